@@ -0,0 +1,1647 @@
+/********************************************************************/
+/*                                                                  */
+/*  aes_rtl.c     AES block cipher with CBC and GCM mode.           */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/aes_rtl.c                                       */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: AES block cipher with CBC and GCM mode.                */
+/*                                                                  */
+/*  The expanded key is stored in a bstring. This way it is copied  */
+/*  and freed like any other value. All functions process a whole   */
+/*  message (e.g. a TLS record) per call.                           */
+/*  No table lookups are used: If the CPU supports AES-NI and       */
+/*  PCLMULQDQ these instructions are used. Otherwise AES is         */
+/*  computed bitsliced (four blocks at once) and GHASH is computed  */
+/*  with integer multiplications. Both need constant time.          */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#if HAS_AESNI_INTRINSICS
+#include "immintrin.h"
+#endif
+
+#include "common.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "striutl.h"
+#include "rtl_err.h"
+
+#undef EXTERN
+#define EXTERN
+#include "aes_rtl.h"
+
+
+#define AES_BLOCK_SIZE       16
+#define AES_MAX_ROUNDS       14
+#define AES_MAX_KEY_WORDS    (4 * (AES_MAX_ROUNDS + 1))
+#define GCM_NONCE_SIZE       12
+#define BITSLICE_BLOCKS       4
+#define STRI_CHUNK_SIZE    4096
+
+/* A bitsliced state holds four blocks in eight words. Bit k of     */
+/* byte n of block b is stored in bit 16 * b + n of word k. The     */
+/* byte n of a block is in row n mod 4 and column n div 4.          */
+#define LANES(mask) ((uint64Type) (mask) * 0x0001000100010001)
+
+#define ROTATE_ROWS_1(x) ((((x) & LANES(0xeeee)) >> 1) | \
+                          (((x) & LANES(0x1111)) << 3))
+#define ROTATE_ROWS_2(x) ((((x) & LANES(0xcccc)) >> 2) | \
+                          (((x) & LANES(0x3333)) << 2))
+
+typedef enum {
+    CBC_ENCODE, CBC_DECODE, GCM_ENCRYPT, GCM_DECRYPT
+  } cryptModeType;
+
+typedef struct {
+    uint32Type rounds;
+    ucharType roundKey[AES_MAX_ROUNDS + 1][AES_BLOCK_SIZE];
+    ucharType hashKey[AES_BLOCK_SIZE];  /* Encrypted zero block (GHASH key) */
+  } aesKeyRecord, *aesKeyType;
+
+typedef const aesKeyRecord *const_aesKeyType;
+
+typedef uint64Type bitslicedKeyType[AES_MAX_ROUNDS + 1][8];
+
+
+
+static inline uint32Type loadBigEndian32 (const ucharType *bytes)
+
+  { /* loadBigEndian32 */
+    return (uint32Type) bytes[0] << 24   | (uint32Type) bytes[1] << 16 |
+           (uint32Type) bytes[2] <<  8   | (uint32Type) bytes[3];
+  } /* loadBigEndian32 */
+
+
+
+static inline void storeBigEndian32 (ucharType *bytes, uint32Type number)
+
+  { /* storeBigEndian32 */
+    bytes[0] = (ucharType) (number >> 24);
+    bytes[1] = (ucharType) (number >> 16 & 0xff);
+    bytes[2] = (ucharType) (number >>  8 & 0xff);
+    bytes[3] = (ucharType) (number       & 0xff);
+  } /* storeBigEndian32 */
+
+
+
+static inline uint64Type loadBigEndian64 (const ucharType *bytes)
+
+  { /* loadBigEndian64 */
+    return (uint64Type) loadBigEndian32(bytes) << 32 |
+           (uint64Type) loadBigEndian32(&bytes[4]);
+  } /* loadBigEndian64 */
+
+
+
+static inline void storeBigEndian64 (ucharType *bytes, uint64Type number)
+
+  { /* storeBigEndian64 */
+    storeBigEndian32(bytes, (uint32Type) (number >> 32));
+    storeBigEndian32(&bytes[4], (uint32Type) (number & 0xffffffff));
+  } /* storeBigEndian64 */
+
+
+
+static inline uint64Type loadLittleEndian64 (const ucharType *bytes)
+
+  {
+    uint64Type number = 0;
+    int pos;
+
+  /* loadLittleEndian64 */
+    for (pos = 7; pos >= 0; pos--) {
+      number = number << 8 | bytes[pos];
+    } /* for */
+    return number;
+  } /* loadLittleEndian64 */
+
+
+
+static inline void storeLittleEndian64 (ucharType *bytes, uint64Type number)
+
+  {
+    int pos;
+
+  /* storeLittleEndian64 */
+    for (pos = 0; pos < 8; pos++) {
+      bytes[pos] = (ucharType) (number & 0xff);
+      number >>= 8;
+    } /* for */
+  } /* storeLittleEndian64 */
+
+
+
+/**
+ *  Transpose the 8x8 bit matrix with the bytes of 'x' as rows.
+ */
+static inline uint64Type transpose8 (uint64Type x)
+
+  {
+    uint64Type t;
+
+  /* transpose8 */
+    t = (x ^ (x >>  7)) & 0x00aa00aa00aa00aa;
+    x ^= t ^ (t <<  7);
+    t = (x ^ (x >> 14)) & 0x0000cccc0000cccc;
+    x ^= t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000f0f0f0f0;
+    x ^= t ^ (t << 28);
+    return x;
+  } /* transpose8 */
+
+
+
+/**
+ *  Convert 'numBlocks' (1 to 4) blocks to the bitsliced state 'q'.
+ *  Missing blocks are set to zero.
+ */
+static void packBlocks (uint64Type q[8], const ucharType *in,
+    unsigned int numBlocks)
+
+  {
+    unsigned int group;
+    unsigned int bit;
+    uint64Type x;
+
+  /* packBlocks */
+    for (bit = 0; bit < 8; bit++) {
+      q[bit] = 0;
+    } /* for */
+    for (group = 0; group < 2 * numBlocks; group++) {
+      x = transpose8(loadLittleEndian64(&in[8 * group]));
+      for (bit = 0; bit < 8; bit++) {
+        q[bit] |= (x >> (8 * bit) & 0xff) << (8 * group);
+      } /* for */
+    } /* for */
+  } /* packBlocks */
+
+
+
+static void unpackBlocks (ucharType *out, const uint64Type q[8],
+    unsigned int numBlocks)
+
+  {
+    unsigned int group;
+    unsigned int bit;
+    uint64Type x;
+
+  /* unpackBlocks */
+    for (group = 0; group < 2 * numBlocks; group++) {
+      x = 0;
+      for (bit = 0; bit < 8; bit++) {
+        x |= (q[bit] >> (8 * group) & 0xff) << (8 * bit);
+      } /* for */
+      storeLittleEndian64(&out[8 * group], transpose8(x));
+    } /* for */
+  } /* unpackBlocks */
+
+
+
+/**
+ *  Multiply the bitsliced elements of GF(2^8) 'a' and 'b'.
+ *  The field is defined by the AES polynomial x^8+x^4+x^3+x+1.
+ */
+static void gfMultiply (uint64Type c[8], const uint64Type a[8],
+    const uint64Type b[8])
+
+  {
+    uint64Type p[15];
+    int i;
+    int j;
+
+  /* gfMultiply */
+    for (i = 0; i < 15; i++) {
+      p[i] = 0;
+    } /* for */
+    for (i = 0; i < 8; i++) {
+      for (j = 0; j < 8; j++) {
+        p[i + j] ^= a[i] & b[j];
+      } /* for */
+    } /* for */
+    for (i = 14; i >= 8; i--) {
+      p[i - 4] ^= p[i];
+      p[i - 5] ^= p[i];
+      p[i - 7] ^= p[i];
+      p[i - 8] ^= p[i];
+    } /* for */
+    memcpy(c, p, 8 * sizeof(uint64Type));
+  } /* gfMultiply */
+
+
+
+/**
+ *  Square the bitsliced element of GF(2^8) 'a'.
+ *  Squaring is linear, so it needs only XOR operations.
+ */
+static void gfSquare (uint64Type c[8], const uint64Type a[8])
+
+  {
+    uint64Type b[8];
+
+  /* gfSquare */
+    b[0] = a[0] ^ a[4] ^ a[6];
+    b[1] = a[4] ^ a[6] ^ a[7];
+    b[2] = a[1] ^ a[5];
+    b[3] = a[4] ^ a[5] ^ a[6] ^ a[7];
+    b[4] = a[2] ^ a[4] ^ a[7];
+    b[5] = a[5] ^ a[6];
+    b[6] = a[3] ^ a[5];
+    b[7] = a[6] ^ a[7];
+    memcpy(c, b, 8 * sizeof(uint64Type));
+  } /* gfSquare */
+
+
+
+/**
+ *  Compute the multiplicative inverse of all bytes in 'q' as q^254.
+ *  The inverse of zero is zero, as required by the S-box.
+ */
+static void gfInverse (uint64Type q[8])
+
+  {
+    uint64Type x2[8];
+    uint64Type x3[8];
+    uint64Type x12[8];
+    uint64Type x15[8];
+    uint64Type t[8];
+
+  /* gfInverse */
+    gfSquare(x2, q);
+    gfMultiply(x3, x2, q);
+    gfSquare(x12, x3);
+    gfSquare(x12, x12);
+    gfMultiply(x15, x12, x3);
+    gfSquare(t, x15);
+    gfSquare(t, t);
+    gfSquare(t, t);
+    gfSquare(t, t);
+    gfMultiply(t, t, x12);
+    gfMultiply(q, t, x2);
+  } /* gfInverse */
+
+
+
+static void subBytes (uint64Type q[8])
+
+  {
+    uint64Type b[8];
+    int bit;
+
+  /* subBytes */
+    gfInverse(q);
+    memcpy(b, q, 8 * sizeof(uint64Type));
+    for (bit = 0; bit < 8; bit++) {
+      q[bit] = b[bit] ^ b[(bit + 7) & 7] ^ b[(bit + 6) & 7] ^
+               b[(bit + 5) & 7] ^ b[(bit + 4) & 7];
+    } /* for */
+    /* Add the constant 0x63. */
+    q[0] = ~q[0];
+    q[1] = ~q[1];
+    q[5] = ~q[5];
+    q[6] = ~q[6];
+  } /* subBytes */
+
+
+
+static void invSubBytes (uint64Type q[8])
+
+  {
+    uint64Type s[8];
+    int bit;
+
+  /* invSubBytes */
+    memcpy(s, q, 8 * sizeof(uint64Type));
+    for (bit = 0; bit < 8; bit++) {
+      q[bit] = s[(bit + 7) & 7] ^ s[(bit + 5) & 7] ^ s[(bit + 2) & 7];
+    } /* for */
+    /* Add the constant 0x05. */
+    q[0] = ~q[0];
+    q[2] = ~q[2];
+    gfInverse(q);
+  } /* invSubBytes */
+
+
+
+static void shiftRows (uint64Type q[8])
+
+  {
+    uint64Type x;
+    int bit;
+
+  /* shiftRows */
+    for (bit = 0; bit < 8; bit++) {
+      x = q[bit];
+      q[bit] = (x & LANES(0x1111)) |
+               (x & LANES(0x2220)) >> 4 | (x & LANES(0x0002)) << 12 |
+               (x & LANES(0x4400)) >> 8 | (x & LANES(0x0044)) <<  8 |
+               (x & LANES(0x8000)) >> 12 | (x & LANES(0x0888)) << 4;
+    } /* for */
+  } /* shiftRows */
+
+
+
+static void invShiftRows (uint64Type q[8])
+
+  {
+    uint64Type x;
+    int bit;
+
+  /* invShiftRows */
+    for (bit = 0; bit < 8; bit++) {
+      x = q[bit];
+      q[bit] = (x & LANES(0x1111)) |
+               (x & LANES(0x0222)) << 4 | (x & LANES(0x2000)) >> 12 |
+               (x & LANES(0x4400)) >> 8 | (x & LANES(0x0044)) <<  8 |
+               (x & LANES(0x0008)) << 12 | (x & LANES(0x8880)) >> 4;
+    } /* for */
+  } /* invShiftRows */
+
+
+
+/**
+ *  Multiply all bytes of the bitsliced state 'd' by x.
+ */
+static void xtime (uint64Type q[8], const uint64Type d[8])
+
+  {
+    uint64Type top;
+
+  /* xtime */
+    top = d[7];
+    q[7] = d[6];
+    q[6] = d[5];
+    q[5] = d[4];
+    q[4] = d[3] ^ top;
+    q[3] = d[2] ^ top;
+    q[2] = d[1];
+    q[1] = d[0] ^ top;
+    q[0] = top;
+  } /* xtime */
+
+
+
+static void mixColumns (uint64Type q[8])
+
+  {
+    uint64Type rotated[8];
+    uint64Type d[8];
+    uint64Type d2[8];
+    int bit;
+
+  /* mixColumns */
+    for (bit = 0; bit < 8; bit++) {
+      rotated[bit] = ROTATE_ROWS_1(q[bit]);
+      d[bit] = q[bit] ^ rotated[bit];
+    } /* for */
+    xtime(d2, d);
+    for (bit = 0; bit < 8; bit++) {
+      q[bit] = d2[bit] ^ rotated[bit] ^ ROTATE_ROWS_2(d[bit]);
+    } /* for */
+  } /* mixColumns */
+
+
+
+/**
+ *  InvMixColumns is MixColumns applied after a preprocessing step,
+ *  which adds 4 * (a[row] + a[row + 2]) to every byte.
+ */
+static void invMixColumns (uint64Type q[8])
+
+  {
+    uint64Type t[8];
+    int bit;
+
+  /* invMixColumns */
+    for (bit = 0; bit < 8; bit++) {
+      t[bit] = q[bit] ^ ROTATE_ROWS_2(q[bit]);
+    } /* for */
+    xtime(t, t);
+    xtime(t, t);
+    for (bit = 0; bit < 8; bit++) {
+      q[bit] ^= t[bit];
+    } /* for */
+    mixColumns(q);
+  } /* invMixColumns */
+
+
+
+static inline void addRoundKey (uint64Type q[8], const uint64Type roundKey[8])
+
+  {
+    int bit;
+
+  /* addRoundKey */
+    for (bit = 0; bit < 8; bit++) {
+      q[bit] ^= roundKey[bit];
+    } /* for */
+  } /* addRoundKey */
+
+
+
+/**
+ *  Convert the round keys to bitsliced form.
+ *  Every round key is repeated for all four blocks.
+ */
+static void bitsliceRoundKeys (bitslicedKeyType bitslicedKey,
+    const_aesKeyType key)
+
+  {
+    unsigned int round;
+    int bit;
+
+  /* bitsliceRoundKeys */
+    for (round = 0; round <= key->rounds; round++) {
+      packBlocks(bitslicedKey[round], key->roundKey[round], 1);
+      for (bit = 0; bit < 8; bit++) {
+        bitslicedKey[round][bit] = LANES(bitslicedKey[round][bit]);
+      } /* for */
+    } /* for */
+  } /* bitsliceRoundKeys */
+
+
+
+static void encryptBitsliced (uint64Type q[8],
+    const bitslicedKeyType bitslicedKey, unsigned int rounds)
+
+  {
+    unsigned int round;
+
+  /* encryptBitsliced */
+    addRoundKey(q, bitslicedKey[0]);
+    for (round = 1; round < rounds; round++) {
+      subBytes(q);
+      shiftRows(q);
+      mixColumns(q);
+      addRoundKey(q, bitslicedKey[round]);
+    } /* for */
+    subBytes(q);
+    shiftRows(q);
+    addRoundKey(q, bitslicedKey[rounds]);
+  } /* encryptBitsliced */
+
+
+
+static void decryptBitsliced (uint64Type q[8],
+    const bitslicedKeyType bitslicedKey, unsigned int rounds)
+
+  {
+    unsigned int round;
+
+  /* decryptBitsliced */
+    addRoundKey(q, bitslicedKey[rounds]);
+    for (round = rounds - 1; round > 0; round--) {
+      invShiftRows(q);
+      invSubBytes(q);
+      addRoundKey(q, bitslicedKey[round]);
+      invMixColumns(q);
+    } /* for */
+    invShiftRows(q);
+    invSubBytes(q);
+    addRoundKey(q, bitslicedKey[0]);
+  } /* decryptBitsliced */
+
+
+
+/**
+ *  Apply the S-box to the four bytes of 'word'.
+ */
+static void subWord (ucharType word[4])
+
+  {
+    ucharType block[AES_BLOCK_SIZE];
+    uint64Type q[8];
+
+  /* subWord */
+    memset(block, 0, AES_BLOCK_SIZE);
+    memcpy(block, word, 4);
+    packBlocks(q, block, 1);
+    subBytes(q);
+    unpackBlocks(block, q, 1);
+    memcpy(word, block, 4);
+  } /* subWord */
+
+
+
+/**
+ *  Compute the round keys from 'keyBytes' (FIPS-197 section 5.2).
+ *  @param keyLength Length of the key in bytes (16, 24 or 32).
+ */
+static void expandKey (aesKeyType key, const ucharType *keyBytes,
+    unsigned int keyLength)
+
+  {
+    ucharType word[AES_MAX_KEY_WORDS][4];
+    unsigned int keyWords;
+    unsigned int numWords;
+    unsigned int idx;
+    unsigned int pos;
+    ucharType temp[4];
+    ucharType rcon = 1;
+
+  /* expandKey */
+    keyWords = keyLength / 4;
+    key->rounds = keyWords + 6;
+    numWords = 4 * (key->rounds + 1);
+    memcpy(word, keyBytes, keyLength);
+    for (idx = keyWords; idx < numWords; idx++) {
+      if (idx % keyWords == 0) {
+        temp[0] = word[idx - 1][1];
+        temp[1] = word[idx - 1][2];
+        temp[2] = word[idx - 1][3];
+        temp[3] = word[idx - 1][0];
+        subWord(temp);
+        temp[0] ^= rcon;
+        rcon = (ucharType) (rcon << 1 ^ (rcon >> 7) * 0x1b);
+      } else {
+        memcpy(temp, word[idx - 1], 4);
+        if (keyWords > 6 && idx % keyWords == 4) {
+          subWord(temp);
+        } /* if */
+      } /* if */
+      for (pos = 0; pos < 4; pos++) {
+        word[idx][pos] = word[idx - keyWords][pos] ^ temp[pos];
+      } /* for */
+    } /* for */
+    memcpy(key->roundKey, word, 4 * numWords);
+  } /* expandKey */
+
+
+
+static void encryptBlockGeneric (const_aesKeyType key, const ucharType *in,
+    ucharType *out)
+
+  {
+    bitslicedKeyType bitslicedKey;
+    uint64Type q[8];
+
+  /* encryptBlockGeneric */
+    bitsliceRoundKeys(bitslicedKey, key);
+    packBlocks(q, in, 1);
+    encryptBitsliced(q, bitslicedKey, key->rounds);
+    unpackBlocks(out, q, 1);
+  } /* encryptBlockGeneric */
+
+
+
+static void cbcEncodeGeneric (const_aesKeyType key, ucharType *iv,
+    const ucharType *in, ucharType *out, memSizeType length)
+
+  {
+    bitslicedKeyType bitslicedKey;
+    uint64Type q[8];
+    unsigned int pos;
+
+  /* cbcEncodeGeneric */
+    bitsliceRoundKeys(bitslicedKey, key);
+    for (; length != 0; length -= AES_BLOCK_SIZE) {
+      for (pos = 0; pos < AES_BLOCK_SIZE; pos++) {
+        iv[pos] ^= in[pos];
+      } /* for */
+      packBlocks(q, iv, 1);
+      encryptBitsliced(q, bitslicedKey, key->rounds);
+      unpackBlocks(iv, q, 1);
+      memcpy(out, iv, AES_BLOCK_SIZE);
+      in += AES_BLOCK_SIZE;
+      out += AES_BLOCK_SIZE;
+    } /* for */
+  } /* cbcEncodeGeneric */
+
+
+
+static void cbcDecodeGeneric (const_aesKeyType key, ucharType *iv,
+    const ucharType *in, ucharType *out, memSizeType length)
+
+  {
+    bitslicedKeyType bitslicedKey;
+    uint64Type q[8];
+    ucharType plain[BITSLICE_BLOCKS * AES_BLOCK_SIZE];
+    unsigned int numBlocks;
+    unsigned int pos;
+
+  /* cbcDecodeGeneric */
+    bitsliceRoundKeys(bitslicedKey, key);
+    while (length != 0) {
+      numBlocks = length >= BITSLICE_BLOCKS * AES_BLOCK_SIZE ?
+          BITSLICE_BLOCKS : (unsigned int) (length / AES_BLOCK_SIZE);
+      packBlocks(q, in, numBlocks);
+      decryptBitsliced(q, bitslicedKey, key->rounds);
+      unpackBlocks(plain, q, numBlocks);
+      for (pos = 0; pos < AES_BLOCK_SIZE; pos++) {
+        out[pos] = plain[pos] ^ iv[pos];
+      } /* for */
+      for (pos = AES_BLOCK_SIZE; pos < numBlocks * AES_BLOCK_SIZE; pos++) {
+        out[pos] = plain[pos] ^ in[pos - AES_BLOCK_SIZE];
+      } /* for */
+      memcpy(iv, &in[(numBlocks - 1) * AES_BLOCK_SIZE], AES_BLOCK_SIZE);
+      in += numBlocks * AES_BLOCK_SIZE;
+      out += numBlocks * AES_BLOCK_SIZE;
+      length -= numBlocks * AES_BLOCK_SIZE;
+    } /* while */
+  } /* cbcDecodeGeneric */
+
+
+
+/**
+ *  Encrypt or decrypt in counter mode. The last four bytes of
+ *  'counter' are incremented as 32-bit big-endian number (GCM inc32).
+ */
+static void ctr32Generic (const_aesKeyType key, ucharType *counter,
+    const ucharType *in, ucharType *out, memSizeType length)
+
+  {
+    bitslicedKeyType bitslicedKey;
+    uint64Type q[8];
+    ucharType keyStream[BITSLICE_BLOCKS * AES_BLOCK_SIZE];
+    uint32Type count;
+    unsigned int numBlocks;
+    unsigned int block;
+    memSizeType chunkSize;
+    memSizeType pos;
+
+  /* ctr32Generic */
+    bitsliceRoundKeys(bitslicedKey, key);
+    count = loadBigEndian32(&counter[12]);
+    while (length != 0) {
+      chunkSize = length < BITSLICE_BLOCKS * AES_BLOCK_SIZE ?
+          length : BITSLICE_BLOCKS * AES_BLOCK_SIZE;
+      numBlocks = (unsigned int) ((chunkSize + AES_BLOCK_SIZE - 1) / AES_BLOCK_SIZE);
+      for (block = 0; block < numBlocks; block++) {
+        memcpy(&keyStream[block * AES_BLOCK_SIZE], counter, 12);
+        storeBigEndian32(&keyStream[block * AES_BLOCK_SIZE + 12], count);
+        count++;
+      } /* for */
+      packBlocks(q, keyStream, numBlocks);
+      encryptBitsliced(q, bitslicedKey, key->rounds);
+      unpackBlocks(keyStream, q, numBlocks);
+      for (pos = 0; pos < chunkSize; pos++) {
+        out[pos] = in[pos] ^ keyStream[pos];
+      } /* for */
+      in += chunkSize;
+      out += chunkSize;
+      length -= chunkSize;
+    } /* while */
+    storeBigEndian32(&counter[12], count);
+  } /* ctr32Generic */
+
+
+
+/**
+ *  Carryless multiplication of 'x' and 'y' (lower 64 bits).
+ *  Integer multiplications with holes of three zero bits between
+ *  the data bits keep the carries away from the used bits.
+ */
+static inline uint64Type bmul64 (uint64Type x, uint64Type y)
+
+  {
+    uint64Type x0, x1, x2, x3;
+    uint64Type y0, y1, y2, y3;
+    uint64Type z0, z1, z2, z3;
+
+  /* bmul64 */
+    x0 = x & 0x1111111111111111;
+    x1 = x & 0x2222222222222222;
+    x2 = x & 0x4444444444444444;
+    x3 = x & 0x8888888888888888;
+    y0 = y & 0x1111111111111111;
+    y1 = y & 0x2222222222222222;
+    y2 = y & 0x4444444444444444;
+    y3 = y & 0x8888888888888888;
+    z0 = (x0 * y0) ^ (x1 * y3) ^ (x2 * y2) ^ (x3 * y1);
+    z1 = (x0 * y1) ^ (x1 * y0) ^ (x2 * y3) ^ (x3 * y2);
+    z2 = (x0 * y2) ^ (x1 * y1) ^ (x2 * y0) ^ (x3 * y3);
+    z3 = (x0 * y3) ^ (x1 * y2) ^ (x2 * y1) ^ (x3 * y0);
+    return (z0 & 0x1111111111111111) | (z1 & 0x2222222222222222) |
+           (z2 & 0x4444444444444444) | (z3 & 0x8888888888888888);
+  } /* bmul64 */
+
+
+
+static inline uint64Type rev64 (uint64Type x)
+
+  { /* rev64 */
+    x = (x & 0x5555555555555555) << 1 | (x >> 1 & 0x5555555555555555);
+    x = (x & 0x3333333333333333) << 2 | (x >> 2 & 0x3333333333333333);
+    x = (x & 0x0f0f0f0f0f0f0f0f) << 4 | (x >> 4 & 0x0f0f0f0f0f0f0f0f);
+    x = (x & 0x00ff00ff00ff00ff) << 8 | (x >> 8 & 0x00ff00ff00ff00ff);
+    x = (x & 0x0000ffff0000ffff) << 16 | (x >> 16 & 0x0000ffff0000ffff);
+    return x << 32 | x >> 32;
+  } /* rev64 */
+
+
+
+/**
+ *  Process 'data' with GHASH (NIST SP 800-38D). A final partial
+ *  block is padded with zero bytes. The high halves of the
+ *  products are computed as the low halves of the bit reversed
+ *  factors. This way no multiplication has a carry problem.
+ */
+static void ghashGeneric (ucharType *hash, const ucharType *hashKey,
+    const ucharType *data, memSizeType length)
+
+  {
+    ucharType block[AES_BLOCK_SIZE];
+    const ucharType *src;
+    uint64Type y0, y1, y2, y0r, y1r, y2r;
+    uint64Type h0, h1, h2, h0r, h1r, h2r;
+    uint64Type z0, z1, z2, z0h, z1h, z2h;
+    uint64Type v0, v1, v2, v3;
+
+  /* ghashGeneric */
+    y1 = loadBigEndian64(hash);
+    y0 = loadBigEndian64(&hash[8]);
+    h1 = loadBigEndian64(hashKey);
+    h0 = loadBigEndian64(&hashKey[8]);
+    h0r = rev64(h0);
+    h1r = rev64(h1);
+    h2 = h0 ^ h1;
+    h2r = h0r ^ h1r;
+    while (length != 0) {
+      if (length >= AES_BLOCK_SIZE) {
+        src = data;
+        data += AES_BLOCK_SIZE;
+        length -= AES_BLOCK_SIZE;
+      } else {
+        memcpy(block, data, length);
+        memset(&block[length], 0, AES_BLOCK_SIZE - length);
+        src = block;
+        length = 0;
+      } /* if */
+      y1 ^= loadBigEndian64(src);
+      y0 ^= loadBigEndian64(&src[8]);
+      y0r = rev64(y0);
+      y1r = rev64(y1);
+      y2 = y0 ^ y1;
+      y2r = y0r ^ y1r;
+      /* Karatsuba multiplication */
+      z0 = bmul64(y0, h0);
+      z1 = bmul64(y1, h1);
+      z2 = bmul64(y2, h2);
+      z0h = bmul64(y0r, h0r);
+      z1h = bmul64(y1r, h1r);
+      z2h = bmul64(y2r, h2r);
+      z2 ^= z0 ^ z1;
+      z2h ^= z0h ^ z1h;
+      z0h = rev64(z0h) >> 1;
+      z1h = rev64(z1h) >> 1;
+      z2h = rev64(z2h) >> 1;
+      v0 = z0;
+      v1 = z0h ^ z2;
+      v2 = z1 ^ z2h;
+      v3 = z1h;
+      /* The bits are reflected: Shift the product left by one. */
+      v3 = v3 << 1 | v2 >> 63;
+      v2 = v2 << 1 | v1 >> 63;
+      v1 = v1 << 1 | v0 >> 63;
+      v0 = v0 << 1;
+      /* Reduce modulo x^128 + x^7 + x^2 + x + 1. */
+      v2 ^= v0 ^ (v0 >> 1) ^ (v0 >> 2) ^ (v0 >> 7);
+      v1 ^= (v0 << 63) ^ (v0 << 62) ^ (v0 << 57);
+      v3 ^= v1 ^ (v1 >> 1) ^ (v1 >> 2) ^ (v1 >> 7);
+      v2 ^= (v1 << 63) ^ (v1 << 62) ^ (v1 << 57);
+      y0 = v2;
+      y1 = v3;
+    } /* while */
+    storeBigEndian64(hash, y1);
+    storeBigEndian64(&hash[8], y0);
+  } /* ghashGeneric */
+
+
+
+#if HAS_AESNI_INTRINSICS
+__attribute__((target("aes,pclmul,ssse3,sse4.1")))
+static void encryptBlockAesni (const_aesKeyType key, const ucharType *in,
+    ucharType *out)
+
+  {
+    __m128i block;
+    unsigned int round;
+
+  /* encryptBlockAesni */
+    block = _mm_xor_si128(_mm_loadu_si128((const __m128i *) in),
+                          _mm_loadu_si128((const __m128i *) key->roundKey[0]));
+    for (round = 1; round < key->rounds; round++) {
+      block = _mm_aesenc_si128(block,
+          _mm_loadu_si128((const __m128i *) key->roundKey[round]));
+    } /* for */
+    block = _mm_aesenclast_si128(block,
+        _mm_loadu_si128((const __m128i *) key->roundKey[key->rounds]));
+    _mm_storeu_si128((__m128i *) out, block);
+  } /* encryptBlockAesni */
+
+
+
+__attribute__((target("aes,pclmul,ssse3,sse4.1")))
+static void cbcEncodeAesni (const_aesKeyType key, ucharType *iv,
+    const ucharType *in, ucharType *out, memSizeType length)
+
+  {
+    __m128i roundKey[AES_MAX_ROUNDS + 1];
+    __m128i block;
+    unsigned int rounds;
+    unsigned int round;
+
+  /* cbcEncodeAesni */
+    rounds = key->rounds;
+    for (round = 0; round <= rounds; round++) {
+      roundKey[round] = _mm_loadu_si128((const __m128i *) key->roundKey[round]);
+    } /* for */
+    block = _mm_loadu_si128((const __m128i *) iv);
+    for (; length != 0; length -= AES_BLOCK_SIZE) {
+      block = _mm_xor_si128(block, _mm_loadu_si128((const __m128i *) in));
+      block = _mm_xor_si128(block, roundKey[0]);
+      for (round = 1; round < rounds; round++) {
+        block = _mm_aesenc_si128(block, roundKey[round]);
+      } /* for */
+      block = _mm_aesenclast_si128(block, roundKey[rounds]);
+      _mm_storeu_si128((__m128i *) out, block);
+      in += AES_BLOCK_SIZE;
+      out += AES_BLOCK_SIZE;
+    } /* for */
+    _mm_storeu_si128((__m128i *) iv, block);
+  } /* cbcEncodeAesni */
+
+
+
+__attribute__((target("aes,pclmul,ssse3,sse4.1")))
+static void cbcDecodeAesni (const_aesKeyType key, ucharType *iv,
+    const ucharType *in, ucharType *out, memSizeType length)
+
+  {
+    __m128i roundKey[AES_MAX_ROUNDS + 1];
+    __m128i previous;
+    __m128i cipher0, cipher1, cipher2, cipher3;
+    __m128i block0, block1, block2, block3;
+    unsigned int rounds;
+    unsigned int round;
+
+  /* cbcDecodeAesni */
+    /* Round keys for the equivalent inverse cipher. */
+    rounds = key->rounds;
+    roundKey[0] = _mm_loadu_si128((const __m128i *) key->roundKey[rounds]);
+    for (round = 1; round < rounds; round++) {
+      roundKey[round] = _mm_aesimc_si128(
+          _mm_loadu_si128((const __m128i *) key->roundKey[rounds - round]));
+    } /* for */
+    roundKey[rounds] = _mm_loadu_si128((const __m128i *) key->roundKey[0]);
+    previous = _mm_loadu_si128((const __m128i *) iv);
+    for (; length >= 4 * AES_BLOCK_SIZE; length -= 4 * AES_BLOCK_SIZE) {
+      cipher0 = _mm_loadu_si128((const __m128i *) in);
+      cipher1 = _mm_loadu_si128((const __m128i *) &in[16]);
+      cipher2 = _mm_loadu_si128((const __m128i *) &in[32]);
+      cipher3 = _mm_loadu_si128((const __m128i *) &in[48]);
+      block0 = _mm_xor_si128(cipher0, roundKey[0]);
+      block1 = _mm_xor_si128(cipher1, roundKey[0]);
+      block2 = _mm_xor_si128(cipher2, roundKey[0]);
+      block3 = _mm_xor_si128(cipher3, roundKey[0]);
+      for (round = 1; round < rounds; round++) {
+        block0 = _mm_aesdec_si128(block0, roundKey[round]);
+        block1 = _mm_aesdec_si128(block1, roundKey[round]);
+        block2 = _mm_aesdec_si128(block2, roundKey[round]);
+        block3 = _mm_aesdec_si128(block3, roundKey[round]);
+      } /* for */
+      block0 = _mm_aesdeclast_si128(block0, roundKey[rounds]);
+      block1 = _mm_aesdeclast_si128(block1, roundKey[rounds]);
+      block2 = _mm_aesdeclast_si128(block2, roundKey[rounds]);
+      block3 = _mm_aesdeclast_si128(block3, roundKey[rounds]);
+      _mm_storeu_si128((__m128i *) out, _mm_xor_si128(block0, previous));
+      _mm_storeu_si128((__m128i *) &out[16], _mm_xor_si128(block1, cipher0));
+      _mm_storeu_si128((__m128i *) &out[32], _mm_xor_si128(block2, cipher1));
+      _mm_storeu_si128((__m128i *) &out[48], _mm_xor_si128(block3, cipher2));
+      previous = cipher3;
+      in += 4 * AES_BLOCK_SIZE;
+      out += 4 * AES_BLOCK_SIZE;
+    } /* for */
+    for (; length != 0; length -= AES_BLOCK_SIZE) {
+      cipher0 = _mm_loadu_si128((const __m128i *) in);
+      block0 = _mm_xor_si128(cipher0, roundKey[0]);
+      for (round = 1; round < rounds; round++) {
+        block0 = _mm_aesdec_si128(block0, roundKey[round]);
+      } /* for */
+      block0 = _mm_aesdeclast_si128(block0, roundKey[rounds]);
+      _mm_storeu_si128((__m128i *) out, _mm_xor_si128(block0, previous));
+      previous = cipher0;
+      in += AES_BLOCK_SIZE;
+      out += AES_BLOCK_SIZE;
+    } /* for */
+    _mm_storeu_si128((__m128i *) iv, previous);
+  } /* cbcDecodeAesni */
+
+
+
+__attribute__((target("aes,pclmul,ssse3,sse4.1")))
+static void ctr32Aesni (const_aesKeyType key, ucharType *counter,
+    const ucharType *in, ucharType *out, memSizeType length)
+
+  {
+    __m128i roundKey[AES_MAX_ROUNDS + 1];
+    __m128i counterBlock;
+    __m128i block0, block1, block2, block3;
+    ucharType keyStream[AES_BLOCK_SIZE];
+    uint32Type count;
+    unsigned int rounds;
+    unsigned int round;
+    memSizeType pos;
+
+  /* ctr32Aesni */
+    rounds = key->rounds;
+    for (round = 0; round <= rounds; round++) {
+      roundKey[round] = _mm_loadu_si128((const __m128i *) key->roundKey[round]);
+    } /* for */
+    counterBlock = _mm_loadu_si128((const __m128i *) counter);
+    count = loadBigEndian32(&counter[12]);
+    for (; length >= 4 * AES_BLOCK_SIZE; length -= 4 * AES_BLOCK_SIZE) {
+      block0 = _mm_insert_epi32(counterBlock, (int) __builtin_bswap32(count), 3);
+      block1 = _mm_insert_epi32(counterBlock, (int) __builtin_bswap32(count + 1), 3);
+      block2 = _mm_insert_epi32(counterBlock, (int) __builtin_bswap32(count + 2), 3);
+      block3 = _mm_insert_epi32(counterBlock, (int) __builtin_bswap32(count + 3), 3);
+      count += 4;
+      block0 = _mm_xor_si128(block0, roundKey[0]);
+      block1 = _mm_xor_si128(block1, roundKey[0]);
+      block2 = _mm_xor_si128(block2, roundKey[0]);
+      block3 = _mm_xor_si128(block3, roundKey[0]);
+      for (round = 1; round < rounds; round++) {
+        block0 = _mm_aesenc_si128(block0, roundKey[round]);
+        block1 = _mm_aesenc_si128(block1, roundKey[round]);
+        block2 = _mm_aesenc_si128(block2, roundKey[round]);
+        block3 = _mm_aesenc_si128(block3, roundKey[round]);
+      } /* for */
+      block0 = _mm_aesenclast_si128(block0, roundKey[rounds]);
+      block1 = _mm_aesenclast_si128(block1, roundKey[rounds]);
+      block2 = _mm_aesenclast_si128(block2, roundKey[rounds]);
+      block3 = _mm_aesenclast_si128(block3, roundKey[rounds]);
+      _mm_storeu_si128((__m128i *) out, _mm_xor_si128(block0,
+          _mm_loadu_si128((const __m128i *) in)));
+      _mm_storeu_si128((__m128i *) &out[16], _mm_xor_si128(block1,
+          _mm_loadu_si128((const __m128i *) &in[16])));
+      _mm_storeu_si128((__m128i *) &out[32], _mm_xor_si128(block2,
+          _mm_loadu_si128((const __m128i *) &in[32])));
+      _mm_storeu_si128((__m128i *) &out[48], _mm_xor_si128(block3,
+          _mm_loadu_si128((const __m128i *) &in[48])));
+      in += 4 * AES_BLOCK_SIZE;
+      out += 4 * AES_BLOCK_SIZE;
+    } /* for */
+    while (length != 0) {
+      block0 = _mm_insert_epi32(counterBlock, (int) __builtin_bswap32(count), 3);
+      count++;
+      block0 = _mm_xor_si128(block0, roundKey[0]);
+      for (round = 1; round < rounds; round++) {
+        block0 = _mm_aesenc_si128(block0, roundKey[round]);
+      } /* for */
+      block0 = _mm_aesenclast_si128(block0, roundKey[rounds]);
+      if (length >= AES_BLOCK_SIZE) {
+        _mm_storeu_si128((__m128i *) out, _mm_xor_si128(block0,
+            _mm_loadu_si128((const __m128i *) in)));
+        in += AES_BLOCK_SIZE;
+        out += AES_BLOCK_SIZE;
+        length -= AES_BLOCK_SIZE;
+      } else {
+        _mm_storeu_si128((__m128i *) keyStream, block0);
+        for (pos = 0; pos < length; pos++) {
+          out[pos] = in[pos] ^ keyStream[pos];
+        } /* for */
+        length = 0;
+      } /* if */
+    } /* while */
+    storeBigEndian32(&counter[12], count);
+  } /* ctr32Aesni */
+
+
+
+/**
+ *  Add the carryless product of 'a' and 'b' to lo, mid and hi.
+ */
+__attribute__((target("aes,pclmul,ssse3,sse4.1")))
+static inline void clmulAccumulate (__m128i a, __m128i b,
+    __m128i *lo, __m128i *mid, __m128i *hi)
+
+  { /* clmulAccumulate */
+    *lo = _mm_xor_si128(*lo, _mm_clmulepi64_si128(a, b, 0x00));
+    *hi = _mm_xor_si128(*hi, _mm_clmulepi64_si128(a, b, 0x11));
+    *mid = _mm_xor_si128(*mid, _mm_clmulepi64_si128(a, b, 0x01));
+    *mid = _mm_xor_si128(*mid, _mm_clmulepi64_si128(a, b, 0x10));
+  } /* clmulAccumulate */
+
+
+
+/**
+ *  Reduce a 256-bit carryless product of byte reversed GHASH values
+ *  modulo x^128 + x^7 + x^2 + x + 1 (Intel white paper, algorithm 5).
+ */
+__attribute__((target("aes,pclmul,ssse3,sse4.1")))
+static inline __m128i ghashReduce (__m128i lo, __m128i mid, __m128i hi)
+
+  {
+    __m128i carryLo, carryHi, carryTop;
+    __m128i t1, t2, t3;
+
+  /* ghashReduce */
+    lo = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+    hi = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+    /* The bits are reflected: Shift the product left by one. */
+    carryLo = _mm_srli_epi32(lo, 31);
+    carryHi = _mm_srli_epi32(hi, 31);
+    lo = _mm_slli_epi32(lo, 1);
+    hi = _mm_slli_epi32(hi, 1);
+    carryTop = _mm_srli_si128(carryLo, 12);
+    carryHi = _mm_slli_si128(carryHi, 4);
+    carryLo = _mm_slli_si128(carryLo, 4);
+    lo = _mm_or_si128(lo, carryLo);
+    hi = _mm_or_si128(_mm_or_si128(hi, carryHi), carryTop);
+    t1 = _mm_xor_si128(_mm_xor_si128(_mm_slli_epi32(lo, 31),
+                                     _mm_slli_epi32(lo, 30)),
+                       _mm_slli_epi32(lo, 25));
+    t2 = _mm_srli_si128(t1, 4);
+    lo = _mm_xor_si128(lo, _mm_slli_si128(t1, 12));
+    t3 = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi32(lo, 1),
+                                     _mm_srli_epi32(lo, 2)),
+                       _mm_xor_si128(_mm_srli_epi32(lo, 7), t2));
+    return _mm_xor_si128(hi, _mm_xor_si128(lo, t3));
+  } /* ghashReduce */
+
+
+
+__attribute__((target("aes,pclmul,ssse3,sse4.1")))
+static inline __m128i ghashMultiply (__m128i a, __m128i b)
+
+  {
+    __m128i lo, mid, hi;
+
+  /* ghashMultiply */
+    lo = _mm_setzero_si128();
+    mid = _mm_setzero_si128();
+    hi = _mm_setzero_si128();
+    clmulAccumulate(a, b, &lo, &mid, &hi);
+    return ghashReduce(lo, mid, hi);
+  } /* ghashMultiply */
+
+
+
+/**
+ *  Process 'data' with GHASH using PCLMULQDQ. Four blocks are
+ *  multiplied with H^4 .. H^1 and reduced together.
+ */
+__attribute__((target("aes,pclmul,ssse3,sse4.1")))
+static void ghashPclmul (ucharType *hash, const ucharType *hashKey,
+    const ucharType *data, memSizeType length)
+
+  {
+    __m128i byteSwap;
+    __m128i h1, h2, h3, h4;
+    __m128i y;
+    __m128i lo, mid, hi;
+    ucharType block[AES_BLOCK_SIZE];
+
+  /* ghashPclmul */
+    byteSwap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7,
+                            8, 9, 10, 11, 12, 13, 14, 15);
+    h1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) hashKey), byteSwap);
+    y = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) hash), byteSwap);
+    if (length >= 4 * AES_BLOCK_SIZE) {
+      h2 = ghashMultiply(h1, h1);
+      h3 = ghashMultiply(h2, h1);
+      h4 = ghashMultiply(h3, h1);
+      for (; length >= 4 * AES_BLOCK_SIZE; length -= 4 * AES_BLOCK_SIZE) {
+        lo = _mm_setzero_si128();
+        mid = _mm_setzero_si128();
+        hi = _mm_setzero_si128();
+        y = _mm_xor_si128(y, _mm_shuffle_epi8(
+            _mm_loadu_si128((const __m128i *) data), byteSwap));
+        clmulAccumulate(y, h4, &lo, &mid, &hi);
+        clmulAccumulate(_mm_shuffle_epi8(
+            _mm_loadu_si128((const __m128i *) &data[16]), byteSwap),
+            h3, &lo, &mid, &hi);
+        clmulAccumulate(_mm_shuffle_epi8(
+            _mm_loadu_si128((const __m128i *) &data[32]), byteSwap),
+            h2, &lo, &mid, &hi);
+        clmulAccumulate(_mm_shuffle_epi8(
+            _mm_loadu_si128((const __m128i *) &data[48]), byteSwap),
+            h1, &lo, &mid, &hi);
+        y = ghashReduce(lo, mid, hi);
+        data += 4 * AES_BLOCK_SIZE;
+      } /* for */
+    } /* if */
+    for (; length >= AES_BLOCK_SIZE; length -= AES_BLOCK_SIZE) {
+      y = _mm_xor_si128(y, _mm_shuffle_epi8(
+          _mm_loadu_si128((const __m128i *) data), byteSwap));
+      y = ghashMultiply(y, h1);
+      data += AES_BLOCK_SIZE;
+    } /* for */
+    if (length != 0) {
+      memcpy(block, data, length);
+      memset(&block[length], 0, AES_BLOCK_SIZE - length);
+      y = _mm_xor_si128(y, _mm_shuffle_epi8(
+          _mm_loadu_si128((const __m128i *) block), byteSwap));
+      y = ghashMultiply(y, h1);
+    } /* if */
+    _mm_storeu_si128((__m128i *) hash, _mm_shuffle_epi8(y, byteSwap));
+  } /* ghashPclmul */
+
+
+
+static inline boolType aesniSupported (void)
+
+  { /* aesniSupported */
+    return __builtin_cpu_supports("aes") && __builtin_cpu_supports("pclmul") &&
+           __builtin_cpu_supports("ssse3") && __builtin_cpu_supports("sse4.1");
+  } /* aesniSupported */
+#endif
+
+
+
+static void encryptBlock (const_aesKeyType key, const ucharType *in,
+    ucharType *out)
+
+  { /* encryptBlock */
+#if HAS_AESNI_INTRINSICS
+    if (aesniSupported()) {
+      encryptBlockAesni(key, in, out);
+    } else {
+      encryptBlockGeneric(key, in, out);
+    } /* if */
+#else
+    encryptBlockGeneric(key, in, out);
+#endif
+  } /* encryptBlock */
+
+
+
+static void ghashBytes (ucharType *hash, const ucharType *hashKey,
+    const ucharType *data, memSizeType length)
+
+  { /* ghashBytes */
+#if HAS_AESNI_INTRINSICS
+    if (aesniSupported()) {
+      ghashPclmul(hash, hashKey, data, length);
+    } else {
+      ghashGeneric(hash, hashKey, data, length);
+    } /* if */
+#else
+    ghashGeneric(hash, hashKey, data, length);
+#endif
+  } /* ghashBytes */
+
+
+
+#if HAS_AESNI_INTRINSICS
+static void cryptBytesAesni (const_aesKeyType key, cryptModeType mode,
+    ucharType *chainBlock, ucharType *hash, const ucharType *in,
+    ucharType *out, memSizeType length)
+
+  { /* cryptBytesAesni */
+    switch (mode) {
+      case CBC_ENCODE:
+        cbcEncodeAesni(key, chainBlock, in, out, length);
+        break;
+      case CBC_DECODE:
+        cbcDecodeAesni(key, chainBlock, in, out, length);
+        break;
+      case GCM_ENCRYPT:
+        ctr32Aesni(key, chainBlock, in, out, length);
+        ghashPclmul(hash, key->hashKey, out, length);
+        break;
+      case GCM_DECRYPT:
+        ghashPclmul(hash, key->hashKey, in, length);
+        ctr32Aesni(key, chainBlock, in, out, length);
+        break;
+    } /* switch */
+  } /* cryptBytesAesni */
+#endif
+
+
+
+static void cryptBytesGeneric (const_aesKeyType key, cryptModeType mode,
+    ucharType *chainBlock, ucharType *hash, const ucharType *in,
+    ucharType *out, memSizeType length)
+
+  { /* cryptBytesGeneric */
+    switch (mode) {
+      case CBC_ENCODE:
+        cbcEncodeGeneric(key, chainBlock, in, out, length);
+        break;
+      case CBC_DECODE:
+        cbcDecodeGeneric(key, chainBlock, in, out, length);
+        break;
+      case GCM_ENCRYPT:
+        ctr32Generic(key, chainBlock, in, out, length);
+        ghashGeneric(hash, key->hashKey, out, length);
+        break;
+      case GCM_DECRYPT:
+        ghashGeneric(hash, key->hashKey, in, length);
+        ctr32Generic(key, chainBlock, in, out, length);
+        break;
+    } /* switch */
+  } /* cryptBytesGeneric */
+
+
+
+/**
+ *  Process one chunk of a message.
+ *  @param chainBlock IV (CBC) or counter block (GCM). It is updated
+ *         such that the next chunk continues the message.
+ *  @param hash GHASH value, which is updated with the ciphertext.
+ */
+static void cryptBytes (const_aesKeyType key, cryptModeType mode,
+    ucharType *chainBlock, ucharType *hash, const ucharType *in,
+    ucharType *out, memSizeType length)
+
+  { /* cryptBytes */
+#if HAS_AESNI_INTRINSICS
+    if (aesniSupported()) {
+      cryptBytesAesni(key, mode, chainBlock, hash, in, out, length);
+    } else {
+      cryptBytesGeneric(key, mode, chainBlock, hash, in, out, length);
+    } /* if */
+#else
+    cryptBytesGeneric(key, mode, chainBlock, hash, in, out, length);
+#endif
+  } /* cryptBytes */
+
+
+
+/**
+ *  Process the characters of 'in' in chunks and write the result
+ *  to 'out'. All chunks except the last are a multiple of the
+ *  block size, so partial blocks only occur at the end.
+ *  @return TRUE if all characters are bytes, FALSE otherwise.
+ */
+static boolType cryptStri (const_aesKeyType key, cryptModeType mode,
+    ucharType *chainBlock, ucharType *hash, const strElemType *in,
+    strElemType *out, memSizeType length)
+
+  {
+    ucharType inBuffer[STRI_CHUNK_SIZE];
+    ucharType outBuffer[STRI_CHUNK_SIZE];
+    memSizeType chunkSize;
+    boolType okay = TRUE;
+
+  /* cryptStri */
+    while (length != 0 && okay) {
+      chunkSize = length < STRI_CHUNK_SIZE ? length : STRI_CHUNK_SIZE;
+      if (unlikely(memcpy_from_strelem(inBuffer, in, chunkSize))) {
+        okay = FALSE;
+      } else {
+        cryptBytes(key, mode, chainBlock, hash, inBuffer, outBuffer, chunkSize);
+        memcpy_to_strelem(out, outBuffer, chunkSize);
+        in += chunkSize;
+        out += chunkSize;
+        length -= chunkSize;
+      } /* if */
+    } /* while */
+    return okay;
+  } /* cryptStri */
+
+
+
+static boolType ghashStri (ucharType *hash, const ucharType *hashKey,
+    const strElemType *stri, memSizeType length)
+
+  {
+    ucharType buffer[STRI_CHUNK_SIZE];
+    memSizeType chunkSize;
+    boolType okay = TRUE;
+
+  /* ghashStri */
+    while (length != 0 && okay) {
+      chunkSize = length < STRI_CHUNK_SIZE ? length : STRI_CHUNK_SIZE;
+      if (unlikely(memcpy_from_strelem(buffer, stri, chunkSize))) {
+        okay = FALSE;
+      } else {
+        ghashBytes(hash, hashKey, buffer, chunkSize);
+        stri += chunkSize;
+        length -= chunkSize;
+      } /* if */
+    } /* while */
+    return okay;
+  } /* ghashStri */
+
+
+
+/**
+ *  Copy the expanded key stored in the bstring 'keyBstri' to 'key'.
+ *  @return TRUE if 'keyBstri' contains a valid key, FALSE otherwise.
+ */
+static boolType getKey (const const_bstriType keyBstri, aesKeyType key)
+
+  {
+    boolType okay = FALSE;
+
+  /* getKey */
+    if (keyBstri->size == sizeof(aesKeyRecord)) {
+      memcpy(key, keyBstri->mem, sizeof(aesKeyRecord));
+      okay = key->rounds == 10 || key->rounds == 12 || key->rounds == 14;
+    } /* if */
+    return okay;
+  } /* getKey */
+
+
+
+/**
+ *  Encrypt or decrypt 'data' with AES in GCM mode.
+ *  @param mode GCM_ENCRYPT or GCM_DECRYPT.
+ *  @return the processed data followed by the authentication tag
+ *          of the ciphertext.
+ */
+static striType gcmCrypt (const const_bstriType keyBstri,
+    const const_striType nonce, const const_striType aad,
+    const const_striType data, cryptModeType mode)
+
+  {
+    aesKeyRecord key;
+    ucharType counter[AES_BLOCK_SIZE];
+    ucharType tagMask[AES_BLOCK_SIZE];
+    ucharType hash[AES_BLOCK_SIZE];
+    ucharType tag[AES_BLOCK_SIZE];
+    unsigned int pos;
+    striType result;
+
+  /* gcmCrypt */
+    if (unlikely(!getKey(keyBstri, &key))) {
+      logError(printf("gcmCrypt(*, *, *, *, %d): Illegal AES key.\n", mode););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else if (unlikely(nonce->size != GCM_NONCE_SIZE ||
+                        memcpy_from_strelem(counter, nonce->mem, GCM_NONCE_SIZE))) {
+      logError(printf("gcmCrypt(*, \"%s\", *, *, %d): "
+                      "The nonce must consist of " FMT_U_MEM " bytes.\n",
+                      striAsUnquotedCStri(nonce), mode,
+                      (memSizeType) GCM_NONCE_SIZE););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else if (unlikely(data->size / AES_BLOCK_SIZE >= 0xfffffffe)) {
+      logError(printf("gcmCrypt(*, *, *, *, %d): "
+                      "Data length of " FMT_U_MEM " too big.\n",
+                      mode, data->size););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else if (unlikely(data->size > MAX_STRI_LEN - AES_BLOCK_SIZE ||
+                        !ALLOC_STRI_SIZE_OK(result, data->size + AES_BLOCK_SIZE))) {
+      raise_error(MEMORY_ERROR);
+      result = NULL;
+    } else {
+      result->size = data->size + AES_BLOCK_SIZE;
+      /* The counter block J0 encrypts the tag. */
+      storeBigEndian32(&counter[GCM_NONCE_SIZE], 1);
+      encryptBlock(&key, counter, tagMask);
+      storeBigEndian32(&counter[GCM_NONCE_SIZE], 2);
+      memset(hash, 0, AES_BLOCK_SIZE);
+      if (unlikely(!ghashStri(hash, key.hashKey, aad->mem, aad->size) ||
+                   !cryptStri(&key, mode, counter, hash, data->mem,
+                              result->mem, data->size))) {
+        logError(printf("gcmCrypt(*, *, *, *, %d): "
+                        "Character beyond '\\255;' in data.\n", mode););
+        FREE_STRI(result);
+        raise_error(RANGE_ERROR);
+        result = NULL;
+      } else {
+        storeBigEndian64(tag, (uint64Type) aad->size * 8);
+        storeBigEndian64(&tag[8], (uint64Type) data->size * 8);
+        ghashBytes(hash, key.hashKey, tag, AES_BLOCK_SIZE);
+        for (pos = 0; pos < AES_BLOCK_SIZE; pos++) {
+          tag[pos] = hash[pos] ^ tagMask[pos];
+        } /* for */
+        memcpy_to_strelem(&result->mem[data->size], tag, AES_BLOCK_SIZE);
+      } /* if */
+    } /* if */
+    return result;
+  } /* gcmCrypt */
+
+
+
+/**
+ *  Encrypt or decrypt 'data' with AES in CBC mode.
+ *  @param mode CBC_ENCODE or CBC_DECODE.
+ */
+static striType cbcCrypt (const const_bstriType keyBstri,
+    const const_striType iv, const const_striType data, cryptModeType mode)
+
+  {
+    aesKeyRecord key;
+    ucharType chainBlock[AES_BLOCK_SIZE];
+    striType result;
+
+  /* cbcCrypt */
+    if (unlikely(!getKey(keyBstri, &key))) {
+      logError(printf("cbcCrypt(*, *, *, %d): Illegal AES key.\n", mode););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else if (unlikely(iv->size != AES_BLOCK_SIZE ||
+                        memcpy_from_strelem(chainBlock, iv->mem, AES_BLOCK_SIZE))) {
+      logError(printf("cbcCrypt(*, \"%s\", *, %d): "
+                      "The IV must consist of " FMT_U_MEM " bytes.\n",
+                      striAsUnquotedCStri(iv), mode,
+                      (memSizeType) AES_BLOCK_SIZE););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else if (unlikely(data->size % AES_BLOCK_SIZE != 0)) {
+      logError(printf("cbcCrypt(*, *, *, %d): Data length of " FMT_U_MEM
+                      " is not a multiple of the block size.\n",
+                      mode, data->size););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else if (unlikely(!ALLOC_STRI_SIZE_OK(result, data->size))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      result->size = data->size;
+      if (unlikely(!cryptStri(&key, mode, chainBlock, NULL, data->mem,
+                              result->mem, data->size))) {
+        logError(printf("cbcCrypt(*, *, *, %d): "
+                        "Character beyond '\\255;' in data.\n", mode););
+        FREE_STRI(result);
+        raise_error(RANGE_ERROR);
+        result = NULL;
+      } /* if */
+    } /* if */
+    return result;
+  } /* cbcCrypt */
+
+
+
+/**
+ *  Decode 'encoded' with AES in CBC mode.
+ *  @param keyBstri Expanded key created with aesInit().
+ *  @param iv Initialization vector (the previous ciphertext block).
+ *  @return the decoded data.
+ *  @exception RANGE_ERROR If 'keyBstri' is not a valid key, if 'iv'
+ *             is not 16 bytes long, if the length of 'encoded' is not
+ *             a multiple of 16 or if a character is beyond '\255;'.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+striType aesCbcDecode (const const_bstriType keyBstri,
+    const const_striType iv, const const_striType encoded)
+
+  {
+    striType result;
+
+  /* aesCbcDecode */
+    logFunction(printf("aesCbcDecode(*, \"%s\", \"%s\")\n",
+                       striAsUnquotedCStri(iv),
+                       striAsUnquotedCStri(encoded)););
+    result = cbcCrypt(keyBstri, iv, encoded, CBC_DECODE);
+    logFunction(printf("aesCbcDecode --> \"%s\"\n",
+                       striAsUnquotedCStri(result)););
+    return result;
+  } /* aesCbcDecode */
+
+
+
+/**
+ *  Encode 'plaintext' with AES in CBC mode.
+ *  @param keyBstri Expanded key created with aesInit().
+ *  @param iv Initialization vector (the previous ciphertext block).
+ *  @return the encoded data.
+ *  @exception RANGE_ERROR If 'keyBstri' is not a valid key, if 'iv'
+ *             is not 16 bytes long, if the length of 'plaintext' is
+ *             not a multiple of 16 or if a character is beyond '\255;'.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+striType aesCbcEncode (const const_bstriType keyBstri,
+    const const_striType iv, const const_striType plaintext)
+
+  {
+    striType result;
+
+  /* aesCbcEncode */
+    logFunction(printf("aesCbcEncode(*, \"%s\", \"%s\")\n",
+                       striAsUnquotedCStri(iv),
+                       striAsUnquotedCStri(plaintext)););
+    result = cbcCrypt(keyBstri, iv, plaintext, CBC_ENCODE);
+    logFunction(printf("aesCbcEncode --> \"%s\"\n",
+                       striAsUnquotedCStri(result)););
+    return result;
+  } /* aesCbcEncode */
+
+
+
+/**
+ *  Decrypt 'encoded' with AES in GCM mode (NIST SP 800-38D).
+ *  The authentication tag is not checked. Instead the tag computed
+ *  from 'aad' and 'encoded' is returned. The caller compares it with
+ *  the received tag.
+ *  @param keyBstri Expanded key created with aesInit().
+ *  @param nonce Initialization vector with 12 bytes.
+ *  @param aad Additional authenticated data.
+ *  @param encoded Ciphertext without authentication tag.
+ *  @return the plaintext followed by the 16 byte computed tag.
+ *  @exception RANGE_ERROR If 'keyBstri' is not a valid key, if
+ *             'nonce' is not 12 bytes long or if a character is
+ *             beyond '\255;'.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+striType aesGcmDecrypt (const const_bstriType keyBstri,
+    const const_striType nonce, const const_striType aad,
+    const const_striType encoded)
+
+  {
+    striType result;
+
+  /* aesGcmDecrypt */
+    logFunction(printf("aesGcmDecrypt(*, \"%s\", ",
+                       striAsUnquotedCStri(nonce));
+                printf("\"%s\", ", striAsUnquotedCStri(aad));
+                printf("\"%s\")\n", striAsUnquotedCStri(encoded)););
+    result = gcmCrypt(keyBstri, nonce, aad, encoded, GCM_DECRYPT);
+    logFunction(printf("aesGcmDecrypt --> \"%s\"\n",
+                       striAsUnquotedCStri(result)););
+    return result;
+  } /* aesGcmDecrypt */
+
+
+
+/**
+ *  Encrypt 'plaintext' with AES in GCM mode (NIST SP 800-38D).
+ *  @param keyBstri Expanded key created with aesInit().
+ *  @param nonce Initialization vector with 12 bytes.
+ *  @param aad Additional authenticated data.
+ *  @return the ciphertext followed by the 16 byte authentication tag.
+ *  @exception RANGE_ERROR If 'keyBstri' is not a valid key, if
+ *             'nonce' is not 12 bytes long or if a character is
+ *             beyond '\255;'.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+striType aesGcmEncrypt (const const_bstriType keyBstri,
+    const const_striType nonce, const const_striType aad,
+    const const_striType plaintext)
+
+  {
+    striType result;
+
+  /* aesGcmEncrypt */
+    logFunction(printf("aesGcmEncrypt(*, \"%s\", ",
+                       striAsUnquotedCStri(nonce));
+                printf("\"%s\", ", striAsUnquotedCStri(aad));
+                printf("\"%s\")\n", striAsUnquotedCStri(plaintext)););
+    result = gcmCrypt(keyBstri, nonce, aad, plaintext, GCM_ENCRYPT);
+    logFunction(printf("aesGcmEncrypt --> \"%s\"\n",
+                       striAsUnquotedCStri(result)););
+    return result;
+  } /* aesGcmEncrypt */
+
+
+
+/**
+ *  Expand an AES key.
+ *  @param cipherKey Key with 16, 24 or 32 bytes (AES-128, AES-192
+ *         or AES-256).
+ *  @return the expanded key, which is stored in a bstring.
+ *  @exception RANGE_ERROR If 'cipherKey' has a different length or
+ *             contains a character beyond '\255;'.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+bstriType aesInit (const const_striType cipherKey)
+
+  {
+    ucharType keyBytes[32];
+    ucharType zeroBlock[AES_BLOCK_SIZE];
+    aesKeyRecord key;
+    bstriType result;
+
+  /* aesInit */
+    logFunction(printf("aesInit(*)\n"););
+    if (unlikely((cipherKey->size != 16 && cipherKey->size != 24 &&
+                  cipherKey->size != 32) ||
+                 memcpy_from_strelem(keyBytes, cipherKey->mem, cipherKey->size))) {
+      logError(printf("aesInit(*): Illegal key with length " FMT_U_MEM ".\n",
+                      cipherKey->size););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else if (unlikely(!ALLOC_BSTRI_SIZE_OK(result, sizeof(aesKeyRecord)))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      memset(&key, 0, sizeof(aesKeyRecord));
+      expandKey(&key, keyBytes, (unsigned int) cipherKey->size);
+      memset(zeroBlock, 0, AES_BLOCK_SIZE);
+      encryptBlock(&key, zeroBlock, key.hashKey);
+      result->size = sizeof(aesKeyRecord);
+      memcpy(result->mem, &key, sizeof(aesKeyRecord));
+    } /* if */
+    return result;
+  } /* aesInit */
@@ -0,0 +1,145 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Library                                                 */
+/*  File: seed7/src/aeslib.c                                        */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: All primitive actions for the AES cipher.              */
+/*                                                                  */
+/********************************************************************/
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+
+#include "common.h"
+#include "data.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "syvarutl.h"
+#include "objutl.h"
+#include "runerr.h"
+#include "aes_rtl.h"
+
+#undef EXTERN
+#define EXTERN
+#include "aeslib.h"
+
+
+
+/**
+ *  Decode encoded/arg_3 with AES in CBC mode.
+ *  The expanded key arg_1 and the initialization vector arg_2 are used.
+ *  @return the decoded data.
+ *  @exception RANGE_ERROR If arg_1 is not a valid key, if arg_2 is not
+ *             16 bytes long or if the length of arg_3 is not a
+ *             multiple of 16.
+ */
+objectType aes_cbc_decode (listType arguments)
+
+  { /* aes_cbc_decode */
+    isit_bstri(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    isit_stri(arg_3(arguments));
+    return bld_stri_temp(
+        aesCbcDecode(take_bstri(arg_1(arguments)), take_stri(arg_2(arguments)),
+                     take_stri(arg_3(arguments))));
+  } /* aes_cbc_decode */
+
+
+
+/**
+ *  Encode plaintext/arg_3 with AES in CBC mode.
+ *  The expanded key arg_1 and the initialization vector arg_2 are used.
+ *  @return the encoded data.
+ *  @exception RANGE_ERROR If arg_1 is not a valid key, if arg_2 is not
+ *             16 bytes long or if the length of arg_3 is not a
+ *             multiple of 16.
+ */
+objectType aes_cbc_encode (listType arguments)
+
+  { /* aes_cbc_encode */
+    isit_bstri(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    isit_stri(arg_3(arguments));
+    return bld_stri_temp(
+        aesCbcEncode(take_bstri(arg_1(arguments)), take_stri(arg_2(arguments)),
+                     take_stri(arg_3(arguments))));
+  } /* aes_cbc_encode */
+
+
+
+/**
+ *  Decrypt encoded/arg_4 with AES in GCM mode.
+ *  The expanded key arg_1, the nonce arg_2 and the additional
+ *  authenticated data arg_3 are used.
+ *  @return the plaintext followed by the computed authentication tag.
+ *  @exception RANGE_ERROR If arg_1 is not a valid key or if arg_2
+ *             is not 12 bytes long.
+ */
+objectType aes_gcm_decrypt (listType arguments)
+
+  { /* aes_gcm_decrypt */
+    isit_bstri(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    isit_stri(arg_3(arguments));
+    isit_stri(arg_4(arguments));
+    return bld_stri_temp(
+        aesGcmDecrypt(take_bstri(arg_1(arguments)), take_stri(arg_2(arguments)),
+                      take_stri(arg_3(arguments)), take_stri(arg_4(arguments))));
+  } /* aes_gcm_decrypt */
+
+
+
+/**
+ *  Encrypt plaintext/arg_4 with AES in GCM mode.
+ *  The expanded key arg_1, the nonce arg_2 and the additional
+ *  authenticated data arg_3 are used.
+ *  @return the ciphertext followed by the authentication tag.
+ *  @exception RANGE_ERROR If arg_1 is not a valid key or if arg_2
+ *             is not 12 bytes long.
+ */
+objectType aes_gcm_encrypt (listType arguments)
+
+  { /* aes_gcm_encrypt */
+    isit_bstri(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    isit_stri(arg_3(arguments));
+    isit_stri(arg_4(arguments));
+    return bld_stri_temp(
+        aesGcmEncrypt(take_bstri(arg_1(arguments)), take_stri(arg_2(arguments)),
+                      take_stri(arg_3(arguments)), take_stri(arg_4(arguments))));
+  } /* aes_gcm_encrypt */
+
+
+
+/**
+ *  Expand the AES key arg_1 with 16, 24 or 32 bytes.
+ *  @return the expanded key.
+ *  @exception RANGE_ERROR If arg_1 has a different length.
+ */
+objectType aes_init (listType arguments)
+
+  { /* aes_init */
+    isit_stri(arg_1(arguments));
+    return bld_bstri_temp(
+        aesInit(take_stri(arg_1(arguments))));
+  } /* aes_init */
@@ -0,0 +1,12 @@
+#define PATH_DELIMITER '/'
+#define OBJECT_FILE_EXTENSION ".o"
+#define C_COMPILER "gcc"
+#define CC_OPT_VERSION_INFO "--version"
+#define CC_FLAGS "-ffunction-sections -fdata-sections"
+#define CC_ERROR_FILEDES 2
+#define CC_VERSION_INFO_FILEDES 1
+#define LINKER_OPT_OUTPUT_FILE "-o "
+#define ARCHIVER "ar"
+#define ARCHIVER_OPT_REPLACE "r "
+#define SYSTEM_LIBS ""
+#define SYSTEM_MATH_LIBS "-lm"
@@ -0,0 +1,1028 @@
+/********************************************************************/
+/*                                                                  */
+/*  bz2_rtl.c     Bzip2 decompression.                              */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/bz2_rtl.c                                       */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: Bzip2 decompression.                                   */
+/*                                                                  */
+/*  The state of an incremental decompression is stored in a        */
+/*  bstring. It consists of a header, with the tables of the        */
+/*  current block, followed by the array used for the inverse       */
+/*  Burrows-Wheeler transform. The symbols of a block are decoded   */
+/*  one by one, as long as input is available. Afterwards the       */
+/*  block is written in pieces. Bits that have been read from the   */
+/*  input, but not used, are given back at the end of every step.   */
+/*  Only the bits of a partially used byte are kept in the state.   */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+
+#include "common.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "striutl.h"
+#include "mdg_rtl.h"
+#include "rtl_err.h"
+
+#undef EXTERN
+#define EXTERN
+#include "bz2_rtl.h"
+
+
+#define BLOCK_MAGIC      0x314159265359
+#define END_MAGIC        0x177245385090
+#define MAX_GROUPS       6
+#define MIN_GROUPS       2
+#define GROUP_SIZE       50
+#define MAX_ALPHA_SIZE   258
+#define MAX_CODE_LENGTH  20
+#define MAX_SELECTORS    18002
+#define FAST_BITS        10
+#define RUN_A            0
+#define RUN_B            1
+#define BLOCK_SIZE_UNIT  100000
+#define HEADER_SIZE      4
+
+#define MIN_OUTPUT_CHUNK   65536
+#define INITIAL_OUTPUT    131072
+
+#define MODE_STREAM_HEADER 0
+#define MODE_BLOCK_HEADER  1
+#define MODE_SYMBOLS       2
+#define MODE_OUTPUT        3
+#define MODE_FINISHED      4
+#define MODE_ERROR         5
+
+#define STATUS_RUNNING      0
+#define STATUS_OUTPUT_FULL  1
+#define STATUS_NEED_INPUT   2
+#define STATUS_FINISHED     3
+#define STATUS_DATA_ERROR   4
+#define STATUS_MEMORY_ERROR 5
+
+typedef struct {
+    uint32Type minLength;
+    uint32Type firstCode[MAX_CODE_LENGTH + 1];
+    uint32Type count[MAX_CODE_LENGTH + 1];
+    uint32Type offset[MAX_CODE_LENGTH + 1];
+    uint16Type perm[MAX_ALPHA_SIZE];
+    /* Symbol * 32 + length for codes with at most FAST_BITS bits. */
+    uint16Type fast[1 << FAST_BITS];
+  } bz2CodeRecord;
+
+typedef struct {
+    uint32Type mode;
+    uint32Type blockSizeMax;
+    uint32Type bitCount;
+    uint32Type storedBlockCrc;
+    uint32Type blockCrc;
+    uint32Type combinedCrc;
+    uint32Type origPtr;
+    uint32Type numInUse;
+    uint32Type alphaSize;
+    uint32Type numSelectors;
+    uint32Type groupIndex;
+    uint32Type groupPos;
+    uint32Type runLength;
+    uint32Type runWeight;
+    uint32Type blockLength;
+    uint32Type blockUsed;
+    uint32Type tPos;
+    uint32Type lastByte;
+    uint32Type sameBytes;
+    uint32Type pendingRun;
+    uint64Type bitBuffer;
+    uint32Type byteCount[256];
+    ucharType seqToUnseq[256];
+    ucharType mtf[256];
+    ucharType selectors[MAX_SELECTORS];
+    bz2CodeRecord codes[MAX_GROUPS];
+  } bz2StateRecord;
+
+#define STATE_AREA_SIZE ((sizeof(bz2StateRecord) + 7) & ~(memSizeType) 7)
+
+typedef struct {
+    bz2StateRecord state;
+    bstriType *stateBstri;
+    uint32Type *tt;
+    const ucharType *in;
+    memSizeType inLength;
+    memSizeType inPos;
+    boolType inputEnd;
+    ucharType *out;
+    memSizeType outPos;
+    memSizeType outCapacity;
+    memSizeType outTarget;
+  } bz2WorkRecord, *bz2WorkType;
+
+#define ALLOC_BZ2_WORK(var) (ALLOC_HEAP(var, bz2WorkType, sizeof(bz2WorkRecord))?CNT(CNT1_BYT(sizeof(bz2WorkRecord))) TRUE:FALSE)
+#define FREE_BZ2_WORK(var)  (CNT(CNT2_BYT(sizeof(bz2WorkRecord))) FREE_HEAP(var, sizeof(bz2WorkRecord)))
+#define REALLOC_UBYTES(var,byt) REALLOC_HEAP(var, ucharType *, byt)
+#define COUNT3_UBYTES(byt1,byt2) CNT3(CNT2_BYT(byt1), CNT1_BYT(byt2))
+
+
+
+static striType bytesToStri (const ucharType *bytes, memSizeType length)
+
+  {
+    striType result;
+
+  /* bytesToStri */
+    if (unlikely(!ALLOC_STRI_CHECK_SIZE(result, length))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      result->size = length;
+      memcpy_to_strelem(result->mem, bytes, length);
+    } /* if */
+    return result;
+  } /* bytesToStri */
+
+
+
+/**
+ *  Load bytes into the bit buffer until it contains at least 57 bits
+ *  or the input is exhausted.
+ */
+static inline void fillBits (bz2WorkType work)
+
+  { /* fillBits */
+    while (work->state.bitCount <= 56 && work->inPos < work->inLength) {
+      work->state.bitBuffer = work->state.bitBuffer << 8 | work->in[work->inPos];
+      work->inPos++;
+      work->state.bitCount += 8;
+    } /* while */
+  } /* fillBits */
+
+
+
+/**
+ *  Read 'numBits' bits (at most 32) from the input.
+ *  @return TRUE if the bits could be read, FALSE if the input
+ *          does not contain enough bits.
+ */
+static boolType getBits (bz2WorkType work, unsigned int numBits,
+    uint32Type *value)
+
+  {
+    boolType okay = TRUE;
+
+  /* getBits */
+    if (work->state.bitCount < numBits) {
+      fillBits(work);
+    } /* if */
+    if (work->state.bitCount < numBits) {
+      okay = FALSE;
+    } else {
+      work->state.bitCount -= numBits;
+      *value = (uint32Type) (work->state.bitBuffer >> work->state.bitCount) &
+               (uint32Type) (((uint64Type) 1 << numBits) - 1);
+    } /* if */
+    return okay;
+  } /* getBits */
+
+
+
+/**
+ *  Give whole bytes, which are in the bit buffer, back to the input.
+ *  These bytes have been loaded during the current step, since
+ *  every step ends with this function.
+ */
+static void returnBytes (bz2WorkType work)
+
+  {
+    uint32Type numBytes;
+
+  /* returnBytes */
+    numBytes = work->state.bitCount / 8;
+    /* Two shifts, since a shift by 64 bits is undefined. */
+    work->state.bitBuffer = (work->state.bitBuffer >> 4 * numBytes) >> 4 * numBytes;
+    work->state.bitCount -= 8 * numBytes;
+    work->inPos -= numBytes;
+  } /* returnBytes */
+
+
+
+/**
+ *  Compute the tables to decode the canonical Huffman code of a group.
+ *  @return TRUE if the code lengths are valid, FALSE otherwise.
+ */
+static boolType buildCode (bz2CodeRecord *code, const ucharType *lengths,
+    uint32Type alphaSize)
+
+  {
+    uint32Type symbol;
+    uint32Type length;
+    uint32Type nextCode;
+    uint32Type position;
+    uint32Type codeValue;
+    uint32Type fastIndex;
+    uint32Type fastEnd;
+    boolType okay = TRUE;
+
+  /* buildCode */
+    memset(code->count, 0, sizeof(code->count));
+    memset(code->fast, 0, sizeof(code->fast));
+    for (symbol = 0; symbol < alphaSize; symbol++) {
+      code->count[lengths[symbol]]++;
+    } /* for */
+    code->minLength = MAX_CODE_LENGTH;
+    nextCode = 0;
+    position = 0;
+    for (length = 1; length <= MAX_CODE_LENGTH; length++) {
+      code->firstCode[length] = nextCode;
+      code->offset[length] = position;
+      if (code->count[length] != 0 && length < code->minLength) {
+        code->minLength = length;
+      } /* if */
+      nextCode += code->count[length];
+      position += code->count[length];
+      if (nextCode > (uint32Type) 1 << length) {
+        /* The code is oversubscribed. */
+        okay = FALSE;
+      } /* if */
+      nextCode <<= 1;
+    } /* for */
+    if (okay) {
+      for (length = 1; length <= MAX_CODE_LENGTH; length++) {
+        codeValue = code->firstCode[length];
+        for (symbol = 0; symbol < alphaSize; symbol++) {
+          if (lengths[symbol] == length) {
+            code->perm[code->offset[length] + codeValue -
+                       code->firstCode[length]] = (uint16Type) symbol;
+            if (length <= FAST_BITS) {
+              fastIndex = codeValue << (FAST_BITS - length);
+              fastEnd = fastIndex + ((uint32Type) 1 << (FAST_BITS - length));
+              for (; fastIndex < fastEnd; fastIndex++) {
+                code->fast[fastIndex] = (uint16Type) (symbol << 5 | length);
+              } /* for */
+            } /* if */
+            codeValue++;
+          } /* if */
+        } /* for */
+      } /* for */
+    } /* if */
+    return okay;
+  } /* buildCode */
+
+
+
+static int readStreamHeader (bz2WorkType work)
+
+  {
+    const ucharType *data;
+    memSizeType size;
+    bstriType resized;
+    int status = STATUS_RUNNING;
+
+  /* readStreamHeader */
+    data = &work->in[work->inPos];
+    if (work->inLength - work->inPos < HEADER_SIZE) {
+      status = work->inputEnd ? STATUS_DATA_ERROR : STATUS_NEED_INPUT;
+    } else if (data[0] != 'B' || data[1] != 'Z' || data[2] != 'h' ||
+               data[3] < '1' || data[3] > '9') {
+      status = STATUS_DATA_ERROR;
+    } else {
+      work->state.blockSizeMax = (uint32Type) (data[3] - '0') * BLOCK_SIZE_UNIT;
+      size = STATE_AREA_SIZE + work->state.blockSizeMax * sizeof(uint32Type);
+      if ((*work->stateBstri)->size != size) {
+        REALLOC_BSTRI_SIZE_OK(resized, *work->stateBstri,
+                              (*work->stateBstri)->size, size);
+        if (unlikely(resized == NULL)) {
+          return STATUS_MEMORY_ERROR;
+        } else {
+          COUNT3_BSTRI((*work->stateBstri)->size, size);
+          resized->size = size;
+          *work->stateBstri = resized;
+        } /* if */
+      } /* if */
+      work->tt = (uint32Type *) &(*work->stateBstri)->mem[STATE_AREA_SIZE];
+      work->inPos += HEADER_SIZE;
+      work->state.mode = MODE_BLOCK_HEADER;
+    } /* if */
+    return status;
+  } /* readStreamHeader */
+
+
+
+/**
+ *  Read the block header with the tables of the block.
+ *  @return STATUS_RUNNING if the block header has been read,
+ *          STATUS_FINISHED if the end of the stream was found and
+ *          STATUS_NEED_INPUT if there is not enough input.
+ */
+static int parseBlockHeader (bz2WorkType work)
+
+  {
+    uint32Type magicHigh;
+    uint32Type magicLow;
+    uint32Type value;
+    uint32Type usedGroups;
+    uint32Type index;
+    uint32Type bit;
+    uint32Type numGroups;
+    uint32Type numSelectors;
+    uint32Type group;
+    uint32Type symbol;
+    uint32Type length;
+    ucharType groupMtf[MAX_GROUPS];
+    ucharType lengths[MAX_ALPHA_SIZE];
+    ucharType selector;
+
+  /* parseBlockHeader */
+    if (!getBits(work, 24, &magicHigh) || !getBits(work, 24, &magicLow)) {
+      return STATUS_NEED_INPUT;
+    } else if (((uint64Type) magicHigh << 24 | magicLow) == END_MAGIC) {
+      if (!getBits(work, 32, &value)) {
+        return STATUS_NEED_INPUT;
+      } else if (value != work->state.combinedCrc) {
+        logError(printf("bzip2: Combined CRC does not match.\n"););
+        return STATUS_DATA_ERROR;
+      } /* if */
+      /* The stream is padded to a byte boundary. */
+      work->state.bitCount -= work->state.bitCount % 8;
+      return STATUS_FINISHED;
+    } else if (((uint64Type) magicHigh << 24 | magicLow) != BLOCK_MAGIC) {
+      return STATUS_DATA_ERROR;
+    } /* if */
+    if (!getBits(work, 32, &work->state.storedBlockCrc) ||
+        !getBits(work, 1, &value) ||
+        !getBits(work, 24, &work->state.origPtr) ||
+        !getBits(work, 16, &usedGroups)) {
+      return STATUS_NEED_INPUT;
+    } else if (value != 0) {
+      /* Randomized blocks are deprecated and not supported. */
+      return STATUS_DATA_ERROR;
+    } /* if */
+    work->state.numInUse = 0;
+    for (index = 0; index < 16; index++) {
+      if ((usedGroups >> (15 - index)) & 1) {
+        for (bit = 0; bit < 16; bit++) {
+          if (!getBits(work, 1, &value)) {
+            return STATUS_NEED_INPUT;
+          } else if (value != 0) {
+            work->state.seqToUnseq[work->state.numInUse] =
+                (ucharType) (index * 16 + bit);
+            work->state.numInUse++;
+          } /* if */
+        } /* for */
+      } /* if */
+    } /* for */
+    if (work->state.numInUse == 0) {
+      return STATUS_DATA_ERROR;
+    } /* if */
+    work->state.alphaSize = work->state.numInUse + 2;
+    if (!getBits(work, 3, &numGroups) || !getBits(work, 15, &numSelectors)) {
+      return STATUS_NEED_INPUT;
+    } else if (numGroups < MIN_GROUPS || numGroups > MAX_GROUPS ||
+               numSelectors == 0) {
+      return STATUS_DATA_ERROR;
+    } /* if */
+    for (group = 0; group < numGroups; group++) {
+      groupMtf[group] = (ucharType) group;
+    } /* for */
+    for (index = 0; index < numSelectors; index++) {
+      group = 0;
+      do {
+        if (!getBits(work, 1, &value)) {
+          return STATUS_NEED_INPUT;
+        } /* if */
+        group += value;
+      } while (value != 0 && group < numGroups);
+      if (group >= numGroups) {
+        return STATUS_DATA_ERROR;
+      } /* if */
+      selector = groupMtf[group];
+      for (; group > 0; group--) {
+        groupMtf[group] = groupMtf[group - 1];
+      } /* for */
+      groupMtf[0] = selector;
+      /* Selectors beyond the maximum are read, but not used. */
+      if (index < MAX_SELECTORS) {
+        work->state.selectors[index] = selector;
+      } /* if */
+    } /* for */
+    work->state.numSelectors = numSelectors < MAX_SELECTORS ?
+                               numSelectors : MAX_SELECTORS;
+    for (group = 0; group < numGroups; group++) {
+      if (!getBits(work, 5, &length)) {
+        return STATUS_NEED_INPUT;
+      } /* if */
+      for (symbol = 0; symbol < work->state.alphaSize; symbol++) {
+        do {
+          if (length < 1 || length > MAX_CODE_LENGTH) {
+            return STATUS_DATA_ERROR;
+          } else if (!getBits(work, 1, &value)) {
+            return STATUS_NEED_INPUT;
+          } else if (value != 0) {
+            if (!getBits(work, 1, &bit)) {
+              return STATUS_NEED_INPUT;
+            } /* if */
+            length = bit == 0 ? length + 1 : length - 1;
+          } /* if */
+        } while (value != 0);
+        lengths[symbol] = (ucharType) length;
+      } /* for */
+      if (!buildCode(&work->state.codes[group], lengths, work->state.alphaSize)) {
+        return STATUS_DATA_ERROR;
+      } /* if */
+    } /* for */
+    for (index = 0; index < work->state.numSelectors; index++) {
+      if (work->state.selectors[index] >= numGroups) {
+        return STATUS_DATA_ERROR;
+      } /* if */
+    } /* for */
+    return STATUS_RUNNING;
+  } /* parseBlockHeader */
+
+
+
+/**
+ *  Read a block header or the end of the stream. The header is
+ *  only consumed if it is completely available.
+ */
+static int readBlockHeader (bz2WorkType work)
+
+  {
+    uint64Type bitBuffer;
+    uint32Type bitCount;
+    memSizeType inPos;
+    int status;
+
+  /* readBlockHeader */
+    bitBuffer = work->state.bitBuffer;
+    bitCount = work->state.bitCount;
+    inPos = work->inPos;
+    status = parseBlockHeader(work);
+    if (status == STATUS_NEED_INPUT) {
+      work->state.bitBuffer = bitBuffer;
+      work->state.bitCount = bitCount;
+      work->inPos = inPos;
+      if (work->inputEnd) {
+        status = STATUS_DATA_ERROR;
+      } /* if */
+    } else if (status == STATUS_FINISHED) {
+      work->state.mode = MODE_FINISHED;
+    } else if (status == STATUS_RUNNING) {
+      for (inPos = 0; inPos < 256; inPos++) {
+        work->state.mtf[inPos] = (ucharType) inPos;
+        work->state.byteCount[inPos] = 0;
+      } /* for */
+      work->state.groupIndex = 0;
+      work->state.groupPos = 0;
+      work->state.runLength = 0;
+      work->state.runWeight = 1;
+      work->state.blockLength = 0;
+      work->state.blockUsed = 0;
+      work->state.mode = MODE_SYMBOLS;
+    } /* if */
+    return status;
+  } /* readBlockHeader */
+
+
+
+/**
+ *  Prepare the inverse Burrows-Wheeler transform. The bytes of the
+ *  block are in the low 8 bits of 'tt'. The index of the following
+ *  byte is stored in the upper 24 bits.
+ */
+static int prepareOutput (bz2WorkType work)
+
+  {
+    uint32Type *tt;
+    uint32Type blockLength;
+    uint32Type index;
+    uint32Type sum = 0;
+    uint32Type count;
+    uint32Type start[256];
+
+  /* prepareOutput */
+    tt = work->tt;
+    blockLength = work->state.blockLength;
+    if (work->state.origPtr >= blockLength) {
+      return STATUS_DATA_ERROR;
+    } /* if */
+    for (index = 0; index < 256; index++) {
+      count = work->state.byteCount[index];
+      start[index] = sum;
+      sum += count;
+    } /* for */
+    for (index = 0; index < blockLength; index++) {
+      tt[start[tt[index] & 0xff]++] |= index << 8;
+    } /* for */
+    work->state.tPos = tt[work->state.origPtr] >> 8;
+    work->state.blockUsed = 0;
+    work->state.lastByte = 256;
+    work->state.sameBytes = 0;
+    work->state.pendingRun = 0;
+    work->state.blockCrc = 0;
+    work->state.mode = MODE_OUTPUT;
+    return STATUS_RUNNING;
+  } /* prepareOutput */
+
+
+
+/**
+ *  Decode the symbols of a block, until the end of block symbol
+ *  is found or the input is exhausted.
+ */
+static int decodeSymbols (bz2WorkType work)
+
+  {
+    uint32Type *tt;
+    ucharType *mtf;
+    bz2CodeRecord *code;
+    uint64Type bitBuffer;
+    uint32Type bitCount;
+    uint32Type peeked;
+    uint32Type entry;
+    uint32Type symbol;
+    uint32Type length;
+    uint32Type value;
+    uint32Type blockLength;
+    uint32Type endOfBlock;
+    ucharType byte;
+    int status = STATUS_RUNNING;
+
+  /* decodeSymbols */
+    tt = work->tt;
+    mtf = work->state.mtf;
+    blockLength = work->state.blockLength;
+    endOfBlock = work->state.numInUse + 1;
+    /* A partially decoded group continues with the selector before groupIndex. */
+    code = &work->state.codes[work->state.selectors[
+        work->state.groupIndex != 0 ? work->state.groupIndex - 1 : 0]];
+    while (status == STATUS_RUNNING) {
+      if (work->state.bitCount < MAX_CODE_LENGTH) {
+        fillBits(work);
+      } /* if */
+      bitBuffer = work->state.bitBuffer;
+      bitCount = work->state.bitCount;
+      if (bitCount < MAX_CODE_LENGTH && !work->inputEnd) {
+        status = STATUS_NEED_INPUT;
+      } else {
+        if (work->state.groupPos == 0) {
+          if (work->state.groupIndex >= work->state.numSelectors) {
+            return STATUS_DATA_ERROR;
+          } /* if */
+          code = &work->state.codes[work->state.selectors[work->state.groupIndex]];
+          work->state.groupIndex++;
+          work->state.groupPos = GROUP_SIZE;
+        } /* if */
+        /* Missing bits at the end of the input are zero. */
+        if (bitCount >= MAX_CODE_LENGTH) {
+          peeked = (uint32Type) (bitBuffer >> (bitCount - MAX_CODE_LENGTH)) &
+                   ((1 << MAX_CODE_LENGTH) - 1);
+        } else {
+          peeked = (uint32Type) (bitBuffer << (MAX_CODE_LENGTH - bitCount)) &
+                   ((1 << MAX_CODE_LENGTH) - 1);
+        } /* if */
+        entry = code->fast[peeked >> (MAX_CODE_LENGTH - FAST_BITS)];
+        if (entry != 0) {
+          symbol = entry >> 5;
+          length = entry & 31;
+        } else {
+          symbol = MAX_ALPHA_SIZE;
+          for (length = FAST_BITS + 1; length <= MAX_CODE_LENGTH &&
+               symbol == MAX_ALPHA_SIZE; length++) {
+            value = peeked >> (MAX_CODE_LENGTH - length);
+            if (value - code->firstCode[length] < code->count[length]) {
+              symbol = code->perm[code->offset[length] + value -
+                                  code->firstCode[length]];
+            } /* if */
+          } /* for */
+          length--;
+          if (symbol == MAX_ALPHA_SIZE) {
+            return STATUS_DATA_ERROR;
+          } /* if */
+        } /* if */
+        if (length > bitCount) {
+          return STATUS_DATA_ERROR;
+        } /* if */
+        work->state.bitCount = bitCount - length;
+        work->state.groupPos--;
+        if (symbol <= RUN_B) {
+          /* Bijective base 2 number of repetitions of the first byte. */
+          if (work->state.runWeight >= 1 << 21) {
+            return STATUS_DATA_ERROR;
+          } /* if */
+          work->state.runLength += work->state.runWeight << symbol;
+          work->state.runWeight <<= 1;
+        } else {
+          if (work->state.runLength != 0) {
+            byte = work->state.seqToUnseq[mtf[0]];
+            if (work->state.runLength > work->state.blockSizeMax - blockLength) {
+              return STATUS_DATA_ERROR;
+            } /* if */
+            work->state.byteCount[byte] += work->state.runLength;
+            for (; work->state.runLength != 0; work->state.runLength--) {
+              tt[blockLength] = byte;
+              blockLength++;
+            } /* for */
+            work->state.runWeight = 1;
+          } /* if */
+          if (symbol == endOfBlock) {
+            status = STATUS_FINISHED;
+          } else if (blockLength >= work->state.blockSizeMax) {
+            return STATUS_DATA_ERROR;
+          } else {
+            symbol--;
+            byte = mtf[symbol];
+            memmove(&mtf[1], &mtf[0], symbol);
+            mtf[0] = byte;
+            byte = work->state.seqToUnseq[byte];
+            work->state.byteCount[byte]++;
+            tt[blockLength] = byte;
+            blockLength++;
+          } /* if */
+        } /* if */
+        work->state.blockLength = blockLength;
+      } /* if */
+    } /* while */
+    if (status == STATUS_FINISHED) {
+      status = prepareOutput(work);
+    } /* if */
+    return status;
+  } /* decodeSymbols */
+
+
+
+/**
+ *  Make sure that at least one byte can be written to the output.
+ *  @return TRUE if the output has space, FALSE if there is not
+ *          enough memory.
+ */
+static boolType growOutput (bz2WorkType work)
+
+  {
+    memSizeType newCapacity;
+    ucharType *resized;
+    boolType okay = TRUE;
+
+  /* growOutput */
+    if (work->outPos == work->outCapacity) {
+      newCapacity = work->outCapacity * 2;
+      resized = REALLOC_UBYTES(work->out, newCapacity);
+      if (unlikely(resized == NULL)) {
+        okay = FALSE;
+      } else {
+        COUNT3_UBYTES(work->outCapacity, newCapacity);
+        work->out = resized;
+        work->outCapacity = newCapacity;
+      } /* if */
+    } /* if */
+    return okay;
+  } /* growOutput */
+
+
+
+/**
+ *  Write the bytes of the block to the output. The runs of 4 to 255
+ *  equal bytes are expanded.
+ */
+static int writeBlock (bz2WorkType work)
+
+  {
+    const uint32Type *tt;
+    ucharType *out;
+    memSizeType outPos;
+    memSizeType outEnd;
+    memSizeType startPos;
+    memSizeType count;
+    uint32Type tPos;
+    uint32Type blockUsed;
+    uint32Type blockLength;
+    uint32Type lastByte;
+    uint32Type sameBytes;
+    uint32Type byte;
+    int status = STATUS_RUNNING;
+
+  /* writeBlock */
+    tt = work->tt;
+    tPos = work->state.tPos;
+    blockUsed = work->state.blockUsed;
+    blockLength = work->state.blockLength;
+    lastByte = work->state.lastByte;
+    sameBytes = work->state.sameBytes;
+    startPos = work->outPos;
+    while (status == STATUS_RUNNING) {
+      if (work->outPos >= work->outTarget) {
+        status = STATUS_OUTPUT_FULL;
+      } else if (work->state.pendingRun == 0 && blockUsed == blockLength) {
+        status = STATUS_FINISHED;
+      } else if (!growOutput(work)) {
+        status = STATUS_MEMORY_ERROR;
+      } else {
+        out = work->out;
+        outPos = work->outPos;
+        outEnd = work->outCapacity;
+        if (outEnd > work->outTarget) {
+          outEnd = work->outTarget;
+        } /* if */
+        if (work->state.pendingRun != 0) {
+          count = outEnd - outPos;
+          if (count > work->state.pendingRun) {
+            count = work->state.pendingRun;
+          } /* if */
+          memset(&out[outPos], (int) lastByte, count);
+          outPos += count;
+          work->state.pendingRun -= (uint32Type) count;
+        } /* if */
+        while (outPos < outEnd && blockUsed < blockLength) {
+          tPos = tt[tPos];
+          byte = tPos & 0xff;
+          tPos >>= 8;
+          blockUsed++;
+          if (sameBytes == 4) {
+            /* After four equal bytes follows the number of repetitions. */
+            sameBytes = 0;
+            count = outEnd - outPos;
+            if (count > byte) {
+              count = byte;
+            } /* if */
+            memset(&out[outPos], (int) lastByte, count);
+            outPos += count;
+            work->state.pendingRun = (uint32Type) (byte - count);
+            if (work->state.pendingRun != 0) {
+              outEnd = outPos;
+            } /* if */
+          } else {
+            if (byte == lastByte) {
+              sameBytes++;
+            } else {
+              lastByte = byte;
+              sameBytes = 1;
+            } /* if */
+            out[outPos] = (ucharType) byte;
+            outPos++;
+          } /* if */
+        } /* while */
+        work->outPos = outPos;
+      } /* if */
+    } /* while */
+    work->state.tPos = tPos;
+    work->state.blockUsed = blockUsed;
+    work->state.lastByte = lastByte;
+    work->state.sameBytes = sameBytes;
+    work->state.blockCrc = mdgBzip2Crc32Bytes(work->state.blockCrc,
+        &work->out[startPos], work->outPos - startPos);
+    if (status == STATUS_FINISHED) {
+      if (work->state.blockCrc != work->state.storedBlockCrc) {
+        logError(printf("bzip2: Block CRC does not match.\n"););
+        status = STATUS_DATA_ERROR;
+      } else {
+        work->state.combinedCrc = (work->state.combinedCrc << 1 |
+                                   work->state.combinedCrc >> 31) ^
+                                  work->state.blockCrc;
+        work->state.mode = MODE_BLOCK_HEADER;
+        status = STATUS_RUNNING;
+      } /* if */
+    } /* if */
+    return status;
+  } /* writeBlock */
+
+
+
+static int runBzip2 (bz2WorkType work)
+
+  {
+    int status = STATUS_RUNNING;
+
+  /* runBzip2 */
+    while (status == STATUS_RUNNING) {
+      switch (work->state.mode) {
+        case MODE_STREAM_HEADER: status = readStreamHeader(work); break;
+        case MODE_BLOCK_HEADER:  status = readBlockHeader(work);  break;
+        case MODE_SYMBOLS:       status = decodeSymbols(work);    break;
+        case MODE_OUTPUT:        status = writeBlock(work);       break;
+        default:                 status = STATUS_FINISHED;        break;
+      } /* switch */
+    } /* while */
+    return status;
+  } /* runBzip2 */
+
+
+
+/**
+ *  Copy the bzip2 state stored in the bstring 'stateBstri' to 'state'.
+ *  @return TRUE if 'stateBstri' contains a valid state, FALSE otherwise.
+ */
+static boolType getBzip2State (const const_bstriType stateBstri,
+    bz2StateRecord *state)
+
+  {
+    boolType okay = FALSE;
+
+  /* getBzip2State */
+    if (stateBstri->size >= STATE_AREA_SIZE) {
+      memcpy(state, stateBstri->mem, sizeof(bz2StateRecord));
+      okay = state->mode <= MODE_ERROR && state->bitCount < 8 &&
+             state->blockSizeMax <= 9 * BLOCK_SIZE_UNIT &&
+             state->blockLength <= state->blockSizeMax &&
+             state->blockUsed <= state->blockLength &&
+             state->numInUse <= 256 && state->alphaSize <= MAX_ALPHA_SIZE &&
+             state->numSelectors <= MAX_SELECTORS &&
+             state->groupPos <= GROUP_SIZE &&
+             state->pendingRun <= 255;
+      if (okay && state->mode != MODE_STREAM_HEADER) {
+        okay = stateBstri->size == STATE_AREA_SIZE +
+                                   state->blockSizeMax * sizeof(uint32Type);
+      } /* if */
+      if (okay && state->mode == MODE_SYMBOLS) {
+        okay = state->groupIndex <= state->numSelectors &&
+               state->numInUse != 0;
+      } else if (okay && state->mode == MODE_OUTPUT) {
+        okay = state->tPos < state->blockLength;
+      } /* if */
+    } /* if */
+    return okay;
+  } /* getBzip2State */
+
+
+
+/**
+ *  Create a state for the incremental decompression of a bzip2 stream.
+ *  @return the bzip2 state, which is stored in a bstring.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+bstriType bz2DecodeInit (void)
+
+  {
+    bstriType result;
+
+  /* bz2DecodeInit */
+    logFunction(printf("bz2DecodeInit\n"););
+    if (unlikely(!ALLOC_BSTRI_SIZE_OK(result, STATE_AREA_SIZE))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      result->size = STATE_AREA_SIZE;
+      memset(result->mem, 0, STATE_AREA_SIZE);
+    } /* if */
+    return result;
+  } /* bz2DecodeInit */
+
+
+
+/**
+ *  Determine if the end of the bzip2 stream has been reached.
+ *  @param stateBstri Bzip2 state created with bz2DecodeInit().
+ *  @return TRUE if the stream has been decompressed completely,
+ *          FALSE otherwise.
+ *  @exception RANGE_ERROR If 'stateBstri' is not a valid bzip2 state.
+ */
+boolType bz2DecodeFinished (const const_bstriType stateBstri)
+
+  {
+    bz2StateRecord state;
+    boolType finished;
+
+  /* bz2DecodeFinished */
+    if (unlikely(!getBzip2State(stateBstri, &state))) {
+      logError(printf("bz2DecodeFinished(*): Illegal bzip2 state.\n"););
+      raise_error(RANGE_ERROR);
+      finished = FALSE;
+    } else {
+      finished = state.mode == MODE_FINISHED;
+    } /* if */
+    return finished;
+  } /* bz2DecodeFinished */
+
+
+
+/**
+ *  Decompress bzip2 data from 'compressed' starting at '*bytePos'.
+ *  Decompression continues until at least 'minLength' bytes have
+ *  been produced, the end of the stream is reached or more input is
+ *  needed. Afterwards '*bytePos' refers to the first byte that has
+ *  not been consumed. At the end of the stream it refers to the
+ *  first byte after the stream.
+ *  @param stateBstri Variable with a bzip2 state created with
+ *         bz2DecodeInit(). The state grows, when the block size is
+ *         known.
+ *  @param inputEnd TRUE if no data follows after 'compressed'.
+ *  @param minLength Minimum length of the result.
+ *  @return the decompressed bytes.
+ *  @exception RANGE_ERROR If the state is not valid, if 'compressed'
+ *             is not in bzip2 format or if it contains a character
+ *             beyond '\255;'. The state cannot be used afterwards.
+ *  @exception INDEX_ERROR If '*bytePos' is not in the range 1 to
+ *             length(compressed) + 1.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+striType bz2DecodeStep (bstriType *const stateBstri,
+    const const_striType compressed, intType *const bytePos,
+    boolType inputEnd, intType minLength)
+
+  {
+    bz2WorkType work;
+    ucharType *inBuffer = NULL;
+    memSizeType inLength;
+    int status;
+    striType result = NULL;
+
+  /* bz2DecodeStep */
+    logFunction(printf("bz2DecodeStep(*, \"%s\", " FMT_D ", %d, " FMT_D ")\n",
+                       striAsUnquotedCStri(compressed), *bytePos,
+                       inputEnd, minLength););
+    if (unlikely(*bytePos < 1 ||
+                 (uintType) *bytePos - 1 > compressed->size)) {
+      logError(printf("bz2DecodeStep: Byte position " FMT_D
+                      " not in range 1 .. " FMT_U_MEM ".\n",
+                      *bytePos, compressed->size + 1););
+      raise_error(INDEX_ERROR);
+    } else if (unlikely(minLength < 0)) {
+      logError(printf("bz2DecodeStep: Negative minimum length.\n"););
+      raise_error(RANGE_ERROR);
+    } else if (unlikely(!ALLOC_BZ2_WORK(work))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      if (unlikely(!getBzip2State(*stateBstri, &work->state) ||
+                   work->state.mode == MODE_ERROR)) {
+        logError(printf("bz2DecodeStep: Illegal bzip2 state.\n"););
+        raise_error(RANGE_ERROR);
+      } else if (work->state.mode == MODE_FINISHED) {
+        result = bytesToStri(NULL, 0);
+      } else {
+        inLength = compressed->size - (memSizeType) (*bytePos - 1);
+        /* One more byte, such that the allocation size is never zero. */
+        if (unlikely(inLength == MAX_MEMSIZETYPE ||
+                     !ALLOC_UBYTES(inBuffer, inLength + 1))) {
+          raise_error(MEMORY_ERROR);
+        } else if (unlikely(memcpy_from_strelem(inBuffer,
+                                                &compressed->mem[*bytePos - 1],
+                                                inLength))) {
+          logError(printf("bz2DecodeStep: "
+                          "Character beyond '\\255;' in data.\n"););
+          raise_error(RANGE_ERROR);
+        } else {
+          work->stateBstri = stateBstri;
+          work->tt = (uint32Type *) &(*stateBstri)->mem[STATE_AREA_SIZE];
+          work->in = inBuffer;
+          work->inLength = inLength;
+          work->inPos = 0;
+          work->inputEnd = inputEnd;
+          work->outTarget = (memSizeType) minLength;
+          if (work->outTarget < MIN_OUTPUT_CHUNK) {
+            work->outTarget = MIN_OUTPUT_CHUNK;
+          } /* if */
+          work->outCapacity = INITIAL_OUTPUT;
+          work->outPos = 0;
+          if (unlikely(!ALLOC_UBYTES(work->out, work->outCapacity))) {
+            raise_error(MEMORY_ERROR);
+          } else {
+            status = runBzip2(work);
+            if (status == STATUS_MEMORY_ERROR || status == STATUS_DATA_ERROR) {
+              work->state.mode = MODE_ERROR;
+              memcpy((*stateBstri)->mem, &work->state, sizeof(bz2StateRecord));
+              raise_error(status == STATUS_MEMORY_ERROR ? MEMORY_ERROR :
+                                                          RANGE_ERROR);
+            } else {
+              returnBytes(work);
+              result = bytesToStri(work->out, work->outPos);
+              if (result != NULL) {
+                *bytePos += (intType) work->inPos;
+                memcpy((*stateBstri)->mem, &work->state, sizeof(bz2StateRecord));
+              } /* if */
+            } /* if */
+            FREE_BYTES(work->out, work->outCapacity);
+          } /* if */
+        } /* if */
+        if (inBuffer != NULL) {
+          FREE_BYTES(inBuffer, inLength + 1);
+        } /* if */
+      } /* if */
+      FREE_BZ2_WORK(work);
+    } /* if */
+    logFunction(printf("bz2DecodeStep --> \"%s\" (bytePos=" FMT_D ")\n",
+                       striAsUnquotedCStri(result), *bytePos););
+    return result;
+  } /* bz2DecodeStep */
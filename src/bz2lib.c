@@ -0,0 +1,112 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Library                                                 */
+/*  File: seed7/src/bz2lib.c                                        */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: All primitive actions for bzip2 decompression.         */
+/*                                                                  */
+/********************************************************************/
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+
+#include "common.h"
+#include "data.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "syvarutl.h"
+#include "objutl.h"
+#include "runerr.h"
+#include "bz2_rtl.h"
+
+#undef EXTERN
+#define EXTERN
+#include "bz2lib.h"
+
+
+
+/**
+ *  Determine if the bzip2 state arg_1 reached the end of the stream.
+ *  @return TRUE if the stream has been decompressed completely,
+ *          FALSE otherwise.
+ *  @exception RANGE_ERROR If arg_1 is not a valid bzip2 state.
+ */
+objectType bz2_decode_finished (listType arguments)
+
+  { /* bz2_decode_finished */
+    isit_bstri(arg_1(arguments));
+    if (bz2DecodeFinished(take_bstri(arg_1(arguments)))) {
+      return SYS_TRUE_OBJECT;
+    } else {
+      return SYS_FALSE_OBJECT;
+    } /* if */
+  } /* bz2_decode_finished */
+
+
+
+/**
+ *  Create a state for the decompression of a bzip2 stream.
+ *  @return the new bzip2 state.
+ */
+objectType bz2_decode_init (listType arguments)
+
+  { /* bz2_decode_init */
+    return bld_bstri_temp(bz2DecodeInit());
+  } /* bz2_decode_init */
+
+
+
+/**
+ *  Decompress compressed/arg_2 starting at bytePos/arg_3 with the
+ *  bzip2 state arg_1. The variable bytePos/arg_3 is advanced behind
+ *  the consumed bytes. If inputEnd/arg_4 is TRUE no data follows
+ *  after arg_2. At least minLength/arg_5 bytes are produced, if the
+ *  data and the input allow it.
+ *  @return the decompressed bytes.
+ *  @exception RANGE_ERROR If arg_1 is not a valid bzip2 state or
+ *             if arg_2 is not in bzip2 format.
+ *  @exception INDEX_ERROR If bytePos/arg_3 is not in the range
+ *             1 to length(arg_2) + 1.
+ */
+objectType bz2_decode_step (listType arguments)
+
+  {
+    objectType stateVar;
+    objectType bytePosVar;
+
+  /* bz2_decode_step */
+    stateVar = arg_1(arguments);
+    isit_bstri(stateVar);
+    is_variable(stateVar);
+    isit_stri(arg_2(arguments));
+    bytePosVar = arg_3(arguments);
+    isit_int(bytePosVar);
+    is_variable(bytePosVar);
+    isit_bool(arg_4(arguments));
+    isit_int(arg_5(arguments));
+    return bld_stri_temp(
+        bz2DecodeStep(&stateVar->value.bstriValue, take_stri(arg_2(arguments)),
+                      &bytePosVar->value.intValue,
+                      take_bool(arg_4(arguments)) == SYS_TRUE_OBJECT,
+                      take_int(arg_5(arguments))));
+  } /* bz2_decode_step */
@@ -4219,6 +4219,109 @@ static void numericProperties (FILE *versionFile)
 
 
 
+static void determineVectorInstructions (FILE *versionFile)
+
+  {
+    int sse2Okay;
+    int avx2Okay = 0;
+    int shaOkay = 0;
+    int pclmulOkay = 0;
+    int aesniOkay = 0;
+
+  /* determineVectorInstructions */
+    sse2Okay = compileAndLinkOk("#include <stdio.h>\n#include <emmintrin.h>\n"
+                                "int main(int argc, char *argv[]){\n"
+                                "unsigned char in[16] = \"abcdefghijklmno\";\n"
+                                "unsigned int out[4];\n"
+                                "__m128i bytes, zero = _mm_setzero_si128();\n"
+                                "in[3] = 0x80;\n"
+                                "bytes = _mm_loadu_si128((const __m128i *) in);\n"
+                                "_mm_storeu_si128((__m128i *) out,\n"
+                                "    _mm_unpacklo_epi16(_mm_unpacklo_epi8(bytes, zero), zero));\n"
+                                "printf(\"%d\\n\", _mm_movemask_epi8(bytes) == 8 &&\n"
+                                "    out[0] == 'a' && out[3] == 0x80);\n"
+                                "return 0;}\n") &&
+               doTest() == 1;
+    fprintf(versionFile, "#define HAS_SSE2_INTRINSICS %d\n", sse2Okay);
+    if (sse2Okay) {
+      /* AVX2 functions are compiled with a target attribute and */
+      /* they are only called if the CPU supports AVX2.          */
+      avx2Okay = compileAndLinkOk("#include <stdio.h>\n#include <immintrin.h>\n"
+                                  "__attribute__((target(\"avx2\")))\n"
+                                  "static int avx2Test (const unsigned char *in) {\n"
+                                  "unsigned int out[8];\n"
+                                  "__m256i bytes = _mm256_loadu_si256((const __m256i *) in);\n"
+                                  "_mm256_storeu_si256((__m256i *) out,\n"
+                                  "    _mm256_cvtepu8_epi32(_mm256_castsi256_si128(bytes)));\n"
+                                  "return _mm256_movemask_epi8(bytes) == 8 && out[3] == 0x80;}\n"
+                                  "int main(int argc, char *argv[]){\n"
+                                  "unsigned char in[32] = \"abcdefghijklmnopqrstuvwxyz01234\";\n"
+                                  "in[3] = 0x80;\n"
+                                  "__builtin_cpu_init();\n"
+                                  "printf(\"%d\\n\", !__builtin_cpu_supports(\"avx2\") ||\n"
+                                  "    avx2Test(in));\n"
+                                  "return 0;}\n") &&
+                 doTest() == 1;
+    } /* if */
+    fprintf(versionFile, "#define HAS_AVX2_INTRINSICS %d\n", avx2Okay);
+    if (sse2Okay) {
+      /* SHA functions are compiled with a target attribute and */
+      /* they are only called if the CPU supports SHA.          */
+      shaOkay = compileAndLinkOk("#include <stdio.h>\n#include <immintrin.h>\n"
+                                 "__attribute__((target(\"sha,sse4.1\")))\n"
+                                 "static int shaTest (void) {\n"
+                                 "__m128i zero = _mm_setzero_si128();\n"
+                                 "__m128i msg = _mm_set_epi32(4, 3, 2, 1);\n"
+                                 "__m128i rounds = _mm_sha256rnds2_epu32(zero, zero, zero);\n"
+                                 "msg = _mm_sha1nexte_epu32(rounds, msg);\n"
+                                 "return _mm_extract_epi32(msg, 3) == 4;}\n"
+                                 "int main(int argc, char *argv[]){\n"
+                                 "__builtin_cpu_init();\n"
+                                 "printf(\"%d\\n\", !__builtin_cpu_supports(\"sha\") ||\n"
+                                 "    shaTest());\n"
+                                 "return 0;}\n") &&
+                doTest() == 1;
+    } /* if */
+    fprintf(versionFile, "#define HAS_SHA_INTRINSICS %d\n", shaOkay);
+    if (sse2Okay) {
+      /* PCLMUL functions are compiled with a target attribute and */
+      /* they are only called if the CPU supports PCLMUL.          */
+      pclmulOkay = compileAndLinkOk("#include <stdio.h>\n#include <immintrin.h>\n"
+                                    "__attribute__((target(\"pclmul,sse4.1\")))\n"
+                                    "static int pclmulTest (void) {\n"
+                                    "__m128i a = _mm_set_epi64x(0, 3);\n"
+                                    "__m128i b = _mm_set_epi64x(0, 5);\n"
+                                    "__m128i product = _mm_clmulepi64_si128(a, b, 0x00);\n"
+                                    "return _mm_extract_epi32(product, 0) == 15;}\n"
+                                    "int main(int argc, char *argv[]){\n"
+                                    "__builtin_cpu_init();\n"
+                                    "printf(\"%d\\n\", !__builtin_cpu_supports(\"pclmul\") ||\n"
+                                    "    pclmulTest());\n"
+                                    "return 0;}\n") &&
+                   doTest() == 1;
+    } /* if */
+    fprintf(versionFile, "#define HAS_PCLMUL_INTRINSICS %d\n", pclmulOkay);
+    if (pclmulOkay) {
+      /* AES-NI functions are compiled with a target attribute and */
+      /* they are only called if the CPU supports AES and PCLMUL.  */
+      aesniOkay = compileAndLinkOk("#include <stdio.h>\n#include <immintrin.h>\n"
+                                   "__attribute__((target(\"aes,pclmul,ssse3,sse4.1\")))\n"
+                                   "static int aesniTest (void) {\n"
+                                   "__m128i zero = _mm_setzero_si128();\n"
+                                   "__m128i state = _mm_aesenclast_si128(zero, zero);\n"
+                                   "return _mm_extract_epi32(state, 0) == 0x63636363;}\n"
+                                   "int main(int argc, char *argv[]){\n"
+                                   "__builtin_cpu_init();\n"
+                                   "printf(\"%d\\n\", !__builtin_cpu_supports(\"aes\") ||\n"
+                                   "    aesniTest());\n"
+                                   "return 0;}\n") &&
+                  doTest() == 1;
+    } /* if */
+    fprintf(versionFile, "#define HAS_AESNI_INTRINSICS %d\n", aesniOkay);
+  } /* determineVectorInstructions */
+
+
+
 static void determineMallocProperties (FILE *versionFile)
 
   {
@@ -11312,6 +11415,81 @@ static void writeReadBufferEmptyMacro (FILE *versionFile)
 
 
 
+static void writeReadBufferAccessMacros (FILE *versionFile)
+
+  {
+    const char *define_read_buffer_access;
+    char buffer[2 * BUFFER_SIZE];
+
+  /* writeReadBufferAccessMacros */
+    if (compileAndLinkOk("#include<stdio.h>\nint main(int argc,char *argv[])\n"
+                         "{FILE*fp;fp->_IO_read_ptr+=fp->_IO_read_end-fp->_IO_read_ptr;return 0;}\n")) {
+      define_read_buffer_access =
+          "#define read_buffer_ptr(fp) ((const unsigned char *) (fp)->_IO_read_ptr)\n"
+          "#define read_buffer_avail(fp) ((size_t) ((fp)->_IO_read_end - (fp)->_IO_read_ptr))\n"
+          "#define read_buffer_skip(fp, n) ((fp)->_IO_read_ptr += (n))";
+    } else if (compileAndLinkOk("#include<stdio.h>\nint main(int argc,char *argv[])\n"
+                                "{FILE*fp;fp->_p+=fp->_r;fp->_r=0;return 0;}\n")) {
+      define_read_buffer_access =
+          "#define read_buffer_ptr(fp) ((const unsigned char *) (fp)->_p)\n"
+          "#define read_buffer_avail(fp) ((fp)->_r > 0 ? (size_t) (fp)->_r : 0)\n"
+          "#define read_buffer_skip(fp, n) ((fp)->_p += (n), (fp)->_r -= (int) (n))";
+    } else if (compileAndLinkOk("#include<stdio.h>\n"
+                                "typedef struct {unsigned flags; unsigned char *rpos, *rend;} MY_READ_FILE;\n"
+                                "int main(int argc,char *argv[])\n"
+                                "{FILE*fp;((MY_READ_FILE*)(fp))->rpos+=((MY_READ_FILE*)(fp))->rend-"
+                                "((MY_READ_FILE*)(fp))->rpos;return 0;}\n")) {
+      define_read_buffer_access =
+          "typedef struct {unsigned flags; unsigned char *rpos, *rend;} MY_READ_FILE;\n"
+          "#define read_buffer_ptr(fp) ((const unsigned char *) ((MY_READ_FILE*)(fp))->rpos)\n"
+          "#define read_buffer_avail(fp) ((size_t) (((MY_READ_FILE*)(fp))->rend - ((MY_READ_FILE*)(fp))->rpos))\n"
+          "#define read_buffer_skip(fp, n) (((MY_READ_FILE*)(fp))->rpos += (n))";
+    } else {
+      define_read_buffer_access = NULL;
+    } /* if */
+    if (define_read_buffer_access != NULL) {
+      sprintf(buffer,
+              "#include<stdio.h>\n"
+              "%s\n"
+              "int main(int argc,char *argv[]){\n"
+              "FILE *aFile;\n"
+              "aFile = fopen(\"ctstfile.txt\", \"w\");\n"
+              "if (aFile != NULL) {\n"
+              "  fputs(\"abcdefghijklmnopqrstuvwxyz\\n\", aFile);\n"
+              "  fclose(aFile);\n"
+              "}\n"
+              "aFile = fopen(\"ctstfile.txt\", \"rb\");\n"
+              "if (aFile == NULL) {\n"
+              "  puts(\"0\");\n"
+              "} else {\n"
+              "  if (getc(aFile) != 'a' || read_buffer_avail(aFile) != 26 ||\n"
+              "      read_buffer_ptr(aFile)[0] != 'b') {\n"
+              "    puts(\"0\");\n"
+              "  } else {\n"
+              "    read_buffer_skip(aFile, 3);\n"
+              "    printf(\"%%d\\n\", getc(aFile) == 'e' &&\n"
+              "           read_buffer_avail(aFile) == 22 &&\n"
+              "           read_buffer_ptr(aFile)[0] == 'f');\n"
+              "  }\n"
+              "  fclose(aFile);\n"
+              "}\n"
+              "return 0;}\n", define_read_buffer_access);
+      if (!compileAndLinkOk(buffer) || doTest() != 1) {
+        fprintf(logFile, "\n *** The macro read_buffer_skip does not work.\n");
+        define_read_buffer_access = NULL;
+      } /* if */
+      doRemove("ctstfile.txt");
+    } else {
+      fprintf(logFile, "\n *** Could not define macro read_buffer_skip.\n");
+    } /* if */
+    if (define_read_buffer_access != NULL) {
+      fprintf(versionFile, "%s\n", define_read_buffer_access);
+      fprintf(logFile, "\rMacro read_buffer_skip defined.\n");
+    } /* if */
+  } /* writeReadBufferAccessMacros */
+
+
+
 #ifdef OS_STRI_USES_CODE_PAGE
 static int getCodePage (void)
 
@@ -11686,6 +11864,7 @@ int main (int argc, char **argv)
 #endif
     fprintf(logFile, " determined\n");
     numericProperties(versionFile);
+    determineVectorInstructions(versionFile);
     fprintf(logFile, "Advanced settings: ");
     fflush(logFile);
     determineMallocProperties(versionFile);
@@ -11958,14 +12137,86 @@ int main (int argc, char **argv)
                          "{struct pollfd pollFd[1];\n"
                          "poll(pollFd, 1, 0);\n"
                          "return 0;}\n"));
+    fprintf(versionFile, "#define HAS_EPOLL %d\n",
+        compileAndLinkOk("#include<sys/epoll.h>\n#include<stddef.h>\n"
+                         "int main(int argc,char *argv[])\n"
+                         "{struct epoll_event event;\n"
+                         "int epollFd = epoll_create1(EPOLL_CLOEXEC);\n"
+                         "event.events = EPOLLIN | EPOLLOUT;\n"
+                         "event.data.fd = 0;\n"
+                         "epoll_ctl(epollFd, EPOLL_CTL_ADD, 0, &event);\n"
+                         "epoll_wait(epollFd, &event, 1, 0);\n"
+                         "return 0;}\n"));
+    fprintf(versionFile, "#define HAS_UCONTEXT %d\n",
+        expectTestResult("#include<stdio.h>\n#include<stdlib.h>\n#include<setjmp.h>\n"
+                         "#include<ucontext.h>\n"
+                         "ucontext_t coContext;\n"
+                         "jmp_buf mainBuffer, coBuffer;\n"
+                         "int counter = 0;\n"
+                         "void coFunc (void) {\n"
+                         "counter++;\n"
+                         "if (_setjmp(coBuffer) == 0) _longjmp(mainBuffer, 1);\n"
+                         "counter++;\n"
+                         "_longjmp(mainBuffer, 1);\n"
+                         "}\n"
+                         "int main(int argc,char *argv[])\n"
+                         "{char *stack = (char *) malloc(65536);\n"
+                         "getcontext(&coContext);\n"
+                         "coContext.uc_stack.ss_sp = stack;\n"
+                         "coContext.uc_stack.ss_size = 65536;\n"
+                         "coContext.uc_link = NULL;\n"
+                         "makecontext(&coContext, coFunc, 0);\n"
+                         "if (_setjmp(mainBuffer) == 0) setcontext(&coContext);\n"
+                         "if (_setjmp(mainBuffer) == 0) _longjmp(coBuffer, 1);\n"
+                         "printf(\"%d\\n\", counter == 2);\n"
+                         "return 0;}\n", 1));
     fprintf(versionFile, "#define HAS_MMAP %d\n",
         compileAndLinkOk("#include<stddef.h>\n#include<sys/mman.h>\n"
                          "int main(int argc,char *argv[])\n"
                          "{mmap(NULL, 12345, PROT_READ, MAP_PRIVATE, 3, 0);\n"
                          "return 0;}\n"));
+    fprintf(versionFile, "#define HAS_POSIX_MADVISE %d\n",
+        compileAndLinkOk("#include<stddef.h>\n#include<sys/mman.h>\n"
+                         "int main(int argc,char *argv[])\n"
+                         "{char buffer[12345];\n"
+                         "posix_madvise(buffer, 12345, POSIX_MADV_SEQUENTIAL);\n"
+                         "posix_madvise(buffer, 12345, POSIX_MADV_RANDOM);\n"
+                         "posix_madvise(buffer, 12345, POSIX_MADV_WILLNEED);\n"
+                         "return 0;}\n"));
+    fprintf(versionFile, "#define HAS_COPY_FILE_RANGE %d\n",
+        compileAndLinkOk("#define _GNU_SOURCE\n#include<stddef.h>\n#include<unistd.h>\n"
+                         "int main(int argc,char *argv[])\n"
+                         "{copy_file_range(3, NULL, 4, NULL, 12345, 0);\n"
+                         "return 0;}\n"));
+    fprintf(versionFile, "#define HAS_SENDFILE %d\n",
+        compileAndLinkOk("#include<stddef.h>\n#include<sys/sendfile.h>\n"
+                         "int main(int argc,char *argv[])\n"
+                         "{sendfile(4, 3, NULL, 12345);\n"
+                         "return 0;}\n"));
+    fprintf(versionFile, "#define HAS_ACCEPT4 %d\n",
+        compileAndLinkOk("#define _GNU_SOURCE\n#include<stddef.h>\n#include<sys/socket.h>\n"
+                         "int main(int argc,char *argv[])\n"
+                         "{accept4(3, NULL, NULL, SOCK_CLOEXEC);\n"
+                         "return 0;}\n"));
+    fprintf(versionFile, "#define HAS_FSTATAT %d\n",
+        compileAndLinkOk("#include<stddef.h>\n#include<unistd.h>\n#include<fcntl.h>\n"
+                         "#include<sys/types.h>\n#include<sys/stat.h>\n#include<dirent.h>\n"
+                         "int main(int argc,char *argv[])\n"
+                         "{DIR *directory; struct stat stat_buf; int fd;\n"
+                         "fd = openat(AT_FDCWD, \".\", O_RDONLY | O_DIRECTORY | O_NOFOLLOW);\n"
+                         "directory = fdopendir(fd);\n"
+                         "fstatat(dirfd(directory), \"x\", &stat_buf, AT_SYMLINK_NOFOLLOW);\n"
+                         "closedir(directory);\n"
+                         "return 0;}\n"));
+    fprintf(versionFile, "#define HAS_FICLONE %d\n",
+        compileAndLinkOk("#include<sys/ioctl.h>\n#include<linux/fs.h>\n"
+                         "int main(int argc,char *argv[])\n"
+                         "{ioctl(4, FICLONE, 3);\n"
+                         "return 0;}\n"));
     fprintf(logFile, " determined\n");
     determineIncludesAndLibs(versionFile);
     writeReadBufferEmptyMacro(versionFile);
+    writeReadBufferAccessMacros(versionFile);
     cleanUpCompilation("ctest", testNumber);
     removeDoSleep();
     fprintf(versionFile, "#define REMOVE_REATTEMPTS %lu\n", removeReattempts);
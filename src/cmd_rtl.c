@@ -35,6 +35,16 @@
 
 #include "version.h"
 
+#if HAS_COPY_FILE_RANGE
+#define _GNU_SOURCE
+#endif
+
+#if HAS_FSTATAT && !defined os_DIR && !defined os_stat_struct
+#define WALK_DIR_WITH_FD 1
+#else
+#define WALK_DIR_WITH_FD 0
+#endif
+
 #include "stdlib.h"
 #include "stdio.h"
 #include "string.h"
@@ -72,6 +82,19 @@
 #include "sys/mman.h"
 #endif
 
+#if HAS_SENDFILE
+#include "sys/sendfile.h"
+#endif
+
+#if HAS_FICLONE
+#include "sys/ioctl.h"
+#include "linux/fs.h"
+#endif
+
+#if WALK_DIR_WITH_FD
+#include "fcntl.h"
+#endif
+
 #include "common.h"
 #include "data_rtl.h"
 #include "os_decls.h"
@@ -232,6 +255,13 @@
 
 #define SIZE_NORMAL_BUFFER   32768
 #define SIZE_RESERVE_BUFFER   2048
+#define KERNEL_COPY_CHUNK 0x40000000
+
+#if HAS_FICLONE || HAS_COPY_FILE_RANGE || HAS_SENDFILE
+#define HAS_KERNEL_COPY 1
+#else
+#define HAS_KERNEL_COPY 0
+#endif
 
 #define PRESERVE_NOTHING    0x00
 #define PRESERVE_MODE       0x01
@@ -239,6 +269,7 @@
 #define PRESERVE_TIMESTAMPS 0x04
 #define PRESERVE_SYMLINKS   0x08
 #define PRESERVE_ALL        0xFF
+#define REFLINK_CONTENTS   0x100
 
 #define USR_BITS_NORMAL (S_IRUSR == 0400 && S_IWUSR == 0200 && S_IXUSR == 0100)
 #define GRP_BITS_NORMAL (S_IRGRP == 0040 && S_IWGRP == 0020 && S_IXGRP == 0010)
@@ -248,6 +279,24 @@
 #define INITIAL_ARRAY_SIZE 256
 #define ARRAY_SIZE_DELTA   256
 
+/* Number of integers per entry in the info of cmdReadDirInfo(): */
+/* File type, size, mode and modification time.                   */
+#define DIR_INFO_FIELDS 4
+
+typedef struct {
+    striType name;
+    os_striType os_name;
+    intType info[DIR_INFO_FIELDS];
+} dirInfoEntryRecord, *dirInfoEntryType;
+
+typedef struct {
+    rtlArrayType names;
+    rtlArrayType info;
+    memSizeType used;
+    boolType recursive;
+    errInfoType err_info;
+} dirWalkRecord, *dirWalkType;
+
 #if INTTYPE_SIZE >= INT_SIZE
 #define CONFIG_VALUE_BUFFER_SIZE INTTYPE_DECIMAL_SIZE + NULL_TERMINATION_LEN
 #else
@@ -442,18 +491,103 @@ static void remove_any_file (const const_os_striType file_name, errInfoType *err
 
 
 
+#if HAS_KERNEL_COPY
+/**
+ *  Copy the contents of a regular file without a user space buffer.
+ *  A reflink (FICLONE) is tried first, if 'flags' contains
+ *  REFLINK_CONTENTS. Afterwards copy_file_range() and sendfile()
+ *  are tried. If a system call is not supported for these files
+ *  the next one is used. Bytes that have already been copied are
+ *  reflected in the file positions of 'from_fd' and 'to_fd'.
+ *  @param copied Number of bytes copied (also if FALSE is returned).
+ *  @return TRUE if the whole file was copied or an error occurred
+ *          (in this case 'err_info' is set), and
+ *          FALSE if the remaining bytes must be copied in user space.
+ */
+static boolType copy_in_kernel (int from_fd, int to_fd,
+    os_off_t file_size, int flags, unsigned_os_off_t *copied,
+    errInfoType *err_info)
+
+  {
+    ssize_t bytes_copied;
+    boolType done = FALSE;
+
+  /* copy_in_kernel */
+    logFunction(printf("copy_in_kernel(%d, %d, " FMT_D_OFF ", 0x%x, *)\n",
+                       from_fd, to_fd, file_size, flags););
+    *copied = 0;
+#if HAS_FICLONE
+    if ((flags & REFLINK_CONTENTS) && ioctl(to_fd, FICLONE, from_fd) == 0) {
+      *copied = (unsigned_os_off_t) file_size;
+      done = TRUE;
+    } /* if */
+#endif
+#if HAS_COPY_FILE_RANGE
+    if (!done) {
+      while ((bytes_copied = copy_file_range(from_fd, NULL, to_fd, NULL,
+                                             KERNEL_COPY_CHUNK, 0)) > 0) {
+        *copied += (unsigned_os_off_t) bytes_copied;
+      } /* while */
+      if (bytes_copied == 0) {
+        /* Files from pseudo file systems report a size but some */
+        /* kernels copy nothing. In this case read() is used.     */
+        done = *copied != 0;
+      } else if (errno != ENOSYS && errno != EXDEV && errno != EINVAL &&
+                 errno != EOPNOTSUPP && errno != EBADF && errno != EPERM) {
+        logError(printf("copy_in_kernel: copy_file_range(%d, NULL, %d, NULL, "
+                        FMT_U_MEM ", 0) failed:\n"
+                        "errno=%d\nerror: %s\n",
+                        from_fd, to_fd, (memSizeType) KERNEL_COPY_CHUNK,
+                        errno, strerror(errno)););
+        *err_info = FILE_ERROR;
+        done = TRUE;
+      } /* if */
+    } /* if */
+#endif
+#if HAS_SENDFILE
+    if (!done) {
+      while ((bytes_copied = sendfile(to_fd, from_fd, NULL,
+                                      KERNEL_COPY_CHUNK)) > 0) {
+        *copied += (unsigned_os_off_t) bytes_copied;
+      } /* while */
+      if (bytes_copied == 0) {
+        done = *copied != 0;
+      } else if (errno != ENOSYS && errno != EINVAL && errno != EOPNOTSUPP) {
+        logError(printf("copy_in_kernel: sendfile(%d, %d, NULL, "
+                        FMT_U_MEM ") failed:\n"
+                        "errno=%d\nerror: %s\n",
+                        to_fd, from_fd, (memSizeType) KERNEL_COPY_CHUNK,
+                        errno, strerror(errno)););
+        *err_info = FILE_ERROR;
+        done = TRUE;
+      } /* if */
+    } /* if */
+#endif
+    logFunction(printf("copy_in_kernel(%d, %d, " FMT_D_OFF ", 0x%x, " FMT_U_OFF
+                       ") --> %d (err_info=%d)\n",
+                       from_fd, to_fd, file_size, flags, *copied,
+                       done, *err_info););
+    return done;
+  } /* copy_in_kernel */
+#endif
+
+
+
 static void copy_file (const const_os_striType from_name,
-    const const_os_striType to_name, errInfoType *err_info)
+    const const_os_striType to_name, int flags, errInfoType *err_info)
 
   {
     FILE *from_file;
     FILE *to_file;
-#if HAS_MMAP
+#if HAS_MMAP || HAS_KERNEL_COPY
     int file_no;
     os_fstat_struct file_stat;
+    unsigned_os_off_t copied = 0;
+    boolType classic_copy = TRUE;
+#endif
+#if HAS_MMAP
     memSizeType file_length;
     ustriType file_content;
-    boolType classic_copy = TRUE;
 #endif
     char *normal_buffer;
     char *buffer;
@@ -466,15 +600,27 @@ static void copy_file (const const_os_striType from_name,
                        from_name, to_name););
     if ((from_file = os_fopen(from_name, os_mode_rb)) != NULL) {
       if ((to_file = os_fopen(to_name, os_mode_wb)) != NULL) {
-#if HAS_MMAP
+#if HAS_MMAP || HAS_KERNEL_COPY
         file_no = os_fileno(from_file);
         if (file_no != -1 && os_fstat(file_no, &file_stat) == 0) {
-          if (file_stat.st_size >= 0 &&
-              (unsigned_os_off_t) file_stat.st_size < MAX_MEMSIZETYPE) {
+#if HAS_KERNEL_COPY
+          if (S_ISREG(file_stat.st_mode) && file_stat.st_size > 0 &&
+              copy_in_kernel(file_no, os_fileno(to_file), file_stat.st_size,
+                             flags, &copied, err_info)) {
+            classic_copy = FALSE;
+          } /* if */
+#endif
+#if HAS_MMAP
+          if (classic_copy && file_stat.st_size >= 0 &&
+              (unsigned_os_off_t) file_stat.st_size < MAX_MEMSIZETYPE &&
+              copied < (unsigned_os_off_t) file_stat.st_size) {
+            /* Bytes already copied in the kernel are skipped. */
             file_length = (memSizeType) file_stat.st_size;
             if ((file_content = (ustriType) mmap(NULL, file_length,
                 PROT_READ, MAP_PRIVATE, file_no, 0)) != (ustriType) -1) {
-              if (fwrite(file_content, 1, file_length, to_file) != file_length) {
+              file_length -= (memSizeType) copied;
+              if (fwrite(&file_content[(memSizeType) copied], 1, file_length,
+                         to_file) != file_length) {
                 logError(printf("copy_file(\"" FMT_S_OS "\", \"" FMT_S_OS "\"): "
                                 "fwrite(*, 1, " FMT_U_MEM ", %d) failed:\n"
                                 "errno=%d\nerror: %s\n",
@@ -482,10 +628,11 @@ static void copy_file (const const_os_striType from_name,
                                 errno, strerror(errno)););
                 *err_info = FILE_ERROR;
               } /* if */
-              munmap(file_content, file_length);
+              munmap(file_content, file_length + (memSizeType) copied);
               classic_copy = FALSE;
             } /* if */
           } /* if */
+#endif
         } /* if */
         if (classic_copy) {
 #endif
@@ -510,7 +657,7 @@ static void copy_file (const const_os_striType from_name,
           if (normal_buffer != NULL) {
             FREE_BYTES(normal_buffer, SIZE_NORMAL_BUFFER);
           } /* if */
-#if HAS_MMAP
+#if HAS_MMAP || HAS_KERNEL_COPY
         } /* if */
 #endif
         if (fclose(from_file) != 0) {
@@ -718,7 +865,7 @@ static void copy_any_file (const const_os_striType from_name,
         *err_info = FILE_ERROR;
 #endif
       } else if (S_ISREG(from_stat.st_mode)) {
-        copy_file(from_name, to_name, err_info);
+        copy_file(from_name, to_name, flags, err_info);
       } else if (S_ISDIR(from_stat.st_mode)) {
         copy_dir(from_name, to_name, flags, err_info);
       } else if (S_ISFIFO(from_stat.st_mode)) {
@@ -998,6 +1145,382 @@ static rtlArrayType read_dir (const const_striType dir_name, errInfoType *err_in
 
 
 
+#ifdef USE_CDECL
+static int _cdecl cmp_dir_info_entry (char *entry1, char *entry2)
+#else
+static int cmp_dir_info_entry (void const *entry1, void const *entry2)
+#endif
+
+  { /* cmp_dir_info_entry */
+    return (int) strCompare(
+        ((const dirInfoEntryRecord *) entry1)->name,
+        ((const dirInfoEntryRecord *) entry2)->name);
+  } /* cmp_dir_info_entry */
+
+
+
+static void statToDirInfo (const os_stat_struct *stat_buf, intType *info)
+
+  { /* statToDirInfo */
+    if (S_ISREG(stat_buf->st_mode)) {
+      info[0] = FILE_REGULAR;
+    } else if (S_ISDIR(stat_buf->st_mode)) {
+      info[0] = FILE_DIR;
+    } else if (S_ISCHR(stat_buf->st_mode)) {
+      info[0] = FILE_CHAR;
+    } else if (S_ISBLK(stat_buf->st_mode)) {
+      info[0] = FILE_BLOCK;
+    } else if (S_ISFIFO(stat_buf->st_mode)) {
+      info[0] = FILE_FIFO;
+    } else if (S_ISLNK(stat_buf->st_mode)) {
+      info[0] = FILE_SYMLINK;
+    } else if (S_ISSOCK(stat_buf->st_mode)) {
+      info[0] = FILE_SOCKET;
+    } else {
+      info[0] = FILE_UNKNOWN;
+    } /* if */
+    if (S_ISREG(stat_buf->st_mode) &&
+        stat_buf->st_size >= 0 && stat_buf->st_size <= INTTYPE_MAX) {
+      info[1] = (intType) stat_buf->st_size;
+    } else {
+      info[1] = 0;
+    } /* if */
+#if MODE_BITS_NORMAL
+    info[2] = (intType) (0777 & stat_buf->st_mode);
+#else
+    /* Force the bits to the standard sequence */
+    info[2] = (intType)
+        ((stat_buf->st_mode & S_IRUSR ? 0400 : 0) |
+         (stat_buf->st_mode & S_IWUSR ? 0200 : 0) |
+         (stat_buf->st_mode & S_IXUSR ? 0100 : 0) |
+         (stat_buf->st_mode & S_IRGRP ? 0040 : 0) |
+         (stat_buf->st_mode & S_IWGRP ? 0020 : 0) |
+         (stat_buf->st_mode & S_IXGRP ? 0010 : 0) |
+         (stat_buf->st_mode & S_IROTH ? 0004 : 0) |
+         (stat_buf->st_mode & S_IWOTH ? 0002 : 0) |
+         (stat_buf->st_mode & S_IXOTH ? 0001 : 0));
+#endif
+    info[3] = (intType) stat_buf->st_mtime;
+  } /* statToDirInfo */
+
+
+
+/**
+ *  Append a path and its properties to the result of a directory walk.
+ *  The capacity of the arrays is doubled if necessary.
+ *  If there is not enough memory 'path' is freed and
+ *  walk->err_info is set to MEMORY_ERROR.
+ */
+static void addDirWalkEntry (dirWalkType walk, const striType path,
+    const intType *info)
+
+  {
+    memSizeType new_capacity;
+    rtlArrayType resized_array;
+    memSizeType pos;
+
+  /* addDirWalkEntry */
+    if (walk->used >= (memSizeType) walk->names->max_position) {
+      new_capacity = 2 * (memSizeType) walk->names->max_position;
+      if (unlikely(new_capacity > MAX_RTL_ARR_INDEX ||
+                   !REALLOC_RTL_ARRAY(resized_array, walk->names,
+                                      new_capacity))) {
+        walk->err_info = MEMORY_ERROR;
+      } else {
+        COUNT3_RTL_ARRAY(new_capacity / 2, new_capacity);
+        walk->names = resized_array;
+        walk->names->max_position = (intType) new_capacity;
+      } /* if */
+    } /* if */
+    if (walk->err_info == OKAY_NO_ERROR &&
+        (walk->used + 1) * DIR_INFO_FIELDS > (memSizeType) walk->info->max_position) {
+      new_capacity = 2 * (memSizeType) walk->info->max_position;
+      if (unlikely(new_capacity > MAX_RTL_ARR_INDEX ||
+                   !REALLOC_RTL_ARRAY(resized_array, walk->info,
+                                      new_capacity))) {
+        walk->err_info = MEMORY_ERROR;
+      } else {
+        COUNT3_RTL_ARRAY(new_capacity / 2, new_capacity);
+        walk->info = resized_array;
+        walk->info->max_position = (intType) new_capacity;
+      } /* if */
+    } /* if */
+    if (unlikely(walk->err_info != OKAY_NO_ERROR)) {
+      FREE_STRI(path);
+    } else {
+      walk->names->arr[walk->used].value.striValue = path;
+      for (pos = 0; pos < DIR_INFO_FIELDS; pos++) {
+        walk->info->arr[walk->used * DIR_INFO_FIELDS + pos].value.intValue =
+            info[pos];
+      } /* for */
+      walk->used++;
+    } /* if */
+  } /* addDirWalkEntry */
+
+
+
+/**
+ *  Read the entries of 'directory' and add them sorted to 'walk'.
+ *  The properties of an entry are determined with lstat(), so
+ *  symbolic links are not followed. With WALK_DIR_WITH_FD the
+ *  entries are accessed relative to the directory file descriptor,
+ *  otherwise 'os_dir_path' is used to build the path of an entry.
+ *  If walk->recursive is TRUE subdirectories are read directly
+ *  after their own entry.
+ *  @param prefix Path of 'directory' relative to the start of the
+ *         walk, or NULL for the start directory itself.
+ */
+static void walk_dir (os_DIR *directory, const const_os_striType os_dir_path,
+    const const_striType prefix, dirWalkType walk)
+
+  {
+    os_dirent_struct *current_entry;
+    memSizeType d_name_size;
+    os_stat_struct stat_buf;
+    int stat_result;
+#if WALK_DIR_WITH_FD
+    int sub_dir_fd;
+#else
+    memSizeType os_dir_path_size;
+    memSizeType os_path_capacity = 0;
+    os_striType os_path = NULL;
+    os_striType resized_path;
+#endif
+    memSizeType new_size;
+    memSizeType entries_capacity = 0;
+    memSizeType num_entries = 0;
+    dirInfoEntryType entries = NULL;
+    dirInfoEntryType resized_entries;
+    dirInfoEntryType entry;
+    striType path = NULL;
+    os_DIR *sub_directory;
+    memSizeType pos;
+
+  /* walk_dir */
+    logFunction(printf("walk_dir(*, *, \"%s\", *)\n",
+                       striAsUnquotedCStri(prefix)););
+#if !WALK_DIR_WITH_FD
+    os_dir_path_size = os_stri_strlen(os_dir_path);
+#endif
+    while (walk->err_info == OKAY_NO_ERROR &&
+           (current_entry = os_readdir(directory)) != NULL) {
+      if (current_entry->d_name[0] != '.' ||
+          (current_entry->d_name[1] != '\0' &&
+           (current_entry->d_name[1] != '.' ||
+            current_entry->d_name[2] != '\0'))) {
+        d_name_size = os_stri_strlen(current_entry->d_name);
+#if WALK_DIR_WITH_FD
+        stat_result = fstatat(dirfd(directory), current_entry->d_name,
+                              &stat_buf, AT_SYMLINK_NOFOLLOW);
+#else
+        stat_result = -1;
+        new_size = os_dir_path_size + 1 + d_name_size;
+        if (new_size > os_path_capacity) {
+          resized_path = REALLOC_OS_STRI(os_path, new_size);
+          if (unlikely(resized_path == NULL)) {
+            walk->err_info = MEMORY_ERROR;
+          } else {
+            if (os_path == NULL) {
+              memcpy(resized_path, os_dir_path,
+                     os_dir_path_size * sizeof(os_charType));
+              memcpy(&resized_path[os_dir_path_size], pathDelimiter,
+                     sizeof(os_charType));
+            } /* if */
+            os_path = resized_path;
+            os_path_capacity = new_size;
+          } /* if */
+        } /* if */
+        if (likely(walk->err_info == OKAY_NO_ERROR)) {
+          memcpy(&os_path[os_dir_path_size + 1], current_entry->d_name,
+                 (d_name_size + 1) * sizeof(os_charType));
+          stat_result = os_lstat(os_path, &stat_buf);
+        } /* if */
+#endif
+        /* Entries removed since os_readdir() are left out. */
+        if (stat_result == 0) {
+          if (num_entries >= entries_capacity) {
+            new_size = entries_capacity == 0 ? INITIAL_ARRAY_SIZE : 2 * entries_capacity;
+            resized_entries = REALLOC_TABLE(entries, dirInfoEntryRecord,
+                                            entries_capacity, new_size);
+            if (unlikely(resized_entries == NULL)) {
+              walk->err_info = MEMORY_ERROR;
+            } else {
+              COUNT3_TABLE(dirInfoEntryRecord, entries_capacity, new_size);
+              entries = resized_entries;
+              entries_capacity = new_size;
+            } /* if */
+          } /* if */
+          if (likely(walk->err_info == OKAY_NO_ERROR)) {
+            entry = &entries[num_entries];
+            entry->name = conv_from_os_stri(current_entry->d_name, d_name_size);
+            entry->os_name = NULL;
+            if (unlikely(entry->name == NULL)) {
+              walk->err_info = MEMORY_ERROR;
+            } else {
+              statToDirInfo(&stat_buf, entry->info);
+              if (walk->recursive && S_ISDIR(stat_buf.st_mode)) {
+                if (unlikely(!ALLOC_OS_STRI(entry->os_name, d_name_size))) {
+                  walk->err_info = MEMORY_ERROR;
+                } else {
+                  memcpy(entry->os_name, current_entry->d_name,
+                         (d_name_size + 1) * sizeof(os_charType));
+                } /* if */
+              } /* if */
+              num_entries++;
+            } /* if */
+          } /* if */
+        } /* if */
+      } /* if */
+    } /* while */
+    if (num_entries != 0) {
+      qsort((void *) entries, (size_t) num_entries,
+            sizeof(dirInfoEntryRecord), &cmp_dir_info_entry);
+    } /* if */
+    for (pos = 0; pos < num_entries; pos++) {
+      entry = &entries[pos];
+      if (walk->err_info == OKAY_NO_ERROR) {
+        if (prefix == NULL) {
+          path = entry->name;
+          entry->name = NULL;
+        } else if (unlikely(!ALLOC_STRI_CHECK_SIZE(path,
+                       prefix->size + 1 + entry->name->size))) {
+          walk->err_info = MEMORY_ERROR;
+        } else {
+          path->size = prefix->size + 1 + entry->name->size;
+          memcpy(path->mem, prefix->mem, prefix->size * sizeof(strElemType));
+          path->mem[prefix->size] = (strElemType) '/';
+          memcpy(&path->mem[prefix->size + 1], entry->name->mem,
+                 entry->name->size * sizeof(strElemType));
+        } /* if */
+        if (likely(walk->err_info == OKAY_NO_ERROR)) {
+          addDirWalkEntry(walk, path, entry->info);
+        } /* if */
+        if (entry->os_name != NULL && walk->err_info == OKAY_NO_ERROR) {
+          /* Subdirectories that cannot be opened are not read. */
+#if WALK_DIR_WITH_FD
+          sub_dir_fd = openat(dirfd(directory), entry->os_name,
+                              O_RDONLY | O_DIRECTORY | O_NOFOLLOW);
+          if (sub_dir_fd == -1) {
+            sub_directory = NULL;
+          } else if ((sub_directory = fdopendir(sub_dir_fd)) == NULL) {
+            close(sub_dir_fd);
+          } /* if */
+          if (sub_directory != NULL) {
+            walk_dir(sub_directory, NULL, path, walk);
+            os_closedir(sub_directory);
+          } /* if */
+#else
+          memcpy(&os_path[os_dir_path_size + 1], entry->os_name,
+                 (os_stri_strlen(entry->os_name) + 1) * sizeof(os_charType));
+          if ((sub_directory = os_opendir(os_path)) != NULL) {
+            walk_dir(sub_directory, os_path, path, walk);
+            os_closedir(sub_directory);
+          } /* if */
+#endif
+        } /* if */
+      } /* if */
+      if (entry->name != NULL) {
+        FREE_STRI(entry->name);
+      } /* if */
+      if (entry->os_name != NULL) {
+        FREE_OS_STRI(entry->os_name);
+      } /* if */
+    } /* for */
+#if !WALK_DIR_WITH_FD
+    if (os_path != NULL) {
+      FREE_OS_STRI(os_path);
+    } /* if */
+#endif
+    if (entries != NULL) {
+      FREE_TABLE(entries, dirInfoEntryRecord, entries_capacity);
+    } /* if */
+    logFunction(printf("walk_dir(*, *, \"%s\", *) --> (err_info=%d)\n",
+                       striAsUnquotedCStri(prefix), walk->err_info););
+  } /* walk_dir */
+
+
+
+static rtlArrayType read_dir_info (const const_striType dirPath,
+    boolType recursive, rtlArrayType *info, errInfoType *err_info)
+
+  {
+    os_striType os_path;
+    int path_info = PATH_IS_NORMAL;
+    os_DIR *directory;
+    dirWalkRecord walk;
+    rtlArrayType resized_info;
+
+  /* read_dir_info */
+    logFunction(printf("read_dir_info(\"%s\", %d, *, *)\n",
+                       striAsUnquotedCStri(dirPath), recursive););
+    walk.names = NULL;
+    os_path = cp_to_os_path(dirPath, &path_info, err_info);
+    if (unlikely(os_path == NULL)) {
+      logError(printf("read_dir_info: cp_to_os_path(\"%s\", *, *) failed:\n"
+                      "path_info=%d, err_info=%d\n",
+                      striAsUnquotedCStri(dirPath), path_info, *err_info););
+      if (*err_info == OKAY_NO_ERROR) {
+        /* The emulated root cannot be read with os_opendir(). */
+        *err_info = FILE_ERROR;
+      } /* if */
+    } else {
+      if (unlikely((directory = os_opendir(os_path)) == NULL)) {
+        logError(printf("read_dir_info: os_opendir(\"" FMT_S_OS "\") failed:\n"
+                        "errno=%d\nerror: %s\n",
+                        os_path, errno, strerror(errno)););
+        *err_info = FILE_ERROR;
+      } else {
+        if (unlikely(!ALLOC_RTL_ARRAY(walk.names, INITIAL_ARRAY_SIZE))) {
+          *err_info = MEMORY_ERROR;
+        } else if (unlikely(!ALLOC_RTL_ARRAY(walk.info,
+                                             INITIAL_ARRAY_SIZE * DIR_INFO_FIELDS))) {
+          FREE_RTL_ARRAY(walk.names, INITIAL_ARRAY_SIZE);
+          walk.names = NULL;
+          *err_info = MEMORY_ERROR;
+        } else {
+          walk.names->min_position = 1;
+          walk.names->max_position = INITIAL_ARRAY_SIZE;
+          walk.info->min_position = 1;
+          walk.info->max_position = INITIAL_ARRAY_SIZE * DIR_INFO_FIELDS;
+          walk.used = 0;
+          walk.recursive = recursive;
+          walk.err_info = OKAY_NO_ERROR;
+          walk_dir(directory, os_path, NULL, &walk);
+          if (unlikely(walk.err_info != OKAY_NO_ERROR)) {
+            freeRtlStriArray(walk.names, (intType) walk.used);
+            FREE_RTL_ARRAY(walk.info, (memSizeType) walk.info->max_position);
+            walk.names = NULL;
+            *err_info = walk.err_info;
+          } else {
+            walk.names = completeRtlStriArray(walk.names, (intType) walk.used);
+            if (unlikely(walk.names == NULL)) {
+              FREE_RTL_ARRAY(walk.info, (memSizeType) walk.info->max_position);
+              *err_info = MEMORY_ERROR;
+            } else if (unlikely(!REALLOC_RTL_ARRAY(resized_info, walk.info,
+                                walk.used * DIR_INFO_FIELDS))) {
+              freeRtlStriArray(walk.names, (intType) walk.used);
+              FREE_RTL_ARRAY(walk.info, (memSizeType) walk.info->max_position);
+              walk.names = NULL;
+              *err_info = MEMORY_ERROR;
+            } else {
+              COUNT3_RTL_ARRAY((memSizeType) resized_info->max_position,
+                               walk.used * DIR_INFO_FIELDS);
+              resized_info->max_position = (intType) (walk.used * DIR_INFO_FIELDS);
+              *info = resized_info;
+            } /* if */
+          } /* if */
+        } /* if */
+        os_closedir(directory);
+      } /* if */
+      os_stri_free(os_path);
+    } /* if */
+    logFunction(printf("read_dir_info(\"%s\", %d, *, %d) -->\n",
+                       striAsUnquotedCStri(dirPath), recursive, *err_info););
+    return walk.names;
+  } /* read_dir_info */
+
+
+
 #ifdef os_setenv
 static void setEnvironmentVariable (const const_striType name, const const_striType value,
     errInfoType *err_info)
@@ -2122,7 +2645,8 @@ void cmdCloneFile (const const_striType sourcePath, const const_striType destPat
                           os_destPath););
           err_info = FILE_ERROR;
         } else {
-          copy_any_file(os_sourcePath, os_destPath, PRESERVE_ALL, &err_info);
+          copy_any_file(os_sourcePath, os_destPath,
+                        PRESERVE_ALL | REFLINK_CONTENTS, &err_info);
         } /* if */
         os_stri_free(os_destPath);
       } /* if */
@@ -3784,6 +4308,65 @@ rtlArrayType cmdReadDir (const const_striType dirPath)
 
 
 
+/**
+ *  Determine the files in a directory together with their properties.
+ *  The properties are determined without following symbolic links.
+ *  The files "." and ".." are left out from the result. The entries
+ *  of a directory are sorted by name. If 'recursive' is TRUE the
+ *  entries of a subdirectory follow directly after the subdirectory
+ *  itself. Subdirectories that cannot be opened are left out.
+ *  Symbolic links to directories are not followed.
+ *  @param recursive TRUE if subdirectories should be read as well.
+ *  @param info Is assigned an array with four integers per entry:
+ *         The file type (as returned by fileTypeSL), the size (0
+ *         for files that are not regular), the mode bits and the
+ *         modification time in seconds since the Unix epoch.
+ *         The old array is freed, if 'info' does not refer to NULL.
+ *  @return a string-array containing the paths relative to 'dirPath'.
+ *  @exception MEMORY_ERROR Not enough memory to convert 'dirPath'
+ *             to the system path type or not enough memory to
+ *             represent the result.
+ *  @exception RANGE_ERROR 'dirPath' does not use the standard path
+ *             representation or it cannot be converted to the system
+ *             path type.
+ *  @exception FILE_ERROR The file described with 'dirPath' does not
+ *             exist, or it is not a directory, or a system function
+ *             returns an error.
+ */
+rtlArrayType cmdReadDirInfo (const const_striType dirPath,
+    boolType recursive, rtlArrayType *info)
+
+  {
+    rtlArrayType new_info = NULL;
+    errInfoType err_info = OKAY_NO_ERROR;
+    rtlArrayType result;
+
+  /* cmdReadDirInfo */
+    logFunction(printf("cmdReadDirInfo(\"%s\", %d, *)\n",
+                       striAsUnquotedCStri(dirPath), recursive););
+    result = read_dir_info(dirPath, recursive, &new_info, &err_info);
+    if (unlikely(result == NULL)) {
+      logError(printf("cmdReadDirInfo: read_dir_info(\"%s\", %d, *, *) failed:\n"
+                      "err_info=%d\n",
+                      striAsUnquotedCStri(dirPath), recursive, err_info););
+      raise_error(err_info);
+    } else {
+      if (*info != NULL) {
+        FREE_RTL_ARRAY(*info, arraySize(*info));
+      } /* if */
+      *info = new_info;
+    } /* if */
+    logFunction(if (result == NULL) {
+                  printf("cmdReadDirInfo --> NULL\n");
+                } else {
+                  printf("cmdReadDirInfo --> array[size = " FMT_U_MEM "]\n",
+                         arraySize(result));
+                });
+    return result;
+  } /* cmdReadDirInfo */
+
+
+
 /**
  *  Reads the destination of a symbolic link.
  *  This function reads the link destination from the file system
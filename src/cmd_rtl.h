@@ -94,6 +94,8 @@ void cmdMakeDir (const const_striType dirPath);
 void cmdMakeLink (const const_striType symlinkPath, const const_striType targetPath);
 void cmdMove (const const_striType sourcePath, const const_striType destPath);
 rtlArrayType cmdReadDir (const const_striType dirPath);
+rtlArrayType cmdReadDirInfo (const const_striType dirPath,
+    boolType recursive, rtlArrayType *info);
 striType cmdReadLink (const const_striType filePath);
 striType cmdReadLinkAbsolute (const const_striType filePath);
 void cmdRemoveFile (const const_striType filePath);
@@ -44,10 +44,12 @@
 #include "striutl.h"
 #include "arrutl.h"
 #include "objutl.h"
+#include "executl.h"
 #include "runerr.h"
 #include "dir_drv.h"
 #include "dir_rtl.h"
 #include "str_rtl.h"
+#include "arr_rtl.h"
 #include "cmd_rtl.h"
 #include "cmd_drv.h"
 
@@ -966,6 +968,72 @@ objectType cmd_read_dir (listType arguments)
 
 
 
+/**
+ *  Determine the files in a directory together with their properties.
+ *  The properties are determined without following symbolic links.
+ *  The files "." and ".." are left out from the result.
+ *  @param dirPath/arg_1 Path of the directory to be read.
+ *  @param recursive/arg_2 TRUE if subdirectories should be read as well.
+ *  @param info/arg_3 Is assigned an array with four integers per entry:
+ *         The file type, the size, the mode bits and the modification
+ *         time in seconds since the Unix epoch.
+ *  @return a string-array containing the paths relative to 'dirPath'.
+ *  @exception MEMORY_ERROR Not enough memory to convert 'dirPath'
+ *             to the system path type or not enough memory to
+ *             represent the result.
+ *  @exception RANGE_ERROR 'dirPath' does not use the standard path
+ *             representation or it cannot be converted to the system
+ *             path type.
+ *  @exception FILE_ERROR The file described with 'dirPath' does not
+ *             exist, or it is not a directory, or a system function
+ *             returns an error.
+ */
+objectType cmd_read_dir_info (listType arguments)
+
+  {
+    objectType info_variable;
+    rtlArrayType info;
+    rtlArrayType names;
+    memSizeType info_size;
+    memSizeType pos;
+    arrayType info_array;
+    typeType typeOfInt;
+
+  /* cmd_read_dir_info */
+    isit_stri(arg_1(arguments));
+    isit_bool(arg_2(arguments));
+    info_variable = arg_3(arguments);
+    isit_array(info_variable);
+    is_variable(info_variable);
+    info = NULL;
+    names = cmdReadDirInfo(take_stri(arg_1(arguments)),
+                           take_bool(arg_2(arguments)) == SYS_TRUE_OBJECT,
+                           &info);
+    if (names != NULL) {
+      info_size = arraySize(info);
+      if (unlikely(!ALLOC_ARRAY(info_array, info_size))) {
+        FREE_RTL_ARRAY(info, info_size);
+        freeRtlStriArray(names, names->max_position);
+        return raise_exception(SYS_MEM_EXCEPTION);
+      } /* if */
+      info_array->min_position = info->min_position;
+      info_array->max_position = info->max_position;
+      typeOfInt = take_type(SYS_INT_TYPE);
+      for (pos = 0; pos < info_size; pos++) {
+        info_array->arr[pos].type_of = typeOfInt;
+        info_array->arr[pos].descriptor.property = NULL;
+        info_array->arr[pos].value.intValue = info->arr[pos].value.intValue;
+        INIT_CATEGORY_OF_VAR(&info_array->arr[pos], INTOBJECT);
+      } /* for */
+      free_array(take_array(info_variable));
+      info_variable->value.arrayValue = info_array;
+      FREE_RTL_ARRAY(info, info_size);
+    } /* if */
+    return toArrayType(names);
+  } /* cmd_read_dir_info */
+
+
+
 /**
  *  Reads the destination of a symbolic link.
  *  This function reads the link destination from the file system
@@ -54,6 +54,7 @@ objectType cmd_make_dir                 (listType arguments);
 objectType cmd_make_link                (listType arguments);
 objectType cmd_move                     (listType arguments);
 objectType cmd_read_dir                 (listType arguments);
+objectType cmd_read_dir_info            (listType arguments);
 objectType cmd_read_link                (listType arguments);
 objectType cmd_read_link_absolute       (listType arguments);
 objectType cmd_remove_file              (listType arguments);
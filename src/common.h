@@ -728,6 +728,12 @@ typedef struct fileStruct {
     uintType usage_count;
     boolType readingAllowed;
     boolType writingAllowed;
+    /* The fields below are only used by memory mapped files. */
+    const_ustriType mapStart;  /* NULL if the file is not mapped */
+    memSizeType mapLength;
+    memSizeType mapPosition;
+    boolType mapEof;
+    boolType mapRandom;
   } fileRecord;
 
 typedef struct pollStruct {
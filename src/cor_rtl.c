@@ -0,0 +1,1025 @@
+/********************************************************************/
+/*                                                                  */
+/*  cor_rtl.c     Primitive actions for coroutines.                 */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/cor_rtl.c                                       */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: Primitive actions for coroutines.                      */
+/*                                                                  */
+/*  Coroutines are stackful and cooperative. Every coroutine runs   */
+/*  on its own stack, which is created with makecontext(). Later    */
+/*  context switches use _setjmp() and _longjmp(), because they do  */
+/*  not save and restore the signal mask with a system call. The    */
+/*  scheduler corRun() resumes the ready coroutines one after the   */
+/*  other. A coroutine runs until it finishes or until it must      */
+/*  wait for a socket, a point in time or corYield(). Waiting       */
+/*  coroutines are woken up by one epoll_wait() or poll() call.     */
+/*  When no coroutine runs all of this costs nothing: inCoroutine   */
+/*  is FALSE and the socket functions use their normal code paths.  */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+/* The context switch jumps between the stacks of the coroutines. */
+/* The checking longjmp() of _FORTIFY_SOURCE would reject this.   */
+#undef _FORTIFY_SOURCE
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#include "limits.h"
+#if HAS_UCONTEXT && HAS_POLL
+#include "ucontext.h"
+#include "poll.h"
+#if HAS_EPOLL
+#include "sys/epoll.h"
+#endif
+#if HAS_MMAP
+#include "sys/mman.h"
+#endif
+#endif
+#include "setjmp.h"
+#include "errno.h"
+
+#include "common.h"
+#include "os_decls.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "tim_drv.h"
+#include "rtl_err.h"
+
+#undef EXTERN
+#define EXTERN
+#define DO_INIT
+#include "cor_rtl.h"
+
+
+#if HAS_UCONTEXT && HAS_POLL
+
+/* The stack is mapped lazily: Only the pages used are allocated. */
+#define COROUTINE_STACK_SIZE 0x100000
+#define STACK_GUARD_SIZE      0x10000
+#define MAX_CACHED_STACKS         256
+#define CATCH_STACK_START_SIZE     16
+#define FD_TABLE_INCREMENT       1024
+#define TIMER_HEAP_INCREMENT     1024
+#define MAX_EVENTS                256
+
+#if HAS_MMAP && !defined MAP_ANONYMOUS && defined MAP_ANON
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+#ifndef MAP_NORESERVE
+#define MAP_NORESERVE 0
+#endif
+
+typedef longjmpPosition catch_type;
+extern catch_type *catch_stack;
+extern size_t catch_stack_pos;
+extern size_t max_catch_stack;
+
+typedef struct coroutineStruct *coroutineType;
+
+typedef struct coroutineStruct {
+    ucontext_t context;
+    jmp_buf jumpBuffer;
+    boolType started;
+    void *stack;
+    corFuncType func;
+    genericType data;
+    destrFuncType destrData;
+    void *interpreterState;
+    catch_type *catchStack;
+    size_t catchStackPos;
+    size_t maxCatchStack;
+    int exceptionNumber;
+    const char *errorFile;
+    int errorLine;
+    int waitFd;
+    short waitEvents;
+    boolType wokenByEvent;
+    boolType finished;
+    intType deadline;
+    memSizeType timerPos;
+    coroutineType nextWaiting;
+    coroutineType nextReady;
+  } coroutineRecord;
+
+typedef struct {
+    coroutineType waiters;
+    boolType registered;
+  } fdWaitType;
+
+static jmp_buf schedulerJumpBuffer;
+static coroutineType currentCoroutine = NULL;
+static coroutineType readyHead = NULL;
+static coroutineType readyTail = NULL;
+static memSizeType numCoroutines = 0;
+static memSizeType numFdWaiters = 0;
+static boolType stopRequested = FALSE;
+static int uncaughtException = OKAY_NO_ERROR;
+static const char *uncaughtFile = NULL;
+static int uncaughtLine = 0;
+
+static fdWaitType *fdTable = NULL;
+static memSizeType fdTableSize = 0;
+
+/* The timer heap is one-based: timerPos 0 means "no timer". */
+static coroutineType *timerHeap = NULL;
+static memSizeType timerHeapSize = 0;
+static memSizeType timerHeapCapacity = 0;
+
+static void *stackCache[MAX_CACHED_STACKS];
+static memSizeType numCachedStacks = 0;
+
+static memSizeType interpreterStateSize = 0;
+static corSwitchStateFuncType switchInterpreterState = NULL;
+
+#if HAS_EPOLL
+static int epollFd = -1;
+#else
+static struct pollfd *pollFds = NULL;
+static memSizeType pollFdsCapacity = 0;
+#endif
+
+
+
+/**
+ *  Register the functions used to switch the state of the interpreter.
+ *  The interpreter keeps some state in global variables. Every
+ *  coroutine gets 'stateSize' zeroed bytes, and 'switchState' is
+ *  called when a coroutine is entered (TRUE) and left (FALSE).
+ *  Compiled programs have no such state and do not call this.
+ */
+void initCoroutineOperations (memSizeType stateSize,
+    corSwitchStateFuncType switchState)
+
+  { /* initCoroutineOperations */
+    interpreterStateSize = stateSize;
+    switchInterpreterState = switchState;
+  } /* initCoroutineOperations */
+
+
+
+static void *allocStack (void)
+
+  {
+    void *stack;
+
+  /* allocStack */
+    if (numCachedStacks != 0) {
+      numCachedStacks--;
+      stack = stackCache[numCachedStacks];
+    } else {
+#if HAS_MMAP && defined MAP_ANONYMOUS
+      stack = mmap(NULL, COROUTINE_STACK_SIZE, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+      if (unlikely(stack == MAP_FAILED)) {
+        stack = NULL;
+      } else {
+        /* A stack overflow hits the guard page instead of the heap. */
+#if STACK_GROWS_UPWARD
+        mprotect(&((char *) stack)[COROUTINE_STACK_SIZE - STACK_GUARD_SIZE],
+                 STACK_GUARD_SIZE, PROT_NONE);
+#else
+        mprotect(stack, STACK_GUARD_SIZE, PROT_NONE);
+#endif
+      } /* if */
+#else
+      stack = malloc(COROUTINE_STACK_SIZE);
+#endif
+    } /* if */
+    return stack;
+  } /* allocStack */
+
+
+
+static void freeStack (void *stack)
+
+  { /* freeStack */
+    if (numCachedStacks < MAX_CACHED_STACKS) {
+      stackCache[numCachedStacks] = stack;
+      numCachedStacks++;
+    } else {
+#if HAS_MMAP && defined MAP_ANONYMOUS
+      munmap(stack, COROUTINE_STACK_SIZE);
+#else
+      free(stack);
+#endif
+    } /* if */
+  } /* freeStack */
+
+
+
+static void enqueueReady (coroutineType coroutine)
+
+  { /* enqueueReady */
+    coroutine->nextReady = NULL;
+    if (readyTail == NULL) {
+      readyHead = coroutine;
+    } else {
+      readyTail->nextReady = coroutine;
+    } /* if */
+    readyTail = coroutine;
+  } /* enqueueReady */
+
+
+
+static coroutineType dequeueReady (void)
+
+  {
+    coroutineType coroutine;
+
+  /* dequeueReady */
+    coroutine = readyHead;
+    readyHead = coroutine->nextReady;
+    if (readyHead == NULL) {
+      readyTail = NULL;
+    } /* if */
+    return coroutine;
+  } /* dequeueReady */
+
+
+
+static void siftUpTimer (memSizeType pos)
+
+  {
+    coroutineType coroutine;
+    boolType moving = TRUE;
+
+  /* siftUpTimer */
+    coroutine = timerHeap[pos];
+    while (moving && pos > 1) {
+      if (timerHeap[pos / 2]->deadline > coroutine->deadline) {
+        timerHeap[pos] = timerHeap[pos / 2];
+        timerHeap[pos]->timerPos = pos;
+        pos /= 2;
+      } else {
+        moving = FALSE;
+      } /* if */
+    } /* while */
+    timerHeap[pos] = coroutine;
+    coroutine->timerPos = pos;
+  } /* siftUpTimer */
+
+
+
+static void siftDownTimer (memSizeType pos)
+
+  {
+    coroutineType coroutine;
+    memSizeType child;
+    boolType moving = TRUE;
+
+  /* siftDownTimer */
+    coroutine = timerHeap[pos];
+    while (moving && 2 * pos <= timerHeapSize) {
+      child = 2 * pos;
+      if (child < timerHeapSize &&
+          timerHeap[child + 1]->deadline < timerHeap[child]->deadline) {
+        child++;
+      } /* if */
+      if (timerHeap[child]->deadline < coroutine->deadline) {
+        timerHeap[pos] = timerHeap[child];
+        timerHeap[pos]->timerPos = pos;
+        pos = child;
+      } else {
+        moving = FALSE;
+      } /* if */
+    } /* while */
+    timerHeap[pos] = coroutine;
+    coroutine->timerPos = pos;
+  } /* siftDownTimer */
+
+
+
+static boolType addTimer (coroutineType coroutine)
+
+  {
+    coroutineType *resizedHeap;
+    boolType okay = TRUE;
+
+  /* addTimer */
+    if (timerHeapSize + 1 >= timerHeapCapacity) {
+      resizedHeap = (coroutineType *) realloc(timerHeap,
+          (timerHeapCapacity + TIMER_HEAP_INCREMENT) * sizeof(coroutineType));
+      if (unlikely(resizedHeap == NULL)) {
+        okay = FALSE;
+      } else {
+        timerHeap = resizedHeap;
+        timerHeapCapacity += TIMER_HEAP_INCREMENT;
+      } /* if */
+    } /* if */
+    if (likely(okay)) {
+      timerHeapSize++;
+      timerHeap[timerHeapSize] = coroutine;
+      siftUpTimer(timerHeapSize);
+    } /* if */
+    return okay;
+  } /* addTimer */
+
+
+
+static void removeTimer (coroutineType coroutine)
+
+  {
+    memSizeType pos;
+
+  /* removeTimer */
+    pos = coroutine->timerPos;
+    coroutine->timerPos = 0;
+    if (pos < timerHeapSize) {
+      timerHeap[pos] = timerHeap[timerHeapSize];
+      timerHeapSize--;
+      if (pos > 1 && timerHeap[pos / 2]->deadline > timerHeap[pos]->deadline) {
+        siftUpTimer(pos);
+      } else {
+        siftDownTimer(pos);
+      } /* if */
+    } else {
+      timerHeapSize--;
+    } /* if */
+  } /* removeTimer */
+
+
+
+#if HAS_EPOLL
+/**
+ *  Add 'fd' to the epoll set of the scheduler.
+ *  The registration is edge triggered and stays until the socket is
+ *  closed. Coroutines wait only after a socket function found that
+ *  it would block. The next edge reports that the state has changed.
+ *  This way waiting does not need an epoll_ctl() call.
+ */
+static boolType registerFd (int fd)
+
+  {
+    struct epoll_event event;
+    int result;
+
+  /* registerFd */
+    event.events = EPOLLIN | EPOLLOUT | EPOLLET;
+    event.data.fd = fd;
+    result = epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+    if (result != 0 && errno == EEXIST) {
+      /* A duplicate of the file descriptor is still registered. */
+      result = epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event);
+    } /* if */
+    if (unlikely(result != 0)) {
+      logError(printf("registerFd(%d): epoll_ctl(%d, EPOLL_CTL_ADD, %d, *) failed:\n"
+                      "%s=%d\nerror: %s\n",
+                      fd, epollFd, fd, ERROR_INFORMATION););
+    } /* if */
+    fdTable[fd].registered = result == 0;
+    return result == 0;
+  } /* registerFd */
+#endif
+
+
+
+static boolType addWaiter (coroutineType coroutine)
+
+  {
+    int fd;
+    memSizeType newSize;
+    fdWaitType *resizedTable;
+    boolType okay = TRUE;
+
+  /* addWaiter */
+    fd = coroutine->waitFd;
+#if HAS_EPOLL
+    if (epollFd == -1) {
+      epollFd = epoll_create1(EPOLL_CLOEXEC);
+      okay = epollFd != -1;
+    } /* if */
+#endif
+    if (okay && (memSizeType) fd >= fdTableSize) {
+      newSize = ((memSizeType) fd / FD_TABLE_INCREMENT + 1) * FD_TABLE_INCREMENT;
+      resizedTable = (fdWaitType *) realloc(fdTable, newSize * sizeof(fdWaitType));
+      if (unlikely(resizedTable == NULL)) {
+        okay = FALSE;
+      } else {
+        memset(&resizedTable[fdTableSize], 0,
+               (newSize - fdTableSize) * sizeof(fdWaitType));
+        fdTable = resizedTable;
+        fdTableSize = newSize;
+      } /* if */
+    } /* if */
+    if (likely(okay)) {
+      coroutine->nextWaiting = fdTable[fd].waiters;
+      fdTable[fd].waiters = coroutine;
+      numFdWaiters++;
+#if HAS_EPOLL
+      if (!fdTable[fd].registered && unlikely(!registerFd(fd))) {
+        fdTable[fd].waiters = coroutine->nextWaiting;
+        numFdWaiters--;
+        okay = FALSE;
+      } /* if */
+#endif
+    } /* if */
+    return okay;
+  } /* addWaiter */
+
+
+
+static void removeWaiter (coroutineType coroutine)
+
+  {
+    coroutineType *waiterPtr;
+
+  /* removeWaiter */
+    waiterPtr = &fdTable[coroutine->waitFd].waiters;
+    while (*waiterPtr != coroutine) {
+      waiterPtr = &(*waiterPtr)->nextWaiting;
+    } /* while */
+    *waiterPtr = coroutine->nextWaiting;
+    numFdWaiters--;
+  } /* removeWaiter */
+
+
+
+/**
+ *  Move the coroutines waiting for 'revents' of 'fd' to the ready queue.
+ */
+static void wakeWaiters (int fd, short revents)
+
+  {
+    coroutineType *waiterPtr;
+    coroutineType waiter;
+
+  /* wakeWaiters */
+    if ((memSizeType) fd < fdTableSize) {
+      waiterPtr = &fdTable[fd].waiters;
+      while (*waiterPtr != NULL) {
+        waiter = *waiterPtr;
+        if ((revents & (waiter->waitEvents | POLLERR | POLLHUP | POLLNVAL)) != 0) {
+          *waiterPtr = waiter->nextWaiting;
+          numFdWaiters--;
+          if (waiter->timerPos != 0) {
+            removeTimer(waiter);
+          } /* if */
+          waiter->wokenByEvent = TRUE;
+          enqueueReady(waiter);
+        } else {
+          waiterPtr = &waiter->nextWaiting;
+        } /* if */
+      } /* while */
+    } /* if */
+  } /* wakeWaiters */
+
+
+
+static int timeoutInMilliSec (void)
+
+  {
+    intType timeout;
+
+  /* timeoutInMilliSec */
+    if (timerHeapSize == 0) {
+      timeout = -1;
+    } else {
+      timeout = timerHeap[1]->deadline - timMicroSec();
+      if (timeout <= 0) {
+        timeout = 0;
+      } else if (timeout >= (intType) INT_MAX * 1000) {
+        timeout = INT_MAX;
+      } else {
+        /* Round up, such that the deadline has passed afterwards. */
+        timeout = (timeout + 999) / 1000;
+      } /* if */
+    } /* if */
+    return (int) timeout;
+  } /* timeoutInMilliSec */
+
+
+
+/**
+ *  Wait until at least one coroutine can continue.
+ *  @return TRUE if the waiting succeeded, FALSE if an error occurred.
+ */
+static boolType waitForEvents (void)
+
+  {
+#if HAS_EPOLL
+    struct epoll_event events[MAX_EVENTS];
+    short revents;
+#else
+    struct pollfd *resizedPollFds;
+    memSizeType fd;
+#endif
+    int numEvents;
+    int pos;
+    intType now;
+    coroutineType coroutine;
+    boolType okay = TRUE;
+
+  /* waitForEvents */
+#if HAS_EPOLL
+    if (numFdWaiters == 0) {
+      numEvents = os_poll(NULL, 0, timeoutInMilliSec());
+    } else {
+      numEvents = epoll_wait(epollFd, events, MAX_EVENTS, timeoutInMilliSec());
+      for (pos = 0; pos < numEvents; pos++) {
+        revents = 0;
+        if (events[pos].events & EPOLLIN) {
+          revents |= POLLIN;
+        } /* if */
+        if (events[pos].events & EPOLLOUT) {
+          revents |= POLLOUT;
+        } /* if */
+        if (events[pos].events & EPOLLERR) {
+          revents |= POLLERR;
+        } /* if */
+        if (events[pos].events & EPOLLHUP) {
+          revents |= POLLHUP;
+        } /* if */
+        wakeWaiters(events[pos].data.fd, revents);
+      } /* for */
+    } /* if */
+#else
+    if (pollFdsCapacity < numFdWaiters) {
+      resizedPollFds = (struct pollfd *) realloc(pollFds,
+          fdTableSize * sizeof(struct pollfd));
+      if (unlikely(resizedPollFds == NULL)) {
+        okay = FALSE;
+      } else {
+        pollFds = resizedPollFds;
+        pollFdsCapacity = fdTableSize;
+      } /* if */
+    } /* if */
+    if (likely(okay)) {
+      pos = 0;
+      for (fd = 0; fd < fdTableSize; fd++) {
+        if (fdTable[fd].waiters != NULL) {
+          pollFds[pos].fd = (int) fd;
+          pollFds[pos].events = 0;
+          for (coroutine = fdTable[fd].waiters; coroutine != NULL;
+               coroutine = coroutine->nextWaiting) {
+            pollFds[pos].events |= coroutine->waitEvents;
+          } /* for */
+          pos++;
+        } /* if */
+      } /* for */
+      numEvents = os_poll(pollFds, (nfds_t) pos, timeoutInMilliSec());
+      if (numEvents > 0) {
+        numEvents = pos;
+        for (pos = 0; pos < numEvents; pos++) {
+          if (pollFds[pos].revents != 0) {
+            wakeWaiters(pollFds[pos].fd, pollFds[pos].revents);
+          } /* if */
+        } /* for */
+      } /* if */
+    } else {
+      numEvents = 0;
+    } /* if */
+#endif
+    if (unlikely(numEvents < 0 && errno != EINTR)) {
+      logError(printf("waitForEvents: Waiting failed:\n"
+                      "%s=%d\nerror: %s\n",
+                      ERROR_INFORMATION););
+      okay = FALSE;
+    } /* if */
+    if (timerHeapSize != 0) {
+      now = timMicroSec();
+      while (timerHeapSize != 0 && timerHeap[1]->deadline <= now) {
+        coroutine = timerHeap[1];
+        removeTimer(coroutine);
+        if (coroutine->waitFd != -1) {
+          removeWaiter(coroutine);
+        } /* if */
+        coroutine->wokenByEvent = FALSE;
+        enqueueReady(coroutine);
+      } /* while */
+    } /* if */
+    return okay;
+  } /* waitForEvents */
+
+
+
+static void coroutineEntry (void)
+
+  { /* coroutineEntry */
+    catch_stack_pos = 1;
+    if (do_setjmp(catch_stack[catch_stack_pos]) == 0) {
+      currentCoroutine->func(&currentCoroutine->data);
+    } else {
+      /* An exception was not caught inside of the coroutine.  */
+      /* The scheduler stops and raises it in corRun().        */
+      uncaughtException = exception_number;
+      uncaughtFile = error_file;
+      uncaughtLine = error_line;
+      stopRequested = TRUE;
+    } /* if */
+    catch_stack_pos = 0;
+    currentCoroutine->finished = TRUE;
+    _longjmp(schedulerJumpBuffer, 1);
+  } /* coroutineEntry */
+
+
+
+static void resumeCoroutine (coroutineType coroutine)
+
+  {
+    catch_type *mainCatchStack;
+    size_t mainCatchStackPos;
+    size_t mainMaxCatchStack;
+    int mainExceptionNumber;
+    const char *mainErrorFile;
+    int mainErrorLine;
+
+  /* resumeCoroutine */
+    mainCatchStack = catch_stack;
+    mainCatchStackPos = catch_stack_pos;
+    mainMaxCatchStack = max_catch_stack;
+    mainExceptionNumber = exception_number;
+    mainErrorFile = error_file;
+    mainErrorLine = error_line;
+    catch_stack = coroutine->catchStack;
+    catch_stack_pos = coroutine->catchStackPos;
+    max_catch_stack = coroutine->maxCatchStack;
+    exception_number = coroutine->exceptionNumber;
+    error_file = coroutine->errorFile;
+    error_line = coroutine->errorLine;
+    currentCoroutine = coroutine;
+    inCoroutine = TRUE;
+    if (switchInterpreterState != NULL) {
+      switchInterpreterState(coroutine->interpreterState, TRUE);
+    } /* if */
+    if (_setjmp(schedulerJumpBuffer) == 0) {
+      if (coroutine->started) {
+        _longjmp(coroutine->jumpBuffer, 1);
+      } else {
+        coroutine->started = TRUE;
+        setcontext(&coroutine->context);
+      } /* if */
+    } /* if */
+    if (switchInterpreterState != NULL) {
+      switchInterpreterState(coroutine->interpreterState, FALSE);
+    } /* if */
+    inCoroutine = FALSE;
+    currentCoroutine = NULL;
+    /* The catch stack of the coroutine might have been resized. */
+    coroutine->catchStack = catch_stack;
+    coroutine->catchStackPos = catch_stack_pos;
+    coroutine->maxCatchStack = max_catch_stack;
+    coroutine->exceptionNumber = exception_number;
+    coroutine->errorFile = error_file;
+    coroutine->errorLine = error_line;
+    catch_stack = mainCatchStack;
+    catch_stack_pos = mainCatchStackPos;
+    max_catch_stack = mainMaxCatchStack;
+    exception_number = mainExceptionNumber;
+    error_file = mainErrorFile;
+    error_line = mainErrorLine;
+  } /* resumeCoroutine */
+
+
+
+static void suspendCoroutine (void)
+
+  { /* suspendCoroutine */
+    if (_setjmp(currentCoroutine->jumpBuffer) == 0) {
+      _longjmp(schedulerJumpBuffer, 1);
+    } /* if */
+  } /* suspendCoroutine */
+
+
+
+static void freeCoroutine (coroutineType coroutine)
+
+  {
+    genericType data;
+    destrFuncType destrData;
+
+  /* freeCoroutine */
+    data = coroutine->data;
+    destrData = coroutine->destrData;
+    freeStack(coroutine->stack);
+    free(coroutine->catchStack);
+    free(coroutine->interpreterState);
+    free(coroutine);
+    numCoroutines--;
+    destrData(data);
+  } /* freeCoroutine */
+
+
+
+/**
+ *  Run the coroutines until all of them have finished.
+ *  The coroutines run one after the other. When no coroutine can
+ *  continue corRun() waits until a socket gets ready or a timer
+ *  expires. An exception, which is not caught inside of a coroutine,
+ *  stops the scheduler and is raised by corRun(). The other
+ *  coroutines are kept and can be continued with another corRun().
+ *  @exception RANGE_ERROR If corRun() is called inside of a coroutine.
+ *  @exception FILE_ERROR If waiting for the sockets failed.
+ */
+void corRun (void)
+
+  {
+    coroutineType coroutine;
+    int exceptionNumber;
+
+  /* corRun */
+    logFunction(printf("corRun()\n"););
+    if (unlikely(inCoroutine)) {
+      logError(printf("corRun(): Called inside of a coroutine.\n"););
+      raise_error(RANGE_ERROR);
+    } else {
+      stopRequested = FALSE;
+      while (numCoroutines != 0 && !stopRequested) {
+        if (readyHead != NULL) {
+          coroutine = dequeueReady();
+          resumeCoroutine(coroutine);
+          if (coroutine->finished) {
+            freeCoroutine(coroutine);
+          } /* if */
+        } else if (unlikely(numFdWaiters == 0 && timerHeapSize == 0)) {
+          logError(printf("corRun(): No coroutine can continue.\n"););
+          stopRequested = TRUE;
+        } else if (unlikely(!waitForEvents())) {
+          raise_error(FILE_ERROR);
+          stopRequested = TRUE;
+        } /* if */
+      } /* while */
+      if (uncaughtException != OKAY_NO_ERROR) {
+        exceptionNumber = uncaughtException;
+        uncaughtException = OKAY_NO_ERROR;
+        raise_error2(exceptionNumber, uncaughtFile, uncaughtLine);
+      } /* if */
+    } /* if */
+    logFunction(printf("corRun() -->\n"););
+  } /* corRun */
+
+
+
+/**
+ *  Suspend the current coroutine until 'deadline' is reached.
+ *  Outside of a coroutine this function does nothing.
+ *  @param deadline Point in time in micro seconds (see timMicroSec).
+ *  @exception MEMORY_ERROR Not enough memory to register the timer.
+ */
+void corSleep (intType deadline)
+
+  {
+    coroutineType coroutine;
+
+  /* corSleep */
+    logFunction(printf("corSleep(" FMT_D ")\n", deadline););
+    if (inCoroutine) {
+      coroutine = currentCoroutine;
+      coroutine->waitFd = -1;
+      coroutine->deadline = deadline;
+      if (unlikely(!addTimer(coroutine))) {
+        raise_error(MEMORY_ERROR);
+      } else {
+        suspendCoroutine();
+      } /* if */
+    } /* if */
+    logFunction(printf("corSleep(" FMT_D ") -->\n", deadline););
+  } /* corSleep */
+
+
+
+/**
+ *  Create a coroutine, which calls func(&data) when it is started.
+ *  The new coroutine is appended to the ready queue. It is started
+ *  by corRun() or, if called from a coroutine, after the running
+ *  coroutines have been suspended. The coroutine takes ownership
+ *  of 'data': When it has finished destrData(data) is called.
+ *  @exception MEMORY_ERROR Not enough memory to create the coroutine.
+ */
+void corSpawn (corFuncType func, genericType data, destrFuncType destrData)
+
+  {
+    coroutineType coroutine;
+
+  /* corSpawn */
+    logFunction(printf("corSpawn(" FMT_U_MEM ", " FMT_U_GEN ")\n",
+                       (memSizeType) func, data););
+    coroutine = (coroutineType) malloc(sizeof(coroutineRecord));
+    if (unlikely(coroutine == NULL)) {
+      destrData(data);
+      raise_error(MEMORY_ERROR);
+    } else {
+      memset(coroutine, 0, sizeof(coroutineRecord));
+      coroutine->stack = allocStack();
+      coroutine->catchStack = (catch_type *) malloc(
+          CATCH_STACK_START_SIZE * sizeof(catch_type));
+      if (interpreterStateSize != 0) {
+        coroutine->interpreterState = calloc(1, interpreterStateSize);
+      } /* if */
+      if (unlikely(coroutine->stack == NULL || coroutine->catchStack == NULL ||
+                   (interpreterStateSize != 0 &&
+                    coroutine->interpreterState == NULL) ||
+                   getcontext(&coroutine->context) != 0)) {
+        if (coroutine->stack != NULL) {
+          freeStack(coroutine->stack);
+        } /* if */
+        free(coroutine->catchStack);
+        free(coroutine->interpreterState);
+        free(coroutine);
+        destrData(data);
+        raise_error(MEMORY_ERROR);
+      } else {
+        coroutine->context.uc_stack.ss_sp = coroutine->stack;
+        coroutine->context.uc_stack.ss_size = COROUTINE_STACK_SIZE;
+        coroutine->context.uc_link = NULL;
+        makecontext(&coroutine->context, coroutineEntry, 0);
+        coroutine->func = func;
+        coroutine->data = data;
+        coroutine->destrData = destrData;
+        coroutine->maxCatchStack = CATCH_STACK_START_SIZE;
+        coroutine->exceptionNumber = OKAY_NO_ERROR;
+        coroutine->waitFd = -1;
+        numCoroutines++;
+        enqueueReady(coroutine);
+      } /* if */
+    } /* if */
+    logFunction(printf("corSpawn -->\n"););
+  } /* corSpawn */
+
+
+
+/**
+ *  Stop corRun() after the current coroutine has been left.
+ *  The interpreter uses this when an exception was not caught
+ *  inside of a coroutine.
+ */
+void corStop (void)
+
+  { /* corStop */
+    stopRequested = TRUE;
+  } /* corStop */
+
+
+
+/**
+ *  Forget the registration of 'sock', which is closed.
+ *  Closing removes a socket from the epoll set. The number of the
+ *  socket can be reused by a new socket, which must be registered.
+ */
+void corForgetSocket (socketType sock)
+
+  { /* corForgetSocket */
+    if ((memSizeType) sock < fdTableSize) {
+      fdTable[sock].registered = FALSE;
+    } /* if */
+  } /* corForgetSocket */
+
+
+
+/**
+ *  Suspend the current coroutine until 'sock' is ready.
+ *  The caller must have found that 'sock' is not ready, e.g.
+ *  because recv() or send() failed with EWOULDBLOCK.
+ *  Outside of a coroutine this function must not be called.
+ *  @param forWriting TRUE if the socket should be ready for writing,
+ *         FALSE if it should be ready for reading.
+ *  @param timeout Maximum time to wait in micro seconds, or
+ *         a negative value to wait without a time limit.
+ *  @return TRUE if the socket is ready (or has an error condition),
+ *          FALSE if the timeout expired or registering failed.
+ */
+boolType corWaitForSocket (socketType sock, boolType forWriting,
+    intType timeout)
+
+  {
+    coroutineType coroutine;
+    boolType ready = FALSE;
+
+  /* corWaitForSocket */
+    logFunction(printf("corWaitForSocket(%d, %d, " FMT_D ")\n",
+                       sock, forWriting, timeout););
+    coroutine = currentCoroutine;
+    coroutine->waitFd = (int) sock;
+    coroutine->waitEvents = forWriting ? POLLOUT : POLLIN;
+    coroutine->wokenByEvent = FALSE;
+    if (likely(addWaiter(coroutine))) {
+      if (timeout >= 0) {
+        if (timMicroSec() > INTTYPE_MAX - timeout) {
+          coroutine->deadline = INTTYPE_MAX;
+        } else {
+          coroutine->deadline = timMicroSec() + timeout;
+        } /* if */
+        if (unlikely(!addTimer(coroutine))) {
+          removeWaiter(coroutine);
+          coroutine->waitFd = -1;
+          return FALSE;
+        } /* if */
+      } /* if */
+      suspendCoroutine();
+      ready = coroutine->wokenByEvent;
+    } /* if */
+    coroutine->waitFd = -1;
+    logFunction(printf("corWaitForSocket(%d, %d, " FMT_D ") --> %d\n",
+                       sock, forWriting, timeout, ready););
+    return ready;
+  } /* corWaitForSocket */
+
+
+
+/**
+ *  Let the other ready coroutines run before the current one continues.
+ *  Outside of a coroutine this function does nothing.
+ */
+void corYield (void)
+
+  { /* corYield */
+    logFunction(printf("corYield\n"););
+    if (inCoroutine) {
+      enqueueReady(currentCoroutine);
+      suspendCoroutine();
+    } /* if */
+    logFunction(printf("corYield -->\n"););
+  } /* corYield */
+
+#else
+
+
+
+void initCoroutineOperations (memSizeType stateSize,
+    corSwitchStateFuncType switchState)
+
+  { /* initCoroutineOperations */
+  } /* initCoroutineOperations */
+
+
+
+void corRun (void)
+
+  { /* corRun */
+  } /* corRun */
+
+
+
+void corSleep (intType deadline)
+
+  { /* corSleep */
+  } /* corSleep */
+
+
+
+void corSpawn (corFuncType func, genericType data, destrFuncType destrData)
+
+  { /* corSpawn */
+    logError(printf("corSpawn: Coroutines are not supported.\n"););
+    destrData(data);
+    raise_error(FILE_ERROR);
+  } /* corSpawn */
+
+
+
+void corStop (void)
+
+  { /* corStop */
+  } /* corStop */
+
+
+
+void corForgetSocket (socketType sock)
+
+  { /* corForgetSocket */
+  } /* corForgetSocket */
+
+
+
+boolType corWaitForSocket (socketType sock, boolType forWriting,
+    intType timeout)
+
+  { /* corWaitForSocket */
+    return FALSE;
+  } /* corWaitForSocket */
+
+
+
+void corYield (void)
+
+  { /* corYield */
+  } /* corYield */
+
+#endif
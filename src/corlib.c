@@ -0,0 +1,232 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Library                                                 */
+/*  File: seed7/src/corlib.c                                        */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: All primitive actions to support coroutines.           */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+
+#include "common.h"
+#include "data.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "flistutl.h"
+#include "syvarutl.h"
+#include "objutl.h"
+#include "executl.h"
+#include "exec.h"
+#include "runerr.h"
+#include "itflib.h"
+#include "cor_rtl.h"
+#include "rtl_err.h"
+
+#undef EXTERN
+#define EXTERN
+#include "corlib.h"
+
+
+typedef struct {
+    objectType runner;
+    objectType task;
+  } interpretedTaskRecord, *interpretedTaskType;
+
+/* The state of the interpreter, which belongs to a coroutine. */
+/* While a coroutine runs it holds the state of the scheduler.  */
+typedef struct {
+    objectType action_object;
+    objectType exec_object;
+    listType argument_list;
+    bindingFrameType binding_frame;
+  } interpreterStateRecord, *interpreterStateType;
+
+static boolType coroutineOpsInitialized = FALSE;
+static boolType exceptionPending = FALSE;
+static failStateStruct pendingFailState;
+
+
+
+static void switchInterpreterState (void *state, boolType enter)
+
+  {
+    interpreterStateType interpreterState;
+    objectType action_object;
+    objectType exec_object;
+    listType argument_list;
+    bindingFrameType binding_frame;
+
+  /* switchInterpreterState */
+    interpreterState = (interpreterStateType) state;
+    if (!enter) {
+      exchangeBindings(curr_binding_frame, FALSE);
+    } /* if */
+    action_object = curr_action_object;
+    exec_object = curr_exec_object;
+    argument_list = curr_argument_list;
+    binding_frame = curr_binding_frame;
+    curr_action_object = interpreterState->action_object;
+    curr_exec_object = interpreterState->exec_object;
+    curr_argument_list = interpreterState->argument_list;
+    curr_binding_frame = interpreterState->binding_frame;
+    interpreterState->action_object = action_object;
+    interpreterState->exec_object = exec_object;
+    interpreterState->argument_list = argument_list;
+    interpreterState->binding_frame = binding_frame;
+    if (enter) {
+      exchangeBindings(curr_binding_frame, TRUE);
+    } /* if */
+  } /* switchInterpreterState */
+
+
+
+static void runInterpreted (genericType *data)
+
+  {
+    interpretedTaskType interpretedTask;
+
+  /* runInterpreted */
+    interpretedTask = (interpretedTaskType) (memSizeType) *data;
+    param2_call(interpretedTask->runner, interpretedTask->task,
+                interpretedTask->runner);
+    if (fail_flag) {
+      /* The exception is raised again by cor_run. */
+      if (!exceptionPending) {
+        saveFailState(&pendingFailState);
+        exceptionPending = TRUE;
+      } /* if */
+      corStop();
+    } /* if */
+  } /* runInterpreted */
+
+
+
+static void destrInterpretedTask (const genericType data)
+
+  {
+    interpretedTaskType interpretedTask;
+
+  /* destrInterpretedTask */
+    interpretedTask = (interpretedTaskType) (memSizeType) data;
+    destr_interface(interpretedTask->task->value.objValue);
+    FREE_OBJECT(interpretedTask->task);
+    free(interpretedTask);
+  } /* destrInterpretedTask */
+
+
+
+/**
+ *  Run the coroutines until all of them have finished.
+ *  An exception, which is not caught in a coroutine, stops the
+ *  coroutines and is raised by cor_run.
+ */
+objectType cor_run (listType arguments)
+
+  {
+    failStateStruct ignoredFailState;
+
+  /* cor_run */
+    corRun();
+    if (exceptionPending) {
+      exceptionPending = FALSE;
+      if (fail_flag) {
+        saveFailState(&ignoredFailState);
+      } /* if */
+      restoreFailState(&pendingFailState);
+      return fail_value;
+    } else {
+      return SYS_EMPTY_OBJECT;
+    } /* if */
+  } /* cor_run */
+
+
+
+/**
+ *  Create a coroutine, which calls runner/arg_2 with task/arg_1.
+ *  The coroutine is started by cor_run.
+ */
+objectType cor_spawn (listType arguments)
+
+  {
+    objectType task;
+    interpretedTaskType interpretedTask;
+    listRecord create_arguments[3];
+
+  /* cor_spawn */
+    isit_interface(arg_1(arguments));
+    isit_reference(arg_2(arguments));
+    if (!coroutineOpsInitialized) {
+      initCoroutineOperations(sizeof(interpreterStateRecord),
+                              switchInterpreterState);
+      coroutineOpsInitialized = TRUE;
+    } /* if */
+    interpretedTask = (interpretedTaskType) malloc(sizeof(interpretedTaskRecord));
+    if (unlikely(interpretedTask == NULL)) {
+      return raise_exception(SYS_MEM_EXCEPTION);
+    } else if (unlikely(!ALLOC_OBJECT(task))) {
+      free(interpretedTask);
+      return raise_exception(SYS_MEM_EXCEPTION);
+    } else {
+      /* The task is a variable, which refers to the same struct. */
+      task->type_of = arg_1(arguments)->type_of;
+      task->descriptor.property = NULL;
+      INIT_CATEGORY_OF_VAR(task, INTERFACEOBJECT);
+      task->value.objValue = NULL;
+      create_arguments[0].next = &create_arguments[1];
+      create_arguments[1].next = &create_arguments[2];
+      create_arguments[2].next = NULL;
+      create_arguments[0].obj = task;
+      create_arguments[1].obj = NULL;
+      create_arguments[2].obj = arg_1(arguments);
+      itf_create(create_arguments);
+      if (unlikely(fail_flag)) {
+        FREE_OBJECT(task);
+        free(interpretedTask);
+        return fail_value;
+      } else {
+        interpretedTask->runner = take_reference(arg_2(arguments));
+        interpretedTask->task = task;
+        corSpawn(runInterpreted, (genericType) (memSizeType) interpretedTask,
+                 destrInterpretedTask);
+        return SYS_EMPTY_OBJECT;
+      } /* if */
+    } /* if */
+  } /* cor_spawn */
+
+
+
+/**
+ *  Let the other ready coroutines run before this one continues.
+ */
+objectType cor_yield (listType arguments)
+
+  { /* cor_yield */
+    corYield();
+    return SYS_EMPTY_OBJECT;
+  } /* cor_yield */
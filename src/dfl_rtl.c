@@ -0,0 +1,2176 @@
+/********************************************************************/
+/*                                                                  */
+/*  dfl_rtl.c     DEFLATE compression and decompression.            */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/dfl_rtl.c                                       */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: DEFLATE compression and decompression (RFC 1951).      */
+/*                                                                  */
+/*  The state of an incremental compression or decompression is     */
+/*  stored in a bstring. It consists of a small header followed by  */
+/*  the sliding window. The decoder can stop at any Huffman symbol  */
+/*  and continue with the next call. Whole bytes of the bit buffer  */
+/*  are given back to the caller, such that the state never refers  */
+/*  to input bytes that the caller has already discarded.           */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+
+#include "common.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "striutl.h"
+#include "rtl_err.h"
+
+#undef EXTERN
+#define EXTERN
+#include "dfl_rtl.h"
+
+
+#define WINDOW_SIZE           32768
+#define WINDOW64_SIZE         65536
+#define MIN_MATCH_LENGTH          3
+#define MAX_MATCH_LENGTH        258
+#define MAX_MATCH64_LENGTH    65538
+#define COPY_SLACK                8
+#define MIN_OUTPUT_CHUNK      65536
+#define SYMBOL_INPUT_MARGIN      16
+#define HEADER_INPUT_MARGIN     640
+#define NUM_LITLEN_CODES        288
+#define NUM_DIST_CODES           32
+#define NUM_CODELEN_CODES        19
+#define END_OF_BLOCK            256
+#define MAX_CODE_LENGTH          15
+#define MAX_CODELEN_LENGTH        7
+
+/* Decoding tables consist of a root table, which is indexed with */
+/* ROOT_BITS bits, and of subtables for codes longer than that.   */
+#define ROOT_BITS                10
+#define SUBTABLE_BITS             (MAX_CODE_LENGTH - ROOT_BITS)
+#define ROOT_MASK                 ((1 << ROOT_BITS) - 1)
+#define SUBTABLE_MASK             ((1 << SUBTABLE_BITS) - 1)
+#define LITLEN_TABLE_SIZE         ((1 << ROOT_BITS) + NUM_LITLEN_CODES * (1 << SUBTABLE_BITS))
+#define DIST_TABLE_SIZE           ((1 << ROOT_BITS) + NUM_DIST_CODES * (1 << SUBTABLE_BITS))
+#define CODELEN_TABLE_SIZE        (1 << ROOT_BITS)
+
+#define ENTRY_LITERAL  0
+#define ENTRY_BASE     1
+#define ENTRY_END      2
+#define ENTRY_LINK     3
+#define ENTRY_INVALID  4
+
+#define MAKE_ENTRY(kind, extra, bits, value) \
+    ((uint32Type) (kind) << 28 | (uint32Type) (extra) << 20 | \
+     (uint32Type) (bits) << 16 | (uint32Type) (value))
+#define ENTRY_KIND(entry)  ((entry) >> 28)
+#define ENTRY_EXTRA(entry) (((entry) >> 20) & 0x1f)
+#define ENTRY_BITS(entry)  (((entry) >> 16) & 0xf)
+#define ENTRY_VALUE(entry) ((entry) & 0xffff)
+
+#define LITLEN_TABLE   0
+#define DIST_TABLE     1
+#define CODELEN_TABLE  2
+
+#define MODE_BLOCK_HEADER 0
+#define MODE_STORED       1
+#define MODE_HUFFMAN      2
+#define MODE_FINISHED     3
+
+#define STATUS_RUNNING      0
+#define STATUS_END_OF_BLOCK 1
+#define STATUS_OUTPUT_FULL  2
+#define STATUS_NEED_INPUT   3
+#define STATUS_FINISHED     4
+#define STATUS_DATA_ERROR   5
+#define STATUS_MEMORY_ERROR 6
+
+/* Deflate */
+#define DEFAULT_LEVEL             6
+#define MAX_LEVEL                 9
+#define MAX_DISTANCE          (WINDOW_SIZE - 1)
+#define TOO_FAR                4096
+#define HASH_BITS                15
+#define HASH_SIZE             (1 << HASH_BITS)
+#define WINDOW_MASK           (WINDOW_SIZE - 1)
+#define NO_POSITION              -1
+#define SEGMENT_SIZE         0x100000
+#define DATA_SLACK                8
+#define BLOCK_SYMBOLS         16384
+#define MAX_STORED_LENGTH     65535
+#define NUM_LENGTH_SYMBOLS      286
+#define NUM_DISTANCE_SYMBOLS     30
+
+static const uint16Type lengthBase[] = {
+      3,   4,   5,   6,   7,   8,   9,  10,  11,  13,  15,  17,  19,  23,  27,
+     31,  35,  43,  51,  59,  67,  83,  99, 115, 131, 163, 195, 227, 258
+  };
+
+static const ucharType lengthExtraBits[] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4,
+    5, 5, 5, 5, 0
+  };
+
+static const uint16Type distanceBase[] = {
+        1,     2,     3,     4,     5,     7,     9,    13,    17,    25,
+       33,    49,    65,    97,   129,   193,   257,   385,   513,   769,
+     1025,  1537,  2049,  3073,  4097,  6145,  8193, 12289, 16385, 24577,
+    32769, 49153
+  };
+
+static const ucharType distanceExtraBits[] = {
+     0,  0,  0,  0,  1,  1,  2,  2,  3,  3,  4,  4,  5,  5,  6,  6,
+     7,  7,  8,  8,  9,  9, 10, 10, 11, 11, 12, 12, 13, 13, 14, 14
+  };
+
+static const ucharType codeLengthOrder[] = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+  };
+
+/* Parameters of the compression levels 1 to 9 as used by zlib. */
+/* Levels up to 3 use greedy matching, the others lazy matching. */
+static const struct {
+    uint16Type goodLength;
+    uint16Type lazyLength;
+    uint16Type niceLength;
+    uint16Type maxChain;
+  } levelConfig[] = {
+    /* 0 */ {  0,   0,   0,    0},
+    /* 1 */ {  4,   4,   8,    4},
+    /* 2 */ {  4,   5,  16,    8},
+    /* 3 */ {  4,   6,  32,   32},
+    /* 4 */ {  4,   4,  16,   16},
+    /* 5 */ {  8,  16,  32,   32},
+    /* 6 */ {  8,  16, 128,  128},
+    /* 7 */ {  8,  32, 128,  256},
+    /* 8 */ { 32, 128, 258, 1024},
+    /* 9 */ { 32, 258, 258, 4096}
+  };
+
+typedef struct {
+    uint32Type deflate64;
+    uint32Type mode;
+    uint32Type lastBlock;
+    uint32Type storedRemaining;
+    uint32Type bitBuf;
+    uint32Type bitCount;
+    uint32Type windowFill;
+    uint32Type numLitLenCodes;
+    uint32Type numDistCodes;
+    ucharType codeLengths[NUM_LITLEN_CODES + NUM_DIST_CODES];
+  } inflateStateRecord;
+
+typedef struct {
+    inflateStateRecord state;
+    const ucharType *in;
+    memSizeType inLength;
+    memSizeType inPos;
+    boolType inputEnd;
+    uint64Type bitBuf;
+    unsigned int bitCount;
+    unsigned int paddingBits;
+    ucharType *out;
+    memSizeType outPos;
+    memSizeType outCapacity;
+    memSizeType outLimit;
+    memSizeType maxMatchLength;
+    uint32Type litLenTable[LITLEN_TABLE_SIZE];
+    uint32Type distTable[DIST_TABLE_SIZE];
+    uint32Type codeLenTable[CODELEN_TABLE_SIZE];
+  } inflateWorkRecord, *inflateWorkType;
+
+typedef struct {
+    uint32Type level;
+    uint32Type finished;
+    uint32Type bitBuf;
+    uint32Type bitCount;
+    uint32Type windowFill;
+  } deflateStateRecord;
+
+typedef struct {
+    deflateStateRecord state;
+    ucharType *data;
+    memSizeType dataLength;
+    memSizeType blockStart;
+    memSizeType emittedPos;
+    ucharType *out;
+    memSizeType outPos;
+    memSizeType outCapacity;
+    uint64Type bitBuf;
+    unsigned int bitCount;
+    boolType memoryError;
+    unsigned int numSymbols;
+    uint16Type symbolLitLen[BLOCK_SYMBOLS];
+    uint16Type symbolDistance[BLOCK_SYMBOLS];
+    uint32Type litLenFreq[NUM_LENGTH_SYMBOLS];
+    uint32Type distFreq[NUM_DISTANCE_SYMBOLS];
+    ucharType lengthCode[MAX_MATCH_LENGTH + 1];
+    ucharType distanceCode[512];
+    int32Type head[HASH_SIZE];
+    int32Type prev[WINDOW_SIZE];
+  } deflateWorkRecord, *deflateWorkType;
+
+#define ALLOC_INFLATE_WORK(var) (ALLOC_HEAP(var, inflateWorkType, sizeof(inflateWorkRecord))?CNT(CNT1_BYT(sizeof(inflateWorkRecord))) TRUE:FALSE)
+#define FREE_INFLATE_WORK(var)  (CNT(CNT2_BYT(sizeof(inflateWorkRecord))) FREE_HEAP(var, sizeof(inflateWorkRecord)))
+#define ALLOC_DEFLATE_WORK(var) (ALLOC_HEAP(var, deflateWorkType, sizeof(deflateWorkRecord))?CNT(CNT1_BYT(sizeof(deflateWorkRecord))) TRUE:FALSE)
+#define FREE_DEFLATE_WORK(var)  (CNT(CNT2_BYT(sizeof(deflateWorkRecord))) FREE_HEAP(var, sizeof(deflateWorkRecord)))
+#define REALLOC_UBYTES(var,byt) REALLOC_HEAP(var, ucharType *, byt)
+#define COUNT3_UBYTES(byt1,byt2) CNT3(CNT2_BYT(byt1), CNT1_BYT(byt2))
+
+
+
+static inline uint64Type loadLittleEndian64 (const ucharType *bytes)
+
+  {
+    uint64Type number;
+
+  /* loadLittleEndian64 */
+#if LITTLE_ENDIAN_INTTYPE
+    memcpy(&number, bytes, sizeof(uint64Type));
+#else
+    number = (uint64Type) bytes[0]       | (uint64Type) bytes[1] <<  8 |
+             (uint64Type) bytes[2] << 16 | (uint64Type) bytes[3] << 24 |
+             (uint64Type) bytes[4] << 32 | (uint64Type) bytes[5] << 40 |
+             (uint64Type) bytes[6] << 48 | (uint64Type) bytes[7] << 56;
+#endif
+    return number;
+  } /* loadLittleEndian64 */
+
+
+
+static striType bytesToStri (const ucharType *bytes, memSizeType length)
+
+  {
+    striType result;
+
+  /* bytesToStri */
+    if (unlikely(!ALLOC_STRI_CHECK_SIZE(result, length))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      result->size = length;
+      memcpy_to_strelem(result->mem, bytes, length);
+    } /* if */
+    return result;
+  } /* bytesToStri */
+
+
+
+/**
+ *  Make sure that 'capacity' bytes can be stored at 'buffer'.
+ *  The buffer grows at least by a factor of two.
+ *  @return TRUE if the buffer is big enough, FALSE if there
+ *          is not enough memory.
+ */
+static boolType growBuffer (ucharType **buffer, memSizeType *bufferCapacity,
+    memSizeType capacity)
+
+  {
+    memSizeType newCapacity;
+    ucharType *resized;
+    boolType okay = TRUE;
+
+  /* growBuffer */
+    if (capacity > *bufferCapacity) {
+      newCapacity = *bufferCapacity * 2;
+      if (newCapacity < capacity || newCapacity < *bufferCapacity) {
+        newCapacity = capacity;
+      } /* if */
+      resized = REALLOC_UBYTES(*buffer, newCapacity);
+      if (unlikely(resized == NULL)) {
+        okay = FALSE;
+      } else {
+        COUNT3_UBYTES(*bufferCapacity, newCapacity);
+        *buffer = resized;
+        *bufferCapacity = newCapacity;
+      } /* if */
+    } /* if */
+    return okay;
+  } /* growBuffer */
+
+
+
+/**
+ *  Fill the bit buffer of 'work' such that it contains at least 56 bits.
+ *  At the end of the input zero bytes are added, which are counted in
+ *  'paddingBits'. Consuming them is detected with 'paddingBits'.
+ */
+static inline void refillBits (inflateWorkType work)
+
+  { /* refillBits */
+    if (likely(work->inLength - work->inPos >= 8)) {
+      work->bitBuf |= loadLittleEndian64(&work->in[work->inPos]) << work->bitCount;
+      work->inPos += (63 - work->bitCount) >> 3;
+      work->bitCount |= 56;
+    } else {
+      while (work->bitCount < 56) {
+        if (work->inPos < work->inLength) {
+          work->bitBuf |= (uint64Type) work->in[work->inPos] << work->bitCount;
+          work->inPos++;
+        } else {
+          work->paddingBits += 8;
+        } /* if */
+        work->bitCount += 8;
+      } /* while */
+    } /* if */
+  } /* refillBits */
+
+
+
+static inline uint32Type takeBits (inflateWorkType work, unsigned int numBits)
+
+  {
+    uint32Type bits;
+
+  /* takeBits */
+    bits = (uint32Type) (work->bitBuf & (((uint64Type) 1 << numBits) - 1));
+    work->bitBuf >>= numBits;
+    work->bitCount -= numBits;
+    return bits;
+  } /* takeBits */
+
+
+
+/**
+ *  Decode a Huffman symbol with the decoding table 'table'.
+ *  The bit buffer must contain at least MAX_CODE_LENGTH bits.
+ *  @return the table entry of the symbol.
+ */
+static inline uint32Type decodeEntry (inflateWorkType work,
+    const uint32Type *table)
+
+  {
+    uint32Type entry;
+
+  /* decodeEntry */
+    entry = table[work->bitBuf & ROOT_MASK];
+    if (ENTRY_KIND(entry) == ENTRY_LINK) {
+      work->bitBuf >>= ROOT_BITS;
+      work->bitCount -= ROOT_BITS;
+      entry = table[ENTRY_VALUE(entry) + (work->bitBuf & SUBTABLE_MASK)];
+    } /* if */
+    work->bitBuf >>= ENTRY_BITS(entry);
+    work->bitCount -= ENTRY_BITS(entry);
+    return entry;
+  } /* decodeEntry */
+
+
+
+static uint32Type symbolEntry (int tableKind, unsigned int symbol,
+    boolType deflate64)
+
+  {
+    uint32Type entry;
+
+  /* symbolEntry */
+    if (tableKind == CODELEN_TABLE) {
+      entry = MAKE_ENTRY(ENTRY_LITERAL, 0, 0, symbol);
+    } else if (tableKind == LITLEN_TABLE) {
+      if (symbol < END_OF_BLOCK) {
+        entry = MAKE_ENTRY(ENTRY_LITERAL, 0, 0, symbol);
+      } else if (symbol == END_OF_BLOCK) {
+        entry = MAKE_ENTRY(ENTRY_END, 0, 0, 0);
+      } else if (symbol < 285) {
+        entry = MAKE_ENTRY(ENTRY_BASE, lengthExtraBits[symbol - 257], 0,
+                           lengthBase[symbol - 257]);
+      } else if (symbol == 285) {
+        if (deflate64) {
+          entry = MAKE_ENTRY(ENTRY_BASE, 16, 0, 3);
+        } else {
+          entry = MAKE_ENTRY(ENTRY_BASE, 0, 0, 258);
+        } /* if */
+      } else {
+        entry = MAKE_ENTRY(ENTRY_INVALID, 0, 0, 0);
+      } /* if */
+    } else if (symbol < 30 || (deflate64 && symbol < NUM_DIST_CODES)) {
+      entry = MAKE_ENTRY(ENTRY_BASE, distanceExtraBits[symbol], 0,
+                         distanceBase[symbol]);
+    } else {
+      entry = MAKE_ENTRY(ENTRY_INVALID, 0, 0, 0);
+    } /* if */
+    return entry;
+  } /* symbolEntry */
+
+
+
+/**
+ *  Build a decoding table for the canonical Huffman code with the
+ *  code lengths 'lengths'. Codes with up to ROOT_BITS bits are
+ *  decoded with the root table. Longer codes use a subtable with
+ *  SUBTABLE_BITS bits. An incomplete code is accepted. Unused bit
+ *  patterns lead to invalid entries.
+ *  @return TRUE if the code is okay, FALSE if it is over-subscribed.
+ */
+static boolType buildDecodingTable (const ucharType *lengths,
+    unsigned int numCodes, int tableKind, boolType deflate64,
+    uint32Type *table)
+
+  {
+    unsigned int count[MAX_CODE_LENGTH + 1];
+    unsigned int nextCode[MAX_CODE_LENGTH + 1];
+    int left;
+    unsigned int length;
+    unsigned int symbol;
+    unsigned int code;
+    unsigned int reversed;
+    unsigned int index;
+    unsigned int rootIndex;
+    uint32Type subtable;
+    uint32Type subtableStart = 1 << ROOT_BITS;
+    uint32Type invalid;
+    uint32Type entry;
+    boolType okay = TRUE;
+
+  /* buildDecodingTable */
+    memset(count, 0, sizeof(count));
+    for (symbol = 0; symbol < numCodes; symbol++) {
+      count[lengths[symbol]]++;
+    } /* for */
+    count[0] = 0;
+    left = 1;
+    code = 0;
+    for (length = 1; length <= MAX_CODE_LENGTH; length++) {
+      left = 2 * left - (int) count[length];
+      if (left < 0) {
+        okay = FALSE;
+      } /* if */
+      code = (code + count[length - 1]) << 1;
+      nextCode[length] = code;
+    } /* for */
+    if (okay) {
+      invalid = MAKE_ENTRY(ENTRY_INVALID, 0, 0, 0);
+      for (index = 0; index < (1 << ROOT_BITS); index++) {
+        table[index] = invalid;
+      } /* for */
+      for (symbol = 0; symbol < numCodes; symbol++) {
+        length = lengths[symbol];
+        if (length != 0) {
+          code = nextCode[length]++;
+          reversed = 0;
+          for (index = 0; index < length; index++) {
+            reversed = (reversed << 1) | ((code >> index) & 1);
+          } /* for */
+          entry = symbolEntry(tableKind, symbol, deflate64);
+          if (length <= ROOT_BITS) {
+            entry |= (uint32Type) length << 16;
+            for (index = reversed; index < (1 << ROOT_BITS);
+                 index += 1U << length) {
+              table[index] = entry;
+            } /* for */
+          } else {
+            rootIndex = reversed & ROOT_MASK;
+            if (ENTRY_KIND(table[rootIndex]) != ENTRY_LINK) {
+              table[rootIndex] = MAKE_ENTRY(ENTRY_LINK, 0, ROOT_BITS, subtableStart);
+              for (index = 0; index < (1 << SUBTABLE_BITS); index++) {
+                table[subtableStart + index] = invalid;
+              } /* for */
+              subtableStart += 1 << SUBTABLE_BITS;
+            } /* if */
+            subtable = ENTRY_VALUE(table[rootIndex]);
+            entry |= (uint32Type) (length - ROOT_BITS) << 16;
+            for (index = reversed >> ROOT_BITS; index < (1 << SUBTABLE_BITS);
+                 index += 1U << (length - ROOT_BITS)) {
+              table[subtable + index] = entry;
+            } /* for */
+          } /* if */
+        } /* if */
+      } /* for */
+    } /* if */
+    return okay;
+  } /* buildDecodingTable */
+
+
+
+static boolType buildBlockTables (inflateWorkType work)
+
+  {
+    boolType deflate64;
+
+  /* buildBlockTables */
+    deflate64 = work->state.deflate64 != 0;
+    return buildDecodingTable(work->state.codeLengths,
+                              work->state.numLitLenCodes, LITLEN_TABLE,
+                              deflate64, work->litLenTable) &&
+           buildDecodingTable(&work->state.codeLengths[NUM_LITLEN_CODES],
+                              work->state.numDistCodes, DIST_TABLE,
+                              deflate64, work->distTable);
+  } /* buildBlockTables */
+
+
+
+static void setFixedCodeLengths (inflateStateRecord *state)
+
+  {
+    unsigned int symbol;
+
+  /* setFixedCodeLengths */
+    for (symbol = 0; symbol < 144; symbol++) {
+      state->codeLengths[symbol] = 8;
+    } /* for */
+    for (; symbol < 256; symbol++) {
+      state->codeLengths[symbol] = 9;
+    } /* for */
+    for (; symbol < 280; symbol++) {
+      state->codeLengths[symbol] = 7;
+    } /* for */
+    for (; symbol < NUM_LITLEN_CODES; symbol++) {
+      state->codeLengths[symbol] = 8;
+    } /* for */
+    for (symbol = 0; symbol < NUM_DIST_CODES; symbol++) {
+      state->codeLengths[NUM_LITLEN_CODES + symbol] = 5;
+    } /* for */
+    state->numLitLenCodes = NUM_LITLEN_CODES;
+    state->numDistCodes = NUM_DIST_CODES;
+  } /* setFixedCodeLengths */
+
+
+
+/**
+ *  Read the code lengths of a block with dynamic Huffman codes.
+ *  The caller makes sure that the whole header is in the input.
+ */
+static int readDynamicHeader (inflateWorkType work)
+
+  {
+    ucharType codeLenLengths[NUM_CODELEN_CODES];
+    ucharType lengths[NUM_LITLEN_CODES + NUM_DIST_CODES];
+    unsigned int numLitLenCodes;
+    unsigned int numDistCodes;
+    unsigned int numCodeLenCodes;
+    unsigned int numCodes;
+    unsigned int index;
+    unsigned int repeat;
+    ucharType value;
+    uint32Type entry;
+    int status = STATUS_RUNNING;
+
+  /* readDynamicHeader */
+    refillBits(work);
+    numLitLenCodes = takeBits(work, 5) + 257;
+    numDistCodes = takeBits(work, 5) + 1;
+    numCodeLenCodes = takeBits(work, 4) + 4;
+    if (numLitLenCodes > 286 ||
+        numDistCodes > (work->state.deflate64 ? NUM_DIST_CODES : 30)) {
+      logError(printf("readDynamicHeader: Too many codes (%u, %u).\n",
+                      numLitLenCodes, numDistCodes););
+      status = STATUS_DATA_ERROR;
+    } else {
+      memset(codeLenLengths, 0, sizeof(codeLenLengths));
+      for (index = 0; index < numCodeLenCodes; index++) {
+        if (work->bitCount < 3) {
+          refillBits(work);
+        } /* if */
+        codeLenLengths[codeLengthOrder[index]] = (ucharType) takeBits(work, 3);
+      } /* for */
+      if (!buildDecodingTable(codeLenLengths, NUM_CODELEN_CODES,
+                              CODELEN_TABLE, FALSE, work->codeLenTable)) {
+        logError(printf("readDynamicHeader: Illegal code length code.\n"););
+        status = STATUS_DATA_ERROR;
+      } /* if */
+      numCodes = numLitLenCodes + numDistCodes;
+      index = 0;
+      while (index < numCodes && status == STATUS_RUNNING) {
+        if (work->bitCount < MAX_CODELEN_LENGTH + 7) {
+          refillBits(work);
+        } /* if */
+        entry = decodeEntry(work, work->codeLenTable);
+        if (ENTRY_KIND(entry) != ENTRY_LITERAL) {
+          status = STATUS_DATA_ERROR;
+        } else if (ENTRY_VALUE(entry) < 16) {
+          lengths[index] = (ucharType) ENTRY_VALUE(entry);
+          index++;
+        } else {
+          if (ENTRY_VALUE(entry) == 16) {
+            if (index == 0) {
+              status = STATUS_DATA_ERROR;
+              value = 0;
+            } else {
+              value = lengths[index - 1];
+            } /* if */
+            repeat = takeBits(work, 2) + 3;
+          } else if (ENTRY_VALUE(entry) == 17) {
+            value = 0;
+            repeat = takeBits(work, 3) + 3;
+          } else {
+            value = 0;
+            repeat = takeBits(work, 7) + 11;
+          } /* if */
+          if (repeat > numCodes - index) {
+            status = STATUS_DATA_ERROR;
+          } else {
+            memset(&lengths[index], value, repeat);
+            index += repeat;
+          } /* if */
+        } /* if */
+      } /* while */
+      if (status == STATUS_RUNNING) {
+        if (lengths[END_OF_BLOCK] == 0) {
+          logError(printf("readDynamicHeader: No end-of-block code.\n"););
+          status = STATUS_DATA_ERROR;
+        } else {
+          memcpy(work->state.codeLengths, lengths, numLitLenCodes);
+          memcpy(&work->state.codeLengths[NUM_LITLEN_CODES],
+                 &lengths[numLitLenCodes], numDistCodes);
+          work->state.numLitLenCodes = numLitLenCodes;
+          work->state.numDistCodes = numDistCodes;
+        } /* if */
+      } /* if */
+    } /* if */
+    return status;
+  } /* readDynamicHeader */
+
+
+
+static int readBlockHeader (inflateWorkType work)
+
+  {
+    memSizeType available;
+    uint32Type blockType;
+    uint32Type length;
+    int status = STATUS_RUNNING;
+
+  /* readBlockHeader */
+    available = work->inLength - work->inPos + work->bitCount / 8;
+    if (work->state.lastBlock) {
+      work->state.mode = MODE_FINISHED;
+    } else if (!work->inputEnd && available < HEADER_INPUT_MARGIN) {
+      status = STATUS_NEED_INPUT;
+    } else {
+      refillBits(work);
+      work->state.lastBlock = takeBits(work, 1);
+      blockType = takeBits(work, 2);
+      switch (blockType) {
+        case 0:
+          takeBits(work, work->bitCount % 8);
+          refillBits(work);
+          length = takeBits(work, 16);
+          if (takeBits(work, 16) != (~length & 0xffff)) {
+            logError(printf("readBlockHeader: Stored block length does not "
+                            "match its complement.\n"););
+            status = STATUS_DATA_ERROR;
+          } else {
+            work->state.storedRemaining = length;
+            work->state.mode = MODE_STORED;
+          } /* if */
+          break;
+        case 1:
+          setFixedCodeLengths(&work->state);
+          buildBlockTables(work);
+          work->state.mode = MODE_HUFFMAN;
+          break;
+        case 2:
+          status = readDynamicHeader(work);
+          if (status == STATUS_RUNNING) {
+            if (buildBlockTables(work)) {
+              work->state.mode = MODE_HUFFMAN;
+            } else {
+              logError(printf("readBlockHeader: Over-subscribed code.\n"););
+              status = STATUS_DATA_ERROR;
+            } /* if */
+          } /* if */
+          break;
+        default:
+          logError(printf("readBlockHeader: Illegal block type.\n"););
+          status = STATUS_DATA_ERROR;
+          break;
+      } /* switch */
+      if (work->bitCount < work->paddingBits) {
+        logError(printf("readBlockHeader: Unexpected end of data.\n"););
+        status = STATUS_DATA_ERROR;
+      } /* if */
+    } /* if */
+    return status;
+  } /* readBlockHeader */
+
+
+
+static int copyStoredBlock (inflateWorkType work)
+
+  {
+    memSizeType length;
+    int status = STATUS_RUNNING;
+
+  /* copyStoredBlock */
+    while (work->state.storedRemaining != 0 && status == STATUS_RUNNING) {
+      if (work->outPos >= work->outLimit) {
+        status = STATUS_OUTPUT_FULL;
+      } else if (work->outPos == work->outCapacity &&
+                 !growBuffer(&work->out, &work->outCapacity,
+                             work->outCapacity + work->state.storedRemaining)) {
+        status = STATUS_MEMORY_ERROR;
+      } else if (work->bitCount >= work->paddingBits + 8) {
+        work->out[work->outPos] = (ucharType) takeBits(work, 8);
+        work->outPos++;
+        work->state.storedRemaining--;
+      } else if (work->bitCount >= 8) {
+        logError(printf("copyStoredBlock: Unexpected end of data.\n"););
+        status = STATUS_DATA_ERROR;
+      } else if (work->inPos < work->inLength) {
+        /* The bit buffer is empty, but it may contain bits of the */
+        /* byte at inPos. They are outdated after the copy.         */
+        work->bitBuf = 0;
+        length = work->state.storedRemaining;
+        if (length > work->inLength - work->inPos) {
+          length = work->inLength - work->inPos;
+        } /* if */
+        if (length > work->outCapacity - work->outPos) {
+          length = work->outCapacity - work->outPos;
+        } /* if */
+        memcpy(&work->out[work->outPos], &work->in[work->inPos], length);
+        work->outPos += length;
+        work->inPos += length;
+        work->state.storedRemaining -= (uint32Type) length;
+      } else if (work->inputEnd) {
+        logError(printf("copyStoredBlock: Unexpected end of data.\n"););
+        status = STATUS_DATA_ERROR;
+      } else {
+        status = STATUS_NEED_INPUT;
+      } /* if */
+    } /* while */
+    if (work->state.storedRemaining == 0) {
+      work->state.mode = MODE_BLOCK_HEADER;
+    } /* if */
+    return status;
+  } /* copyStoredBlock */
+
+
+
+/**
+ *  Copy 'length' bytes from 'distance' bytes before 'dest' to 'dest'.
+ *  Source and destination may overlap. Up to COPY_SLACK - 1 bytes
+ *  after the end of the copied area may be overwritten.
+ */
+static inline void copyMatch (ucharType *dest, memSizeType distance,
+    memSizeType length)
+
+  {
+    const ucharType *source;
+    ucharType *end;
+
+  /* copyMatch */
+    source = dest - distance;
+    end = dest + length;
+    if (distance >= 8) {
+      do {
+        memcpy(dest, source, 8);
+        dest += 8;
+        source += 8;
+      } while (dest < end);
+    } else if (distance == 1) {
+      memset(dest, *source, length);
+    } else {
+      do {
+        *dest++ = *source++;
+      } while (dest < end);
+    } /* if */
+  } /* copyMatch */
+
+
+
+/**
+ *  Decode the symbols of a block with Huffman codes.
+ *  The hot path works on local copies of the bit buffer and the
+ *  output position, since stores to the output may alias 'work'.
+ */
+static int decodeHuffmanBlock (inflateWorkType work)
+
+  {
+    const ucharType *in;
+    memSizeType inLength;
+    memSizeType inPos;
+    uint64Type bitBuf;
+    unsigned int bitCount;
+    ucharType *out;
+    memSizeType outPos;
+    memSizeType outLimit;
+    memSizeType outMargin;
+    const uint32Type *litLenTable;
+    const uint32Type *distTable;
+    uint32Type entry;
+    memSizeType length;
+    memSizeType distance;
+    int status = STATUS_RUNNING;
+
+  /* decodeHuffmanBlock */
+    in = work->in;
+    inLength = work->inLength;
+    inPos = work->inPos;
+    bitBuf = work->bitBuf;
+    bitCount = work->bitCount;
+    out = work->out;
+    outPos = work->outPos;
+    outLimit = work->outLimit;
+    outMargin = work->maxMatchLength + COPY_SLACK;
+    litLenTable = work->litLenTable;
+    distTable = work->distTable;
+    do {
+      if (outPos >= outLimit) {
+        status = STATUS_OUTPUT_FULL;
+      } else if (unlikely(work->outCapacity - outPos < outMargin)) {
+        if (growBuffer(&work->out, &work->outCapacity, outPos + outMargin)) {
+          out = work->out;
+        } else {
+          status = STATUS_MEMORY_ERROR;
+        } /* if */
+      } else if (unlikely(inLength - inPos < SYMBOL_INPUT_MARGIN) &&
+                 !work->inputEnd) {
+        status = STATUS_NEED_INPUT;
+      } else {
+        if (likely(inLength - inPos >= 8)) {
+          bitBuf |= loadLittleEndian64(&in[inPos]) << bitCount;
+          inPos += (63 - bitCount) >> 3;
+          bitCount |= 56;
+        } else {
+          work->inPos = inPos;
+          work->bitBuf = bitBuf;
+          work->bitCount = bitCount;
+          if (bitCount < work->paddingBits) {
+            status = STATUS_DATA_ERROR;
+          } /* if */
+          refillBits(work);
+          inPos = work->inPos;
+          bitBuf = work->bitBuf;
+          bitCount = work->bitCount;
+        } /* if */
+        entry = litLenTable[bitBuf & ROOT_MASK];
+        if (ENTRY_KIND(entry) == ENTRY_LINK) {
+          bitBuf >>= ROOT_BITS;
+          bitCount -= ROOT_BITS;
+          entry = litLenTable[ENTRY_VALUE(entry) + (bitBuf & SUBTABLE_MASK)];
+        } /* if */
+        bitBuf >>= ENTRY_BITS(entry);
+        bitCount -= ENTRY_BITS(entry);
+        if (status != STATUS_RUNNING) {
+          logError(printf("decodeHuffmanBlock: Unexpected end of data.\n"););
+        } else if (ENTRY_KIND(entry) == ENTRY_LITERAL) {
+          out[outPos] = (ucharType) ENTRY_VALUE(entry);
+          outPos++;
+        } else if (ENTRY_KIND(entry) == ENTRY_BASE) {
+          length = ENTRY_VALUE(entry) +
+                   (memSizeType) (bitBuf & ((1U << ENTRY_EXTRA(entry)) - 1));
+          bitBuf >>= ENTRY_EXTRA(entry);
+          bitCount -= ENTRY_EXTRA(entry);
+          if (bitCount < MAX_CODE_LENGTH + 14) {
+            work->inPos = inPos;
+            work->bitBuf = bitBuf;
+            work->bitCount = bitCount;
+            refillBits(work);
+            inPos = work->inPos;
+            bitBuf = work->bitBuf;
+            bitCount = work->bitCount;
+          } /* if */
+          entry = distTable[bitBuf & ROOT_MASK];
+          if (ENTRY_KIND(entry) == ENTRY_LINK) {
+            bitBuf >>= ROOT_BITS;
+            bitCount -= ROOT_BITS;
+            entry = distTable[ENTRY_VALUE(entry) + (bitBuf & SUBTABLE_MASK)];
+          } /* if */
+          bitBuf >>= ENTRY_BITS(entry);
+          bitCount -= ENTRY_BITS(entry);
+          distance = ENTRY_VALUE(entry) +
+                     (memSizeType) (bitBuf & ((1U << ENTRY_EXTRA(entry)) - 1));
+          bitBuf >>= ENTRY_EXTRA(entry);
+          bitCount -= ENTRY_EXTRA(entry);
+          if (unlikely(ENTRY_KIND(entry) != ENTRY_BASE)) {
+            logError(printf("decodeHuffmanBlock: Illegal distance code.\n"););
+            status = STATUS_DATA_ERROR;
+          } else if (unlikely(distance > outPos)) {
+            logError(printf("decodeHuffmanBlock: Distance too far back.\n"););
+            status = STATUS_DATA_ERROR;
+          } else {
+            copyMatch(&out[outPos], distance, length);
+            outPos += length;
+          } /* if */
+        } else if (ENTRY_KIND(entry) == ENTRY_END) {
+          status = STATUS_END_OF_BLOCK;
+        } else {
+          logError(printf("decodeHuffmanBlock: Illegal literal/length code.\n"););
+          status = STATUS_DATA_ERROR;
+        } /* if */
+      } /* if */
+    } while (status == STATUS_RUNNING);
+    work->inPos = inPos;
+    work->bitBuf = bitBuf;
+    work->bitCount = bitCount;
+    work->outPos = outPos;
+    if (status == STATUS_END_OF_BLOCK) {
+      work->state.mode = MODE_BLOCK_HEADER;
+      status = STATUS_RUNNING;
+    } /* if */
+    if (bitCount < work->paddingBits && status != STATUS_MEMORY_ERROR) {
+      logError(printf("decodeHuffmanBlock: Unexpected end of data.\n"););
+      status = STATUS_DATA_ERROR;
+    } /* if */
+    return status;
+  } /* decodeHuffmanBlock */
+
+
+
+static int runInflate (inflateWorkType work)
+
+  {
+    int status = STATUS_RUNNING;
+
+  /* runInflate */
+    while (status == STATUS_RUNNING) {
+      switch (work->state.mode) {
+        case MODE_BLOCK_HEADER:
+          status = readBlockHeader(work);
+          break;
+        case MODE_STORED:
+          status = copyStoredBlock(work);
+          break;
+        case MODE_HUFFMAN:
+          status = decodeHuffmanBlock(work);
+          break;
+        default:
+          status = STATUS_FINISHED;
+          break;
+      } /* switch */
+    } /* while */
+    return status;
+  } /* runInflate */
+
+
+
+static inline memSizeType inflateWindowSize (const inflateStateRecord *state)
+
+  { /* inflateWindowSize */
+    return state->deflate64 ? WINDOW64_SIZE : WINDOW_SIZE;
+  } /* inflateWindowSize */
+
+
+
+/**
+ *  Copy the inflate state stored in the bstring 'stateBstri' to 'state'.
+ *  @return TRUE if 'stateBstri' contains a valid state, FALSE otherwise.
+ */
+static boolType getInflateState (const const_bstriType stateBstri,
+    inflateStateRecord *state)
+
+  {
+    boolType okay = FALSE;
+
+  /* getInflateState */
+    if (stateBstri->size >= sizeof(inflateStateRecord)) {
+      memcpy(state, stateBstri->mem, sizeof(inflateStateRecord));
+      okay = state->deflate64 <= 1 &&
+             stateBstri->size == sizeof(inflateStateRecord) +
+                                 inflateWindowSize(state) &&
+             state->mode <= MODE_FINISHED &&
+             state->lastBlock <= 1 &&
+             state->storedRemaining <= MAX_STORED_LENGTH &&
+             state->bitCount < 8 &&
+             state->windowFill <= inflateWindowSize(state) &&
+             state->numLitLenCodes <= NUM_LITLEN_CODES &&
+             state->numDistCodes <= NUM_DIST_CODES;
+    } /* if */
+    return okay;
+  } /* getInflateState */
+
+
+
+/**
+ *  Create an inflate state for an incremental decompression.
+ *  @param deflate64 TRUE if the data is compressed with DEFLATE64
+ *         and FALSE if it is compressed with DEFLATE.
+ *  @return the inflate state, which is stored in a bstring.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+bstriType dflInflateInit (boolType deflate64)
+
+  {
+    inflateStateRecord state;
+    memSizeType size;
+    bstriType result;
+
+  /* dflInflateInit */
+    logFunction(printf("dflInflateInit(%d)\n", deflate64););
+    memset(&state, 0, sizeof(inflateStateRecord));
+    state.deflate64 = deflate64 ? 1 : 0;
+    state.mode = MODE_BLOCK_HEADER;
+    size = sizeof(inflateStateRecord) + inflateWindowSize(&state);
+    if (unlikely(!ALLOC_BSTRI_SIZE_OK(result, size))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      result->size = size;
+      memcpy(result->mem, &state, sizeof(inflateStateRecord));
+      memset(&result->mem[sizeof(inflateStateRecord)], 0,
+             size - sizeof(inflateStateRecord));
+    } /* if */
+    return result;
+  } /* dflInflateInit */
+
+
+
+/**
+ *  Determine if the end of the compressed data has been reached.
+ *  @param stateBstri Inflate state created with dflInflateInit().
+ *  @return TRUE if the last block has been decompressed,
+ *          FALSE otherwise.
+ *  @exception RANGE_ERROR If 'stateBstri' is not a valid inflate state.
+ */
+boolType dflInflateFinished (const const_bstriType stateBstri)
+
+  {
+    inflateStateRecord state;
+    boolType finished;
+
+  /* dflInflateFinished */
+    if (unlikely(!getInflateState(stateBstri, &state))) {
+      logError(printf("dflInflateFinished(*): Illegal inflate state.\n"););
+      raise_error(RANGE_ERROR);
+      finished = FALSE;
+    } else {
+      finished = state.mode == MODE_FINISHED;
+    } /* if */
+    return finished;
+  } /* dflInflateFinished */
+
+
+
+/**
+ *  Decompress DEFLATE data from 'compressed' starting at '*bytePos'.
+ *  Decompression continues until at least 'minLength' bytes have
+ *  been produced, the end of the compressed data is reached or more
+ *  input is needed. Afterwards '*bytePos' refers to the first byte
+ *  that has not been consumed. At the end of the compressed data it
+ *  refers to the first byte after the compressed data. If 'inputEnd'
+ *  is FALSE a few bytes at the end of 'compressed' may be left over.
+ *  They must be passed again together with the following input.
+ *  @param stateBstri Inflate state created with dflInflateInit().
+ *  @param inputEnd TRUE if no data follows after 'compressed'.
+ *  @param minLength Minimum length of the result.
+ *  @return the decompressed bytes.
+ *  @exception RANGE_ERROR If 'stateBstri' is not a valid inflate state,
+ *             if 'compressed' is not in DEFLATE format or if it
+ *             contains a character beyond '\255;'. In this case the
+ *             state is not changed.
+ *  @exception INDEX_ERROR If '*bytePos' is not in the range 1 to
+ *             length(compressed) + 1.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+striType dflInflateStep (bstriType stateBstri, const const_striType compressed,
+    intType *const bytePos, boolType inputEnd, intType minLength)
+
+  {
+    inflateWorkType work;
+    ucharType *inBuffer = NULL;
+    memSizeType inLength;
+    memSizeType windowSize;
+    memSizeType windowFill;
+    memSizeType target;
+    memSizeType keep;
+    unsigned int realBits;
+    int status;
+    striType result = NULL;
+
+  /* dflInflateStep */
+    logFunction(printf("dflInflateStep(*, \"%s\", " FMT_D ", %d, " FMT_D ")\n",
+                       striAsUnquotedCStri(compressed), *bytePos,
+                       inputEnd, minLength););
+    if (unlikely(*bytePos < 1 ||
+                 (uintType) *bytePos - 1 > compressed->size)) {
+      logError(printf("dflInflateStep: Byte position " FMT_D
+                      " not in range 1 .. " FMT_U_MEM ".\n",
+                      *bytePos, compressed->size + 1););
+      raise_error(INDEX_ERROR);
+    } else if (unlikely(minLength < 0)) {
+      logError(printf("dflInflateStep: Negative minimum length.\n"););
+      raise_error(RANGE_ERROR);
+    } else if (unlikely(!ALLOC_INFLATE_WORK(work))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      if (unlikely(!getInflateState(stateBstri, &work->state))) {
+        logError(printf("dflInflateStep: Illegal inflate state.\n"););
+        raise_error(RANGE_ERROR);
+      } else if (work->state.mode == MODE_FINISHED) {
+        result = bytesToStri(NULL, 0);
+      } else {
+        inLength = compressed->size - (memSizeType) (*bytePos - 1);
+        if (unlikely(!ALLOC_UBYTES(inBuffer, inLength))) {
+          raise_error(MEMORY_ERROR);
+        } else if (unlikely(memcpy_from_strelem(inBuffer,
+                                                &compressed->mem[*bytePos - 1],
+                                                inLength))) {
+          logError(printf("dflInflateStep: "
+                          "Character beyond '\\255;' in data.\n"););
+          raise_error(RANGE_ERROR);
+        } else {
+          windowSize = inflateWindowSize(&work->state);
+          windowFill = work->state.windowFill;
+          target = (memSizeType) minLength;
+          if (target < MIN_OUTPUT_CHUNK) {
+            target = MIN_OUTPUT_CHUNK;
+          } /* if */
+          work->maxMatchLength = work->state.deflate64 ?
+                                 MAX_MATCH64_LENGTH : MAX_MATCH_LENGTH;
+          if (target > MAX_MEMSIZETYPE - windowFill) {
+            work->outLimit = MAX_MEMSIZETYPE;
+          } else {
+            work->outLimit = windowFill + target;
+          } /* if */
+          if (target > 4 * inLength && target > MIN_OUTPUT_CHUNK) {
+            /* Probably everything is decompressed at once. */
+            target = 4 * inLength < MIN_OUTPUT_CHUNK ?
+                     MIN_OUTPUT_CHUNK : 4 * inLength;
+          } /* if */
+          work->outCapacity = windowFill + target +
+                              work->maxMatchLength + COPY_SLACK;
+          if (unlikely(!ALLOC_UBYTES(work->out, work->outCapacity))) {
+            raise_error(MEMORY_ERROR);
+          } else {
+            memcpy(work->out, &stateBstri->mem[sizeof(inflateStateRecord)],
+                   windowFill);
+            work->outPos = windowFill;
+            work->in = inBuffer;
+            work->inLength = inLength;
+            work->inPos = 0;
+            work->inputEnd = inputEnd;
+            work->bitBuf = work->state.bitBuf;
+            work->bitCount = work->state.bitCount;
+            work->paddingBits = 0;
+            if (work->state.mode == MODE_HUFFMAN) {
+              buildBlockTables(work);
+            } /* if */
+            status = runInflate(work);
+            if (status == STATUS_MEMORY_ERROR) {
+              raise_error(MEMORY_ERROR);
+            } else if (status == STATUS_DATA_ERROR ||
+                       work->bitCount < work->paddingBits) {
+              raise_error(RANGE_ERROR);
+            } else {
+              realBits = work->bitCount - work->paddingBits;
+              /* Give whole bytes of the bit buffer back to the caller. */
+              *bytePos += (intType) (work->inPos - realBits / 8);
+              if (status == STATUS_FINISHED) {
+                work->state.bitBuf = 0;
+                work->state.bitCount = 0;
+              } else {
+                work->state.bitBuf = (uint32Type) (work->bitBuf &
+                                                   ((1U << (realBits % 8)) - 1));
+                work->state.bitCount = realBits % 8;
+              } /* if */
+              result = bytesToStri(&work->out[windowFill],
+                                   work->outPos - windowFill);
+              if (result != NULL) {
+                keep = work->outPos < windowSize ? work->outPos : windowSize;
+                work->state.windowFill = (uint32Type) keep;
+                memcpy(stateBstri->mem, &work->state, sizeof(inflateStateRecord));
+                memcpy(&stateBstri->mem[sizeof(inflateStateRecord)],
+                       &work->out[work->outPos - keep], keep);
+              } /* if */
+            } /* if */
+            FREE_BYTES(work->out, work->outCapacity);
+          } /* if */
+        } /* if */
+        if (inBuffer != NULL) {
+          FREE_BYTES(inBuffer, inLength);
+        } /* if */
+      } /* if */
+      FREE_INFLATE_WORK(work);
+    } /* if */
+    logFunction(printf("dflInflateStep --> \"%s\" (bytePos=" FMT_D ")\n",
+                       striAsUnquotedCStri(result), *bytePos););
+    return result;
+  } /* dflInflateStep */
+
+
+
+static inline void putBits (deflateWorkType work, uint32Type bits,
+    unsigned int numBits)
+
+  { /* putBits */
+    work->bitBuf |= (uint64Type) bits << work->bitCount;
+    work->bitCount += numBits;
+    if (work->bitCount >= 32) {
+      work->out[work->outPos]     = (ucharType) work->bitBuf;
+      work->out[work->outPos + 1] = (ucharType) (work->bitBuf >> 8);
+      work->out[work->outPos + 2] = (ucharType) (work->bitBuf >> 16);
+      work->out[work->outPos + 3] = (ucharType) (work->bitBuf >> 24);
+      work->outPos += 4;
+      work->bitBuf >>= 32;
+      work->bitCount -= 32;
+    } /* if */
+  } /* putBits */
+
+
+
+/**
+ *  Write the whole bytes of the bit buffer to the output.
+ */
+static void flushWholeBytes (deflateWorkType work)
+
+  { /* flushWholeBytes */
+    while (work->bitCount >= 8) {
+      work->out[work->outPos] = (ucharType) work->bitBuf;
+      work->outPos++;
+      work->bitBuf >>= 8;
+      work->bitCount -= 8;
+    } /* while */
+  } /* flushWholeBytes */
+
+
+
+static int compareSymbolKeys (const void *key1, const void *key2)
+
+  { /* compareSymbolKeys */
+    return *(const uint64Type *) key1 < *(const uint64Type *) key2 ? -1 :
+           *(const uint64Type *) key1 > *(const uint64Type *) key2 ? 1 : 0;
+  } /* compareSymbolKeys */
+
+
+
+/**
+ *  Compute the code lengths of a Huffman code for the frequencies 'freq'.
+ *  The code lengths are computed in place with the algorithm of Moffat
+ *  and Katajainen. Afterwards code lengths beyond 'maxLength' are
+ *  reduced and the Kraft sum is repaired, like it is done in miniz.
+ *  At least two symbols get a code, since some decoders cannot cope
+ *  with a code that consists of only one symbol.
+ */
+static void computeCodeLengths (const uint32Type *freq, unsigned int numSymbols,
+    unsigned int maxLength, ucharType *lengths)
+
+  {
+    uint64Type keys[NUM_LENGTH_SYMBOLS];
+    uint32Type weight[NUM_LENGTH_SYMBOLS];
+    unsigned int numCodes[NUM_LENGTH_SYMBOLS + 1];
+    unsigned int numUsed = 0;
+    unsigned int symbol;
+    int root;
+    int leaf;
+    int next;
+    int avbl;
+    int used;
+    int depth;
+    int index;
+    unsigned int length;
+    uint32Type total;
+    boolType searching;
+
+  /* computeCodeLengths */
+    memset(lengths, 0, numSymbols);
+    for (symbol = 0; symbol < numSymbols; symbol++) {
+      if (freq[symbol] != 0) {
+        keys[numUsed] = (uint64Type) freq[symbol] << 16 | symbol;
+        numUsed++;
+      } /* if */
+    } /* for */
+    for (symbol = 0; numUsed < 2; symbol++) {
+      if (freq[symbol] == 0) {
+        keys[numUsed] = (uint64Type) 1 << 16 | symbol;
+        numUsed++;
+      } /* if */
+    } /* for */
+    qsort(keys, numUsed, sizeof(uint64Type), compareSymbolKeys);
+    for (index = 0; index < (int) numUsed; index++) {
+      weight[index] = (uint32Type) (keys[index] >> 16);
+    } /* for */
+    /* Moffat and Katajainen: First phase. */
+    weight[0] += weight[1];
+    root = 0;
+    leaf = 2;
+    for (next = 1; next < (int) numUsed - 1; next++) {
+      if (leaf >= (int) numUsed || weight[root] < weight[leaf]) {
+        weight[next] = weight[root];
+        weight[root] = (uint32Type) next;
+        root++;
+      } else {
+        weight[next] = weight[leaf];
+        leaf++;
+      } /* if */
+      if (leaf >= (int) numUsed ||
+          (root < next && weight[root] < weight[leaf])) {
+        weight[next] += weight[root];
+        weight[root] = (uint32Type) next;
+        root++;
+      } else {
+        weight[next] += weight[leaf];
+        leaf++;
+      } /* if */
+    } /* for */
+    /* Second phase: Depths of the internal nodes. */
+    weight[numUsed - 2] = 0;
+    for (next = (int) numUsed - 3; next >= 0; next--) {
+      weight[next] = weight[weight[next]] + 1;
+    } /* for */
+    /* Third phase: Depths of the leaves. */
+    avbl = 1;
+    used = 0;
+    depth = 0;
+    root = (int) numUsed - 2;
+    next = (int) numUsed - 1;
+    while (avbl > 0) {
+      while (root >= 0 && (int) weight[root] == depth) {
+        used++;
+        root--;
+      } /* while */
+      while (avbl > used) {
+        weight[next] = (uint32Type) depth;
+        next--;
+        avbl--;
+      } /* while */
+      avbl = 2 * used;
+      depth++;
+      used = 0;
+    } /* while */
+    /* Limit the code lengths to maxLength. */
+    memset(numCodes, 0, sizeof(numCodes));
+    for (index = 0; index < (int) numUsed; index++) {
+      numCodes[weight[index]]++;
+    } /* for */
+    for (length = maxLength + 1; length <= NUM_LENGTH_SYMBOLS; length++) {
+      numCodes[maxLength] += numCodes[length];
+    } /* for */
+    total = 0;
+    for (length = maxLength; length > 0; length--) {
+      total += (uint32Type) numCodes[length] << (maxLength - length);
+    } /* for */
+    while (total != (uint32Type) 1 << maxLength) {
+      numCodes[maxLength]--;
+      searching = TRUE;
+      for (length = maxLength - 1; length > 0 && searching; length--) {
+        if (numCodes[length] != 0) {
+          numCodes[length]--;
+          numCodes[length + 1] += 2;
+          searching = FALSE;
+        } /* if */
+      } /* for */
+      total--;
+    } /* while */
+    /* The most frequent symbols get the shortest codes. */
+    index = (int) numUsed;
+    for (length = 1; length <= maxLength; length++) {
+      for (symbol = numCodes[length]; symbol > 0; symbol--) {
+        index--;
+        lengths[keys[index] & 0xffff] = (ucharType) length;
+      } /* for */
+    } /* for */
+  } /* computeCodeLengths */
+
+
+
+/**
+ *  Compute the bit reversed canonical Huffman codes for 'lengths'.
+ */
+static void computeCodes (const ucharType *lengths, unsigned int numSymbols,
+    uint16Type *codes)
+
+  {
+    unsigned int count[MAX_CODE_LENGTH + 1];
+    unsigned int nextCode[MAX_CODE_LENGTH + 1];
+    unsigned int length;
+    unsigned int symbol;
+    unsigned int code;
+    unsigned int reversed;
+    unsigned int bit;
+
+  /* computeCodes */
+    memset(count, 0, sizeof(count));
+    for (symbol = 0; symbol < numSymbols; symbol++) {
+      count[lengths[symbol]]++;
+    } /* for */
+    count[0] = 0;
+    code = 0;
+    for (length = 1; length <= MAX_CODE_LENGTH; length++) {
+      code = (code + count[length - 1]) << 1;
+      nextCode[length] = code;
+    } /* for */
+    for (symbol = 0; symbol < numSymbols; symbol++) {
+      length = lengths[symbol];
+      if (length != 0) {
+        code = nextCode[length]++;
+        reversed = 0;
+        for (bit = 0; bit < length; bit++) {
+          reversed = (reversed << 1) | ((code >> bit) & 1);
+        } /* for */
+        codes[symbol] = (uint16Type) reversed;
+      } else {
+        codes[symbol] = 0;
+      } /* if */
+    } /* for */
+  } /* computeCodes */
+
+
+
+/**
+ *  Run length encode the code lengths of a dynamic block header.
+ *  @return the number of code length symbols.
+ */
+static unsigned int encodeCodeLengths (const ucharType *lengths,
+    unsigned int numLengths, ucharType *symbols, ucharType *extra,
+    uint32Type *freq)
+
+  {
+    unsigned int index = 0;
+    unsigned int run;
+    unsigned int count;
+    unsigned int numSymbols = 0;
+
+  /* encodeCodeLengths */
+    while (index < numLengths) {
+      run = 1;
+      while (index + run < numLengths && lengths[index + run] == lengths[index]) {
+        run++;
+      } /* while */
+      if (lengths[index] == 0) {
+        while (run >= 11) {
+          count = run > 138 ? 138 : run;
+          symbols[numSymbols] = 18;
+          extra[numSymbols] = (ucharType) (count - 11);
+          numSymbols++;
+          run -= count;
+          index += count;
+        } /* while */
+        if (run >= 3) {
+          symbols[numSymbols] = 17;
+          extra[numSymbols] = (ucharType) (run - 3);
+          numSymbols++;
+          index += run;
+          run = 0;
+        } /* if */
+      } else {
+        symbols[numSymbols] = lengths[index];
+        numSymbols++;
+        index++;
+        run--;
+        while (run >= 3) {
+          count = run > 6 ? 6 : run;
+          symbols[numSymbols] = 16;
+          extra[numSymbols] = (ucharType) (count - 3);
+          numSymbols++;
+          run -= count;
+          index += count;
+        } /* while */
+      } /* if */
+      while (run > 0) {
+        symbols[numSymbols] = lengths[index];
+        numSymbols++;
+        index++;
+        run--;
+      } /* while */
+    } /* while */
+    for (index = 0; index < numSymbols; index++) {
+      freq[symbols[index]]++;
+    } /* for */
+    return numSymbols;
+  } /* encodeCodeLengths */
+
+
+
+static void putStoredBlocks (deflateWorkType work, boolType lastBlock)
+
+  {
+    memSizeType position;
+    memSizeType length;
+
+  /* putStoredBlocks */
+    position = work->blockStart;
+    do {
+      length = work->emittedPos - position;
+      if (length > MAX_STORED_LENGTH) {
+        length = MAX_STORED_LENGTH;
+      } /* if */
+      putBits(work, lastBlock && position + length == work->emittedPos, 1);
+      putBits(work, 0, 2);
+      putBits(work, 0, (8 - work->bitCount % 8) % 8);
+      flushWholeBytes(work);
+      work->out[work->outPos]     = (ucharType) length;
+      work->out[work->outPos + 1] = (ucharType) (length >> 8);
+      work->out[work->outPos + 2] = (ucharType) ~length;
+      work->out[work->outPos + 3] = (ucharType) (~length >> 8);
+      memcpy(&work->out[work->outPos + 4], &work->data[position], length);
+      work->outPos += 4 + length;
+      position += length;
+    } while (position < work->emittedPos);
+  } /* putStoredBlocks */
+
+
+
+static void putSymbols (deflateWorkType work, const ucharType *litLenLengths,
+    const uint16Type *litLenCodes, const ucharType *distLengths,
+    const uint16Type *distCodes)
+
+  {
+    unsigned int index;
+    unsigned int litLen;
+    unsigned int distance;
+    unsigned int code;
+
+  /* putSymbols */
+    for (index = 0; index < work->numSymbols; index++) {
+      litLen = work->symbolLitLen[index];
+      distance = work->symbolDistance[index];
+      if (distance == 0) {
+        putBits(work, litLenCodes[litLen], litLenLengths[litLen]);
+      } else {
+        code = work->lengthCode[litLen];
+        putBits(work, litLenCodes[257 + code], litLenLengths[257 + code]);
+        putBits(work, litLen - lengthBase[code], lengthExtraBits[code]);
+        code = distance <= 256 ? work->distanceCode[distance - 1] :
+                                 work->distanceCode[256 + ((distance - 1) >> 7)];
+        putBits(work, distCodes[code], distLengths[code]);
+        putBits(work, distance - distanceBase[code], distanceExtraBits[code]);
+      } /* if */
+    } /* for */
+    putBits(work, litLenCodes[END_OF_BLOCK], litLenLengths[END_OF_BLOCK]);
+  } /* putSymbols */
+
+
+
+/**
+ *  Write the collected symbols as one block. The block is written
+ *  with dynamic Huffman codes, with the fixed Huffman codes or as
+ *  stored block, whatever is shorter.
+ */
+static void flushBlock (deflateWorkType work, boolType lastBlock)
+
+  {
+    ucharType litLenLengths[NUM_LITLEN_CODES];
+    ucharType distLengths[NUM_DIST_CODES];
+    uint16Type litLenCodes[NUM_LITLEN_CODES];
+    uint16Type distCodes[NUM_DIST_CODES];
+    ucharType fixedLengths[NUM_LITLEN_CODES + NUM_DIST_CODES];
+    uint16Type fixedLitLenCodes[NUM_LITLEN_CODES];
+    uint16Type fixedDistCodes[NUM_DIST_CODES];
+    ucharType combined[NUM_LENGTH_SYMBOLS + NUM_DISTANCE_SYMBOLS];
+    ucharType rleSymbols[NUM_LENGTH_SYMBOLS + NUM_DISTANCE_SYMBOLS];
+    ucharType rleExtra[NUM_LENGTH_SYMBOLS + NUM_DISTANCE_SYMBOLS];
+    uint32Type codeLenFreq[NUM_CODELEN_CODES];
+    ucharType codeLenLengths[NUM_CODELEN_CODES];
+    uint16Type codeLenCodes[NUM_CODELEN_CODES];
+    inflateStateRecord fixedState;
+    unsigned int numLitLenCodes = 0;
+    unsigned int numDistCodes = 0;
+    unsigned int numCodeLenCodes = 0;
+    unsigned int numRleSymbols = 0;
+    unsigned int symbol;
+    unsigned int index;
+    uint64Type extraBits = 0;
+    uint64Type dynamicBits;
+    uint64Type fixedBits;
+    uint64Type storedBits;
+    memSizeType rawLength;
+    memSizeType maxBytes;
+
+  /* flushBlock */
+    work->litLenFreq[END_OF_BLOCK] = 1;
+    rawLength = work->emittedPos - work->blockStart;
+    if (work->state.level == 0) {
+      dynamicBits = UINT64TYPE_MAX;
+      fixedBits = UINT64TYPE_MAX;
+    } else {
+      computeCodeLengths(work->litLenFreq, NUM_LENGTH_SYMBOLS,
+                         MAX_CODE_LENGTH, litLenLengths);
+      computeCodeLengths(work->distFreq, NUM_DISTANCE_SYMBOLS,
+                         MAX_CODE_LENGTH, distLengths);
+      numLitLenCodes = NUM_LENGTH_SYMBOLS;
+      while (numLitLenCodes > 257 && litLenLengths[numLitLenCodes - 1] == 0) {
+        numLitLenCodes--;
+      } /* while */
+      numDistCodes = NUM_DISTANCE_SYMBOLS;
+      while (numDistCodes > 1 && distLengths[numDistCodes - 1] == 0) {
+        numDistCodes--;
+      } /* while */
+      memcpy(combined, litLenLengths, numLitLenCodes);
+      memcpy(&combined[numLitLenCodes], distLengths, numDistCodes);
+      memset(codeLenFreq, 0, sizeof(codeLenFreq));
+      numRleSymbols = encodeCodeLengths(combined, numLitLenCodes + numDistCodes,
+                                        rleSymbols, rleExtra, codeLenFreq);
+      computeCodeLengths(codeLenFreq, NUM_CODELEN_CODES, MAX_CODELEN_LENGTH,
+                         codeLenLengths);
+      numCodeLenCodes = NUM_CODELEN_CODES;
+      while (numCodeLenCodes > 4 &&
+             codeLenLengths[codeLengthOrder[numCodeLenCodes - 1]] == 0) {
+        numCodeLenCodes--;
+      } /* while */
+      for (symbol = 257; symbol < NUM_LENGTH_SYMBOLS; symbol++) {
+        extraBits += (uint64Type) work->litLenFreq[symbol] *
+                     lengthExtraBits[symbol - 257];
+      } /* for */
+      for (symbol = 0; symbol < NUM_DISTANCE_SYMBOLS; symbol++) {
+        extraBits += (uint64Type) work->distFreq[symbol] *
+                     distanceExtraBits[symbol];
+      } /* for */
+      setFixedCodeLengths(&fixedState);
+      memcpy(fixedLengths, fixedState.codeLengths, sizeof(fixedLengths));
+      dynamicBits = 3 + 14 + 3 * (uint64Type) numCodeLenCodes + extraBits;
+      fixedBits = 3 + extraBits;
+      for (index = 0; index < numRleSymbols; index++) {
+        dynamicBits += codeLenLengths[rleSymbols[index]];
+        dynamicBits += rleSymbols[index] == 16 ? 2 :
+                       rleSymbols[index] == 17 ? 3 :
+                       rleSymbols[index] == 18 ? 7 : 0;
+      } /* for */
+      for (symbol = 0; symbol < NUM_LENGTH_SYMBOLS; symbol++) {
+        dynamicBits += (uint64Type) work->litLenFreq[symbol] * litLenLengths[symbol];
+        fixedBits += (uint64Type) work->litLenFreq[symbol] * fixedLengths[symbol];
+      } /* for */
+      for (symbol = 0; symbol < NUM_DISTANCE_SYMBOLS; symbol++) {
+        dynamicBits += (uint64Type) work->distFreq[symbol] * distLengths[symbol];
+        fixedBits += (uint64Type) work->distFreq[symbol] * 5;
+      } /* for */
+    } /* if */
+    storedBits = (rawLength / MAX_STORED_LENGTH + 1) * (3 + 7 + 32) +
+                 8 * (uint64Type) rawLength;
+    if (storedBits < dynamicBits && storedBits < fixedBits) {
+      maxBytes = (memSizeType) (storedBits / 8) + 16;
+    } else if (dynamicBits < fixedBits) {
+      maxBytes = (memSizeType) (dynamicBits / 8) + 16;
+    } else {
+      maxBytes = (memSizeType) (fixedBits / 8) + 16;
+    } /* if */
+    if (!growBuffer(&work->out, &work->outCapacity, work->outPos + maxBytes)) {
+      work->memoryError = TRUE;
+    } else if (storedBits < dynamicBits && storedBits < fixedBits) {
+      putStoredBlocks(work, lastBlock);
+    } else if (dynamicBits < fixedBits) {
+      putBits(work, lastBlock ? 1 : 0, 1);
+      putBits(work, 2, 2);
+      putBits(work, numLitLenCodes - 257, 5);
+      putBits(work, numDistCodes - 1, 5);
+      putBits(work, numCodeLenCodes - 4, 4);
+      for (index = 0; index < numCodeLenCodes; index++) {
+        putBits(work, codeLenLengths[codeLengthOrder[index]], 3);
+      } /* for */
+      computeCodes(codeLenLengths, NUM_CODELEN_CODES, codeLenCodes);
+      for (index = 0; index < numRleSymbols; index++) {
+        putBits(work, codeLenCodes[rleSymbols[index]],
+                codeLenLengths[rleSymbols[index]]);
+        if (rleSymbols[index] == 16) {
+          putBits(work, rleExtra[index], 2);
+        } else if (rleSymbols[index] == 17) {
+          putBits(work, rleExtra[index], 3);
+        } else if (rleSymbols[index] == 18) {
+          putBits(work, rleExtra[index], 7);
+        } /* if */
+      } /* for */
+      computeCodes(litLenLengths, NUM_LENGTH_SYMBOLS, litLenCodes);
+      computeCodes(distLengths, NUM_DISTANCE_SYMBOLS, distCodes);
+      putSymbols(work, litLenLengths, litLenCodes, distLengths, distCodes);
+    } else {
+      putBits(work, lastBlock ? 1 : 0, 1);
+      putBits(work, 1, 2);
+      computeCodes(fixedLengths, NUM_LITLEN_CODES, fixedLitLenCodes);
+      computeCodes(&fixedLengths[NUM_LITLEN_CODES], NUM_DIST_CODES,
+                   fixedDistCodes);
+      putSymbols(work, fixedLengths, fixedLitLenCodes,
+                 &fixedLengths[NUM_LITLEN_CODES], fixedDistCodes);
+    } /* if */
+    work->numSymbols = 0;
+    memset(work->litLenFreq, 0, sizeof(work->litLenFreq));
+    memset(work->distFreq, 0, sizeof(work->distFreq));
+    work->blockStart = work->emittedPos;
+  } /* flushBlock */
+
+
+
+static inline void putLiteral (deflateWorkType work, ucharType literal)
+
+  { /* putLiteral */
+    work->symbolLitLen[work->numSymbols] = literal;
+    work->symbolDistance[work->numSymbols] = 0;
+    work->numSymbols++;
+    work->litLenFreq[literal]++;
+  } /* putLiteral */
+
+
+
+static inline void putMatch (deflateWorkType work, memSizeType length,
+    memSizeType distance)
+
+  { /* putMatch */
+    work->symbolLitLen[work->numSymbols] = (uint16Type) length;
+    work->symbolDistance[work->numSymbols] = (uint16Type) distance;
+    work->numSymbols++;
+    work->litLenFreq[257 + work->lengthCode[length]]++;
+    work->distFreq[distance <= 256 ?
+                   work->distanceCode[distance - 1] :
+                   work->distanceCode[256 + ((distance - 1) >> 7)]]++;
+  } /* putMatch */
+
+
+
+static inline uint32Type hashOf (const ucharType *bytes)
+
+  { /* hashOf */
+    return (((uint32Type) bytes[0] | (uint32Type) bytes[1] << 8 |
+             (uint32Type) bytes[2] << 16) * 0x9e3779b1) >> (32 - HASH_BITS);
+  } /* hashOf */
+
+
+
+/**
+ *  Insert the string at 'position' into the hash chains.
+ *  @return the previous position with the same hash value.
+ */
+static inline int32Type insertString (deflateWorkType work,
+    memSizeType position)
+
+  {
+    uint32Type hash;
+    int32Type previous;
+
+  /* insertString */
+    hash = hashOf(&work->data[position]);
+    previous = work->head[hash];
+    work->prev[position & WINDOW_MASK] = previous;
+    work->head[hash] = (int32Type) position;
+    return previous;
+  } /* insertString */
+
+
+
+/**
+ *  Search the longest match for the string at 'position'.
+ *  Only matches longer than 'prevLength' are considered.
+ *  @return the length of the match found or 0.
+ */
+static memSizeType longestMatch (deflateWorkType work, memSizeType position,
+    memSizeType prevLength, int32Type candidate, memSizeType *matchDistance)
+
+  {
+    const ucharType *scan;
+    const ucharType *match;
+    memSizeType maxLength;
+    memSizeType niceLength;
+    memSizeType limit;
+    memSizeType bestLength;
+    memSizeType length;
+    unsigned int chainLength;
+    uint64Type difference;
+
+  /* longestMatch */
+    scan = &work->data[position];
+    maxLength = work->dataLength - position;
+    if (maxLength > MAX_MATCH_LENGTH) {
+      maxLength = MAX_MATCH_LENGTH;
+    } /* if */
+    niceLength = levelConfig[work->state.level].niceLength;
+    if (niceLength > maxLength) {
+      niceLength = maxLength;
+    } /* if */
+    limit = position > MAX_DISTANCE ? position - MAX_DISTANCE : 0;
+    chainLength = levelConfig[work->state.level].maxChain;
+    if (prevLength >= levelConfig[work->state.level].goodLength) {
+      chainLength >>= 2;
+    } /* if */
+    bestLength = prevLength;
+    while (candidate >= 0 && (memSizeType) candidate >= limit &&
+           chainLength != 0 && bestLength < niceLength) {
+      match = &work->data[candidate];
+      if (match[bestLength] == scan[bestLength] &&
+          match[0] == scan[0] && match[1] == scan[1]) {
+        length = 0;
+        do {
+          difference = loadLittleEndian64(&scan[length]) ^
+                       loadLittleEndian64(&match[length]);
+          if (difference == 0) {
+            length += 8;
+          } else {
+            while ((difference & 0xff) == 0) {
+              difference >>= 8;
+              length++;
+            } /* while */
+          } /* if */
+        } while (difference == 0 && length < maxLength);
+        if (length > maxLength) {
+          length = maxLength;
+        } /* if */
+        if (length > bestLength) {
+          bestLength = length;
+          *matchDistance = position - (memSizeType) candidate;
+        } /* if */
+      } /* if */
+      candidate = work->prev[(memSizeType) candidate & WINDOW_MASK];
+      chainLength--;
+    } /* while */
+    return bestLength > prevLength ? bestLength : 0;
+  } /* longestMatch */
+
+
+
+static void checkBlockFull (deflateWorkType work)
+
+  { /* checkBlockFull */
+    if (work->numSymbols >= BLOCK_SYMBOLS - 1) {
+      flushBlock(work, FALSE);
+    } /* if */
+  } /* checkBlockFull */
+
+
+
+/**
+ *  Greedy matching as used by the compression levels 1 to 3.
+ */
+static void compressGreedy (deflateWorkType work, memSizeType position)
+
+  {
+    int32Type candidate;
+    memSizeType matchLength;
+    memSizeType matchDistance = 0;
+    memSizeType end;
+
+  /* compressGreedy */
+    while (position < work->dataLength && !work->memoryError) {
+      matchLength = 0;
+      if (position + MIN_MATCH_LENGTH <= work->dataLength) {
+        candidate = insertString(work, position);
+        matchLength = longestMatch(work, position, MIN_MATCH_LENGTH - 1,
+                                   candidate, &matchDistance);
+      } /* if */
+      if (matchLength >= MIN_MATCH_LENGTH) {
+        putMatch(work, matchLength, matchDistance);
+        end = position + matchLength;
+        if (matchLength <= levelConfig[work->state.level].lazyLength) {
+          for (position++; position < end &&
+               position + MIN_MATCH_LENGTH <= work->dataLength; position++) {
+            insertString(work, position);
+          } /* for */
+        } /* if */
+        position = end;
+      } else {
+        putLiteral(work, work->data[position]);
+        position++;
+      } /* if */
+      work->emittedPos = position;
+      checkBlockFull(work);
+    } /* while */
+  } /* compressGreedy */
+
+
+
+/**
+ *  Lazy matching as used by the compression levels 4 to 9.
+ *  A match is only taken if the match at the next position
+ *  is not longer.
+ */
+static void compressLazy (deflateWorkType work, memSizeType position)
+
+  {
+    int32Type candidate;
+    memSizeType matchLength;
+    memSizeType matchDistance = 0;
+    memSizeType prevLength = MIN_MATCH_LENGTH - 1;
+    memSizeType prevDistance = 0;
+    boolType matchAvailable = FALSE;
+    memSizeType end;
+
+  /* compressLazy */
+    while (position < work->dataLength && !work->memoryError) {
+      matchLength = MIN_MATCH_LENGTH - 1;
+      if (position + MIN_MATCH_LENGTH <= work->dataLength) {
+        candidate = insertString(work, position);
+        if (prevLength < levelConfig[work->state.level].lazyLength) {
+          matchLength = longestMatch(work, position, prevLength,
+                                     candidate, &matchDistance);
+          if (matchLength < MIN_MATCH_LENGTH ||
+              (matchLength == MIN_MATCH_LENGTH && matchDistance > TOO_FAR)) {
+            matchLength = MIN_MATCH_LENGTH - 1;
+          } /* if */
+        } /* if */
+      } /* if */
+      if (prevLength >= MIN_MATCH_LENGTH && matchLength <= prevLength) {
+        putMatch(work, prevLength, prevDistance);
+        end = position - 1 + prevLength;
+        for (position++; position < end &&
+             position + MIN_MATCH_LENGTH <= work->dataLength; position++) {
+          insertString(work, position);
+        } /* for */
+        position = end;
+        work->emittedPos = position;
+        matchAvailable = FALSE;
+        prevLength = MIN_MATCH_LENGTH - 1;
+      } else {
+        if (matchAvailable) {
+          putLiteral(work, work->data[position - 1]);
+          work->emittedPos = position;
+        } /* if */
+        matchAvailable = TRUE;
+        prevLength = matchLength;
+        prevDistance = matchDistance;
+        position++;
+      } /* if */
+      checkBlockFull(work);
+    } /* while */
+    if (matchAvailable) {
+      putLiteral(work, work->data[position - 1]);
+      work->emittedPos = position;
+    } /* if */
+  } /* compressLazy */
+
+
+
+static void initCodeTables (deflateWorkType work)
+
+  {
+    unsigned int code;
+    unsigned int length;
+    unsigned int distance;
+
+  /* initCodeTables */
+    for (code = 0; code < 28; code++) {
+      for (length = lengthBase[code];
+           length < (unsigned int) lengthBase[code] + (1U << lengthExtraBits[code]);
+           length++) {
+        work->lengthCode[length] = (ucharType) code;
+      } /* for */
+    } /* for */
+    work->lengthCode[MAX_MATCH_LENGTH] = 28;
+    for (code = 0; code < NUM_DISTANCE_SYMBOLS; code++) {
+      for (distance = distanceBase[code];
+           distance < (unsigned int) distanceBase[code] + (1U << distanceExtraBits[code]);
+           distance++) {
+        if (distance <= 256) {
+          work->distanceCode[distance - 1] = (ucharType) code;
+        } else if (((distance - 1) & 127) == 0) {
+          work->distanceCode[256 + ((distance - 1) >> 7)] = (ucharType) code;
+        } /* if */
+      } /* for */
+    } /* for */
+  } /* initCodeTables */
+
+
+
+/**
+ *  Compress the bytes of 'work->data' after the window.
+ *  The window at the start of 'work->data' is used as dictionary.
+ */
+static void compressSegment (deflateWorkType work, boolType lastSegment)
+
+  {
+    memSizeType position;
+    int32Type *headEnd;
+    int32Type *head;
+
+  /* compressSegment */
+    head = work->head;
+    headEnd = &work->head[HASH_SIZE];
+    while (head < headEnd) {
+      *head = NO_POSITION;
+      head++;
+    } /* while */
+    work->blockStart = work->state.windowFill;
+    work->emittedPos = work->state.windowFill;
+    if (work->state.level == 0) {
+      work->emittedPos = work->dataLength;
+    } else {
+      for (position = 0; position + MIN_MATCH_LENGTH <= work->state.windowFill;
+           position++) {
+        insertString(work, position);
+      } /* for */
+      if (work->state.level <= 3) {
+        compressGreedy(work, work->state.windowFill);
+      } else {
+        compressLazy(work, work->state.windowFill);
+      } /* if */
+    } /* if */
+    if (!work->memoryError &&
+        (work->emittedPos != work->blockStart || lastSegment)) {
+      flushBlock(work, lastSegment);
+    } /* if */
+  } /* compressSegment */
+
+
+
+/**
+ *  Copy the deflate state stored in the bstring 'stateBstri' to 'state'.
+ *  @return TRUE if 'stateBstri' contains a valid state, FALSE otherwise.
+ */
+static boolType getDeflateState (const const_bstriType stateBstri,
+    deflateStateRecord *state)
+
+  {
+    boolType okay = FALSE;
+
+  /* getDeflateState */
+    if (stateBstri->size == sizeof(deflateStateRecord) + WINDOW_SIZE) {
+      memcpy(state, stateBstri->mem, sizeof(deflateStateRecord));
+      okay = state->level <= MAX_LEVEL &&
+             state->finished <= 1 &&
+             state->bitCount < 8 &&
+             state->windowFill <= WINDOW_SIZE;
+    } /* if */
+    return okay;
+  } /* getDeflateState */
+
+
+
+/**
+ *  Create a deflate state for an incremental compression.
+ *  @param level Compression level from 0 (no compression) to 9
+ *         (best compression). The level -1 selects the default
+ *         level 6.
+ *  @return the deflate state, which is stored in a bstring.
+ *  @exception RANGE_ERROR If 'level' is not in the range -1 to 9.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+bstriType dflDeflateInit (intType level)
+
+  {
+    deflateStateRecord state;
+    memSizeType size;
+    bstriType result;
+
+  /* dflDeflateInit */
+    logFunction(printf("dflDeflateInit(" FMT_D ")\n", level););
+    if (unlikely(level < -1 || level > MAX_LEVEL)) {
+      logError(printf("dflDeflateInit(" FMT_D "): "
+                      "Level not in range -1 .. 9.\n", level););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else {
+      memset(&state, 0, sizeof(deflateStateRecord));
+      state.level = level == -1 ? DEFAULT_LEVEL : (uint32Type) level;
+      size = sizeof(deflateStateRecord) + WINDOW_SIZE;
+      if (unlikely(!ALLOC_BSTRI_SIZE_OK(result, size))) {
+        raise_error(MEMORY_ERROR);
+      } else {
+        result->size = size;
+        memcpy(result->mem, &state, sizeof(deflateStateRecord));
+        memset(&result->mem[sizeof(deflateStateRecord)], 0, WINDOW_SIZE);
+      } /* if */
+    } /* if */
+    return result;
+  } /* dflDeflateInit */
+
+
+
+/**
+ *  Compress 'uncompressed' with DEFLATE and return the compressed bytes.
+ *  The data of previous calls is used as dictionary. Every call writes
+ *  complete blocks. If 'lastBlock' is FALSE up to seven bits of the
+ *  last block are kept in the state. If 'lastBlock' is TRUE the
+ *  compressed data is finished and padded to a whole byte.
+ *  @param stateBstri Deflate state created with dflDeflateInit().
+ *  @param lastBlock TRUE if no data follows after 'uncompressed'.
+ *  @return the compressed bytes.
+ *  @exception RANGE_ERROR If 'stateBstri' is not a valid deflate state,
+ *             if the compression has already been finished or if
+ *             'uncompressed' contains a character beyond '\255;'.
+ *             In this case the state is not changed.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+striType dflDeflateStep (bstriType stateBstri, const const_striType uncompressed,
+    boolType lastBlock)
+
+  {
+    deflateWorkType work;
+    memSizeType dataCapacity = 0;
+    memSizeType consumed = 0;
+    memSizeType segmentLength;
+    memSizeType keep;
+    boolType okay = TRUE;
+    striType result = NULL;
+
+  /* dflDeflateStep */
+    logFunction(printf("dflDeflateStep(*, \"%s\", %d)\n",
+                       striAsUnquotedCStri(uncompressed), lastBlock););
+    if (unlikely(!ALLOC_DEFLATE_WORK(work))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      if (unlikely(!getDeflateState(stateBstri, &work->state) ||
+                   work->state.finished)) {
+        logError(printf("dflDeflateStep: Illegal deflate state.\n"););
+        raise_error(RANGE_ERROR);
+      } else {
+        dataCapacity = WINDOW_SIZE + (uncompressed->size < SEGMENT_SIZE ?
+                                      uncompressed->size : SEGMENT_SIZE) + DATA_SLACK;
+        work->outCapacity = uncompressed->size / 2 + 64;
+        work->out = NULL;
+        if (unlikely(!ALLOC_UBYTES(work->data, dataCapacity))) {
+          raise_error(MEMORY_ERROR);
+        } else if (unlikely(!ALLOC_UBYTES(work->out, work->outCapacity))) {
+          FREE_BYTES(work->data, dataCapacity);
+          raise_error(MEMORY_ERROR);
+        } else {
+          memcpy(work->data, &stateBstri->mem[sizeof(deflateStateRecord)],
+                 work->state.windowFill);
+          work->outPos = 0;
+          work->bitBuf = work->state.bitBuf;
+          work->bitCount = work->state.bitCount;
+          work->memoryError = FALSE;
+          work->numSymbols = 0;
+          memset(work->litLenFreq, 0, sizeof(work->litLenFreq));
+          memset(work->distFreq, 0, sizeof(work->distFreq));
+          initCodeTables(work);
+          do {
+            segmentLength = uncompressed->size - consumed;
+            if (segmentLength > SEGMENT_SIZE) {
+              segmentLength = SEGMENT_SIZE;
+            } /* if */
+            if (unlikely(memcpy_from_strelem(&work->data[work->state.windowFill],
+                                             &uncompressed->mem[consumed],
+                                             segmentLength))) {
+              logError(printf("dflDeflateStep: "
+                              "Character beyond '\\255;' in data.\n"););
+              okay = FALSE;
+            } else {
+              consumed += segmentLength;
+              work->dataLength = work->state.windowFill + segmentLength;
+              memset(&work->data[work->dataLength], 0, DATA_SLACK);
+              if (segmentLength != 0 || lastBlock) {
+                compressSegment(work, lastBlock && consumed == uncompressed->size);
+              } /* if */
+              keep = work->dataLength < WINDOW_SIZE ? work->dataLength : WINDOW_SIZE;
+              memmove(work->data, &work->data[work->dataLength - keep], keep);
+              work->state.windowFill = (uint32Type) keep;
+            } /* if */
+          } while (okay && !work->memoryError && consumed < uncompressed->size);
+          if (!okay) {
+            raise_error(RANGE_ERROR);
+          } else if (work->memoryError) {
+            raise_error(MEMORY_ERROR);
+          } else {
+            if (lastBlock) {
+              putBits(work, 0, (8 - work->bitCount % 8) % 8);
+              work->state.finished = 1;
+            } /* if */
+            flushWholeBytes(work);
+            work->state.bitBuf = (uint32Type) work->bitBuf;
+            work->state.bitCount = work->bitCount;
+            result = bytesToStri(work->out, work->outPos);
+            if (result != NULL) {
+              memcpy(stateBstri->mem, &work->state, sizeof(deflateStateRecord));
+              memcpy(&stateBstri->mem[sizeof(deflateStateRecord)], work->data,
+                     work->state.windowFill);
+            } /* if */
+          } /* if */
+          FREE_BYTES(work->out, work->outCapacity);
+          FREE_BYTES(work->data, dataCapacity);
+        } /* if */
+      } /* if */
+      FREE_DEFLATE_WORK(work);
+    } /* if */
+    logFunction(printf("dflDeflateStep --> \"%s\"\n",
+                       striAsUnquotedCStri(result)););
+    return result;
+  } /* dflDeflateStep */
@@ -0,0 +1,150 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Library                                                 */
+/*  File: seed7/src/dfllib.c                                        */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: All primitive actions for DEFLATE compression.         */
+/*                                                                  */
+/********************************************************************/
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+
+#include "common.h"
+#include "data.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "syvarutl.h"
+#include "objutl.h"
+#include "runerr.h"
+#include "dfl_rtl.h"
+
+#undef EXTERN
+#define EXTERN
+#include "dfllib.h"
+
+
+
+/**
+ *  Create a deflate state for the compression level arg_1.
+ *  The level -1 selects the default compression level.
+ *  @return the new deflate state.
+ *  @exception RANGE_ERROR If the level is not in the range -1 to 9.
+ */
+objectType dfl_deflate_init (listType arguments)
+
+  { /* dfl_deflate_init */
+    isit_int(arg_1(arguments));
+    return bld_bstri_temp(
+        dflDeflateInit(take_int(arg_1(arguments))));
+  } /* dfl_deflate_init */
+
+
+
+/**
+ *  Compress uncompressed/arg_2 with the deflate state arg_1.
+ *  If lastBlock/arg_3 is TRUE the compressed data is finished.
+ *  @return the compressed bytes.
+ *  @exception RANGE_ERROR If arg_1 is not a valid deflate state or
+ *             if arg_2 contains a character beyond '\255;'.
+ */
+objectType dfl_deflate_step (listType arguments)
+
+  { /* dfl_deflate_step */
+    isit_bstri(arg_1(arguments));
+    is_variable(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    isit_bool(arg_3(arguments));
+    return bld_stri_temp(
+        dflDeflateStep(take_bstri(arg_1(arguments)), take_stri(arg_2(arguments)),
+                       take_bool(arg_3(arguments)) == SYS_TRUE_OBJECT));
+  } /* dfl_deflate_step */
+
+
+
+/**
+ *  Determine if the inflate state arg_1 reached the end of the data.
+ *  @return TRUE if the last block has been decompressed,
+ *          FALSE otherwise.
+ *  @exception RANGE_ERROR If arg_1 is not a valid inflate state.
+ */
+objectType dfl_inflate_finished (listType arguments)
+
+  { /* dfl_inflate_finished */
+    isit_bstri(arg_1(arguments));
+    if (dflInflateFinished(take_bstri(arg_1(arguments)))) {
+      return SYS_TRUE_OBJECT;
+    } else {
+      return SYS_FALSE_OBJECT;
+    } /* if */
+  } /* dfl_inflate_finished */
+
+
+
+/**
+ *  Create an inflate state. If arg_1 is TRUE the state
+ *  decompresses DEFLATE64 data.
+ *  @return the new inflate state.
+ */
+objectType dfl_inflate_init (listType arguments)
+
+  { /* dfl_inflate_init */
+    isit_bool(arg_1(arguments));
+    return bld_bstri_temp(
+        dflInflateInit(take_bool(arg_1(arguments)) == SYS_TRUE_OBJECT));
+  } /* dfl_inflate_init */
+
+
+
+/**
+ *  Decompress compressed/arg_2 starting at bytePos/arg_3 with the
+ *  inflate state arg_1. The variable bytePos/arg_3 is advanced
+ *  behind the consumed bytes. If inputEnd/arg_4 is TRUE no data
+ *  follows after arg_2. At least minLength/arg_5 bytes are produced,
+ *  if the data and the input allow it.
+ *  @return the decompressed bytes.
+ *  @exception RANGE_ERROR If arg_1 is not a valid inflate state or
+ *             if arg_2 is not in DEFLATE format.
+ *  @exception INDEX_ERROR If bytePos/arg_3 is not in the range
+ *             1 to length(arg_2) + 1.
+ */
+objectType dfl_inflate_step (listType arguments)
+
+  {
+    objectType bytePosVar;
+
+  /* dfl_inflate_step */
+    isit_bstri(arg_1(arguments));
+    is_variable(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    bytePosVar = arg_3(arguments);
+    isit_int(bytePosVar);
+    is_variable(bytePosVar);
+    isit_bool(arg_4(arguments));
+    isit_int(arg_5(arguments));
+    return bld_stri_temp(
+        dflInflateStep(take_bstri(arg_1(arguments)), take_stri(arg_2(arguments)),
+                       &bytePosVar->value.intValue,
+                       take_bool(arg_4(arguments)) == SYS_TRUE_OBJECT,
+                       take_int(arg_5(arguments))));
+  } /* dfl_inflate_step */
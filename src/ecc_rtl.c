@@ -0,0 +1,1074 @@
+/********************************************************************/
+/*                                                                  */
+/*  ecc_rtl.c     Elliptic curve scalar multiplication.             */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/ecc_rtl.c                                       */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: Elliptic curve scalar multiplication.                  */
+/*                                                                  */
+/*  Supports the curves secp256r1 and secp384r1 and the X25519      */
+/*  function of RFC 7748. Field elements have a fixed number of     */
+/*  limbs and are kept in Montgomery form. The points of the NIST   */
+/*  curves use projective coordinates and the complete formulas of  */
+/*  Renes, Costello and Batina. So there are no special cases for   */
+/*  the neutral element or for doubling. Table entries are selected */
+/*  by scanning the whole table. This way the sequence of           */
+/*  operations and memory accesses does not depend on the scalar.   */
+/*  The multiples of the base point are computed at the first use.  */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+
+#include "common.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "striutl.h"
+#include "rtl_err.h"
+
+#undef EXTERN
+#define EXTERN
+#include "ecc_rtl.h"
+
+
+#ifdef INT128TYPE
+typedef uint64Type limbType;
+typedef uint128Type doubleLimbType;
+#define LIMB_SIZE 64
+#else
+typedef uint32Type limbType;
+typedef uint64Type doubleLimbType;
+#define LIMB_SIZE 32
+#endif
+
+#define LIMB_BYTES           (LIMB_SIZE / 8)
+#define MAX_FIELD_BYTES      48
+#define MAX_LIMBS            (MAX_FIELD_BYTES / LIMB_BYTES)
+#define WINDOW_BITS           4
+#define WINDOW_SIZE          (1 << WINDOW_BITS)
+#define X25519_BYTES         32
+
+typedef limbType fieldElement[MAX_LIMBS];
+
+typedef struct {
+    unsigned int limbs;
+    unsigned int bytes;
+    fieldElement modulus;
+    limbType modulusInverse;  /* -modulus ** -1 mod 2 ** LIMB_SIZE */
+    fieldElement one;         /* 1 in Montgomery form */
+    fieldElement rSquared;    /* Converts to Montgomery form */
+  } fieldRecord;
+
+typedef const fieldRecord *const_fieldType;
+
+/* The point (x, y) is represented by (x * z, y * z, z). */
+typedef struct {
+    fieldElement x;
+    fieldElement y;
+    fieldElement z;
+  } pointRecord;
+
+typedef struct {
+    fieldElement x;
+    fieldElement y;
+  } affinePointRecord;
+
+typedef struct {
+    const char *modulusHex;
+    const char *bHex;
+    const char *gxHex;
+    const char *gyHex;
+    unsigned int bytes;
+    boolType initialized;
+    fieldRecord field;
+    fieldElement b;
+    /* For every window w the points j * 16 ** w * g with j from 1 to 15. */
+    affinePointRecord *baseTable;
+  } curveRecord;
+
+typedef curveRecord *curveType;
+
+/* Curves with a = -3. */
+static curveRecord secp256r1 = {
+    "ffffffff00000001000000000000000000000000ffffffffffffffffffffffff",
+    "5ac635d8aa3a93e7b3ebbd55769886bc651d06b0cc53b0f63bce3c3e27d2604b",
+    "6b17d1f2e12c4247f8bce6e563a440f277037d812deb33a0f4a13945d898c296",
+    "4fe342e2fe1a7f9b8ee7eb4a7c0f9e162bce33576b315ececbb6406837bf51f5",
+    32, FALSE};
+
+static curveRecord secp384r1 = {
+    "fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffe"
+    "ffffffff0000000000000000ffffffff",
+    "b3312fa7e23ee7e4988e056be3f82d19181d9c6efe8141120314088f5013875a"
+    "c656398d8a2ed19d2a85c8edd3ec2aef",
+    "aa87ca22be8b05378eb1c71ef320ad746e1d3b628ba79b9859f741e082542a38"
+    "5502f25dbf55296c3a545e3872760ab7",
+    "3617de4a96262c6f5d9e98bf9292dc29f8f41dbd289a147ce9da3113b5f0b8c0"
+    "0a60b1ce1d7e819d7a431d7c90ea0e5f",
+    48, FALSE};
+
+static boolType curve25519FieldInitialized = FALSE;
+static fieldRecord curve25519Field;
+
+
+
+static void bytesToLimbs (limbType *limbs, unsigned int numLimbs,
+    const ucharType *bytes)
+
+  {
+    unsigned int pos;
+
+  /* bytesToLimbs */
+    memset(limbs, 0, numLimbs * sizeof(limbType));
+    for (pos = 0; pos < numLimbs * LIMB_BYTES; pos++) {
+      limbs[pos / LIMB_BYTES] |= (limbType) bytes[numLimbs * LIMB_BYTES - 1 - pos] <<
+                                 (8 * (pos % LIMB_BYTES));
+    } /* for */
+  } /* bytesToLimbs */
+
+
+
+static void limbsToBytes (ucharType *bytes, unsigned int numLimbs,
+    const limbType *limbs)
+
+  {
+    unsigned int pos;
+
+  /* limbsToBytes */
+    for (pos = 0; pos < numLimbs * LIMB_BYTES; pos++) {
+      bytes[numLimbs * LIMB_BYTES - 1 - pos] =
+          (ucharType) (limbs[pos / LIMB_BYTES] >> (8 * (pos % LIMB_BYTES)));
+    } /* for */
+  } /* limbsToBytes */
+
+
+
+static void hexToLimbs (limbType *limbs, unsigned int numLimbs, const char *hex)
+
+  {
+    ucharType bytes[MAX_FIELD_BYTES];
+    unsigned int pos;
+    unsigned int digit;
+
+  /* hexToLimbs */
+    for (pos = 0; pos < numLimbs * LIMB_BYTES * 2; pos++) {
+      if (hex[pos] >= 'a') {
+        digit = (unsigned int) (hex[pos] - 'a' + 10);
+      } else {
+        digit = (unsigned int) (hex[pos] - '0');
+      } /* if */
+      if ((pos & 1) == 0) {
+        bytes[pos / 2] = (ucharType) (digit << 4);
+      } else {
+        bytes[pos / 2] |= (ucharType) digit;
+      } /* if */
+    } /* for */
+    bytesToLimbs(limbs, numLimbs, bytes);
+  } /* hexToLimbs */
+
+
+
+/**
+ *  Return a mask with all bits set if a == b and zero otherwise.
+ */
+static limbType equalMask (unsigned int a, unsigned int b)
+
+  {
+    limbType diff;
+
+  /* equalMask */
+    diff = (limbType) (a ^ b);
+    return ((diff | ((limbType) 0 - diff)) >> (LIMB_SIZE - 1)) - 1;
+  } /* equalMask */
+
+
+
+/**
+ *  Subtract the modulus from t, if t (with the extra limb 'high')
+ *  is not less than the modulus.
+ */
+static inline void reduceOnce (limbType *r, const limbType *t, limbType high,
+    const_fieldType field, const unsigned int limbs)
+
+  {
+    limbType diff[MAX_LIMBS];
+    doubleLimbType sum;
+    limbType borrow = 0;
+    limbType mask;
+    unsigned int idx;
+
+  /* reduceOnce */
+    for (idx = 0; idx < limbs; idx++) {
+      sum = (doubleLimbType) t[idx] - field->modulus[idx] - borrow;
+      diff[idx] = (limbType) sum;
+      borrow = (limbType) (sum >> LIMB_SIZE) & 1;
+    } /* for */
+    /* Use the difference, if there was a carry or if there was no borrow. */
+    mask = (limbType) 0 - (high | (borrow ^ 1));
+    for (idx = 0; idx < limbs; idx++) {
+      r[idx] = (diff[idx] & mask) | (t[idx] & ~mask);
+    } /* for */
+  } /* reduceOnce */
+
+
+
+static inline void addLimbs (limbType *r, const limbType *a,
+    const limbType *b, const_fieldType field, const unsigned int limbs)
+
+  {
+    limbType t[MAX_LIMBS];
+    doubleLimbType sum;
+    limbType carry = 0;
+    unsigned int idx;
+
+  /* addLimbs */
+    for (idx = 0; idx < limbs; idx++) {
+      sum = (doubleLimbType) a[idx] + b[idx] + carry;
+      t[idx] = (limbType) sum;
+      carry = (limbType) (sum >> LIMB_SIZE);
+    } /* for */
+    reduceOnce(r, t, carry, field, limbs);
+  } /* addLimbs */
+
+
+
+static inline void subLimbs (limbType *r, const limbType *a,
+    const limbType *b, const_fieldType field, const unsigned int limbs)
+
+  {
+    doubleLimbType sum;
+    limbType borrow = 0;
+    limbType carry = 0;
+    limbType mask;
+    unsigned int idx;
+
+  /* subLimbs */
+    for (idx = 0; idx < limbs; idx++) {
+      sum = (doubleLimbType) a[idx] - b[idx] - borrow;
+      r[idx] = (limbType) sum;
+      borrow = (limbType) (sum >> LIMB_SIZE) & 1;
+    } /* for */
+    /* Add the modulus, if the difference is negative. */
+    mask = (limbType) 0 - borrow;
+    for (idx = 0; idx < limbs; idx++) {
+      sum = (doubleLimbType) r[idx] + (field->modulus[idx] & mask) + carry;
+      r[idx] = (limbType) sum;
+      carry = (limbType) (sum >> LIMB_SIZE);
+    } /* for */
+  } /* subLimbs */
+
+
+
+/**
+ *  Montgomery multiplication: r = a * b / R mod modulus.
+ *  The product is computed with the CIOS method.
+ */
+static inline void mulLimbs (limbType *r, const limbType *a,
+    const limbType *b, const_fieldType field, const unsigned int limbs)
+
+  {
+    limbType t[MAX_LIMBS + 2];
+    doubleLimbType product;
+    limbType carry;
+    limbType m;
+    unsigned int i;
+    unsigned int j;
+
+  /* mulLimbs */
+    memset(t, 0, sizeof(t));
+    for (i = 0; i < limbs; i++) {
+      carry = 0;
+      for (j = 0; j < limbs; j++) {
+        product = (doubleLimbType) a[j] * b[i] + t[j] + carry;
+        t[j] = (limbType) product;
+        carry = (limbType) (product >> LIMB_SIZE);
+      } /* for */
+      product = (doubleLimbType) t[limbs] + carry;
+      t[limbs] = (limbType) product;
+      t[limbs + 1] = (limbType) (product >> LIMB_SIZE);
+      m = t[0] * field->modulusInverse;
+      product = (doubleLimbType) m * field->modulus[0] + t[0];
+      carry = (limbType) (product >> LIMB_SIZE);
+      for (j = 1; j < limbs; j++) {
+        product = (doubleLimbType) m * field->modulus[j] + t[j] + carry;
+        t[j - 1] = (limbType) product;
+        carry = (limbType) (product >> LIMB_SIZE);
+      } /* for */
+      product = (doubleLimbType) t[limbs] + carry;
+      t[limbs - 1] = (limbType) product;
+      t[limbs] = t[limbs + 1] + (limbType) (product >> LIMB_SIZE);
+    } /* for */
+    reduceOnce(r, t, t[limbs], field, limbs);
+  } /* mulLimbs */
+
+
+
+/* All fields have 256 or 384 bits. A constant number of limbs */
+/* allows the compiler to unroll the loops.                     */
+
+static void fieldAdd (limbType *r, const limbType *a, const limbType *b,
+    const_fieldType field)
+
+  { /* fieldAdd */
+    if (field->limbs == 256 / LIMB_SIZE) {
+      addLimbs(r, a, b, field, 256 / LIMB_SIZE);
+    } else {
+      addLimbs(r, a, b, field, 384 / LIMB_SIZE);
+    } /* if */
+  } /* fieldAdd */
+
+
+
+static void fieldSub (limbType *r, const limbType *a, const limbType *b,
+    const_fieldType field)
+
+  { /* fieldSub */
+    if (field->limbs == 256 / LIMB_SIZE) {
+      subLimbs(r, a, b, field, 256 / LIMB_SIZE);
+    } else {
+      subLimbs(r, a, b, field, 384 / LIMB_SIZE);
+    } /* if */
+  } /* fieldSub */
+
+
+
+static void fieldMul (limbType *r, const limbType *a, const limbType *b,
+    const_fieldType field)
+
+  { /* fieldMul */
+    if (field->limbs == 256 / LIMB_SIZE) {
+      mulLimbs(r, a, b, field, 256 / LIMB_SIZE);
+    } else {
+      mulLimbs(r, a, b, field, 384 / LIMB_SIZE);
+    } /* if */
+  } /* fieldMul */
+
+
+
+/**
+ *  Compute r = a ** (modulus - 2), which is the inverse of a.
+ *  The exponent is public, so the sequence of operations is fixed.
+ */
+static void fieldInvert (limbType *r, const limbType *a,
+    const_fieldType field)
+
+  {
+    fieldElement exponent;
+    fieldElement power;
+    int bit;
+
+  /* fieldInvert */
+    memcpy(exponent, field->modulus, sizeof(fieldElement));
+    exponent[0] -= 2;
+    memcpy(power, field->one, sizeof(fieldElement));
+    for (bit = (int) (field->limbs * LIMB_SIZE) - 1; bit >= 0; bit--) {
+      fieldMul(power, power, power, field);
+      if ((exponent[bit / LIMB_SIZE] >> (bit % LIMB_SIZE)) & 1) {
+        fieldMul(power, power, a, field);
+      } /* if */
+    } /* for */
+    memcpy(r, power, sizeof(fieldElement));
+  } /* fieldInvert */
+
+
+
+static limbType fieldIsZero (const limbType *a, const_fieldType field)
+
+  {
+    limbType bits = 0;
+    unsigned int idx;
+
+  /* fieldIsZero */
+    for (idx = 0; idx < field->limbs; idx++) {
+      bits |= a[idx];
+    } /* for */
+    return bits == 0;
+  } /* fieldIsZero */
+
+
+
+static void fieldSelect (limbType *r, const limbType *a, limbType mask,
+    const_fieldType field)
+
+  {
+    unsigned int idx;
+
+  /* fieldSelect */
+    for (idx = 0; idx < field->limbs; idx++) {
+      r[idx] = (a[idx] & mask) | (r[idx] & ~mask);
+    } /* for */
+  } /* fieldSelect */
+
+
+
+/**
+ *  Convert a big-endian number to a field element in Montgomery form.
+ *  @return TRUE if the number is less than the modulus,
+ *          FALSE otherwise.
+ */
+static boolType fieldFromBytes (limbType *r, const ucharType *bytes,
+    const_fieldType field)
+
+  {
+    fieldElement value;
+    fieldElement reduced;
+
+  /* fieldFromBytes */
+    bytesToLimbs(value, field->limbs, bytes);
+    reduceOnce(reduced, value, 0, field, field->limbs);
+    fieldMul(r, value, field->rSquared, field);
+    return memcmp(reduced, value, field->limbs * sizeof(limbType)) == 0;
+  } /* fieldFromBytes */
+
+
+
+static void fieldToBytes (ucharType *bytes, const limbType *a,
+    const_fieldType field)
+
+  {
+    fieldElement unity;
+    fieldElement value;
+
+  /* fieldToBytes */
+    memset(unity, 0, sizeof(fieldElement));
+    unity[0] = 1;
+    fieldMul(value, a, unity, field);
+    limbsToBytes(bytes, field->limbs, value);
+  } /* fieldToBytes */
+
+
+
+static void initField (fieldRecord *field, const char *modulusHex,
+    unsigned int bytes)
+
+  {
+    limbType inverse;
+    doubleLimbType difference;
+    limbType borrow = 0;
+    unsigned int count;
+
+  /* initField */
+    field->bytes = bytes;
+    field->limbs = bytes / LIMB_BYTES;
+    hexToLimbs(field->modulus, field->limbs, modulusHex);
+    /* Newton iteration: Every step doubles the number of correct bits. */
+    inverse = field->modulus[0];
+    for (count = 0; count < 6; count++) {
+      inverse *= 2 - field->modulus[0] * inverse;
+    } /* for */
+    field->modulusInverse = (limbType) 0 - inverse;
+    /* R mod modulus is computed as (R - modulus) mod modulus. */
+    for (count = 0; count < field->limbs; count++) {
+      difference = (doubleLimbType) 0 - field->modulus[count] - borrow;
+      field->one[count] = (limbType) difference;
+      borrow = (limbType) (difference >> LIMB_SIZE) & 1;
+    } /* for */
+    reduceOnce(field->one, field->one, 0, field, field->limbs);
+    memcpy(field->rSquared, field->one, sizeof(fieldElement));
+    for (count = 0; count < field->limbs * LIMB_SIZE; count++) {
+      fieldAdd(field->rSquared, field->rSquared, field->rSquared, field);
+    } /* for */
+  } /* initField */
+
+
+
+static void setNeutral (pointRecord *point, const_fieldType field)
+
+  {
+  /* setNeutral */
+    memset(point->x, 0, sizeof(fieldElement));
+    memcpy(point->y, field->one, sizeof(fieldElement));
+    memset(point->z, 0, sizeof(fieldElement));
+  } /* setNeutral */
+
+
+
+/**
+ *  Complete addition for curves with a = -3.
+ *  This is algorithm 4 of "Complete addition formulas for prime
+ *  order elliptic curves" (Renes, Costello, Batina).
+ *  It also works for p1 = p2 and if p1 or p2 is the neutral element.
+ */
+static void pointAdd (pointRecord *sum, const pointRecord *p1,
+    const pointRecord *p2, const curveRecord *curve)
+
+  {
+    const_fieldType field;
+    fieldElement t0, t1, t2, t3, t4, x3, y3, z3;
+
+  /* pointAdd */
+    field = &curve->field;
+    fieldMul(t0, p1->x, p2->x, field);
+    fieldMul(t1, p1->y, p2->y, field);
+    fieldMul(t2, p1->z, p2->z, field);
+    fieldAdd(t3, p1->x, p1->y, field);
+    fieldAdd(t4, p2->x, p2->y, field);
+    fieldMul(t3, t3, t4, field);
+    fieldAdd(t4, t0, t1, field);
+    fieldSub(t3, t3, t4, field);
+    fieldAdd(t4, p1->y, p1->z, field);
+    fieldAdd(x3, p2->y, p2->z, field);
+    fieldMul(t4, t4, x3, field);
+    fieldAdd(x3, t1, t2, field);
+    fieldSub(t4, t4, x3, field);
+    fieldAdd(x3, p1->x, p1->z, field);
+    fieldAdd(y3, p2->x, p2->z, field);
+    fieldMul(x3, x3, y3, field);
+    fieldAdd(y3, t0, t2, field);
+    fieldSub(y3, x3, y3, field);
+    fieldMul(z3, curve->b, t2, field);
+    fieldSub(x3, y3, z3, field);
+    fieldAdd(z3, x3, x3, field);
+    fieldAdd(x3, x3, z3, field);
+    fieldSub(z3, t1, x3, field);
+    fieldAdd(x3, t1, x3, field);
+    fieldMul(y3, curve->b, y3, field);
+    fieldAdd(t1, t2, t2, field);
+    fieldAdd(t2, t1, t2, field);
+    fieldSub(y3, y3, t2, field);
+    fieldSub(y3, y3, t0, field);
+    fieldAdd(t1, y3, y3, field);
+    fieldAdd(y3, t1, y3, field);
+    fieldAdd(t1, t0, t0, field);
+    fieldAdd(t0, t1, t0, field);
+    fieldSub(t0, t0, t2, field);
+    fieldMul(t1, t4, y3, field);
+    fieldMul(t2, t0, y3, field);
+    fieldMul(y3, x3, z3, field);
+    fieldAdd(y3, y3, t2, field);
+    fieldMul(x3, t3, x3, field);
+    fieldSub(x3, x3, t1, field);
+    fieldMul(z3, t4, z3, field);
+    fieldMul(t1, t3, t0, field);
+    fieldAdd(z3, z3, t1, field);
+    memcpy(sum->x, x3, sizeof(fieldElement));
+    memcpy(sum->y, y3, sizeof(fieldElement));
+    memcpy(sum->z, z3, sizeof(fieldElement));
+  } /* pointAdd */
+
+
+
+/**
+ *  Complete doubling for curves with a = -3.
+ *  This is algorithm 6 of "Complete addition formulas for prime
+ *  order elliptic curves" (Renes, Costello, Batina).
+ */
+static void pointDouble (pointRecord *sum, const pointRecord *p1,
+    const curveRecord *curve)
+
+  {
+    const_fieldType field;
+    fieldElement t0, t1, t2, t3, x3, y3, z3;
+
+  /* pointDouble */
+    field = &curve->field;
+    fieldMul(t0, p1->x, p1->x, field);
+    fieldMul(t1, p1->y, p1->y, field);
+    fieldMul(t2, p1->z, p1->z, field);
+    fieldMul(t3, p1->x, p1->y, field);
+    fieldAdd(t3, t3, t3, field);
+    fieldMul(z3, p1->x, p1->z, field);
+    fieldAdd(z3, z3, z3, field);
+    fieldMul(y3, curve->b, t2, field);
+    fieldSub(y3, y3, z3, field);
+    fieldAdd(x3, y3, y3, field);
+    fieldAdd(y3, x3, y3, field);
+    fieldSub(x3, t1, y3, field);
+    fieldAdd(y3, t1, y3, field);
+    fieldMul(y3, x3, y3, field);
+    fieldMul(x3, x3, t3, field);
+    fieldAdd(t3, t2, t2, field);
+    fieldAdd(t2, t2, t3, field);
+    fieldMul(z3, curve->b, z3, field);
+    fieldSub(z3, z3, t2, field);
+    fieldSub(z3, z3, t0, field);
+    fieldAdd(t3, z3, z3, field);
+    fieldAdd(z3, z3, t3, field);
+    fieldAdd(t3, t0, t0, field);
+    fieldAdd(t0, t3, t0, field);
+    fieldSub(t0, t0, t2, field);
+    fieldMul(t0, t0, z3, field);
+    fieldAdd(y3, y3, t0, field);
+    fieldMul(t0, p1->y, p1->z, field);
+    fieldAdd(t0, t0, t0, field);
+    fieldMul(z3, t0, z3, field);
+    fieldSub(x3, x3, z3, field);
+    fieldMul(z3, t0, t1, field);
+    fieldAdd(z3, z3, z3, field);
+    fieldAdd(z3, z3, z3, field);
+    memcpy(sum->x, x3, sizeof(fieldElement));
+    memcpy(sum->y, y3, sizeof(fieldElement));
+    memcpy(sum->z, z3, sizeof(fieldElement));
+  } /* pointDouble */
+
+
+
+/**
+ *  Get the window with the number 'window' from a big-endian scalar.
+ */
+static unsigned int scalarWindow (const ucharType *scalar, unsigned int bytes,
+    unsigned int window)
+
+  {
+  /* scalarWindow */
+    return (scalar[bytes - 1 - window / 2] >> (WINDOW_BITS * (window & 1))) &
+           (WINDOW_SIZE - 1);
+  } /* scalarWindow */
+
+
+
+/**
+ *  Compute the multiples of the base point for all windows.
+ *  The table entries are converted to affine coordinates with
+ *  one inversion per window.
+ *  @return FALSE if there is not enough memory, TRUE otherwise.
+ */
+static boolType initBaseTable (curveType curve)
+
+  {
+    const_fieldType field;
+    unsigned int numWindows;
+    unsigned int window;
+    unsigned int idx;
+    pointRecord base;
+    pointRecord multiple[WINDOW_SIZE - 1];
+    fieldElement zProduct[WINDOW_SIZE - 1];
+    fieldElement inverse;
+    fieldElement zInverse;
+    affinePointRecord *entry;
+    boolType okay = TRUE;
+
+  /* initBaseTable */
+    field = &curve->field;
+    numWindows = 2 * curve->bytes;
+    curve->baseTable = (affinePointRecord *) malloc(
+        numWindows * (WINDOW_SIZE - 1) * sizeof(affinePointRecord));
+    if (unlikely(curve->baseTable == NULL)) {
+      okay = FALSE;
+    } else {
+      hexToLimbs(base.x, field->limbs, curve->gxHex);
+      hexToLimbs(base.y, field->limbs, curve->gyHex);
+      fieldMul(base.x, base.x, field->rSquared, field);
+      fieldMul(base.y, base.y, field->rSquared, field);
+      memcpy(base.z, field->one, sizeof(fieldElement));
+      for (window = 0; window < numWindows; window++) {
+        multiple[0] = base;
+        for (idx = 1; idx < WINDOW_SIZE - 1; idx++) {
+          pointAdd(&multiple[idx], &multiple[idx - 1], &base, curve);
+        } /* for */
+        pointAdd(&base, &multiple[WINDOW_SIZE - 2], &base, curve);
+        /* Montgomery's trick: Invert all z coordinates at once. */
+        memcpy(zProduct[0], multiple[0].z, sizeof(fieldElement));
+        for (idx = 1; idx < WINDOW_SIZE - 1; idx++) {
+          fieldMul(zProduct[idx], zProduct[idx - 1], multiple[idx].z, field);
+        } /* for */
+        fieldInvert(inverse, zProduct[WINDOW_SIZE - 2], field);
+        entry = &curve->baseTable[window * (WINDOW_SIZE - 1)];
+        for (idx = WINDOW_SIZE - 2; idx >= 1; idx--) {
+          fieldMul(zInverse, inverse, zProduct[idx - 1], field);
+          fieldMul(inverse, inverse, multiple[idx].z, field);
+          fieldMul(entry[idx].x, multiple[idx].x, zInverse, field);
+          fieldMul(entry[idx].y, multiple[idx].y, zInverse, field);
+        } /* for */
+        fieldMul(entry[0].x, multiple[0].x, inverse, field);
+        fieldMul(entry[0].y, multiple[0].y, inverse, field);
+      } /* for */
+    } /* if */
+    return okay;
+  } /* initBaseTable */
+
+
+
+static curveType getCurve (intType curveNumber)
+
+  {
+    curveType curve;
+
+  /* getCurve */
+    if (curveNumber == 1) {
+      curve = &secp256r1;
+    } else if (curveNumber == 2) {
+      curve = &secp384r1;
+    } else {
+      logError(printf("getCurve(" FMT_D "): Unknown curve.\n",
+                      curveNumber););
+      raise_error(RANGE_ERROR);
+      curve = NULL;
+    } /* if */
+    if (curve != NULL && !curve->initialized) {
+      initField(&curve->field, curve->modulusHex, curve->bytes);
+      hexToLimbs(curve->b, curve->field.limbs, curve->bHex);
+      fieldMul(curve->b, curve->b, curve->field.rSquared, &curve->field);
+      if (unlikely(!initBaseTable(curve))) {
+        raise_error(MEMORY_ERROR);
+        curve = NULL;
+      } else {
+        curve->initialized = TRUE;
+      } /* if */
+    } /* if */
+    return curve;
+  } /* getCurve */
+
+
+
+static void multBasePoint (pointRecord *product, const curveRecord *curve,
+    const ucharType *scalar)
+
+  {
+    const_fieldType field;
+    unsigned int window;
+    unsigned int digit;
+    unsigned int idx;
+    limbType mask;
+    const affinePointRecord *entry;
+    pointRecord selected;
+
+  /* multBasePoint */
+    field = &curve->field;
+    setNeutral(product, field);
+    for (window = 0; window < 2 * curve->bytes; window++) {
+      digit = scalarWindow(scalar, curve->bytes, window);
+      setNeutral(&selected, field);
+      entry = &curve->baseTable[window * (WINDOW_SIZE - 1)];
+      for (idx = 1; idx < WINDOW_SIZE; idx++) {
+        mask = equalMask(idx, digit);
+        fieldSelect(selected.x, entry[idx - 1].x, mask, field);
+        fieldSelect(selected.y, entry[idx - 1].y, mask, field);
+        fieldSelect(selected.z, field->one, mask, field);
+      } /* for */
+      pointAdd(product, product, &selected, curve);
+    } /* for */
+  } /* multBasePoint */
+
+
+
+static void multPoint (pointRecord *product, const curveRecord *curve,
+    const pointRecord *point, const ucharType *scalar)
+
+  {
+    const_fieldType field;
+    pointRecord multiple[WINDOW_SIZE];
+    pointRecord selected;
+    int window;
+    unsigned int digit;
+    unsigned int idx;
+    limbType mask;
+
+  /* multPoint */
+    field = &curve->field;
+    setNeutral(&multiple[0], field);
+    multiple[1] = *point;
+    for (idx = 2; idx < WINDOW_SIZE; idx++) {
+      if ((idx & 1) == 0) {
+        pointDouble(&multiple[idx], &multiple[idx / 2], curve);
+      } else {
+        pointAdd(&multiple[idx], &multiple[idx - 1], point, curve);
+      } /* if */
+    } /* for */
+    setNeutral(product, field);
+    for (window = (int) (2 * curve->bytes) - 1; window >= 0; window--) {
+      for (idx = 0; idx < WINDOW_BITS; idx++) {
+        pointDouble(product, product, curve);
+      } /* for */
+      digit = scalarWindow(scalar, curve->bytes, (unsigned int) window);
+      selected = multiple[0];
+      for (idx = 1; idx < WINDOW_SIZE; idx++) {
+        mask = equalMask(idx, digit);
+        fieldSelect(selected.x, multiple[idx].x, mask, field);
+        fieldSelect(selected.y, multiple[idx].y, mask, field);
+        fieldSelect(selected.z, multiple[idx].z, mask, field);
+      } /* for */
+      pointAdd(product, product, &selected, curve);
+    } /* for */
+  } /* multPoint */
+
+
+
+/**
+ *  Decode an uncompressed point and check that it is on the curve.
+ *  @return TRUE if the point is valid, FALSE otherwise.
+ */
+static boolType decodePoint (pointRecord *point, const curveRecord *curve,
+    const const_striType encoded)
+
+  {
+    const_fieldType field;
+    ucharType bytes[1 + 2 * MAX_FIELD_BYTES];
+    fieldElement left;
+    fieldElement right;
+    fieldElement term;
+    boolType okay;
+
+  /* decodePoint */
+    field = &curve->field;
+    okay = encoded->size == 1 + 2 * curve->bytes &&
+           !memcpy_from_strelem(bytes, encoded->mem, encoded->size) &&
+           bytes[0] == 4 &&
+           fieldFromBytes(point->x, &bytes[1], field) &&
+           fieldFromBytes(point->y, &bytes[1 + curve->bytes], field);
+    if (okay) {
+      memcpy(point->z, field->one, sizeof(fieldElement));
+      /* Check y ** 2 = x ** 3 - 3 * x + b */
+      fieldMul(left, point->y, point->y, field);
+      fieldMul(right, point->x, point->x, field);
+      fieldMul(right, right, point->x, field);
+      fieldAdd(term, point->x, point->x, field);
+      fieldAdd(term, term, point->x, field);
+      fieldSub(right, right, term, field);
+      fieldAdd(right, right, curve->b, field);
+      okay = memcmp(left, right, field->limbs * sizeof(limbType)) == 0;
+    } /* if */
+    return okay;
+  } /* decodePoint */
+
+
+
+/**
+ *  Convert a point to affine coordinates and encode it uncompressed.
+ */
+static striType encodePoint (const pointRecord *point, const curveRecord *curve)
+
+  {
+    const_fieldType field;
+    ucharType bytes[1 + 2 * MAX_FIELD_BYTES];
+    fieldElement zInverse;
+    fieldElement coordinate;
+    memSizeType length;
+    striType result;
+
+  /* encodePoint */
+    field = &curve->field;
+    if (fieldIsZero(point->z, field)) {
+      bytes[0] = 0;
+      length = 1;
+    } else {
+      fieldInvert(zInverse, point->z, field);
+      bytes[0] = 4;
+      fieldMul(coordinate, point->x, zInverse, field);
+      fieldToBytes(&bytes[1], coordinate, field);
+      fieldMul(coordinate, point->y, zInverse, field);
+      fieldToBytes(&bytes[1 + curve->bytes], coordinate, field);
+      length = 1 + 2 * curve->bytes;
+    } /* if */
+    if (unlikely(!ALLOC_STRI_SIZE_OK(result, length))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      result->size = length;
+      memcpy_to_strelem(result->mem, bytes, length);
+    } /* if */
+    return result;
+  } /* encodePoint */
+
+
+
+/**
+ *  Multiply a point of an elliptic curve with a scalar.
+ *  The computation needs constant time.
+ *  @param curveNumber 1 for secp256r1 and 2 for secp384r1.
+ *  @param scalar Big-endian scalar with the size of a coordinate.
+ *  @param point Uncompressed point ("\4;" followed by x and y),
+ *         "\0;" for the neutral element or "" for the base point.
+ *  @return the uncompressed product or "\0;" if the product is the
+ *          neutral element.
+ *  @exception RANGE_ERROR If the curve is unknown, if the scalar
+ *             has the wrong size or if the point is not on the curve.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+striType eccMult (intType curveNumber, const const_striType scalar,
+    const const_striType point)
+
+  {
+    curveType curve;
+    ucharType scalarBytes[MAX_FIELD_BYTES];
+    pointRecord base;
+    pointRecord product;
+    striType result;
+
+  /* eccMult */
+    logFunction(printf("eccMult(" FMT_D ", *, \"%s\")\n",
+                       curveNumber, striAsUnquotedCStri(point)););
+    curve = getCurve(curveNumber);
+    if (unlikely(curve == NULL)) {
+      result = NULL;
+    } else if (unlikely(scalar->size != curve->bytes ||
+                        memcpy_from_strelem(scalarBytes, scalar->mem,
+                                            scalar->size))) {
+      logError(printf("eccMult(" FMT_D ", *, *): "
+                      "The scalar must consist of %u bytes.\n",
+                      curveNumber, curve->bytes););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else if (point->size == 0) {
+      multBasePoint(&product, curve, scalarBytes);
+      result = encodePoint(&product, curve);
+    } else if (point->size == 1 && point->mem[0] == 0) {
+      setNeutral(&product, &curve->field);
+      result = encodePoint(&product, curve);
+    } else if (unlikely(!decodePoint(&base, curve, point))) {
+      logError(printf("eccMult(" FMT_D ", *, \"%s\"): "
+                      "The point is not on the curve.\n",
+                      curveNumber, striAsUnquotedCStri(point)););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else {
+      multPoint(&product, curve, &base, scalarBytes);
+      result = encodePoint(&product, curve);
+    } /* if */
+    logFunction(printf("eccMult --> \"%s\"\n",
+                       striAsUnquotedCStri(result)););
+    return result;
+  } /* eccMult */
+
+
+
+static void fieldSwap (limbType *a, limbType *b, limbType mask,
+    const_fieldType field)
+
+  {
+    limbType diff;
+    unsigned int idx;
+
+  /* fieldSwap */
+    for (idx = 0; idx < field->limbs; idx++) {
+      diff = (a[idx] ^ b[idx]) & mask;
+      a[idx] ^= diff;
+      b[idx] ^= diff;
+    } /* for */
+  } /* fieldSwap */
+
+
+
+/**
+ *  Compute the X25519 function of RFC 7748.
+ *  The Montgomery ladder needs constant time.
+ *  @param scalar Little-endian scalar with 32 bytes. The scalar
+ *         is clamped as described in RFC 7748.
+ *  @param uCoordinate Little-endian u-coordinate with 32 bytes.
+ *  @return the little-endian u-coordinate of the product (32 bytes).
+ *  @exception RANGE_ERROR If a parameter does not consist of 32 bytes.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+striType eccX25519 (const const_striType scalar,
+    const const_striType uCoordinate)
+
+  {
+    const_fieldType field;
+    ucharType k[X25519_BYTES];
+    ucharType bytes[X25519_BYTES];
+    fieldElement x1, x2, z2, x3, z3, a24;
+    fieldElement a, aa, b, bb, e, c, d, da, cb;
+    limbType swap = 0;
+    limbType bit;
+    int pos;
+    striType result;
+
+  /* eccX25519 */
+    logFunction(printf("eccX25519(*, \"%s\")\n",
+                       striAsUnquotedCStri(uCoordinate)););
+    if (!curve25519FieldInitialized) {
+      initField(&curve25519Field,
+                "7fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffed",
+                X25519_BYTES);
+      curve25519FieldInitialized = TRUE;
+    } /* if */
+    field = &curve25519Field;
+    if (unlikely(scalar->size != X25519_BYTES ||
+                 uCoordinate->size != X25519_BYTES ||
+                 memcpy_from_strelem(k, scalar->mem, X25519_BYTES) ||
+                 memcpy_from_strelem(bytes, uCoordinate->mem, X25519_BYTES))) {
+      logError(printf("eccX25519(*, \"%s\"): "
+                      "The parameters must consist of %d bytes.\n",
+                      striAsUnquotedCStri(uCoordinate), X25519_BYTES););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else {
+      k[0] &= 248;
+      k[31] &= 127;
+      k[31] |= 64;
+      /* Reverse to big-endian and ignore the most significant bit. */
+      for (pos = 0; pos < X25519_BYTES / 2; pos++) {
+        bit = bytes[pos];
+        bytes[pos] = bytes[X25519_BYTES - 1 - pos];
+        bytes[X25519_BYTES - 1 - pos] = (ucharType) bit;
+      } /* for */
+      bytes[0] &= 127;
+      bytesToLimbs(x1, field->limbs, bytes);
+      fieldMul(x1, x1, field->rSquared, field);
+      memset(a24, 0, sizeof(fieldElement));
+      a24[0] = 121665;
+      fieldMul(a24, a24, field->rSquared, field);
+      memcpy(x2, field->one, sizeof(fieldElement));
+      memset(z2, 0, sizeof(fieldElement));
+      memcpy(x3, x1, sizeof(fieldElement));
+      memcpy(z3, field->one, sizeof(fieldElement));
+      for (pos = 254; pos >= 0; pos--) {
+        bit = (k[pos / 8] >> (pos % 8)) & 1;
+        swap ^= bit;
+        fieldSwap(x2, x3, (limbType) 0 - swap, field);
+        fieldSwap(z2, z3, (limbType) 0 - swap, field);
+        swap = bit;
+        fieldAdd(a, x2, z2, field);
+        fieldMul(aa, a, a, field);
+        fieldSub(b, x2, z2, field);
+        fieldMul(bb, b, b, field);
+        fieldSub(e, aa, bb, field);
+        fieldAdd(c, x3, z3, field);
+        fieldSub(d, x3, z3, field);
+        fieldMul(da, d, a, field);
+        fieldMul(cb, c, b, field);
+        fieldAdd(x3, da, cb, field);
+        fieldMul(x3, x3, x3, field);
+        fieldSub(z3, da, cb, field);
+        fieldMul(z3, z3, z3, field);
+        fieldMul(z3, x1, z3, field);
+        fieldMul(x2, aa, bb, field);
+        fieldMul(z2, a24, e, field);
+        fieldAdd(z2, aa, z2, field);
+        fieldMul(z2, e, z2, field);
+      } /* for */
+      fieldSwap(x2, x3, (limbType) 0 - swap, field);
+      fieldSwap(z2, z3, (limbType) 0 - swap, field);
+      fieldInvert(z2, z2, field);
+      fieldMul(x2, x2, z2, field);
+      fieldToBytes(bytes, x2, field);
+      if (unlikely(!ALLOC_STRI_SIZE_OK(result, X25519_BYTES))) {
+        raise_error(MEMORY_ERROR);
+      } else {
+        result->size = X25519_BYTES;
+        for (pos = 0; pos < X25519_BYTES; pos++) {
+          result->mem[pos] = (strElemType) bytes[X25519_BYTES - 1 - pos];
+        } /* for */
+      } /* if */
+    } /* if */
+    logFunction(printf("eccX25519 --> \"%s\"\n",
+                       striAsUnquotedCStri(result)););
+    return result;
+  } /* eccX25519 */
@@ -0,0 +1,35 @@
+/********************************************************************/
+/*                                                                  */
+/*  ecc_rtl.h     Elliptic curve scalar multiplication.             */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/ecc_rtl.h                                       */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: Elliptic curve scalar multiplication.                  */
+/*                                                                  */
+/********************************************************************/
+
+striType eccMult (intType curveNumber, const const_striType scalar,
+                  const const_striType point);
+striType eccX25519 (const const_striType scalar,
+                    const const_striType uCoordinate);
@@ -0,0 +1,82 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Library                                                 */
+/*  File: seed7/src/ecclib.c                                        */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: All primitive actions for elliptic curves.             */
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+
+#include "common.h"
+#include "data.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "syvarutl.h"
+#include "objutl.h"
+#include "runerr.h"
+#include "ecc_rtl.h"
+
+#undef EXTERN
+#define EXTERN
+#include "ecclib.h"
+
+
+
+/**
+ *  Multiply the point arg_3 of the elliptic curve arg_1 with arg_2.
+ *  The curve number arg_1 is 1 for secp256r1 and 2 for secp384r1.
+ *  The big-endian scalar arg_2 has the size of a coordinate.
+ *  The point arg_3 is uncompressed, "\0;" for the neutral element
+ *  or "" for the base point.
+ *  @return the uncompressed product or "\0;" for the neutral element.
+ *  @exception RANGE_ERROR If arg_1 is not a known curve, if arg_2
+ *             has the wrong size or if arg_3 is not on the curve.
+ */
+objectType ecc_mult (listType arguments)
+
+  { /* ecc_mult */
+    isit_int(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    isit_stri(arg_3(arguments));
+    return bld_stri_temp(
+        eccMult(take_int(arg_1(arguments)), take_stri(arg_2(arguments)),
+                take_stri(arg_3(arguments))));
+  } /* ecc_mult */
+
+
+
+/**
+ *  Compute the X25519 function of RFC 7748.
+ *  The scalar arg_1 and the u-coordinate arg_2 are little-endian.
+ *  @return the little-endian u-coordinate of the product.
+ *  @exception RANGE_ERROR If arg_1 or arg_2 is not 32 bytes long.
+ */
+objectType ecc_x25519 (listType arguments)
+
+  { /* ecc_x25519 */
+    isit_stri(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    return bld_stri_temp(
+        eccX25519(take_stri(arg_1(arguments)), take_stri(arg_2(arguments))));
+  } /* ecc_x25519 */
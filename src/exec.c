@@ -486,6 +486,59 @@ static void show_arg_list (listType act_param_list)
 
 
 
+/**
+ *  Exchange the values of parameters, local variables and results
+ *  with the values saved in the binding frames.
+ *  The interpreter uses shallow binding: The objects of parameters
+ *  and local variables hold the values of the innermost call.
+ *  A coroutine, which is left, must unbind its frames innermost
+ *  first. A coroutine, which is entered, must rebind its frames
+ *  outermost first. Exchanging twice restores the original state.
+ */
+void exchangeBindings (bindingFrameType frame, boolType outermostFirst)
+
+  {
+    locListType form_param;
+    locListType loc_var;
+    listType backup;
+    objectType value;
+
+  /* exchangeBindings */
+    if (frame != NULL) {
+      if (outermostFirst) {
+        exchangeBindings(frame->outer, TRUE);
+      } /* if */
+      form_param = frame->block->params;
+      backup = frame->backup_form_params;
+      while (form_param != NULL) {
+        value = form_param->local.object->value.objValue;
+        form_param->local.object->value.objValue = backup->obj;
+        backup->obj = value;
+        form_param = form_param->next;
+        backup = backup->next;
+      } /* while */
+      loc_var = frame->block->local_vars;
+      backup = frame->backup_loc_var;
+      while (loc_var != NULL) {
+        value = loc_var->local.object->value.objValue;
+        loc_var->local.object->value.objValue = backup->obj;
+        backup->obj = value;
+        loc_var = loc_var->next;
+        backup = backup->next;
+      } /* while */
+      if (frame->block->result.object != NULL) {
+        value = frame->block->result.object->value.objValue;
+        frame->block->result.object->value.objValue = *frame->backup_block_result;
+        *frame->backup_block_result = value;
+      } /* if */
+      if (!outermostFirst) {
+        exchangeBindings(frame->outer, FALSE);
+      } /* if */
+    } /* if */
+  } /* exchangeBindings */
+
+
+
 static objectType exec_lambda (const_blockType block,
     listType actual_parameters, objectType object)
 
@@ -495,6 +548,7 @@ static objectType exec_lambda (const_blockType block,
     listType backup_form_params;
     objectType backup_block_result;
     listType backup_loc_var;
+    bindingFrameRecord binding_frame;
 
   /* exec_lambda */
     logFunction(printf("exec_lambda\n"););
@@ -511,7 +565,14 @@ static objectType exec_lambda (const_blockType block,
         result = fail_value;
       } else {
         if (res_init(&block->result, &backup_block_result)) {
+          binding_frame.block = block;
+          binding_frame.backup_form_params = backup_form_params;
+          binding_frame.backup_loc_var = backup_loc_var;
+          binding_frame.backup_block_result = &backup_block_result;
+          binding_frame.outer = curr_binding_frame;
+          curr_binding_frame = &binding_frame;
           result = exec_call(block->body);
+          curr_binding_frame = binding_frame.outer;
           if (fail_flag) {
             errInfoType ignored_err_info;
 
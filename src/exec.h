@@ -32,8 +32,25 @@ EXTERN volatile boolType interrupt_flag;
 #endif
 EXTERN volatile int signal_number;
 
+/* Bindings of the currently executed functions. Coroutines use it */
+/* to exchange the values of parameters and local variables.       */
+typedef struct bindingFrameStruct {
+    const_blockType block;
+    listType backup_form_params;
+    listType backup_loc_var;
+    objectType *backup_block_result;
+    struct bindingFrameStruct *outer;
+  } bindingFrameRecord, *bindingFrameType;
+
+#ifdef DO_INIT
+bindingFrameType curr_binding_frame = NULL;
+#else
+EXTERN bindingFrameType curr_binding_frame;
+#endif
+
 
 void doSuspendInterpreter (int signalNum);
+void exchangeBindings (bindingFrameType frame, boolType outermostFirst);
 objectType exec_object (register objectType object);
 objectType exec_call (objectType object);
 objectType do_exec_call (objectType object, errInfoType *err_info);
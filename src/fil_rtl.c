@@ -45,6 +45,9 @@
 #if UNISTD_H_PRESENT
 #include "unistd.h"
 #endif
+#if HAS_MMAP
+#include "sys/mman.h"
+#endif
 #if defined ISATTY_INCLUDE_IO_H || defined FTRUNCATE_INCLUDE_IO_H || defined LSEEK_INCLUDE_IO_H
 #include "io.h"
 #endif
@@ -99,7 +102,8 @@ extern int _chsize (int fd, long size);
 #define BUFFER_SIZE             4096
 #define GETS_DEFAULT_SIZE    1048576
 #define READ_STRI_INIT_SIZE      256
-#define READ_STRI_SIZE_DELTA    2048
+#define MAP_WILLNEED_SIZE      65536
+#define MAP_ADVICE_ALIGNMENT   65536
 
 
 
@@ -701,6 +705,461 @@ static striType read_and_alloc_stri (cFileType inFile, memSizeType chars_missing
 
 
 
+/**
+ *  Enlarge a string that receives the characters of a read function.
+ *  The capacity is doubled, but at least 'minLength' is reserved.
+ *  Doubling keeps the number of reallocations logarithmic.
+ *  If the reallocation fails 'stri' is freed.
+ *  @param memlength Address of the capacity of 'stri'. It is
+ *         updated to the new capacity.
+ *  @return the resized string or NULL if there is not enough memory.
+ */
+static striType growReadStri (const striType stri, memSizeType *memlength,
+    const memSizeType minLength)
+
+  {
+    memSizeType newmemlength;
+    striType resized_stri;
+
+  /* growReadStri */
+    if (*memlength > MAX_STRI_LEN / 2) {
+      newmemlength = MAX_STRI_LEN;
+    } else {
+      newmemlength = 2 * *memlength;
+    } /* if */
+    if (newmemlength < minLength) {
+      newmemlength = minLength;
+    } /* if */
+    REALLOC_STRI_CHECK_SIZE2(resized_stri, stri, *memlength, newmemlength);
+    if (unlikely(resized_stri == NULL)) {
+      FREE_STRI2(stri, *memlength);
+    } else {
+      *memlength = newmemlength;
+    } /* if */
+    return resized_stri;
+  } /* growReadStri */
+
+
+
+#ifdef read_buffer_skip
+/**
+ *  Append 'length' bytes from the read buffer of a file to a string.
+ *  @return TRUE if the bytes have been appended, or
+ *          FALSE if there is not enough memory (*stri is freed and
+ *          set to NULL).
+ */
+static boolType appendBytesToReadStri (striType *stri, memSizeType *memlength,
+    memSizeType *position, const unsigned char *bytes, const memSizeType length)
+
+  { /* appendBytesToReadStri */
+    if (length > *memlength - *position) {
+      *stri = growReadStri(*stri, memlength, *position + length);
+      if (unlikely(*stri == NULL)) {
+        return FALSE;
+      } /* if */
+    } /* if */
+    memcpy_to_strelem(&(*stri)->mem[*position], bytes, length);
+    *position += length;
+    return TRUE;
+  } /* appendBytesToReadStri */
+
+
+
+/**
+ *  Read from 'inFile' until 'terminator' or EOF is found.
+ *  The read buffer of 'inFile' is searched with memchr() and the
+ *  bytes in front of the 'terminator' are widened at once. The
+ *  buffer is refilled with getc_unlocked(). A 'terminator' is
+ *  consumed but not stored. The caller must lock 'inFile'.
+ *  @param terminator Byte that terminates the read or EOF, if
+ *         only the end of the file terminates the read.
+ *  @param stri Address of the string that receives the bytes.
+ *         If there is not enough memory *stri is freed and set
+ *         to NULL.
+ *  @param memlength Address of the capacity of *stri.
+ *  @param position Address of the number of characters in *stri.
+ *  @return 'terminator' or EOF.
+ */
+static int readTerminatedFromBuffer (cFileType inFile, const int terminator,
+    striType *stri, memSizeType *memlength, memSizeType *position)
+
+  {
+    memSizeType available;
+    memSizeType length;
+    const unsigned char *buffer;
+    const unsigned char *found;
+    unsigned char byte;
+    boolType searching = TRUE;
+    int ch = EOF;
+
+  /* readTerminatedFromBuffer */
+    do {
+      available = read_buffer_avail(inFile);
+      if (available == 0) {
+        /* The buffer is empty: getc_unlocked() refills it. */
+        ch = getc_unlocked(inFile);
+        if (ch == terminator || ch == EOF) {
+          searching = FALSE;
+        } else {
+          byte = (unsigned char) ch;
+          if (unlikely(!appendBytesToReadStri(stri, memlength, position,
+                                              &byte, 1))) {
+            return EOF;
+          } /* if */
+        } /* if */
+      } else {
+        buffer = read_buffer_ptr(inFile);
+        if (terminator == EOF) {
+          found = NULL;
+        } else {
+          found = (const unsigned char *) memchr(buffer, terminator, available);
+        } /* if */
+        if (found == NULL) {
+          length = available;
+        } else {
+          length = (memSizeType) (found - buffer);
+          ch = terminator;
+          searching = FALSE;
+        } /* if */
+        if (unlikely(!appendBytesToReadStri(stri, memlength, position,
+                                            buffer, length))) {
+          return EOF;
+        } /* if */
+        read_buffer_skip(inFile, found == NULL ? length : length + 1);
+      } /* if */
+    } while (searching);
+    return ch;
+  } /* readTerminatedFromBuffer */
+
+
+
+/**
+ *  Read from 'inFile' until ' ', '\t', '\n' or EOF is found.
+ *  The read buffer of 'inFile' is scanned directly and the bytes
+ *  of the word are widened at once. The buffer is refilled with
+ *  getc_unlocked(). The terminating character is consumed but not
+ *  stored. The caller must lock 'inFile'.
+ *  @param stri Address of the string that receives the bytes.
+ *         If there is not enough memory *stri is freed and set
+ *         to NULL.
+ *  @param memlength Address of the capacity of *stri.
+ *  @param position Address of the number of characters in *stri.
+ *  @return ' ', '\t', '\n' or EOF.
+ */
+static int readWordFromBuffer (cFileType inFile, striType *stri,
+    memSizeType *memlength, memSizeType *position)
+
+  {
+    memSizeType available;
+    memSizeType length;
+    const unsigned char *buffer;
+    unsigned char byte;
+    boolType searching = TRUE;
+    int ch = EOF;
+
+  /* readWordFromBuffer */
+    do {
+      available = read_buffer_avail(inFile);
+      if (available == 0) {
+        /* The buffer is empty: getc_unlocked() refills it. */
+        ch = getc_unlocked(inFile);
+        if (ch == ' ' || ch == '\t' || ch == '\n' || ch == EOF) {
+          searching = FALSE;
+        } else {
+          byte = (unsigned char) ch;
+          if (unlikely(!appendBytesToReadStri(stri, memlength, position,
+                                              &byte, 1))) {
+            return EOF;
+          } /* if */
+        } /* if */
+      } else {
+        buffer = read_buffer_ptr(inFile);
+        length = 0;
+        while (length < available && buffer[length] != ' ' &&
+               buffer[length] != '\t' && buffer[length] != '\n') {
+          length++;
+        } /* while */
+        if (unlikely(!appendBytesToReadStri(stri, memlength, position,
+                                            buffer, length))) {
+          return EOF;
+        } /* if */
+        if (length < available) {
+          ch = buffer[length];
+          searching = FALSE;
+          read_buffer_skip(inFile, length + 1);
+        } else {
+          read_buffer_skip(inFile, length);
+        } /* if */
+      } /* if */
+    } while (searching);
+    return ch;
+  } /* readWordFromBuffer */
+
+/**
+ *  Determine the initial capacity of a string read up to 'terminator'.
+ *  If 'terminator' is found in the read buffer of 'inFile' the exact
+ *  length is returned. In this case no reallocation is necessary.
+ *  The caller must lock 'inFile'.
+ *  @param terminator Byte that terminates the read or EOF.
+ *  @return the initial capacity for the string.
+ */
+static memSizeType readStriInitSize (cFileType inFile, const int terminator)
+
+  {
+    memSizeType available;
+    const unsigned char *buffer;
+    const unsigned char *found;
+    memSizeType initSize = READ_STRI_INIT_SIZE;
+
+  /* readStriInitSize */
+    available = read_buffer_avail(inFile);
+    if (available != 0 && terminator != EOF) {
+      buffer = read_buffer_ptr(inFile);
+      found = (const unsigned char *) memchr(buffer, terminator, available);
+      if (found != NULL) {
+        initSize = (memSizeType) (found - buffer);
+      } /* if */
+    } /* if */
+    return initSize;
+  } /* readStriInitSize */
+
+
+
+/**
+ *  Determine the initial capacity of a word that starts with a
+ *  character that has already been read. If a ' ', '\t' or '\n'
+ *  is found in the read buffer of 'inFile' the exact length is
+ *  returned. The caller must lock 'inFile'.
+ *  @return the initial capacity for the word.
+ */
+static memSizeType wordStriInitSize (cFileType inFile)
+
+  {
+    memSizeType available;
+    const unsigned char *buffer;
+    memSizeType length = 0;
+
+  /* wordStriInitSize */
+    available = read_buffer_avail(inFile);
+    buffer = read_buffer_ptr(inFile);
+    while (length < available && buffer[length] != ' ' &&
+           buffer[length] != '\t' && buffer[length] != '\n') {
+      length++;
+    } /* while */
+    if (length < available) {
+      return length + 1;
+    } else {
+      return READ_STRI_INIT_SIZE;
+    } /* if */
+  } /* wordStriInitSize */
+#endif
+
+
+
+/**
+ *  Create a string from the bytes of a memory mapped file.
+ *  @return the string or NULL if there is not enough memory.
+ */
+static striType mapBytesToStri (const const_ustriType bytes,
+    const memSizeType length)
+
+  {
+    striType result;
+
+  /* mapBytesToStri */
+    if (likely(ALLOC_STRI_CHECK_SIZE(result, length))) {
+      result->size = length;
+      memcpy_to_strelem(result->mem, bytes, length);
+    } /* if */
+    return result;
+  } /* mapBytesToStri */
+
+
+
+/**
+ *  Read a string with a maximum length from a memory mapped file.
+ *  When random access has been detected the pages of a large read
+ *  are requested at once, since the kernel does no read ahead.
+ *  @return the string read.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+static striType mapGets (fileType inFile, memSizeType chars_requested)
+
+  {
+    memSizeType available = 0;
+    striType result;
+
+  /* mapGets */
+    if (inFile->mapPosition < inFile->mapLength) {
+      available = inFile->mapLength - inFile->mapPosition;
+    } /* if */
+    if (chars_requested > available) {
+      chars_requested = available;
+      inFile->mapEof = TRUE;
+    } /* if */
+#if HAS_POSIX_MADVISE
+    if (inFile->mapRandom && chars_requested >= MAP_WILLNEED_SIZE) {
+      memSizeType start = inFile->mapPosition &
+                          ~(memSizeType) (MAP_ADVICE_ALIGNMENT - 1);
+
+      posix_madvise((void *) &inFile->mapStart[start],
+                    inFile->mapPosition - start + chars_requested,
+                    POSIX_MADV_WILLNEED);
+    } /* if */
+#endif
+    result = mapBytesToStri(&inFile->mapStart[inFile->mapPosition],
+                            chars_requested);
+    if (unlikely(result == NULL)) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      inFile->mapPosition += chars_requested;
+    } /* if */
+    return result;
+  } /* mapGets */
+
+
+
+/**
+ *  Read from a memory mapped file until 'terminator' or EOF is found.
+ *  The 'terminator' is consumed but not stored. If 'stripCr' is TRUE
+ *  a "\r" in front of the 'terminator' is removed.
+ *  @param terminator Byte that terminates the read or EOF.
+ *  @return the string read.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+static striType mapTerminatedRead (fileType inFile, const int terminator,
+    const boolType stripCr, charType *terminationChar)
+
+  {
+    memSizeType available = 0;
+    const_ustriType bytes;
+    const_ustriType found = NULL;
+    memSizeType length;
+    memSizeType consumed;
+    striType result;
+
+  /* mapTerminatedRead */
+    if (inFile->mapPosition < inFile->mapLength) {
+      available = inFile->mapLength - inFile->mapPosition;
+    } /* if */
+    bytes = &inFile->mapStart[inFile->mapPosition];
+    if (terminator != EOF && available != 0) {
+      found = (const_ustriType) memchr(bytes, terminator, available);
+    } /* if */
+    if (found != NULL) {
+      length = (memSizeType) (found - bytes);
+      consumed = length + 1;
+      if (stripCr && length != 0 && bytes[length - 1] == '\r') {
+        length--;
+      } /* if */
+    } else {
+      length = available;
+      consumed = available;
+    } /* if */
+    result = mapBytesToStri(bytes, length);
+    if (unlikely(result == NULL)) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      inFile->mapPosition += consumed;
+      if (found != NULL) {
+        *terminationChar = (charType) terminator;
+      } else {
+        inFile->mapEof = TRUE;
+        *terminationChar = (charType) EOF;
+      } /* if */
+    } /* if */
+    return result;
+  } /* mapTerminatedRead */
+
+
+
+/**
+ *  Read a word from a memory mapped file.
+ *  Leading spaces and tabs are skipped. The word ends with ' ',
+ *  '\t', '\n', "\r\n" or EOF. The word ending characters are
+ *  consumed but not stored.
+ *  @return the word read.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+static striType mapWordRead (fileType inFile, charType *terminationChar)
+
+  {
+    const_ustriType bytes;
+    memSizeType position;
+    memSizeType start;
+    memSizeType length;
+    int ch = EOF;
+    striType result;
+
+  /* mapWordRead */
+    bytes = inFile->mapStart;
+    position = inFile->mapPosition;
+    while (position < inFile->mapLength &&
+           (bytes[position] == ' ' || bytes[position] == '\t')) {
+      position++;
+    } /* while */
+    start = position;
+    while (position < inFile->mapLength && bytes[position] != ' ' &&
+           bytes[position] != '\t' && bytes[position] != '\n') {
+      position++;
+    } /* while */
+    length = position - start;
+    if (position < inFile->mapLength) {
+      ch = bytes[position];
+      if (ch == '\n' && length != 0 && bytes[position - 1] == '\r') {
+        length--;
+      } /* if */
+    } /* if */
+    result = mapBytesToStri(&bytes[start], length);
+    if (unlikely(result == NULL)) {
+      raise_error(MEMORY_ERROR);
+    } else if (ch == EOF) {
+      inFile->mapPosition = position;
+      inFile->mapEof = TRUE;
+      *terminationChar = (charType) EOF;
+    } else {
+      inFile->mapPosition = position + 1;
+      *terminationChar = (charType) ch;
+    } /* if */
+    return result;
+  } /* mapWordRead */
+
+
+
+/**
+ *  Set the current position of a memory mapped file.
+ *  A backward seek indicates random access. In this case the
+ *  kernel is told to stop the read ahead for the mapping.
+ *  @param position Position measured in bytes from the start of
+ *         the file. The first byte in the file has the position 0.
+ */
+static void mapSeek (fileType aFile, const memSizeType position)
+
+  { /* mapSeek */
+    if (position < aFile->mapPosition && !aFile->mapRandom) {
+#if HAS_POSIX_MADVISE
+      posix_madvise((void *) aFile->mapStart, aFile->mapLength,
+                    POSIX_MADV_RANDOM);
+#endif
+      aFile->mapRandom = TRUE;
+    } /* if */
+    aFile->mapPosition = position;
+    aFile->mapEof = FALSE;
+  } /* mapSeek */
+
+
+
+#if HAS_MMAP
+static void unmapFile (fileType aFile)
+
+  { /* unmapFile */
+    munmap((void *) aFile->mapStart, aFile->mapLength);
+    aFile->mapStart = NULL;
+  } /* unmapFile */
+#endif
+
+
+
 #if !HAS_SIGACTION && !HAS_SIGNAL
 /**
  *  Read a character from 'inFile' and check if ctrl-c is pressed.
@@ -921,6 +1380,8 @@ bigIntType filBigLng (fileType aFile)
       logError(printf("filBigLng: Attempt to get the length of a closed file.\n"););
       raise_error(FILE_ERROR);
       length = NULL;
+    } else if (aFile->mapStart != NULL) {
+      length = bigFromUInt64((uint64Type) aFile->mapLength);
     } else {
       /* os_fstat() is not used, because when writing to a */
       /* file the stat data is only updated after a flush. */
@@ -970,6 +1431,12 @@ void filBigSeek (fileType aFile, const const_bigIntType position)
                         safe_fileno(cFile), file_position, file_position == 0 ?
                             " or conversion from bigInteger failed" : ""););
         raise_error(RANGE_ERROR);
+      } else if (aFile->mapStart != NULL) {
+        if ((uint64Type) (file_position - 1) > MAX_MEMSIZETYPE) {
+          mapSeek(aFile, MAX_MEMSIZETYPE);
+        } else {
+          mapSeek(aFile, (memSizeType) (file_position - 1));
+        } /* if */
       } else if (unlikely(offsetSeek(cFile, file_position - 1, SEEK_SET) != 0)) {
         logError(printf("filBigSeek(%d, %s): "
                         "offsetSeek(%d, " FMT_D64 ", SEEK_SET) failed.\n",
@@ -1007,6 +1474,8 @@ bigIntType filBigTell (fileType aFile)
       logError(printf("filBigTell: Attempt to get the current position of a closed file.\n"););
       raise_error(FILE_ERROR);
       position = NULL;
+    } else if (aFile->mapStart != NULL) {
+      position = bigFromUInt64((uint64Type) aFile->mapPosition + 1);
     } else {
       current_file_position = offsetTell(cFile);
       if (unlikely(current_file_position < (os_off_t) 0)) {
@@ -1048,6 +1517,11 @@ void filClose (fileType aFile)
       logError(printf("filClose: Called with a closed file.\n"););
       raise_error(FILE_ERROR);
     } else {
+#if HAS_MMAP
+      if (aFile->mapStart != NULL) {
+        unmapFile(aFile);
+      } /* if */
+#endif
 #if FCLOSE_FAILS_AFTER_PREVIOUS_ERROR
       clearerr(aFile->cFile);
 #endif
@@ -1227,6 +1701,8 @@ boolType filEof (fileType inFile)
       logError(printf("filEof: Attempt to test a closed file.\n"););
       raise_error(FILE_ERROR);
       eofIndicator = FALSE;
+    } else if (inFile->mapStart != NULL) {
+      eofIndicator = inFile->mapEof;
     } else {
       eofIndicator = feof(cInFile) != 0;
     } /* if */
@@ -1306,6 +1782,11 @@ void filFree (fileType oldFile)
                        oldFile != NULL ? safe_fileno(oldFile->cFile) : 0,
                        oldFile != NULL ? oldFile->usage_count : (uintType) 0););
     if (oldFile->cFile != NULL) {
+#if HAS_MMAP
+      if (oldFile->mapStart != NULL) {
+        unmapFile(oldFile);
+      } /* if */
+#endif
       fclose(oldFile->cFile);
     } /* if */
     FREE_RECORD(oldFile, fileRecord, count.files);
@@ -1335,6 +1816,14 @@ charType filGetcChkCtrlC (fileType inFile)
       logError(printf("filGetcChkCtrlC: Attempt to read from closed file.\n"););
       raise_error(FILE_ERROR);
       result = 0;
+    } else if (inFile->mapStart != NULL) {
+      if (inFile->mapPosition < inFile->mapLength) {
+        result = inFile->mapStart[inFile->mapPosition];
+        inFile->mapPosition++;
+      } else {
+        inFile->mapEof = TRUE;
+        result = (charType) EOF;
+      } /* if */
     } else {
       file_no = os_fileno(cInFile);
       if (file_no != -1 && os_isatty(file_no)) {
@@ -1407,6 +1896,12 @@ striType filGets (fileType inFile, intType length)
         } /* if */
         result = (striType) emptyStri;
       } /* if */
+    } else if (inFile->mapStart != NULL) {
+      if ((uintType) length > MAX_MEMSIZETYPE) {
+        result = mapGets(inFile, MAX_MEMSIZETYPE);
+      } else {
+        result = mapGets(inFile, (memSizeType) length);
+      } /* if */
 #if FREAD_WRONG_FOR_WRITE_ONLY_FILES
     } else if (unlikely(!inFile->readingAllowed)) {
       logError(printf("filGets(%d, " FMT_D "): "
@@ -1555,6 +2050,8 @@ boolType filHasNext (fileType inFile)
       logError(printf("filHasNext: Attempt to test a closed file.\n"););
       raise_error(FILE_ERROR);
       hasNext = FALSE;
+    } else if (inFile->mapStart != NULL) {
+      hasNext = inFile->mapPosition < inFile->mapLength;
     } else if (feof(cInFile)) {
       hasNext = FALSE;
     } else {
@@ -1599,6 +2096,8 @@ boolType filHasNextChkCtrlC (fileType inFile)
       logError(printf("filHasNextChkCtrlC: Attempt to test a closed file.\n"););
       raise_error(FILE_ERROR);
       hasNext = FALSE;
+    } else if (inFile->mapStart != NULL) {
+      hasNext = inFile->mapPosition < inFile->mapLength;
     } else if (feof(cInFile)) {
       hasNext = FALSE;
     } else {
@@ -1646,10 +2145,9 @@ striType filLineRead (fileType inFile, charType *terminationChar)
   {
     cFileType cInFile;
     register int ch;
-    register memSizeType position;
+    memSizeType position;
     strElemType *memory;
     memSizeType memlength;
-    memSizeType newmemlength;
     striType resized_result;
     striType result;
 
@@ -1664,6 +2162,8 @@ striType filLineRead (fileType inFile, charType *terminationChar)
       logError(printf("filLineRead: Attempt to read from closed file.\n"););
       raise_error(FILE_ERROR);
       result = NULL;
+    } else if (inFile->mapStart != NULL) {
+      result = mapTerminatedRead(inFile, '\n', TRUE, terminationChar);
 #if FREAD_WRONG_FOR_WRITE_ONLY_FILES
     } else if (unlikely(!inFile->readingAllowed)) {
       logError(printf("filLineRead(%d, *): "
@@ -1673,29 +2173,40 @@ striType filLineRead (fileType inFile, charType *terminationChar)
       result = NULL;
 #endif
     } else {
+      flockfile(cInFile);
+#ifdef read_buffer_skip
+      memlength = readStriInitSize(cInFile, '\n');
+#else
       memlength = READ_STRI_INIT_SIZE;
+#endif
       if (unlikely(!ALLOC_STRI_SIZE_OK(result, memlength))) {
+        funlockfile(cInFile);
         raise_error(MEMORY_ERROR);
       } else {
         memory = result->mem;
         position = 0;
-        flockfile(cInFile);
+#ifdef read_buffer_skip
+        ch = readTerminatedFromBuffer(cInFile, '\n', &result, &memlength, &position);
+        if (unlikely(result == NULL)) {
+          funlockfile(cInFile);
+          raise_error(MEMORY_ERROR);
+          return NULL;
+        } /* if */
+        memory = result->mem;
+#else
         while ((ch = getc_unlocked(cInFile)) != '\n' && ch != EOF) {
           if (position >= memlength) {
-            newmemlength = memlength + READ_STRI_SIZE_DELTA;
-            REALLOC_STRI_CHECK_SIZE2(resized_result, result, memlength, newmemlength);
-            if (unlikely(resized_result == NULL)) {
-              FREE_STRI2(result, memlength);
+            result = growReadStri(result, &memlength, position + 1);
+            if (unlikely(result == NULL)) {
               funlockfile(cInFile);
               raise_error(MEMORY_ERROR);
               return NULL;
             } /* if */
-            result = resized_result;
             memory = result->mem;
-            memlength = newmemlength;
           } /* if */
           memory[position++] = (strElemType) ch;
         } /* while */
+#endif
         funlockfile(cInFile);
         if (ch == '\n' && position != 0 && memory[position - 1] == '\r') {
           position--;
@@ -1710,7 +2221,11 @@ striType filLineRead (fileType inFile, charType *terminationChar)
           raise_error(FILE_ERROR);
           result = NULL;
         } else {
-          REALLOC_STRI_SIZE_SMALLER2(resized_result, result, memlength, position);
+          if (position < memlength) {
+            REALLOC_STRI_SIZE_SMALLER2(resized_result, result, memlength, position);
+          } else {
+            resized_result = result;
+          } /* if */
           if (unlikely(resized_result == NULL)) {
             FREE_STRI2(result, memlength);
             raise_error(MEMORY_ERROR);
@@ -1819,6 +2334,8 @@ intType filLng (fileType aFile)
       logError(printf("filLng: Attempt to get the length of a closed file.\n"););
       raise_error(FILE_ERROR);
       length = 0;
+    } else if (aFile->mapStart != NULL) {
+      length = (intType) aFile->mapLength;
     } else {
       /* os_fstat() is not used, because when writing to a */
       /* file the stat data is only updated after a flush. */
@@ -2031,6 +2548,92 @@ fileType filOpen (const const_striType path, const const_striType mode)
 
 
 
+/**
+ *  Opens a file with the specified 'path' for reading via memory mapping.
+ *  The functions filGetc, filGets, filLineRead, filWordRead,
+ *  filTerminatedRead, filSeek, filTell and filLng work directly on the
+ *  mapping. The kernel is advised to read ahead sequentially. After a
+ *  backward seek it is advised to expect random access. The file is
+ *  opened in binary mode. If the file cannot be mapped (e.g. because
+ *  it is empty, not a regular file or too large for the address space)
+ *  the file is read via the C library, like a file opened with mode "r".
+ *  @param path Path of the file to be opened. The path must
+ *         use the standard path representation.
+ *  @return the file opened, or CLIB_NULL_FILE if it could not be opened or
+ *          if 'path' refers to a directory.
+ *  @exception MEMORY_ERROR Not enough memory to convert the path
+ *             to the system path type.
+ *  @exception RANGE_ERROR 'path' does not use the standard path
+ *             representation or 'path' cannot be converted
+ *             to the system path type.
+ */
+fileType filOpenMapped (const const_striType path)
+
+  {
+    cFileType cFile;
+#if HAS_MMAP
+    int file_no;
+    os_fstat_struct stat_buf;
+    memSizeType file_length;
+    ustriType file_content;
+#endif
+    errInfoType err_info = OKAY_NO_ERROR;
+    fileType fileOpened;
+
+  /* filOpenMapped */
+    logFunction(printf("filOpenMapped(\"%s\")\n", striAsUnquotedCStri(path)););
+    cFile = cFileOpen(path, os_mode_rb, &err_info);
+    if (unlikely(cFile == NULL)) {
+      if (unlikely(err_info != OKAY_NO_ERROR)) {
+        raise_error(err_info);
+        fileOpened = NULL;
+      } else {
+        fileOpened = &nullFileRecord;
+      } /* if */
+    } else if (unlikely(!ALLOC_RECORD(fileOpened, fileRecord, count.files))) {
+      fclose(cFile);
+      raise_error(MEMORY_ERROR);
+    } else {
+      initFileType(fileOpened, TRUE, FALSE);
+      fileOpened->cFile = cFile;
+#if HAS_MMAP
+      file_no = os_fileno(cFile);
+      if (file_no != -1 && os_fstat(file_no, &stat_buf) == 0 &&
+          S_ISREG(stat_buf.st_mode) && stat_buf.st_size > 0 &&
+          (unsigned_os_off_t) stat_buf.st_size < MAX_MEMSIZETYPE) {
+        file_length = (memSizeType) stat_buf.st_size;
+        file_content = (ustriType) mmap(NULL, file_length, PROT_READ,
+                                        MAP_PRIVATE, file_no, 0);
+        if (file_content != (ustriType) -1) {
+#if HAS_POSIX_MADVISE
+          posix_madvise(file_content, file_length, POSIX_MADV_SEQUENTIAL);
+#endif
+          fileOpened->mapStart = file_content;
+          fileOpened->mapLength = file_length;
+          fileOpened->mapPosition = 0;
+          fileOpened->mapEof = FALSE;
+          fileOpened->mapRandom = FALSE;
+        } else {
+          logError(printf("filOpenMapped(\"%s\"): "
+                          "mmap(NULL, " FMT_U_MEM ", PROT_READ, MAP_PRIVATE, %d, 0) "
+                          "failed:\nerrno=%d\nerror: %s\n",
+                          striAsUnquotedCStri(path), file_length, file_no,
+                          errno, strerror(errno)););
+        } /* if */
+      } /* if */
+#endif
+    } /* if */
+    logFunction(printf("filOpenMapped(\"%s\") --> " FMT_U_MEM " %s%d (usage=" FMT_U ")\n",
+                       striAsUnquotedCStri(path),
+                       (memSizeType) fileOpened,
+                       fileOpened == NULL ? "NULL " : "",
+                       fileOpened != NULL ? safe_fileno(fileOpened->cFile) : 0,
+                       fileOpened != NULL ? fileOpened->usage_count : (uintType) 0););
+    return fileOpened;
+  } /* filOpenMapped */
+
+
+
 /**
  *  Open the null device of the operation system for reading and writing.
  *  @return the null device opened, or CLIB_NULL_FILE if it could not be opened.
@@ -2255,6 +2858,12 @@ void filSeek (fileType aFile, intType position)
       logError(printf("filSeek(%d, " FMT_D "): Position <= 0.\n",
                       safe_fileno(cFile), position););
       raise_error(RANGE_ERROR);
+    } else if (aFile->mapStart != NULL) {
+      if ((uintType) (position - 1) > MAX_MEMSIZETYPE) {
+        mapSeek(aFile, MAX_MEMSIZETYPE);
+      } else {
+        mapSeek(aFile, (memSizeType) (position - 1));
+      } /* if */
 #if OS_OFF_T_SIZE < INTTYPE_SIZE
 #if OS_OFF_T_SIZE == 32
     } else if (unlikely(position > INT32TYPE_MAX)) {
@@ -2394,6 +3003,8 @@ intType filTell (fileType aFile)
       logError(printf("filTell: Attempt to get the current position of a closed file.\n"););
       raise_error(FILE_ERROR);
       position = 0;
+    } else if (aFile->mapStart != NULL) {
+      position = (intType) aFile->mapPosition + 1;
     } else {
       current_file_position = offsetTell(cFile);
       if (unlikely(current_file_position < (os_off_t) 0)) {
@@ -2442,10 +3053,8 @@ striType filTerminatedRead (fileType inFile, charType terminator,
     cFileType cInFile;
     register int termCh;
     register int ch;
-    register memSizeType position;
-    strElemType *memory;
+    memSizeType position;
     memSizeType memlength;
-    memSizeType newmemlength;
     striType resized_result;
     striType result;
 
@@ -2464,6 +3073,8 @@ striType filTerminatedRead (fileType inFile, charType terminator,
       logError(printf("filTerminatedRead: Attempt to read from closed file.\n"););
       raise_error(FILE_ERROR);
       result = NULL;
+    } else if (inFile->mapStart != NULL) {
+      result = mapTerminatedRead(inFile, termCh, FALSE, terminationChar);
 #if FREAD_WRONG_FOR_WRITE_ONLY_FILES
     } else if (unlikely(!inFile->readingAllowed)) {
       logError(printf("filTerminatedRead(%d, '\\" FMT_U32 ";', *): "
@@ -2473,29 +3084,37 @@ striType filTerminatedRead (fileType inFile, charType terminator,
       result = NULL;
 #endif
     } else {
+      flockfile(cInFile);
+#ifdef read_buffer_skip
+      memlength = readStriInitSize(cInFile, termCh);
+#else
       memlength = READ_STRI_INIT_SIZE;
+#endif
       if (unlikely(!ALLOC_STRI_SIZE_OK(result, memlength))) {
+        funlockfile(cInFile);
         raise_error(MEMORY_ERROR);
       } else {
-        memory = result->mem;
         position = 0;
-        flockfile(cInFile);
+#ifdef read_buffer_skip
+        ch = readTerminatedFromBuffer(cInFile, termCh, &result, &memlength, &position);
+        if (unlikely(result == NULL)) {
+          funlockfile(cInFile);
+          raise_error(MEMORY_ERROR);
+          return NULL;
+        } /* if */
+#else
         while ((ch = getc_unlocked(cInFile)) != termCh && ch != EOF) {
           if (position >= memlength) {
-            newmemlength = memlength + READ_STRI_SIZE_DELTA;
-            REALLOC_STRI_CHECK_SIZE2(resized_result, result, memlength, newmemlength);
-            if (unlikely(resized_result == NULL)) {
-              FREE_STRI2(result, memlength);
+            result = growReadStri(result, &memlength, position + 1);
+            if (unlikely(result == NULL)) {
               funlockfile(cInFile);
               raise_error(MEMORY_ERROR);
               return NULL;
             } /* if */
-            result = resized_result;
-            memory = result->mem;
-            memlength = newmemlength;
           } /* if */
-          memory[position++] = (strElemType) ch;
+          result->mem[position++] = (strElemType) ch;
         } /* while */
+#endif
         funlockfile(cInFile);
         if (unlikely(ch == EOF && position == 0 && ferror(cInFile))) {
           FREE_STRI2(result, memlength);
@@ -2507,7 +3126,11 @@ striType filTerminatedRead (fileType inFile, charType terminator,
           raise_error(FILE_ERROR);
           result = NULL;
         } else {
-          REALLOC_STRI_SIZE_SMALLER2(resized_result, result, memlength, position);
+          if (position < memlength) {
+            REALLOC_STRI_SIZE_SMALLER2(resized_result, result, memlength, position);
+          } else {
+            resized_result = result;
+          } /* if */
           if (unlikely(resized_result == NULL)) {
             FREE_STRI2(result, memlength);
             raise_error(MEMORY_ERROR);
@@ -2625,10 +3248,9 @@ striType filWordRead (fileType inFile, charType *terminationChar)
   {
     cFileType cInFile;
     register int ch;
-    register memSizeType position;
+    memSizeType position;
     strElemType *memory;
     memSizeType memlength;
-    memSizeType newmemlength;
     striType resized_result;
     striType result;
 
@@ -2643,6 +3265,8 @@ striType filWordRead (fileType inFile, charType *terminationChar)
       logError(printf("filWordRead: Attempt to read from closed file.\n"););
       raise_error(FILE_ERROR);
       result = NULL;
+    } else if (inFile->mapStart != NULL) {
+      result = mapWordRead(inFile, terminationChar);
 #if FREAD_WRONG_FOR_WRITE_ONLY_FILES
     } else if (unlikely(!inFile->readingAllowed)) {
       logError(printf("filWordRead(%d, *): "
@@ -2652,34 +3276,48 @@ striType filWordRead (fileType inFile, charType *terminationChar)
       result = NULL;
 #endif
     } else {
+      flockfile(cInFile);
+      do {
+        ch = getc_unlocked(cInFile);
+      } while (ch == ' ' || ch == '\t');
+#ifdef read_buffer_skip
+      memlength = wordStriInitSize(cInFile);
+#else
       memlength = READ_STRI_INIT_SIZE;
+#endif
       if (unlikely(!ALLOC_STRI_SIZE_OK(result, memlength))) {
+        funlockfile(cInFile);
         raise_error(MEMORY_ERROR);
       } else {
         memory = result->mem;
         position = 0;
-        flockfile(cInFile);
-        do {
-          ch = getc_unlocked(cInFile);
-        } while (ch == ' ' || ch == '\t');
+#ifdef read_buffer_skip
+        if (ch != ' ' && ch != '\t' && ch != '\n' && ch != EOF) {
+          memory[position++] = (strElemType) ch;
+          ch = readWordFromBuffer(cInFile, &result, &memlength, &position);
+          if (unlikely(result == NULL)) {
+            funlockfile(cInFile);
+            raise_error(MEMORY_ERROR);
+            return NULL;
+          } /* if */
+          memory = result->mem;
+        } /* if */
+#else
         while (ch != ' ' && ch != '\t' &&
             ch != '\n' && ch != EOF) {
           if (position >= memlength) {
-            newmemlength = memlength + READ_STRI_SIZE_DELTA;
-            REALLOC_STRI_CHECK_SIZE2(resized_result, result, memlength, newmemlength);
-            if (unlikely(resized_result == NULL)) {
-              FREE_STRI2(result, memlength);
+            result = growReadStri(result, &memlength, position + 1);
+            if (unlikely(result == NULL)) {
               funlockfile(cInFile);
               raise_error(MEMORY_ERROR);
               return NULL;
             } /* if */
-            result = resized_result;
             memory = result->mem;
-            memlength = newmemlength;
           } /* if */
           memory[position++] = (strElemType) ch;
           ch = getc_unlocked(cInFile);
         } /* while */
+#endif
         funlockfile(cInFile);
         if (ch == '\n' && position != 0 && memory[position - 1] == '\r') {
           position--;
@@ -2694,7 +3332,11 @@ striType filWordRead (fileType inFile, charType *terminationChar)
           raise_error(FILE_ERROR);
           result = NULL;
         } else {
-          REALLOC_STRI_SIZE_SMALLER2(resized_result, result, memlength, position);
+          if (position < memlength) {
+            REALLOC_STRI_SIZE_SMALLER2(resized_result, result, memlength, position);
+          } else {
+            resized_result = result;
+          } /* if */
           if (unlikely(resized_result == NULL)) {
             FREE_STRI2(result, memlength);
             raise_error(MEMORY_ERROR);
@@ -44,7 +44,8 @@ EXTERN fileRecord stderrFileRecord;
 #define initFileType(aFile, readingOkay, writingOkay) \
     (aFile)->usage_count = 1; \
     (aFile)->readingAllowed = (readingOkay); \
-    (aFile)->writingAllowed = (writingOkay);
+    (aFile)->writingAllowed = (writingOkay); \
+    (aFile)->mapStart = NULL;
 
 int offsetSeek (cFileType aFile, const os_off_t anOffset, const int origin);
 memSizeType remainingBytesInFile (cFileType aFile);
@@ -70,6 +71,7 @@ striType filLineReadChkCtrlC (fileType inFile, charType *terminationChar);
 striType filLit (fileType aFile);
 intType filLng (fileType aFile);
 fileType filOpen (const const_striType path, const const_striType mode);
+fileType filOpenMapped (const const_striType path);
 fileType filOpenNullDevice (void);
 void filPclose (fileType aPipe);
 fileType filPopen (const const_striType command,
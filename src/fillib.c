@@ -549,6 +549,27 @@ objectType fil_open (listType arguments)
 
 
 
+/**
+ *  Opens a file with the specified 'path' for reading via memory mapping.
+ *  Reading, seeking and the length work directly on the mapping.
+ *  If the file cannot be mapped it is read like a file opened with "r".
+ *  @return the file opened, or CLIB_NULL_FILE if it could not be opened or
+ *          if 'path' refers to a directory.
+ *  @exception MEMORY_ERROR Not enough memory to convert the path
+ *             to the system path type.
+ *  @exception RANGE_ERROR 'path' does not use the standard path
+ *             representation or 'path' cannot be converted
+ *             to the system path type.
+ */
+objectType fil_open_mapped (listType arguments)
+
+  { /* fil_open_mapped */
+    isit_stri(arg_1(arguments));
+    return bld_file_temp(filOpenMapped(take_stri(arg_1(arguments))));
+  } /* fil_open_mapped */
+
+
+
 /**
  *  Open the null device of the operation system for reading and writing.
  *  @return the null device opened, or NULL if it could not be opened.
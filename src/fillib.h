@@ -47,6 +47,7 @@ objectType fil_lit              (listType arguments);
 objectType fil_lng              (listType arguments);
 objectType fil_ne               (listType arguments);
 objectType fil_open             (listType arguments);
+objectType fil_open_mapped (listType arguments);
 objectType fil_open_null_device (listType arguments);
 objectType fil_out              (listType arguments);
 objectType fil_pclose           (listType arguments);
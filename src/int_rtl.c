@@ -39,6 +39,7 @@
 #include "stdlib.h"
 #include "stdio.h"
 #include "string.h"
+#include "wchar.h"
 #include "time.h"
 #include "limits.h"
 
@@ -74,64 +75,14 @@
 
 #define BYTE_BUFFER_SIZE sizeof(intType)
 
+/**
+ *  Number of decimal digits that can be accumulated in an
+ *  uintType without the possibility of an overflow.
+ */
 #if   INTTYPE_SIZE == 32
-#define DECIMAL_DIGITS(num) \
-  ((num) < UINT_SUFFIX(100000000) ?               \
-      ((num) < UINT_SUFFIX(10000) ?               \
-        ((num) < UINT_SUFFIX(100) ?               \
-          ((num) < UINT_SUFFIX(10) ? 1 : 2)       \
-        :                                         \
-          ((num) < UINT_SUFFIX(1000) ? 3 : 4)     \
-        )                                         \
-      :                                           \
-        ((num) < UINT_SUFFIX(1000000) ?           \
-          ((num) < UINT_SUFFIX(100000) ? 5 : 6)   \
-        :                                         \
-          ((num) < UINT_SUFFIX(10000000) ? 7 : 8) \
-        )                                         \
-      )                                           \
-    :                                             \
-      ((num) < UINT_SUFFIX(1000000000) ? 9 : 10)  \
-    )
+#define DIGITS_WITHOUT_OVERFLOW 8
 #elif INTTYPE_SIZE == 64
-#define DECIMAL_DIGITS(num) \
-    ((num) < UINT_SUFFIX(10000000000000000) ?                 \
-      ((num) < UINT_SUFFIX(100000000) ?                       \
-        ((num) < UINT_SUFFIX(10000) ?                         \
-          ((num) < UINT_SUFFIX(100) ?                         \
-            ((num) < UINT_SUFFIX(10) ? 1 : 2)                 \
-          :                                                   \
-            ((num) < UINT_SUFFIX(1000) ? 3 : 4)               \
-          )                                                   \
-        :                                                     \
-          ((num) < UINT_SUFFIX(1000000) ?                     \
-            ((num) < UINT_SUFFIX(100000) ? 5 : 6)             \
-          :                                                   \
-            ((num) < UINT_SUFFIX(10000000) ? 7 : 8)           \
-          )                                                   \
-        )                                                     \
-      :                                                       \
-        ((num) < UINT_SUFFIX(1000000000000) ?                 \
-          ((num) < UINT_SUFFIX(10000000000) ?                 \
-            ((num) < UINT_SUFFIX(1000000000) ? 9 : 10)        \
-          :                                                   \
-            ((num) < UINT_SUFFIX(100000000000) ? 11 : 12)     \
-          )                                                   \
-        :                                                     \
-          ((num) < UINT_SUFFIX(100000000000000) ?             \
-            ((num) < UINT_SUFFIX(10000000000000) ? 13 : 14)   \
-          :                                                   \
-            ((num) < UINT_SUFFIX(1000000000000000) ? 15 : 16) \
-          )                                                   \
-        )                                                     \
-      )                                                       \
-    :                                                         \
-      ((num) < UINT_SUFFIX(1000000000000000000) ?             \
-        ((num) < UINT_SUFFIX(100000000000000000) ? 17 : 18)   \
-      :                                                       \
-        ((num) < UINT_SUFFIX(10000000000000000000) ? 19 : 20) \
-      )                                                       \
-    )
+#define DIGITS_WITHOUT_OVERFLOW 16
 #endif
 
 
@@ -217,6 +168,17 @@ const const_ustriType digitTable[] = {
     (const_ustriType) "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ"
   };
 
+/**
+ *  Decimal digits of the numbers 0 to 99. The digits of the number
+ *  n are at the positions 2 * n and 2 * n + 1.
+ */
+static const char digitPairs[] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
 #ifdef HAS_DOUBLE_INTTYPE
 doubleUintType seed;
 #else
@@ -1072,6 +1034,40 @@ striType uintRadixPow2 (uintType number, int shift, int mask, boolType upperCase
 
 
 
+/**
+ *  Write the decimal digits of an unsigned number backward into memory.
+ *  Two digits are written at once with the help of the digitPairs
+ *  table. This halves the number of divisions by 10.
+ *  @param number Number to be converted to decimal digits.
+ *  @param memEnd Place after the memory for the last digit.
+ *  @return a pointer to the first (most significant) digit.
+ */
+strElemType *uintDigitsToMem (uintType number, strElemType *memEnd)
+
+  {
+    const char *pair;
+
+  /* uintDigitsToMem */
+    while (number >= 100) {
+      pair = &digitPairs[(number % 100) << 1];
+      number /= 100;
+      memEnd -= 2;
+      memEnd[0] = (strElemType) pair[0];
+      memEnd[1] = (strElemType) pair[1];
+    } /* while */
+    if (number >= 10) {
+      pair = &digitPairs[number << 1];
+      memEnd -= 2;
+      memEnd[0] = (strElemType) pair[0];
+      memEnd[1] = (strElemType) pair[1];
+    } else {
+      *(--memEnd) = (strElemType) (number + '0');
+    } /* if */
+    return memEnd;
+  } /* uintDigitsToMem */
+
+
+
 /**
  *  Convert an unsigned integer number to a string.
  *  The number is converted to a string with decimal representation.
@@ -1081,7 +1077,6 @@ striType uintRadixPow2 (uintType number, int shift, int mask, boolType upperCase
 striType uintStr (uintType number)
 
   {
-    strElemType *buffer;
     memSizeType length;
     striType result;
 
@@ -1092,10 +1087,7 @@ striType uintStr (uintType number)
       raise_error(MEMORY_ERROR);
     } else {
       result->size = length;
-      buffer = &result->mem[length];
-      do {
-        *(--buffer) = (strElemType) (number % 10 + '0');
-      } while ((number /= 10) != 0);
+      uintDigitsToMem(number, &result->mem[length]);
     } /* if */
     logFunction(printf("uintStr --> \"%s\"\n",
                        striAsUnquotedCStri(result)););
@@ -1931,6 +1923,89 @@ intType intCmpGeneric (const genericType value1, const genericType value2)
 
 
 
+/**
+ *  Convert an array of integers to a string with delimiters.
+ *  The numbers are converted to decimal representation and the
+ *  'delimiter' is inserted between them. The size of the result is
+ *  computed in advance, such that it is allocated only once.
+ *   intJoin([](1, -2, 3), ", ")  returns  "1, -2, 3"
+ *   intJoin([](42), ", ")        returns  "42"
+ *  @return the decimal representations of the 'numbers' separated
+ *          by 'delimiter'.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+striType intJoin (const const_rtlArrayType numbers,
+    const const_striType delimiter)
+
+  {
+    memSizeType numElements;
+    memSizeType pos;
+    intType number;
+    uintType unsigned_number;
+    memSizeType length;
+    strElemType *dest;
+    striType result;
+
+  /* intJoin */
+    logFunction(printf("intJoin(arr (size=" FMT_U_MEM "), \"%s\")\n",
+                       arraySize(numbers),
+                       striAsUnquotedCStri(delimiter)););
+    numElements = arraySize(numbers);
+    if (unlikely(numElements != 0 &&
+                 MAX_STRI_LEN / numElements <
+                 delimiter->size + INTTYPE_DECIMAL_SIZE)) {
+      raise_error(MEMORY_ERROR);
+      result = NULL;
+    } else {
+      length = 0;
+      for (pos = 0; pos < numElements; pos++) {
+        number = numbers->arr[pos].value.intValue;
+        if (number < 0) {
+          unsigned_number = -(uintType) number;
+        } else {
+          unsigned_number = (uintType) number;
+        } /* if */
+        length += (memSizeType) DECIMAL_DIGITS(unsigned_number) +
+                  (memSizeType) (number < 0);
+      } /* for */
+      if (numElements != 0) {
+        length += (numElements - 1) * delimiter->size;
+      } /* if */
+      if (unlikely(!ALLOC_STRI_SIZE_OK(result, length))) {
+        raise_error(MEMORY_ERROR);
+      } else {
+        result->size = length;
+        dest = result->mem;
+        for (pos = 0; pos < numElements; pos++) {
+          if (pos != 0) {
+            memcpy(dest, delimiter->mem,
+                   delimiter->size * sizeof(strElemType));
+            dest += delimiter->size;
+          } /* if */
+          number = numbers->arr[pos].value.intValue;
+          /* The minus sign is written unconditionally and it is */
+          /* overwritten by the digits of a nonnegative number.   */
+          *dest = (strElemType) '-';
+          if (number < 0) {
+            dest++;
+            /* The unsigned value is negated to avoid a signed integer */
+            /* overflow if the smallest signed integer is negated.     */
+            unsigned_number = -(uintType) number;
+          } else {
+            unsigned_number = (uintType) number;
+          } /* if */
+          dest += (memSizeType) DECIMAL_DIGITS(unsigned_number);
+          uintDigitsToMem(unsigned_number, dest);
+        } /* for */
+      } /* if */
+    } /* if */
+    logFunction(printf("intJoin --> \"%s\"\n",
+                       striAsUnquotedCStri(result)););
+    return result;
+  } /* intJoin */
+
+
+
 /**
  *  Compute the truncated base 10 logarithm of an integer number.
  *  The definition of intLog10 is extended by defining intLog10(0) = -1.
@@ -2070,10 +2145,7 @@ striType intLpad0 (intType number, const intType padSize)
       raise_error(MEMORY_ERROR);
     } else {
       result->size = result_size;
-      buffer = &result->mem[result_size];
-      do {
-        *(--buffer) = (strElemType) (unsigned_number % 10 + '0');
-      } while ((unsigned_number /= 10) != 0);
+      buffer = uintDigitsToMem(unsigned_number, &result->mem[result_size]);
       if (buffer != result->mem) {
         while (buffer != &result->mem[1]) {
           *(--buffer) = (strElemType) '0';
@@ -2516,56 +2588,77 @@ striType intNBytesLeUnsigned (intType number, intType length)
 
 
 /**
- *  Convert a string to an integer number.
- *  The string must contain an integer literal consisting of an
- *  optional + or - sign, followed by a sequence of digits. Other
- *  characters as well as leading or trailing whitespace characters
- *  are not allowed. The sequence of digits is taken to be decimal.
- *  @return the integer result of the conversion.
- *  @exception RANGE_ERROR If the string is empty or it does not contain
- *             an integer literal or if the integer literal is too big
- *             or too small to be represented as integer value.
+ *  Convert a sequence of characters to an integer number.
+ *  The characters must form an integer literal consisting of an
+ *  optional + or - sign, followed by a sequence of decimal digits.
+ *  The first DIGITS_WITHOUT_OVERFLOW digits cannot overflow. They are
+ *  converted in groups of four digits, which shortens the chain of
+ *  dependent multiplications. Further digits are converted one by
+ *  one with an overflow check.
+ *  @param mem Characters to be converted.
+ *  @param size Number of characters in 'mem'.
+ *  @param err_info Unchanged if the function succeeds, and
+ *                  RANGE_ERROR if the characters do not form an
+ *                  integer literal or if the integer literal is too
+ *                  big or too small to be represented as integer value.
+ *  @return the integer result of the conversion, or 0 if the
+ *          conversion failed.
  */
-intType intParse (const const_striType stri)
+intType intParseMem (const strElemType *mem, memSizeType size,
+    errInfoType *err_info)
 
   {
     boolType okay;
-    boolType negative;
+    boolType negative = FALSE;
     memSizeType position = 0;
+    memSizeType fastEnd;
+    uintType digit0;
+    uintType digit1;
+    uintType digit2;
+    uintType digit3;
     uintType digitval;
     uintType uintValue;
     intType intResult;
 
-  /* intParse */
-    logFunction(printf("intParse(\"%s\")\n", striAsUnquotedCStri(stri)););
-    if (likely(stri->size != 0)) {
-      if (stri->mem[0] == ((strElemType) '-')) {
+  /* intParseMem */
+    if (likely(size != 0)) {
+      if (mem[0] == ((strElemType) '-')) {
         negative = TRUE;
         position++;
-      } else {
-        if (stri->mem[0] == ((strElemType) '+')) {
-          position++;
-        } /* if */
-        negative = FALSE;
+      } else if (mem[0] == ((strElemType) '+')) {
+        position++;
       } /* if */
     } /* if */
-    if (unlikely(position >= stri->size)) {
-      logError(printf("intParse(\"%s\"): "
-                      "Digit missing.\n",
-                      striAsUnquotedCStri(stri)););
-      raise_error(RANGE_ERROR);
+    if (unlikely(position >= size)) {
+      logError(printf("intParseMem: Digit missing.\n"););
+      *err_info = RANGE_ERROR;
       intResult = 0;
     } else {
       uintValue = 0;
       okay = TRUE;
+      if (size - position > DIGITS_WITHOUT_OVERFLOW) {
+        fastEnd = position + DIGITS_WITHOUT_OVERFLOW;
+      } else {
+        fastEnd = size;
+      } /* if */
+      while (fastEnd - position >= 4 &&
+             (digit0 = ((uintType) mem[position])     - ((uintType) '0')) <= 9 &&
+             (digit1 = ((uintType) mem[position + 1]) - ((uintType) '0')) <= 9 &&
+             (digit2 = ((uintType) mem[position + 2]) - ((uintType) '0')) <= 9 &&
+             (digit3 = ((uintType) mem[position + 3]) - ((uintType) '0')) <= 9) {
+        uintValue = ((uintType) 10000) * uintValue +
+                    ((uintType) 1000) * digit0 + ((uintType) 100) * digit1 +
+                    ((uintType) 10) * digit2 + digit3;
+        position += 4;
+      } /* while */
 #if TWOS_COMPLEMENT_INTTYPE
-      while (position < stri->size &&
-             (digitval = ((uintType) stri->mem[position]) - ((uintType) '0')) <= 9) {
+      while (position < size &&
+             (digitval = ((uintType) mem[position]) - ((uintType) '0')) <= 9) {
 #else
-      while (position < stri->size &&
-          stri->mem[position] >= ((strElemType) '0') &&
-          stri->mem[position] <= ((strElemType) '9')) {
-        digitval = ((uintType) stri->mem[position]) - ((uintType) '0');
+      while (position < size &&
+          mem[position] >= ((strElemType) '0') &&
+          mem[position] <= ((strElemType) '9')) {
+        digitval = ((uintType) mem[position]) - ((uintType) '0');
 #endif
         if (unlikely(uintValue > MAX_DIV_10)) {
           okay = FALSE;
@@ -2574,25 +2667,21 @@ intType intParse (const const_striType stri)
         } /* if */
         position++;
       } /* while */
-      if (unlikely(position < stri->size)) {
-        logError(printf("intParse(\"%s\"): "
-                        "Illegal digit.\n",
-                        striAsUnquotedCStri(stri)););
-        raise_error(RANGE_ERROR);
+      if (unlikely(position < size)) {
+        logError(printf("intParseMem: Illegal digit.\n"););
+        *err_info = RANGE_ERROR;
         intResult = 0;
       } else if (unlikely(!okay)) {
-        logError(printf("intParse(\"%s\"): "
-                        "Absolute value of literal is too big.\n",
-                        striAsUnquotedCStri(stri)););
-        raise_error(RANGE_ERROR);
+        logError(printf("intParseMem: "
+                        "Absolute value of literal is too big.\n"););
+        *err_info = RANGE_ERROR;
         intResult = 0;
       } else {
         if (negative) {
 #if TWOS_COMPLEMENT_INTTYPE
           if (uintValue > (uintType) INTTYPE_MAX + 1) {
-            logError(printf("intParse(\"%s\"): Literal too small.\n",
-                            striAsUnquotedCStri(stri)););
-            raise_error(RANGE_ERROR);
+            logError(printf("intParseMem: Literal too small.\n"););
+            *err_info = RANGE_ERROR;
             intResult = 0;
           } else {
             /* The unsigned value is negated to avoid an overflow */
@@ -2603,15 +2692,45 @@ intType intParse (const const_striType stri)
           intResult = (intType) -uintValue;
 #endif
         } else if (uintValue > (uintType) INTTYPE_MAX) {
-          logError(printf("intParse(\"%s\"): Literal too big.\n",
-                          striAsUnquotedCStri(stri)););
-          raise_error(RANGE_ERROR);
+          logError(printf("intParseMem: Literal too big.\n"););
+          *err_info = RANGE_ERROR;
           intResult = 0;
         } else {
           intResult = (intType) uintValue;
         } /* if */
       } /* if */
     } /* if */
+    return intResult;
+  } /* intParseMem */
+
+
+
+/**
+ *  Convert a string to an integer number.
+ *  The string must contain an integer literal consisting of an
+ *  optional + or - sign, followed by a sequence of digits. Other
+ *  characters as well as leading or trailing whitespace characters
+ *  are not allowed. The sequence of digits is taken to be decimal.
+ *  @return the integer result of the conversion.
+ *  @exception RANGE_ERROR If the string is empty or it does not contain
+ *             an integer literal or if the integer literal is too big
+ *             or too small to be represented as integer value.
+ */
+intType intParse (const const_striType stri)
+
+  {
+    errInfoType err_info = OKAY_NO_ERROR;
+    intType intResult;
+
+  /* intParse */
+    logFunction(printf("intParse(\"%s\")\n", striAsUnquotedCStri(stri)););
+    intResult = intParseMem(stri->mem, stri->size, &err_info);
+    if (unlikely(err_info != OKAY_NO_ERROR)) {
+      logError(printf("intParse(\"%s\"): "
+                      "Illegal integer literal.\n",
+                      striAsUnquotedCStri(stri)););
+      raise_error(err_info);
+    } /* if */
     logFunction(printf("intParse --> " FMT_D "\n", intResult););
     return intResult;
   } /* intParse */
@@ -2771,11 +2890,16 @@ striType intRadix (intType number, intType base, boolType upperCase)
       } else {
         unsigned_number = (uintType) number;
       } /* if */
-      digits = digitTable[upperCase];
-      buffer = &buffer_1[RADIX_BUFFER_SIZE];
-      do {
-        *(--buffer) = (strElemType) (digits[unsigned_number % (uintType) base]);
-      } while ((unsigned_number /= (uintType) base) != 0);
+      if (base == 10) {
+        buffer = uintDigitsToMem(unsigned_number,
+                                 &buffer_1[RADIX_BUFFER_SIZE]);
+      } else {
+        digits = digitTable[upperCase];
+        buffer = &buffer_1[RADIX_BUFFER_SIZE];
+        do {
+          *(--buffer) = (strElemType) (digits[unsigned_number % (uintType) base]);
+        } while ((unsigned_number /= (uintType) base) != 0);
+      } /* if */
       if (negative) {
         *(--buffer) = (strElemType) '-';
       } /* if */
@@ -2901,6 +3025,72 @@ intType intRand (intType low, intType high)
 
 
 
+/**
+ *  Split a string around a delimiter and convert the parts to integers.
+ *  Each part of 'stri' that is terminated by 'delimiter' or by the
+ *  end of 'stri' must be an integer literal as accepted by intParse().
+ *  The number of parts is determined first, such that the result is
+ *  allocated only once.
+ *   intSplit("", ',')          returns  0 times 0
+ *   intSplit("15", ',')        returns  [](15)
+ *   intSplit("1,-2,+3", ',')   returns  [](1, -2, 3)
+ *  @return the array of integers that are separated by 'delimiter'.
+ *  @exception RANGE_ERROR If a part of 'stri' is not an integer literal
+ *             or if the integer literal is too big or too small to be
+ *             represented as integer value.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+rtlArrayType intSplit (const const_striType stri, const charType delimiter)
+
+  {
+    memSizeType numElements = 0;
+    memSizeType pos;
+    const strElemType *search_start;
+    const strElemType *search_end;
+    const strElemType *found_pos;
+    errInfoType err_info = OKAY_NO_ERROR;
+    rtlArrayType result_array;
+
+  /* intSplit */
+    logFunction(printf("intSplit(\"%s\", '\\" FMT_U32 ";')\n",
+                       striAsUnquotedCStri(stri), delimiter););
+    search_end = &stri->mem[stri->size];
+    if (stri->size != 0) {
+      numElements = memcnt_strelem(stri->mem, delimiter, stri->size) + 1;
+    } /* if */
+    if (unlikely(numElements > MAX_RTL_ARR_LEN ||
+                 !ALLOC_RTL_ARRAY(result_array, numElements))) {
+      raise_error(MEMORY_ERROR);
+      result_array = NULL;
+    } else {
+      result_array->min_position = 1;
+      result_array->max_position = (intType) numElements;
+      search_start = stri->mem;
+      for (pos = 0; pos < numElements; pos++) {
+        found_pos = memchr_strelem(search_start, delimiter,
+            (memSizeType) (search_end - search_start));
+        if (found_pos == NULL) {
+          found_pos = search_end;
+        } /* if */
+        result_array->arr[pos].value.intValue = intParseMem(search_start,
+            (memSizeType) (found_pos - search_start), &err_info);
+        search_start = found_pos + 1;
+      } /* for */
+      if (unlikely(err_info != OKAY_NO_ERROR)) {
+        logError(printf("intSplit(\"%s\", '\\" FMT_U32 ";'): "
+                        "Illegal integer literal.\n",
+                        striAsUnquotedCStri(stri), delimiter););
+        FREE_RTL_ARRAY(result_array, numElements);
+        raise_error(err_info);
+        result_array = NULL;
+      } /* if */
+    } /* if */
+    logFunction(printf("intSplit -->\n"););
+    return result_array;
+  } /* intSplit */
+
+
+
 /**
  *  Compute the integer square root of an integer radicand.
  *  @return the integer square root.
@@ -2946,7 +3136,6 @@ striType intStr (intType number)
   {
     register uintType unsigned_number;
     boolType negative;
-    strElemType *buffer;
     memSizeType length;
     striType result;
 
@@ -2968,10 +3157,7 @@ striType intStr (intType number)
       raise_error(MEMORY_ERROR);
     } else {
       result->size = length;
-      buffer = &result->mem[length];
-      do {
-        *(--buffer) = (strElemType) (unsigned_number % 10 + '0');
-      } while ((unsigned_number /= 10) != 0);
+      uintDigitsToMem(unsigned_number, &result->mem[length]);
       if (negative) {
         result->mem[0] = (strElemType) '-';
       } /* if */
@@ -3007,10 +3193,8 @@ striType intStrToBuffer (intType number, striType buffer)
     } else {
       unsigned_number = (uintType) number;
     } /* if */
-    bufferPtr = &buffer->mem1[INTTYPE_DECIMAL_SIZE];
-    do {
-      *(--bufferPtr) = (strElemType) (unsigned_number % 10 + '0');
-    } while ((unsigned_number /= 10) != 0);
+    bufferPtr = uintDigitsToMem(unsigned_number,
+                                &buffer->mem1[INTTYPE_DECIMAL_SIZE]);
     if (negative) {
       *(--bufferPtr) = (strElemType) '-';
     } /* if */
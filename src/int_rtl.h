@@ -37,6 +37,69 @@
 #define RAND_INCREMENT   1442695040888963407
 #endif
 
+/**
+ *  Number of decimal digits of the unsigned number num.
+ */
+#if   INTTYPE_SIZE == 32
+#define DECIMAL_DIGITS(num) \
+  ((num) < UINT_SUFFIX(100000000) ?               \
+      ((num) < UINT_SUFFIX(10000) ?               \
+        ((num) < UINT_SUFFIX(100) ?               \
+          ((num) < UINT_SUFFIX(10) ? 1 : 2)       \
+        :                                         \
+          ((num) < UINT_SUFFIX(1000) ? 3 : 4)     \
+        )                                         \
+      :                                           \
+        ((num) < UINT_SUFFIX(1000000) ?           \
+          ((num) < UINT_SUFFIX(100000) ? 5 : 6)   \
+        :                                         \
+          ((num) < UINT_SUFFIX(10000000) ? 7 : 8) \
+        )                                         \
+      )                                           \
+    :                                             \
+      ((num) < UINT_SUFFIX(1000000000) ? 9 : 10)  \
+    )
+#elif INTTYPE_SIZE == 64
+#define DECIMAL_DIGITS(num) \
+    ((num) < UINT_SUFFIX(10000000000000000) ?                 \
+      ((num) < UINT_SUFFIX(100000000) ?                       \
+        ((num) < UINT_SUFFIX(10000) ?                         \
+          ((num) < UINT_SUFFIX(100) ?                         \
+            ((num) < UINT_SUFFIX(10) ? 1 : 2)                 \
+          :                                                   \
+            ((num) < UINT_SUFFIX(1000) ? 3 : 4)               \
+          )                                                   \
+        :                                                     \
+          ((num) < UINT_SUFFIX(1000000) ?                     \
+            ((num) < UINT_SUFFIX(100000) ? 5 : 6)             \
+          :                                                   \
+            ((num) < UINT_SUFFIX(10000000) ? 7 : 8)           \
+          )                                                   \
+        )                                                     \
+      :                                                       \
+        ((num) < UINT_SUFFIX(1000000000000) ?                 \
+          ((num) < UINT_SUFFIX(10000000000) ?                 \
+            ((num) < UINT_SUFFIX(1000000000) ? 9 : 10)        \
+          :                                                   \
+            ((num) < UINT_SUFFIX(100000000000) ? 11 : 12)     \
+          )                                                   \
+        :                                                     \
+          ((num) < UINT_SUFFIX(100000000000000) ?             \
+            ((num) < UINT_SUFFIX(10000000000000) ? 13 : 14)   \
+          :                                                   \
+            ((num) < UINT_SUFFIX(1000000000000000) ? 15 : 16) \
+          )                                                   \
+        )                                                     \
+      )                                                       \
+    :                                                         \
+      ((num) < UINT_SUFFIX(1000000000000000000) ?             \
+        ((num) < UINT_SUFFIX(100000000000000000) ? 17 : 18)   \
+      :                                                       \
+        ((num) < UINT_SUFFIX(10000000000000000000) ? 19 : 20) \
+      )                                                       \
+    )
+#endif
+
 extern const const_ustriType digitTable[];
 
 
@@ -64,6 +127,7 @@ uintType uintBytesLe2UInt (const const_striType byteStri);
 intType uintCard (uintType number);
 striType uintRadix (uintType number, intType base, boolType upperCase);
 striType uintRadixPow2 (uintType number, int shift, int mask, boolType upperCase);
+strElemType *uintDigitsToMem (uintType number, strElemType *memEnd);
 striType uintStr (uintType number);
 intType intBinom (intType n_number, intType k_number);
 uintType uintBinomNoChk (uintType n_number, intType k_number);
@@ -75,6 +139,8 @@ striType intBytesLe (intType number, boolType isSigned);
 intType intBytesLe2Int (const const_striType byteStri);
 intType intBytesLe2UInt (const const_striType byteStri);
 intType intCmp (intType number1, intType number2);
+/* striType intJoin (const const_rtlArrayType numbers,
+    const const_striType delimiter); */
 intType intLog10 (intType number);
 intType intLog2 (intType number);
 intType intLowestSetBit (intType number);
@@ -84,12 +150,16 @@ striType intNBytesBeSigned (intType number, intType length);
 striType intNBytesBeUnsigned (intType number, intType length);
 striType intNBytesLeSigned (intType number, intType length);
 striType intNBytesLeUnsigned (intType number, intType length);
+intType intParseMem (const strElemType *mem, memSizeType size,
+    errInfoType *err_info);
 intType intParse (const const_striType stri);
 intType intPow (intType base, intType exponent);
 intType intPowOvfChk (intType base, intType exponent);
 striType intRadix (intType number, intType base, boolType upperCase);
 striType intRadixPow2 (intType number, int shift, int mask, boolType upperCase);
 intType intRand (intType low, intType high);
+/* rtlArrayType intSplit (const const_striType stri,
+    const charType delimiter); */
 intType intSqrt (intType radicand);
 striType intStr (intType number);
 #if ALLOW_STRITYPE_SLICES
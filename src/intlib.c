@@ -35,6 +35,7 @@
 #include "stdlib.h"
 #include "stdio.h"
 #include "string.h"
+#include "wchar.h"
 
 #include "common.h"
 #include "data.h"
@@ -43,8 +44,10 @@
 #include "syvarutl.h"
 #include "objutl.h"
 #include "traceutl.h"
+#include "striutl.h"
 #include "runerr.h"
 #include "int_rtl.h"
+#include "rtl_err.h"
 
 #undef EXTERN
 #define EXTERN
@@ -63,6 +66,138 @@ static const intType fact[] = {
   };
 
 
+static striType intJoin (const const_arrayType numbers,
+    const const_striType delimiter)
+
+  {
+    memSizeType numElements;
+    memSizeType pos;
+    intType number;
+    uintType unsigned_number;
+    memSizeType length;
+    strElemType *dest;
+    striType result;
+
+  /* intJoin */
+    logFunction(printf("intJoin(arr (size=" FMT_U_MEM "), \"%s\")\n",
+                       arraySize(numbers),
+                       striAsUnquotedCStri(delimiter)););
+    numElements = arraySize(numbers);
+    if (unlikely(numElements != 0 &&
+                 MAX_STRI_LEN / numElements <
+                 delimiter->size + INTTYPE_DECIMAL_SIZE)) {
+      raise_error(MEMORY_ERROR);
+      result = NULL;
+    } else {
+      length = 0;
+      for (pos = 0; pos < numElements; pos++) {
+        number = numbers->arr[pos].value.intValue;
+        if (number < 0) {
+          unsigned_number = -(uintType) number;
+        } else {
+          unsigned_number = (uintType) number;
+        } /* if */
+        length += (memSizeType) DECIMAL_DIGITS(unsigned_number) +
+                  (memSizeType) (number < 0);
+      } /* for */
+      if (numElements != 0) {
+        length += (numElements - 1) * delimiter->size;
+      } /* if */
+      if (unlikely(!ALLOC_STRI_SIZE_OK(result, length))) {
+        raise_error(MEMORY_ERROR);
+      } else {
+        result->size = length;
+        dest = result->mem;
+        for (pos = 0; pos < numElements; pos++) {
+          if (pos != 0) {
+            memcpy(dest, delimiter->mem,
+                   delimiter->size * sizeof(strElemType));
+            dest += delimiter->size;
+          } /* if */
+          number = numbers->arr[pos].value.intValue;
+          /* The minus sign is written unconditionally and it is */
+          /* overwritten by the digits of a nonnegative number.   */
+          *dest = (strElemType) '-';
+          if (number < 0) {
+            dest++;
+            /* The unsigned value is negated to avoid a signed integer */
+            /* overflow if the smallest signed integer is negated.     */
+            unsigned_number = -(uintType) number;
+          } else {
+            unsigned_number = (uintType) number;
+          } /* if */
+          dest += (memSizeType) DECIMAL_DIGITS(unsigned_number);
+          uintDigitsToMem(unsigned_number, dest);
+        } /* for */
+      } /* if */
+    } /* if */
+    logFunction(printf("intJoin --> \"%s\"\n",
+                       striAsUnquotedCStri(result)););
+    return result;
+  } /* intJoin */
+
+
+
+static arrayType intSplit (const const_striType stri,
+    const charType delimiter)
+
+  {
+    memSizeType numElements = 0;
+    memSizeType pos;
+    const strElemType *search_start;
+    const strElemType *search_end;
+    const strElemType *found_pos;
+    errInfoType err_info = OKAY_NO_ERROR;
+    arrayType result_array;
+
+  /* intSplit */
+    logFunction(printf("intSplit(\"%s\", '\\" FMT_U32 ";')\n",
+                       striAsUnquotedCStri(stri), delimiter););
+    search_start = stri->mem;
+    search_end = &stri->mem[stri->size];
+    if (stri->size != 0) {
+      numElements = 1;
+      while ((found_pos = memchr_strelem(search_start, delimiter,
+          (memSizeType) (search_end - search_start))) != NULL) {
+        numElements++;
+        search_start = found_pos + 1;
+      } /* while */
+    } /* if */
+    if (unlikely(numElements > MAX_ARR_LEN ||
+                 !ALLOC_ARRAY(result_array, numElements))) {
+      raise_error(MEMORY_ERROR);
+      result_array = NULL;
+    } else {
+      result_array->min_position = 1;
+      result_array->max_position = (intType) numElements;
+      search_start = stri->mem;
+      for (pos = 0; pos < numElements; pos++) {
+        found_pos = memchr_strelem(search_start, delimiter,
+            (memSizeType) (search_end - search_start));
+        if (found_pos == NULL) {
+          found_pos = search_end;
+        } /* if */
+        result_array->arr[pos].type_of = take_type(SYS_INT_TYPE);
+        result_array->arr[pos].descriptor.property = NULL;
+        result_array->arr[pos].value.intValue = intParseMem(search_start,
+            (memSizeType) (found_pos - search_start), &err_info);
+        INIT_CATEGORY_OF_VAR(&result_array->arr[pos], INTOBJECT);
+        search_start = found_pos + 1;
+      } /* for */
+      if (unlikely(err_info != OKAY_NO_ERROR)) {
+        logError(printf("intSplit(\"%s\", '\\" FMT_U32 ";'): "
+                        "Illegal integer literal.\n",
+                        striAsUnquotedCStri(stri), delimiter););
+        FREE_ARRAY(result_array, numElements);
+        raise_error(err_info);
+        result_array = NULL;
+      } /* if */
+    } /* if */
+    logFunction(printf("intSplit -->\n"););
+    return result_array;
+  } /* intSplit */
+
+
 
 /**
  *  Generic Destr function.
@@ -669,6 +804,24 @@ objectType int_incr (listType arguments)
 
 
 
+/**
+ *  Convert an array of integers to a string with delimiters.
+ *   join([](1, -2, 3), ", ")  returns  "1, -2, 3"
+ *  @return the decimal representations of the numbers separated
+ *          by the delimiter.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+objectType int_join (listType arguments)
+
+  { /* int_join */
+    isit_array(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    return bld_stri_temp(
+        intJoin(take_array(arg_1(arguments)), take_stri(arg_2(arguments))));
+  } /* int_join */
+
+
+
 /**
  *  Check if number1 is less than or equal to number2.
  *  @return TRUE if number1 is less than or equal to number2,
@@ -1581,6 +1734,26 @@ objectType int_sbtr_assign (listType arguments)
 
 
 
+/**
+ *  Split a string around a delimiter and convert the parts to integers.
+ *   splitIntegers("1,-2,+3", ',')  returns  [](1, -2, 3)
+ *  @return the array of integers that are separated by the delimiter.
+ *  @exception RANGE_ERROR If a part of the string is not an integer
+ *             literal or if the integer literal is too big or too
+ *             small to be represented as integer value.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+objectType int_split (listType arguments)
+
+  { /* int_split */
+    isit_stri(arg_1(arguments));
+    isit_char(arg_2(arguments));
+    return bld_array_temp(
+        intSplit(take_stri(arg_1(arguments)), take_char(arg_2(arguments))));
+  } /* int_split */
+
+
+
 /**
  *  Compute the integer square root of an integer radicand.
  *  @return the integer square root.
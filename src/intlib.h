@@ -52,6 +52,7 @@ objectType int_hashcode            (listType arguments);
 objectType int_iconv1              (listType arguments);
 objectType int_iconv3              (listType arguments);
 objectType int_incr                (listType arguments);
+objectType int_join                (listType arguments);
 objectType int_le                  (listType arguments);
 objectType int_log10               (listType arguments);
 objectType int_log2                (listType arguments);
@@ -83,6 +84,7 @@ objectType int_rshift              (listType arguments);
 objectType int_rshift_assign       (listType arguments);
 objectType int_sbtr                (listType arguments);
 objectType int_sbtr_assign         (listType arguments);
+objectType int_split               (listType arguments);
 objectType int_sqrt                (listType arguments);
 objectType int_str                 (listType arguments);
 objectType int_succ                (listType arguments);
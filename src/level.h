@@ -0,0 +1 @@
+#define LEVEL 76
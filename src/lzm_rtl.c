@@ -0,0 +1,1733 @@
+/********************************************************************/
+/*                                                                  */
+/*  lzm_rtl.c     LZMA, LZMA2 and XZ decompression.                 */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/lzm_rtl.c                                       */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: LZMA, LZMA2 and XZ decompression.                      */
+/*                                                                  */
+/*  The state of an incremental decompression is stored in a        */
+/*  bstring. It consists of a header, the probabilities of the      */
+/*  range coder and the dictionary, which is a ring buffer. The     */
+/*  probabilities and the dictionary are used in place. LZMA data   */
+/*  is decoded symbol by symbol, as long as enough input is         */
+/*  available for the longest symbol. LZMA2 chunks are decoded when */
+/*  they are completely available.                                  */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+
+#include "common.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "striutl.h"
+#include "mdg_rtl.h"
+#include "rtl_err.h"
+
+#undef EXTERN
+#define EXTERN
+#include "lzm_rtl.h"
+
+
+#define LZMA_FORMAT_ALONE   1
+#define LZMA_FORMAT_ZIP     2
+#define LZMA_FORMAT_XZ      3
+
+#define NUM_STATES         12
+#define NUM_POS_BITS_MAX    4
+#define NUM_LEN_TO_POS      4
+#define NUM_ALIGN_BITS      4
+#define END_POS_MODEL_INDEX 14
+#define NUM_FULL_DISTANCES 128
+#define MATCH_MIN_LEN       2
+#define LITERAL_CODER_SIZE  0x300
+#define BIT_MODEL_TOTAL     2048
+#define NUM_MOVE_BITS       5
+#define TOP_VALUE           ((uint32Type) 1 << 24)
+#define MIN_DICT_SIZE       4096
+#define MAX_LC_LP_LZMA2     4
+#define END_MARKER          0xffffffff
+
+#define REQUIRED_INPUT_MAX    20
+#define INPUT_SLACK           32
+#define MIN_OUTPUT_CHUNK   65536
+#define INITIAL_OUTPUT    131072
+
+#define ALONE_HEADER_SIZE     13
+#define ZIP_HEADER_SIZE        9
+#define XZ_HEADER_SIZE        12
+#define XZ_FOOTER_SIZE        12
+#define XZ_FILTER_LZMA2     0x21
+#define XZ_CHECK_NONE          0
+#define XZ_CHECK_CRC32         1
+#define XZ_CHECK_CRC64         4
+#define MAX_VARINT_LENGTH      9
+#define LZMA2_MAX_HEADER       6
+
+#define MODE_ALONE_HEADER   0
+#define MODE_ZIP_HEADER     1
+#define MODE_STREAM_HEADER  2
+#define MODE_LZMA_DATA      3
+#define MODE_BLOCK_HEADER   4
+#define MODE_LZMA2_CHUNK    5
+#define MODE_BLOCK_END      6
+#define MODE_INDEX          7
+#define MODE_INDEX_RECORDS  8
+#define MODE_INDEX_END      9
+#define MODE_STREAM_FOOTER 10
+#define MODE_FINISHED      11
+#define MODE_ERROR         12
+
+#define STATUS_RUNNING      0
+#define STATUS_OUTPUT_FULL  1
+#define STATUS_NEED_INPUT   2
+#define STATUS_FINISHED     3
+#define STATUS_DATA_ERROR   4
+#define STATUS_MEMORY_ERROR 5
+
+static const ucharType xzMagic[] = {0xfd, '7', 'z', 'X', 'Z', 0};
+
+/* Sizes of the check fields for the check types 0 to 15. */
+static const ucharType xzCheckSize[] = {
+    0, 4, 4, 4, 8, 8, 8, 16, 16, 16, 32, 32, 32, 64, 64, 64
+  };
+
+static uint64Type crc64Table[256];
+static boolType crc64TableInitialized = FALSE;
+
+typedef struct {
+    uint16Type choice;
+    uint16Type choice2;
+    uint16Type low[1 << NUM_POS_BITS_MAX][8];
+    uint16Type mid[1 << NUM_POS_BITS_MAX][8];
+    uint16Type high[256];
+  } lenProbsRecord;
+
+/* The literal probabilities follow after this record. */
+typedef struct {
+    uint16Type isMatch[NUM_STATES][1 << NUM_POS_BITS_MAX];
+    uint16Type isRep[NUM_STATES];
+    uint16Type isRepG0[NUM_STATES];
+    uint16Type isRepG1[NUM_STATES];
+    uint16Type isRepG2[NUM_STATES];
+    uint16Type isRep0Long[NUM_STATES][1 << NUM_POS_BITS_MAX];
+    uint16Type posSlot[NUM_LEN_TO_POS][64];
+    uint16Type posSpecial[1 + NUM_FULL_DISTANCES - END_POS_MODEL_INDEX];
+    uint16Type align[1 << NUM_ALIGN_BITS];
+    lenProbsRecord lenProbs;
+    lenProbsRecord repLenProbs;
+  } lzmaProbsRecord, *lzmaProbsType;
+
+typedef struct {
+    uint32Type mode;
+    uint32Type format;
+    uint32Type lc;
+    uint32Type lp;
+    uint32Type pb;
+    uint32Type state;
+    uint32Type rep0;
+    uint32Type rep1;
+    uint32Type rep2;
+    uint32Type rep3;
+    uint32Type range;
+    uint32Type code;
+    uint32Type dictSize;
+    uint32Type dictBufSize;
+    uint32Type dictPos;
+    uint32Type dictFull;
+    uint32Type totalPos;
+    uint32Type maxLcLp;
+    uint32Type unpackSizeKnown;
+    uint32Type needDictReset;
+    uint32Type needProperties;
+    uint32Type streamFlags;
+    uint32Type checkType;
+    uint32Type crc32;
+    uint32Type blockHeaderSize;
+    uint32Type hasCompressedSize;
+    uint32Type hasUncompressedSize;
+    uint32Type indexCrc;
+    uint64Type unpackSize;
+    uint64Type crc64;
+    uint64Type blockCompressed;
+    uint64Type blockUncompressed;
+    uint64Type expectedCompressed;
+    uint64Type expectedUncompressed;
+    uint64Type numBlocks;
+    uint64Type sumUnpadded;
+    uint64Type sumUncompressed;
+    uint64Type indexRecords;
+    uint64Type indexSize;
+    uint64Type recordUnpadded;
+    uint64Type recordUncompressed;
+  } lzmaStateRecord;
+
+#define STATE_AREA_SIZE ((sizeof(lzmaStateRecord) + 7) & ~(memSizeType) 7)
+#define NUM_PROBS(lcLp) (sizeof(lzmaProbsRecord) / sizeof(uint16Type) + \
+                         ((memSizeType) LITERAL_CODER_SIZE << (lcLp)))
+#define PROBS_AREA_SIZE(lcLp) ((NUM_PROBS(lcLp) * sizeof(uint16Type) + 7) & \
+                               ~(memSizeType) 7)
+#define DICT_OFFSET(lcLp) (STATE_AREA_SIZE + PROBS_AREA_SIZE(lcLp))
+
+typedef struct {
+    lzmaStateRecord state;
+    bstriType *stateBstri;
+    lzmaProbsType probs;
+    uint16Type *literalProbs;
+    ucharType *dict;
+    uint32Type flushPos;
+    const ucharType *in;
+    memSizeType inLength;
+    memSizeType inPos;
+    boolType inputEnd;
+    ucharType *out;
+    memSizeType outPos;
+    memSizeType outCapacity;
+    memSizeType outTarget;
+  } lzmaWorkRecord, *lzmaWorkType;
+
+#define ALLOC_LZMA_WORK(var) (ALLOC_HEAP(var, lzmaWorkType, sizeof(lzmaWorkRecord))?CNT(CNT1_BYT(sizeof(lzmaWorkRecord))) TRUE:FALSE)
+#define FREE_LZMA_WORK(var)  (CNT(CNT2_BYT(sizeof(lzmaWorkRecord))) FREE_HEAP(var, sizeof(lzmaWorkRecord)))
+#define REALLOC_UBYTES(var,byt) REALLOC_HEAP(var, ucharType *, byt)
+#define COUNT3_UBYTES(byt1,byt2) CNT3(CNT2_BYT(byt1), CNT1_BYT(byt2))
+
+
+
+static inline uint32Type loadLittleEndian32 (const ucharType *bytes)
+
+  { /* loadLittleEndian32 */
+    return (uint32Type) bytes[0]       | (uint32Type) bytes[1] <<  8 |
+           (uint32Type) bytes[2] << 16 | (uint32Type) bytes[3] << 24;
+  } /* loadLittleEndian32 */
+
+
+
+static inline uint64Type loadLittleEndian64 (const ucharType *bytes)
+
+  { /* loadLittleEndian64 */
+    return (uint64Type) loadLittleEndian32(bytes) |
+           (uint64Type) loadLittleEndian32(&bytes[4]) << 32;
+  } /* loadLittleEndian64 */
+
+
+
+static striType bytesToStri (const ucharType *bytes, memSizeType length)
+
+  {
+    striType result;
+
+  /* bytesToStri */
+    if (unlikely(!ALLOC_STRI_CHECK_SIZE(result, length))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      result->size = length;
+      memcpy_to_strelem(result->mem, bytes, length);
+    } /* if */
+    return result;
+  } /* bytesToStri */
+
+
+
+static void initCrc64Table (void)
+
+  {
+    unsigned int index;
+    unsigned int bit;
+    uint64Type crc;
+
+  /* initCrc64Table */
+    for (index = 0; index < 256; index++) {
+      crc = index;
+      for (bit = 0; bit < 8; bit++) {
+        crc = (crc >> 1) ^ (0xc96c5795d7870f42 & (0 - (crc & 1)));
+      } /* for */
+      crc64Table[index] = crc;
+    } /* for */
+    crc64TableInitialized = TRUE;
+  } /* initCrc64Table */
+
+
+
+/**
+ *  Compute the CRC-64 of xz (ECMA-182 polynomial, bit reflected).
+ *  @param crc CRC of the preceding data, 0 at the start.
+ */
+static uint64Type crc64Bytes (uint64Type crc, const ucharType *data,
+    memSizeType length)
+
+  { /* crc64Bytes */
+    if (unlikely(!crc64TableInitialized)) {
+      initCrc64Table();
+    } /* if */
+    crc = ~crc;
+    for (; length != 0; length--) {
+      crc = crc64Table[(crc ^ *data) & 0xff] ^ (crc >> 8);
+      data++;
+    } /* for */
+    return ~crc;
+  } /* crc64Bytes */
+
+
+
+/**
+ *  Read a variable length integer of the xz format.
+ *  @return 1 if the integer has been read, 0 if more input is
+ *          needed and -1 if the integer is illegal.
+ */
+static int readVarint (const ucharType *data, memSizeType available,
+    memSizeType *pos, uint64Type *value)
+
+  {
+    unsigned int index = 0;
+    uint64Type number = 0;
+    int result = -1;
+    boolType done = FALSE;
+
+  /* readVarint */
+    while (!done) {
+      if (*pos + index >= available) {
+        result = 0;
+        done = TRUE;
+      } else if (index >= MAX_VARINT_LENGTH) {
+        done = TRUE;
+      } else {
+        number |= (uint64Type) (data[*pos + index] & 0x7f) << (7 * index);
+        if ((data[*pos + index] & 0x80) == 0) {
+          /* A zero byte at the end is only allowed as single byte. */
+          if (index == 0 || data[*pos + index] != 0) {
+            *pos += index + 1;
+            *value = number;
+            result = 1;
+          } /* if */
+          done = TRUE;
+        } /* if */
+        index++;
+      } /* if */
+    } /* while */
+    return result;
+  } /* readVarint */
+
+
+
+/**
+ *  Make sure that 'size' bytes can be stored in the state bstring.
+ *  The pointers of 'work' are updated afterwards.
+ *  @return TRUE if the state has the requested size, FALSE if there
+ *          is not enough memory.
+ */
+static boolType resizeState (lzmaWorkType work, memSizeType size)
+
+  {
+    bstriType resized;
+    boolType okay = TRUE;
+
+  /* resizeState */
+    if ((*work->stateBstri)->size != size) {
+      REALLOC_BSTRI_SIZE_OK(resized, *work->stateBstri,
+                            (*work->stateBstri)->size, size);
+      if (unlikely(resized == NULL)) {
+        okay = FALSE;
+      } else {
+        COUNT3_BSTRI((*work->stateBstri)->size, size);
+        resized->size = size;
+        *work->stateBstri = resized;
+      } /* if */
+    } /* if */
+    return okay;
+  } /* resizeState */
+
+
+
+static void setPointers (lzmaWorkType work)
+
+  { /* setPointers */
+    work->probs = (lzmaProbsType) &(*work->stateBstri)->mem[STATE_AREA_SIZE];
+    work->literalProbs = (uint16Type *) &work->probs[1];
+    work->dict = &(*work->stateBstri)->mem[DICT_OFFSET(work->state.maxLcLp)];
+  } /* setPointers */
+
+
+
+/**
+ *  Allocate the probabilities and the dictionary.
+ *  @param maxLcLp Maximum of lc + lp for the probabilities.
+ *  @param bufSize Size of the dictionary ring buffer.
+ *  @return TRUE if the memory could be allocated, FALSE otherwise.
+ */
+static boolType allocDictionary (lzmaWorkType work, uint32Type maxLcLp,
+    uint64Type bufSize)
+
+  {
+    boolType okay = FALSE;
+
+  /* allocDictionary */
+    if (bufSize < MIN_DICT_SIZE) {
+      bufSize = MIN_DICT_SIZE;
+    } /* if */
+    if (bufSize <= (uint64Type) (MAX_BSTRI_LEN - DICT_OFFSET(maxLcLp)) &&
+        bufSize <= 0xffffffff) {
+      okay = resizeState(work, (memSizeType) (DICT_OFFSET(maxLcLp) + bufSize));
+      if (okay) {
+        work->state.maxLcLp = maxLcLp;
+        work->state.dictBufSize = (uint32Type) bufSize;
+        work->state.dictPos = 0;
+        work->state.dictFull = 0;
+        work->state.totalPos = 0;
+        work->flushPos = 0;
+        setPointers(work);
+      } /* if */
+    } /* if */
+    return okay;
+  } /* allocDictionary */
+
+
+
+static boolType setProperties (lzmaWorkType work, unsigned int propByte)
+
+  {
+    boolType okay = FALSE;
+
+  /* setProperties */
+    if (propByte < 9 * 5 * 5) {
+      work->state.lc = propByte % 9;
+      propByte /= 9;
+      work->state.lp = propByte % 5;
+      work->state.pb = propByte / 5;
+      okay = TRUE;
+    } /* if */
+    return okay;
+  } /* setProperties */
+
+
+
+static void resetLzmaState (lzmaWorkType work)
+
+  {
+    uint16Type *prob;
+    memSizeType numProbs;
+
+  /* resetLzmaState */
+    prob = (uint16Type *) work->probs;
+    numProbs = NUM_PROBS(work->state.lc + work->state.lp);
+    for (; numProbs != 0; numProbs--) {
+      *prob = BIT_MODEL_TOTAL >> 1;
+      prob++;
+    } /* for */
+    work->state.state = 0;
+    work->state.rep0 = 0;
+    work->state.rep1 = 0;
+    work->state.rep2 = 0;
+    work->state.rep3 = 0;
+  } /* resetLzmaState */
+
+
+
+/**
+ *  Initialize the range decoder with the 5 bytes at 'data'.
+ *  @return TRUE if the initialization is correct, FALSE otherwise.
+ */
+static boolType initRangeDecoder (lzmaWorkType work, const ucharType *data)
+
+  { /* initRangeDecoder */
+    work->state.range = 0xffffffff;
+    work->state.code = (uint32Type) data[1] << 24 | (uint32Type) data[2] << 16 |
+                       (uint32Type) data[3] <<  8 | (uint32Type) data[4];
+    return data[0] == 0 && work->state.code != work->state.range;
+  } /* initRangeDecoder */
+
+
+
+/**
+ *  Append the bytes produced by the decoder to the output of the step.
+ *  @return TRUE if the output has been appended, FALSE if there
+ *          is not enough memory.
+ */
+static boolType emitBytes (lzmaWorkType work, const ucharType *bytes,
+    memSizeType length)
+
+  {
+    memSizeType newCapacity;
+    ucharType *resized;
+    boolType okay = TRUE;
+
+  /* emitBytes */
+    if (length > work->outCapacity - work->outPos) {
+      newCapacity = work->outCapacity * 2;
+      if (newCapacity < work->outPos + length) {
+        newCapacity = work->outPos + length;
+      } /* if */
+      resized = REALLOC_UBYTES(work->out, newCapacity);
+      if (unlikely(resized == NULL)) {
+        okay = FALSE;
+      } else {
+        COUNT3_UBYTES(work->outCapacity, newCapacity);
+        work->out = resized;
+        work->outCapacity = newCapacity;
+      } /* if */
+    } /* if */
+    if (okay) {
+      memcpy(&work->out[work->outPos], bytes, length);
+      work->outPos += length;
+    } /* if */
+    return okay;
+  } /* emitBytes */
+
+
+
+/**
+ *  Move the bytes decoded into the dictionary to the output.
+ *  The check of the xz block is updated with these bytes.
+ *  When the end of the ring buffer is reached it starts again.
+ */
+static boolType flushDictionary (lzmaWorkType work)
+
+  {
+    const ucharType *bytes;
+    memSizeType length;
+    boolType okay;
+
+  /* flushDictionary */
+    bytes = &work->dict[work->flushPos];
+    length = work->state.dictPos - work->flushPos;
+    okay = emitBytes(work, bytes, length);
+    if (okay) {
+      if (work->state.checkType == XZ_CHECK_CRC32) {
+        work->state.crc32 = mdgCrc32Bytes(work->state.crc32, bytes, length);
+      } else if (work->state.checkType == XZ_CHECK_CRC64) {
+        work->state.crc64 = crc64Bytes(work->state.crc64, bytes, length);
+      } /* if */
+      work->state.blockUncompressed += length;
+      if (work->state.dictPos == work->state.dictBufSize) {
+        work->state.dictPos = 0;
+        work->state.dictFull = 1;
+      } /* if */
+      work->flushPos = work->state.dictPos;
+    } /* if */
+    return okay;
+  } /* flushDictionary */
+
+
+
+#define NORMALIZE \
+    if (range < TOP_VALUE) { \
+      range <<= 8; \
+      code = (code << 8) | *in++; \
+    }
+
+#define DECODE_BIT(prob, bit) { \
+    uint32Type bound = (range >> 11) * *(prob); \
+    if (code < bound) { \
+      range = bound; \
+      *(prob) = (uint16Type) (*(prob) + ((BIT_MODEL_TOTAL - *(prob)) >> NUM_MOVE_BITS)); \
+      bit = 0; \
+    } else { \
+      range -= bound; \
+      code -= bound; \
+      *(prob) = (uint16Type) (*(prob) - (*(prob) >> NUM_MOVE_BITS)); \
+      bit = 1; \
+    } \
+    NORMALIZE \
+  }
+
+#define DECODE_TREE(probs, numBits, result) { \
+    unsigned int treeIndex; \
+    unsigned int treeBit; \
+    result = 1; \
+    for (treeIndex = 0; treeIndex < (numBits); treeIndex++) { \
+      DECODE_BIT(&(probs)[result], treeBit) \
+      result = (result << 1) + treeBit; \
+    } \
+    result -= 1U << (numBits); \
+  }
+
+#define DECODE_REVERSE_TREE(probs, numBits, result) { \
+    unsigned int treeIndex; \
+    unsigned int treeBit; \
+    unsigned int treeNode = 1; \
+    result = 0; \
+    for (treeIndex = 0; treeIndex < (numBits); treeIndex++) { \
+      DECODE_BIT(&(probs)[treeNode], treeBit) \
+      treeNode = (treeNode << 1) + treeBit; \
+      result |= treeBit << treeIndex; \
+    } \
+  }
+
+#define DECODE_LEN(lenProbs, posState, len) { \
+    unsigned int choiceBit; \
+    DECODE_BIT(&(lenProbs)->choice, choiceBit) \
+    if (choiceBit == 0) { \
+      DECODE_TREE((lenProbs)->low[posState], 3, len) \
+    } else { \
+      DECODE_BIT(&(lenProbs)->choice2, choiceBit) \
+      if (choiceBit == 0) { \
+        DECODE_TREE((lenProbs)->mid[posState], 3, len) \
+        len += 8; \
+      } else { \
+        DECODE_TREE((lenProbs)->high, 8, len) \
+        len += 16; \
+      } \
+    } \
+  }
+
+#define SAVE_DECODER \
+    work->state.range = range; \
+    work->state.code = code; \
+    work->state.state = state; \
+    work->state.rep0 = rep0; \
+    work->state.rep1 = rep1; \
+    work->state.rep2 = rep2; \
+    work->state.rep3 = rep3; \
+    work->state.dictPos = dictPos; \
+    work->state.totalPos = totalPos;
+
+
+
+/**
+ *  Copy a match of 'length' bytes with the distance 'distance'.
+ *  The dictionary is flushed when its end is reached.
+ *  @return TRUE if the match has been copied, FALSE if there is
+ *          not enough memory for the output.
+ */
+static boolType copyMatch (lzmaWorkType work, uint32Type distance,
+    uint32Type length)
+
+  {
+    ucharType *dict;
+    uint32Type bufSize;
+    uint32Type dictPos;
+    uint32Type source;
+    uint32Type count;
+    uint32Type index;
+    uint32Type step;
+    boolType okay = TRUE;
+
+  /* copyMatch */
+    dict = work->dict;
+    bufSize = work->state.dictBufSize;
+    while (length != 0 && okay) {
+      dictPos = work->state.dictPos;
+      count = bufSize - dictPos;
+      if (count > length) {
+        count = length;
+      } /* if */
+      if (dictPos >= distance) {
+        source = dictPos - distance;
+        if (distance == 1) {
+          memset(&dict[dictPos], dict[source], count);
+        } else {
+          /* Copy pieces of at most 'distance' bytes, which do not overlap. */
+          for (index = 0; index < count; index += step) {
+            step = count - index < distance ? count - index : distance;
+            memcpy(&dict[dictPos + index], &dict[source + index], step);
+          } /* for */
+        } /* if */
+      } else {
+        source = bufSize - distance + dictPos;
+        for (index = 0; index < count; index++) {
+          dict[dictPos + index] = dict[source];
+          source++;
+          if (source == bufSize) {
+            source = 0;
+          } /* if */
+        } /* for */
+      } /* if */
+      work->state.dictPos += count;
+      length -= count;
+      if (work->state.dictPos == bufSize) {
+        okay = flushDictionary(work);
+      } /* if */
+    } /* while */
+    return okay;
+  } /* copyMatch */
+
+
+
+/**
+ *  Decode LZMA symbols until the unpacked size is reached, an end
+ *  marker is found, enough output has been produced or the input
+ *  is exhausted.
+ *  @param inLimit End of the input. For LZMA2 this is the end of the
+ *         chunk, which must not be exceeded.
+ *  @param streaming TRUE if the input might end before the data is
+ *         finished (LZMA), FALSE if the input contains the whole
+ *         chunk (LZMA2).
+ *  @return the status of the decoder.
+ */
+static int decodeLzma (lzmaWorkType work, const ucharType *inLimit,
+    boolType streaming)
+
+  {
+    const ucharType *in;
+    uint32Type range;
+    uint32Type code;
+    uint32Type state;
+    uint32Type rep0;
+    uint32Type rep1;
+    uint32Type rep2;
+    uint32Type rep3;
+    uint32Type dictPos;
+    uint32Type totalPos;
+    ucharType *dict;
+    uint32Type bufSize;
+    lzmaProbsType probs;
+    uint16Type *literalProbs;
+    uint16Type *prob;
+    uint32Type lc;
+    uint32Type lpMask;
+    uint32Type pbMask;
+    uint32Type posState;
+    uint32Type prevByte;
+    uint32Type matchByte;
+    uint32Type matchBit;
+    unsigned int symbol;
+    unsigned int bit;
+    unsigned int len;
+    unsigned int posSlot;
+    unsigned int numDirectBits;
+    unsigned int alignBits;
+    uint32Type distance;
+    int status = STATUS_RUNNING;
+
+  /* decodeLzma */
+    in = &work->in[work->inPos];
+    range = work->state.range;
+    code = work->state.code;
+    state = work->state.state;
+    rep0 = work->state.rep0;
+    rep1 = work->state.rep1;
+    rep2 = work->state.rep2;
+    rep3 = work->state.rep3;
+    dictPos = work->state.dictPos;
+    totalPos = work->state.totalPos;
+    dict = work->dict;
+    bufSize = work->state.dictBufSize;
+    probs = work->probs;
+    literalProbs = work->literalProbs;
+    lc = work->state.lc;
+    lpMask = (1U << work->state.lp) - 1;
+    pbMask = (1U << work->state.pb) - 1;
+    while (status == STATUS_RUNNING) {
+      if (work->state.unpackSizeKnown && work->state.unpackSize == 0 &&
+          code == 0) {
+        status = STATUS_FINISHED;
+      } else if (streaming && !work->inputEnd &&
+                 (memSizeType) (inLimit - in) < REQUIRED_INPUT_MAX) {
+        status = STATUS_NEED_INPUT;
+      } else if (streaming &&
+                 work->outPos + (dictPos - work->flushPos) >= work->outTarget) {
+        status = STATUS_OUTPUT_FULL;
+      } else if (!streaming && work->state.unpackSize == 0) {
+        /* The LZMA data of an LZMA2 chunk has no end marker. */
+        status = STATUS_DATA_ERROR;
+      } else {
+        posState = totalPos & pbMask;
+        DECODE_BIT(&probs->isMatch[state][posState], bit)
+        if (bit == 0) {
+          if (work->state.unpackSizeKnown && work->state.unpackSize == 0) {
+            status = STATUS_DATA_ERROR;
+          } else {
+            if (dictPos != 0) {
+              prevByte = dict[dictPos - 1];
+            } else if (work->state.dictFull) {
+              prevByte = dict[bufSize - 1];
+            } else {
+              prevByte = 0;
+            } /* if */
+            prob = &literalProbs[LITERAL_CODER_SIZE *
+                (((totalPos & lpMask) << lc) + (prevByte >> (8 - lc)))];
+            symbol = 1;
+            if (state >= 7) {
+              matchByte = dict[dictPos > rep0 ? dictPos - rep0 - 1 :
+                               bufSize - rep0 - 1 + dictPos];
+              do {
+                matchBit = (matchByte >> 7) & 1;
+                matchByte <<= 1;
+                DECODE_BIT(&prob[((1 + matchBit) << 8) + symbol], bit)
+                symbol = (symbol << 1) | bit;
+              } while (symbol < 0x100 && matchBit == bit);
+            } /* if */
+            while (symbol < 0x100) {
+              DECODE_BIT(&prob[symbol], bit)
+              symbol = (symbol << 1) | bit;
+            } /* while */
+            dict[dictPos++] = (ucharType) symbol;
+            totalPos++;
+            work->state.unpackSize--;
+            state = state < 4 ? 0 : (state < 10 ? state - 3 : state - 6);
+            if (dictPos == bufSize) {
+              SAVE_DECODER
+              if (!flushDictionary(work)) {
+                status = STATUS_MEMORY_ERROR;
+              } /* if */
+              dictPos = work->state.dictPos;
+            } /* if */
+          } /* if */
+        } else {
+          len = 0;
+          DECODE_BIT(&probs->isRep[state], bit)
+          if (bit != 0) {
+            if ((work->state.unpackSizeKnown && work->state.unpackSize == 0) ||
+                (dictPos == 0 && !work->state.dictFull)) {
+              status = STATUS_DATA_ERROR;
+            } else {
+              DECODE_BIT(&probs->isRepG0[state], bit)
+              if (bit == 0) {
+                DECODE_BIT(&probs->isRep0Long[state][posState], bit)
+                if (bit == 0) {
+                  /* Short rep: A single byte with the distance rep0. */
+                  dict[dictPos] = dict[dictPos > rep0 ? dictPos - rep0 - 1 :
+                                       bufSize - rep0 - 1 + dictPos];
+                  dictPos++;
+                  totalPos++;
+                  work->state.unpackSize--;
+                  state = state < 7 ? 9 : 11;
+                  if (dictPos == bufSize) {
+                    SAVE_DECODER
+                    if (!flushDictionary(work)) {
+                      status = STATUS_MEMORY_ERROR;
+                    } /* if */
+                    dictPos = work->state.dictPos;
+                  } /* if */
+                } /* if */
+              } else {
+                DECODE_BIT(&probs->isRepG1[state], bit)
+                if (bit == 0) {
+                  distance = rep1;
+                } else {
+                  DECODE_BIT(&probs->isRepG2[state], bit)
+                  if (bit == 0) {
+                    distance = rep2;
+                  } else {
+                    distance = rep3;
+                    rep3 = rep2;
+                  } /* if */
+                  rep2 = rep1;
+                } /* if */
+                rep1 = rep0;
+                rep0 = distance;
+                bit = 1;
+              } /* if */
+              if (bit != 0) {
+                DECODE_LEN(&probs->repLenProbs, posState, len)
+                state = state < 7 ? 8 : 11;
+                len += MATCH_MIN_LEN;
+              } /* if */
+            } /* if */
+          } else {
+            rep3 = rep2;
+            rep2 = rep1;
+            rep1 = rep0;
+            DECODE_LEN(&probs->lenProbs, posState, len)
+            state = state < 7 ? 7 : 10;
+            DECODE_TREE(probs->posSlot[len < NUM_LEN_TO_POS ? len :
+                                       NUM_LEN_TO_POS - 1], 6, posSlot)
+            if (posSlot < 4) {
+              rep0 = posSlot;
+            } else {
+              numDirectBits = (posSlot >> 1) - 1;
+              rep0 = (2 | (posSlot & 1)) << numDirectBits;
+              if (posSlot < END_POS_MODEL_INDEX) {
+                DECODE_REVERSE_TREE(&probs->posSpecial[rep0 - posSlot],
+                                    numDirectBits, distance)
+                rep0 += distance;
+              } else {
+                distance = 0;
+                for (numDirectBits -= NUM_ALIGN_BITS; numDirectBits != 0;
+                     numDirectBits--) {
+                  range >>= 1;
+                  code -= range;
+                  bit = 0 - (code >> 31);
+                  code += range & bit;
+                  distance = (distance << 1) + (bit + 1);
+                  NORMALIZE
+                } /* for */
+                DECODE_REVERSE_TREE(probs->align, NUM_ALIGN_BITS, alignBits)
+                rep0 += (distance << NUM_ALIGN_BITS) + alignBits;
+              } /* if */
+            } /* if */
+            len += MATCH_MIN_LEN;
+            if (rep0 == END_MARKER) {
+              if (!streaming || code != 0 ||
+                  (work->state.unpackSizeKnown && work->state.unpackSize != 0)) {
+                status = STATUS_DATA_ERROR;
+              } else {
+                status = STATUS_FINISHED;
+              } /* if */
+              len = 0;
+            } else if ((work->state.unpackSizeKnown && work->state.unpackSize == 0) ||
+                       rep0 >= work->state.dictSize ||
+                       (rep0 >= dictPos && !work->state.dictFull)) {
+              status = STATUS_DATA_ERROR;
+              len = 0;
+            } /* if */
+          } /* if */
+          if (len != 0 && status == STATUS_RUNNING) {
+            if (work->state.unpackSizeKnown && work->state.unpackSize < len) {
+              status = STATUS_DATA_ERROR;
+            } else {
+              work->state.unpackSize -= len;
+              totalPos += len;
+              if (rep0 < dictPos && len <= bufSize - dictPos &&
+                  rep0 + 1 >= len) {
+                /* Fast path: The match neither wraps nor overlaps. */
+                memcpy(&dict[dictPos], &dict[dictPos - rep0 - 1], len);
+                dictPos += len;
+                if (dictPos == bufSize) {
+                  SAVE_DECODER
+                  if (!flushDictionary(work)) {
+                    status = STATUS_MEMORY_ERROR;
+                  } /* if */
+                  dictPos = work->state.dictPos;
+                } /* if */
+              } else {
+                SAVE_DECODER
+                if (!copyMatch(work, rep0 + 1, len)) {
+                  status = STATUS_MEMORY_ERROR;
+                } /* if */
+                dictPos = work->state.dictPos;
+              } /* if */
+            } /* if */
+          } /* if */
+        } /* if */
+        if (in > inLimit) {
+          /* The input ended in the middle of a symbol. */
+          status = STATUS_DATA_ERROR;
+        } /* if */
+      } /* if */
+    } /* while */
+    SAVE_DECODER
+    work->inPos = (memSizeType) (in - work->in);
+    return status;
+  } /* decodeLzma */
+
+
+
+static int readAloneHeader (lzmaWorkType work)
+
+  {
+    const ucharType *data;
+    uint64Type unpackSize;
+    uint64Type bufSize;
+    int status = STATUS_RUNNING;
+
+  /* readAloneHeader */
+    data = &work->in[work->inPos];
+    if (work->inLength - work->inPos < ALONE_HEADER_SIZE + 5) {
+      status = work->inputEnd ? STATUS_DATA_ERROR : STATUS_NEED_INPUT;
+    } else if (!setProperties(work, data[0])) {
+      status = STATUS_DATA_ERROR;
+    } else {
+      work->state.dictSize = loadLittleEndian32(&data[1]);
+      if (work->state.dictSize < MIN_DICT_SIZE) {
+        work->state.dictSize = MIN_DICT_SIZE;
+      } /* if */
+      unpackSize = loadLittleEndian64(&data[5]);
+      work->state.unpackSizeKnown = unpackSize != (uint64Type) -1;
+      work->state.unpackSize = unpackSize;
+      bufSize = work->state.dictSize;
+      if (work->state.unpackSizeKnown && unpackSize < bufSize) {
+        /* The whole data fits into a smaller dictionary. */
+        bufSize = unpackSize;
+      } /* if */
+      if (!allocDictionary(work, work->state.lc + work->state.lp, bufSize)) {
+        status = STATUS_MEMORY_ERROR;
+      } else {
+        resetLzmaState(work);
+        if (!initRangeDecoder(work, &data[ALONE_HEADER_SIZE])) {
+          status = STATUS_DATA_ERROR;
+        } else {
+          work->inPos += ALONE_HEADER_SIZE + 5;
+          work->state.mode = MODE_LZMA_DATA;
+        } /* if */
+      } /* if */
+    } /* if */
+    return status;
+  } /* readAloneHeader */
+
+
+
+static int readZipHeader (lzmaWorkType work)
+
+  {
+    const ucharType *data;
+    uint64Type bufSize;
+    int status = STATUS_RUNNING;
+
+  /* readZipHeader */
+    data = &work->in[work->inPos];
+    if (work->inLength - work->inPos < ZIP_HEADER_SIZE + 5) {
+      status = work->inputEnd ? STATUS_DATA_ERROR : STATUS_NEED_INPUT;
+    } else if (data[2] != 5 || data[3] != 0 || !setProperties(work, data[4])) {
+      status = STATUS_DATA_ERROR;
+    } else {
+      work->state.dictSize = loadLittleEndian32(&data[5]);
+      if (work->state.dictSize < MIN_DICT_SIZE) {
+        work->state.dictSize = MIN_DICT_SIZE;
+      } /* if */
+      bufSize = work->state.dictSize;
+      if (work->state.unpackSizeKnown && work->state.unpackSize < bufSize) {
+        bufSize = work->state.unpackSize;
+      } /* if */
+      if (!allocDictionary(work, work->state.lc + work->state.lp, bufSize)) {
+        status = STATUS_MEMORY_ERROR;
+      } else {
+        resetLzmaState(work);
+        if (!initRangeDecoder(work, &data[ZIP_HEADER_SIZE])) {
+          status = STATUS_DATA_ERROR;
+        } else {
+          work->inPos += ZIP_HEADER_SIZE + 5;
+          work->state.mode = MODE_LZMA_DATA;
+        } /* if */
+      } /* if */
+    } /* if */
+    return status;
+  } /* readZipHeader */
+
+
+
+static int decodeLzmaData (lzmaWorkType work)
+
+  {
+    int status;
+
+  /* decodeLzmaData */
+    status = decodeLzma(work, &work->in[work->inLength], TRUE);
+    if (status == STATUS_FINISHED) {
+      work->state.mode = MODE_FINISHED;
+    } /* if */
+    return status;
+  } /* decodeLzmaData */
+
+
+
+static int readStreamHeader (lzmaWorkType work)
+
+  {
+    const ucharType *data;
+    int status = STATUS_RUNNING;
+
+  /* readStreamHeader */
+    data = &work->in[work->inPos];
+    if (work->inLength - work->inPos < XZ_HEADER_SIZE) {
+      status = work->inputEnd ? STATUS_DATA_ERROR : STATUS_NEED_INPUT;
+    } else if (memcmp(data, xzMagic, sizeof(xzMagic)) != 0 ||
+               data[6] != 0 || data[7] > 15 ||
+               mdgCrc32Bytes(0, &data[6], 2) != loadLittleEndian32(&data[8])) {
+      status = STATUS_DATA_ERROR;
+    } else {
+      work->state.streamFlags = data[7];
+      work->state.checkType = data[7];
+      work->inPos += XZ_HEADER_SIZE;
+      work->state.mode = MODE_BLOCK_HEADER;
+    } /* if */
+    return status;
+  } /* readStreamHeader */
+
+
+
+static int readBlockHeader (lzmaWorkType work)
+
+  {
+    const ucharType *data;
+    memSizeType available;
+    memSizeType headerSize;
+    memSizeType pos;
+    uint64Type value;
+    uint64Type filterId;
+    uint64Type propertiesSize;
+    uint32Type dictSize;
+    uint64Type bufSize;
+    unsigned int bits;
+    int status = STATUS_RUNNING;
+
+  /* readBlockHeader */
+    data = &work->in[work->inPos];
+    available = work->inLength - work->inPos;
+    if (available < 1) {
+      status = work->inputEnd ? STATUS_DATA_ERROR : STATUS_NEED_INPUT;
+    } else if (data[0] == 0) {
+      /* Index indicator */
+      work->state.indexCrc = mdgCrc32Bytes(0, data, 1);
+      work->state.indexSize = 1;
+      work->inPos++;
+      work->state.mode = MODE_INDEX;
+    } else {
+      headerSize = ((memSizeType) data[0] + 1) * 4;
+      if (available < headerSize) {
+        status = work->inputEnd ? STATUS_DATA_ERROR : STATUS_NEED_INPUT;
+      } else if (mdgCrc32Bytes(0, data, headerSize - 4) !=
+                 loadLittleEndian32(&data[headerSize - 4]) ||
+                 (data[1] & 0x3c) != 0 || (data[1] & 0x03) != 0) {
+        /* Only a single filter (LZMA2) is supported. */
+        status = STATUS_DATA_ERROR;
+      } else {
+        pos = 2;
+        work->state.hasCompressedSize = (data[1] & 0x40) != 0;
+        work->state.hasUncompressedSize = (data[1] & 0x80) != 0;
+        if (work->state.hasCompressedSize) {
+          if (readVarint(data, headerSize - 4, &pos, &value) != 1 || value == 0) {
+            status = STATUS_DATA_ERROR;
+          } else {
+            work->state.expectedCompressed = value;
+          } /* if */
+        } /* if */
+        if (status == STATUS_RUNNING && work->state.hasUncompressedSize) {
+          if (readVarint(data, headerSize - 4, &pos, &value) != 1) {
+            status = STATUS_DATA_ERROR;
+          } else {
+            work->state.expectedUncompressed = value;
+          } /* if */
+        } /* if */
+        if (status == STATUS_RUNNING &&
+            (readVarint(data, headerSize - 4, &pos, &filterId) != 1 ||
+             readVarint(data, headerSize - 4, &pos, &propertiesSize) != 1 ||
+             filterId != XZ_FILTER_LZMA2 || propertiesSize != 1 ||
+             pos >= headerSize - 4 || data[pos] > 40)) {
+          status = STATUS_DATA_ERROR;
+        } /* if */
+        if (status == STATUS_RUNNING) {
+          bits = data[pos];
+          pos++;
+          while (pos < headerSize - 4 && data[pos] == 0) {
+            pos++;
+          } /* while */
+          if (pos != headerSize - 4) {
+            /* The header padding must consist of zero bytes. */
+            status = STATUS_DATA_ERROR;
+          } else {
+            if (bits == 40) {
+              dictSize = 0xffffffff;
+            } else {
+              dictSize = (2 | (bits & 1)) << (bits / 2 + 11);
+            } /* if */
+            work->state.dictSize = dictSize < MIN_DICT_SIZE ? MIN_DICT_SIZE : dictSize;
+            bufSize = work->state.dictSize;
+            if (work->state.hasUncompressedSize &&
+                work->state.expectedUncompressed < bufSize) {
+              bufSize = work->state.expectedUncompressed;
+            } /* if */
+            if (!allocDictionary(work, MAX_LC_LP_LZMA2, bufSize)) {
+              status = STATUS_MEMORY_ERROR;
+            } else {
+              work->state.blockHeaderSize = (uint32Type) headerSize;
+              work->state.blockCompressed = 0;
+              work->state.blockUncompressed = 0;
+              work->state.crc32 = 0;
+              work->state.crc64 = 0;
+              work->state.needDictReset = 1;
+              work->state.needProperties = 1;
+              work->state.unpackSizeKnown = 1;
+              work->state.unpackSize = 0;
+              work->inPos += headerSize;
+              work->state.mode = MODE_LZMA2_CHUNK;
+            } /* if */
+          } /* if */
+        } /* if */
+      } /* if */
+    } /* if */
+    return status;
+  } /* readBlockHeader */
+
+
+
+/**
+ *  Copy an uncompressed LZMA2 chunk into the dictionary.
+ */
+static boolType copyUncompressed (lzmaWorkType work, const ucharType *data,
+    uint32Type length)
+
+  {
+    uint32Type count;
+    boolType okay = TRUE;
+
+  /* copyUncompressed */
+    while (length != 0 && okay) {
+      count = work->state.dictBufSize - work->state.dictPos;
+      if (count > length) {
+        count = length;
+      } /* if */
+      memcpy(&work->dict[work->state.dictPos], data, count);
+      work->state.dictPos += count;
+      work->state.totalPos += count;
+      data += count;
+      length -= count;
+      if (work->state.dictPos == work->state.dictBufSize) {
+        okay = flushDictionary(work);
+      } /* if */
+    } /* while */
+    return okay;
+  } /* copyUncompressed */
+
+
+
+static int decodeLzma2Chunk (lzmaWorkType work)
+
+  {
+    const ucharType *data;
+    memSizeType available;
+    unsigned int control;
+    uint32Type unpackedSize;
+    uint32Type packedSize;
+    memSizeType headerSize;
+    int status = STATUS_RUNNING;
+
+  /* decodeLzma2Chunk */
+    data = &work->in[work->inPos];
+    available = work->inLength - work->inPos;
+    if (work->outPos + (work->state.dictPos - work->flushPos) >= work->outTarget) {
+      return STATUS_OUTPUT_FULL;
+    } else if (available < 1) {
+      return work->inputEnd ? STATUS_DATA_ERROR : STATUS_NEED_INPUT;
+    } /* if */
+    control = data[0];
+    if (control == 0) {
+      /* End of the LZMA2 data */
+      if (!flushDictionary(work)) {
+        status = STATUS_MEMORY_ERROR;
+      } else {
+        work->inPos++;
+        work->state.blockCompressed++;
+        work->state.mode = MODE_BLOCK_END;
+      } /* if */
+    } else if (control >= 3 && control < 0x80) {
+      status = STATUS_DATA_ERROR;
+    } else {
+      headerSize = control >= 0xc0 ? 6 : (control >= 0x80 ? 5 : 3);
+      if (available < headerSize) {
+        return work->inputEnd ? STATUS_DATA_ERROR : STATUS_NEED_INPUT;
+      } /* if */
+      if (control < 0x80) {
+        unpackedSize = ((uint32Type) data[1] << 8 | data[2]) + 1;
+        packedSize = unpackedSize;
+      } else {
+        unpackedSize = ((uint32Type) (control & 0x1f) << 16 |
+                        (uint32Type) data[1] << 8 | data[2]) + 1;
+        packedSize = ((uint32Type) data[3] << 8 | data[4]) + 1;
+      } /* if */
+      if (available - headerSize < packedSize) {
+        return work->inputEnd ? STATUS_DATA_ERROR : STATUS_NEED_INPUT;
+      } /* if */
+      if (control >= 0xe0 || control == 1) {
+        /* Dictionary reset */
+        if (!flushDictionary(work)) {
+          return STATUS_MEMORY_ERROR;
+        } /* if */
+        work->state.dictPos = 0;
+        work->state.dictFull = 0;
+        work->state.totalPos = 0;
+        work->flushPos = 0;
+        work->state.needDictReset = 0;
+        work->state.needProperties = 1;
+      } else if (work->state.needDictReset) {
+        return STATUS_DATA_ERROR;
+      } /* if */
+      if (control < 0x80) {
+        if (!copyUncompressed(work, &data[headerSize], unpackedSize)) {
+          status = STATUS_MEMORY_ERROR;
+        } /* if */
+      } else {
+        if (control >= 0xc0) {
+          if (!setProperties(work, data[5]) ||
+              work->state.lc + work->state.lp > MAX_LC_LP_LZMA2) {
+            return STATUS_DATA_ERROR;
+          } /* if */
+          work->state.needProperties = 0;
+        } else if (work->state.needProperties) {
+          return STATUS_DATA_ERROR;
+        } /* if */
+        if (control >= 0xa0) {
+          resetLzmaState(work);
+        } /* if */
+        if (packedSize < 5 || !initRangeDecoder(work, &data[headerSize])) {
+          return STATUS_DATA_ERROR;
+        } /* if */
+        work->state.unpackSize = unpackedSize;
+        work->inPos += headerSize + 5;
+        status = decodeLzma(work, &data[headerSize + packedSize], FALSE);
+        if (status == STATUS_FINISHED &&
+            &work->in[work->inPos] == &data[headerSize + packedSize]) {
+          /* The chunk must be consumed exactly. */
+          status = STATUS_RUNNING;
+        } else if (status != STATUS_MEMORY_ERROR) {
+          status = STATUS_DATA_ERROR;
+        } /* if */
+        work->inPos = (memSizeType) (data - work->in);
+      } /* if */
+      if (status == STATUS_RUNNING) {
+        work->inPos += headerSize + packedSize;
+        work->state.blockCompressed += headerSize + packedSize;
+      } /* if */
+    } /* if */
+    return status;
+  } /* decodeLzma2Chunk */
+
+
+
+static int readBlockEnd (lzmaWorkType work)
+
+  {
+    const ucharType *data;
+    memSizeType padding;
+    memSizeType checkSize;
+    memSizeType pos;
+    uint64Type unpaddedSize;
+    int status = STATUS_RUNNING;
+
+  /* readBlockEnd */
+    data = &work->in[work->inPos];
+    padding = (memSizeType) ((4 - (work->state.blockHeaderSize +
+                                   work->state.blockCompressed) % 4) % 4);
+    checkSize = xzCheckSize[work->state.checkType];
+    if (work->inLength - work->inPos < padding + checkSize) {
+      status = work->inputEnd ? STATUS_DATA_ERROR : STATUS_NEED_INPUT;
+    } else if ((work->state.hasCompressedSize &&
+                work->state.blockCompressed != work->state.expectedCompressed) ||
+               (work->state.hasUncompressedSize &&
+                work->state.blockUncompressed != work->state.expectedUncompressed)) {
+      status = STATUS_DATA_ERROR;
+    } else {
+      for (pos = 0; pos < padding; pos++) {
+        if (data[pos] != 0) {
+          status = STATUS_DATA_ERROR;
+        } /* if */
+      } /* for */
+      if (work->state.checkType == XZ_CHECK_CRC32) {
+        if (loadLittleEndian32(&data[padding]) != work->state.crc32) {
+          logError(printf("xz: CRC32 of block does not match.\n"););
+          status = STATUS_DATA_ERROR;
+        } /* if */
+      } else if (work->state.checkType == XZ_CHECK_CRC64) {
+        if (loadLittleEndian64(&data[padding]) != work->state.crc64) {
+          logError(printf("xz: CRC64 of block does not match.\n"););
+          status = STATUS_DATA_ERROR;
+        } /* if */
+      } /* if */
+      /* Other checks (e.g. SHA-256) are not verified. */
+      if (status == STATUS_RUNNING) {
+        unpaddedSize = work->state.blockHeaderSize +
+                       work->state.blockCompressed + checkSize;
+        work->state.numBlocks++;
+        work->state.sumUnpadded += unpaddedSize;
+        work->state.sumUncompressed += work->state.blockUncompressed;
+        work->inPos += padding + checkSize;
+        work->state.mode = MODE_BLOCK_HEADER;
+      } /* if */
+    } /* if */
+    return status;
+  } /* readBlockEnd */
+
+
+
+static int readIndex (lzmaWorkType work)
+
+  {
+    memSizeType pos;
+    uint64Type value;
+    int varintStatus;
+    int status = STATUS_RUNNING;
+
+  /* readIndex */
+    pos = work->inPos;
+    varintStatus = readVarint(work->in, work->inLength, &pos, &value);
+    if (varintStatus == 0) {
+      status = work->inputEnd ? STATUS_DATA_ERROR : STATUS_NEED_INPUT;
+    } else if (varintStatus < 0 || value != work->state.numBlocks) {
+      status = STATUS_DATA_ERROR;
+    } else {
+      work->state.indexCrc = mdgCrc32Bytes(work->state.indexCrc,
+                                           &work->in[work->inPos], pos - work->inPos);
+      work->state.indexSize += pos - work->inPos;
+      work->state.indexRecords = value;
+      work->state.recordUnpadded = 0;
+      work->state.recordUncompressed = 0;
+      work->inPos = pos;
+      work->state.mode = MODE_INDEX_RECORDS;
+    } /* if */
+    return status;
+  } /* readIndex */
+
+
+
+static int readIndexRecords (lzmaWorkType work)
+
+  {
+    memSizeType pos;
+    uint64Type unpaddedSize;
+    uint64Type uncompressedSize;
+    int varintStatus;
+    int status = STATUS_RUNNING;
+
+  /* readIndexRecords */
+    while (status == STATUS_RUNNING && work->state.indexRecords != 0) {
+      pos = work->inPos;
+      varintStatus = readVarint(work->in, work->inLength, &pos, &unpaddedSize);
+      if (varintStatus == 1) {
+        varintStatus = readVarint(work->in, work->inLength, &pos, &uncompressedSize);
+      } /* if */
+      if (varintStatus == 0) {
+        status = work->inputEnd ? STATUS_DATA_ERROR : STATUS_NEED_INPUT;
+      } else if (varintStatus < 0 || unpaddedSize < 5) {
+        status = STATUS_DATA_ERROR;
+      } else {
+        work->state.indexCrc = mdgCrc32Bytes(work->state.indexCrc,
+                                             &work->in[work->inPos], pos - work->inPos);
+        work->state.indexSize += pos - work->inPos;
+        work->state.recordUnpadded += unpaddedSize;
+        work->state.recordUncompressed += uncompressedSize;
+        work->state.indexRecords--;
+        work->inPos = pos;
+      } /* if */
+    } /* while */
+    if (status == STATUS_RUNNING) {
+      if (work->state.recordUnpadded != work->state.sumUnpadded ||
+          work->state.recordUncompressed != work->state.sumUncompressed) {
+        status = STATUS_DATA_ERROR;
+      } else {
+        work->state.mode = MODE_INDEX_END;
+      } /* if */
+    } /* if */
+    return status;
+  } /* readIndexRecords */
+
+
+
+static int readIndexEnd (lzmaWorkType work)
+
+  {
+    const ucharType *data;
+    memSizeType padding;
+    memSizeType pos;
+    int status = STATUS_RUNNING;
+
+  /* readIndexEnd */
+    data = &work->in[work->inPos];
+    padding = (memSizeType) ((4 - work->state.indexSize % 4) % 4);
+    if (work->inLength - work->inPos < padding + 4) {
+      status = work->inputEnd ? STATUS_DATA_ERROR : STATUS_NEED_INPUT;
+    } else {
+      for (pos = 0; pos < padding; pos++) {
+        if (data[pos] != 0) {
+          status = STATUS_DATA_ERROR;
+        } /* if */
+      } /* for */
+      work->state.indexCrc = mdgCrc32Bytes(work->state.indexCrc, data, padding);
+      work->state.indexSize += padding + 4;
+      if (status == STATUS_RUNNING &&
+          loadLittleEndian32(&data[padding]) != work->state.indexCrc) {
+        status = STATUS_DATA_ERROR;
+      } else {
+        work->inPos += padding + 4;
+        work->state.mode = MODE_STREAM_FOOTER;
+      } /* if */
+    } /* if */
+    return status;
+  } /* readIndexEnd */
+
+
+
+static int readStreamFooter (lzmaWorkType work)
+
+  {
+    const ucharType *data;
+    int status = STATUS_RUNNING;
+
+  /* readStreamFooter */
+    data = &work->in[work->inPos];
+    if (work->inLength - work->inPos < XZ_FOOTER_SIZE) {
+      status = work->inputEnd ? STATUS_DATA_ERROR : STATUS_NEED_INPUT;
+    } else if (mdgCrc32Bytes(0, &data[4], 6) != loadLittleEndian32(data) ||
+               ((uint64Type) loadLittleEndian32(&data[4]) + 1) * 4 !=
+                   work->state.indexSize ||
+               data[8] != 0 || data[9] != work->state.streamFlags ||
+               data[10] != 'Y' || data[11] != 'Z') {
+      status = STATUS_DATA_ERROR;
+    } else {
+      work->inPos += XZ_FOOTER_SIZE;
+      work->state.mode = MODE_FINISHED;
+    } /* if */
+    return status;
+  } /* readStreamFooter */
+
+
+
+static int runLzma (lzmaWorkType work)
+
+  {
+    int status = STATUS_RUNNING;
+
+  /* runLzma */
+    while (status == STATUS_RUNNING) {
+      switch (work->state.mode) {
+        case MODE_ALONE_HEADER:  status = readAloneHeader(work);  break;
+        case MODE_ZIP_HEADER:    status = readZipHeader(work);    break;
+        case MODE_STREAM_HEADER: status = readStreamHeader(work); break;
+        case MODE_LZMA_DATA:     status = decodeLzmaData(work);   break;
+        case MODE_BLOCK_HEADER:  status = readBlockHeader(work);  break;
+        case MODE_LZMA2_CHUNK:   status = decodeLzma2Chunk(work); break;
+        case MODE_BLOCK_END:     status = readBlockEnd(work);     break;
+        case MODE_INDEX:         status = readIndex(work);        break;
+        case MODE_INDEX_RECORDS: status = readIndexRecords(work); break;
+        case MODE_INDEX_END:     status = readIndexEnd(work);     break;
+        case MODE_STREAM_FOOTER: status = readStreamFooter(work); break;
+        default:                 status = STATUS_FINISHED;        break;
+      } /* switch */
+    } /* while */
+    return status;
+  } /* runLzma */
+
+
+
+/**
+ *  Copy the LZMA state stored in the bstring 'stateBstri' to 'state'.
+ *  @return TRUE if 'stateBstri' contains a valid state, FALSE otherwise.
+ */
+static boolType getLzmaState (const const_bstriType stateBstri,
+    lzmaStateRecord *state)
+
+  {
+    boolType okay = FALSE;
+
+  /* getLzmaState */
+    if (stateBstri->size >= STATE_AREA_SIZE) {
+      memcpy(state, stateBstri->mem, sizeof(lzmaStateRecord));
+      okay = state->mode <= MODE_ERROR &&
+             state->format >= LZMA_FORMAT_ALONE &&
+             state->format <= LZMA_FORMAT_XZ &&
+             state->checkType <= 15 &&
+             state->lc <= 8 && state->lp <= 4 && state->pb <= 4 &&
+             state->state < NUM_STATES &&
+             state->maxLcLp <= 12 &&
+             state->lc + state->lp <= state->maxLcLp;
+      if (okay && state->mode >= MODE_LZMA_DATA && state->mode <= MODE_BLOCK_END &&
+          state->mode != MODE_BLOCK_HEADER) {
+        okay = stateBstri->size == DICT_OFFSET(state->maxLcLp) +
+                                   state->dictBufSize &&
+               state->dictBufSize >= MIN_DICT_SIZE &&
+               state->dictPos < state->dictBufSize &&
+               state->dictSize >= MIN_DICT_SIZE &&
+               state->rep0 < 0xffffffff;
+      } /* if */
+    } /* if */
+    return okay;
+  } /* getLzmaState */
+
+
+
+/**
+ *  Create a state for an incremental LZMA decompression.
+ *  @param format Format of the compressed data: 1 for LZMA files
+ *         with a 13 byte header (.lzma), 2 for LZMA data in zip
+ *         files and 3 for XZ files.
+ *  @param uncompressedSize Size of the uncompressed data of the
+ *         zip format, or -1 if the data ends with an end marker.
+ *  @return the LZMA state, which is stored in a bstring.
+ *  @exception RANGE_ERROR If the format is not 1, 2 or 3.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+bstriType lzmDecodeInit (intType format, intType uncompressedSize)
+
+  {
+    lzmaStateRecord state;
+    bstriType result;
+
+  /* lzmDecodeInit */
+    logFunction(printf("lzmDecodeInit(" FMT_D ", " FMT_D ")\n",
+                       format, uncompressedSize););
+    if (unlikely(format < LZMA_FORMAT_ALONE || format > LZMA_FORMAT_XZ)) {
+      logError(printf("lzmDecodeInit(" FMT_D ", " FMT_D "): "
+                      "Illegal format.\n", format, uncompressedSize););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else if (unlikely(!ALLOC_BSTRI_SIZE_OK(result, STATE_AREA_SIZE))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      memset(&state, 0, sizeof(lzmaStateRecord));
+      state.format = (uint32Type) format;
+      switch (format) {
+        case LZMA_FORMAT_ALONE: state.mode = MODE_ALONE_HEADER;  break;
+        case LZMA_FORMAT_ZIP:   state.mode = MODE_ZIP_HEADER;    break;
+        default:                state.mode = MODE_STREAM_HEADER; break;
+      } /* switch */
+      if (format == LZMA_FORMAT_ZIP && uncompressedSize >= 0) {
+        state.unpackSizeKnown = 1;
+        state.unpackSize = (uint64Type) uncompressedSize;
+      } /* if */
+      result->size = STATE_AREA_SIZE;
+      memset(result->mem, 0, STATE_AREA_SIZE);
+      memcpy(result->mem, &state, sizeof(lzmaStateRecord));
+    } /* if */
+    return result;
+  } /* lzmDecodeInit */
+
+
+
+/**
+ *  Determine if the end of the LZMA data has been reached.
+ *  @param stateBstri LZMA state created with lzmDecodeInit().
+ *  @return TRUE if the data has been decompressed completely,
+ *          FALSE otherwise.
+ *  @exception RANGE_ERROR If 'stateBstri' is not a valid LZMA state.
+ */
+boolType lzmDecodeFinished (const const_bstriType stateBstri)
+
+  {
+    lzmaStateRecord state;
+    boolType finished;
+
+  /* lzmDecodeFinished */
+    if (unlikely(!getLzmaState(stateBstri, &state))) {
+      logError(printf("lzmDecodeFinished(*): Illegal LZMA state.\n"););
+      raise_error(RANGE_ERROR);
+      finished = FALSE;
+    } else {
+      finished = state.mode == MODE_FINISHED;
+    } /* if */
+    return finished;
+  } /* lzmDecodeFinished */
+
+
+
+/**
+ *  Decompress LZMA data from 'compressed' starting at '*bytePos'.
+ *  Decompression continues until at least 'minLength' bytes have
+ *  been produced, the end of the data is reached or more input is
+ *  needed. Afterwards '*bytePos' refers to the first byte that has
+ *  not been consumed. At the end of the data it refers to the first
+ *  byte after the compressed data. For the XZ format this is the
+ *  first byte after the stream footer.
+ *  @param stateBstri Variable with an LZMA state created with
+ *         lzmDecodeInit(). The state grows, when the size of the
+ *         dictionary is known.
+ *  @param inputEnd TRUE if no data follows after 'compressed'.
+ *  @param minLength Minimum length of the result.
+ *  @return the decompressed bytes.
+ *  @exception RANGE_ERROR If the state is not valid, if 'compressed'
+ *             is not in the format of the state or if it contains
+ *             a character beyond '\255;'. The state cannot be used
+ *             afterwards.
+ *  @exception INDEX_ERROR If '*bytePos' is not in the range 1 to
+ *             length(compressed) + 1.
+ *  @exception MEMORY_ERROR Not enough memory for the dictionary or
+ *             to represent the result.
+ */
+striType lzmDecodeStep (bstriType *const stateBstri,
+    const const_striType compressed, intType *const bytePos,
+    boolType inputEnd, intType minLength)
+
+  {
+    lzmaWorkType work;
+    ucharType *inBuffer = NULL;
+    memSizeType inLength;
+    int status;
+    striType result = NULL;
+
+  /* lzmDecodeStep */
+    logFunction(printf("lzmDecodeStep(*, \"%s\", " FMT_D ", %d, " FMT_D ")\n",
+                       striAsUnquotedCStri(compressed), *bytePos,
+                       inputEnd, minLength););
+    if (unlikely(*bytePos < 1 ||
+                 (uintType) *bytePos - 1 > compressed->size)) {
+      logError(printf("lzmDecodeStep: Byte position " FMT_D
+                      " not in range 1 .. " FMT_U_MEM ".\n",
+                      *bytePos, compressed->size + 1););
+      raise_error(INDEX_ERROR);
+    } else if (unlikely(minLength < 0)) {
+      logError(printf("lzmDecodeStep: Negative minimum length.\n"););
+      raise_error(RANGE_ERROR);
+    } else if (unlikely(!ALLOC_LZMA_WORK(work))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      if (unlikely(!getLzmaState(*stateBstri, &work->state) ||
+                   work->state.mode == MODE_ERROR)) {
+        logError(printf("lzmDecodeStep: Illegal LZMA state.\n"););
+        raise_error(RANGE_ERROR);
+      } else if (work->state.mode == MODE_FINISHED) {
+        result = bytesToStri(NULL, 0);
+      } else {
+        inLength = compressed->size - (memSizeType) (*bytePos - 1);
+        if (unlikely(inLength > MAX_MEMSIZETYPE - INPUT_SLACK ||
+                     !ALLOC_UBYTES(inBuffer, inLength + INPUT_SLACK))) {
+          raise_error(MEMORY_ERROR);
+        } else if (unlikely(memcpy_from_strelem(inBuffer,
+                                                &compressed->mem[*bytePos - 1],
+                                                inLength))) {
+          logError(printf("lzmDecodeStep: "
+                          "Character beyond '\\255;' in data.\n"););
+          raise_error(RANGE_ERROR);
+        } else {
+          memset(&inBuffer[inLength], 0, INPUT_SLACK);
+          work->stateBstri = stateBstri;
+          setPointers(work);
+          work->flushPos = work->state.dictPos;
+          work->in = inBuffer;
+          work->inLength = inLength;
+          work->inPos = 0;
+          work->inputEnd = inputEnd;
+          work->outTarget = (memSizeType) minLength;
+          if (work->outTarget < MIN_OUTPUT_CHUNK) {
+            work->outTarget = MIN_OUTPUT_CHUNK;
+          } /* if */
+          work->outCapacity = INITIAL_OUTPUT;
+          work->outPos = 0;
+          if (unlikely(!ALLOC_UBYTES(work->out, work->outCapacity))) {
+            raise_error(MEMORY_ERROR);
+          } else {
+            status = runLzma(work);
+            if (status != STATUS_MEMORY_ERROR && status != STATUS_DATA_ERROR &&
+                work->state.dictBufSize != 0 && !flushDictionary(work)) {
+              status = STATUS_MEMORY_ERROR;
+            } /* if */
+            if (status == STATUS_MEMORY_ERROR || status == STATUS_DATA_ERROR) {
+              work->state.mode = MODE_ERROR;
+              memcpy((*stateBstri)->mem, &work->state, sizeof(lzmaStateRecord));
+              raise_error(status == STATUS_MEMORY_ERROR ? MEMORY_ERROR :
+                                                          RANGE_ERROR);
+            } else {
+              result = bytesToStri(work->out, work->outPos);
+              if (result != NULL) {
+                *bytePos += (intType) work->inPos;
+                memcpy((*stateBstri)->mem, &work->state, sizeof(lzmaStateRecord));
+              } /* if */
+            } /* if */
+            FREE_BYTES(work->out, work->outCapacity);
+          } /* if */
+        } /* if */
+        if (inBuffer != NULL) {
+          FREE_BYTES(inBuffer, inLength + INPUT_SLACK);
+        } /* if */
+      } /* if */
+      FREE_LZMA_WORK(work);
+    } /* if */
+    logFunction(printf("lzmDecodeStep --> \"%s\" (bytePos=" FMT_D ")\n",
+                       striAsUnquotedCStri(result), *bytePos););
+    return result;
+  } /* lzmDecodeStep */
@@ -0,0 +1,1886 @@
+/********************************************************************/
+/*                                                                  */
+/*  mdg_rtl.c     Message digest and secure hash algorithms.        */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/mdg_rtl.c                                       */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: Message digest, secure hash and checksum algorithms.   */
+/*                                                                  */
+/*  The state of an incremental digest computation is stored in a   */
+/*  bstring. This way it is copied and freed like any other value.  */
+/*  The algorithms are numbered like the values of the enumeration  */
+/*  digestAlgorithm from msgdigest.s7i.                             */
+/*  The checksums CRC-32, CRC-32C and Adler-32 need no state        */
+/*  record: The checksum of the preceding data is the state.        */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#if HAS_SHA_INTRINSICS || HAS_PCLMUL_INTRINSICS || HAS_AVX2_INTRINSICS
+#include "immintrin.h"
+#endif
+
+#include "common.h"
+#include "os_decls.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "striutl.h"
+#include "rtl_err.h"
+
+#undef EXTERN
+#define EXTERN
+#include "mdg_rtl.h"
+
+
+#define NO_DIGEST   0
+#define MD4         1
+#define MD5         2
+#define RIPEMD160   3
+#define SHA1        4
+#define SHA224      5
+#define SHA256      6
+#define SHA384      7
+#define SHA512      8
+#define SHA3_224    9
+#define SHA3_256   10
+#define SHA3_384   11
+#define SHA3_512   12
+#define NUMBER_OF_ALGORITHMS 13
+
+#define MAX_BLOCK_SIZE     144
+#define MAX_DIGEST_SIZE     64
+#define STRI_CHUNK_SIZE   4096
+#define FILE_BUFFER_SIZE 65536
+
+#define CRC32_POLYNOMIAL       0xedb88320  /* Bit reflected 0x04c11db7 */
+#define CRC32C_POLYNOMIAL      0x82f63b78  /* Bit reflected 0x1edc6f41 */
+#define BZIP2_CRC32_POLYNOMIAL 0x04c11db7
+#define PCLMUL_MIN_LENGTH      64
+#define ADLER32_BASE        65521
+#define ADLER32_NMAX         5552
+
+#define ROTL32(x, n) ((uint32Type) ((x) << (n)) | ((x) >> (32 - (n))))
+#define ROTR32(x, n) (((x) >> (n)) | (uint32Type) ((x) << (32 - (n))))
+#define ROTL64(x, n) ((uint64Type) ((x) << (n)) | ((x) >> (64 - (n))))
+#define ROTR64(x, n) (((x) >> (n)) | (uint64Type) ((x) << (64 - (n))))
+
+typedef enum {
+    LITTLE_ENDIAN_32, BIG_ENDIAN_32, BIG_ENDIAN_64, KECCAK_SPONGE
+  } digestFamilyType;
+
+typedef struct {
+    uint32Type algorithm;
+    uint32Type bufferFill;
+    uint64Type length;
+    union {
+      uint32Type h32[8];
+      uint64Type h64[25];
+    } hash;
+    ucharType buffer[MAX_BLOCK_SIZE];
+  } digestStateRecord, *digestStateType;
+
+typedef void (*compressFuncType) (digestStateType state,
+    const ucharType *data, memSizeType numBlocks);
+
+typedef struct {
+    digestFamilyType family;
+    unsigned int blockSize;
+    unsigned int digestSize;
+    compressFuncType compress;
+  } algorithmRecord;
+
+typedef uint32Type (*checksumFuncType) (uint32Type checksum,
+    const ucharType *data, memSizeType length);
+
+/* Folding constants of a bit reflected CRC: k1 to k5 are        */
+/* x^544, x^480, x^160, x^96 and x^64 modulo the polynomial and  */
+/* mu is x^64 divided by the polynomial. All values are bit      */
+/* reflected and shifted left by one.                            */
+typedef struct {
+    uint64Type k1;
+    uint64Type k2;
+    uint64Type k3;
+    uint64Type k4;
+    uint64Type k5;
+    uint64Type polynomial;
+    uint64Type mu;
+  } pclmulConstantType;
+
+static const uint32Type md5Table[] = {
+    0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a,
+    0xa8304613, 0xfd469501, 0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be,
+    0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821, 0xf61e2562, 0xc040b340,
+    0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+    0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8,
+    0x676f02d9, 0x8d2a4c8a, 0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c,
+    0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70, 0x289b7ec6, 0xeaa127fa,
+    0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+    0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92,
+    0xffeff47d, 0x85845dd1, 0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1,
+    0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391
+  };
+
+static const unsigned char md5Shift[] = {
+    7, 12, 17, 22, 5,  9, 14, 20, 4, 11, 16, 23, 6, 10, 15, 21
+  };
+
+static const unsigned char md4Index[] = {
+    0, 1, 2,  3, 4, 5,  6,  7, 8, 9, 10, 11, 12, 13, 14, 15,
+    0, 4, 8, 12, 1, 5,  9, 13, 2, 6, 10, 14,  3,  7, 11, 15,
+    0, 8, 4, 12, 2, 10, 6, 14, 1, 9,  5, 13,  3, 11,  7, 15
+  };
+
+static const unsigned char md4Shift[] = {
+    3, 7, 11, 19, 3, 5, 9, 13, 3, 9, 11, 15
+  };
+
+static const unsigned char ripemdIndexLeft[] = {
+     0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15,
+     7,  4, 13,  1, 10,  6, 15,  3, 12,  0,  9,  5,  2, 14, 11,  8,
+     3, 10, 14,  4,  9, 15,  8,  1,  2,  7,  0,  6, 13, 11,  5, 12,
+     1,  9, 11, 10,  0,  8, 12,  4, 13,  3,  7, 15, 14,  5,  6,  2,
+     4,  0,  5,  9,  7, 12,  2, 10, 14,  1,  3,  8, 11,  6, 15, 13
+  };
+
+static const unsigned char ripemdIndexRight[] = {
+     5, 14,  7,  0,  9,  2, 11,  4, 13,  6, 15,  8,  1, 10,  3, 12,
+     6, 11,  3,  7,  0, 13,  5, 10, 14, 15,  8, 12,  4,  9,  1,  2,
+    15,  5,  1,  3,  7, 14,  6,  9, 11,  8, 12,  2, 10,  0,  4, 13,
+     8,  6,  4,  1,  3, 11, 15,  0,  5, 12,  2, 13,  9,  7, 10, 14,
+    12, 15, 10,  4,  1,  5,  8,  7,  6,  2, 13, 14,  0,  3,  9, 11
+  };
+
+static const unsigned char ripemdShiftLeft[] = {
+    11, 14, 15, 12,  5,  8,  7,  9, 11, 13, 14, 15,  6,  7,  9,  8,
+     7,  6,  8, 13, 11,  9,  7, 15,  7, 12, 15,  9, 11,  7, 13, 12,
+    11, 13,  6,  7, 14,  9, 13, 15, 14,  8, 13,  6,  5, 12,  7,  5,
+    11, 12, 14, 15, 14, 15,  9,  8,  9, 14,  5,  6,  8,  6,  5, 12,
+     9, 15,  5, 11,  6,  8, 13, 12,  5, 12, 13, 14, 11,  8,  5,  6
+  };
+
+static const unsigned char ripemdShiftRight[] = {
+     8,  9,  9, 11, 13, 15, 15,  5,  7,  7,  8, 11, 14, 14, 12,  6,
+     9, 13, 15,  7, 12,  8,  9, 11,  7,  7, 12,  7,  6, 15, 13, 11,
+     9,  7, 15, 11,  8,  6,  6, 14, 12, 13,  5, 14, 13, 13,  7,  5,
+    15,  5,  8, 11, 14, 14,  6, 14,  6,  9, 12,  9, 12,  5, 15,  8,
+     8,  5, 12,  9, 12,  5, 14,  6,  8, 13,  6,  5, 15, 13, 11, 11
+  };
+
+static const uint32Type ripemdConstLeft[] = {
+    0x00000000, 0x5a827999, 0x6ed9eba1, 0x8f1bbcdc, 0xa953fd4e
+  };
+
+static const uint32Type ripemdConstRight[] = {
+    0x50a28be6, 0x5c4dd124, 0x6d703ef3, 0x7a6d76e9, 0x00000000
+  };
+
+static const uint32Type sha256Table[] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+  };
+
+static const uint64Type sha512Table[] = {
+    0x428a2f98d728ae22, 0x7137449123ef65cd, 0xb5c0fbcfec4d3b2f, 0xe9b5dba58189dbbc,
+    0x3956c25bf348b538, 0x59f111f1b605d019, 0x923f82a4af194f9b, 0xab1c5ed5da6d8118,
+    0xd807aa98a3030242, 0x12835b0145706fbe, 0x243185be4ee4b28c, 0x550c7dc3d5ffb4e2,
+    0x72be5d74f27b896f, 0x80deb1fe3b1696b1, 0x9bdc06a725c71235, 0xc19bf174cf692694,
+    0xe49b69c19ef14ad2, 0xefbe4786384f25e3, 0x0fc19dc68b8cd5b5, 0x240ca1cc77ac9c65,
+    0x2de92c6f592b0275, 0x4a7484aa6ea6e483, 0x5cb0a9dcbd41fbd4, 0x76f988da831153b5,
+    0x983e5152ee66dfab, 0xa831c66d2db43210, 0xb00327c898fb213f, 0xbf597fc7beef0ee4,
+    0xc6e00bf33da88fc2, 0xd5a79147930aa725, 0x06ca6351e003826f, 0x142929670a0e6e70,
+    0x27b70a8546d22ffc, 0x2e1b21385c26c926, 0x4d2c6dfc5ac42aed, 0x53380d139d95b3df,
+    0x650a73548baf63de, 0x766a0abb3c77b2a8, 0x81c2c92e47edaee6, 0x92722c851482353b,
+    0xa2bfe8a14cf10364, 0xa81a664bbc423001, 0xc24b8b70d0f89791, 0xc76c51a30654be30,
+    0xd192e819d6ef5218, 0xd69906245565a910, 0xf40e35855771202a, 0x106aa07032bbd1b8,
+    0x19a4c116b8d2d0c8, 0x1e376c085141ab53, 0x2748774cdf8eeb99, 0x34b0bcb5e19b48a8,
+    0x391c0cb3c5c95a63, 0x4ed8aa4ae3418acb, 0x5b9cca4f7763e373, 0x682e6ff3d6b2b8a3,
+    0x748f82ee5defb2fc, 0x78a5636f43172f60, 0x84c87814a1f0ab72, 0x8cc702081a6439ec,
+    0x90befffa23631e28, 0xa4506cebde82bde9, 0xbef9a3f7b2c67915, 0xc67178f2e372532b,
+    0xca273eceea26619c, 0xd186b8c721c0c207, 0xeada7dd6cde0eb1e, 0xf57d4f7fee6ed178,
+    0x06f067aa72176fba, 0x0a637dc5a2c898a6, 0x113f9804bef90dae, 0x1b710b35131c471b,
+    0x28db77f523047d84, 0x32caab7b40c72493, 0x3c9ebe0a15c9bebc, 0x431d67c49c100d4c,
+    0x4cc5d4becb3e42b6, 0x597f299cfc657e2a, 0x5fcb6fab3ad6faec, 0x6c44198c4a475817
+  };
+
+static const uint64Type keccakRoundConstants[] = {
+    0x0000000000000001, 0x0000000000008082, 0x800000000000808a, 0x8000000080008000,
+    0x000000000000808b, 0x0000000080000001, 0x8000000080008081, 0x8000000000008009,
+    0x000000000000008a, 0x0000000000000088, 0x0000000080008009, 0x000000008000000a,
+    0x000000008000808b, 0x800000000000008b, 0x8000000000008089, 0x8000000000008003,
+    0x8000000000008002, 0x8000000000000080, 0x000000000000800a, 0x800000008000000a,
+    0x8000000080008081, 0x8000000000008080, 0x0000000080000001, 0x8000000080008008
+  };
+
+static const pclmulConstantType crc32PclmulConstants = {
+    0x154442bd4, 0x1c6e41596, 0x1751997d0, 0x0ccaa009e, 0x163cd6124,
+    0x1db710641, 0x1f7011641
+  };
+
+static const pclmulConstantType crc32cPclmulConstants = {
+    0x0740eef02, 0x09e4addf8, 0x0f20c0dfe, 0x14cd00bd6, 0x0dd45aab8,
+    0x105ec76f1, 0x0dea713f1
+  };
+
+static uint32Type crc32Table[8][256];
+static uint32Type crc32cTable[8][256];
+static uint32Type bzip2Crc32Table[8][256];
+static boolType crcTablesInitialized = FALSE;
+
+
+
+static inline uint32Type loadLittleEndian32 (const ucharType *bytes)
+
+  { /* loadLittleEndian32 */
+    return (uint32Type) bytes[0]         | (uint32Type) bytes[1] <<  8 |
+           (uint32Type) bytes[2] << 16   | (uint32Type) bytes[3] << 24;
+  } /* loadLittleEndian32 */
+
+
+
+static inline uint32Type loadBigEndian32 (const ucharType *bytes)
+
+  { /* loadBigEndian32 */
+    return (uint32Type) bytes[0] << 24   | (uint32Type) bytes[1] << 16 |
+           (uint32Type) bytes[2] <<  8   | (uint32Type) bytes[3];
+  } /* loadBigEndian32 */
+
+
+
+static inline uint64Type loadLittleEndian64 (const ucharType *bytes)
+
+  { /* loadLittleEndian64 */
+    return (uint64Type) loadLittleEndian32(bytes) |
+           (uint64Type) loadLittleEndian32(&bytes[4]) << 32;
+  } /* loadLittleEndian64 */
+
+
+
+static inline uint64Type loadBigEndian64 (const ucharType *bytes)
+
+  { /* loadBigEndian64 */
+    return (uint64Type) loadBigEndian32(bytes) << 32 |
+           (uint64Type) loadBigEndian32(&bytes[4]);
+  } /* loadBigEndian64 */
+
+
+
+static void storeBigEndian64 (ucharType *bytes, uint64Type number)
+
+  {
+    int pos;
+
+  /* storeBigEndian64 */
+    for (pos = 7; pos >= 0; pos--) {
+      bytes[pos] = (ucharType) (number & 0xff);
+      number >>= 8;
+    } /* for */
+  } /* storeBigEndian64 */
+
+
+
+static void md4Compress (digestStateType state, const ucharType *data,
+    memSizeType numBlocks)
+
+  {
+    uint32Type x[16];
+    uint32Type a, b, c, d;
+    uint32Type temp;
+    unsigned int index;
+
+  /* md4Compress */
+    for (; numBlocks != 0; numBlocks--) {
+      for (index = 0; index < 16; index++) {
+        x[index] = loadLittleEndian32(&data[4 * index]);
+      } /* for */
+      a = state->hash.h32[0];
+      b = state->hash.h32[1];
+      c = state->hash.h32[2];
+      d = state->hash.h32[3];
+      for (index = 0; index < 48; index++) {
+        if (index < 16) {
+          temp = a + ((b & c) | (~b & d));
+        } else if (index < 32) {
+          temp = a + ((b & c) | (b & d) | (c & d)) + 0x5a827999;
+        } else {
+          temp = a + (b ^ c ^ d) + 0x6ed9eba1;
+        } /* if */
+        temp += x[md4Index[index]];
+        a = d;
+        d = c;
+        c = b;
+        b = ROTL32(temp, md4Shift[(index >> 4) * 4 + (index & 3)]);
+      } /* for */
+      state->hash.h32[0] += a;
+      state->hash.h32[1] += b;
+      state->hash.h32[2] += c;
+      state->hash.h32[3] += d;
+      data += 64;
+    } /* for */
+  } /* md4Compress */
+
+
+
+static void md5Compress (digestStateType state, const ucharType *data,
+    memSizeType numBlocks)
+
+  {
+    uint32Type x[16];
+    uint32Type a, b, c, d;
+    uint32Type f;
+    unsigned int g;
+    uint32Type temp;
+    unsigned int index;
+
+  /* md5Compress */
+    for (; numBlocks != 0; numBlocks--) {
+      for (index = 0; index < 16; index++) {
+        x[index] = loadLittleEndian32(&data[4 * index]);
+      } /* for */
+      a = state->hash.h32[0];
+      b = state->hash.h32[1];
+      c = state->hash.h32[2];
+      d = state->hash.h32[3];
+      for (index = 0; index < 64; index++) {
+        if (index < 16) {
+          f = d ^ (b & (c ^ d));
+          g = index;
+        } else if (index < 32) {
+          f = c ^ (d & (b ^ c));
+          g = (5 * index + 1) & 15;
+        } else if (index < 48) {
+          f = b ^ c ^ d;
+          g = (3 * index + 5) & 15;
+        } else {
+          f = c ^ (b | ~d);
+          g = (7 * index) & 15;
+        } /* if */
+        temp = a + f + md5Table[index] + x[g];
+        a = d;
+        d = c;
+        c = b;
+        b += ROTL32(temp, md5Shift[(index >> 4) * 4 + (index & 3)]);
+      } /* for */
+      state->hash.h32[0] += a;
+      state->hash.h32[1] += b;
+      state->hash.h32[2] += c;
+      state->hash.h32[3] += d;
+      data += 64;
+    } /* for */
+  } /* md5Compress */
+
+
+
+static inline uint32Type ripemdFunction (unsigned int round,
+    uint32Type x, uint32Type y, uint32Type z)
+
+  {
+    uint32Type result;
+
+  /* ripemdFunction */
+    switch (round) {
+      case 0:  result = x ^ y ^ z;           break;
+      case 1:  result = (x & y) | (~x & z);  break;
+      case 2:  result = (x | ~y) ^ z;        break;
+      case 3:  result = (x & z) | (y & ~z);  break;
+      default: result = x ^ (y | ~z);        break;
+    } /* switch */
+    return result;
+  } /* ripemdFunction */
+
+
+
+static void ripemd160Compress (digestStateType state, const ucharType *data,
+    memSizeType numBlocks)
+
+  {
+    uint32Type x[16];
+    uint32Type a, b, c, d, e;
+    uint32Type a2, b2, c2, d2, e2;
+    uint32Type temp;
+    unsigned int index;
+
+  /* ripemd160Compress */
+    for (; numBlocks != 0; numBlocks--) {
+      for (index = 0; index < 16; index++) {
+        x[index] = loadLittleEndian32(&data[4 * index]);
+      } /* for */
+      a = a2 = state->hash.h32[0];
+      b = b2 = state->hash.h32[1];
+      c = c2 = state->hash.h32[2];
+      d = d2 = state->hash.h32[3];
+      e = e2 = state->hash.h32[4];
+      for (index = 0; index < 80; index++) {
+        temp = a + ripemdFunction(index >> 4, b, c, d) +
+               x[ripemdIndexLeft[index]] + ripemdConstLeft[index >> 4];
+        temp = ROTL32(temp, ripemdShiftLeft[index]) + e;
+        a = e;
+        e = d;
+        d = ROTL32(c, 10);
+        c = b;
+        b = temp;
+        temp = a2 + ripemdFunction(4 - (index >> 4), b2, c2, d2) +
+               x[ripemdIndexRight[index]] + ripemdConstRight[index >> 4];
+        temp = ROTL32(temp, ripemdShiftRight[index]) + e2;
+        a2 = e2;
+        e2 = d2;
+        d2 = ROTL32(c2, 10);
+        c2 = b2;
+        b2 = temp;
+      } /* for */
+      temp = state->hash.h32[1] + c + d2;
+      state->hash.h32[1] = state->hash.h32[2] + d + e2;
+      state->hash.h32[2] = state->hash.h32[3] + e + a2;
+      state->hash.h32[3] = state->hash.h32[4] + a + b2;
+      state->hash.h32[4] = state->hash.h32[0] + b + c2;
+      state->hash.h32[0] = temp;
+      data += 64;
+    } /* for */
+  } /* ripemd160Compress */
+
+
+
+static void sha1CompressGeneric (digestStateType state, const ucharType *data,
+    memSizeType numBlocks)
+
+  {
+    uint32Type w[80];
+    uint32Type a, b, c, d, e;
+    uint32Type temp;
+    unsigned int index;
+
+  /* sha1CompressGeneric */
+    for (; numBlocks != 0; numBlocks--) {
+      for (index = 0; index < 16; index++) {
+        w[index] = loadBigEndian32(&data[4 * index]);
+      } /* for */
+      for (index = 16; index < 80; index++) {
+        temp = w[index - 3] ^ w[index - 8] ^ w[index - 14] ^ w[index - 16];
+        w[index] = ROTL32(temp, 1);
+      } /* for */
+      a = state->hash.h32[0];
+      b = state->hash.h32[1];
+      c = state->hash.h32[2];
+      d = state->hash.h32[3];
+      e = state->hash.h32[4];
+      for (index = 0; index < 80; index++) {
+        if (index < 20) {
+          temp = (d ^ (b & (c ^ d))) + 0x5a827999;
+        } else if (index < 40) {
+          temp = (b ^ c ^ d) + 0x6ed9eba1;
+        } else if (index < 60) {
+          temp = ((b & c) | (d & (b | c))) + 0x8f1bbcdc;
+        } else {
+          temp = (b ^ c ^ d) + 0xca62c1d6;
+        } /* if */
+        temp += ROTL32(a, 5) + e + w[index];
+        e = d;
+        d = c;
+        c = ROTL32(b, 30);
+        b = a;
+        a = temp;
+      } /* for */
+      state->hash.h32[0] += a;
+      state->hash.h32[1] += b;
+      state->hash.h32[2] += c;
+      state->hash.h32[3] += d;
+      state->hash.h32[4] += e;
+      data += 64;
+    } /* for */
+  } /* sha1CompressGeneric */
+
+
+
+static void sha256CompressGeneric (digestStateType state,
+    const ucharType *data, memSizeType numBlocks)
+
+  {
+    uint32Type w[64];
+    uint32Type h[8];
+    uint32Type s0, s1;
+    uint32Type temp1, temp2;
+    unsigned int index;
+
+  /* sha256CompressGeneric */
+    for (; numBlocks != 0; numBlocks--) {
+      for (index = 0; index < 16; index++) {
+        w[index] = loadBigEndian32(&data[4 * index]);
+      } /* for */
+      for (index = 16; index < 64; index++) {
+        s0 = ROTR32(w[index - 15], 7) ^ ROTR32(w[index - 15], 18) ^
+             (w[index - 15] >> 3);
+        s1 = ROTR32(w[index - 2], 17) ^ ROTR32(w[index - 2], 19) ^
+             (w[index - 2] >> 10);
+        w[index] = w[index - 16] + s0 + w[index - 7] + s1;
+      } /* for */
+      memcpy(h, state->hash.h32, sizeof(h));
+      for (index = 0; index < 64; index++) {
+        s1 = ROTR32(h[4], 6) ^ ROTR32(h[4], 11) ^ ROTR32(h[4], 25);
+        temp1 = h[7] + s1 + (h[6] ^ (h[4] & (h[5] ^ h[6]))) +
+                sha256Table[index] + w[index];
+        s0 = ROTR32(h[0], 2) ^ ROTR32(h[0], 13) ^ ROTR32(h[0], 22);
+        temp2 = s0 + ((h[0] & h[1]) | (h[2] & (h[0] | h[1])));
+        h[7] = h[6];
+        h[6] = h[5];
+        h[5] = h[4];
+        h[4] = h[3] + temp1;
+        h[3] = h[2];
+        h[2] = h[1];
+        h[1] = h[0];
+        h[0] = temp1 + temp2;
+      } /* for */
+      for (index = 0; index < 8; index++) {
+        state->hash.h32[index] += h[index];
+      } /* for */
+      data += 64;
+    } /* for */
+  } /* sha256CompressGeneric */
+
+
+
+#if HAS_SHA_INTRINSICS
+/**
+ *  SHA-1 variant of the compression function with SHA extensions.
+ *  Every sha1rnds4 instruction computes four rounds. The round
+ *  function must be an immediate, hence one macro per function.
+ *  This function must only be called if the CPU supports SHA.
+ */
+__attribute__((target("sha,sse4.1")))
+static void sha1CompressShaNi (digestStateType state, const ucharType *data,
+    memSizeType numBlocks)
+
+  {
+    const __m128i byteOrder = _mm_set_epi64x(0x0001020304050607LL,
+                                             0x08090a0b0c0d0e0fLL);
+    __m128i abcd, abcdSave, previousAbcd;
+    __m128i e0, e0Save, e;
+    __m128i msg[4];
+    unsigned int group;
+    unsigned int count;
+
+  /* sha1CompressShaNi */
+    abcd = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *) state->hash.h32), 0x1b);
+    e0 = _mm_set_epi32((int) state->hash.h32[4], 0, 0, 0);
+    for (; numBlocks != 0; numBlocks--) {
+      abcdSave = abcd;
+      e0Save = e0;
+      previousAbcd = abcd;
+      for (group = 0; group < 4; group++) {
+        msg[group] = _mm_shuffle_epi8(_mm_loadu_si128(
+            (const __m128i *) &data[16 * group]), byteOrder);
+      } /* for */
+      group = 0;
+#define SHA1_FIVE_GROUPS(function) \
+      for (count = 0; count < 5; count++) { \
+        if (group >= 4) { \
+          msg[group & 3] = _mm_sha1msg2_epu32(_mm_xor_si128( \
+              _mm_sha1msg1_epu32(msg[group & 3], msg[(group + 1) & 3]), \
+              msg[(group + 2) & 3]), msg[(group + 3) & 3]); \
+        } \
+        if (group == 0) { \
+          e = _mm_add_epi32(e0, msg[0]); \
+        } else { \
+          e = _mm_sha1nexte_epu32(previousAbcd, msg[group & 3]); \
+        } \
+        previousAbcd = abcd; \
+        abcd = _mm_sha1rnds4_epu32(abcd, e, function); \
+        group++; \
+      }
+      SHA1_FIVE_GROUPS(0);
+      SHA1_FIVE_GROUPS(1);
+      SHA1_FIVE_GROUPS(2);
+      SHA1_FIVE_GROUPS(3);
+#undef SHA1_FIVE_GROUPS
+      e0 = _mm_sha1nexte_epu32(previousAbcd, e0Save);
+      abcd = _mm_add_epi32(abcd, abcdSave);
+      data += 64;
+    } /* for */
+    _mm_storeu_si128((__m128i *) state->hash.h32, _mm_shuffle_epi32(abcd, 0x1b));
+    state->hash.h32[4] = (uint32Type) _mm_extract_epi32(e0, 3);
+  } /* sha1CompressShaNi */
+
+
+
+/**
+ *  SHA-256 variant of the compression function with SHA extensions.
+ *  Every sha256rnds2 instruction computes two rounds.
+ *  This function must only be called if the CPU supports SHA.
+ */
+__attribute__((target("sha,sse4.1")))
+static void sha256CompressShaNi (digestStateType state,
+    const ucharType *data, memSizeType numBlocks)
+
+  {
+    const __m128i byteOrder = _mm_set_epi64x(0x0c0d0e0f08090a0bLL,
+                                             0x0405060700010203LL);
+    __m128i state0, state1, abefSave, cdghSave;
+    __m128i temp;
+    __m128i msg[4];
+    unsigned int group;
+
+  /* sha256CompressShaNi */
+    temp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *) &state->hash.h32[0]), 0xb1);
+    state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *) &state->hash.h32[4]), 0x1b);
+    state0 = _mm_alignr_epi8(temp, state1, 8);      /* ABEF */
+    state1 = _mm_blend_epi16(state1, temp, 0xf0);   /* CDGH */
+    for (; numBlocks != 0; numBlocks--) {
+      abefSave = state0;
+      cdghSave = state1;
+      for (group = 0; group < 16; group++) {
+        if (group < 4) {
+          msg[group] = _mm_shuffle_epi8(_mm_loadu_si128(
+              (const __m128i *) &data[16 * group]), byteOrder);
+        } else {
+          temp = _mm_add_epi32(
+              _mm_sha256msg1_epu32(msg[group & 3], msg[(group + 1) & 3]),
+              _mm_alignr_epi8(msg[(group + 3) & 3], msg[(group + 2) & 3], 4));
+          msg[group & 3] = _mm_sha256msg2_epu32(temp, msg[(group + 3) & 3]);
+        } /* if */
+        temp = _mm_add_epi32(msg[group & 3],
+            _mm_loadu_si128((const __m128i *) &sha256Table[4 * group]));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, temp);
+        state0 = _mm_sha256rnds2_epu32(state0, state1,
+                                       _mm_shuffle_epi32(temp, 0x0e));
+      } /* for */
+      state0 = _mm_add_epi32(state0, abefSave);
+      state1 = _mm_add_epi32(state1, cdghSave);
+      data += 64;
+    } /* for */
+    temp = _mm_shuffle_epi32(state0, 0x1b);         /* FEBA */
+    state1 = _mm_shuffle_epi32(state1, 0xb1);       /* DCHG */
+    _mm_storeu_si128((__m128i *) &state->hash.h32[0],
+                     _mm_blend_epi16(temp, state1, 0xf0));   /* DCBA */
+    _mm_storeu_si128((__m128i *) &state->hash.h32[4],
+                     _mm_alignr_epi8(state1, temp, 8));      /* HGFE */
+  } /* sha256CompressShaNi */
+#endif
+
+
+
+static void sha1Compress (digestStateType state, const ucharType *data,
+    memSizeType numBlocks)
+
+  { /* sha1Compress */
+#if HAS_SHA_INTRINSICS
+    if (__builtin_cpu_supports("sha")) {
+      sha1CompressShaNi(state, data, numBlocks);
+    } else {
+      sha1CompressGeneric(state, data, numBlocks);
+    } /* if */
+#else
+    sha1CompressGeneric(state, data, numBlocks);
+#endif
+  } /* sha1Compress */
+
+
+
+static void sha256Compress (digestStateType state, const ucharType *data,
+    memSizeType numBlocks)
+
+  { /* sha256Compress */
+#if HAS_SHA_INTRINSICS
+    if (__builtin_cpu_supports("sha")) {
+      sha256CompressShaNi(state, data, numBlocks);
+    } else {
+      sha256CompressGeneric(state, data, numBlocks);
+    } /* if */
+#else
+    sha256CompressGeneric(state, data, numBlocks);
+#endif
+  } /* sha256Compress */
+
+
+
+static void sha512Compress (digestStateType state, const ucharType *data,
+    memSizeType numBlocks)
+
+  {
+    uint64Type w[80];
+    uint64Type h[8];
+    uint64Type s0, s1;
+    uint64Type temp1, temp2;
+    unsigned int index;
+
+  /* sha512Compress */
+    for (; numBlocks != 0; numBlocks--) {
+      for (index = 0; index < 16; index++) {
+        w[index] = loadBigEndian64(&data[8 * index]);
+      } /* for */
+      for (index = 16; index < 80; index++) {
+        s0 = ROTR64(w[index - 15], 1) ^ ROTR64(w[index - 15], 8) ^
+             (w[index - 15] >> 7);
+        s1 = ROTR64(w[index - 2], 19) ^ ROTR64(w[index - 2], 61) ^
+             (w[index - 2] >> 6);
+        w[index] = w[index - 16] + s0 + w[index - 7] + s1;
+      } /* for */
+      memcpy(h, state->hash.h64, sizeof(h));
+      for (index = 0; index < 80; index++) {
+        s1 = ROTR64(h[4], 14) ^ ROTR64(h[4], 18) ^ ROTR64(h[4], 41);
+        temp1 = h[7] + s1 + (h[6] ^ (h[4] & (h[5] ^ h[6]))) +
+                sha512Table[index] + w[index];
+        s0 = ROTR64(h[0], 28) ^ ROTR64(h[0], 34) ^ ROTR64(h[0], 39);
+        temp2 = s0 + ((h[0] & h[1]) | (h[2] & (h[0] | h[1])));
+        h[7] = h[6];
+        h[6] = h[5];
+        h[5] = h[4];
+        h[4] = h[3] + temp1;
+        h[3] = h[2];
+        h[2] = h[1];
+        h[1] = h[0];
+        h[0] = temp1 + temp2;
+      } /* for */
+      for (index = 0; index < 8; index++) {
+        state->hash.h64[index] += h[index];
+      } /* for */
+      data += 128;
+    } /* for */
+  } /* sha512Compress */
+
+
+
+/**
+ *  Keccak-f[1600] permutation of the 25 lanes in 'lane'.
+ *  The rho and pi steps are combined and written out with constant
+ *  indices and rotation counts. This keeps the lanes in registers.
+ */
+static void keccakPermute (uint64Type lane[25])
+
+  {
+    uint64Type c0, c1, c2, c3, c4;
+    uint64Type d0, d1, d2, d3, d4;
+    uint64Type b[25];
+    unsigned int round;
+    unsigned int y;
+
+  /* keccakPermute */
+    for (round = 0; round < 24; round++) {
+      /* Theta */
+      c0 = lane[0] ^ lane[5] ^ lane[10] ^ lane[15] ^ lane[20];
+      c1 = lane[1] ^ lane[6] ^ lane[11] ^ lane[16] ^ lane[21];
+      c2 = lane[2] ^ lane[7] ^ lane[12] ^ lane[17] ^ lane[22];
+      c3 = lane[3] ^ lane[8] ^ lane[13] ^ lane[18] ^ lane[23];
+      c4 = lane[4] ^ lane[9] ^ lane[14] ^ lane[19] ^ lane[24];
+      d0 = c4 ^ ROTL64(c1, 1);
+      d1 = c0 ^ ROTL64(c2, 1);
+      d2 = c1 ^ ROTL64(c3, 1);
+      d3 = c2 ^ ROTL64(c4, 1);
+      d4 = c3 ^ ROTL64(c0, 1);
+      /* Rho and pi */
+      b[ 0] =        lane[ 0] ^ d0;
+      b[ 1] = ROTL64(lane[ 6] ^ d1, 44);
+      b[ 2] = ROTL64(lane[12] ^ d2, 43);
+      b[ 3] = ROTL64(lane[18] ^ d3, 21);
+      b[ 4] = ROTL64(lane[24] ^ d4, 14);
+      b[ 5] = ROTL64(lane[ 3] ^ d3, 28);
+      b[ 6] = ROTL64(lane[ 9] ^ d4, 20);
+      b[ 7] = ROTL64(lane[10] ^ d0,  3);
+      b[ 8] = ROTL64(lane[16] ^ d1, 45);
+      b[ 9] = ROTL64(lane[22] ^ d2, 61);
+      b[10] = ROTL64(lane[ 1] ^ d1,  1);
+      b[11] = ROTL64(lane[ 7] ^ d2,  6);
+      b[12] = ROTL64(lane[13] ^ d3, 25);
+      b[13] = ROTL64(lane[19] ^ d4,  8);
+      b[14] = ROTL64(lane[20] ^ d0, 18);
+      b[15] = ROTL64(lane[ 4] ^ d4, 27);
+      b[16] = ROTL64(lane[ 5] ^ d0, 36);
+      b[17] = ROTL64(lane[11] ^ d1, 10);
+      b[18] = ROTL64(lane[17] ^ d2, 15);
+      b[19] = ROTL64(lane[23] ^ d3, 56);
+      b[20] = ROTL64(lane[ 2] ^ d2, 62);
+      b[21] = ROTL64(lane[ 8] ^ d3, 55);
+      b[22] = ROTL64(lane[14] ^ d4, 39);
+      b[23] = ROTL64(lane[15] ^ d0, 41);
+      b[24] = ROTL64(lane[21] ^ d1,  2);
+      /* Chi */
+      for (y = 0; y < 25; y += 5) {
+        lane[y    ] = b[y    ] ^ (~b[y + 1] & b[y + 2]);
+        lane[y + 1] = b[y + 1] ^ (~b[y + 2] & b[y + 3]);
+        lane[y + 2] = b[y + 2] ^ (~b[y + 3] & b[y + 4]);
+        lane[y + 3] = b[y + 3] ^ (~b[y + 4] & b[y    ]);
+        lane[y + 4] = b[y + 4] ^ (~b[y    ] & b[y + 1]);
+      } /* for */
+      /* Iota */
+      lane[0] ^= keccakRoundConstants[round];
+    } /* for */
+  } /* keccakPermute */
+
+
+
+static void sha3Compress (digestStateType state, const ucharType *data,
+    memSizeType numBlocks)
+
+  {
+    unsigned int rate;
+    unsigned int index;
+
+  /* sha3Compress */
+    /* The rate of SHA3 is 200 bytes minus two times the digest size. */
+    switch (state->algorithm) {
+      case SHA3_224: rate = 144; break;
+      case SHA3_256: rate = 136; break;
+      case SHA3_384: rate = 104; break;
+      default:       rate =  72; break;
+    } /* switch */
+    for (; numBlocks != 0; numBlocks--) {
+      for (index = 0; index < rate / 8; index++) {
+        state->hash.h64[index] ^= loadLittleEndian64(&data[8 * index]);
+      } /* for */
+      keccakPermute(state->hash.h64);
+      data += rate;
+    } /* for */
+  } /* sha3Compress */
+
+
+
+static const algorithmRecord algorithmTable[NUMBER_OF_ALGORITHMS] = {
+    /* NO_DIGEST */ {LITTLE_ENDIAN_32,   0,  0, NULL},
+    /* MD4       */ {LITTLE_ENDIAN_32,  64, 16, md4Compress},
+    /* MD5       */ {LITTLE_ENDIAN_32,  64, 16, md5Compress},
+    /* RIPEMD160 */ {LITTLE_ENDIAN_32,  64, 20, ripemd160Compress},
+    /* SHA1      */ {BIG_ENDIAN_32,     64, 20, sha1Compress},
+    /* SHA224    */ {BIG_ENDIAN_32,     64, 28, sha256Compress},
+    /* SHA256    */ {BIG_ENDIAN_32,     64, 32, sha256Compress},
+    /* SHA384    */ {BIG_ENDIAN_64,    128, 48, sha512Compress},
+    /* SHA512    */ {BIG_ENDIAN_64,    128, 64, sha512Compress},
+    /* SHA3_224  */ {KECCAK_SPONGE,    144, 28, sha3Compress},
+    /* SHA3_256  */ {KECCAK_SPONGE,    136, 32, sha3Compress},
+    /* SHA3_384  */ {KECCAK_SPONGE,    104, 48, sha3Compress},
+    /* SHA3_512  */ {KECCAK_SPONGE,     72, 64, sha3Compress}
+  };
+
+
+
+/**
+ *  Initialize 'state' for the algorithm with the number 'digestAlg'.
+ *  @return TRUE if 'digestAlg' is a known algorithm, FALSE otherwise.
+ */
+static boolType initState (digestStateType state, intType digestAlg)
+
+  {
+    static const uint32Type sha224Init[] = {
+        0xc1059ed8, 0x367cd507, 0x3070dd17, 0xf70e5939,
+        0xffc00b31, 0x68581511, 0x64f98fa7, 0xbefa4fa4
+      };
+    static const uint32Type sha256Init[] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+      };
+    static const uint64Type sha384Init[] = {
+        0xcbbb9d5dc1059ed8, 0x629a292a367cd507, 0x9159015a3070dd17,
+        0x152fecd8f70e5939, 0x67332667ffc00b31, 0x8eb44a8768581511,
+        0xdb0c2e0d64f98fa7, 0x47b5481dbefa4fa4
+      };
+    static const uint64Type sha512Init[] = {
+        0x6a09e667f3bcc908, 0xbb67ae8584caa73b, 0x3c6ef372fe94f82b,
+        0xa54ff53a5f1d36f1, 0x510e527fade682d1, 0x9b05688c2b3e6c1f,
+        0x1f83d9abfb41bd6b, 0x5be0cd19137e2179
+      };
+    boolType okay = TRUE;
+
+  /* initState */
+    memset(state, 0, sizeof(digestStateRecord));
+    state->algorithm = (uint32Type) digestAlg;
+    switch (digestAlg) {
+      case NO_DIGEST:
+        break;
+      case MD4:
+      case MD5:
+      case RIPEMD160:
+      case SHA1:
+        state->hash.h32[0] = 0x67452301;
+        state->hash.h32[1] = 0xefcdab89;
+        state->hash.h32[2] = 0x98badcfe;
+        state->hash.h32[3] = 0x10325476;
+        state->hash.h32[4] = 0xc3d2e1f0;
+        break;
+      case SHA224:
+        memcpy(state->hash.h32, sha224Init, sizeof(sha224Init));
+        break;
+      case SHA256:
+        memcpy(state->hash.h32, sha256Init, sizeof(sha256Init));
+        break;
+      case SHA384:
+        memcpy(state->hash.h64, sha384Init, sizeof(sha384Init));
+        break;
+      case SHA512:
+        memcpy(state->hash.h64, sha512Init, sizeof(sha512Init));
+        break;
+      case SHA3_224:
+      case SHA3_256:
+      case SHA3_384:
+      case SHA3_512:
+        break;
+      default:
+        okay = FALSE;
+        break;
+    } /* switch */
+    return okay;
+  } /* initState */
+
+
+
+static void updateBytes (digestStateType state, const ucharType *data,
+    memSizeType length)
+
+  {
+    const algorithmRecord *algorithm;
+    memSizeType bytesToCopy;
+    memSizeType numBlocks;
+
+  /* updateBytes */
+    algorithm = &algorithmTable[state->algorithm];
+    if (algorithm->compress != NULL) {
+      state->length += length;
+      if (state->bufferFill != 0) {
+        bytesToCopy = algorithm->blockSize - state->bufferFill;
+        if (length < bytesToCopy) {
+          bytesToCopy = length;
+        } /* if */
+        memcpy(&state->buffer[state->bufferFill], data, bytesToCopy);
+        state->bufferFill += (uint32Type) bytesToCopy;
+        data += bytesToCopy;
+        length -= bytesToCopy;
+        if (state->bufferFill == algorithm->blockSize) {
+          algorithm->compress(state, state->buffer, 1);
+          state->bufferFill = 0;
+        } /* if */
+      } /* if */
+      if (length >= algorithm->blockSize) {
+        numBlocks = length / algorithm->blockSize;
+        algorithm->compress(state, data, numBlocks);
+        data += numBlocks * algorithm->blockSize;
+        length -= numBlocks * algorithm->blockSize;
+      } /* if */
+      if (length != 0) {
+        /* If bufferFill is not zero the whole data has been consumed. */
+        memcpy(state->buffer, data, length);
+        state->bufferFill = (uint32Type) length;
+      } /* if */
+    } /* if */
+  } /* updateBytes */
+
+
+
+/**
+ *  Feed the characters of a string to the digest computation.
+ *  The characters are converted to bytes in chunks.
+ *  @return TRUE if all characters are bytes, FALSE if a character
+ *          beyond '\255;' was found.
+ */
+static boolType updateStri (digestStateType state, const strElemType *stri,
+    memSizeType length)
+
+  {
+    ucharType bytes[STRI_CHUNK_SIZE];
+    memSizeType chunkSize;
+    boolType okay = TRUE;
+
+  /* updateStri */
+    while (length != 0 && okay) {
+      chunkSize = length < STRI_CHUNK_SIZE ? length : STRI_CHUNK_SIZE;
+      if (unlikely(memcpy_from_strelem(bytes, stri, chunkSize))) {
+        okay = FALSE;
+      } else {
+        updateBytes(state, bytes, chunkSize);
+        stri += chunkSize;
+        length -= chunkSize;
+      } /* if */
+    } /* while */
+    return okay;
+  } /* updateStri */
+
+
+
+/**
+ *  Pad the message and write the digest of 'state' to 'digest'.
+ *  The state is changed by this function.
+ */
+static void finalizeState (digestStateType state, ucharType *digest)
+
+  {
+    const algorithmRecord *algorithm;
+    unsigned int blockSize;
+    unsigned int fill;
+    uint64Type bitLength;
+    unsigned int pos;
+
+  /* finalizeState */
+    algorithm = &algorithmTable[state->algorithm];
+    blockSize = algorithm->blockSize;
+    fill = state->bufferFill;
+    if (algorithm->family == KECCAK_SPONGE) {
+      memset(&state->buffer[fill], 0, blockSize - fill);
+      state->buffer[fill] = 0x06;
+      state->buffer[blockSize - 1] |= 0x80;
+      algorithm->compress(state, state->buffer, 1);
+      for (pos = 0; pos < algorithm->digestSize; pos++) {
+        digest[pos] = (ucharType) (state->hash.h64[pos >> 3] >> (8 * (pos & 7)));
+      } /* for */
+    } else if (algorithm->compress != NULL) {
+      state->buffer[fill] = 0x80;
+      fill++;
+      if (fill > blockSize - blockSize / 8) {
+        /* The length does not fit into this block. */
+        memset(&state->buffer[fill], 0, blockSize - fill);
+        algorithm->compress(state, state->buffer, 1);
+        fill = 0;
+      } /* if */
+      memset(&state->buffer[fill], 0, blockSize - fill);
+      bitLength = state->length << 3;
+      if (algorithm->family == LITTLE_ENDIAN_32) {
+        for (pos = 0; pos < 8; pos++) {
+          state->buffer[blockSize - 8 + pos] = (ucharType) (bitLength >> (8 * pos));
+        } /* for */
+      } else {
+        storeBigEndian64(&state->buffer[blockSize - 8], bitLength);
+        if (algorithm->family == BIG_ENDIAN_64) {
+          storeBigEndian64(&state->buffer[blockSize - 16], state->length >> 61);
+        } /* if */
+      } /* if */
+      algorithm->compress(state, state->buffer, 1);
+      for (pos = 0; pos < algorithm->digestSize; pos++) {
+        if (algorithm->family == LITTLE_ENDIAN_32) {
+          digest[pos] = (ucharType) (state->hash.h32[pos >> 2] >> (8 * (pos & 3)));
+        } else if (algorithm->family == BIG_ENDIAN_32) {
+          digest[pos] = (ucharType) (state->hash.h32[pos >> 2] >> (8 * (3 - (pos & 3))));
+        } else {
+          digest[pos] = (ucharType) (state->hash.h64[pos >> 3] >> (8 * (7 - (pos & 7))));
+        } /* if */
+      } /* for */
+    } /* if */
+  } /* finalizeState */
+
+
+
+/**
+ *  Initialize the slicing-by-8 tables of the CRC algorithms.
+ *  Table 0 is the classic byte table. Table k maps a byte to the
+ *  CRC of this byte followed by k zero bytes.
+ */
+static void initCrcTables (void)
+
+  {
+    unsigned int index;
+    unsigned int bit;
+    unsigned int tableNum;
+    uint32Type crc;
+    uint32Type crcC;
+    uint32Type crcBzip2;
+
+  /* initCrcTables */
+    for (index = 0; index < 256; index++) {
+      crc = index;
+      crcC = index;
+      crcBzip2 = (uint32Type) index << 24;
+      for (bit = 0; bit < 8; bit++) {
+        crc = (crc >> 1) ^ (CRC32_POLYNOMIAL & (0 - (crc & 1)));
+        crcC = (crcC >> 1) ^ (CRC32C_POLYNOMIAL & (0 - (crcC & 1)));
+        crcBzip2 = (uint32Type) (crcBzip2 << 1) ^
+            (BZIP2_CRC32_POLYNOMIAL & (0 - (crcBzip2 >> 31)));
+      } /* for */
+      crc32Table[0][index] = crc;
+      crc32cTable[0][index] = crcC;
+      bzip2Crc32Table[0][index] = crcBzip2;
+    } /* for */
+    for (tableNum = 1; tableNum < 8; tableNum++) {
+      for (index = 0; index < 256; index++) {
+        crc = crc32Table[tableNum - 1][index];
+        crc32Table[tableNum][index] = (crc >> 8) ^ crc32Table[0][crc & 0xff];
+        crc = crc32cTable[tableNum - 1][index];
+        crc32cTable[tableNum][index] = (crc >> 8) ^ crc32cTable[0][crc & 0xff];
+        crc = bzip2Crc32Table[tableNum - 1][index];
+        bzip2Crc32Table[tableNum][index] =
+            (uint32Type) (crc << 8) ^ bzip2Crc32Table[0][crc >> 24];
+      } /* for */
+    } /* for */
+    crcTablesInitialized = TRUE;
+  } /* initCrcTables */
+
+
+
+/**
+ *  Process 'data' with a bit reflected CRC (least significant bit first).
+ *  Eight bytes are processed at once with the slicing-by-8 tables.
+ *  @param crc The CRC register (not inverted).
+ *  @return the new value of the CRC register.
+ */
+static uint32Type crcReflectedSlicing (const uint32Type table[8][256],
+    uint32Type crc, const ucharType *data, memSizeType length)
+
+  {
+    uint32Type low;
+    uint32Type high;
+
+  /* crcReflectedSlicing */
+    for (; length >= 8; length -= 8) {
+      low = loadLittleEndian32(data) ^ crc;
+      high = loadLittleEndian32(&data[4]);
+      crc = table[7][low & 0xff] ^ table[6][(low >> 8) & 0xff] ^
+            table[5][(low >> 16) & 0xff] ^ table[4][low >> 24] ^
+            table[3][high & 0xff] ^ table[2][(high >> 8) & 0xff] ^
+            table[1][(high >> 16) & 0xff] ^ table[0][high >> 24];
+      data += 8;
+    } /* for */
+    for (; length != 0; length--) {
+      crc = table[0][(crc ^ *data) & 0xff] ^ (crc >> 8);
+      data++;
+    } /* for */
+    return crc;
+  } /* crcReflectedSlicing */
+
+
+
+#if HAS_PCLMUL_INTRINSICS
+/**
+ *  Fold 'data' into the CRC register with carry-less multiplications.
+ *  Four 128-bit lanes are folded in parallel and reduced to 32 bits
+ *  with a Barrett reduction at the end (Intel white paper "Fast CRC
+ *  Computation for Generic Polynomials Using PCLMULQDQ Instruction").
+ *  This function must only be called if the CPU supports PCLMUL.
+ *  @param crc The CRC register (not inverted).
+ *  @param length Number of bytes, a multiple of 16 and at least 64.
+ *  @return the new value of the CRC register.
+ */
+__attribute__((target("pclmul,sse4.1")))
+static uint32Type crcReflectedPclmul (const pclmulConstantType *constants,
+    uint32Type crc, const ucharType *data, memSizeType length)
+
+  {
+    __m128i fold;
+    __m128i lane1, lane2, lane3, lane4;
+    __m128i prod1, prod2, prod3, prod4;
+    __m128i mask32;
+
+  /* crcReflectedPclmul */
+    lane1 = _mm_loadu_si128((const __m128i *) data);
+    lane2 = _mm_loadu_si128((const __m128i *) &data[16]);
+    lane3 = _mm_loadu_si128((const __m128i *) &data[32]);
+    lane4 = _mm_loadu_si128((const __m128i *) &data[48]);
+    lane1 = _mm_xor_si128(lane1, _mm_cvtsi32_si128((int) crc));
+    fold = _mm_set_epi64x((long long) constants->k2,
+                          (long long) constants->k1);
+    data += 64;
+    length -= 64;
+    for (; length >= 64; length -= 64) {
+      prod1 = _mm_clmulepi64_si128(lane1, fold, 0x00);
+      prod2 = _mm_clmulepi64_si128(lane2, fold, 0x00);
+      prod3 = _mm_clmulepi64_si128(lane3, fold, 0x00);
+      prod4 = _mm_clmulepi64_si128(lane4, fold, 0x00);
+      lane1 = _mm_clmulepi64_si128(lane1, fold, 0x11);
+      lane2 = _mm_clmulepi64_si128(lane2, fold, 0x11);
+      lane3 = _mm_clmulepi64_si128(lane3, fold, 0x11);
+      lane4 = _mm_clmulepi64_si128(lane4, fold, 0x11);
+      lane1 = _mm_xor_si128(_mm_xor_si128(lane1, prod1),
+                            _mm_loadu_si128((const __m128i *) data));
+      lane2 = _mm_xor_si128(_mm_xor_si128(lane2, prod2),
+                            _mm_loadu_si128((const __m128i *) &data[16]));
+      lane3 = _mm_xor_si128(_mm_xor_si128(lane3, prod3),
+                            _mm_loadu_si128((const __m128i *) &data[32]));
+      lane4 = _mm_xor_si128(_mm_xor_si128(lane4, prod4),
+                            _mm_loadu_si128((const __m128i *) &data[48]));
+      data += 64;
+    } /* for */
+    /* Fold the four lanes into one. */
+    fold = _mm_set_epi64x((long long) constants->k4,
+                          (long long) constants->k3);
+    prod1 = _mm_clmulepi64_si128(lane1, fold, 0x00);
+    lane1 = _mm_clmulepi64_si128(lane1, fold, 0x11);
+    lane1 = _mm_xor_si128(_mm_xor_si128(lane1, prod1), lane2);
+    prod1 = _mm_clmulepi64_si128(lane1, fold, 0x00);
+    lane1 = _mm_clmulepi64_si128(lane1, fold, 0x11);
+    lane1 = _mm_xor_si128(_mm_xor_si128(lane1, prod1), lane3);
+    prod1 = _mm_clmulepi64_si128(lane1, fold, 0x00);
+    lane1 = _mm_clmulepi64_si128(lane1, fold, 0x11);
+    lane1 = _mm_xor_si128(_mm_xor_si128(lane1, prod1), lane4);
+    for (; length >= 16; length -= 16) {
+      prod1 = _mm_clmulepi64_si128(lane1, fold, 0x00);
+      lane1 = _mm_clmulepi64_si128(lane1, fold, 0x11);
+      lane1 = _mm_xor_si128(_mm_xor_si128(lane1, prod1),
+                            _mm_loadu_si128((const __m128i *) data));
+      data += 16;
+    } /* for */
+    /* Fold 128 bits to 64 bits. */
+    mask32 = _mm_setr_epi32(-1, 0, -1, 0);
+    prod1 = _mm_clmulepi64_si128(lane1, fold, 0x10);
+    lane1 = _mm_xor_si128(_mm_srli_si128(lane1, 8), prod1);
+    fold = _mm_set_epi64x(0, (long long) constants->k5);
+    prod1 = _mm_srli_si128(lane1, 4);
+    lane1 = _mm_clmulepi64_si128(_mm_and_si128(lane1, mask32), fold, 0x00);
+    lane1 = _mm_xor_si128(lane1, prod1);
+    /* Barrett reduction to 32 bits. */
+    fold = _mm_set_epi64x((long long) constants->mu,
+                          (long long) constants->polynomial);
+    prod1 = _mm_clmulepi64_si128(_mm_and_si128(lane1, mask32), fold, 0x10);
+    prod1 = _mm_clmulepi64_si128(_mm_and_si128(prod1, mask32), fold, 0x00);
+    lane1 = _mm_xor_si128(lane1, prod1);
+    return (uint32Type) _mm_extract_epi32(lane1, 1);
+  } /* crcReflectedPclmul */
+#endif
+
+
+
+/**
+ *  Process 'data' with a bit reflected CRC.
+ *  Long inputs are folded with PCLMULQDQ if the CPU supports it.
+ *  The remaining bytes are processed with slicing-by-8.
+ *  @param crc The CRC register (not inverted).
+ *  @return the new value of the CRC register.
+ */
+static uint32Type crcReflected (const uint32Type table[8][256],
+    const pclmulConstantType *constants, uint32Type crc,
+    const ucharType *data, memSizeType length)
+
+  {
+#if HAS_PCLMUL_INTRINSICS
+    memSizeType foldLength;
+#endif
+
+  /* crcReflected */
+#if HAS_PCLMUL_INTRINSICS
+    if (length >= PCLMUL_MIN_LENGTH && __builtin_cpu_supports("pclmul") &&
+        __builtin_cpu_supports("sse4.1")) {
+      foldLength = length & ~(memSizeType) 15;
+      crc = crcReflectedPclmul(constants, crc, data, foldLength);
+      data += foldLength;
+      length -= foldLength;
+    } /* if */
+#endif
+    return crcReflectedSlicing(table, crc, data, length);
+  } /* crcReflected */
+
+
+
+static uint32Type crc32Bytes (uint32Type crc, const ucharType *data,
+    memSizeType length)
+
+  { /* crc32Bytes */
+    return crcReflected(crc32Table, &crc32PclmulConstants, crc, data, length);
+  } /* crc32Bytes */
+
+
+
+static uint32Type crc32cBytes (uint32Type crc, const ucharType *data,
+    memSizeType length)
+
+  { /* crc32cBytes */
+    return crcReflected(crc32cTable, &crc32cPclmulConstants, crc, data, length);
+  } /* crc32cBytes */
+
+
+
+/**
+ *  Process 'data' with the CRC of BZIP2 (most significant bit first).
+ *  Eight bytes are processed at once with the slicing-by-8 tables.
+ *  @param crc The CRC register (not inverted).
+ *  @return the new value of the CRC register.
+ */
+static uint32Type bzip2Crc32Bytes (uint32Type crc, const ucharType *data,
+    memSizeType length)
+
+  {
+    uint32Type high;
+    uint32Type low;
+
+  /* bzip2Crc32Bytes */
+    for (; length >= 8; length -= 8) {
+      high = loadBigEndian32(data) ^ crc;
+      low = loadBigEndian32(&data[4]);
+      crc = bzip2Crc32Table[7][high >> 24] ^
+            bzip2Crc32Table[6][(high >> 16) & 0xff] ^
+            bzip2Crc32Table[5][(high >> 8) & 0xff] ^
+            bzip2Crc32Table[4][high & 0xff] ^
+            bzip2Crc32Table[3][low >> 24] ^
+            bzip2Crc32Table[2][(low >> 16) & 0xff] ^
+            bzip2Crc32Table[1][(low >> 8) & 0xff] ^
+            bzip2Crc32Table[0][low & 0xff];
+      data += 8;
+    } /* for */
+    for (; length != 0; length--) {
+      crc = bzip2Crc32Table[0][(crc >> 24) ^ *data] ^ (uint32Type) (crc << 8);
+      data++;
+    } /* for */
+    return crc;
+  } /* bzip2Crc32Bytes */
+
+
+
+#if HAS_AVX2_INTRINSICS
+/**
+ *  AVX2 variant of the Adler-32 sums for 32 byte blocks.
+ *  The weighted sum of each block is computed with vpmaddubsw and
+ *  the first sum before each block is accumulated for s2 separately.
+ *  This function must only be called if the CPU supports AVX2.
+ *  @param length Number of bytes, a multiple of 32 and at most
+ *         ADLER32_NMAX, such that the 32-bit sums cannot overflow.
+ */
+__attribute__((target("avx2")))
+static void adler32Avx2 (uint32Type *s1, uint32Type *s2,
+    const ucharType *data, memSizeType length)
+
+  {
+    const __m256i weights = _mm256_setr_epi8(
+        32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+        16, 15, 14, 13, 12, 11, 10,  9,  8,  7,  6,  5,  4,  3,  2,  1);
+    const __m256i ones = _mm256_set1_epi16(1);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i bytes;
+    __m256i sum1;
+    __m256i sum2;
+    __m256i prefixSum;
+    __m128i halves;
+
+  /* adler32Avx2 */
+    sum1 = _mm256_setr_epi32((int) *s1, 0, 0, 0, 0, 0, 0, 0);
+    sum2 = _mm256_setr_epi32((int) *s2, 0, 0, 0, 0, 0, 0, 0);
+    prefixSum = zero;
+    for (; length != 0; length -= 32) {
+      bytes = _mm256_loadu_si256((const __m256i *) data);
+      prefixSum = _mm256_add_epi32(prefixSum, sum1);
+      sum1 = _mm256_add_epi32(sum1, _mm256_sad_epu8(bytes, zero));
+      sum2 = _mm256_add_epi32(sum2, _mm256_madd_epi16(
+          _mm256_maddubs_epi16(bytes, weights), ones));
+      data += 32;
+    } /* for */
+    sum2 = _mm256_add_epi32(sum2, _mm256_slli_epi32(prefixSum, 5));
+    halves = _mm_add_epi32(_mm256_castsi256_si128(sum1),
+                           _mm256_extracti128_si256(sum1, 1));
+    halves = _mm_add_epi32(halves, _mm_srli_si128(halves, 8));
+    halves = _mm_add_epi32(halves, _mm_srli_si128(halves, 4));
+    *s1 = (uint32Type) _mm_cvtsi128_si32(halves) % ADLER32_BASE;
+    halves = _mm_add_epi32(_mm256_castsi256_si128(sum2),
+                           _mm256_extracti128_si256(sum2, 1));
+    halves = _mm_add_epi32(halves, _mm_srli_si128(halves, 8));
+    halves = _mm_add_epi32(halves, _mm_srli_si128(halves, 4));
+    *s2 = (uint32Type) _mm_cvtsi128_si32(halves) % ADLER32_BASE;
+  } /* adler32Avx2 */
+#endif
+
+
+
+/**
+ *  Process 'data' with the Adler-32 checksum.
+ *  The sums are reduced modulo 65521 only once per ADLER32_NMAX bytes.
+ *  @return the new Adler-32 checksum.
+ */
+static uint32Type adler32Bytes (uint32Type adler, const ucharType *data,
+    memSizeType length)
+
+  {
+    uint32Type s1;
+    uint32Type s2;
+    memSizeType blockLength;
+#if HAS_AVX2_INTRINSICS
+    memSizeType vectorLength;
+#endif
+
+  /* adler32Bytes */
+    s1 = adler & 0xffff;
+    s2 = adler >> 16;
+    while (length != 0) {
+      blockLength = length < ADLER32_NMAX ? length : ADLER32_NMAX;
+      length -= blockLength;
+#if HAS_AVX2_INTRINSICS
+      if (blockLength >= 32 && __builtin_cpu_supports("avx2")) {
+        vectorLength = blockLength & ~(memSizeType) 31;
+        adler32Avx2(&s1, &s2, data, vectorLength);
+        data += vectorLength;
+        blockLength -= vectorLength;
+      } /* if */
+#endif
+      for (; blockLength >= 4; blockLength -= 4) {
+        s1 += data[0];
+        s2 += s1;
+        s1 += data[1];
+        s2 += s1;
+        s1 += data[2];
+        s2 += s1;
+        s1 += data[3];
+        s2 += s1;
+        data += 4;
+      } /* for */
+      for (; blockLength != 0; blockLength--) {
+        s1 += *data;
+        s2 += s1;
+        data++;
+      } /* for */
+      s1 %= ADLER32_BASE;
+      s2 %= ADLER32_BASE;
+    } /* while */
+    return s2 << 16 | s1;
+  } /* adler32Bytes */
+
+
+
+/**
+ *  Feed the characters of a string to a checksum function.
+ *  The characters are converted to bytes in chunks.
+ *  @return TRUE if all characters are bytes, FALSE if a character
+ *          beyond '\255;' was found.
+ */
+static boolType checksumStri (checksumFuncType checksumFunc,
+    uint32Type *checksum, const strElemType *stri, memSizeType length)
+
+  {
+    ucharType bytes[STRI_CHUNK_SIZE];
+    memSizeType chunkSize;
+    boolType okay = TRUE;
+
+  /* checksumStri */
+    while (length != 0 && okay) {
+      chunkSize = length < STRI_CHUNK_SIZE ? length : STRI_CHUNK_SIZE;
+      if (unlikely(memcpy_from_strelem(bytes, stri, chunkSize))) {
+        okay = FALSE;
+      } else {
+        *checksum = checksumFunc(*checksum, bytes, chunkSize);
+        stri += chunkSize;
+        length -= chunkSize;
+      } /* if */
+    } /* while */
+    return okay;
+  } /* checksumStri */
+
+
+
+static striType digestToStri (const ucharType *digest, memSizeType digestSize)
+
+  {
+    striType result;
+
+  /* digestToStri */
+    if (unlikely(!ALLOC_STRI_SIZE_OK(result, digestSize))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      result->size = digestSize;
+      memcpy_to_strelem(result->mem, digest, digestSize);
+    } /* if */
+    return result;
+  } /* digestToStri */
+
+
+
+/**
+ *  Copy the digest state stored in the bstring 'stateBstri' to 'state'.
+ *  @return TRUE if 'stateBstri' contains a valid state, FALSE otherwise.
+ */
+static boolType getState (const const_bstriType stateBstri,
+    digestStateType state)
+
+  {
+    boolType okay = FALSE;
+
+  /* getState */
+    if (stateBstri->size == sizeof(digestStateRecord)) {
+      memcpy(state, stateBstri->mem, sizeof(digestStateRecord));
+      okay = state->algorithm < NUMBER_OF_ALGORITHMS &&
+             (state->bufferFill == 0 ||
+              state->bufferFill < algorithmTable[state->algorithm].blockSize);
+    } /* if */
+    return okay;
+  } /* getState */
+
+
+
+/**
+ *  Compute the message digest of the data fed to 'stateBstri'.
+ *  The state is not changed. More data can be added afterwards.
+ *  @param stateBstri Digest state created with mdgInit().
+ *  @return the message digest.
+ *  @exception RANGE_ERROR If 'stateBstri' is not a valid digest state.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+striType mdgFinal (const const_bstriType stateBstri)
+
+  {
+    digestStateRecord state;
+    ucharType digest[MAX_DIGEST_SIZE];
+    striType result;
+
+  /* mdgFinal */
+    logFunction(printf("mdgFinal(*)\n"););
+    if (unlikely(!getState(stateBstri, &state))) {
+      logError(printf("mdgFinal(*): Illegal digest state.\n"););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else {
+      finalizeState(&state, digest);
+      result = digestToStri(digest, algorithmTable[state.algorithm].digestSize);
+    } /* if */
+    return result;
+  } /* mdgFinal */
+
+
+
+/**
+ *  Compute the message digest of the remaining bytes of 'inFile'.
+ *  The file is read from the current position up to its end.
+ *  A memory mapped file is digested directly from the mapping.
+ *  Other files are read in blocks, such that a big file can be
+ *  digested with a small amount of memory.
+ *  @param digestAlg Number of the digest algorithm.
+ *  @return the message digest.
+ *  @exception RANGE_ERROR If 'digestAlg' is not a known algorithm.
+ *  @exception FILE_ERROR The file is closed or reading fails.
+ *  @exception MEMORY_ERROR Not enough memory for a buffer or the result.
+ */
+striType mdgFileDigest (intType digestAlg, fileType inFile)
+
+  {
+    cFileType cInFile;
+    digestStateRecord state;
+    ucharType digest[MAX_DIGEST_SIZE];
+    ucharType *buffer;
+    memSizeType bytesRead;
+    striType result = NULL;
+
+  /* mdgFileDigest */
+    logFunction(printf("mdgFileDigest(" FMT_D ", %s%d)\n",
+                       digestAlg,
+                       inFile == NULL ? "NULL " : "",
+                       inFile != NULL ? safe_fileno(inFile->cFile) : 0););
+    cInFile = inFile->cFile;
+    if (unlikely(!initState(&state, digestAlg))) {
+      logError(printf("mdgFileDigest(" FMT_D ", *): Unknown algorithm.\n",
+                      digestAlg););
+      raise_error(RANGE_ERROR);
+    } else if (unlikely(cInFile == NULL)) {
+      logError(printf("mdgFileDigest: Attempt to read from closed file.\n"););
+      raise_error(FILE_ERROR);
+    } else if (inFile->mapStart != NULL) {
+      if (inFile->mapPosition < inFile->mapLength) {
+        updateBytes(&state, &inFile->mapStart[inFile->mapPosition],
+                    inFile->mapLength - inFile->mapPosition);
+        inFile->mapPosition = inFile->mapLength;
+      } /* if */
+      inFile->mapEof = TRUE;
+      finalizeState(&state, digest);
+      result = digestToStri(digest, algorithmTable[state.algorithm].digestSize);
+    } else if (unlikely(!ALLOC_UBYTES(buffer, FILE_BUFFER_SIZE))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      do {
+        bytesRead = (memSizeType) fread(buffer, 1, FILE_BUFFER_SIZE, cInFile);
+        updateBytes(&state, buffer, bytesRead);
+      } while (bytesRead == FILE_BUFFER_SIZE);
+      FREE_BYTES(buffer, FILE_BUFFER_SIZE);
+      if (unlikely(ferror(cInFile))) {
+        logError(printf("mdgFileDigest: fread(*, 1, %d, %d) failed.\n",
+                        FILE_BUFFER_SIZE, safe_fileno(cInFile)););
+        raise_error(FILE_ERROR);
+      } else {
+        finalizeState(&state, digest);
+        result = digestToStri(digest, algorithmTable[state.algorithm].digestSize);
+      } /* if */
+    } /* if */
+    return result;
+  } /* mdgFileDigest */
+
+
+
+/**
+ *  Compute the message digest of 'message'.
+ *  @param digestAlg Number of the digest algorithm.
+ *  @return the message digest.
+ *  @exception RANGE_ERROR If 'digestAlg' is not a known algorithm or
+ *             if 'message' contains a character beyond '\255;'.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+striType mdgDigest (intType digestAlg, const const_striType message)
+
+  {
+    digestStateRecord state;
+    ucharType digest[MAX_DIGEST_SIZE];
+    striType result;
+
+  /* mdgDigest */
+    logFunction(printf("mdgDigest(" FMT_D ", \"%s\")\n",
+                       digestAlg, striAsUnquotedCStri(message)););
+    if (unlikely(!initState(&state, digestAlg))) {
+      logError(printf("mdgDigest(" FMT_D ", *): Unknown algorithm.\n",
+                      digestAlg););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else if (unlikely(!updateStri(&state, message->mem, message->size))) {
+      logError(printf("mdgDigest(" FMT_D ", *): "
+                      "Character beyond '\\255;' in message.\n",
+                      digestAlg););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else {
+      finalizeState(&state, digest);
+      result = digestToStri(digest, algorithmTable[state.algorithm].digestSize);
+    } /* if */
+    return result;
+  } /* mdgDigest */
+
+
+
+/**
+ *  Create a digest state for an incremental digest computation.
+ *  @param digestAlg Number of the digest algorithm.
+ *  @return the digest state, which is stored in a bstring.
+ *  @exception RANGE_ERROR If 'digestAlg' is not a known algorithm.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+bstriType mdgInit (intType digestAlg)
+
+  {
+    digestStateRecord state;
+    bstriType result;
+
+  /* mdgInit */
+    logFunction(printf("mdgInit(" FMT_D ")\n", digestAlg););
+    if (unlikely(!initState(&state, digestAlg))) {
+      logError(printf("mdgInit(" FMT_D "): Unknown algorithm.\n",
+                      digestAlg););
+      raise_error(RANGE_ERROR);
+      result = NULL;
+    } else if (unlikely(!ALLOC_BSTRI_SIZE_OK(result, sizeof(digestStateRecord)))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      result->size = sizeof(digestStateRecord);
+      memcpy(result->mem, &state, sizeof(digestStateRecord));
+    } /* if */
+    return result;
+  } /* mdgInit */
+
+
+
+/**
+ *  Feed the characters of 'data' to the digest state 'stateBstri'.
+ *  @param stateBstri Digest state created with mdgInit().
+ *  @exception RANGE_ERROR If 'stateBstri' is not a valid digest state
+ *             or if 'data' contains a character beyond '\255;'.
+ *             In this case the state is not changed.
+ */
+void mdgUpdate (bstriType stateBstri, const const_striType data)
+
+  {
+    digestStateRecord state;
+
+  /* mdgUpdate */
+    logFunction(printf("mdgUpdate(*, \"%s\")\n",
+                       striAsUnquotedCStri(data)););
+    if (unlikely(!getState(stateBstri, &state))) {
+      logError(printf("mdgUpdate(*, *): Illegal digest state.\n"););
+      raise_error(RANGE_ERROR);
+    } else if (unlikely(!updateStri(&state, data->mem, data->size))) {
+      logError(printf("mdgUpdate(*, *): Character beyond '\\255;' in data.\n"););
+      raise_error(RANGE_ERROR);
+    } else {
+      memcpy(stateBstri->mem, &state, sizeof(digestStateRecord));
+    } /* if */
+  } /* mdgUpdate */
+
+
+
+/**
+ *  Compute the Adler-32 checksum of 'data' (RFC 1950).
+ *  The checksum can be computed incrementally: Processing 'data'
+ *  with the checksum of the preceding data as 'oldAdler' gives the
+ *  same result as processing all data at once.
+ *  @param oldAdler Checksum of the preceding data, 1 at the start.
+ *  @return the Adler-32 checksum.
+ *  @exception RANGE_ERROR If 'data' contains a character beyond '\255;'.
+ */
+intType mdgAdler32 (const const_striType data, intType oldAdler)
+
+  {
+    uint32Type adler;
+    intType result;
+
+  /* mdgAdler32 */
+    logFunction(printf("mdgAdler32(\"%s\", " FMT_D ")\n",
+                       striAsUnquotedCStri(data), oldAdler););
+    adler = (uint32Type) oldAdler;
+    if (unlikely(!checksumStri(adler32Bytes, &adler, data->mem, data->size))) {
+      logError(printf("mdgAdler32(*, " FMT_D "): "
+                      "Character beyond '\\255;' in data.\n",
+                      oldAdler););
+      raise_error(RANGE_ERROR);
+      result = 0;
+    } else {
+      result = (intType) adler;
+    } /* if */
+    return result;
+  } /* mdgAdler32 */
+
+
+
+/**
+ *  Compute the CRC-32 of BZIP2 (polynomial 0x04c11db7, most
+ *  significant bit first). The CRC can be computed incrementally
+ *  with the CRC of the preceding data as 'oldCrc'.
+ *  @param oldCrc CRC of the preceding data, 0 at the start.
+ *  @return the CRC-32 of BZIP2.
+ *  @exception RANGE_ERROR If 'data' contains a character beyond '\255;'.
+ */
+intType mdgBzip2Crc32 (const const_striType data, intType oldCrc)
+
+  {
+    uint32Type crc;
+    intType result;
+
+  /* mdgBzip2Crc32 */
+    logFunction(printf("mdgBzip2Crc32(\"%s\", " FMT_D ")\n",
+                       striAsUnquotedCStri(data), oldCrc););
+    if (unlikely(!crcTablesInitialized)) {
+      initCrcTables();
+    } /* if */
+    crc = ~(uint32Type) oldCrc;
+    if (unlikely(!checksumStri(bzip2Crc32Bytes, &crc, data->mem, data->size))) {
+      logError(printf("mdgBzip2Crc32(*, " FMT_D "): "
+                      "Character beyond '\\255;' in data.\n",
+                      oldCrc););
+      raise_error(RANGE_ERROR);
+      result = 0;
+    } else {
+      result = (intType) ~crc;
+    } /* if */
+    return result;
+  } /* mdgBzip2Crc32 */
+
+
+
+/**
+ *  Compute the CRC-32 of BZIP2 for 'length' bytes at 'data'.
+ *  This is used by the decompression functions, which check
+ *  the CRC of the data they produce.
+ *  @param oldCrc CRC of the preceding data, 0 at the start.
+ *  @return the CRC-32 of BZIP2.
+ */
+uint32Type mdgBzip2Crc32Bytes (uint32Type oldCrc, const ucharType *data,
+    memSizeType length)
+
+  { /* mdgBzip2Crc32Bytes */
+    if (unlikely(!crcTablesInitialized)) {
+      initCrcTables();
+    } /* if */
+    return ~bzip2Crc32Bytes(~oldCrc, data, length);
+  } /* mdgBzip2Crc32Bytes */
+
+
+
+/**
+ *  Compute the CRC-32 of 'data' (polynomial 0x04c11db7, bit
+ *  reflected), as used by zip, gzip, PNG and xz. The CRC can be
+ *  computed incrementally with the CRC of the preceding data as
+ *  'oldCrc'.
+ *  @param oldCrc CRC of the preceding data, 0 at the start.
+ *  @return the CRC-32.
+ *  @exception RANGE_ERROR If 'data' contains a character beyond '\255;'.
+ */
+intType mdgCrc32 (const const_striType data, intType oldCrc)
+
+  {
+    uint32Type crc;
+    intType result;
+
+  /* mdgCrc32 */
+    logFunction(printf("mdgCrc32(\"%s\", " FMT_D ")\n",
+                       striAsUnquotedCStri(data), oldCrc););
+    if (unlikely(!crcTablesInitialized)) {
+      initCrcTables();
+    } /* if */
+    crc = ~(uint32Type) oldCrc;
+    if (unlikely(!checksumStri(crc32Bytes, &crc, data->mem, data->size))) {
+      logError(printf("mdgCrc32(*, " FMT_D "): "
+                      "Character beyond '\\255;' in data.\n",
+                      oldCrc););
+      raise_error(RANGE_ERROR);
+      result = 0;
+    } else {
+      result = (intType) ~crc;
+    } /* if */
+    return result;
+  } /* mdgCrc32 */
+
+
+
+/**
+ *  Compute the CRC-32 of zip, gzip and xz for 'length' bytes at
+ *  'data'. This is used by the decompression functions, which
+ *  check the CRC of the data they produce.
+ *  @param oldCrc CRC of the preceding data, 0 at the start.
+ *  @return the CRC-32.
+ */
+uint32Type mdgCrc32Bytes (uint32Type oldCrc, const ucharType *data,
+    memSizeType length)
+
+  { /* mdgCrc32Bytes */
+    if (unlikely(!crcTablesInitialized)) {
+      initCrcTables();
+    } /* if */
+    return ~crc32Bytes(~oldCrc, data, length);
+  } /* mdgCrc32Bytes */
+
+
+
+/**
+ *  Compute the CRC-32C of 'data' (Castagnoli polynomial 0x1edc6f41,
+ *  bit reflected), as used by iSCSI, SCTP and ext4. The CRC can be
+ *  computed incrementally with the CRC of the preceding data as
+ *  'oldCrc'.
+ *  @param oldCrc CRC of the preceding data, 0 at the start.
+ *  @return the CRC-32C.
+ *  @exception RANGE_ERROR If 'data' contains a character beyond '\255;'.
+ */
+intType mdgCrc32c (const const_striType data, intType oldCrc)
+
+  {
+    uint32Type crc;
+    intType result;
+
+  /* mdgCrc32c */
+    logFunction(printf("mdgCrc32c(\"%s\", " FMT_D ")\n",
+                       striAsUnquotedCStri(data), oldCrc););
+    if (unlikely(!crcTablesInitialized)) {
+      initCrcTables();
+    } /* if */
+    crc = ~(uint32Type) oldCrc;
+    if (unlikely(!checksumStri(crc32cBytes, &crc, data->mem, data->size))) {
+      logError(printf("mdgCrc32c(*, " FMT_D "): "
+                      "Character beyond '\\255;' in data.\n",
+                      oldCrc););
+      raise_error(RANGE_ERROR);
+      result = 0;
+    } else {
+      result = (intType) ~crc;
+    } /* if */
+    return result;
+  } /* mdgCrc32c */
@@ -0,0 +1,44 @@
+/********************************************************************/
+/*                                                                  */
+/*  mdg_rtl.h     Message digest and secure hash algorithms.        */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/mdg_rtl.h                                       */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: Message digest and secure hash algorithms.             */
+/*                                                                  */
+/********************************************************************/
+
+intType mdgAdler32 (const const_striType data, intType oldAdler);
+intType mdgBzip2Crc32 (const const_striType data, intType oldCrc);
+uint32Type mdgBzip2Crc32Bytes (uint32Type oldCrc, const ucharType *data,
+                               memSizeType length);
+intType mdgCrc32 (const const_striType data, intType oldCrc);
+uint32Type mdgCrc32Bytes (uint32Type oldCrc, const ucharType *data,
+                          memSizeType length);
+intType mdgCrc32c (const const_striType data, intType oldCrc);
+striType mdgDigest (intType digestAlg, const const_striType message);
+striType mdgFileDigest (intType digestAlg, fileType inFile);
+striType mdgFinal (const const_bstriType stateBstri);
+bstriType mdgInit (intType digestAlg);
+void mdgUpdate (bstriType stateBstri, const const_striType data);
@@ -0,0 +1,197 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Library                                                 */
+/*  File: seed7/src/mdglib.c                                        */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: All primitive actions for message digests.             */
+/*                                                                  */
+/********************************************************************/
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+
+#include "common.h"
+#include "data.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "syvarutl.h"
+#include "objutl.h"
+#include "runerr.h"
+#include "mdg_rtl.h"
+
+#undef EXTERN
+#define EXTERN
+#include "mdglib.h"
+
+
+
+/**
+ *  Compute the Adler-32 checksum of data/arg_1.
+ *  The checksum of preceding data is given with arg_2.
+ *  @return the Adler-32 checksum.
+ *  @exception RANGE_ERROR If data/arg_1 contains a character beyond '\255;'.
+ */
+objectType mdg_adler32 (listType arguments)
+
+  { /* mdg_adler32 */
+    isit_stri(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    return bld_int_temp(
+        mdgAdler32(take_stri(arg_1(arguments)), take_int(arg_2(arguments))));
+  } /* mdg_adler32 */
+
+
+
+/**
+ *  Compute the CRC-32 of BZIP2 of data/arg_1.
+ *  The CRC of preceding data is given with arg_2.
+ *  @return the CRC-32 of BZIP2.
+ *  @exception RANGE_ERROR If data/arg_1 contains a character beyond '\255;'.
+ */
+objectType mdg_bzip2_crc32 (listType arguments)
+
+  { /* mdg_bzip2_crc32 */
+    isit_stri(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    return bld_int_temp(
+        mdgBzip2Crc32(take_stri(arg_1(arguments)), take_int(arg_2(arguments))));
+  } /* mdg_bzip2_crc32 */
+
+
+
+/**
+ *  Compute the CRC-32 of data/arg_1.
+ *  The CRC of preceding data is given with arg_2.
+ *  @return the CRC-32.
+ *  @exception RANGE_ERROR If data/arg_1 contains a character beyond '\255;'.
+ */
+objectType mdg_crc32 (listType arguments)
+
+  { /* mdg_crc32 */
+    isit_stri(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    return bld_int_temp(
+        mdgCrc32(take_stri(arg_1(arguments)), take_int(arg_2(arguments))));
+  } /* mdg_crc32 */
+
+
+
+/**
+ *  Compute the CRC-32C of data/arg_1.
+ *  The CRC of preceding data is given with arg_2.
+ *  @return the CRC-32C.
+ *  @exception RANGE_ERROR If data/arg_1 contains a character beyond '\255;'.
+ */
+objectType mdg_crc32c (listType arguments)
+
+  { /* mdg_crc32c */
+    isit_stri(arg_1(arguments));
+    isit_int(arg_2(arguments));
+    return bld_int_temp(
+        mdgCrc32c(take_stri(arg_1(arguments)), take_int(arg_2(arguments))));
+  } /* mdg_crc32c */
+
+
+
+/**
+ *  Compute the message digest of a string.
+ *  @return the message digest of message/arg_2 computed with the
+ *          digest algorithm number arg_1.
+ *  @exception RANGE_ERROR If the algorithm is unknown or if the
+ *             message contains a character beyond '\255;'.
+ */
+objectType mdg_digest (listType arguments)
+
+  { /* mdg_digest */
+    isit_int(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    return bld_stri_temp(
+        mdgDigest(take_int(arg_1(arguments)), take_stri(arg_2(arguments))));
+  } /* mdg_digest */
+
+
+
+/**
+ *  Compute the message digest of the remaining bytes of a file.
+ *  The file inFile/arg_2 is read in blocks up to its end.
+ *  @return the message digest computed with the digest algorithm
+ *          number arg_1.
+ *  @exception RANGE_ERROR If the algorithm is unknown.
+ *  @exception FILE_ERROR The file is closed or reading fails.
+ */
+objectType mdg_file_digest (listType arguments)
+
+  { /* mdg_file_digest */
+    isit_int(arg_1(arguments));
+    isit_file(arg_2(arguments));
+    return bld_stri_temp(
+        mdgFileDigest(take_int(arg_1(arguments)), take_file(arg_2(arguments))));
+  } /* mdg_file_digest */
+
+
+
+/**
+ *  Compute the message digest of the data fed to a digest state.
+ *  The digest state arg_1 is not changed.
+ *  @return the message digest.
+ *  @exception RANGE_ERROR If arg_1 is not a valid digest state.
+ */
+objectType mdg_final (listType arguments)
+
+  { /* mdg_final */
+    isit_bstri(arg_1(arguments));
+    return bld_stri_temp(
+        mdgFinal(take_bstri(arg_1(arguments))));
+  } /* mdg_final */
+
+
+
+/**
+ *  Create a digest state for the digest algorithm number arg_1.
+ *  @return the new digest state.
+ *  @exception RANGE_ERROR If the algorithm is unknown.
+ */
+objectType mdg_init (listType arguments)
+
+  { /* mdg_init */
+    isit_int(arg_1(arguments));
+    return bld_bstri_temp(
+        mdgInit(take_int(arg_1(arguments))));
+  } /* mdg_init */
+
+
+
+/**
+ *  Feed the characters of data/arg_2 to the digest state arg_1.
+ *  @exception RANGE_ERROR If arg_1 is not a valid digest state or
+ *             if data/arg_2 contains a character beyond '\255;'.
+ */
+objectType mdg_update (listType arguments)
+
+  { /* mdg_update */
+    isit_bstri(arg_1(arguments));
+    is_variable(arg_1(arguments));
+    isit_stri(arg_2(arguments));
+    mdgUpdate(take_bstri(arg_1(arguments)), take_stri(arg_2(arguments)));
+    return SYS_EMPTY_OBJECT;
+  } /* mdg_update */
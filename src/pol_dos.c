@@ -279,3 +279,26 @@ void polRemoveCheck (const pollType pollData, const socketType aSocket,
 
   { /* polRemoveCheck */
   } /* polRemoveCheck */
+
+
+
+/**
+ *  Remove the timer of 'aSocket' from 'pollData'.
+ */
+void polRemoveTimeout (const pollType pollData, const socketType aSocket)
+
+  { /* polRemoveTimeout */
+  } /* polRemoveTimeout */
+
+
+
+/**
+ *  Set a timer for 'aSocket', which expires after the given time.
+ *  @exception FILE_ERROR Timers are not supported.
+ */
+void polSetTimeout (const pollType pollData, const socketType aSocket,
+    intType seconds, intType micro_seconds, const genericType fileObj)
+
+  { /* polSetTimeout */
+    raise_error(FILE_ERROR);
+  } /* polSetTimeout */
@@ -33,6 +33,7 @@
 #define POLL_IN      1
 #define POLL_OUT     2
 #define POLL_INOUT   3
+#define POLL_TIMEOUT 4
 
 typedef struct {
     createFuncType incrUsageCount;
@@ -64,3 +65,7 @@ genericType polNextFile (const pollType pollData, const genericType nullFile);
 void polPoll (const pollType pollData);
 void polRemoveCheck (const pollType pollData, const socketType aSocket,
                      intType eventsToCheck);
+void polRemoveTimeout (const pollType pollData, const socketType aSocket);
+void polSetTimeout (const pollType pollData, const socketType aSocket,
+                    intType seconds, intType micro_seconds,
+                    const genericType fileObj);
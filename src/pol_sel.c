@@ -50,12 +50,15 @@
 #include "heaputl.h"
 #include "hsh_rtl.h"
 #include "soc_rtl.h"
+#include "tim_drv.h"
 #include "rtl_err.h"
 
 #undef EXTERN
 #define EXTERN
 #include "pol_drv.h"
 
+#include "pol_tim.c"
+
 
 #if SOCKET_LIB == UNIX_SOCKETS
 
@@ -85,7 +88,8 @@
 typedef enum {
     ITER_EMPTY,
     ITER_CHECKS_IN, ITER_CHECKS_OUT, ITER_CHECKS_INOUT,
-    ITER_FINDINGS_IN, ITER_FINDINGS_OUT, ITER_FINDINGS_INOUT
+    ITER_FINDINGS_IN, ITER_FINDINGS_OUT, ITER_FINDINGS_INOUT,
+    ITER_FINDINGS_TIMEOUT
   } iteratorType;
 
 typedef struct {
@@ -118,6 +122,7 @@ typedef struct {
 typedef struct {
     testType readTest;
     testType writeTest;
+    timerHeapType timers;
     iteratorType iteratorMode;
     memSizeType iterEvents;
     memSizeType numOfEvents;
@@ -761,6 +766,8 @@ void polClear (const pollType pollData)
     hshDestr(conv(pollData)->writeTest.indexHash, (destrFuncType) &genericDestr,
              (destrFuncType) &genericDestr);
     var_conv(pollData)->writeTest.indexHash = hshEmpty();
+    freeTimers(&var_conv(pollData)->timers);
+    initTimers(&var_conv(pollData)->timers);
     var_conv(pollData)->iteratorMode = ITER_EMPTY;
     var_conv(pollData)->iterEvents = 0;
     var_conv(pollData)->numOfEvents = 0;
@@ -789,6 +796,7 @@ void polCpy (const pollType dest, const const_pollType source)
     fdAndFileType *oldWriteFiles;
     memSizeType oldWriteFilesSize;
     memSizeType oldWriteFilesCapacity;
+    timerHeapType newTimers;
     memSizeType pos;
 
   /* polCpy */
@@ -801,7 +809,8 @@ void polCpy (const pollType dest, const const_pollType source)
       newWriteIndexHash = hshCreate(conv(source)->writeTest.indexHash,
           (createFuncType) &genericCreate, (destrFuncType) &genericDestr,
           (createFuncType) &genericCreate, (destrFuncType) &genericDestr);
-      if (unlikely(newReadIndexHash == NULL || newWriteIndexHash == NULL)) {
+      if (unlikely(newReadIndexHash == NULL || newWriteIndexHash == NULL ||
+                   !copyTimers(&newTimers, &conv(source)->timers))) {
         raise_error(MEMORY_ERROR);
       } else {
         pollData = var_conv(dest);
@@ -814,12 +823,14 @@ void polCpy (const pollType dest, const const_pollType source)
           newReadFilesCapacity = pollData->readTest.capacity;
         } /* if */
         if (unlikely(!ALLOC_TABLE(newReadFiles, fdAndFileType, newReadFilesCapacity))) {
+          freeTimers(&newTimers);
           raise_error(MEMORY_ERROR);
           return;
         } else {
           if (pollData->readTest.capacity < conv(source)->readTest.size) {
             if (unlikely(!replaceFdSet(&pollData->readTest, conv(source)->readTest.capacity))) {
               FREE_TABLE(newReadFiles, fdAndFileType, newReadFilesCapacity);
+              freeTimers(&newTimers);
               raise_error(MEMORY_ERROR);
               return;
             } else {
@@ -837,6 +848,7 @@ void polCpy (const pollType dest, const const_pollType source)
         } /* if */
         if (unlikely(!ALLOC_TABLE(newWriteFiles, fdAndFileType, newWriteFilesCapacity))) {
           FREE_TABLE(newReadFiles, fdAndFileType, newReadFilesCapacity);
+          freeTimers(&newTimers);
           raise_error(MEMORY_ERROR);
           return;
         } else {
@@ -844,6 +856,7 @@ void polCpy (const pollType dest, const const_pollType source)
             if (unlikely(!replaceFdSet(&pollData->writeTest, conv(source)->writeTest.capacity))) {
               FREE_TABLE(newReadFiles, fdAndFileType, newReadFilesCapacity);
               FREE_TABLE(newWriteFiles, fdAndFileType, newWriteFilesCapacity);
+              freeTimers(&newTimers);
               raise_error(MEMORY_ERROR);
               return;
             } else {
@@ -902,6 +915,8 @@ void polCpy (const pollType dest, const const_pollType source)
         } /* for */
         FREE_TABLE(oldReadFiles, fdAndFileType, oldReadFilesCapacity);
         FREE_TABLE(oldWriteFiles, fdAndFileType, oldWriteFilesCapacity);
+        freeTimers(&pollData->timers);
+        pollData->timers = newTimers;
       } /* if */
     } /* if */
     logFunction(printf("polCpy -->\n");
@@ -944,7 +959,8 @@ pollType polCreate (const const_pollType source)
                    !ALLOC_TABLE(result->writeTest.files, fdAndFileType,
                                 conv(source)->writeTest.capacity) ||
                    !allocFdSet(&result->readTest, conv(source)->readTest.capacity) ||
-                   !allocFdSet(&result->writeTest, conv(source)->writeTest.capacity))) {
+                   !allocFdSet(&result->writeTest, conv(source)->writeTest.capacity) ||
+                   !copyTimers(&result->timers, &conv(source)->timers))) {
         if (result->readTest.files != NULL) {
           FREE_TABLE(result->readTest.files, fdAndFileType, conv(source)->readTest.capacity);
           if (result->writeTest.files != NULL) {
@@ -1045,6 +1061,7 @@ void polDestr (const pollType oldPollData)
       FREE_TABLE(conv(oldPollData)->writeTest.files, fdAndFileType, capacity);
       hshDestr(conv(oldPollData)->writeTest.indexHash, (destrFuncType) &genericDestr,
                (destrFuncType) &genericDestr);
+      freeTimers(&var_conv(oldPollData)->timers);
       FREE_RECORD(var_conv(oldPollData), select_based_pollRecord, count.polldata);
     } /* if */
   } /* polDestr */
@@ -1075,7 +1092,8 @@ pollType polEmpty (void)
       if (unlikely(!ALLOC_TABLE(result->readTest.files, fdAndFileType, TABLE_START_SIZE) ||
                    !ALLOC_TABLE(result->writeTest.files, fdAndFileType, TABLE_START_SIZE) ||
                    !allocFdSet(&result->readTest, TABLE_START_SIZE) ||
-                   !allocFdSet(&result->writeTest, TABLE_START_SIZE))) {
+                   !allocFdSet(&result->writeTest, TABLE_START_SIZE) ||
+                   !initTimers(&result->timers))) {
         if (result->readTest.files != NULL) {
           FREE_TABLE(result->readTest.files, fdAndFileType, TABLE_START_SIZE);
           if (result->writeTest.files != NULL) {
@@ -1217,6 +1235,8 @@ boolType polHasNext (const pollType pollData)
                               conv(pollData)->iterEvents) ||
                hasNextFinding(&var_conv(pollData)->writeTest,
                               conv(pollData)->iterEvents);
+      case ITER_FINDINGS_TIMEOUT:
+        return hasNextExpired(&conv(pollData)->timers);
       case ITER_EMPTY:
       default:
         return FALSE;
@@ -1274,6 +1294,7 @@ void polIterChecks (const pollType pollData, intType pollMode)
  *  - POLLIN data can be read from the corresponding socket.
  *  - POLLOUT data can be written to the corresponding socket.
  *  - POLLINOUT data can be read or written (POLLIN and POLLOUT).
+ *  - POLLTIMEOUT the timers, which expired in the last polPoll.
  *
  *  @exception RANGE_ERROR Illegal value for 'pollMode'.
  */
@@ -1297,6 +1318,10 @@ void polIterFindings (const pollType pollData, intType pollMode)
         var_conv(pollData)->readTest.iterPos = 0;
         var_conv(pollData)->writeTest.iterPos = 0;
         break;
+      case POLL_TIMEOUT:
+        var_conv(pollData)->iteratorMode = ITER_FINDINGS_TIMEOUT;
+        var_conv(pollData)->timers.iterPos = 0;
+        break;
       default:
         raise_error(RANGE_ERROR);
         break;
@@ -1353,6 +1378,9 @@ genericType polNextFile (const pollType pollData, const genericType nullFile)
                              &var_conv(pollData)->iterEvents, nullFile);
         } /* if */
         break;
+      case ITER_FINDINGS_TIMEOUT:
+        nextFile = nextExpired(&var_conv(pollData)->timers, nullFile);
+        break;
       case ITER_EMPTY:
       default:
         nextFile = nullFile;
@@ -1366,19 +1394,41 @@ genericType polNextFile (const pollType pollData, const genericType nullFile)
 /**
  *  Waits for one or more of the checkedEvents from 'pollData'.
  *  polPoll waits until one of the checkedEvents for a
- *  corresponding socket occurs. If a checked event occurs
+ *  corresponding socket occurs or until the nearest timer of
+ *  'pollData' expires. If a checked event occurs
  *  the eventFindings field is assigned a value. The following
  *  eventFindings values are assigned:
  *  - POLLIN data can be read from the corresponding socket.
  *  - POLLOUT data can be written to the corresponding socket.
  *  - POLLINOUT data can be read and written (POLLIN and POLLOUT).
  *
+ *  Timers, which reach their deadline, are removed from 'pollData'
+ *  and can be processed with polIterFindings(pollData, POLLTIMEOUT).
  *  @exception FILE_ERROR The system function returns an error.
  */
 void polPoll (const pollType pollData)
 
-  { /* polPoll */
-    doPoll(pollData, NULL);
+  {
+    intType timeout;
+    struct timeval timeVal;
+
+  /* polPoll */
+    timeout = nextTimeout(&conv(pollData)->timers);
+    if (timeout < 0) {
+      doPoll(pollData, NULL);
+#if SOCKET_LIB == WINSOCK_SOCKETS
+    } else if (conv(pollData)->readTest.size == 0 &&
+               conv(pollData)->writeTest.size == 0) {
+      /* Winsock select() fails if no socket is given. */
+      Sleep((DWORD) ((timeout + 999) / 1000));
+      var_conv(pollData)->numOfEvents = 0;
+#endif
+    } else {
+      timeVal.tv_sec = (long) (timeout / 1000000);
+      timeVal.tv_usec = (long) (timeout % 1000000);
+      doPoll(pollData, &timeVal);
+    } /* if */
+    collectExpiredTimers(&var_conv(pollData)->timers);
   } /* polPoll */
 
 
@@ -1416,3 +1466,37 @@ void polPoll (const pollType pollData)
         break;
     } /* switch */
   } /* polRemoveCheck */
+
+
+
+/**
+ *  Remove the timer of 'aSocket' from 'pollData'.
+ *  Nothing happens, if 'pollData' has no timer for 'aSocket'.
+ */
+void polRemoveTimeout (const pollType pollData, const socketType aSocket)
+
+  { /* polRemoveTimeout */
+    removeTimer(&var_conv(pollData)->timers, aSocket);
+  } /* polRemoveTimeout */
+
+
+
+/**
+ *  Set a timer for 'aSocket', which expires after the given time.
+ *  An existing timer for 'aSocket' is replaced. When the timer expires
+ *  polPoll returns and the timer is removed from 'pollData'. Expired
+ *  timers are processed with polIterFindings(pollData, POLLTIMEOUT).
+ *  @param pollData Poll data to which the timer is added.
+ *  @param aSocket Socket for which the timer is set.
+ *  @param fileObj File to be returned, if the iterator returns
+ *         the expired timers of 'pollData'.
+ *  @exception RANGE_ERROR 'seconds' or 'micro_seconds' not in allowed range.
+ *  @exception MEMORY_ERROR Not enough memory to add the timer.
+ */
+void polSetTimeout (const pollType pollData, const socketType aSocket,
+    intType seconds, intType micro_seconds, const genericType fileObj)
+
+  { /* polSetTimeout */
+    setRelativeTimer(&var_conv(pollData)->timers, aSocket, seconds,
+                     micro_seconds, fileObj);
+  } /* polSetTimeout */
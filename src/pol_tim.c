@@ -0,0 +1,466 @@
+/********************************************************************/
+/*                                                                  */
+/*  pol_tim.c     Timers for the poll type.                         */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/pol_tim.c                                       */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: Timers for the poll type.                              */
+/*                                                                  */
+/*  This file is included by pol_unx.c and pol_sel.c. The timers   */
+/*  of a pollData are kept in a binary min-heap ordered by their    */
+/*  deadline. An index hash maps every socket to its position in   */
+/*  the heap, such that a timer can be changed or removed in        */
+/*  O(log n). Timers are one-shot: When the deadline of a timer is  */
+/*  reached polPoll moves it from the heap to the expired list.     */
+/*                                                                  */
+/********************************************************************/
+
+#define TIMER_START_SIZE    64
+#define TIMER_INCREMENT   1024
+
+typedef struct {
+    intType deadline;
+    socketType sock;
+    genericType file;
+  } timerType;
+
+typedef struct {
+    memSizeType size;
+    memSizeType capacity;
+    timerType *heap;
+    rtlHashType indexHash;
+    memSizeType numOfExpired;
+    memSizeType expiredCapacity;
+    timerType *expired;
+    memSizeType iterPos;
+  } timerHeapType;
+
+
+
+static void setTimerPos (timerHeapType *timers, memSizeType pos)
+
+  { /* setTimerPos */
+    hshIdxAddr(timers->indexHash,
+               (genericType) (usocketType) timers->heap[pos].sock,
+               (intType) timers->heap[pos].sock,
+               (compareType) &genericCmp)->value.genericValue = (genericType) pos;
+  } /* setTimerPos */
+
+
+
+static void siftUpTimer (timerHeapType *timers, memSizeType pos)
+
+  {
+    timerType timer;
+    memSizeType parent;
+    boolType moving = TRUE;
+
+  /* siftUpTimer */
+    timer = timers->heap[pos];
+    while (moving && pos > 0) {
+      parent = (pos - 1) / 2;
+      if (timers->heap[parent].deadline > timer.deadline) {
+        timers->heap[pos] = timers->heap[parent];
+        setTimerPos(timers, pos);
+        pos = parent;
+      } else {
+        moving = FALSE;
+      } /* if */
+    } /* while */
+    timers->heap[pos] = timer;
+    setTimerPos(timers, pos);
+  } /* siftUpTimer */
+
+
+
+static void siftDownTimer (timerHeapType *timers, memSizeType pos)
+
+  {
+    timerType timer;
+    memSizeType child;
+    boolType moving = TRUE;
+
+  /* siftDownTimer */
+    timer = timers->heap[pos];
+    while (moving && 2 * pos + 1 < timers->size) {
+      child = 2 * pos + 1;
+      if (child + 1 < timers->size &&
+          timers->heap[child + 1].deadline < timers->heap[child].deadline) {
+        child++;
+      } /* if */
+      if (timers->heap[child].deadline < timer.deadline) {
+        timers->heap[pos] = timers->heap[child];
+        setTimerPos(timers, pos);
+        pos = child;
+      } else {
+        moving = FALSE;
+      } /* if */
+    } /* while */
+    timers->heap[pos] = timer;
+    setTimerPos(timers, pos);
+  } /* siftDownTimer */
+
+
+
+/**
+ *  Remove the timer at 'pos' from the heap.
+ *  The usage count of the file of the timer is not changed.
+ */
+static void unlinkTimer (timerHeapType *timers, memSizeType pos)
+
+  {
+    socketType aSocket;
+
+  /* unlinkTimer */
+    aSocket = timers->heap[pos].sock;
+    timers->size--;
+    if (pos < timers->size) {
+      timers->heap[pos] = timers->heap[timers->size];
+      if (pos > 0 &&
+          timers->heap[(pos - 1) / 2].deadline > timers->heap[pos].deadline) {
+        siftUpTimer(timers, pos);
+      } else {
+        siftDownTimer(timers, pos);
+      } /* if */
+    } /* if */
+    hshExcl(timers->indexHash, (genericType) (usocketType) aSocket,
+            (intType) aSocket, (compareType) &genericCmp,
+            (destrFuncType) &genericDestr, (destrFuncType) &genericDestr);
+  } /* unlinkTimer */
+
+
+
+static void releaseExpiredTimers (timerHeapType *timers)
+
+  {
+    memSizeType pos;
+
+  /* releaseExpiredTimers */
+    for (pos = 0; pos < timers->numOfExpired; pos++) {
+      fileObjectOps.decrUsageCount(timers->expired[pos].file);
+    } /* for */
+    timers->numOfExpired = 0;
+    timers->iterPos = 0;
+  } /* releaseExpiredTimers */
+
+
+
+static boolType initTimers (timerHeapType *timers)
+
+  { /* initTimers */
+    timers->size = 0;
+    timers->capacity = 0;
+    timers->heap = NULL;
+    timers->numOfExpired = 0;
+    timers->expiredCapacity = 0;
+    timers->expired = NULL;
+    timers->iterPos = 0;
+    timers->indexHash = hshEmpty();
+    return timers->indexHash != NULL;
+  } /* initTimers */
+
+
+
+static void freeTimers (timerHeapType *timers)
+
+  {
+    memSizeType pos;
+
+  /* freeTimers */
+    for (pos = 0; pos < timers->size; pos++) {
+      fileObjectOps.decrUsageCount(timers->heap[pos].file);
+    } /* for */
+    releaseExpiredTimers(timers);
+    if (timers->heap != NULL) {
+      FREE_TABLE(timers->heap, timerType, timers->capacity);
+    } /* if */
+    if (timers->expired != NULL) {
+      FREE_TABLE(timers->expired, timerType, timers->expiredCapacity);
+    } /* if */
+    if (timers->indexHash != NULL) {
+      hshDestr(timers->indexHash, (destrFuncType) &genericDestr,
+               (destrFuncType) &genericDestr);
+    } /* if */
+  } /* freeTimers */
+
+
+
+/**
+ *  Initialize 'dest' with a copy of the timers of 'source'.
+ *  It is assumed that 'dest' is not initialized.
+ *  @return FALSE if there is not enough memory, TRUE otherwise.
+ */
+static boolType copyTimers (timerHeapType *dest, const timerHeapType *source)
+
+  {
+    memSizeType pos;
+
+  /* copyTimers */
+    dest->size = 0;
+    dest->capacity = source->size;
+    dest->heap = NULL;
+    dest->numOfExpired = 0;
+    dest->expiredCapacity = source->numOfExpired;
+    dest->expired = NULL;
+    dest->iterPos = source->iterPos;
+    dest->indexHash = hshCreate(source->indexHash,
+        (createFuncType) &genericCreate, (destrFuncType) &genericDestr,
+        (createFuncType) &genericCreate, (destrFuncType) &genericDestr);
+    if (unlikely(dest->indexHash == NULL ||
+                 (dest->capacity != 0 &&
+                  !ALLOC_TABLE(dest->heap, timerType, dest->capacity)) ||
+                 (dest->expiredCapacity != 0 &&
+                  !ALLOC_TABLE(dest->expired, timerType, dest->expiredCapacity)))) {
+      if (dest->heap != NULL) {
+        FREE_TABLE(dest->heap, timerType, dest->capacity);
+      } /* if */
+      if (dest->indexHash != NULL) {
+        hshDestr(dest->indexHash, (destrFuncType) &genericDestr,
+                 (destrFuncType) &genericDestr);
+      } /* if */
+      return FALSE;
+    } else {
+      for (pos = 0; pos < source->size; pos++) {
+        dest->heap[pos] = source->heap[pos];
+        fileObjectOps.incrUsageCount(dest->heap[pos].file);
+      } /* for */
+      dest->size = source->size;
+      for (pos = 0; pos < source->numOfExpired; pos++) {
+        dest->expired[pos] = source->expired[pos];
+        fileObjectOps.incrUsageCount(dest->expired[pos].file);
+      } /* for */
+      dest->numOfExpired = source->numOfExpired;
+      return TRUE;
+    } /* if */
+  } /* copyTimers */
+
+
+
+/**
+ *  Set the timer of 'aSocket' to 'deadline'.
+ *  An existing timer of 'aSocket' is replaced.
+ *  @exception MEMORY_ERROR Not enough memory to add the timer.
+ */
+static void setTimer (timerHeapType *timers, const socketType aSocket,
+    intType deadline, const genericType fileObj)
+
+  {
+    memSizeType pos;
+    timerType *resizedHeap;
+
+  /* setTimer */
+    pos = (memSizeType) hshIdxEnterDefault(timers->indexHash,
+        (genericType) (usocketType) aSocket, (genericType) timers->size,
+        (intType) aSocket);
+    if (pos == timers->size) {
+      if (timers->size >= timers->capacity) {
+        if (timers->heap == NULL) {
+          if (unlikely(!ALLOC_TABLE(timers->heap, timerType, TIMER_START_SIZE))) {
+            timers->heap = NULL;
+            resizedHeap = NULL;
+          } else {
+            timers->capacity = TIMER_START_SIZE;
+            resizedHeap = timers->heap;
+          } /* if */
+        } else {
+          resizedHeap = REALLOC_TABLE(timers->heap, timerType,
+              timers->capacity, timers->capacity + TIMER_INCREMENT);
+          if (resizedHeap != NULL) {
+            COUNT3_TABLE(timerType, timers->capacity,
+                         timers->capacity + TIMER_INCREMENT);
+            timers->heap = resizedHeap;
+            timers->capacity += TIMER_INCREMENT;
+          } /* if */
+        } /* if */
+        if (unlikely(resizedHeap == NULL)) {
+          hshExcl(timers->indexHash, (genericType) (usocketType) aSocket,
+                  (intType) aSocket, (compareType) &genericCmp,
+                  (destrFuncType) &genericDestr, (destrFuncType) &genericDestr);
+          raise_error(MEMORY_ERROR);
+          return;
+        } /* if */
+      } /* if */
+      timers->heap[pos].sock = aSocket;
+      timers->heap[pos].deadline = deadline;
+      timers->heap[pos].file = fileObjectOps.incrUsageCount(fileObj);
+      timers->size++;
+      siftUpTimer(timers, pos);
+    } else {
+      if (timers->heap[pos].file != fileObj) {
+        fileObjectOps.decrUsageCount(timers->heap[pos].file);
+        timers->heap[pos].file = fileObjectOps.incrUsageCount(fileObj);
+      } /* if */
+      if (deadline < timers->heap[pos].deadline) {
+        timers->heap[pos].deadline = deadline;
+        siftUpTimer(timers, pos);
+      } else {
+        timers->heap[pos].deadline = deadline;
+        siftDownTimer(timers, pos);
+      } /* if */
+    } /* if */
+  } /* setTimer */
+
+
+
+/**
+ *  Set the timer of 'aSocket' to expire after the given time.
+ *  @exception RANGE_ERROR 'seconds' or 'micro_seconds' not in allowed range.
+ *  @exception MEMORY_ERROR Not enough memory to add the timer.
+ */
+static void setRelativeTimer (timerHeapType *timers, const socketType aSocket,
+    intType seconds, intType micro_seconds, const genericType fileObj)
+
+  {
+    intType now;
+    intType deadline;
+
+  /* setRelativeTimer */
+    if (unlikely(seconds < 0 || micro_seconds < 0 || micro_seconds >= 1000000)) {
+      logError(printf("setRelativeTimer(*, %d, " FMT_D ", " FMT_D "): "
+                      "seconds or micro_seconds not in allowed range.\n",
+                      aSocket, seconds, micro_seconds););
+      raise_error(RANGE_ERROR);
+    } else {
+      now = timMicroSec();
+      if (seconds >= (INTTYPE_MAX - now - micro_seconds) / 1000000) {
+        deadline = INTTYPE_MAX;
+      } else {
+        deadline = now + seconds * 1000000 + micro_seconds;
+      } /* if */
+      setTimer(timers, aSocket, deadline, fileObj);
+    } /* if */
+  } /* setRelativeTimer */
+
+
+
+static void removeTimer (timerHeapType *timers, const socketType aSocket)
+
+  {
+    memSizeType pos;
+
+  /* removeTimer */
+    pos = (memSizeType) hshIdxWithDefault(timers->indexHash,
+        (genericType) (usocketType) aSocket, (genericType) timers->size,
+        (intType) aSocket, (compareType) &genericCmp);
+    if (pos != timers->size) {
+      fileObjectOps.decrUsageCount(timers->heap[pos].file);
+      unlinkTimer(timers, pos);
+    } /* if */
+  } /* removeTimer */
+
+
+
+/**
+ *  Determine how long a poll may wait until the next timer expires.
+ *  @return the time to wait in microseconds, or -1 if there is no timer.
+ */
+static intType nextTimeout (const timerHeapType *timers)
+
+  {
+    intType timeout;
+
+  /* nextTimeout */
+    if (timers->size == 0) {
+      timeout = -1;
+    } else {
+      timeout = timers->heap[0].deadline - timMicroSec();
+      if (timeout < 0) {
+        timeout = 0;
+      } /* if */
+    } /* if */
+    return timeout;
+  } /* nextTimeout */
+
+
+
+/**
+ *  Move all timers, which have reached their deadline, to the
+ *  expired list. The timers of the previous poll are released.
+ *  @exception MEMORY_ERROR Not enough memory for the expired list.
+ */
+static void collectExpiredTimers (timerHeapType *timers)
+
+  {
+    intType now;
+    timerType *newExpired;
+    memSizeType newCapacity;
+
+  /* collectExpiredTimers */
+    releaseExpiredTimers(timers);
+    if (timers->size != 0) {
+      now = timMicroSec();
+      while (timers->size != 0 && timers->heap[0].deadline <= now) {
+        if (timers->numOfExpired >= timers->expiredCapacity) {
+          newCapacity = timers->expiredCapacity + TIMER_START_SIZE;
+          if (timers->expired == NULL) {
+            if (!ALLOC_TABLE(newExpired, timerType, newCapacity)) {
+              newExpired = NULL;
+            } /* if */
+          } else {
+            newExpired = REALLOC_TABLE(timers->expired, timerType,
+                timers->expiredCapacity, newCapacity);
+            if (newExpired != NULL) {
+              COUNT3_TABLE(timerType, timers->expiredCapacity, newCapacity);
+            } /* if */
+          } /* if */
+          if (unlikely(newExpired == NULL)) {
+            raise_error(MEMORY_ERROR);
+            return;
+          } else {
+            timers->expired = newExpired;
+            timers->expiredCapacity = newCapacity;
+          } /* if */
+        } /* if */
+        timers->expired[timers->numOfExpired] = timers->heap[0];
+        timers->numOfExpired++;
+        unlinkTimer(timers, 0);
+      } /* while */
+    } /* if */
+  } /* collectExpiredTimers */
+
+
+
+static inline boolType hasNextExpired (const timerHeapType *timers)
+
+  { /* hasNextExpired */
+    return timers->iterPos < timers->numOfExpired;
+  } /* hasNextExpired */
+
+
+
+static genericType nextExpired (timerHeapType *timers,
+    const genericType nullFile)
+
+  {
+    genericType resultFile;
+
+  /* nextExpired */
+    if (timers->iterPos < timers->numOfExpired) {
+      resultFile = timers->expired[timers->iterPos].file;
+      timers->iterPos++;
+    } else {
+      resultFile = nullFile;
+    } /* if */
+    return resultFile;
+  } /* nextExpired */
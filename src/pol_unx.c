@@ -37,12 +37,17 @@
 #include "stdlib.h"
 #include "stdio.h"
 #include "string.h"
+#include "limits.h"
 #if SOCKET_LIB == WINSOCK_SOCKETS
 #include "winsock2.h"
 /* #define os_poll WSAPoll  - available with Vista */
 #else
 #include "poll.h"
 #endif
+#if HAS_EPOLL
+#include "unistd.h"
+#include "sys/epoll.h"
+#endif
 #include "errno.h"
 
 #include "common.h"
@@ -51,6 +56,7 @@
 #include "heaputl.h"
 #include "hsh_rtl.h"
 #include "soc_rtl.h"
+#include "tim_drv.h"
 #include "rtl_err.h"
 
 #undef EXTERN
@@ -60,10 +66,13 @@
 
 
 #include "data.h"
+#include "pol_tim.c"
+
 typedef enum {
     ITER_EMPTY,
     ITER_CHECKS_IN, ITER_CHECKS_OUT, ITER_CHECKS_INOUT,
-    ITER_FINDINGS_IN, ITER_FINDINGS_OUT, ITER_FINDINGS_INOUT
+    ITER_FINDINGS_IN, ITER_FINDINGS_OUT, ITER_FINDINGS_INOUT,
+    ITER_FINDINGS_TIMEOUT
   } iteratorType;
 
 typedef struct {
@@ -76,6 +85,13 @@ typedef struct {
     struct pollfd *pollFds;
     genericType *pollFiles;
     rtlHashType indexHash;
+    timerHeapType timers;
+#if HAS_EPOLL
+    int epollFd;
+    boolType findingsInEvents;
+    memSizeType eventsCapacity;
+    struct epoll_event *events;
+#endif
   } poll_based_pollRecord, *poll_based_pollType;
 
 typedef const poll_based_pollRecord *const_poll_based_pollType;
@@ -94,6 +110,20 @@ size_t sizeof_pollRecord = sizeof(poll_based_pollRecord);
 #define TERMINATING_REVENT   ~0
 #define DUMP_POLL 0
 
+#if HAS_EPOLL
+/* The epoll set is created when polPoll is called the first time. */
+#define EPOLL_NOT_CREATED  -1
+/* Some files (e.g. regular files) cannot be added to an epoll set. */
+#define EPOLL_UNUSABLE     -2
+/* After an epoll_wait() the findings iterator processes the events */
+/* array instead of the pollFds array. Only the sockets in the       */
+/* events array have a nonzero revents field.                        */
+#define ITERATES_POLL_FDS(pollData) \
+    (!(pollData)->findingsInEvents || (pollData)->iteratorMode < ITER_FINDINGS_IN)
+#else
+#define ITERATES_POLL_FDS(pollData) TRUE
+#endif
+
 
 
 #if DUMP_POLL
@@ -142,6 +172,268 @@ void initPollOperations (const createFuncType incrUsageCount,
 
 
 
+/**
+ *  Convert a timeout from nextTimeout() to milliseconds for poll().
+ *  The timeout is rounded up, such that a poll does not return
+ *  before the deadline of the next timer has been reached.
+ */
+static int timeoutInMilliSec (intType timeout)
+
+  { /* timeoutInMilliSec */
+    if (timeout < 0) {
+      return -1;
+    } else if (timeout >= (intType) INT_MAX * 1000 - 999) {
+      return INT_MAX;
+    } else {
+      return (int) ((timeout + 999) / 1000);
+    } /* if */
+  } /* timeoutInMilliSec */
+
+
+
+#if HAS_EPOLL
+static inline memSizeType posOfSocket (const const_poll_based_pollType pollData,
+    const int fd)
+
+  { /* posOfSocket */
+    return (memSizeType) hshIdxWithDefault(pollData->indexHash,
+        (genericType) (usocketType) fd, (genericType) pollData->size,
+        (intType) fd, (compareType) &genericCmp);
+  } /* posOfSocket */
+
+
+
+static uint32_t pollToEpollEvents (short events)
+
+  {
+    uint32_t epollEvents = 0;
+
+  /* pollToEpollEvents */
+    if ((events & POLLIN) != 0) {
+      epollEvents |= EPOLLIN;
+    } /* if */
+    if ((events & POLLOUT) != 0) {
+      epollEvents |= EPOLLOUT;
+    } /* if */
+    return epollEvents;
+  } /* pollToEpollEvents */
+
+
+
+static short epollToPollEvents (uint32_t epollEvents)
+
+  {
+    short events = 0;
+
+  /* epollToPollEvents */
+    if ((epollEvents & EPOLLIN) != 0) {
+      events |= POLLIN;
+    } /* if */
+    if ((epollEvents & EPOLLOUT) != 0) {
+      events |= POLLOUT;
+    } /* if */
+    if ((epollEvents & EPOLLERR) != 0) {
+      events |= POLLERR;
+    } /* if */
+    if ((epollEvents & EPOLLHUP) != 0) {
+      events |= POLLHUP;
+    } /* if */
+    return events;
+  } /* epollToPollEvents */
+
+
+
+static void closeEpoll (const poll_based_pollType pollData, int newState)
+
+  { /* closeEpoll */
+    if (pollData->epollFd >= 0) {
+      close(pollData->epollFd);
+    } /* if */
+    pollData->epollFd = newState;
+  } /* closeEpoll */
+
+
+
+/**
+ *  Keep the epoll set in sync with the events of a pollfd.
+ *  If the epoll set refuses a socket 'pollData' falls back to poll().
+ */
+static void epollControl (const poll_based_pollType pollData, int operation,
+    int fd, short events)
+
+  {
+    struct epoll_event event;
+    int ctl_result;
+
+  /* epollControl */
+    if (pollData->epollFd >= 0) {
+      memset(&event, 0, sizeof(struct epoll_event));
+      event.events = pollToEpollEvents(events);
+      event.data.fd = fd;
+      ctl_result = epoll_ctl(pollData->epollFd, operation, fd, &event);
+      if (unlikely(ctl_result != 0)) {
+        if (operation == EPOLL_CTL_MOD && errno == ENOENT) {
+          /* The socket has been closed and its number has been reused. */
+          ctl_result = epoll_ctl(pollData->epollFd, EPOLL_CTL_ADD, fd, &event);
+        } else if (operation == EPOLL_CTL_DEL) {
+          /* A closed socket is removed from the epoll set automatically. */
+          ctl_result = 0;
+        } /* if */
+        if (unlikely(ctl_result != 0)) {
+          logError(printf("epollControl: epoll_ctl(%d, %d, %d, *) failed:\n"
+                          "%s=%d\nerror: %s\n",
+                          pollData->epollFd, operation, fd, ERROR_INFORMATION););
+          closeEpoll(pollData, EPOLL_UNUSABLE);
+        } /* if */
+      } /* if */
+    } /* if */
+  } /* epollControl */
+
+
+
+static void createEpoll (const poll_based_pollType pollData)
+
+  {
+    memSizeType pos;
+
+  /* createEpoll */
+    pollData->epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (unlikely(pollData->epollFd == -1)) {
+      logError(printf("createEpoll: epoll_create1(EPOLL_CLOEXEC) failed:\n"
+                      "%s=%d\nerror: %s\n", ERROR_INFORMATION););
+      pollData->epollFd = EPOLL_UNUSABLE;
+    } else {
+      for (pos = 0; pos < pollData->size && pollData->epollFd >= 0; pos++) {
+        epollControl(pollData, EPOLL_CTL_ADD, pollData->pollFds[pos].fd,
+                     pollData->pollFds[pos].events);
+      } /* for */
+    } /* if */
+  } /* createEpoll */
+
+
+
+/**
+ *  Wait for the checked events with epoll_wait().
+ *  Only the revents of the sockets found by the previous and the
+ *  current epoll_wait() are touched. This way the costs of a poll
+ *  depend on the number of findings and not on the number of sockets.
+ *  @param timeout Maximum time to wait in milliseconds or -1.
+ *  @return TRUE if epoll has been used, FALSE if poll() must be used.
+ */
+static boolType epollPoll (const poll_based_pollType pollData, int timeout)
+
+  {
+    memSizeType pos;
+    memSizeType idx;
+    int wait_result;
+
+  /* epollPoll */
+    if (pollData->epollFd == EPOLL_NOT_CREATED) {
+      createEpoll(pollData);
+    } /* if */
+    if (pollData->epollFd < 0) {
+      pollData->findingsInEvents = FALSE;
+      return FALSE;
+    } /* if */
+    if (pollData->findingsInEvents) {
+      for (idx = 0; idx < pollData->numOfEvents; idx++) {
+        pos = posOfSocket(pollData, pollData->events[idx].data.fd);
+        if (pos != pollData->size) {
+          pollData->pollFds[pos].revents = 0;
+        } /* if */
+      } /* for */
+    } else {
+      for (pos = 0; pos < pollData->size; pos++) {
+        pollData->pollFds[pos].revents = 0;
+      } /* for */
+    } /* if */
+    pollData->findingsInEvents = TRUE;
+    pollData->numOfEvents = 0;
+    if (pollData->eventsCapacity < pollData->capacity) {
+      if (pollData->events != NULL) {
+        FREE_TABLE(pollData->events, struct epoll_event, pollData->eventsCapacity);
+        pollData->eventsCapacity = 0;
+      } /* if */
+      if (unlikely(!ALLOC_TABLE(pollData->events, struct epoll_event,
+                                pollData->capacity))) {
+        pollData->events = NULL;
+        raise_error(MEMORY_ERROR);
+        return TRUE;
+      } else {
+        pollData->eventsCapacity = pollData->capacity;
+      } /* if */
+    } /* if */
+    do {
+      wait_result = epoll_wait(pollData->epollFd, pollData->events,
+                               (int) pollData->eventsCapacity, timeout);
+    } while (unlikely(wait_result == -1 && errno == EINTR));
+    if (unlikely(wait_result < 0)) {
+      logError(printf("epollPoll: epoll_wait(%d, *, " FMT_U_MEM ", %d) failed:\n"
+                      "%s=%d\nerror: %s\n",
+                      pollData->epollFd, pollData->eventsCapacity, timeout,
+                      ERROR_INFORMATION););
+      raise_error(FILE_ERROR);
+    } else {
+      for (idx = 0; idx < (memSizeType) wait_result; idx++) {
+        pos = posOfSocket(pollData, pollData->events[idx].data.fd);
+        if (pos != pollData->size) {
+          pollData->pollFds[pos].revents =
+              epollToPollEvents(pollData->events[idx].events);
+        } /* if */
+      } /* for */
+      pollData->iteratorMode = ITER_EMPTY;
+      pollData->iterPos = 0;
+      pollData->numOfEvents = (memSizeType) wait_result;
+    } /* if */
+    return TRUE;
+  } /* epollPoll */
+
+
+
+static boolType hasNextEventFinding (const poll_based_pollType pollData,
+    short eventsToCheck)
+
+  {
+    memSizeType idx;
+    memSizeType pos = 0;
+    boolType hasNext = FALSE;
+
+  /* hasNextEventFinding */
+    for (idx = pollData->iterPos; !hasNext && idx < pollData->numOfEvents; idx++) {
+      pos = posOfSocket(pollData, pollData->events[idx].data.fd);
+      hasNext = pos != pollData->size &&
+          (pollData->pollFds[pos].revents & eventsToCheck) != 0;
+    } /* for */
+    if (hasNext) {
+      idx--;
+    } /* if */
+    pollData->iterPos = idx;
+    return hasNext;
+  } /* hasNextEventFinding */
+
+
+
+static genericType nextEventFinding (const poll_based_pollType pollData,
+    short eventsToCheck, const genericType nullFile)
+
+  {
+    genericType resultFile;
+
+  /* nextEventFinding */
+    if (hasNextEventFinding(pollData, eventsToCheck)) {
+      resultFile = pollData->pollFiles[posOfSocket(pollData,
+          pollData->events[pollData->iterPos].data.fd)];
+      pollData->iterPos++;
+    } else {
+      resultFile = nullFile;
+    } /* if */
+    return resultFile;
+  } /* nextEventFinding */
+
+#endif
+
+
+
 static void addCheck (const poll_based_pollType pollData, short eventsToCheck,
     const socketType aSocket, const genericType fileObj)
 
@@ -185,8 +477,15 @@ static void addCheck (const poll_based_pollType pollData, short eventsToCheck,
       memset(&pollData->pollFds[pollData->size], 0, sizeof(struct pollfd));
       pollData->pollFds[pollData->size].revents = TERMINATING_REVENT;
       pollData->pollFiles[pos] = fileObjectOps.incrUsageCount(fileObj);
-    } else {
+#if HAS_EPOLL
+      epollControl(pollData, EPOLL_CTL_ADD, (int) aSocket, eventsToCheck);
+#endif
+    } else if ((pollData->pollFds[pos].events & eventsToCheck) != eventsToCheck) {
       pollData->pollFds[pos].events |= eventsToCheck;
+#if HAS_EPOLL
+      epollControl(pollData, EPOLL_CTL_MOD, (int) aSocket,
+                   pollData->pollFds[pos].events);
+#endif
     } /* if */
     logFunction(printf("addCheck -->\n");
                 dumpPoll((const_pollType) pollData););
@@ -208,9 +507,13 @@ static void removeCheck (const poll_based_pollType pollData, short eventsToCheck
     if (pos != pollData->size) {
       aPollFd = &pollData->pollFds[pos];
       aPollFd->events &= (short) ~eventsToCheck;
+#if HAS_EPOLL
+      epollControl(pollData, aPollFd->events == 0 ? EPOLL_CTL_DEL : EPOLL_CTL_MOD,
+                   (int) aSocket, aPollFd->events);
+#endif
       if (aPollFd->events == 0) {
         fileObjectOps.decrUsageCount(pollData->pollFiles[pos]);
-        if (pos + 1 <= pollData->iterPos) {
+        if (pos + 1 <= pollData->iterPos && ITERATES_POLL_FDS(pollData)) {
           pollData->iterPos--;
           if (pos < pollData->iterPos) {
             memcpy(&pollData->pollFds[pos],
@@ -267,6 +570,11 @@ static boolType hasNextFinding (const poll_based_pollType pollData, short events
     boolType hasNext;
 
   /* hasNextFinding */
+#if HAS_EPOLL
+    if (pollData->findingsInEvents) {
+      return hasNextEventFinding(pollData, eventsToCheck);
+    } /* if */
+#endif
     if (pollData->iterEvents == 0) {
       hasNext = FALSE;
       pollData->iterPos = pollData->size;
@@ -322,6 +630,11 @@ static genericType nextFinding (const poll_based_pollType pollData,
   /* nextFinding */
     logFunction(printf("nextFinding\n");
                 dumpPoll((const_pollType) pollData););
+#if HAS_EPOLL
+    if (pollData->findingsInEvents) {
+      return nextEventFinding(pollData, eventsToCheck, nullFile);
+    } /* if */
+#endif
     if (pollData->iterEvents == 0) {
       resultFile = nullFile;
       pollData->iterPos = pollData->size;
@@ -412,13 +725,57 @@ void polClear (const pollType pollData)
     var_conv(pollData)->iterPos = 0;
     var_conv(pollData)->iterEvents = 0;
     var_conv(pollData)->numOfEvents = 0;
+#if HAS_EPOLL
+    closeEpoll(var_conv(pollData), EPOLL_NOT_CREATED);
+    var_conv(pollData)->findingsInEvents = FALSE;
+#endif
     hshDestr(conv(pollData)->indexHash, (destrFuncType) &genericDestr,
              (destrFuncType) &genericDestr);
     var_conv(pollData)->indexHash = hshEmpty();
+    freeTimers(&var_conv(pollData)->timers);
+    initTimers(&var_conv(pollData)->timers);
   } /* polClear */
 
 
 
+#if HAS_EPOLL
+/**
+ *  Copy the epoll findings of 'source' to 'dest'.
+ *  The epoll set itself is not shared. The epoll set of 'dest' is
+ *  created when 'dest' is polled the next time.
+ *  @return FALSE if there is not enough memory, TRUE otherwise.
+ */
+static boolType copyEpollFindings (const poll_based_pollType dest,
+    const const_poll_based_pollType source)
+
+  {
+    struct epoll_event *newEvents = NULL;
+    memSizeType newEventsCapacity = 0;
+
+  /* copyEpollFindings */
+    if (source->findingsInEvents && source->numOfEvents != 0) {
+      newEventsCapacity = source->numOfEvents;
+      if (unlikely(!ALLOC_TABLE(newEvents, struct epoll_event, newEventsCapacity))) {
+        return FALSE;
+      } else {
+        memcpy(newEvents, source->events,
+               source->numOfEvents * sizeof(struct epoll_event));
+      } /* if */
+    } /* if */
+    if (dest->events != NULL) {
+      FREE_TABLE(dest->events, struct epoll_event, dest->eventsCapacity);
+    } /* if */
+    closeEpoll(dest, EPOLL_NOT_CREATED);
+    dest->findingsInEvents = source->findingsInEvents;
+    dest->eventsCapacity = newEventsCapacity;
+    dest->events = newEvents;
+    return TRUE;
+  } /* copyEpollFindings */
+
+#endif
+
+
+
 /**
  *  Assign source to dest.
  *  A copy function assumes that dest contains a legal value.
@@ -435,12 +792,24 @@ void polCpy (const pollType dest, const const_pollType source)
     genericType *oldPollFiles;
     memSizeType oldPollFilesSize;
     memSizeType oldPollFilesCapacity;
+    timerHeapType newTimers;
     memSizeType pos;
 
   /* polCpy */
     logFunction(printf("polCpy(" FMT_U_MEM ", " FMT_U_MEM ")\n",
                        (memSizeType) dest, (memSizeType) source););
     if (dest != source) {
+      if (unlikely(!copyTimers(&newTimers, &conv(source)->timers))) {
+        raise_error(MEMORY_ERROR);
+        return;
+      } /* if */
+#if HAS_EPOLL
+      if (unlikely(!copyEpollFindings(var_conv(dest), conv(source)))) {
+        freeTimers(&newTimers);
+        raise_error(MEMORY_ERROR);
+        return;
+      } /* if */
+#endif
       newIndexHash = hshCreate(conv(source)->indexHash,
           (createFuncType) &genericCreate, (destrFuncType) &genericDestr,
           (createFuncType) &genericCreate, (destrFuncType) &genericDestr);
@@ -456,12 +825,14 @@ void polCpy (const pollType dest, const const_pollType source)
         newPollFilesCapacity = pollData->capacity;
       } /* if */
       if (unlikely(!ALLOC_TABLE(newPollFiles, genericType, newPollFilesCapacity))) {
+        freeTimers(&newTimers);
         raise_error(MEMORY_ERROR);
         return;
       } else {
         if (conv(source)->size + NUM_OF_EXTRA_ELEMS > pollData->capacity) {
           if (unlikely(!ALLOC_TABLE(newPollFds, struct pollfd, conv(source)->capacity))) {
             FREE_TABLE(newPollFiles, genericType, newPollFilesCapacity);
+            freeTimers(&newTimers);
             raise_error(MEMORY_ERROR);
             return;
           } else {
@@ -489,6 +860,8 @@ void polCpy (const pollType dest, const const_pollType source)
         fileObjectOps.decrUsageCount(oldPollFiles[pos]);
       } /* for */
       FREE_TABLE(oldPollFiles, genericType, oldPollFilesCapacity);
+      freeTimers(&pollData->timers);
+      pollData->timers = newTimers;
     } /* if */
     logFunction(printf("polCpy -->\n");
                 dumpPoll(dest););
@@ -515,6 +888,10 @@ pollType polCreate (const const_pollType source)
     if (unlikely(!ALLOC_RECORD(result, poll_based_pollRecord, count.polldata))) {
       raise_error(MEMORY_ERROR);
     } else {
+#if HAS_EPOLL
+      result->epollFd = EPOLL_NOT_CREATED;
+      result->events = NULL;
+#endif
       if (unlikely(!ALLOC_TABLE(result->pollFds, struct pollfd, conv(source)->capacity))) {
         FREE_RECORD(result, poll_based_pollRecord, count.polldata);
         raise_error(MEMORY_ERROR);
@@ -525,6 +902,21 @@ pollType polCreate (const const_pollType source)
           FREE_RECORD(result, poll_based_pollRecord, count.polldata);
           raise_error(MEMORY_ERROR);
           result = NULL;
+        } else if (unlikely(!copyTimers(&result->timers, &conv(source)->timers))) {
+          FREE_TABLE(result->pollFiles, genericType, conv(source)->capacity);
+          FREE_TABLE(result->pollFds, struct pollfd, conv(source)->capacity);
+          FREE_RECORD(result, poll_based_pollRecord, count.polldata);
+          raise_error(MEMORY_ERROR);
+          result = NULL;
+#if HAS_EPOLL
+        } else if (unlikely(!copyEpollFindings(result, conv(source)))) {
+          freeTimers(&result->timers);
+          FREE_TABLE(result->pollFiles, genericType, conv(source)->capacity);
+          FREE_TABLE(result->pollFds, struct pollfd, conv(source)->capacity);
+          FREE_RECORD(result, poll_based_pollRecord, count.polldata);
+          raise_error(MEMORY_ERROR);
+          result = NULL;
+#endif
         } else {
           result->indexHash = hshCreate(conv(source)->indexHash,
               (createFuncType) &genericCreate, (destrFuncType) &genericDestr,
@@ -572,6 +964,14 @@ void polDestr (const pollType oldPollData)
       FREE_TABLE(conv(oldPollData)->pollFiles, genericType, conv(oldPollData)->capacity);
       hshDestr(conv(oldPollData)->indexHash, (destrFuncType) &genericDestr,
                (destrFuncType) &genericDestr);
+      freeTimers(&var_conv(oldPollData)->timers);
+#if HAS_EPOLL
+      closeEpoll(var_conv(oldPollData), EPOLL_NOT_CREATED);
+      if (conv(oldPollData)->events != NULL) {
+        FREE_TABLE(conv(oldPollData)->events, struct epoll_event,
+                   conv(oldPollData)->eventsCapacity);
+      } /* if */
+#endif
       FREE_RECORD(var_conv(oldPollData), poll_based_pollRecord, count.polldata);
     } /* if */
   } /* polDestr */
@@ -602,6 +1002,12 @@ pollType polEmpty (void)
           FREE_RECORD(result, poll_based_pollRecord, count.polldata);
           raise_error(MEMORY_ERROR);
           result = NULL;
+        } else if (unlikely(!initTimers(&result->timers))) {
+          FREE_TABLE(result->pollFiles, genericType, TABLE_START_SIZE);
+          FREE_TABLE(result->pollFds, struct pollfd, TABLE_START_SIZE);
+          FREE_RECORD(result, poll_based_pollRecord, count.polldata);
+          raise_error(MEMORY_ERROR);
+          result = NULL;
         } else {
           result->indexHash = hshEmpty();
           result->size = 0;
@@ -610,6 +1016,12 @@ pollType polEmpty (void)
           result->iterPos = 0;
           result->iterEvents = 0;
           result->numOfEvents = 0;
+#if HAS_EPOLL
+          result->epollFd = EPOLL_NOT_CREATED;
+          result->findingsInEvents = FALSE;
+          result->eventsCapacity = 0;
+          result->events = NULL;
+#endif
           memset(&result->pollFds[0], 0, sizeof(struct pollfd));
           result->pollFds[0].revents = TERMINATING_REVENT;
         } /* if */
@@ -737,6 +1149,8 @@ boolType polHasNext (const pollType pollData)
         return hasNextFinding(var_conv(pollData), POLLOUT);
       case ITER_FINDINGS_INOUT:
         return hasNextFinding(var_conv(pollData), POLLIN | POLLOUT);
+      case ITER_FINDINGS_TIMEOUT:
+        return hasNextExpired(&conv(pollData)->timers);
       case ITER_EMPTY:
       default:
         return FALSE;
@@ -791,6 +1205,7 @@ void polIterChecks (const pollType pollData, intType pollMode)
  *  - POLLIN data can be read from the corresponding socket.
  *  - POLLOUT data can be written to the corresponding socket.
  *  - POLLINOUT data can be read or written (POLLIN and POLLOUT).
+ *  - POLLTIMEOUT the timers, which expired in the last polPoll.
  *
  *  @exception RANGE_ERROR Illegal value for 'pollMode'.
  */
@@ -810,6 +1225,10 @@ void polIterFindings (const pollType pollData, intType pollMode)
       case POLL_INOUT:
         var_conv(pollData)->iteratorMode = ITER_FINDINGS_INOUT;
         break;
+      case POLL_TIMEOUT:
+        var_conv(pollData)->iteratorMode = ITER_FINDINGS_TIMEOUT;
+        var_conv(pollData)->timers.iterPos = 0;
+        break;
       default:
         raise_error(RANGE_ERROR);
         break;
@@ -855,6 +1274,9 @@ genericType polNextFile (const pollType pollData, const genericType nullFile)
       case ITER_FINDINGS_INOUT:
         nextFile = nextFinding(var_conv(pollData), POLLIN | POLLOUT, nullFile);
         break;
+      case ITER_FINDINGS_TIMEOUT:
+        nextFile = nextExpired(&var_conv(pollData)->timers, nullFile);
+        break;
       case ITER_EMPTY:
       default:
         nextFile = nullFile;
@@ -868,35 +1290,48 @@ genericType polNextFile (const pollType pollData, const genericType nullFile)
 /**
  *  Waits for one or more of the checkedEvents from 'pollData'.
  *  polPoll waits until one of the checkedEvents for a
- *  corresponding socket occurs. If a checked event occurs
+ *  corresponding socket occurs or until the nearest timer of
+ *  'pollData' expires. If a checked event occurs
  *  the eventFindings field is assigned a value. The following
  *  eventFindings values are assigned:
  *  - POLLIN data can be read from the corresponding socket.
  *  - POLLOUT data can be written to the corresponding socket.
  *  - POLLINOUT data can be read and written (POLLIN and POLLOUT).
  *
+ *  Timers, which reach their deadline, are removed from 'pollData'
+ *  and can be processed with polIterFindings(pollData, POLLTIMEOUT).
  *  @exception FILE_ERROR The system function returns an error.
  */
 void polPoll (const pollType pollData)
 
   {
+    int timeout;
     int poll_result;
 
   /* polPoll */
     logFunction(printf("polPoll\n");
                 dumpPoll(pollData););
+    timeout = timeoutInMilliSec(nextTimeout(&conv(pollData)->timers));
+#if HAS_EPOLL
+    if (epollPoll(var_conv(pollData), timeout)) {
+      collectExpiredTimers(&var_conv(pollData)->timers);
+      logFunction(printf("polPoll -->\n"););
+      return;
+    } /* if */
+#endif
     do {
-      poll_result = os_poll(conv(pollData)->pollFds, conv(pollData)->size, -1); /* &timeout); */
+      poll_result = os_poll(conv(pollData)->pollFds, conv(pollData)->size, timeout);
     } while (unlikely(poll_result == -1 && errno == EINTR));
     if (unlikely(poll_result < 0)) {
-      logError(printf("polPoll: poll(*, " FMT_U_MEM ", -1) failed:\n"
+      logError(printf("polPoll: poll(*, " FMT_U_MEM ", %d) failed:\n"
                       "%s=%d\nerror: %s\n",
-                      conv(pollData)->size, ERROR_INFORMATION););
+                      conv(pollData)->size, timeout, ERROR_INFORMATION););
       raise_error(FILE_ERROR);
     } else {
       var_conv(pollData)->iteratorMode = ITER_EMPTY;
       var_conv(pollData)->iterPos = 0;
       var_conv(pollData)->numOfEvents = (memSizeType) poll_result;
+      collectExpiredTimers(&var_conv(pollData)->timers);
     } /* if */
     logFunction(printf("polPoll -->\n"););
   } /* polPoll */
@@ -937,3 +1372,41 @@ void polRemoveCheck (const pollType pollData, const socketType aSocket,
         break;
     } /* switch */
   } /* polRemoveCheck */
+
+
+
+/**
+ *  Remove the timer of 'aSocket' from 'pollData'.
+ *  Nothing happens, if 'pollData' has no timer for 'aSocket'.
+ */
+void polRemoveTimeout (const pollType pollData, const socketType aSocket)
+
+  { /* polRemoveTimeout */
+    logFunction(printf("polRemoveTimeout(" FMT_U_MEM ", %d)\n",
+                       (memSizeType) pollData, aSocket););
+    removeTimer(&var_conv(pollData)->timers, aSocket);
+  } /* polRemoveTimeout */
+
+
+
+/**
+ *  Set a timer for 'aSocket', which expires after the given time.
+ *  An existing timer for 'aSocket' is replaced. When the timer expires
+ *  polPoll returns and the timer is removed from 'pollData'. Expired
+ *  timers are processed with polIterFindings(pollData, POLLTIMEOUT).
+ *  @param pollData Poll data to which the timer is added.
+ *  @param aSocket Socket for which the timer is set.
+ *  @param fileObj File to be returned, if the iterator returns
+ *         the expired timers of 'pollData'.
+ *  @exception RANGE_ERROR 'seconds' or 'micro_seconds' not in allowed range.
+ *  @exception MEMORY_ERROR Not enough memory to add the timer.
+ */
+void polSetTimeout (const pollType pollData, const socketType aSocket,
+    intType seconds, intType micro_seconds, const genericType fileObj)
+
+  { /* polSetTimeout */
+    logFunction(printf("polSetTimeout(" FMT_U_MEM ", %d, " FMT_D ", " FMT_D ")\n",
+                       (memSizeType) pollData, aSocket, seconds, micro_seconds););
+    setRelativeTimer(&var_conv(pollData)->timers, aSocket, seconds,
+                     micro_seconds, fileObj);
+  } /* polSetTimeout */
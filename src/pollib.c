@@ -389,6 +389,53 @@ objectType pol_remove_check (listType arguments)
 
 
 
+/**
+ *  Remove the timer of aSocket/arg_2 from pollData/arg_1.
+ *  Nothing happens, if pollData/arg_1 has no timer for aSocket/arg_2.
+ */
+objectType pol_remove_timeout (listType arguments)
+
+  { /* pol_remove_timeout */
+    isit_poll(arg_1(arguments));
+    isit_socket(arg_2(arguments));
+    polRemoveTimeout(take_poll(arg_1(arguments)),
+                     take_socket(arg_2(arguments)));
+    return SYS_EMPTY_OBJECT;
+  } /* pol_remove_timeout */
+
+
+
+/**
+ *  Set a timer for aSocket/arg_2, which expires after the given time.
+ *  The timer expires after seconds/arg_3 and micro_seconds/arg_4.
+ *  An existing timer for aSocket/arg_2 is replaced. Expired timers
+ *  are processed with pol_iter_findings(pollData, POLLTIMEOUT).
+ *  @param pollData/arg_1 Poll data to which the timer is added.
+ *  @param aSocket/arg_2 Socket for which the timer is set.
+ *  @param fileObj/arg_5 File to be returned, if the iterator returns
+ *         the expired timers of pollData/arg_1.
+ *  @exception RANGE_ERROR seconds/arg_3 or micro_seconds/arg_4 not
+ *             in allowed range.
+ */
+objectType pol_set_timeout (listType arguments)
+
+  { /* pol_set_timeout */
+    isit_poll(arg_1(arguments));
+    isit_socket(arg_2(arguments));
+    isit_int(arg_3(arguments));
+    isit_int(arg_4(arguments));
+    isit_interface(arg_5(arguments));
+    isit_struct(take_interface(arg_5(arguments)));
+    polSetTimeout(take_poll(arg_1(arguments)),
+                  take_socket(arg_2(arguments)),
+                  take_int(arg_3(arguments)),
+                  take_int(arg_4(arguments)),
+                  (genericType) (memSizeType) take_interface(arg_5(arguments)));
+    return SYS_EMPTY_OBJECT;
+  } /* pol_set_timeout */
+
+
+
 objectType pol_value (listType arguments)
 
   {
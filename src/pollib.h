@@ -39,4 +39,6 @@ objectType pol_iter_findings (listType arguments);
 objectType pol_next_file     (listType arguments);
 objectType pol_poll          (listType arguments);
 objectType pol_remove_check  (listType arguments);
+objectType pol_remove_timeout (listType arguments);
+objectType pol_set_timeout   (listType arguments);
 objectType pol_value         (listType arguments);
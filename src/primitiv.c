@@ -33,16 +33,21 @@
 #include "data.h"
 #include "actutl.h"
 #include "actlib.h"
+#include "aeslib.h"
 #include "arrlib.h"
 #include "biglib.h"
 #include "binlib.h"
 #include "blnlib.h"
 #include "bstlib.h"
+#include "bz2lib.h"
 #include "chrlib.h"
 #include "cmdlib.h"
 #include "conlib.h"
+#include "corlib.h"
 #include "dcllib.h"
+#include "dfllib.h"
 #include "drwlib.h"
+#include "ecclib.h"
 #include "enulib.h"
 #include "fillib.h"
 #include "fltlib.h"
@@ -50,6 +55,8 @@
 #include "intlib.h"
 #include "itflib.h"
 #include "kbdlib.h"
+#include "lzmlib.h"
+#include "mdglib.h"
 #include "pcslib.h"
 #include "pollib.h"
 #include "prclib.h"
@@ -65,6 +72,7 @@
 #include "timlib.h"
 #include "typlib.h"
 #include "ut8lib.h"
+#include "zstlib.h"
 
 #undef EXTERN
 #define EXTERN
@@ -87,6 +95,12 @@ static const actEntryRecord actEntryTable[] = {
 
     { "ACT_CREATE",                   act_create,                   },
 
+    { "AES_CBC_DECODE",               aes_cbc_decode,               },
+    { "AES_CBC_ENCODE",               aes_cbc_encode,               },
+    { "AES_GCM_DECRYPT",              aes_gcm_decrypt,              },
+    { "AES_GCM_ENCRYPT",              aes_gcm_encrypt,              },
+    { "AES_INIT",                     aes_init,                     },
+
     { "ARR_APPEND",                   arr_append,                   },
     { "ARR_ARRLIT",                   arr_arrlit,                   },
     { "ARR_ARRLIT2",                  arr_arrlit2,                  },
@@ -236,6 +250,9 @@ static const actEntryRecord actEntryTable[] = {
     { "BST_STR",                      bst_str,                      },
     { "BST_VALUE",                    bst_value,                    },
 
+    { "BZ2_DECODE_FINISHED",          bz2_decode_finished,          },
+    { "BZ2_DECODE_INIT",              bz2_decode_init,              },
+    { "BZ2_DECODE_STEP",              bz2_decode_step,              },
     { "CHR_CLIT",                     chr_clit,                     },
     { "CHR_CMP",                      chr_cmp,                      },
     { "CHR_CPY",                      chr_cpy,                      },
@@ -290,6 +307,7 @@ static const actEntryRecord actEntryTable[] = {
     { "CMD_MAKE_LINK",                cmd_make_link,                },
     { "CMD_MOVE",                     cmd_move,                     },
     { "CMD_READ_DIR",                 cmd_read_dir,                 },
+    { "CMD_READ_DIR_INFO",            cmd_read_dir_info,            },
     { "CMD_READ_LINK",                cmd_read_link,                },
     { "CMD_READ_LINK_ABSOLUTE",       cmd_read_link_absolute,       },
     { "CMD_REMOVE_FILE",              cmd_remove_file,              },
@@ -322,6 +340,10 @@ static const actEntryRecord actEntryTable[] = {
     { "CON_WIDTH",                    con_width,                    },
     { "CON_WRITE",                    con_write,                    },
 
+    { "COR_RUN",                      cor_run,                      },
+    { "COR_SPAWN",                    cor_spawn,                    },
+    { "COR_YIELD",                    cor_yield,                    },
+
     { "DCL_ATTR",                     dcl_attr,                     },
     { "DCL_CONST",                    dcl_const,                    },
     { "DCL_ELEMENTS",                 dcl_elements,                 },
@@ -345,6 +367,12 @@ static const actEntryRecord actEntryTable[] = {
     { "DCL_VAL2",                     dcl_val2,                     },
     { "DCL_VAR",                      dcl_var,                      },
 
+    { "DFL_DEFLATE_INIT",             dfl_deflate_init,             },
+    { "DFL_DEFLATE_STEP",             dfl_deflate_step,             },
+    { "DFL_INFLATE_FINISHED",         dfl_inflate_finished,         },
+    { "DFL_INFLATE_INIT",             dfl_inflate_init,             },
+    { "DFL_INFLATE_STEP",             dfl_inflate_step,             },
+
 #if WITH_DRAW
     { "DRW_BORDER",                   drw_border,                   },
     { "DRW_CAPTURE",                  drw_capture,                  },
@@ -408,6 +436,9 @@ static const actEntryRecord actEntryTable[] = {
     { "DRW_YPOS",                     drw_ypos,                     },
 #endif
 
+    { "ECC_MULT",                     ecc_mult,                     },
+    { "ECC_X25519",                   ecc_x25519,                   },
+
     { "ENU_CONV",                     enu_conv,                     },
     { "ENU_CPY",                      enu_cpy,                      },
     { "ENU_CREATE",                   enu_create,                   },
@@ -443,6 +474,7 @@ static const actEntryRecord actEntryTable[] = {
     { "FIL_LNG",                      fil_lng,                      },
     { "FIL_NE",                       fil_ne,                       },
     { "FIL_OPEN",                     fil_open,                     },
+    { "FIL_OPEN_MAPPED",              fil_open_mapped,              },
     { "FIL_OPEN_NULL_DEVICE",         fil_open_null_device,         },
     { "FIL_OUT",                      fil_out,                      },
     { "FIL_PCLOSE",                   fil_pclose,                   },
@@ -589,6 +621,7 @@ static const actEntryRecord actEntryTable[] = {
     { "INT_ICONV1",                   int_iconv1,                   },
     { "INT_ICONV3",                   int_iconv3,                   },
     { "INT_INCR",                     int_incr,                     },
+    { "INT_JOIN",                     int_join,                     },
     { "INT_LE",                       int_le,                       },
     { "INT_LOG10",                    int_log10,                    },
     { "INT_LOG2",                     int_log2,                     },
@@ -619,6 +652,7 @@ static const actEntryRecord actEntryTable[] = {
     { "INT_RSHIFT_ASSIGN",            int_rshift_assign,            },
     { "INT_SBTR",                     int_sbtr,                     },
     { "INT_SBTR_ASSIGN",              int_sbtr_assign,              },
+    { "INT_SPLIT",                    int_split,                    },
     { "INT_SQRT",                     int_sqrt,                     },
     { "INT_STR",                      int_str,                      },
     { "INT_SUCC",                     int_succ,                     },
@@ -645,6 +679,19 @@ static const actEntryRecord actEntryTable[] = {
     { "KBD_RAW_GETC",                 kbd_raw_getc,                 },
     { "KBD_WORD_READ",                kbd_word_read,                },
 
+    { "LZM_DECODE_FINISHED",          lzm_decode_finished,          },
+    { "LZM_DECODE_INIT",              lzm_decode_init,              },
+    { "LZM_DECODE_STEP",              lzm_decode_step,              },
+    { "MDG_ADLER32",                  mdg_adler32,                  },
+    { "MDG_BZIP2_CRC32",              mdg_bzip2_crc32,              },
+    { "MDG_CRC32",                    mdg_crc32,                    },
+    { "MDG_CRC32C",                   mdg_crc32c,                   },
+    { "MDG_DIGEST",                   mdg_digest,                   },
+    { "MDG_FILE_DIGEST",              mdg_file_digest,              },
+    { "MDG_FINAL",                    mdg_final,                    },
+    { "MDG_INIT",                     mdg_init,                     },
+    { "MDG_UPDATE",                   mdg_update,                   },
+
     { "PCS_CHILD_STDERR",             pcs_child_stderr,             },
     { "PCS_CHILD_STDIN",              pcs_child_stdin,              },
     { "PCS_CHILD_STDOUT",             pcs_child_stdout,             },
@@ -695,6 +742,8 @@ static const actEntryRecord actEntryTable[] = {
     { "POL_NEXT_FILE",                pol_next_file,                },
     { "POL_POLL",                     pol_poll,                     },
     { "POL_REMOVE_CHECK",             pol_remove_check,             },
+    { "POL_REMOVE_TIMEOUT",           pol_remove_timeout,           },
+    { "POL_SET_TIMEOUT",              pol_set_timeout,              },
     { "POL_VALUE",                    pol_value,                    },
 
     { "PRC_ARGS",                     prc_args,                     },
@@ -935,10 +984,12 @@ static const actEntryRecord actEntryTable[] = {
     { "SOC_RECVFROM",                 soc_recvfrom,                 },
     { "SOC_SEND",                     soc_send,                     },
     { "SOC_SENDTO",                   soc_sendto,                   },
+    { "SOC_SEND_FILE",                soc_send_file,                },
     { "SOC_SET_OPT_BOOL",             soc_set_opt_bool,             },
     { "SOC_SOCKET",                   soc_socket,                   },
     { "SOC_WORD_READ",                soc_word_read,                },
     { "SOC_WRITE",                    soc_write,                    },
+    { "SOC_WRITEV",                   soc_writev,                   },
 
 #if WITH_SQL
     { "SQL_BIND_BIGINT",              sql_bind_bigint,              },
@@ -1093,6 +1144,9 @@ static const actEntryRecord actEntryTable[] = {
     { "UT8_SEEK",                     ut8_seek,                     },
     { "UT8_WORD_READ",                ut8_word_read,                },
     { "UT8_WRITE",                    ut8_write,                    },
+    { "ZST_DECODE_FINISHED",          zst_decode_finished,          },
+    { "ZST_DECODE_INIT",              zst_decode_init,              },
+    { "ZST_DECODE_STEP",              zst_decode_step,              },
   };
 
 
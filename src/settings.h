@@ -0,0 +1,21 @@
+#define MAKE_UTILITY_NAME "make"
+#define MAKEFILE_NAME "makefile"
+#define SEARCH_PATH_DELIMITER ':'
+#define AWAIT_WITH_SELECT
+#define SIGNAL_HANDLER_CAN_DO_IO
+#define CONSOLE_UTF8
+#define OS_STRI_UTF8
+#define ESCAPE_SHELL_COMMANDS
+#define LIBRARY_FILE_EXTENSION ".a"
+#define CPLUSPLUS_COMPILER "g++"
+#define CC_SOURCE_UTF8
+#define CC_OPT_DEBUG_INFO "-g"
+#define CC_OPT_NO_WARNINGS "-w"
+#define LINKER_OPT_NO_DEBUG_INFO "-Wl,--strip-debug"
+#define LINKER_FLAGS "-Wl,--gc-sections"
+#define SEED7_LIB "seed7_05.a"
+#define DRAW_LIB "s7_draw.a"
+#define CONSOLE_LIB "s7_con.a"
+#define DATABASE_LIB "s7_db.a"
+#define COMP_DATA_LIB "s7_data.a"
+#define COMPILER_LIB "s7_comp.a"
@@ -239,6 +239,16 @@ intType socSend (socketType sock, const const_striType stri, intType flags)
 
 
 
+intType socSendFile (socketType outSocket, fileType inFile, intType position,
+    intType length)
+
+  { /* socSendFile */
+    raise_error(FILE_ERROR);
+    return 0;
+  } /* socSendFile */
+
+
+
 intType socSendto (socketType sock, const const_striType stri, intType flags,
     const_bstriType address)
 
@@ -281,4 +291,12 @@ void socWrite (socketType outSocket, const const_striType stri)
     raise_error(FILE_ERROR);
   } /* socWrite */
 
+
+
+void socWritev (socketType outSocket, const const_rtlArrayType striArray)
+
+  { /* socWritev */
+    raise_error(FILE_ERROR);
+  } /* socWritev */
+
 #endif
@@ -34,6 +34,10 @@
 
 #include "version.h"
 
+#if HAS_ACCEPT4
+#define _GNU_SOURCE
+#endif
+
 #if SOCKET_LIB == UNIX_SOCKETS || SOCKET_LIB == WINSOCK_SOCKETS
 #include "stdlib.h"
 #include "stdio.h"
@@ -44,14 +48,19 @@
 
 #include "sys/types.h"
 #include "sys/socket.h"
+#include "fcntl.h"
 #include "netdb.h"
 #include "netinet/in.h"
+#include "netinet/tcp.h"
 #if HAS_SELECT
 #include "sys/select.h"
 #endif
 #if HAS_POLL
 #include "poll.h"
 #endif
+#if HAS_SENDFILE
+#include "sys/sendfile.h"
+#endif
 
 #elif SOCKET_LIB == WINSOCK_SOCKETS
 
@@ -75,6 +84,8 @@
 #include "striutl.h"
 #include "os_decls.h"
 #include "int_rtl.h"
+#include "fil_rtl.h"
+#include "cor_rtl.h"
 #include "rtl_err.h"
 
 #undef EXTERN
@@ -90,6 +101,7 @@ typedef socklen_t sockLenType;
 #define cast_buffer_len(len)          len
 #define ADDRLEN_NEGATIVE(len) 0
 #define INVALID_SOCKET (-1)
+#define SOCKET_WOULD_BLOCK() (errno == EAGAIN || errno == EWOULDBLOCK)
 
 #elif SOCKET_LIB == WINSOCK_SOCKETS
 
@@ -100,6 +112,7 @@ static boolType initialized = FALSE;
 #define cast_send_recv_data(data_ptr) ((char *) (data_ptr))
 #define cast_buffer_len(len)          ((int) (len))
 #define ADDRLEN_NEGATIVE(len) (len) < 0
+#define SOCKET_WOULD_BLOCK() (WSAGetLastError() == WSAEWOULDBLOCK)
 #ifndef SHUT_RDWR
 #define SHUT_RDWR SD_BOTH
 #endif
@@ -118,6 +131,29 @@ static boolType initialized = FALSE;
 #define MAX_SOCK_ADDRESS_LEN \
     STRLEN("[0123:4567:89ab:cdef:0123:4567:89ab:cdef]:") + UINT16TYPE_DECIMAL_SIZE
 
+#define INPUT_BUFFER_SIZE          8192
+#define INPUT_BUFFER_TABLE_DELTA    256
+
+typedef struct {
+    memSizeType start;
+    memSizeType end;
+    ucharType data[INPUT_BUFFER_SIZE];
+  } inputBufferRecord, *inputBufferType;
+
+
+#if SOCKET_LIB == UNIX_SOCKETS
+/* The input buffers of sockets with SOC_OPT_BUFFERED_INPUT.       */
+/* They are indexed by the socket (file descriptor) number.        */
+static inputBufferType *inputBufferTable = NULL;
+static memSizeType inputBufferTableSize = 0;
+
+#define inputBufferOf(sock) \
+    ((memSizeType) (sock) < inputBufferTableSize ? \
+     inputBufferTable[(memSizeType) (sock)] : NULL)
+#else
+#define inputBufferOf(sock) ((inputBufferType) NULL)
+#endif
+
 
 
 #if ANY_LOG_ACTIVE
@@ -369,6 +405,211 @@ static void showAddrinfo (struct addrinfo *addrinfo_list)
 
 
 
+#if SOCKET_LIB == UNIX_SOCKETS
+static boolType createInputBuffer (socketType sock)
+
+  {
+    memSizeType newTableSize;
+    inputBufferType *resizedTable;
+    inputBufferType inputBuffer;
+
+  /* createInputBuffer */
+    if ((memSizeType) sock >= inputBufferTableSize) {
+      newTableSize = (memSizeType) sock + INPUT_BUFFER_TABLE_DELTA;
+      resizedTable = (inputBufferType *) realloc(inputBufferTable,
+          newTableSize * sizeof(inputBufferType));
+      if (unlikely(resizedTable == NULL)) {
+        return FALSE;
+      } /* if */
+      memset(&resizedTable[inputBufferTableSize], 0,
+             (newTableSize - inputBufferTableSize) * sizeof(inputBufferType));
+      inputBufferTable = resizedTable;
+      inputBufferTableSize = newTableSize;
+    } /* if */
+    if (inputBufferTable[sock] == NULL) {
+      inputBuffer = (inputBufferType) malloc(sizeof(inputBufferRecord));
+      if (unlikely(inputBuffer == NULL)) {
+        return FALSE;
+      } /* if */
+      inputBuffer->start = 0;
+      inputBuffer->end = 0;
+      inputBufferTable[sock] = inputBuffer;
+    } /* if */
+    return TRUE;
+  } /* createInputBuffer */
+
+
+
+static void freeInputBuffer (socketType sock)
+
+  { /* freeInputBuffer */
+    if ((memSizeType) sock < inputBufferTableSize &&
+        inputBufferTable[sock] != NULL) {
+      free(inputBufferTable[sock]);
+      inputBufferTable[sock] = NULL;
+    } /* if */
+  } /* freeInputBuffer */
+
+#else
+#define freeInputBuffer(sock)
+#endif
+
+
+
+/**
+ *  Wait until 'sock' is ready for reading or writing.
+ *  This is used for sockets in non-blocking mode, when a function
+ *  like socGets() or socWrite() must wait for the data. Inside of
+ *  a coroutine the other coroutines run in the meantime.
+ *  @param forWriting TRUE if the socket should be ready for writing,
+ *         FALSE if it should be ready for reading.
+ *  @return TRUE if the socket is ready, FALSE if an error occurred.
+ */
+static boolType waitForSocket (socketType sock, boolType forWriting)
+
+  {
+#if HAS_POLL
+    struct pollfd pollFd[1];
+#else
+    fd_set fds;
+#endif
+    int ready;
+
+  /* waitForSocket */
+    logFunction(printf("waitForSocket(%d, %d)\n", sock, forWriting););
+#if HAS_POLL
+    if (inCoroutine) {
+      /* Let the other coroutines run while this one waits. */
+      ready = corWaitForSocket(sock, forWriting, -1) ? 1 : -1;
+    } else {
+      pollFd[0].fd = (int) sock;
+      pollFd[0].events = forWriting ? POLLOUT : POLLIN;
+      ready = os_poll(pollFd, 1, -1);
+    } /* if */
+#else
+    FD_ZERO(&fds);
+    FD_SET((os_socketType) sock, &fds);
+    ready = select((int) sock + 1, forWriting ? NULL : &fds,
+                   forWriting ? &fds : NULL, NULL, NULL);
+#endif
+    if (unlikely(ready < 0)) {
+      logError(printf("waitForSocket(%d, %d): Waiting failed:\n"
+                      "%s=%d\nerror: %s\n",
+                      sock, forWriting, ERROR_INFORMATION););
+    } /* if */
+    logFunction(printf("waitForSocket(%d, %d) --> %d\n",
+                       sock, forWriting, ready > 0););
+    return ready > 0;
+  } /* waitForSocket */
+
+
+
+/**
+ *  Receive up to 'length' bytes with recv() and wait if necessary.
+ *  If 'inSocket' is in non-blocking mode and no data is available
+ *  the function waits until data arrives. This way socGetc(),
+ *  socGets(), socLineRead(), etc. block also for non-blocking sockets.
+ *  @return the number of bytes received, or -1 if an error occurred.
+ */
+static memSizeType recvWaiting (socketType inSocket, void *buffer,
+    memSizeType length, int flags)
+
+  {
+    memSizeType bytes_received;
+
+  /* recvWaiting */
+#ifdef MSG_DONTWAIT
+    if (inCoroutine) {
+      /* A blocking socket must not block the other coroutines. */
+      flags |= MSG_DONTWAIT;
+    } /* if */
+#endif
+    do {
+      bytes_received = (memSizeType) recv((os_socketType) inSocket,
+                                          cast_send_recv_data(buffer),
+                                          cast_buffer_len(length), flags);
+    } while (unlikely(bytes_received == (memSizeType) -1 &&
+                      SOCKET_WOULD_BLOCK() &&
+                      waitForSocket(inSocket, FALSE)));
+    return bytes_received;
+  } /* recvWaiting */
+
+
+
+/**
+ *  Refill the empty 'inputBuffer' of 'inSocket' with one recv().
+ *  @return TRUE if data has been received, FALSE at EOF or error.
+ */
+static boolType fillInputBuffer (socketType inSocket, inputBufferType inputBuffer)
+
+  {
+    memSizeType bytes_received;
+
+  /* fillInputBuffer */
+    bytes_received = recvWaiting(inSocket, inputBuffer->data, INPUT_BUFFER_SIZE, 0);
+    logMessage(printf("fillInputBuffer: bytes_received=" FMT_U_MEM "\n",
+                      bytes_received););
+    if (unlikely(bytes_received == (memSizeType) -1)) {
+      logError(printf("fillInputBuffer: "
+                      "recv(%d, *, " FMT_U_MEM ", 0) failed:\n"
+                      "%s=%d\nerror: %s\n",
+                      inSocket, (memSizeType) INPUT_BUFFER_SIZE,
+                      ERROR_INFORMATION););
+      bytes_received = 0;
+    } /* if */
+    inputBuffer->start = 0;
+    inputBuffer->end = bytes_received;
+    return bytes_received != 0;
+  } /* fillInputBuffer */
+
+
+
+/**
+ *  Copy up to 'length' bytes from the 'inputBuffer' to 'dest'.
+ *  If 'peek' is TRUE the bytes are not removed from the buffer.
+ *  @return the number of bytes copied.
+ */
+static memSizeType takeFromInputBuffer (inputBufferType inputBuffer,
+    ucharType *dest, memSizeType length, boolType peek)
+
+  {
+    memSizeType bytes_available;
+
+  /* takeFromInputBuffer */
+    bytes_available = inputBuffer->end - inputBuffer->start;
+    if (length > bytes_available) {
+      length = bytes_available;
+    } /* if */
+    memcpy(dest, &inputBuffer->data[inputBuffer->start], length);
+    if (!peek) {
+      inputBuffer->start += length;
+    } /* if */
+    return length;
+  } /* takeFromInputBuffer */
+
+
+
+/**
+ *  Receive one byte either from the input buffer or with recv().
+ *  @return 1 if a byte has been received, 0 or -1 otherwise.
+ */
+static inline memSizeType receiveByte (socketType inSocket,
+    inputBufferType inputBuffer, unsigned char *ch)
+
+  { /* receiveByte */
+    if (inputBuffer == NULL) {
+      return recvWaiting(inSocket, ch, 1, 0);
+    } else if (inputBuffer->start != inputBuffer->end ||
+               fillInputBuffer(inSocket, inputBuffer)) {
+      *ch = inputBuffer->data[inputBuffer->start++];
+      return 1;
+    } else {
+      return 0;
+    } /* if */
+  } /* receiveByte */
+
+
+
 /**
  *  Read a string, if we do not know how many bytes are available.
  *  This function reads data into a list of buffers. This is done
@@ -396,9 +637,7 @@ static striType receive_and_alloc_stri (socketType inSocket, memSizeType chars_m
     while (chars_missing - result_size >= LIST_BUFFER_SIZE &&
            bytes_in_buffer == LIST_BUFFER_SIZE &&
            input_ready) {
-      bytes_in_buffer = (memSizeType) recv((os_socketType) inSocket,
-                                           cast_send_recv_data(currBuffer->buffer),
-                                           cast_buffer_len(LIST_BUFFER_SIZE), 0);
+      bytes_in_buffer = recvWaiting(inSocket, currBuffer->buffer, LIST_BUFFER_SIZE, 0);
       logMessage(printf("receive_and_alloc_stri: bytes_in_buffer=" FMT_U_MEM "\n",
                         bytes_in_buffer););
       if (unlikely(bytes_in_buffer == (memSizeType) -1)) {
@@ -429,9 +668,8 @@ static striType receive_and_alloc_stri (socketType inSocket, memSizeType chars_m
     if (chars_missing > result_size &&
         bytes_in_buffer == LIST_BUFFER_SIZE &&
         input_ready) {
-      bytes_in_buffer = (memSizeType) recv((os_socketType) inSocket,
-                                           cast_send_recv_data(currBuffer->buffer),
-                                           cast_buffer_len(chars_missing - result_size), 0);
+      bytes_in_buffer = recvWaiting(inSocket, currBuffer->buffer,
+                                    chars_missing - result_size, 0);
       logMessage(printf("receive_and_alloc_stri: bytes_in_buffer=" FMT_U_MEM "\n",
                         bytes_in_buffer););
       if (unlikely(bytes_in_buffer == (memSizeType) -1)) {
@@ -478,22 +716,271 @@ static striType receive_and_alloc_stri (socketType inSocket, memSizeType chars_m
 
 
 
+/**
+ *  Send all 'length' bytes from 'buffer' to 'outSocket'.
+ *  Send is called repeatedly until all bytes are sent or an error occurs.
+ *  If 'outSocket' is in non-blocking mode it waits until sending is
+ *  possible again.
+ */
+static void sendBytes (socketType outSocket, const ucharType *buffer,
+    memSizeType length, errInfoType *err_info)
+
+  {
+    memSizeType bytes_sent;
+    memSizeType totally_sent = 0;
+    int flags = 0;
+
+  /* sendBytes */
+    logFunction(printf("sendBytes(%d, *, " FMT_U_MEM ", %d)\n",
+                       outSocket, length, *err_info););
+#ifdef MSG_DONTWAIT
+    if (inCoroutine) {
+      /* A blocking socket must not block the other coroutines. */
+      flags = MSG_DONTWAIT;
+    } /* if */
+#endif
+    while (totally_sent < length && *err_info == OKAY_NO_ERROR) {
+      bytes_sent = (memSizeType) send((os_socketType) outSocket,
+                                      cast_send_recv_data(&buffer[totally_sent]),
+                                      cast_buffer_len(length - totally_sent), flags);
+      if (unlikely(bytes_sent == (memSizeType) -1)) {
+        /* A socket in non-blocking mode waits until sending is possible. */
+        if (!SOCKET_WOULD_BLOCK() || !waitForSocket(outSocket, TRUE)) {
+          logError(printf("sendBytes(%d, *, " FMT_U_MEM "): "
+                          "send(%d, data, " FMT_U_MEM ") failed:\n"
+                          "%s=%d\nerror: %s\n"
+                          "bytes sent successfully: " FMT_U_MEM "\n",
+                          outSocket, length, outSocket, length - totally_sent,
+                          ERROR_INFORMATION, totally_sent););
+          *err_info = FILE_ERROR;
+        } /* if */
+      } else {
+        totally_sent += bytes_sent;
+      } /* if */
+    } /* while */
+    logFunction(printf("sendBytes(%d, *, " FMT_U_MEM ", %d) -->\n",
+                       outSocket, length, *err_info););
+  } /* sendBytes */
+
+
+
+#if HAS_SENDFILE
+/**
+ *  Send up to 'length' bytes of the file 'file_no' with sendfile().
+ *  The data is copied in the kernel and the file offset of 'file_no'
+ *  is not changed. While the data is sent the socket is corked, such
+ *  that the last partial segment is not delayed by the Nagle algorithm.
+ *  @param offset Start of the data (zero based).
+ *  @param totally_sent The number of bytes sent is added to it.
+ *  @return TRUE if the data was sent (or an error occurred), or
+ *          FALSE if sendfile() is not supported for these files.
+ */
+static boolType sendFileInKernel (socketType outSocket, int file_no,
+    os_off_t offset, memSizeType length, memSizeType *totally_sent,
+    errInfoType *err_info)
+
+  {
+    ssize_t bytes_sent;
+#ifdef TCP_CORK
+    int cork;
+    boolType corked;
+#endif
+    boolType done = TRUE;
+
+  /* sendFileInKernel */
+    logFunction(printf("sendFileInKernel(%d, %d, " FMT_D_OFF ", " FMT_U_MEM ")\n",
+                       outSocket, file_no, offset, length););
+#ifdef TCP_CORK
+    cork = 1;
+    corked = setsockopt((os_socketType) outSocket, IPPROTO_TCP, TCP_CORK,
+                        &cork, sizeof(cork)) == 0;
+#endif
+    while (*totally_sent < length && *err_info == OKAY_NO_ERROR) {
+      bytes_sent = sendfile((os_socketType) outSocket, file_no, &offset,
+                            length - *totally_sent);
+      if (bytes_sent > 0) {
+        *totally_sent += (memSizeType) bytes_sent;
+      } else if (bytes_sent == 0) {
+        /* End of file reached. */
+        length = *totally_sent;
+      } else if (*totally_sent == 0 &&
+                 (errno == EINVAL || errno == ENOSYS || errno == EOPNOTSUPP)) {
+        done = FALSE;
+        length = 0;
+      } else if (SOCKET_WOULD_BLOCK() && waitForSocket(outSocket, TRUE)) {
+        /* The socket is in non-blocking mode: Continue when possible. */
+      } else {
+        logError(printf("sendFileInKernel(%d, %d, *, " FMT_U_MEM "): "
+                        "sendfile(%d, %d, *, " FMT_U_MEM ") failed:\n"
+                        "errno=%d\nerror: %s\n"
+                        "bytes sent successfully: " FMT_U_MEM "\n",
+                        outSocket, file_no, length, outSocket, file_no,
+                        length - *totally_sent, errno, strerror(errno),
+                        *totally_sent););
+        *err_info = FILE_ERROR;
+      } /* if */
+    } /* while */
+#ifdef TCP_CORK
+    if (corked) {
+      /* Removing the cork sends the last partial segment immediately. */
+      cork = 0;
+      setsockopt((os_socketType) outSocket, IPPROTO_TCP, TCP_CORK,
+                 &cork, sizeof(cork));
+    } /* if */
+#endif
+    logFunction(printf("sendFileInKernel(%d, %d, *, " FMT_U_MEM ", " FMT_U_MEM
+                       ", %d) --> %d\n", outSocket, file_no, length,
+                       *totally_sent, *err_info, done););
+    return done;
+  } /* sendFileInKernel */
+#endif
+
+
+
+/**
+ *  Send up to 'length' bytes of 'inFile' starting at 'position'.
+ *  The data is read with fread() into a buffer and sent from there.
+ *  Afterwards the file position of 'inFile' is restored.
+ *  @param totally_sent The number of bytes sent is added to it.
+ */
+static void sendFileWithBuffer (socketType outSocket, fileType inFile,
+    intType position, memSizeType length, memSizeType *totally_sent,
+    errInfoType *err_info)
+
+  {
+    ucharType buffer[BUFFER_SIZE];
+    intType oldPosition;
+    memSizeType bytes_read = 1;
+
+  /* sendFileWithBuffer */
+    logFunction(printf("sendFileWithBuffer(%d, %d, " FMT_D ", " FMT_U_MEM ")\n",
+                       outSocket, safe_fileno(inFile->cFile), position, length););
+    oldPosition = filTell(inFile);
+    if (likely(oldPosition != 0)) {
+      filSeek(inFile, position);
+      while (*totally_sent < length && bytes_read != 0 &&
+             *err_info == OKAY_NO_ERROR) {
+        bytes_read = (memSizeType) fread(buffer, 1,
+            length - *totally_sent < BUFFER_SIZE ?
+            length - *totally_sent : BUFFER_SIZE, inFile->cFile);
+        if (bytes_read != 0) {
+          sendBytes(outSocket, buffer, bytes_read, err_info);
+          *totally_sent += bytes_read;
+        } else if (unlikely(ferror(inFile->cFile))) {
+          logError(printf("sendFileWithBuffer(%d, %d, " FMT_D ", " FMT_U_MEM "): "
+                          "fread() failed:\n"
+                          "errno=%d\nerror: %s\n",
+                          outSocket, safe_fileno(inFile->cFile), position,
+                          length, errno, strerror(errno)););
+          *err_info = FILE_ERROR;
+        } /* if */
+      } /* while */
+      filSeek(inFile, oldPosition);
+    } /* if */
+    logFunction(printf("sendFileWithBuffer(%d, %d, " FMT_D ", " FMT_U_MEM
+                       ", " FMT_U_MEM ", %d) -->\n",
+                       outSocket, safe_fileno(inFile->cFile), position,
+                       length, *totally_sent, *err_info););
+  } /* sendFileWithBuffer */
+
+
+
 /**
  *  Create a new accepted connection socket for 'listenerSocket'.
  *  The function waits until at least one connection request is
  *  in the sockets queue of pending connections. Then it extracts
  *  the first connection request from the sockets queue. This
  *  request is accepted and a connection socket is created for it.
- *  @return the accepted connection socket.
+ *  If 'listenerSocket' is in non-blocking mode and no connection
+ *  request is pending the function returns -1 immediately. This
+ *  allows draining the queue of pending connections with a loop.
+ *  The accepted socket is not inherited by child processes.
+ *  @return the accepted connection socket, or -1 if a non-blocking
+ *          'listenerSocket' has no pending connection request.
  *  @exception FILE_ERROR A system function returns an error.
  *  @exception MEMORY_ERROR An out of memory situation occurred.
  */
+#if SOCKET_LIB == UNIX_SOCKETS && HAS_POLL
+/**
+ *  Wait inside of a coroutine until a connection request is pending.
+ *  A blocking accept() would block all coroutines. A listener in
+ *  non-blocking mode does not wait, like outside of a coroutine.
+ */
+static void waitForConnectionRequest (socketType listenerSocket)
+
+  {
+    struct pollfd pollFd[1];
+    int flags;
+
+  /* waitForConnectionRequest */
+    flags = fcntl((os_socketType) listenerSocket, F_GETFL);
+    if (flags != -1 && (flags & O_NONBLOCK) == 0) {
+      pollFd[0].fd = (int) listenerSocket;
+      pollFd[0].events = POLLIN;
+      if (os_poll(pollFd, 1, 0) == 0) {
+        corWaitForSocket(listenerSocket, FALSE, -1);
+      } /* if */
+    } /* if */
+  } /* waitForConnectionRequest */
+
+
+
+/**
+ *  Connect 'aSocket' inside of a coroutine.
+ *  A blocking socket is switched to non-blocking mode during the
+ *  connect(), such that the other coroutines run while the
+ *  connection is established.
+ *  @return 0 if the connection succeeded, -1 otherwise.
+ */
+static int connectInCoroutine (socketType aSocket, const_bstriType address)
+
+  {
+    int flags;
+    int soError;
+    sockLenType optlen;
+    int savedErrno;
+    int result;
+
+  /* connectInCoroutine */
+    flags = fcntl((os_socketType) aSocket, F_GETFL);
+    if (flags == -1 || (flags & O_NONBLOCK) != 0 ||
+        fcntl((os_socketType) aSocket, F_SETFL, flags | O_NONBLOCK) == -1) {
+      result = connect((os_socketType) aSocket,
+                       (const struct sockaddr *) address->mem,
+                       (sockLenType) address->size);
+    } else {
+      result = connect((os_socketType) aSocket,
+                       (const struct sockaddr *) address->mem,
+                       (sockLenType) address->size);
+      if (result != 0 && errno == EINPROGRESS &&
+          corWaitForSocket(aSocket, TRUE, -1)) {
+        optlen = sizeof(soError);
+        if (getsockopt((os_socketType) aSocket, SOL_SOCKET, SO_ERROR,
+                       &soError, &optlen) == 0) {
+          if (soError == 0) {
+            result = 0;
+          } else {
+            errno = soError;
+          } /* if */
+        } /* if */
+      } /* if */
+      savedErrno = errno;
+      fcntl((os_socketType) aSocket, F_SETFL, flags);
+      errno = savedErrno;
+    } /* if */
+    return result;
+  } /* connectInCoroutine */
+#endif
+
+
+
 socketType socAccept (socketType listenerSocket, bstriType *address)
 
   {
     memSizeType old_address_size;
     bstriType resized_address;
     sockLenType addrlen;
+    boolType noPendingRequest;
     os_socketType result;
 
   /* socAccept */
@@ -508,12 +995,24 @@ socketType socAccept (socketType listenerSocket, bstriType *address)
       *address = resized_address;
       COUNT3_BSTRI(old_address_size, MAX_ADDRESS_SIZE);
       addrlen = MAX_ADDRESS_SIZE;
+#if SOCKET_LIB == UNIX_SOCKETS && HAS_POLL
+      if (inCoroutine) {
+        waitForConnectionRequest(listenerSocket);
+      } /* if */
+#endif
+#if HAS_ACCEPT4
+      result = (os_socketType) accept4((os_socketType) listenerSocket,
+                                       (struct sockaddr *) (*address)->mem, &addrlen,
+                                       SOCK_CLOEXEC);
+#else
       result = (os_socketType) accept((os_socketType) listenerSocket,
                                       (struct sockaddr *) (*address)->mem, &addrlen);
+#endif
       if (unlikely(result == INVALID_SOCKET ||
                    ADDRLEN_NEGATIVE(addrlen) ||
                    addrlen > MAX_ADDRESS_SIZE)) {
         /* printf("socAccept(%d) %s=%d %s\n", listenerSocket, ERROR_INFORMATION); */
+        noPendingRequest = result == INVALID_SOCKET && SOCKET_WOULD_BLOCK();
         REALLOC_BSTRI_SIZE_OK(resized_address, *address, MAX_ADDRESS_SIZE, old_address_size);
         if (resized_address == NULL) {
           (*address)->size = MAX_ADDRESS_SIZE;
@@ -521,12 +1020,17 @@ socketType socAccept (socketType listenerSocket, bstriType *address)
           *address = resized_address;
           COUNT3_BSTRI(MAX_ADDRESS_SIZE, old_address_size);
         } /* if */
-        logError(printf("socAccept: accept(%d, \"%s\") failed:\n"
-                        "%s=%d\nerror: %s\n",
-                        listenerSocket, socAddressCStri(*address),
-                        ERROR_INFORMATION););
-        raise_error(FILE_ERROR);
+        if (!noPendingRequest) {
+          logError(printf("socAccept: accept(%d, \"%s\") failed:\n"
+                          "%s=%d\nerror: %s\n",
+                          listenerSocket, socAddressCStri(*address),
+                          ERROR_INFORMATION););
+          raise_error(FILE_ERROR);
+        } /* if */
+        result = (os_socketType) -1;
       } else {
+        /* A socket closed without socClose() leaves its buffer behind. */
+        freeInputBuffer((socketType) result);
         REALLOC_BSTRI_SIZE_OK(resized_address, *address, MAX_ADDRESS_SIZE,
                               (memSizeType) addrlen);
         if (unlikely(resized_address == NULL)) {
@@ -748,6 +1252,8 @@ void socClose (socketType aSocket)
 
   /* socClose */
     logFunction(printf("socClose(%d)\n", aSocket););
+    freeInputBuffer(aSocket);
+    corForgetSocket(aSocket);
     shutdown((os_socketType) aSocket, SHUT_RDWR);
 #if SOCKET_LIB == UNIX_SOCKETS
     close_result = close((os_socketType) aSocket);
@@ -770,12 +1276,23 @@ void socClose (socketType aSocket)
  */
 void socConnect (socketType aSocket, const_bstriType address)
 
-  { /* socConnect */
+  {
+    int result;
+
+  /* socConnect */
     logFunction(printf("socConnect(%d, \"%s\")\n",
                        aSocket, socAddressCStri(address)););
-    if (unlikely(connect((os_socketType) aSocket,
-                         (const struct sockaddr *) address->mem,
-                         (sockLenType) address->size) != 0)) {
+#if SOCKET_LIB == UNIX_SOCKETS && HAS_POLL
+    if (inCoroutine) {
+      result = connectInCoroutine(aSocket, address);
+    } else
+#endif
+    {
+      result = connect((os_socketType) aSocket,
+                       (const struct sockaddr *) address->mem,
+                       (sockLenType) address->size);
+    } /* if */
+    if (unlikely(result != 0)) {
       logError(printf("socConnect: connect(%d, \"%s\") failed:\n"
                       "%s=%d\nerror: %s\n",
                       aSocket, socAddressCStri(address),
@@ -800,8 +1317,7 @@ charType socGetc (socketType inSocket, charType *const eofIndicator)
   /* socGetc */
     logFunction(printf("socGetc(%d, '\\" FMT_U32 ";')\n",
                        inSocket, *eofIndicator););
-    bytes_received = (memSizeType) recv((os_socketType) inSocket,
-                                        cast_send_recv_data(&ch), 1, 0);
+    bytes_received = receiveByte(inSocket, inputBufferOf(inSocket), &ch);
     logMessage(printf("socGetc: bytes_received=" FMT_U_MEM "\n",
                       bytes_received););
     if (bytes_received != 1) {
@@ -835,6 +1351,7 @@ striType socGets (socketType inSocket, intType length, charType *const eofIndica
   {
     memSizeType chars_requested;
     memSizeType result_size;
+    inputBufferType inputBuffer;
     errInfoType err_info = OKAY_NO_ERROR;
     striType resized_result;
     striType result;
@@ -870,12 +1387,38 @@ striType socGets (socketType inSocket, intType length, charType *const eofIndica
       } else {
         chars_requested = (memSizeType) length;
       } /* if */
-      if (chars_requested <= BUFFER_SIZE) {
+      inputBuffer = inputBufferOf(inSocket);
+      if (inputBuffer != NULL &&
+          (inputBuffer->start != inputBuffer->end ||
+           chars_requested < INPUT_BUFFER_SIZE)) {
+        if (inputBuffer->start == inputBuffer->end &&
+            !fillInputBuffer(inSocket, inputBuffer)) {
+          result_size = 0;
+        } else {
+          result_size = inputBuffer->end - inputBuffer->start;
+          if (result_size > chars_requested) {
+            result_size = chars_requested;
+          } /* if */
+        } /* if */
+        if (unlikely(!ALLOC_STRI_CHECK_SIZE(result, result_size))) {
+          logError(printf("socGets(%d, " FMT_D ", *): "
+                          "Out of memory when allocating result.\n",
+                          inSocket, length););
+          raise_error(MEMORY_ERROR);
+          result = NULL;
+        } else {
+          memcpy_to_strelem(result->mem, &inputBuffer->data[inputBuffer->start],
+                            result_size);
+          inputBuffer->start += result_size;
+          result->size = result_size;
+          if (result_size == 0) {
+            *eofIndicator = (charType) EOF;
+          } /* if */
+        } /* if */
+      } else if (chars_requested <= BUFFER_SIZE) {
         ucharType buffer[BUFFER_SIZE];
 
-        result_size = (memSizeType) recv((os_socketType) inSocket,
-                                         cast_send_recv_data(buffer),
-                                         cast_buffer_len(chars_requested), 0);
+        result_size = recvWaiting(inSocket, buffer, chars_requested, 0);
         logMessage(printf("socGets: result_size=" FMT_U_MEM "\n",
                           result_size););
         if (unlikely(result_size == (memSizeType) -1)) {
@@ -916,9 +1459,7 @@ striType socGets (socketType inSocket, intType length, charType *const eofIndica
             raise_error(MEMORY_ERROR);
             result = NULL;
           } else {
-            result_size = (memSizeType) recv((os_socketType) inSocket,
-                                             cast_send_recv_data(result->mem),
-                                             cast_buffer_len(chars_requested), 0);
+            result_size = recvWaiting(inSocket, result->mem, chars_requested, 0);
             logMessage(printf("socGets: result_size=" FMT_U_MEM "\n",
                               result_size););
             if (unlikely(result_size == (memSizeType) -1)) {
@@ -1098,12 +1639,19 @@ boolType socHasNext (socketType inSocket)
   {
     unsigned char next_char;
     memSizeType bytes_received;
+    inputBufferType inputBuffer;
     boolType hasNext;
 
   /* socHasNext */
     logFunction(printf("socHasNext(%d)\n", inSocket););
-    bytes_received = (memSizeType) recv((os_socketType) inSocket,
-                                        cast_send_recv_data(&next_char), 1, MSG_PEEK);
+    inputBuffer = inputBufferOf(inSocket);
+    if (inputBuffer != NULL) {
+      hasNext = inputBuffer->start != inputBuffer->end ||
+                fillInputBuffer(inSocket, inputBuffer);
+      logFunction(printf("socHasNext(%d) --> %d\n", inSocket, hasNext););
+      return hasNext;
+    } /* if */
+    bytes_received = recvWaiting(inSocket, &next_char, 1, MSG_PEEK);
     if (bytes_received != 1) {
       logMessage(printf("socHasNext: bytes_received=" FMT_U_MEM "\n",
                         bytes_received););
@@ -1543,11 +2091,23 @@ boolType socInputReady (socketType sock, intType seconds, intType micro_seconds)
                       sock, seconds, micro_seconds););
       raise_error(RANGE_ERROR);
       inputReady = FALSE;
+    } else if (inputBufferOf(sock) != NULL &&
+               inputBufferOf(sock)->start != inputBufferOf(sock)->end) {
+      inputReady = TRUE;
     } else {
       pollFd[0].fd = (int) sock;
       pollFd[0].events = POLLIN;
       timeout = (int) seconds * 1000 + (int) (micro_seconds / 1000);
-      poll_result = os_poll(pollFd, 1, timeout);
+      if (inCoroutine && timeout != 0) {
+        /* Let the other coroutines run while this one waits. */
+        poll_result = os_poll(pollFd, 1, 0);
+        if (poll_result == 0) {
+          corWaitForSocket(sock, FALSE, seconds * 1000000 + micro_seconds);
+          poll_result = os_poll(pollFd, 1, 0);
+        } /* if */
+      } else {
+        poll_result = os_poll(pollFd, 1, timeout);
+      } /* if */
       if (unlikely(poll_result < 0)) {
         logError(printf("socInputReady(%d, " FMT_D ", " FMT_D "): "
                         "os_poll([%d, POLLIN], 1, %d) failed:\n"
@@ -1607,6 +2167,9 @@ boolType socInputReady (socketType sock, intType seconds, intType micro_seconds)
                       sock, seconds, micro_seconds););
       raise_error(RANGE_ERROR);
       inputReady = FALSE;
+    } else if (inputBufferOf(sock) != NULL &&
+               inputBufferOf(sock)->start != inputBufferOf(sock)->end) {
+      inputReady = TRUE;
     } else {
       FD_ZERO(&readfds);
       FD_SET((os_socketType) sock, &readfds);
@@ -1648,6 +2211,89 @@ boolType socInputReady (socketType sock, intType seconds, intType micro_seconds)
 
 
 
+/**
+ *  Read a line from the input buffer of 'inSocket'.
+ *  The buffer is searched with memchr() and refilled when it is
+ *  empty. Each refill costs one recv() for up to INPUT_BUFFER_SIZE
+ *  bytes, so a line usually needs no system call at all.
+ */
+static striType bufferedLineRead (socketType inSocket, inputBufferType inputBuffer,
+    charType *const terminationChar)
+
+  {
+    ucharType *segment;
+    ucharType *nlPos = NULL;
+    memSizeType segment_length;
+    memSizeType result_size = 0;
+    memSizeType result_capacity = 0;
+    memSizeType new_capacity;
+    striType resized_result;
+    striType result = NULL;
+
+  /* bufferedLineRead */
+    do {
+      if (inputBuffer->start == inputBuffer->end &&
+          !fillInputBuffer(inSocket, inputBuffer)) {
+        *terminationChar = (charType) EOF;
+        segment_length = 0;
+      } else {
+        segment = &inputBuffer->data[inputBuffer->start];
+        segment_length = inputBuffer->end - inputBuffer->start;
+        nlPos = (ucharType *) memchr(segment, '\n', segment_length);
+        if (nlPos != NULL) {
+          segment_length = (memSizeType) (nlPos - segment);
+        } /* if */
+        if (result_size + segment_length > result_capacity || result == NULL) {
+          new_capacity = result_size + segment_length;
+          if (result != NULL && new_capacity < 2 * result_capacity) {
+            new_capacity = 2 * result_capacity;
+          } /* if */
+          REALLOC_STRI_CHECK_SIZE2(resized_result, result, result_capacity, new_capacity);
+          if (unlikely(resized_result == NULL)) {
+            if (result != NULL) {
+              FREE_STRI2(result, result_capacity);
+            } /* if */
+            raise_error(MEMORY_ERROR);
+            return NULL;
+          } /* if */
+          result = resized_result;
+          result_capacity = new_capacity;
+        } /* if */
+        memcpy_to_strelem(&result->mem[result_size], segment, segment_length);
+        result_size += segment_length;
+        inputBuffer->start += segment_length;
+        if (nlPos != NULL) {
+          inputBuffer->start++;
+          if (result_size != 0 && result->mem[result_size - 1] == '\r') {
+            result_size--;
+          } /* if */
+          *terminationChar = '\n';
+        } /* if */
+      } /* if */
+    } while (nlPos == NULL && segment_length != 0);
+    if (result == NULL) {
+      emptyStriType emptyStri;
+
+      if (unlikely(!ALLOC_EMPTY_STRI(emptyStri))) {
+        raise_error(MEMORY_ERROR);
+        return NULL;
+      } /* if */
+      result = (striType) emptyStri;
+    } else if (result_size != result_capacity) {
+      REALLOC_STRI_SIZE_SMALLER2(resized_result, result, result_capacity, result_size);
+      if (unlikely(resized_result == NULL)) {
+        FREE_STRI2(result, result_capacity);
+        raise_error(MEMORY_ERROR);
+        return NULL;
+      } /* if */
+      result = resized_result;
+    } /* if */
+    result->size = result_size;
+    return result;
+  } /* bufferedLineRead */
+
+
+
 #define BUFFER_START_SIZE 256
 #define BUFFER_DELTA_SIZE 256
 
@@ -1681,11 +2327,10 @@ striType socLineRead (socketType inSocket, charType *const terminationChar)
                       inSocket, *terminationChar););
       raise_error(FILE_ERROR);
       result = NULL;
+    } else if (inputBufferOf(inSocket) != NULL) {
+      result = bufferedLineRead(inSocket, inputBufferOf(inSocket), terminationChar);
     } else {
-      bytes_received = (memSizeType) recv((os_socketType) inSocket,
-                                          cast_send_recv_data(buffer),
-                                          cast_buffer_len(BUFFER_START_SIZE),
-                                          MSG_PEEK);
+      bytes_received = recvWaiting(inSocket, buffer, BUFFER_START_SIZE, MSG_PEEK);
       logMessage(printf("socLineRead: bytes_received=" FMT_U_MEM "\n",
                         bytes_received););
       if (unlikely(bytes_received == (memSizeType) -1)) {
@@ -1711,9 +2356,7 @@ striType socLineRead (socketType inSocket, charType *const terminationChar)
         if (nlPos != NULL) {
           bytes_requested = (memSizeType) (nlPos - buffer) + 1;
           /* This should overwrite the buffer with identical data up to '\n'. */
-          bytes_received = (memSizeType) recv((os_socketType) inSocket,
-                                              cast_send_recv_data(buffer),
-                                              cast_buffer_len(bytes_requested), 0);
+          bytes_received = recvWaiting(inSocket, buffer, bytes_requested, 0);
           /* bytes_received should always be identical to bytes_requested. */
           result_size = bytes_requested - 1;
           if (nlPos != buffer && nlPos[-1] == '\r') {
@@ -1735,9 +2378,7 @@ striType socLineRead (socketType inSocket, charType *const terminationChar)
           do {
             bytes_requested = bytes_received;
             /* This should overwrite the buffer with identical data. */
-            bytes_received = (memSizeType) recv((os_socketType) inSocket,
-                                                cast_send_recv_data(buffer),
-                                                cast_buffer_len(bytes_requested), 0);
+            bytes_received = recvWaiting(inSocket, buffer, bytes_requested, 0);
             /* bytes_received should always be identical to bytes_requested. */
             result_size += BUFFER_DELTA_SIZE;
             /* printf("A result=%08lx, old_result_size=%d, result_size=%d\n",
@@ -1757,10 +2398,8 @@ striType socLineRead (socketType inSocket, charType *const terminationChar)
               /* printf("a result[%d], size=%d\n", result_pos, bytes_requested); */
               memcpy_to_strelem(&result->mem[result_pos], buffer, bytes_requested);
               result_pos += bytes_requested;
-              bytes_received = (memSizeType) recv((os_socketType) inSocket,
-                                                  cast_send_recv_data(buffer),
-                                                  cast_buffer_len(BUFFER_DELTA_SIZE),
-                                                  MSG_PEEK);
+              bytes_received = recvWaiting(inSocket, buffer,
+                                           BUFFER_DELTA_SIZE, MSG_PEEK);
               if (unlikely(bytes_received == (memSizeType) -1)) {
                 logError(printf("socLineRead: "
                                 "recv(%d, *, " FMT_U_MEM ", MSG_PEEK) failed:\n"
@@ -1788,9 +2427,7 @@ striType socLineRead (socketType inSocket, charType *const terminationChar)
           if (result != NULL && nlPos != NULL) {
             bytes_requested = (memSizeType) (nlPos - buffer) + 1;
             /* This should overwrite the buffer with identical data up to '\n'. */
-            bytes_received = (memSizeType) recv((os_socketType) inSocket,
-                                                cast_send_recv_data(buffer),
-                                                cast_buffer_len(bytes_requested), 0);
+            bytes_received = recvWaiting(inSocket, buffer, bytes_requested, 0);
             /* bytes_received should always be identical to bytes_requested. */
             bytes_requested--;
             if (nlPos == buffer) {
@@ -1894,10 +2531,23 @@ intType socRecv (socketType sock, striType *stri, intType length, intType flags)
         *stri = resized_stri;
         old_stri_size = bytes_requested;
       } /* if */
-      new_stri_size = (memSizeType) recv((os_socketType) sock,
-                                         cast_send_recv_data((*stri)->mem),
-                                         cast_buffer_len(bytes_requested), (int) flags);
-      if (likely(new_stri_size != (memSizeType) -1)) {
+      if (inputBufferOf(sock) != NULL &&
+          inputBufferOf(sock)->start != inputBufferOf(sock)->end) {
+        new_stri_size = takeFromInputBuffer(inputBufferOf(sock),
+            (ucharType *) (*stri)->mem, bytes_requested, (flags & MSG_PEEK) != 0);
+      } else {
+        new_stri_size = (memSizeType) recv((os_socketType) sock,
+                                           cast_send_recv_data((*stri)->mem),
+                                           cast_buffer_len(bytes_requested), (int) flags);
+      } /* if */
+      if (unlikely(new_stri_size == (memSizeType) -1)) {
+        if (!SOCKET_WOULD_BLOCK()) {
+          logError(printf("socRecv: recv(%d, *, " FMT_U_MEM ", 0x" FMT_X ") failed:\n"
+                          "%s=%d\nerror: %s\n",
+                          sock, bytes_requested, flags, ERROR_INFORMATION););
+          raise_error(FILE_ERROR);
+        } /* if */
+      } else {
         memcpy_to_strelem((*stri)->mem, (ustriType) (*stri)->mem, new_stri_size);
         (*stri)->size = new_stri_size;
         if (new_stri_size < old_stri_size) {
@@ -1924,6 +2574,7 @@ intType socRecvfrom (socketType sock, striType *stri, intType length, intType fl
     bstriType resized_address;
     memSizeType bytes_requested;
     sockLenType addrlen;
+    boolType noDataAvailable;
     memSizeType stri_size;
 
   /* socRecvfrom */
@@ -1969,13 +2620,22 @@ intType socRecvfrom (socketType sock, striType *stri, intType length, intType fl
         *address = resized_address;
         COUNT3_BSTRI(old_address_size, MAX_ADDRESS_SIZE);
         addrlen = MAX_ADDRESS_SIZE;
-        stri_size = (memSizeType) recvfrom((os_socketType) sock,
-                                           cast_send_recv_data((*stri)->mem),
-                                           cast_buffer_len(bytes_requested), (int) flags,
-                                           (struct sockaddr *) (*address)->mem, &addrlen);
+        if (inputBufferOf(sock) != NULL &&
+            inputBufferOf(sock)->start != inputBufferOf(sock)->end) {
+          /* Like recvfrom() of a connected stream socket: No address. */
+          addrlen = 0;
+          stri_size = takeFromInputBuffer(inputBufferOf(sock),
+              (ucharType *) (*stri)->mem, bytes_requested, (flags & MSG_PEEK) != 0);
+        } else {
+          stri_size = (memSizeType) recvfrom((os_socketType) sock,
+                                             cast_send_recv_data((*stri)->mem),
+                                             cast_buffer_len(bytes_requested), (int) flags,
+                                             (struct sockaddr *) (*address)->mem, &addrlen);
+        } /* if */
         if (unlikely(stri_size == (memSizeType) -1 ||
                      ADDRLEN_NEGATIVE(addrlen) ||
                      addrlen > MAX_ADDRESS_SIZE)) {
+          noDataAvailable = stri_size == (memSizeType) -1 && SOCKET_WOULD_BLOCK();
           REALLOC_BSTRI_SIZE_OK(resized_address, *address, MAX_ADDRESS_SIZE, old_address_size);
           if (resized_address == NULL) {
             (*address)->size = MAX_ADDRESS_SIZE;
@@ -1983,10 +2643,14 @@ intType socRecvfrom (socketType sock, striType *stri, intType length, intType fl
             *address = resized_address;
             COUNT3_BSTRI(MAX_ADDRESS_SIZE, old_address_size);
           } /* if */
-          logError(printf("socRecvfrom: recvfrom(%d, ...) failed:\n"
-                          "%s=%d\nerror: %s\n",
-                          sock, ERROR_INFORMATION););
-          raise_error(FILE_ERROR);
+          if (noDataAvailable) {
+            stri_size = (memSizeType) -1;
+          } else {
+            logError(printf("socRecvfrom: recvfrom(%d, ...) failed:\n"
+                            "%s=%d\nerror: %s\n",
+                            sock, ERROR_INFORMATION););
+            raise_error(FILE_ERROR);
+          } /* if */
         } else {
           REALLOC_BSTRI_SIZE_OK(resized_address, *address, MAX_ADDRESS_SIZE,
                                 (memSizeType) addrlen);
@@ -2054,14 +2718,20 @@ intType socSend (socketType sock, const const_striType stri, intType flags)
         bytes_sent = (memSizeType) send((os_socketType) sock,
                                         cast_send_recv_data(buf->mem),
                                         cast_buffer_len(buf->size), (int) flags);
-        FREE_BSTRI(buf, buf->size);
         if (unlikely(bytes_sent == (memSizeType) -1)) {
+          if (!SOCKET_WOULD_BLOCK()) {
+            logError(printf("socSend: send(%d, data, " FMT_U_MEM ", 0x" FMT_X ") failed:\n"
+                            "%s=%d\nerror: %s\n",
+                            sock, buf->size, flags, ERROR_INFORMATION););
+            raise_error(FILE_ERROR);
+          } /* if */
           result = -1;
         } else if (unlikely(bytes_sent > MAX_MEM_INDEX)) {
           result = MAX_MEM_INDEX;
         } else {
           result = (intType) bytes_sent;
         } /* if */
+        FREE_BSTRI(buf, buf->size);
       } /* if */
     } /* if */
     return result;
@@ -2069,6 +2739,95 @@ intType socSend (socketType sock, const const_striType stri, intType flags)
 
 
 
+/**
+ *  Send 'length' bytes of 'inFile' starting at 'position' to 'outSocket'.
+ *  The first byte of a file has the position 1. If possible the data
+ *  is copied in the kernel with sendfile(). Memory mapped files are
+ *  sent directly from the mapped memory. The current file position
+ *  of 'inFile' is not changed.
+ *  @return the number of bytes sent. This is less than 'length' if
+ *          the end of 'inFile' is reached.
+ *  @exception RANGE_ERROR 'position' is negative or zero, or
+ *             'length' is negative.
+ *  @exception FILE_ERROR A system function returns an error.
+ */
+intType socSendFile (socketType outSocket, fileType inFile, intType position,
+    intType length)
+
+  {
+    memSizeType bytes_to_send;
+    memSizeType totally_sent = 0;
+    errInfoType err_info = OKAY_NO_ERROR;
+
+  /* socSendFile */
+    logFunction(printf("socSendFile(%d, %d, " FMT_D ", " FMT_D ")\n",
+                       outSocket, safe_fileno(inFile->cFile),
+                       position, length););
+    if (unlikely(outSocket == (socketType) -1)) {
+      logError(printf("socSendFile(%d, %d, " FMT_D ", " FMT_D "): "
+                      "Invalid socket.\n",
+                      outSocket, safe_fileno(inFile->cFile),
+                      position, length););
+      err_info = FILE_ERROR;
+    } else if (unlikely(inFile->cFile == NULL)) {
+      logError(printf("socSendFile(%d, %d, " FMT_D ", " FMT_D "): "
+                      "Attempt to send a closed file.\n",
+                      outSocket, safe_fileno(inFile->cFile),
+                      position, length););
+      err_info = FILE_ERROR;
+    } else if (unlikely(position <= 0 || length < 0)) {
+      logError(printf("socSendFile(%d, %d, " FMT_D ", " FMT_D "): "
+                      "Position or length not in allowed range.\n",
+                      outSocket, safe_fileno(inFile->cFile),
+                      position, length););
+      err_info = RANGE_ERROR;
+    } else {
+      if ((uintType) length > MAX_MEMSIZETYPE) {
+        bytes_to_send = MAX_MEMSIZETYPE;
+      } else {
+        bytes_to_send = (memSizeType) length;
+      } /* if */
+      if (inFile->mapStart != NULL) {
+        if ((uintType) (position - 1) < inFile->mapLength) {
+          if (bytes_to_send > inFile->mapLength - (memSizeType) (position - 1)) {
+            bytes_to_send = inFile->mapLength - (memSizeType) (position - 1);
+          } /* if */
+          sendBytes(outSocket, &inFile->mapStart[position - 1],
+                    bytes_to_send, &err_info);
+          totally_sent = bytes_to_send;
+        } /* if */
+      } else {
+        if (inFile->writingAllowed) {
+          fflush(inFile->cFile);
+        } /* if */
+#if HAS_SENDFILE
+        if (
+#if OS_OFF_T_SIZE < INTTYPE_SIZE
+            position > INT32TYPE_MAX ||
+#endif
+            !sendFileInKernel(outSocket, os_fileno(inFile->cFile),
+                              (os_off_t) (position - 1), bytes_to_send,
+                              &totally_sent, &err_info)) {
+          sendFileWithBuffer(outSocket, inFile, position, bytes_to_send,
+                             &totally_sent, &err_info);
+        } /* if */
+#else
+        sendFileWithBuffer(outSocket, inFile, position, bytes_to_send,
+                           &totally_sent, &err_info);
+#endif
+      } /* if */
+    } /* if */
+    if (unlikely(err_info != OKAY_NO_ERROR)) {
+      raise_error(err_info);
+    } /* if */
+    logFunction(printf("socSendFile(%d, %d, " FMT_D ", " FMT_D ") --> " FMT_U_MEM "\n",
+                       outSocket, safe_fileno(inFile->cFile),
+                       position, length, totally_sent););
+    return (intType) totally_sent;
+  } /* socSendFile */
+
+
+
 intType socSendto (socketType sock, const const_striType stri, intType flags,
     const_bstriType address)
 
@@ -2110,14 +2869,20 @@ intType socSendto (socketType sock, const const_striType stri, intType flags,
                                           cast_buffer_len(buf->size), (int) flags,
                                           (const struct sockaddr *) address->mem,
                                           (sockLenType) address->size);
-        FREE_BSTRI(buf, buf->size);
         if (unlikely(bytes_sent == (memSizeType) -1)) {
+          if (!SOCKET_WOULD_BLOCK()) {
+            logError(printf("socSendto: sendto(%d, data, " FMT_U_MEM ", 0x" FMT_X ") failed:\n"
+                            "%s=%d\nerror: %s\n",
+                            sock, buf->size, flags, ERROR_INFORMATION););
+            raise_error(FILE_ERROR);
+          } /* if */
           result = -1;
         } else if (unlikely(bytes_sent > MAX_MEM_INDEX)) {
           result = MAX_MEM_INDEX;
         } else {
           result = (intType) bytes_sent;
         } /* if */
+        FREE_BSTRI(buf, buf->size);
       } /* if */
     } /* if */
     return result;
@@ -2148,6 +2913,82 @@ void socSetOptBool (socketType sock, intType optname, boolType optval)
           } /* if */
         }
         break;
+#ifdef SO_REUSEPORT
+      case SOC_OPT_REUSEPORT: {
+          int so_reuseport = optval;
+          if (unlikely(setsockopt((os_socketType) sock,
+                                  SOL_SOCKET, SO_REUSEPORT,
+                                  (const char *) &so_reuseport,
+                                  sizeof(so_reuseport)) != 0)) {
+            logError(printf("socSetOptBool(%d, " FMT_D ", %s): "
+                            "setsockopt(%d, ...) failed:\n"
+                            "%s=%d\nerror: %s\n",
+                            sock, optname, optval ? "TRUE" : "FALSE",
+                            sock, ERROR_INFORMATION););
+            raise_error(FILE_ERROR);
+          } /* if */
+        }
+        break;
+#endif
+      case SOC_OPT_NODELAY: {
+          int tcp_nodelay = optval;
+          if (unlikely(setsockopt((os_socketType) sock,
+                                  IPPROTO_TCP, TCP_NODELAY,
+                                  (const char *) &tcp_nodelay,
+                                  sizeof(tcp_nodelay)) != 0)) {
+            logError(printf("socSetOptBool(%d, " FMT_D ", %s): "
+                            "setsockopt(%d, ...) failed:\n"
+                            "%s=%d\nerror: %s\n",
+                            sock, optname, optval ? "TRUE" : "FALSE",
+                            sock, ERROR_INFORMATION););
+            raise_error(FILE_ERROR);
+          } /* if */
+        }
+        break;
+      case SOC_OPT_NONBLOCKING: {
+#if SOCKET_LIB == UNIX_SOCKETS
+          int flags = fcntl((os_socketType) sock, F_GETFL);
+          boolType okay = flags != -1 &&
+              fcntl((os_socketType) sock, F_SETFL,
+                    optval ? flags | O_NONBLOCK : flags & ~O_NONBLOCK) != -1;
+#elif SOCKET_LIB == WINSOCK_SOCKETS
+          u_long nonBlocking = optval;
+          boolType okay = ioctlsocket((os_socketType) sock, FIONBIO,
+                                      &nonBlocking) == 0;
+#endif
+          if (unlikely(!okay)) {
+            logError(printf("socSetOptBool(%d, " FMT_D ", %s): "
+                            "Switching the blocking mode of %d failed:\n"
+                            "%s=%d\nerror: %s\n",
+                            sock, optname, optval ? "TRUE" : "FALSE",
+                            sock, ERROR_INFORMATION););
+            raise_error(FILE_ERROR);
+          } /* if */
+        }
+        break;
+      case SOC_OPT_BUFFERED_INPUT:
+#if SOCKET_LIB == UNIX_SOCKETS
+        if (unlikely(sock == (socketType) -1)) {
+          logError(printf("socSetOptBool(%d, " FMT_D ", %s): "
+                          "Invalid socket.\n",
+                          sock, optname, optval ? "TRUE" : "FALSE"););
+          raise_error(FILE_ERROR);
+        } else if (optval) {
+          if (unlikely(!createInputBuffer(sock))) {
+            raise_error(MEMORY_ERROR);
+          } /* if */
+        } else if (inputBufferOf(sock) != NULL) {
+          if (unlikely(inputBufferOf(sock)->start != inputBufferOf(sock)->end)) {
+            logError(printf("socSetOptBool(%d, " FMT_D ", %s): "
+                            "The input buffer is not empty.\n",
+                            sock, optname, optval ? "TRUE" : "FALSE"););
+            raise_error(FILE_ERROR);
+          } else {
+            freeInputBuffer(sock);
+          } /* if */
+        } /* if */
+#endif
+        break;
       default:
         logError(printf("socSetOptBool(%d, " FMT_D ", %s): "
                         "Unsupported option.\n",
@@ -2184,6 +3025,10 @@ socketType socSocket (intType domain, intType type, intType protocol)
         result = (os_socketType) -1;
       } /* if */
 #endif
+      if (result != (os_socketType) -1) {
+        /* A socket closed without socClose() leaves its buffer behind. */
+        freeInputBuffer((socketType) result);
+      } /* if */
     } /* if */
     logFunction(printf("socSocket(" FMT_D ", " FMT_D ", " FMT_D ") --> %d\n",
                        domain, type, protocol, result););
@@ -2209,6 +3054,7 @@ striType socWordRead (socketType inSocket, charType *const terminationChar)
     unsigned char ch;
     register memSizeType position;
     register memSizeType bytes_received;
+    inputBufferType inputBuffer;
     strElemType *memory;
     memSizeType memlength = READ_STRI_INIT_SIZE;
     memSizeType newmemlength;
@@ -2228,9 +3074,9 @@ striType socWordRead (socketType inSocket, charType *const terminationChar)
     } else {
       memory = result->mem;
       position = 0;
+      inputBuffer = inputBufferOf(inSocket);
       do {
-        bytes_received = (memSizeType) recv((os_socketType) inSocket,
-                                            cast_send_recv_data(&ch), 1, 0);
+        bytes_received = receiveByte(inSocket, inputBuffer, &ch);
       } while (bytes_received == 1 && (ch == ' ' || ch == '\t'));
       while (bytes_received == 1 &&
           ch != ' ' && ch != '\t' && ch != '\n') {
@@ -2247,8 +3093,7 @@ striType socWordRead (socketType inSocket, charType *const terminationChar)
           memlength = newmemlength;
         } /* if */
         memory[position++] = (strElemType) ch;
-        bytes_received = (memSizeType) recv((os_socketType) inSocket,
-                                            cast_send_recv_data(&ch), 1, 0);
+        bytes_received = receiveByte(inSocket, inputBuffer, &ch);
       } /* while */
       if (bytes_received == 1 && ch == '\n' &&
           position != 0 && memory[position - 1] == '\r') {
@@ -2289,8 +3134,6 @@ void socWrite (socketType outSocket, const const_striType stri)
     ucharType buffer[BUFFER_SIZE];
     ustriType buf;
     memSizeType bytes_to_send;
-    memSizeType bytes_sent;
-    memSizeType totally_sent = 0;
     errInfoType err_info = OKAY_NO_ERROR;
     bstriType bstri = NULL;
 
@@ -2329,24 +3172,9 @@ void socWrite (socketType outSocket, const const_striType stri)
         bytes_to_send = bstri->size;
       } /* if */
     } /* if */
-    while (bytes_to_send != 0 && err_info == OKAY_NO_ERROR) {
-      bytes_sent = (memSizeType) send((os_socketType) outSocket,
-                                      cast_send_recv_data(&buf[totally_sent]),
-                                      cast_buffer_len(bytes_to_send), 0);
-      if (bytes_sent == (memSizeType) -1) {
-        logError(printf("socWrite(%d, \"%s\" (size=" FMT_U_MEM ")): "
-                        "send(%d, data, " FMT_U_MEM ") failed:\n"
-                        "%s=%d\nerror: %s\n"
-                        "bytes sent successfully: " FMT_U_MEM "\n",
-                        outSocket, striAsUnquotedCStri(stri),
-                        stri->size, outSocket, bytes_to_send,
-                        ERROR_INFORMATION, totally_sent););
-        err_info = FILE_ERROR;
-      } else {
-        totally_sent += bytes_sent;
-        bytes_to_send -= bytes_sent;
-      } /* if */
-    } /* while */
+    if (bytes_to_send != 0 && err_info == OKAY_NO_ERROR) {
+      sendBytes(outSocket, buf, bytes_to_send, &err_info);
+    } /* if */
     if (bstri != NULL) {
       FREE_BSTRI(bstri, bstri->size);
     } /* if */
@@ -2355,4 +3183,82 @@ void socWrite (socketType outSocket, const const_striType stri)
     } /* if */
   } /* socWrite */
 
+
+
+/**
+ *  Write all strings of 'striArray' to 'outSocket'.
+ *  The strings are converted to bytes in one buffer, which is sent
+ *  with as few send() calls as possible. This avoids concatenating
+ *  the strings beforehand or writing them one by one.
+ *  @exception FILE_ERROR The system function is not able to write
+ *             all characters of the strings.
+ *  @exception RANGE_ERROR A string contains a character that does
+ *             not fit into a byte.
+ *  @exception MEMORY_ERROR Not enough memory to create the buffer.
+ */
+void socWritev (socketType outSocket, const const_rtlArrayType striArray)
+
+  {
+    ucharType buffer[BUFFER_SIZE];
+    memSizeType numElements;
+    memSizeType pos;
+    const_striType stri;
+    memSizeType totalSize = 0;
+    ustriType buf;
+    memSizeType bytes_converted = 0;
+    errInfoType err_info = OKAY_NO_ERROR;
+    bstriType bstri = NULL;
+
+  /* socWritev */
+    logFunction(printf("socWritev(%d, " FMT_U_MEM " strings)\n",
+                       outSocket, arraySize(striArray)););
+    numElements = arraySize(striArray);
+    for (pos = 0; pos < numElements && err_info == OKAY_NO_ERROR; pos++) {
+      if (unlikely(striArray->arr[pos].value.striValue->size >
+                   MAX_BSTRI_LEN - totalSize)) {
+        err_info = MEMORY_ERROR;
+      } else {
+        totalSize += striArray->arr[pos].value.striValue->size;
+      } /* if */
+    } /* for */
+    if (unlikely(outSocket == (socketType) -1)) {
+      logError(printf("socWritev(%d, " FMT_U_MEM " strings): Invalid socket.\n",
+                      outSocket, numElements););
+      err_info = FILE_ERROR;
+      buf = NULL;
+    } else if (unlikely(err_info != OKAY_NO_ERROR)) {
+      buf = NULL;
+    } else if (totalSize <= BUFFER_SIZE) {
+      buf = buffer;
+    } else if (unlikely(!ALLOC_BSTRI_CHECK_SIZE(bstri, totalSize))) {
+      err_info = MEMORY_ERROR;
+      buf = NULL;
+    } else {
+      buf = bstri->mem;
+    } /* if */
+    for (pos = 0; pos < numElements && err_info == OKAY_NO_ERROR; pos++) {
+      stri = striArray->arr[pos].value.striValue;
+      if (unlikely(memcpy_from_strelem(&buf[bytes_converted],
+                                       stri->mem, stri->size))) {
+        logError(printf("socWritev(%d, " FMT_U_MEM " strings): "
+                        "At least one character of \"%s\" "
+                        "does not fit into a byte.\n",
+                        outSocket, numElements,
+                        striAsUnquotedCStri(stri)););
+        err_info = RANGE_ERROR;
+      } else {
+        bytes_converted += stri->size;
+      } /* if */
+    } /* for */
+    if (totalSize != 0 && err_info == OKAY_NO_ERROR) {
+      sendBytes(outSocket, buf, totalSize, &err_info);
+    } /* if */
+    if (bstri != NULL) {
+      FREE_BSTRI(bstri, totalSize);
+    } /* if */
+    if (unlikely(err_info != OKAY_NO_ERROR)) {
+      raise_error(err_info);
+    } /* if */
+  } /* socWritev */
+
 #endif
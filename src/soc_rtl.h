@@ -29,8 +29,12 @@
 /*                                                                  */
 /********************************************************************/
 
-#define SOC_OPT_NONE      0
-#define SOC_OPT_REUSEADDR 1
+#define SOC_OPT_NONE           0
+#define SOC_OPT_REUSEADDR      1
+#define SOC_OPT_BUFFERED_INPUT 2
+#define SOC_OPT_REUSEPORT      3
+#define SOC_OPT_NODELAY        4
+#define SOC_OPT_NONBLOCKING    5
 
 #if SOCKET_LIB == UNIX_SOCKETS
 #define ERROR_INFORMATION "errno", errno, strerror(errno)
@@ -65,9 +69,12 @@ intType socRecv (socketType sock, striType *stri, intType length, intType flags)
 intType socRecvfrom (socketType sock, striType *stri, intType length, intType flags,
     bstriType *address);
 intType socSend (socketType sock, const const_striType stri, intType flags);
+intType socSendFile (socketType outSocket, fileType inFile, intType position,
+    intType length);
 intType socSendto (socketType sock, const const_striType stri, intType flags,
     const_bstriType address);
 void socSetOptBool (socketType sock, intType optname, boolType optval);
 socketType socSocket (intType domain, intType type, intType protocol);
 striType socWordRead (socketType inSocket, charType *const terminationChar);
 void socWrite (socketType outSocket, const const_striType stri);
+void socWritev (socketType outSocket, const const_rtlArrayType striArray);
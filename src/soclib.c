@@ -32,9 +32,11 @@
 
 #include "common.h"
 #include "data.h"
+#include "data_rtl.h"
 #include "heaputl.h"
 #include "syvarutl.h"
 #include "objutl.h"
+#include "arrutl.h"
 #include "runerr.h"
 #include "soc_rtl.h"
 
@@ -494,6 +496,30 @@ objectType soc_send (listType arguments)
 
 
 
+/**
+ *  Send a part of a file to a socket.
+ *  The data is copied in the kernel, if possible.
+ *  @return the number of bytes sent.
+ *  @exception RANGE_ERROR The position is negative or zero, or
+ *             the length is negative.
+ *  @exception FILE_ERROR A system function returns an error.
+ */
+objectType soc_send_file (listType arguments)
+
+  { /* soc_send_file */
+    isit_socket(arg_1(arguments));
+    isit_file(arg_2(arguments));
+    isit_int(arg_3(arguments));
+    isit_int(arg_4(arguments));
+    return bld_int_temp(
+        socSendFile(take_socket(arg_1(arguments)),
+                    take_file(arg_2(arguments)),
+                    take_int(arg_3(arguments)),
+                    take_int(arg_4(arguments))));
+  } /* soc_send_file */
+
+
+
 objectType soc_sendto (listType arguments)
 
   { /* soc_sendto */
@@ -581,3 +607,31 @@ objectType soc_write (listType arguments)
     socWrite(take_socket(arg_1(arguments)), take_stri(arg_2(arguments)));
     return SYS_EMPTY_OBJECT;
   } /* soc_write */
+
+
+
+/**
+ *  Write all strings of an array to a socket.
+ *  @exception FILE_ERROR The system function is not able to write
+ *             all characters of the strings.
+ *  @exception RANGE_ERROR A string contains a character that does
+ *             not fit into a byte.
+ *  @exception MEMORY_ERROR Not enough memory to convert the array.
+ */
+objectType soc_writev (listType arguments)
+
+  {
+    rtlArrayType striArray;
+
+  /* soc_writev */
+    isit_socket(arg_1(arguments));
+    isit_array(arg_2(arguments));
+    striArray = gen_rtl_array(take_array(arg_2(arguments)));
+    if (unlikely(striArray == NULL)) {
+      return raise_exception(SYS_MEM_EXCEPTION);
+    } else {
+      socWritev(take_socket(arg_1(arguments)), striArray);
+      FREE_RTL_ARRAY(striArray, ARRAY_LENGTH(striArray));
+      return SYS_EMPTY_OBJECT;
+    } /* if */
+  } /* soc_writev */
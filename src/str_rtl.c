@@ -2090,6 +2090,7 @@ striType strChRepl (const const_striType mainStri,
 
   {
     memSizeType main_size;
+    memSizeType count;
     memSizeType guessed_result_size;
     memSizeType result_size;
     const strElemType *main_mem;
@@ -2105,11 +2106,14 @@ striType strChRepl (const const_striType mainStri,
     /* printf("main_size=" FMT_U_MEM ", replacement->size=" FMT_U_MEM "\n",
         main_size, replacement->size); */
     if (replacement->size > 1) {
-      if (unlikely(main_size > MAX_STRI_LEN / replacement->size)) {
+      /* Count the occurrences to allocate the exact result size. */
+      count = memcnt_strelem(mainStri->mem, searched, main_size);
+      if (unlikely(count != 0 &&
+                   replacement->size - 1 > (MAX_STRI_LEN - main_size) / count)) {
         raise_error(MEMORY_ERROR);
         return NULL;
       } else {
-        guessed_result_size = main_size * replacement->size;
+        guessed_result_size = main_size + count * (replacement->size - 1);
       } /* if */
     } else {
       guessed_result_size = main_size;
@@ -2178,40 +2182,50 @@ striType strChRepl (const const_striType mainStri,
 rtlArrayType strChSplit (const const_striType mainStri, const charType delimiter)
 
   {
+    memSizeType num_delimiters;
     intType used_max_position;
     const strElemType *search_start;
     const strElemType *search_end;
     const strElemType *found_pos;
+    striType new_stri;
     rtlArrayType result_array;
 
   /* strChSplit */
     logFunction(printf("strChSplit(\"%s\", '\\" FMT_U32 ";')\n",
                        striAsUnquotedCStri(mainStri), delimiter););
-    if (likely(ALLOC_RTL_ARRAY(result_array, INITIAL_ARRAY_SIZE))) {
+    /* Count the delimiters first to allocate the exact array size. */
+    num_delimiters = memcnt_strelem(mainStri->mem, delimiter, mainStri->size);
+    if (unlikely(num_delimiters >= MAX_RTL_ARR_LEN ||
+                 !ALLOC_RTL_ARRAY(result_array, num_delimiters + 1))) {
+      raise_error(MEMORY_ERROR);
+      result_array = NULL;
+    } else {
       result_array->min_position = 1;
-      result_array->max_position = INITIAL_ARRAY_SIZE;
+      result_array->max_position = (intType) num_delimiters + 1;
       used_max_position = 0;
       search_start = mainStri->mem;
       search_end = &mainStri->mem[mainStri->size];
-      while ((found_pos = memchr_strelem(search_start, delimiter,
-          (memSizeType) (search_end - search_start))) != NULL &&
-          result_array != NULL) {
-        result_array = addCopiedStriToRtlArray(search_start,
-            (memSizeType) (found_pos - search_start), result_array,
-            used_max_position);
-        used_max_position++;
-        search_start = found_pos + 1;
-      } /* while */
-      if (likely(result_array != NULL)) {
-        result_array = addCopiedStriToRtlArray(search_start,
-            (memSizeType) (search_end - search_start), result_array,
-            used_max_position);
-        used_max_position++;
-        result_array = completeRtlStriArray(result_array, used_max_position);
-      } /* if */
-    } /* if */
-    if (unlikely(result_array == NULL)) {
-      raise_error(MEMORY_ERROR);
+      do {
+        if ((memSizeType) used_max_position == num_delimiters) {
+          found_pos = search_end;
+        } else {
+          found_pos = memchr_strelem(search_start, delimiter,
+              (memSizeType) (search_end - search_start));
+        } /* if */
+        if (unlikely(!ALLOC_STRI_SIZE_OK(new_stri,
+            (memSizeType) (found_pos - search_start)))) {
+          freeRtlStriArray(result_array, used_max_position);
+          raise_error(MEMORY_ERROR);
+          return NULL;
+        } else {
+          new_stri->size = (memSizeType) (found_pos - search_start);
+          memcpy(new_stri->mem, search_start,
+                 new_stri->size * sizeof(strElemType));
+          result_array->arr[used_max_position].value.striValue = new_stri;
+          used_max_position++;
+          search_start = found_pos + 1;
+        } /* if */
+      } while ((memSizeType) used_max_position <= num_delimiters);
     } /* if */
     logFunction(printf("strChSplit -->\n"););
     return result_array;
@@ -3164,6 +3178,7 @@ striType strHeadTemp (const striType stri, const intType stop)
 
 
 
+#if !HAS_SSE2_INTRINSICS
 /**
  *  Search string 'searched' in 'mainStri' at or after 'fromIndex'.
  *  The search starts at 'fromIndex' and proceeds to the right.
@@ -3228,6 +3243,7 @@ static intType strIPos2 (const const_striType mainStri, const const_striType sea
     } /* while */
     return 0;
   } /* strIPos2 */
+#endif
 
 
 
@@ -3235,7 +3251,8 @@ static intType strIPos2 (const const_striType mainStri, const const_striType sea
  *  Search string 'searched' in 'mainStri' at or after 'fromIndex'.
  *  The search starts at 'fromIndex' and proceeds to the right.
  *  The first character in a string has the position 1.
- *  This function calls strIPos2 if 'mainStri' is long.
+ *  This function uses memmem_strelem. Without vector instructions
+ *  it calls strIPos2 if 'mainStri' is long.
  *  @return the position of 'searched' or 0 if 'mainStri'
  *          does not contain 'searched' at or after 'fromIndex'.
  *  @exception RANGE_ERROR 'fromIndex' <= 0 holds.
@@ -3246,13 +3263,8 @@ intType strIPos (const const_striType mainStri, const const_striType searched,
   {
     memSizeType main_size;
     memSizeType searched_size;
-    strElemType ch_n;
-    const strElemType *ch_n_pos;
-    memSizeType delta;
     const strElemType *main_mem;
-    const strElemType *searched_mem;
-    const strElemType *search_start;
-    const strElemType *search_end;
+    const strElemType *found_pos;
 
   /* strIPos */
     logFunction(printf("strIPos(\"%s\", ",
@@ -3271,37 +3283,17 @@ intType strIPos (const const_striType mainStri, const const_striType searched,
       if (searched_size != 0 && main_size >= searched_size &&
           (uintType) fromIndex - 1 <= main_size - searched_size) {
         main_size -= (memSizeType) fromIndex - 1;
+#if !HAS_SSE2_INTRINSICS
         if (searched_size >= BOYER_MOORE_SEARCHED_STRI_THRESHOLD &&
             main_size >= BOYER_MOORE_MAIN_STRI_THRESHOLD) {
           return strIPos2(mainStri, searched, fromIndex);
-        } else if (searched_size == 1) {
-          return strChIPos(mainStri, searched->mem[0], fromIndex);
-        } else {
-          searched_mem = searched->mem;
-          ch_n = searched_mem[searched_size - 1];
-          ch_n_pos = rsearch_strelem(&searched_mem[searched_size - 2], ch_n, searched_size - 1);
-          if (ch_n_pos == NULL) {
-            delta = searched_size;
-          } else {
-            delta = (memSizeType) (&searched_mem[searched_size - 1] - ch_n_pos);
-          } /* if */
-          main_mem = &mainStri->mem[fromIndex - 1];
-          search_start = &main_mem[searched_size - 1];
-          search_end = &main_mem[main_size];
-          while (search_start < search_end) {
-            search_start = memchr_strelem(search_start, ch_n,
-                (memSizeType) (search_end - search_start));
-            if (search_start == NULL) {
-              return 0;
-            } else {
-              if (memcmp(search_start - searched_size + 1, searched_mem,
-                  (searched_size - 1) * sizeof(strElemType)) == 0) {
-                return ((intType) (search_start - searched_size + 1 - main_mem)) + fromIndex;
-              } else {
-                search_start += delta;
-              } /* if */
-            } /* if */
-          } /* while */
+        } /* if */
+#endif
+        main_mem = &mainStri->mem[fromIndex - 1];
+        found_pos = memmem_strelem(main_mem, main_size,
+                                   searched->mem, searched_size);
+        if (found_pos != NULL) {
+          return ((intType) (found_pos - main_mem)) + fromIndex;
         } /* if */
       } /* if */
     } /* if */
@@ -3828,6 +3820,7 @@ striType strMult (const const_striType stri, const intType factor)
 
 
 
+#if !HAS_SSE2_INTRINSICS
 /**
  *  Determine leftmost position of string 'searched' in 'mainStri'.
  *  If the string is found the position of its first character
@@ -3891,6 +3884,7 @@ static intType strPos2 (const const_striType mainStri, const const_striType sear
     } /* while */
     return 0;
   } /* strPos2 */
+#endif
 
 
 
@@ -3898,7 +3892,8 @@ static intType strPos2 (const const_striType mainStri, const const_striType sear
  *  Determine leftmost position of string 'searched' in 'mainStri'.
  *  If the string is found the position of its first character
  *  is the result. The first character in a string has the position 1.
- *  This function calls strPos2 if 'mainStri' is long.
+ *  This function uses memmem_strelem. Without vector instructions
+ *  it calls strPos2 if 'mainStri' is long.
  *  @return the position of 'searched' or 0 if 'mainStri'
  *          does not contain 'searched'.
  */
@@ -3907,13 +3902,7 @@ intType strPos (const const_striType mainStri, const const_striType searched)
   {
     memSizeType main_size;
     memSizeType searched_size;
-    strElemType ch_n;
-    const strElemType *ch_n_pos;
-    memSizeType delta;
-    const strElemType *main_mem;
-    const strElemType *searched_mem;
-    const strElemType *search_start;
-    const strElemType *search_end;
+    const strElemType *found_pos;
 
   /* strPos */
     logFunction(printf("strPos(\"%s\", ",
@@ -3923,37 +3912,16 @@ intType strPos (const const_striType mainStri, const const_striType searched)
     main_size = mainStri->size;
     searched_size = searched->size;
     if (searched_size != 0 && main_size >= searched_size) {
+#if !HAS_SSE2_INTRINSICS
       if (searched_size >= BOYER_MOORE_SEARCHED_STRI_THRESHOLD &&
           main_size >= BOYER_MOORE_MAIN_STRI_THRESHOLD) {
         return strPos2(mainStri, searched);
-      } else if (searched_size == 1) {
-        return strChPos(mainStri, searched->mem[0]);
-      } else {
-        searched_mem = searched->mem;
-        ch_n = searched_mem[searched_size - 1];
-        ch_n_pos = rsearch_strelem(&searched_mem[searched_size - 2], ch_n, searched_size - 1);
-        if (ch_n_pos == NULL) {
-          delta = searched_size;
-        } else {
-          delta = (memSizeType) (&searched_mem[searched_size - 1] - ch_n_pos);
-        } /* if */
-        main_mem = mainStri->mem;
-        search_start = &main_mem[searched_size - 1];
-        search_end = &main_mem[main_size];
-        while (search_start < search_end) {
-          search_start = memchr_strelem(search_start, ch_n,
-              (memSizeType) (search_end - search_start));
-          if (search_start == NULL) {
-            return 0;
-          } else {
-            if (memcmp(search_start - searched_size + 1, searched_mem,
-                (searched_size - 1) * sizeof(strElemType)) == 0) {
-              return ((intType) (search_start - searched_size + 1 - main_mem)) + 1;
-            } else {
-              search_start += delta;
-            } /* if */
-          } /* if */
-        } /* while */
+      } /* if */
+#endif
+      found_pos = memmem_strelem(mainStri->mem, main_size,
+                                 searched->mem, searched_size);
+      if (found_pos != NULL) {
+        return ((intType) (found_pos - mainStri->mem)) + 1;
       } /* if */
     } /* if */
     return 0;
@@ -4248,6 +4216,7 @@ intType strRChPos (const const_striType mainStri, const charType searched)
 
 
 
+#if !HAS_SSE2_INTRINSICS
 /**
  *  Replace all occurrences of 'searched' in 'mainStri' by 'replacement'.
  *  This function uses a modified Boyer-Moore string search algorithm.
@@ -4324,12 +4293,14 @@ static memSizeType strRepl2 (const const_striType mainStri, const const_striType
     result_size = (memSizeType) (result_end - result->mem);
     return result_size;
   } /* strRepl2 */
+#endif
 
 
 
 /**
  *  Replace all occurrences of 'searched' in 'mainStri' by 'replacement'.
- *  This function calls strRepl2 if 'mainStri' is long.
+ *  This function uses memmem_strelem. Without vector instructions
+ *  it calls strRepl2 if 'mainStri' is long.
  *  @return the result of the replacement.
  */
 striType strRepl (const const_striType mainStri,
@@ -4340,11 +4311,9 @@ striType strRepl (const const_striType mainStri,
     memSizeType searched_size;
     memSizeType guessed_result_size;
     memSizeType result_size;
-    strElemType ch_1;
-    const strElemType *main_mem;
-    const strElemType *searched_mem;
     const strElemType *search_start;
     const strElemType *search_end;
+    const strElemType *found_pos;
     const strElemType *copy_start;
     strElemType *result_end;
     striType resized_result;
@@ -4369,34 +4338,29 @@ striType strRepl (const const_striType mainStri,
     if (unlikely(!ALLOC_STRI_SIZE_OK(result, guessed_result_size))) {
       raise_error(MEMORY_ERROR);
     } else {
+#if !HAS_SSE2_INTRINSICS
       if (searched_size >= BOYER_MOORE_SEARCHED_STRI_THRESHOLD &&
           main_size >= BOYER_MOORE_MAIN_STRI_THRESHOLD) {
         result_size = strRepl2(mainStri, searched, replacement, result);
-      } else {
+      } else
+#endif
+      {
         copy_start = mainStri->mem;
         result_end = result->mem;
-        if (searched_size != 0 && searched_size <= main_size) {
-          searched_mem = searched->mem;
-          ch_1 = searched_mem[0];
-          main_mem = mainStri->mem;
-          search_start = main_mem;
-          search_end = &main_mem[main_size - searched_size + 1];
-          while (search_start < search_end &&
-              (search_start = memchr_strelem(search_start, ch_1,
-                  (memSizeType) (search_end - search_start))) != NULL) {
-            if (memcmp(search_start, searched_mem,
-                searched_size * sizeof(strElemType)) == 0) {
-              memcpy(result_end, copy_start,
-                     (memSizeType) (search_start - copy_start) * sizeof(strElemType));
-              result_end += search_start - copy_start;
-              memcpy(result_end, replacement->mem,
-                     replacement->size * sizeof(strElemType));
-              result_end += replacement->size;
-              search_start += searched_size;
-              copy_start = search_start;
-            } else {
-              search_start++;
-            } /* if */
+        if (searched_size != 0) {
+          search_start = mainStri->mem;
+          search_end = &mainStri->mem[main_size];
+          while ((found_pos = memmem_strelem(search_start,
+              (memSizeType) (search_end - search_start),
+              searched->mem, searched_size)) != NULL) {
+            memcpy(result_end, copy_start,
+                   (memSizeType) (found_pos - copy_start) * sizeof(strElemType));
+            result_end += found_pos - copy_start;
+            memcpy(result_end, replacement->mem,
+                   replacement->size * sizeof(strElemType));
+            result_end += replacement->size;
+            search_start = found_pos + searched_size;
+            copy_start = search_start;
           } /* while */
         } /* if */
         memcpy(result_end, copy_start,
@@ -4771,11 +4735,8 @@ rtlArrayType strSplit (const const_striType mainStri,
 
   {
     memSizeType delimiter_size;
-    const strElemType *delimiter_mem;
-    strElemType ch_1;
     intType used_max_position;
     const strElemType *search_start;
-    const strElemType *segment_start;
     const strElemType *search_end;
     const strElemType *found_pos;
     rtlArrayType result_array;
@@ -4789,34 +4750,23 @@ rtlArrayType strSplit (const const_striType mainStri,
       result_array->max_position = INITIAL_ARRAY_SIZE;
       used_max_position = 0;
       delimiter_size = delimiter->size;
-      delimiter_mem = delimiter->mem;
       search_start = mainStri->mem;
-      segment_start = search_start;
-      if (delimiter_size != 0 && mainStri->size >= delimiter_size) {
-        ch_1 = delimiter_mem[0];
-        search_end = &mainStri->mem[mainStri->size - delimiter_size + 1];
-        while ((found_pos = memchr_strelem(search_start, ch_1,
-            (memSizeType) (search_end - search_start))) != NULL &&
+      search_end = &mainStri->mem[mainStri->size];
+      if (delimiter_size != 0) {
+        while ((found_pos = memmem_strelem(search_start,
+            (memSizeType) (search_end - search_start),
+            delimiter->mem, delimiter_size)) != NULL &&
             result_array != NULL) {
-          if (memcmp(found_pos, delimiter_mem,
-              delimiter_size * sizeof(strElemType)) == 0) {
-            result_array = addCopiedStriToRtlArray(segment_start,
-                (memSizeType) (found_pos - segment_start), result_array,
-                used_max_position);
-            used_max_position++;
-            search_start = found_pos + delimiter_size;
-            segment_start = search_start;
-            if (search_start > search_end) {
-              search_start = search_end;
-            } /* if */
-          } else {
-            search_start = found_pos + 1;
-          } /* if */
+          result_array = addCopiedStriToRtlArray(search_start,
+              (memSizeType) (found_pos - search_start), result_array,
+              used_max_position);
+          used_max_position++;
+          search_start = found_pos + delimiter_size;
         } /* while */
       } /* if */
       if (likely(result_array != NULL)) {
-        result_array = addCopiedStriToRtlArray(segment_start,
-            (memSizeType) (&mainStri->mem[mainStri->size] - segment_start), result_array,
+        result_array = addCopiedStriToRtlArray(search_start,
+            (memSizeType) (search_end - search_start), result_array,
             used_max_position);
         used_max_position++;
         result_array = completeRtlStriArray(result_array, used_max_position);
@@ -5170,6 +5120,7 @@ striType strToUtf8 (const const_striType stri)
     register strElemType *dest;
     register strElemType ch;
     register memSizeType pos;
+    memSizeType asciiLength;
     memSizeType result_size;
     striType resized_result;
     striType result;
@@ -5184,7 +5135,10 @@ striType strToUtf8 (const const_striType stri)
       for (pos = 0; pos < stri->size; pos++) {
         ch = stri->mem[pos];
         if (ch <= 0x7F) {
-          *dest++ = ch;
+          asciiLength = memcpy_ascii_strelem(dest, &stri->mem[pos],
+                                             stri->size - pos);
+          dest += asciiLength;
+          pos += asciiLength - 1;
         } else if (ch <= 0x7FF) {
           dest[0] = 0xC0 | ( ch >>  6);
           dest[1] = 0x80 | ( ch        & 0x3F);
@@ -38,8 +38,12 @@
 #include "stdio.h"
 #include "string.h"
 #include "ctype.h"
-#ifdef OS_STRI_WCHAR
 #include "wchar.h"
+#if HAS_SSE2_INTRINSICS
+#include "emmintrin.h"
+#endif
+#if HAS_AVX2_INTRINSICS
+#include "immintrin.h"
 #endif
 
 #include "common.h"
@@ -346,6 +350,594 @@ cstriType stringify (intType number)
 
 
 
+#if HAS_SSE2_INTRINSICS
+/**
+ *  Number of bytes or UTF-32 characters processed by one step of
+ *  the SSE2 kernels below. Blocks are only processed completely.
+ */
+#define SSE2_BLOCK_SIZE 16
+#define AVX2_BLOCK_SIZE 32
+
+
+
+#if HAS_AVX2_INTRINSICS
+/**
+ *  AVX2 variant of asciiBlocksToStrelem().
+ *  This function must only be called if the CPU supports AVX2.
+ */
+__attribute__((target("avx2")))
+static memSizeType asciiBlocksToStrelemAvx2 (strElemType *const dest,
+    const const_ustriType src, const memSizeType len)
+
+  {
+    memSizeType pos = 0;
+    __m256i bytes;
+    __m128i lowHalf;
+    __m128i highHalf;
+
+  /* asciiBlocksToStrelemAvx2 */
+    while (len - pos >= AVX2_BLOCK_SIZE &&
+           _mm256_movemask_epi8(bytes =
+               _mm256_loadu_si256((const __m256i *) &src[pos])) == 0) {
+      lowHalf = _mm256_castsi256_si128(bytes);
+      highHalf = _mm256_extracti128_si256(bytes, 1);
+      _mm256_storeu_si256((__m256i *) &dest[pos],
+                          _mm256_cvtepu8_epi32(lowHalf));
+      _mm256_storeu_si256((__m256i *) &dest[pos + 8],
+                          _mm256_cvtepu8_epi32(_mm_srli_si128(lowHalf, 8)));
+      _mm256_storeu_si256((__m256i *) &dest[pos + 16],
+                          _mm256_cvtepu8_epi32(highHalf));
+      _mm256_storeu_si256((__m256i *) &dest[pos + 24],
+                          _mm256_cvtepu8_epi32(_mm_srli_si128(highHalf, 8)));
+      pos += AVX2_BLOCK_SIZE;
+    } /* while */
+    return pos;
+  } /* asciiBlocksToStrelemAvx2 */
+
+
+
+/**
+ *  AVX2 variant of latin1BlocksToStrelem().
+ *  This function must only be called if the CPU supports AVX2.
+ */
+__attribute__((target("avx2")))
+static memSizeType latin1BlocksToStrelemAvx2 (strElemType *const dest,
+    const const_ustriType src, memSizeType len)
+
+  {
+    __m128i lowHalf;
+    __m128i highHalf;
+
+  /* latin1BlocksToStrelemAvx2 */
+    while (len >= AVX2_BLOCK_SIZE) {
+      len -= AVX2_BLOCK_SIZE;
+      lowHalf = _mm_loadu_si128((const __m128i *) &src[len]);
+      highHalf = _mm_loadu_si128((const __m128i *) &src[len + 16]);
+      _mm256_storeu_si256((__m256i *) &dest[len + 24],
+                          _mm256_cvtepu8_epi32(_mm_srli_si128(highHalf, 8)));
+      _mm256_storeu_si256((__m256i *) &dest[len + 16],
+                          _mm256_cvtepu8_epi32(highHalf));
+      _mm256_storeu_si256((__m256i *) &dest[len + 8],
+                          _mm256_cvtepu8_epi32(_mm_srli_si128(lowHalf, 8)));
+      _mm256_storeu_si256((__m256i *) &dest[len],
+                          _mm256_cvtepu8_epi32(lowHalf));
+    } /* while */
+    return len;
+  } /* latin1BlocksToStrelemAvx2 */
+#endif
+
+
+
+/**
+ *  Convert leading blocks of ASCII bytes to UTF-32 characters.
+ *  Complete blocks are converted until a block contains a byte
+ *  above 0x7F or until less than a block is left. This is the
+ *  ASCII fast path of the UTF-8 decoder. The remaining bytes
+ *  must be processed by the caller.
+ *  @param dest Destination array with UTF-32 encoded characters.
+ *  @param src Source array with UTF-8 encoded bytes.
+ *  @param len Number of bytes in 'src'.
+ *  @return the number of bytes converted.
+ */
+static memSizeType asciiBlocksToStrelem (strElemType *const dest,
+    const const_ustriType src, const memSizeType len)
+
+  {
+    memSizeType pos = 0;
+    __m128i bytes;
+    __m128i words;
+    const __m128i zero = _mm_setzero_si128();
+
+  /* asciiBlocksToStrelem */
+#if HAS_AVX2_INTRINSICS
+    if (len >= AVX2_BLOCK_SIZE && __builtin_cpu_supports("avx2")) {
+      pos = asciiBlocksToStrelemAvx2(dest, src, len);
+    } /* if */
+#endif
+    while (len - pos >= SSE2_BLOCK_SIZE &&
+           _mm_movemask_epi8(bytes =
+               _mm_loadu_si128((const __m128i *) &src[pos])) == 0) {
+      words = _mm_unpacklo_epi8(bytes, zero);
+      _mm_storeu_si128((__m128i *) &dest[pos],      _mm_unpacklo_epi16(words, zero));
+      _mm_storeu_si128((__m128i *) &dest[pos + 4],  _mm_unpackhi_epi16(words, zero));
+      words = _mm_unpackhi_epi8(bytes, zero);
+      _mm_storeu_si128((__m128i *) &dest[pos + 8],  _mm_unpacklo_epi16(words, zero));
+      _mm_storeu_si128((__m128i *) &dest[pos + 12], _mm_unpackhi_epi16(words, zero));
+      pos += SSE2_BLOCK_SIZE;
+    } /* while */
+    return pos;
+  } /* asciiBlocksToStrelem */
+
+
+
+/**
+ *  Convert trailing blocks of ISO-8859-1 bytes to UTF-32 characters.
+ *  The blocks are processed from the end of 'src' towards its start.
+ *  This way the conversion works also if 'src' and 'dest' point to
+ *  the same address.
+ *  @param dest Destination array with UTF-32 encoded characters.
+ *  @param src Source array with ISO-8859-1 encoded bytes.
+ *  @param len Number of bytes in 'src' and UTF-32 characters in 'dest'.
+ *  @return the number of leading bytes that are left unconverted.
+ */
+static memSizeType latin1BlocksToStrelem (strElemType *const dest,
+    const const_ustriType src, memSizeType len)
+
+  {
+    __m128i bytes;
+    __m128i words;
+    const __m128i zero = _mm_setzero_si128();
+
+  /* latin1BlocksToStrelem */
+#if HAS_AVX2_INTRINSICS
+    if (len >= AVX2_BLOCK_SIZE && __builtin_cpu_supports("avx2")) {
+      len = latin1BlocksToStrelemAvx2(dest, src, len);
+    } /* if */
+#endif
+    while (len >= SSE2_BLOCK_SIZE) {
+      len -= SSE2_BLOCK_SIZE;
+      bytes = _mm_loadu_si128((const __m128i *) &src[len]);
+      words = _mm_unpackhi_epi8(bytes, zero);
+      _mm_storeu_si128((__m128i *) &dest[len + 12], _mm_unpackhi_epi16(words, zero));
+      _mm_storeu_si128((__m128i *) &dest[len + 8],  _mm_unpacklo_epi16(words, zero));
+      words = _mm_unpacklo_epi8(bytes, zero);
+      _mm_storeu_si128((__m128i *) &dest[len + 4],  _mm_unpackhi_epi16(words, zero));
+      _mm_storeu_si128((__m128i *) &dest[len],      _mm_unpacklo_epi16(words, zero));
+    } /* while */
+    return len;
+  } /* latin1BlocksToStrelem */
+
+
+
+/**
+ *  Convert trailing blocks of UTF-32 characters to ISO-8859-1 bytes.
+ *  Characters above 255 are truncated to their lowest byte, like
+ *  the scalar conversion in memcpy_from_strelem() does.
+ *  @param dest Destination array with ISO-8859-1 encoded bytes.
+ *  @param src Source array with UTF-32 encoded characters.
+ *  @param len Number of UTF-32 characters in 'src' and bytes in 'dest'.
+ *         Afterwards it contains the number of leading characters
+ *         that are left unconverted.
+ *  @return a value above 255 if one of the converted characters does
+ *          not fit into a byte, 0 otherwise.
+ */
+static strElemType strelemBlocksToLatin1 (const ustriType dest,
+    const strElemType *const src, memSizeType *const len)
+
+  {
+    memSizeType pos;
+    strElemType check = 0;
+    __m128i chars0;
+    __m128i chars1;
+    __m128i chars2;
+    __m128i chars3;
+    __m128i combined = _mm_setzero_si128();
+    const __m128i lowByte = _mm_set1_epi32(0xFF);
+
+  /* strelemBlocksToLatin1 */
+    pos = *len;
+    while (pos >= SSE2_BLOCK_SIZE) {
+      pos -= SSE2_BLOCK_SIZE;
+      chars0 = _mm_loadu_si128((const __m128i *) &src[pos]);
+      chars1 = _mm_loadu_si128((const __m128i *) &src[pos + 4]);
+      chars2 = _mm_loadu_si128((const __m128i *) &src[pos + 8]);
+      chars3 = _mm_loadu_si128((const __m128i *) &src[pos + 12]);
+      combined = _mm_or_si128(combined,
+          _mm_or_si128(_mm_or_si128(chars0, chars1),
+                       _mm_or_si128(chars2, chars3)));
+      /* After masking the characters fit into the signed and  */
+      /* unsigned saturation ranges of the pack instructions.  */
+      _mm_storeu_si128((__m128i *) &dest[pos], _mm_packus_epi16(
+          _mm_packs_epi32(_mm_and_si128(chars0, lowByte),
+                          _mm_and_si128(chars1, lowByte)),
+          _mm_packs_epi32(_mm_and_si128(chars2, lowByte),
+                          _mm_and_si128(chars3, lowByte))));
+    } /* while */
+    if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_andnot_si128(lowByte, combined),
+                                          _mm_setzero_si128())) != 0xFFFF) {
+      check = 256;
+    } /* if */
+    *len = pos;
+    return check;
+  } /* strelemBlocksToLatin1 */
+
+
+
+/**
+ *  Determine which of 16 UTF-32 characters are above 0x7F.
+ *  @return a bit mask where bit n is set if character n is not ASCII.
+ */
+static inline int nonAsciiStrelemMask (const __m128i chars0,
+    const __m128i chars1, const __m128i chars2, const __m128i chars3)
+
+  {
+    const __m128i nonAsciiBits = _mm_set1_epi32(~0x7F);
+    const __m128i zero = _mm_setzero_si128();
+
+  /* nonAsciiStrelemMask */
+    /* The comparisons produce 0 or -1. Packing keeps these values. */
+    return ~_mm_movemask_epi8(_mm_packs_epi16(
+        _mm_packs_epi32(_mm_cmpeq_epi32(_mm_and_si128(chars0, nonAsciiBits), zero),
+                        _mm_cmpeq_epi32(_mm_and_si128(chars1, nonAsciiBits), zero)),
+        _mm_packs_epi32(_mm_cmpeq_epi32(_mm_and_si128(chars2, nonAsciiBits), zero),
+                        _mm_cmpeq_epi32(_mm_and_si128(chars3, nonAsciiBits), zero)))) & 0xFFFF;
+  } /* nonAsciiStrelemMask */
+
+
+
+/**
+ *  Convert leading blocks of ASCII characters to UTF-8 bytes.
+ *  Complete blocks are converted until a block contains a character
+ *  above 0x7F or until less than a block is left.
+ *  @param dest Destination array with UTF-8 encoded bytes.
+ *  @param src Source array with UTF-32 encoded characters.
+ *  @param len Number of UTF-32 characters in 'src'.
+ *  @return the number of characters converted.
+ */
+static memSizeType asciiStrelemBlocksToUtf8 (const ustriType dest,
+    const strElemType *const src, const memSizeType len)
+
+  {
+    memSizeType pos = 0;
+    int nonAscii = 0;
+    __m128i chars0;
+    __m128i chars1;
+    __m128i chars2;
+    __m128i chars3;
+
+  /* asciiStrelemBlocksToUtf8 */
+    while (len - pos >= SSE2_BLOCK_SIZE && nonAscii == 0) {
+      chars0 = _mm_loadu_si128((const __m128i *) &src[pos]);
+      chars1 = _mm_loadu_si128((const __m128i *) &src[pos + 4]);
+      chars2 = _mm_loadu_si128((const __m128i *) &src[pos + 8]);
+      chars3 = _mm_loadu_si128((const __m128i *) &src[pos + 12]);
+      nonAscii = nonAsciiStrelemMask(chars0, chars1, chars2, chars3);
+      if (nonAscii == 0) {
+        _mm_storeu_si128((__m128i *) &dest[pos], _mm_packus_epi16(
+            _mm_packs_epi32(chars0, chars1), _mm_packs_epi32(chars2, chars3)));
+        pos += SSE2_BLOCK_SIZE;
+      } /* if */
+    } /* while */
+    return pos;
+  } /* asciiStrelemBlocksToUtf8 */
+
+
+
+#if !HAS_WMEMCHR || WCHAR_T_SIZE != 32
+/**
+ *  Skip complete blocks of UTF-32 characters that do not contain 'ch'.
+ *  @param mem Array with UTF-32 characters.
+ *  @param ch UTF-32 character to be searched in 'mem'.
+ *  @param len Number of UTF-32 characters in 'mem'.
+ *  @return the number of characters that are skipped. The block
+ *          after the skipped characters might contain 'ch'.
+ */
+static memSizeType skipBlocksWithoutChar (const strElemType *const mem,
+    const strElemType ch, const memSizeType len)
+
+  {
+    memSizeType pos = 0;
+    const __m128i searched = _mm_set1_epi32((int) ch);
+
+  /* skipBlocksWithoutChar */
+    while (len - pos >= SSE2_BLOCK_SIZE &&
+           _mm_movemask_epi8(_mm_or_si128(
+               _mm_or_si128(
+                   _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *) &mem[pos]), searched),
+                   _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *) &mem[pos + 4]), searched)),
+               _mm_or_si128(
+                   _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *) &mem[pos + 8]), searched),
+                   _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *) &mem[pos + 12]), searched)))) == 0) {
+      pos += SSE2_BLOCK_SIZE;
+    } /* while */
+    return pos;
+  } /* skipBlocksWithoutChar */
+#endif
+
+
+
+#if HAS_AVX2_INTRINSICS
+/**
+ *  AVX2 variant of countCharInBlocks().
+ *  This function must only be called if the CPU supports AVX2.
+ */
+__attribute__((target("avx2")))
+static memSizeType countCharInBlocksAvx2 (const strElemType *const mem,
+    const strElemType ch, memSizeType *const len)
+
+  {
+    memSizeType pos = 0;
+    memSizeType blockCount;
+    const __m256i searched = _mm256_set1_epi32((int) ch);
+    __m256i counts;
+    __m128i sum;
+    memSizeType count = 0;
+
+  /* countCharInBlocksAvx2 */
+    while (*len - pos >= AVX2_BLOCK_SIZE) {
+      /* The lanes of counts are decremented at most 4 * 255 times. */
+      counts = _mm256_setzero_si256();
+      for (blockCount = 255; blockCount != 0 && *len - pos >= AVX2_BLOCK_SIZE;
+           blockCount--) {
+        counts = _mm256_add_epi32(counts, _mm256_add_epi32(
+            _mm256_add_epi32(
+                _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *) &mem[pos]), searched),
+                _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *) &mem[pos + 8]), searched)),
+            _mm256_add_epi32(
+                _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *) &mem[pos + 16]), searched),
+                _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *) &mem[pos + 24]), searched))));
+        pos += AVX2_BLOCK_SIZE;
+      } /* for */
+      sum = _mm_add_epi32(_mm256_castsi256_si128(counts),
+                          _mm256_extracti128_si256(counts, 1));
+      sum = _mm_add_epi32(sum, _mm_srli_si128(sum, 8));
+      sum = _mm_add_epi32(sum, _mm_srli_si128(sum, 4));
+      count += (memSizeType) (uint32Type) -_mm_cvtsi128_si32(sum);
+    } /* while */
+    *len -= pos;
+    return count;
+  } /* countCharInBlocksAvx2 */
+
+
+
+/**
+ *  AVX2 variant of searchBlocksStrelem().
+ *  This function must only be called if the CPU supports AVX2.
+ */
+__attribute__((target("avx2")))
+static const strElemType *searchBlocksStrelemAvx2 (const strElemType *mem,
+    const memSizeType numPositions, const strElemType *const searched,
+    const memSizeType searched_size)
+
+  {
+    const memSizeType lastIndex = searched_size - 1;
+    const __m256i firstChar = _mm256_set1_epi32((int) searched[0]);
+    const __m256i lastChar = _mm256_set1_epi32((int) searched[lastIndex]);
+    const strElemType *beyond;
+    unsigned int candidates;
+    int bitPos;
+
+  /* searchBlocksStrelemAvx2 */
+    beyond = &mem[numPositions - numPositions % 8];
+    for (; mem < beyond; mem += 8) {
+      candidates = (unsigned int) _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_and_si256(
+          _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *) mem), firstChar),
+          _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *) &mem[lastIndex]),
+                             lastChar))));
+      while (candidates != 0) {
+        bitPos = uint8LeastSignificantBit((uint8Type) candidates);
+        if (memcmp(&mem[bitPos + 1], &searched[1],
+                   (searched_size - 2) * sizeof(strElemType)) == 0) {
+          return &mem[bitPos];
+        } /* if */
+        candidates &= candidates - 1;
+      } /* while */
+    } /* for */
+    return beyond;
+  } /* searchBlocksStrelemAvx2 */
+#endif
+
+
+
+/**
+ *  Count the occurrences of 'ch' in complete blocks of 'mem'.
+ *  @param mem Array with UTF-32 characters.
+ *  @param ch UTF-32 character to be counted.
+ *  @param len Number of UTF-32 characters in 'mem'. Afterwards it
+ *         contains the number of trailing characters that are not
+ *         counted.
+ *  @return the number of occurrences of 'ch' in the counted blocks.
+ */
+static memSizeType countCharInBlocks (const strElemType *const mem,
+    const strElemType ch, memSizeType *const len)
+
+  {
+    memSizeType pos = 0;
+    memSizeType blockCount;
+    const __m128i searched = _mm_set1_epi32((int) ch);
+    __m128i counts;
+    memSizeType count = 0;
+
+  /* countCharInBlocks */
+#if HAS_AVX2_INTRINSICS
+    if (*len >= AVX2_BLOCK_SIZE && __builtin_cpu_supports("avx2")) {
+      return countCharInBlocksAvx2(mem, ch, len);
+    } /* if */
+#endif
+    while (*len - pos >= SSE2_BLOCK_SIZE) {
+      /* The lanes of counts are decremented at most 4 * 255 times. */
+      counts = _mm_setzero_si128();
+      for (blockCount = 255; blockCount != 0 && *len - pos >= SSE2_BLOCK_SIZE;
+           blockCount--) {
+        counts = _mm_add_epi32(counts, _mm_add_epi32(
+            _mm_add_epi32(
+                _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *) &mem[pos]), searched),
+                _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *) &mem[pos + 4]), searched)),
+            _mm_add_epi32(
+                _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *) &mem[pos + 8]), searched),
+                _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *) &mem[pos + 12]), searched))));
+        pos += SSE2_BLOCK_SIZE;
+      } /* for */
+      counts = _mm_add_epi32(counts, _mm_srli_si128(counts, 8));
+      counts = _mm_add_epi32(counts, _mm_srli_si128(counts, 4));
+      count += (memSizeType) (uint32Type) -_mm_cvtsi128_si32(counts);
+    } /* while */
+    *len -= pos;
+    return count;
+  } /* countCharInBlocks */
+
+
+
+/**
+ *  Search 'searched' at the first 'numPositions' positions of 'mem'.
+ *  A position is only compared with memcmp(), if the first and the
+ *  last character of 'searched' match. These two characters are
+ *  checked for four positions at once. 'searched' must have at least
+ *  two characters and 'mem' must contain at least
+ *  numPositions + searched_size - 1 characters.
+ *  @return a pointer to the found position, or a pointer to the first
+ *          position that has not been checked. The search can always
+ *          continue at the returned position.
+ */
+static const strElemType *searchBlocksStrelem (const strElemType *mem,
+    const memSizeType numPositions, const strElemType *const searched,
+    const memSizeType searched_size)
+
+  {
+    const memSizeType lastIndex = searched_size - 1;
+    const __m128i firstChar = _mm_set1_epi32((int) searched[0]);
+    const __m128i lastChar = _mm_set1_epi32((int) searched[lastIndex]);
+    const strElemType *beyond;
+    unsigned int candidates;
+    int bitPos;
+
+  /* searchBlocksStrelem */
+#if HAS_AVX2_INTRINSICS
+    if (numPositions >= 8 && __builtin_cpu_supports("avx2")) {
+      return searchBlocksStrelemAvx2(mem, numPositions, searched, searched_size);
+    } /* if */
+#endif
+    beyond = &mem[numPositions - numPositions % 4];
+    for (; mem < beyond; mem += 4) {
+      candidates = (unsigned int) _mm_movemask_ps(_mm_castsi128_ps(_mm_and_si128(
+          _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *) mem), firstChar),
+          _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *) &mem[lastIndex]),
+                          lastChar))));
+      while (candidates != 0) {
+        bitPos = uint8LeastSignificantBit((uint8Type) candidates);
+        if (memcmp(&mem[bitPos + 1], &searched[1],
+                   (searched_size - 2) * sizeof(strElemType)) == 0) {
+          return &mem[bitPos];
+        } /* if */
+        candidates &= candidates - 1;
+      } /* while */
+    } /* for */
+    return beyond;
+  } /* searchBlocksStrelem */
+#endif
+
+
+
+/**
+ *  Convert a run of ASCII bytes to UTF-32 characters.
+ *  The conversion stops at the first byte above 0x7F. The vector
+ *  code converts whole blocks, so characters after the run might
+ *  be overwritten. 'dest' must have room for 'len' characters.
+ *  @param dest Destination array with UTF-32 encoded characters.
+ *  @param src Source array with UTF-8 encoded bytes.
+ *  @param len Number of bytes in 'src'.
+ *  @return the number of bytes converted.
+ */
+static inline memSizeType asciiRunToStrelem (strElemType *const dest,
+    const const_ustriType src, const memSizeType len)
+
+  {
+    memSizeType pos = 0;
+#if HAS_SSE2_INTRINSICS
+    int nonAscii;
+    __m128i bytes;
+    __m128i words;
+    const __m128i zero = _mm_setzero_si128();
+#endif
+
+  /* asciiRunToStrelem */
+#if HAS_SSE2_INTRINSICS
+    if (len >= SSE2_BLOCK_SIZE) {
+      bytes = _mm_loadu_si128((const __m128i *) src);
+      nonAscii = _mm_movemask_epi8(bytes);
+      words = _mm_unpacklo_epi8(bytes, zero);
+      _mm_storeu_si128((__m128i *) dest,        _mm_unpacklo_epi16(words, zero));
+      _mm_storeu_si128((__m128i *) &dest[4],  _mm_unpackhi_epi16(words, zero));
+      words = _mm_unpackhi_epi8(bytes, zero);
+      _mm_storeu_si128((__m128i *) &dest[8],  _mm_unpacklo_epi16(words, zero));
+      _mm_storeu_si128((__m128i *) &dest[12], _mm_unpackhi_epi16(words, zero));
+      if (nonAscii != 0) {
+        pos = (memSizeType) uint16LeastSignificantBit((uint16Type) nonAscii);
+      } else {
+        pos = SSE2_BLOCK_SIZE + asciiBlocksToStrelem(&dest[SSE2_BLOCK_SIZE],
+            &src[SSE2_BLOCK_SIZE], len - SSE2_BLOCK_SIZE);
+      } /* if */
+    } /* if */
+#endif
+    while (pos < len && src[pos] <= 0x7F) {
+      dest[pos] = (strElemType) src[pos];
+      pos++;
+    } /* while */
+    return pos;
+  } /* asciiRunToStrelem */
+
+
+
+/**
+ *  Convert a run of ASCII characters to UTF-8 bytes.
+ *  The conversion stops at the first character above 0x7F. The vector
+ *  code converts whole blocks, so bytes after the run might be
+ *  overwritten. 'dest' must have room for 'len' bytes.
+ *  @param dest Destination array with UTF-8 encoded bytes.
+ *  @param src Source array with UTF-32 encoded characters.
+ *  @param len Number of UTF-32 characters in 'src'.
+ *  @return the number of characters converted.
+ */
+static inline memSizeType asciiRunToUtf8 (const ustriType dest,
+    const strElemType *const src, const memSizeType len)
+
+  {
+    memSizeType pos = 0;
+#if HAS_SSE2_INTRINSICS
+    int nonAscii;
+    __m128i chars0;
+    __m128i chars1;
+    __m128i chars2;
+    __m128i chars3;
+#endif
+
+  /* asciiRunToUtf8 */
+#if HAS_SSE2_INTRINSICS
+    if (len >= SSE2_BLOCK_SIZE) {
+      chars0 = _mm_loadu_si128((const __m128i *) src);
+      chars1 = _mm_loadu_si128((const __m128i *) &src[4]);
+      chars2 = _mm_loadu_si128((const __m128i *) &src[8]);
+      chars3 = _mm_loadu_si128((const __m128i *) &src[12]);
+      nonAscii = nonAsciiStrelemMask(chars0, chars1, chars2, chars3);
+      _mm_storeu_si128((__m128i *) dest, _mm_packus_epi16(
+          _mm_packs_epi32(chars0, chars1), _mm_packs_epi32(chars2, chars3)));
+      if (nonAscii != 0) {
+        pos = (memSizeType) uint16LeastSignificantBit((uint16Type) nonAscii);
+      } else {
+        pos = SSE2_BLOCK_SIZE + asciiStrelemBlocksToUtf8(&dest[SSE2_BLOCK_SIZE],
+            &src[SSE2_BLOCK_SIZE], len - SSE2_BLOCK_SIZE);
+      } /* if */
+    } /* if */
+#endif
+    while (pos < len && src[pos] <= 0x7F) {
+      dest[pos] = (ucharType) src[pos];
+      pos++;
+    } /* while */
+    return pos;
+  } /* asciiRunToUtf8 */
+
+
+
 #if USE_DUFFS_UNROLLING
 /**
  *  Copy len bytes to Seed7 characters in a string.
@@ -364,6 +956,9 @@ void memcpy_to_strelem (register strElemType *const dest,
     register memSizeType pos;
 
   /* memcpy_to_strelem */
+#if HAS_SSE2_INTRINSICS
+    len = latin1BlocksToStrelem(dest, src, len);
+#endif
     if (len != 0) {
       pos = (len + 31) & ~(memSizeType) 31;
       switch (len & 31) {
@@ -487,6 +1082,9 @@ boolType memcpy_from_strelem (register const ustriType dest,
     register strElemType check = 0;
 
   /* memcpy_from_strelem */
+#if HAS_SSE2_INTRINSICS
+    check = strelemBlocksToLatin1(dest, src, &len);
+#endif
     if (len != 0) {
       pos = (len + 31) & ~(memSizeType) 31;
       switch (len & 31) {
@@ -546,8 +1144,16 @@ const strElemType *memchr_strelem (register const strElemType *mem,
 
   {
     register memSizeType blockCount;
+#if HAS_SSE2_INTRINSICS
+    memSizeType skipped;
+#endif
 
   /* memchr_strelem */
+#if HAS_SSE2_INTRINSICS
+    skipped = skipBlocksWithoutChar(mem, ch, len);
+    mem += skipped;
+    len -= skipped;
+#endif
     if (len != 0) {
       blockCount = (len + 31) >> 5;
       switch (len & 31) {
@@ -608,6 +1214,9 @@ void memcpy_to_strelem (register strElemType *const dest,
     register const const_ustriType src, memSizeType len)
 
   { /* memcpy_to_strelem */
+#if HAS_SSE2_INTRINSICS
+    len = latin1BlocksToStrelem(dest, src, len);
+#endif
     while (len != 0) {
       len--;
       dest[len] = src[len];
@@ -649,6 +1258,9 @@ boolType memcpy_from_strelem (register const ustriType dest,
     register strElemType check = 0;
 
   /* memcpy_from_strelem */
+#if HAS_SSE2_INTRINSICS
+    check = strelemBlocksToLatin1(dest, src, &len);
+#endif
     while (len != 0) {
       len--;
       check |= src[len]
@@ -671,7 +1283,17 @@ boolType memcpy_from_strelem (register const ustriType dest,
 const strElemType *memchr_strelem (register const strElemType *mem,
     const strElemType ch, memSizeType len)
 
-  { /* memchr_strelem */
+  {
+#if HAS_SSE2_INTRINSICS
+    memSizeType skipped;
+#endif
+
+  /* memchr_strelem */
+#if HAS_SSE2_INTRINSICS
+    skipped = skipBlocksWithoutChar(mem, ch, len);
+    mem += skipped;
+    len -= skipped;
+#endif
     for (; len > 0; mem++, len--) {
       if (*mem == ch) {
         return mem;
@@ -685,6 +1307,106 @@ const strElemType *memchr_strelem (register const strElemType *mem,
 
 
 
+/**
+ *  Count the occurrences of the character ch in the first len Seed7 characters.
+ *  @param mem Array with UTF-32 characters.
+ *  @param ch UTF-32 character to be counted in 'mem'.
+ *  @param len Number of UTF-32 characters in 'mem'.
+ *  @return the number of characters in 'mem' that are equal to 'ch'.
+ */
+memSizeType memcnt_strelem (const strElemType *const mem, const strElemType ch,
+    const memSizeType len)
+
+  {
+    memSizeType pos = 0;
+    memSizeType count = 0;
+#if HAS_SSE2_INTRINSICS
+    memSizeType unchecked = len;
+#endif
+
+  /* memcnt_strelem */
+#if HAS_SSE2_INTRINSICS
+    count = countCharInBlocks(mem, ch, &unchecked);
+    pos = len - unchecked;
+#endif
+    for (; pos < len; pos++) {
+      if (mem[pos] == ch) {
+        count++;
+      } /* if */
+    } /* for */
+    return count;
+  } /* memcnt_strelem */
+
+
+
+/**
+ *  Search the first occurrence of 'searched' in the first len Seed7 characters.
+ *  If vector instructions are available the first and the last character
+ *  of 'searched' are compared at several positions at once. Otherwise
+ *  the last character of 'searched' is searched with memchr_strelem().
+ *  @param mem Array with UTF-32 characters.
+ *  @param len Number of UTF-32 characters in 'mem'.
+ *  @param searched UTF-32 characters to be searched in 'mem'.
+ *  @param searched_size Number of UTF-32 characters in 'searched'.
+ *  @return a pointer to the first character of the match, or NULL if
+ *          'searched' does not occur in the given string area.
+ */
+const strElemType *memmem_strelem (const strElemType *mem, memSizeType len,
+    const strElemType *const searched, const memSizeType searched_size)
+
+  {
+#if !HAS_SSE2_INTRINSICS
+    strElemType ch_n;
+    memSizeType delta;
+    const strElemType *search_start;
+#endif
+    const strElemType *search_end;
+
+  /* memmem_strelem */
+    if (searched_size > len) {
+      return NULL;
+    } else if (searched_size == 0) {
+      return mem;
+    } else if (searched_size == 1) {
+      return memchr_strelem(mem, searched[0], len);
+    } /* if */
+#if HAS_SSE2_INTRINSICS
+    search_end = &mem[len - searched_size + 1];
+    mem = searchBlocksStrelem(mem, (memSizeType) (search_end - mem),
+                              searched, searched_size);
+    for (; mem < search_end; mem++) {
+      if (*mem == searched[0] &&
+          memcmp(mem, searched, searched_size * sizeof(strElemType)) == 0) {
+        return mem;
+      } /* if */
+    } /* for */
+#else
+    ch_n = searched[searched_size - 1];
+    /* The skip distance depends on the rightmost other occurrence. */
+    delta = 1;
+    while (delta < searched_size && searched[searched_size - 1 - delta] != ch_n) {
+      delta++;
+    } /* while */
+    search_start = &mem[searched_size - 1];
+    search_end = &mem[len];
+    while (search_start < search_end) {
+      search_start = memchr_strelem(search_start, ch_n,
+          (memSizeType) (search_end - search_start));
+      if (search_start == NULL) {
+        return NULL;
+      } else if (memcmp(search_start - searched_size + 1, searched,
+                        (searched_size - 1) * sizeof(strElemType)) == 0) {
+        return search_start - searched_size + 1;
+      } else {
+        search_start += delta;
+      } /* if */
+    } /* while */
+#endif
+    return NULL;
+  } /* memmem_strelem */
+
+
+
 #if STACK_LIKE_ALLOC_FOR_OS_STRI
 os_striType heapAllocOsStri (memSizeType len)
 
@@ -741,6 +1463,57 @@ void heapFreeOsStri (const_os_striType var)
 
 
 
+/**
+ *  Copy a run of ASCII characters from 'src' to 'dest'.
+ *  Copying stops at the first character above 0x7F. The vector
+ *  code copies whole blocks, so characters after the run might
+ *  be overwritten. 'dest' must have room for 'len' characters.
+ *  @param dest Destination array with UTF-32 encoded characters.
+ *  @param src Source array with UTF-32 encoded characters.
+ *  @param len Number of UTF-32 characters in 'src'.
+ *  @return the number of characters copied.
+ */
+memSizeType memcpy_ascii_strelem (strElemType *const dest,
+    const strElemType *const src, const memSizeType len)
+
+  {
+    memSizeType pos = 0;
+#if HAS_SSE2_INTRINSICS
+    int nonAscii = 0;
+    __m128i chars0;
+    __m128i chars1;
+    __m128i chars2;
+    __m128i chars3;
+#endif
+
+  /* memcpy_ascii_strelem */
+#if HAS_SSE2_INTRINSICS
+    while (len - pos >= SSE2_BLOCK_SIZE && nonAscii == 0) {
+      chars0 = _mm_loadu_si128((const __m128i *) &src[pos]);
+      chars1 = _mm_loadu_si128((const __m128i *) &src[pos + 4]);
+      chars2 = _mm_loadu_si128((const __m128i *) &src[pos + 8]);
+      chars3 = _mm_loadu_si128((const __m128i *) &src[pos + 12]);
+      nonAscii = nonAsciiStrelemMask(chars0, chars1, chars2, chars3);
+      _mm_storeu_si128((__m128i *) &dest[pos],      chars0);
+      _mm_storeu_si128((__m128i *) &dest[pos + 4],  chars1);
+      _mm_storeu_si128((__m128i *) &dest[pos + 8],  chars2);
+      _mm_storeu_si128((__m128i *) &dest[pos + 12], chars3);
+      if (nonAscii != 0) {
+        pos += (memSizeType) uint16LeastSignificantBit((uint16Type) nonAscii);
+      } else {
+        pos += SSE2_BLOCK_SIZE;
+      } /* if */
+    } /* while */
+#endif
+    while (pos < len && src[pos] <= 0x7F) {
+      dest[pos] = src[pos];
+      pos++;
+    } /* while */
+    return pos;
+  } /* memcpy_ascii_strelem */
+
+
+
 /**
  *  Convert an UTF-8 encoded string to an UTF-32 encoded string.
  *  The memory for the destination dest_stri is not allocated.
@@ -756,12 +1529,16 @@ memSizeType stri8_to_stri (strElemType *const dest_stri,
 
   {
     strElemType *stri;
+    memSizeType converted;
 
   /* stri8_to_stri */
     stri = dest_stri;
     for (; len > 0; len--) {
       if (*stri8 <= 0x7F) {
-        *stri++ = (strElemType) *stri8++;
+        converted = memcpy_ascii_strelem(stri, stri8, len);
+        stri += converted;
+        stri8 += converted;
+        len -= converted - 1;
       } else if (stri8[0] >= 0xC0 && stri8[0] <= 0xDF && len >= 2 &&
                  stri8[1] >= 0x80 && stri8[1] <= 0xBF) {
         /* stri8[0]   range 192 to 223 (leading bits 110.....) */
@@ -851,12 +1628,16 @@ memSizeType utf8_to_stri (strElemType *const dest_stri,
 
   {
     strElemType *stri;
+    memSizeType converted;
 
   /* utf8_to_stri */
     stri = dest_stri;
     for (; len > 0; len--) {
       if (*ustri <= 0x7F) {
-        *stri++ = (strElemType) *ustri++;
+        converted = asciiRunToStrelem(stri, ustri, len);
+        stri += converted;
+        ustri += converted;
+        len -= converted - 1;
       } else if (ustri[0] >= 0xC0 && ustri[0] <= 0xDF && len >= 2 &&
                  ustri[1] >= 0x80 && ustri[1] <= 0xBF) {
         /* ustri[0]   range 192 to 223 (leading bits 110.....) */
@@ -1038,13 +1819,17 @@ memSizeType stri_to_utf8 (const ustriType out_stri,
   {
     register ustriType ustri;
     register strElemType ch;
+    memSizeType converted;
 
   /* stri_to_utf8 */
     ustri = out_stri;
     for (; len > 0; strelem++, len--) {
       ch = *strelem;
       if (ch <= 0x7F) {
-        *ustri++ = (ucharType) ch;
+        converted = asciiRunToUtf8(ustri, strelem, len);
+        ustri += converted;
+        strelem += converted - 1;
+        len -= converted - 1;
       } else if (ch <= 0x7FF) {
         ustri[0] = (ucharType) (0xC0 | (ch >>  6));
         ustri[1] = (ucharType) (0x80 |( ch        & 0x3F));
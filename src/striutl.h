@@ -216,6 +216,9 @@ void memset_to_strelem (register strElemType *const dest,
 boolType memcpy_from_strelem (register const ustriType dest,
                               register const strElemType *const src,
                               memSizeType len);
+memSizeType memcpy_ascii_strelem (strElemType *const dest,
+                                  const strElemType *const src,
+                                  const memSizeType len);
 #if HAS_WMEMCHR && WCHAR_T_SIZE == 32
 #define memchr_strelem(mem, ch, len) \
     (const strElemType *) wmemchr((const wchar_t *) mem, (wchar_t) ch, (size_t) len)
@@ -223,6 +226,10 @@ boolType memcpy_from_strelem (register const ustriType dest,
 const strElemType *memchr_strelem (register const strElemType *mem,
     const strElemType ch, memSizeType len);
 #endif
+memSizeType memcnt_strelem (const strElemType *const mem, const strElemType ch,
+                            const memSizeType len);
+const strElemType *memmem_strelem (const strElemType *mem, memSizeType len,
+    const strElemType *const searched, const memSizeType searched_size);
 #if STACK_LIKE_ALLOC_FOR_OS_STRI
 os_striType heapAllocOsStri (memSizeType len);
 void heapFreeOsStri (const_os_striType var);
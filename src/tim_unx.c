@@ -55,7 +55,9 @@
 #include "errno.h"
 
 #include "common.h"
+#include "data_rtl.h"
 #include "tim_rtl.h"
+#include "cor_rtl.h"
 #include "rtl_err.h"
 
 #undef EXTERN
@@ -118,6 +120,9 @@ void timAwait (intType year, intType month, intType day, intType hour,
       logError(printf("timAwait: Micro seconds " FMT_D
                       " not in allowed range.\n", micro_sec););
       raise_error(RANGE_ERROR);
+    } else if (inCoroutine) {
+      /* Let the other coroutines run while this one waits. */
+      corSleep(1000000 * (intType) await_second + micro_sec);
     } else {
       do {
         gettimeofday(&time_val, NULL);
@@ -177,6 +182,9 @@ void timAwait (intType year, intType month, intType day, intType hour,
       logError(printf("timAwait: Micro seconds " FMT_D
                       " not in allowed range.\n", micro_sec););
       raise_error(RANGE_ERROR);
+    } else if (inCoroutine) {
+      /* Let the other coroutines run while this one waits. */
+      corSleep(1000000 * (intType) await_second + micro_sec);
     } else {
       do {
         gettimeofday(&time_val, NULL);
@@ -241,6 +249,9 @@ void timAwait (intType year, intType month, intType day, intType hour,
       logError(printf("timAwait: Micro seconds " FMT_D
                       " not in allowed range.\n", micro_sec););
       raise_error(RANGE_ERROR);
+    } else if (inCoroutine) {
+      /* Let the other coroutines run while this one waits. */
+      corSleep(1000000 * (intType) await_second + micro_sec);
     } else {
       do {
         gettimeofday(&time_val, NULL);
@@ -312,6 +323,9 @@ void timAwait (intType year, intType month, intType day, intType hour,
       logError(printf("timAwait: Micro seconds " FMT_D
                       " not in allowed range.\n", micro_sec););
       raise_error(RANGE_ERROR);
+    } else if (inCoroutine) {
+      /* Let the other coroutines run while this one waits. */
+      corSleep(1000000 * (intType) await_second + micro_sec);
     } else {
       do {
         gettimeofday(&time_val, NULL);
@@ -389,6 +403,9 @@ void timAwait (intType year, intType month, intType day, intType hour,
       logError(printf("timAwait: Micro seconds " FMT_D
                       " not in allowed range.\n", micro_sec););
       raise_error(RANGE_ERROR);
+    } else if (inCoroutine) {
+      /* Let the other coroutines run while this one waits. */
+      corSleep(1000000 * (intType) await_second + micro_sec);
     } else {
       gettimeofday(&time_val, NULL);
       if (time_val.tv_sec < await_second ||
@@ -467,6 +484,9 @@ void timAwait (intType year, intType month, intType day, intType hour,
       logError(printf("timAwait: Micro seconds " FMT_D
                       " not in allowed range.\n", micro_sec););
       raise_error(RANGE_ERROR);
+    } else if (inCoroutine) {
+      /* Let the other coroutines run while this one waits. */
+      corSleep(1000000 * (intType) await_second + micro_sec);
     } else {
       gettimeofday(&time_val, NULL);
       if (time_val.tv_sec < await_second ||
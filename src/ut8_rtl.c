@@ -56,7 +56,6 @@
 #define GETS_DEFAULT_SIZE    1048576
 #define GETS_STRI_SIZE_DELTA    4096
 #define READ_STRI_INIT_SIZE      256
-#define READ_STRI_SIZE_DELTA    2048
 #define WRITE_STRI_BLOCK_SIZE    512
 
 
@@ -69,6 +68,111 @@ typedef struct {
 
 
 
+/**
+ *  Enlarge a byte buffer that receives the bytes of a read function.
+ *  The capacity is doubled, but at least 'minLength' is reserved.
+ *  If the reallocation fails 'buffer' is freed.
+ *  @param memlength Address of the capacity of 'buffer'. It is
+ *         updated to the new capacity.
+ *  @return the resized buffer or NULL if there is not enough memory.
+ */
+static bstriType growReadBuffer (const bstriType buffer, memSizeType *memlength,
+    const memSizeType minLength)
+
+  {
+    memSizeType newmemlength;
+    bstriType resized_buffer;
+
+  /* growReadBuffer */
+    if (*memlength > MAX_BSTRI_LEN / 2) {
+      newmemlength = MAX_BSTRI_LEN;
+    } else {
+      newmemlength = 2 * *memlength;
+    } /* if */
+    if (newmemlength < minLength) {
+      newmemlength = minLength;
+    } /* if */
+    REALLOC_BSTRI_CHECK_SIZE(resized_buffer, buffer, *memlength, newmemlength);
+    if (unlikely(resized_buffer == NULL)) {
+      FREE_BSTRI(buffer, *memlength);
+    } else {
+      COUNT3_BSTRI(*memlength, newmemlength);
+      *memlength = newmemlength;
+    } /* if */
+    return resized_buffer;
+  } /* growReadBuffer */
+
+
+
+#ifdef read_buffer_skip
+/**
+ *  Read bytes from 'inFile' until '\n' or EOF is found.
+ *  The read buffer of 'inFile' is searched with memchr() and the
+ *  bytes in front of the '\n' are copied at once. The buffer is
+ *  refilled with getc_unlocked(). A '\n' is consumed but not
+ *  stored. The caller must lock 'inFile'.
+ *  @param buffer Address of the byte buffer that receives the bytes.
+ *         If there is not enough memory *buffer is freed and set
+ *         to NULL.
+ *  @param memlength Address of the capacity of *buffer.
+ *  @param position Address of the number of bytes in *buffer.
+ *  @return '\n' or EOF.
+ */
+static int readLineBytesFromBuffer (cFileType inFile, bstriType *buffer,
+    memSizeType *memlength, memSizeType *position)
+
+  {
+    memSizeType available;
+    memSizeType length;
+    const unsigned char *fileBuffer;
+    const unsigned char *found;
+    boolType searching = TRUE;
+    int ch = EOF;
+
+  /* readLineBytesFromBuffer */
+    do {
+      available = read_buffer_avail(inFile);
+      if (available == 0) {
+        /* The buffer is empty: getc_unlocked() refills it. */
+        ch = getc_unlocked(inFile);
+        if (ch == (int) '\n' || ch == EOF) {
+          searching = FALSE;
+        } else {
+          if (*position >= *memlength) {
+            *buffer = growReadBuffer(*buffer, memlength, *position + 1);
+            if (unlikely(*buffer == NULL)) {
+              return EOF;
+            } /* if */
+          } /* if */
+          (*buffer)->mem[(*position)++] = (ucharType) ch;
+        } /* if */
+      } else {
+        fileBuffer = read_buffer_ptr(inFile);
+        found = (const unsigned char *) memchr(fileBuffer, '\n', available);
+        if (found == NULL) {
+          length = available;
+        } else {
+          length = (memSizeType) (found - fileBuffer);
+          ch = (int) '\n';
+          searching = FALSE;
+        } /* if */
+        if (length > *memlength - *position) {
+          *buffer = growReadBuffer(*buffer, memlength, *position + length);
+          if (unlikely(*buffer == NULL)) {
+            return EOF;
+          } /* if */
+        } /* if */
+        memcpy(&(*buffer)->mem[*position], fileBuffer, length);
+        *position += length;
+        read_buffer_skip(inFile, found == NULL ? length : length + 1);
+      } /* if */
+    } while (searching);
+    return ch;
+  } /* readLineBytesFromBuffer */
+#endif
+
+
+
 static inline void bytes_to_strelements (ustriType buffer, memSizeType bytes_in_buffer,
     strElemType *stri_dest, readStateType *state, errInfoType *err_info)
 
@@ -689,11 +793,9 @@ striType ut8LineRead (fileType inFile, charType *terminationChar)
   {
     cFileType cInFile;
     register int ch;
-    register memSizeType position;
+    memSizeType position;
     ucharType *memory;
     memSizeType memlength;
-    memSizeType newmemlength;
-    bstriType resized_buffer;
     bstriType buffer;
     memSizeType result_size;
     striType resized_result;
@@ -726,23 +828,28 @@ striType ut8LineRead (fileType inFile, charType *terminationChar)
         memory = buffer->mem;
         position = 0;
         flockfile(cInFile);
+#ifdef read_buffer_skip
+        ch = readLineBytesFromBuffer(cInFile, &buffer, &memlength, &position);
+        if (unlikely(buffer == NULL)) {
+          funlockfile(cInFile);
+          raise_error(MEMORY_ERROR);
+          return NULL;
+        } /* if */
+        memory = buffer->mem;
+#else
         while ((ch = getc_unlocked(cInFile)) != (int) '\n' && ch != EOF) {
           if (position >= memlength) {
-            newmemlength = memlength + READ_STRI_SIZE_DELTA;
-            REALLOC_BSTRI_CHECK_SIZE(resized_buffer, buffer, memlength, newmemlength);
-            if (unlikely(resized_buffer == NULL)) {
-              FREE_BSTRI(buffer, memlength);
+            buffer = growReadBuffer(buffer, &memlength, position + 1);
+            if (unlikely(buffer == NULL)) {
               funlockfile(cInFile);
               raise_error(MEMORY_ERROR);
               return NULL;
             } /* if */
-            buffer = resized_buffer;
-            COUNT3_BSTRI(memlength, newmemlength);
             memory = buffer->mem;
-            memlength = newmemlength;
           } /* if */
           memory[position++] = (ucharType) ch;
         } /* while */
+#endif
         funlockfile(cInFile);
         if (ch == (int) '\n' && position != 0 && memory[position - 1] == '\r') {
           position--;
@@ -899,8 +1006,6 @@ striType ut8WordRead (fileType inFile, charType *terminationChar)
     register memSizeType position;
     ucharType *memory;
     memSizeType memlength;
-    memSizeType newmemlength;
-    bstriType resized_buffer;
     bstriType buffer;
     memSizeType result_size;
     striType resized_result;
@@ -939,18 +1044,13 @@ striType ut8WordRead (fileType inFile, charType *terminationChar)
         while (ch != (int) ' ' && ch != (int) '\t' &&
             ch != (int) '\n' && ch != EOF) {
           if (position >= memlength) {
-            newmemlength = memlength + READ_STRI_SIZE_DELTA;
-            REALLOC_BSTRI_CHECK_SIZE(resized_buffer, buffer, memlength, newmemlength);
-            if (unlikely(resized_buffer == NULL)) {
-              FREE_BSTRI(buffer, memlength);
+            buffer = growReadBuffer(buffer, &memlength, position + 1);
+            if (unlikely(buffer == NULL)) {
               funlockfile(cInFile);
               raise_error(MEMORY_ERROR);
               return NULL;
             } /* if */
-            buffer = resized_buffer;
-            COUNT3_BSTRI(memlength, newmemlength);
             memory = buffer->mem;
-            memlength = newmemlength;
           } /* if */
           memory[position++] = (ucharType) ch;
           ch = getc_unlocked(cInFile);
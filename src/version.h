@@ -0,0 +1,398 @@
+#define PATH_DELIMITER '/'
+#define OBJECT_FILE_EXTENSION ".o"
+#define C_COMPILER "gcc"
+#define CC_OPT_VERSION_INFO "--version"
+#define CC_FLAGS "-ffunction-sections -fdata-sections"
+#define CC_ERROR_FILEDES 2
+#define CC_VERSION_INFO_FILEDES 1
+#define LINKER_OPT_OUTPUT_FILE "-o "
+#define ARCHIVER "ar"
+#define ARCHIVER_OPT_REPLACE "r "
+#define SYSTEM_LIBS ""
+#define SYSTEM_MATH_LIBS "-lm"
+#define MAKE_UTILITY_NAME "make"
+#define MAKEFILE_NAME "makefile"
+#define SEARCH_PATH_DELIMITER ':'
+#define AWAIT_WITH_SELECT
+#define SIGNAL_HANDLER_CAN_DO_IO
+#define CONSOLE_UTF8
+#define OS_STRI_UTF8
+#define ESCAPE_SHELL_COMMANDS
+#define LIBRARY_FILE_EXTENSION ".a"
+#define CPLUSPLUS_COMPILER "g++"
+#define CC_SOURCE_UTF8
+#define CC_OPT_DEBUG_INFO "-g"
+#define CC_OPT_NO_WARNINGS "-w"
+#define LINKER_OPT_NO_DEBUG_INFO "-Wl,--strip-debug"
+#define LINKER_FLAGS "-Wl,--gc-sections"
+#define SEED7_LIB "seed7_05.a"
+#define DRAW_LIB "s7_draw.a"
+#define CONSOLE_LIB "s7_con.a"
+#define DATABASE_LIB "s7_db.a"
+#define COMP_DATA_LIB "s7_data.a"
+#define COMPILER_LIB "s7_comp.a"
+#define C_COMPILER_VERSION "gcc (Debian 12.2.0-14+deb12u1) 12.2.0"
+#define C_VERSION 201710
+#define BUILD_DIRECTORY "/root/repo/src"
+#define CC_OPT_LINK_TIME_OPTIMIZATION "-flto=auto"
+#define LINKER_OPT_LTO_MANDATORY 0
+#define LINKER_OPT_PARTIAL_LINKING "-r"
+#define CC_OPT_POSITION_INDEPENDENT_CODE "-fPIC"
+#define CONSTRUCTOR_ATTRIBUTE "__attribute__ ((constructor))"
+#define DEFINE_INITIALIZER_MACRO ""
+#define CHAR_SIZE 8
+#define SHORT_SIZE 16
+#define INT_SIZE 32
+#define LONG_SIZE 64
+#define LONG_LONG_SIZE 64
+#define POINTER_SIZE 64
+#define FLOAT_SIZE 32
+#define DOUBLE_SIZE 64
+#define WCHAR_T_SIZE 32
+#define TIME_T_SIZE 64
+#define TIME_T_SIGNED 1
+#define GID_T_SIZE 32
+#define GID_T_SIGNED 0
+#define PID_T_SIZE 32
+#define PID_T_SIGNED 1
+#define UID_T_SIZE 32
+#define UID_T_SIGNED 0
+#define SIZE_T_SIGNED 0
+#define CHAR_SIGNED 1
+#define BOOLTYPE _Bool
+#define BOOLTYPE_STRI "_Bool"
+#define INT8TYPE signed char
+#define INT8TYPE_STRI "signed char"
+#define UINT8TYPE unsigned char
+#define UINT8TYPE_STRI "unsigned char"
+#define INT16TYPE short int
+#define INT16TYPE_STRI "short int"
+#define UINT16TYPE unsigned short int
+#define UINT16TYPE_STRI "unsigned short int"
+#define INT32TYPE int
+#define INT32TYPE_STRI "int"
+#define UINT32TYPE unsigned int
+#define UINT32TYPE_STRI "unsigned int"
+#define INT32_SUFFIX(num) num
+#define UINT32_SUFFIX(num) num ## U
+#define INT32TYPE_LITERAL_SUFFIX ""
+#define INT32TYPE_FORMAT_LENGTH_MODIFIER ""
+#define INT64TYPE long
+#define INT64TYPE_STRI "long"
+#define UINT64TYPE unsigned long
+#define UINT64TYPE_STRI "unsigned long"
+#define INT64_SUFFIX(num) num ## L
+#define UINT64_SUFFIX(num) num ## UL
+#define INT64TYPE_LITERAL_SUFFIX "L"
+#define INT64TYPE_FORMAT_LENGTH_MODIFIER "l"
+#define INT128TYPE __int128
+#define INT128TYPE_STRI "__int128"
+#define UINT128TYPE unsigned __int128
+#define UINT128TYPE_STRI "unsigned __int128"
+#define HAS_LLABS 1
+#define HAS_ABS64 0
+#define INTPTR_T_DEFINED 1
+#define NULL_DEVICE "/dev/null"
+#define HAS_CDECL 0
+#define HAS_STDCALL 0
+#define LINE_DIRECTIVE_ACCEPTS_UTF8 1
+#define UNISTD_H_PRESENT 1
+#define STDINT_H_PRESENT 1
+#define ACLAPI_H_PRESENT 0
+#define WINDOWSX_H_PRESENT 0
+#define HAS_SIGNAL 1
+#define HAS_SIGACTION 1
+#define SIGNAL_RESETS_HANDLER 0
+#define likely(x)   __builtin_expect((x),1)
+#define unlikely(x) __builtin_expect((x),0)
+#define NORETURN __attribute__ ((noreturn))
+#define MACRO_DEFS "#define likely(x)   __builtin_expect((x),1)\n#define unlikely(x) __builtin_expect((x),0)\n#define NORETURN __attribute__ ((noreturn))\n"
+#define FILENO_WORKS_FOR_NULL 0
+#define UNIX_SOCKETS 1
+#define SOCKET_LIB UNIX_SOCKETS
+#define HAS_GETADDRINFO 1
+#define EAI_NODATA (-5)
+#define DIRENT_DIRECTORY 1
+#define DIR_LIB DIRENT_DIRECTORY
+#define OS_OFF_T_SIZE 64
+#define os_off_t off_t
+#define os_fseek fseeko
+#define os_ftell ftello
+#define OS_FSEEK_RESETS_EOF_FLAG 1
+#define os_lseek lseek
+#define os_ftruncate ftruncate
+#define FTRUNCATE_SIZE OS_OFF_T_SIZE
+#define os_environ environ
+#define DECLARE_OS_ENVIRON 1
+#define USE_GET_ENVIRONMENT 0
+#define INITIALIZE_OS_ENVIRON 0
+#define os_getenv getenv
+#define GETENV_IS_CASE_SENSITIVE 1
+#define os_setenv setenv
+#define SETENV_ALLOWS_KEY_WITH_EQUALS_SIGN 0
+#define GETENV_ALLOWS_KEY_WITH_EQUALS_SIGN 0
+#define os_unsetenv unsetenv
+#define HAS_LUTIMES
+#define os_lutimes lutimes
+#define FOPEN_SUPPORTS_CLOEXEC_MODE 1
+#define FERROR_WRONG_WHEN_READING_FROM_WRITE_ONLY_FILE 0
+#define HAS_FCNTL_SETFD_CLOEXEC 1
+#define HAS_PIPE2 1
+#define HAS_SNPRINTF 1
+#define HAS_VSNPRINTF 1
+#define HAS_POPEN 1
+#define POPEN_SUPPORTS_BINARY_MODE 0
+#define POPEN_SUPPORTS_TEXT_MODE 0
+#define POPEN_SUPPORTS_CLOEXEC_MODE 1
+#define FTELL_SUCCEEDS_FOR_PIPE 0
+#define STDOUT_IS_IN_TEXT_MODE 0
+#define SYSTEM_RESULT_FOR_RETURN_0 0
+#define FSEEK_SUCCEEDS_FOR_STDIN 1
+#define FOPEN_OPENS_DIRECTORIES 1
+#define FWRITE_WRONG_FOR_READ_ONLY_FILES 0
+#define FREAD_WRONG_FOR_WRITE_ONLY_FILES 0
+#define FCLOSE_FAILS_AFTER_PREVIOUS_ERROR 0
+#define REMOVE_FAILS_FOR_EMPTY_DIRS 0
+#define OS_PATH_HAS_DRIVE_LETTERS 0
+#define HOME_DIR_ENV_VAR {'H', 'O', 'M', 'E', 0}
+#define RSHIFT_DOES_SIGN_EXTEND 1
+#define TWOS_COMPLEMENT_INTTYPE 1
+#define ONES_COMPLEMENT_INTTYPE 0
+#define LITTLE_ENDIAN_INTTYPE 1
+#define BIG_ENDIAN_INTTYPE 0
+#define DO_SIGFPE_WITH_DIV_BY_ZERO 0
+#define CHECK_INT_DIV_BY_ZERO 1
+#define CHECK_INT_DIV_ZERO_BY_ZERO 1
+#define CHECK_INT_REM_BY_ZERO 1
+#define CHECK_INT_REM_ZERO_BY_ZERO 1
+#define OVERFLOW_SIGNAL 0
+#define OVERFLOW_SIGNAL_STR ""
+#define HAS_BUILTIN_OVERFLOW_OPERATIONS 1
+#define HAS_BUILTIN_POPCOUNT 1
+#define builtin_popcount64(x) __builtin_popcountl(x)
+#define LSHIFT_BUILTIN_MUL_TIME 138735
+#define LSHIFT_TWO_ARG_CHECKS_TIME 163849
+#define LSHIFT_ONE_ARG_CHECK_TIME 107580
+#define LSHIFT_RESULT_CHECK_TIME 158960
+#define LSHIFT_NO_CHECK_TIME 54394
+#define INT_DIV_OVERFLOW 4
+#define INT_REM_OVERFLOW 4
+#define ROUND_HALF_TO_EVEN 1
+#define PRINTF_ROUNDING ROUND_HALF_TO_EVEN
+#define PRINTF_SUPPORTS_VARIABLE_FORMATS 1
+#define FLOAT_MIN_EXP10 -38
+#define FLOAT_MAX_EXP10 38
+#define DOUBLE_MIN_EXP10 -308
+#define DOUBLE_MAX_EXP10 308
+#define MIN_PRINTED_EXPONENT_DIGITS 2
+#define MAX_PRINTED_EXPONENT_DIGITS 3
+#define FMT_E_FLT "%1.5e"
+#define FMT_E_FLT_PRECISION 5
+#define FLOAT_STR_LARGE_NUMBER 1.0e6
+#define FMT_E_DBL "%1.14e"
+#define FMT_E_DBL_PRECISION 14
+#define DOUBLE_STR_LARGE_NUMBER 1.0e15
+#define FLOAT_ZERO_DIV_ERROR 0
+#define CAST_INT_TO_FLOAT_OKAY 1
+#define HAS_LOG1P 1
+#define HAS_LOG2 1
+#define HAS_CBRT 1
+#define CHECK_FLOAT_DIV_BY_ZERO 0
+#define USE_NEGATIVE_ZERO_BITPATTERN 0
+#define os_isnan isnan
+#define OS_ISNAN_DEFINITION "#define os_isnan isnan\n"
+#define FLOAT_NAN_COMPARISON_OKAY 1
+#define FLOAT_ZERO_COMPARISON_OKAY 1
+#define HAS_EXP 1
+#define HAS_EXP2 1
+#define HAS_EXP10 1
+#define HAS_EXPM1 1
+#define SQRT_OF_NAN_OKAY 1
+#define SQRT_OF_NEGATIVE_OKAY 1
+#define EXP_OF_NAN_OKAY 1
+#define LDEXP_OF_NAN_OKAY 1
+#define LDEXP_OF_INFINITY_OKAY 1
+#define LDEXP_SUBNORMAL_OKAY 1
+#define FREXP_INFINITY_NAN_OKAY 1
+#define FREXP_SUBNORMAL_OKAY 1
+#define FMOD_DIVIDEND_NAN_OKAY 1
+#define FMOD_DIVISOR_NAN_OKAY 1
+#define FMOD_DIVIDEND_INFINITY_OKAY 1
+#define FMOD_DIVISOR_INFINITY_OKAY 1
+#define FMOD_DIVISOR_ZERO_OKAY 1
+#define FLOAT_ZERO_TIMES_INFINITE_OKAY 1
+#define NAN_MULTIPLICATION_OKAY 1
+#define NAN_DIVISION_OKAY 1
+#define MAX_ODD_FLOAT 16777215.0
+#define MAX_ODD_DOUBLE 9007199254740991.0
+#define POW_OF_NAN_OKAY 1
+#define POW_OF_ZERO_OKAY 0
+#define POW_OF_NEGATIVE_OKAY 1
+#define POW_OF_ONE_OKAY 1
+#define POW_EXP_NAN_OKAY 1
+#define POW_EXP_MINUS_INFINITY_OKAY 1
+#define POW_UNDERFLOW_WITH_SIGN 1
+#define LOG_OF_NAN_OKAY 1
+#define LOG_OF_ZERO_OKAY 1
+#define LOG_OF_NEGATIVE_OKAY 1
+#define LOG10_OF_NAN_OKAY 1
+#define LOG10_OF_ZERO_OKAY 1
+#define LOG10_OF_NEGATIVE_OKAY 1
+#define LOG2_OF_NAN_OKAY 1
+#define LOG2_OF_ZERO_OKAY 1
+#define LOG2_OF_NEGATIVE_OKAY 1
+#define PRINTS_NEGATIVE_ZERO 1
+#define os_isinf isinf
+#define FLOAT_TO_INT_OVERFLOW_SATURATES
+#define INT_RANGE_IN_FLOAT_MAX 16777216
+#define FLOAT_MANTISSA_FACTOR 16777216.0
+#define FLOAT_MANTISSA_SHIFT 24
+#define FLOAT_EXPONENT_OFFSET 127
+#define INT_RANGE_IN_DOUBLE_MAX 9007199254740992
+#define DOUBLE_MANTISSA_FACTOR 9007199254740992.0
+#define DOUBLE_MANTISSA_SHIFT 53
+#define DOUBLE_EXPONENT_OFFSET 1023
+#define MINIMUM_TRUNC_ARGUMENT -9223372036854775808
+#define MAXIMUM_TRUNC_ARGUMENT 9223372036854774784
+#define STRTOD_ACCEPTS_HEX_NUMBERS 1
+#define ATOF_ACCEPTS_HEX_NUMBERS 1
+#define STRTOD_ACCEPTS_DENORMAL_NUMBERS 1
+#define ATOF_ACCEPTS_DENORMAL_NUMBERS 1
+#define STRTOD_ACCEPTS_SIGN_WITHOUT_DIGITS 0
+#define STRTOD_ACCEPTS_INF 1
+#define STRTOD_ACCEPTS_INFINITY 1
+#define STRTOD_ACCEPTS_NAN 1
+#define HAS_SSE2_INTRINSICS 1
+#define HAS_AVX2_INTRINSICS 1
+#define HAS_SHA_INTRINSICS 1
+#define HAS_PCLMUL_INTRINSICS 1
+#define HAS_AESNI_INTRINSICS 1
+#define MALLOC_ALIGNMENT 4
+#define MALLOC_OF_0_RETURNS_NULL 0
+#define UNALIGNED_MEMORY_ACCESS_OKAY 1
+#define CASTING_GETS_A_UNION_ELEMENT 1
+#define UNIONS_CAN_CONVERT_TO_GENERIC 1
+#define MEMCPY_ZERO_BYTES_DOES_NOTHING 1
+#define EOF_IS_MINUS_ONE 1
+#define EMPTY_STRUCTS_ALLOWED 1
+#define INITIALIZING_WITH_ADDRESS_ALLOWED 1
+#define LIMITED_CSTRI_LITERAL_LEN 0
+#define LIMITED_ARRAY_LITERAL_LEN 0
+#define SWITCH_WORKS_FOR_INT64TYPE 1
+#define STACK_GROWS_UPWARD 0
+#define STMT_BLOCK_IN_PARENTHESES_OK 1
+#define TRIGRAPH_SEQUENCES_ARE_REPLACED 0
+#define DIGRAPH_SEQUENCES_ARE_REPLACED 1
+#define STRINGIFY_WORKS 1
+#define DIRECTIVES_IN_MACRO_ARGUMENTS_OK 1
+#define DEFAULT_STACK_SIZE 16777216
+#define USE_LOCALTIME_R
+#define LOCALTIME_WORKS_SIGNED 1
+#define HAS_GMTIME_R
+#define HAS_GETRLIMIT 1
+#define SOFT_STACK_LIMIT 8388608
+#define HARD_STACK_LIMIT 0
+#define HAS_SIGALTSTACK 1
+#define SIGNAL_STACK_ENABLED 0
+#define SIGNAL_STACK_SIZE 8192
+#define HAS_VECTORED_EXCEPTION_HANDLER 0
+#define STRCMP_RETURNS_SIGNUM 0
+#define MEMCMP_RETURNS_SIGNUM 0
+#define MEMCMP_WITH_SIZE_0_RETURNS_0 1
+#define HAS_WMEMCMP 1
+#define WMEMCMP_RETURNS_SIGNUM 1
+#define MEMSET_OF_ZERO_BYTES_DOES_NOTHING 1
+#define HAS_WMEMSET 1
+#define HAS_WMEMCHR 1
+#define HAS_WCSNLEN 1
+#define HAS_STRNCASECMP 1
+#define HAS_GETGRGID_R 1
+#define HAS_GETGRGID 1
+#define GROUP_0_NAME "root"
+#define HAS_GETGRNAM_R 1
+#define HAS_GETGRNAM 1
+#define HAS_GETPWUID_R 1
+#define HAS_GETPWUID 1
+#define USER_0_NAME "root"
+#define HAS_GETPWNAM_R 1
+#define HAS_GETPWNAM 1
+#define HAS_SETJMP 1
+#define HAS_SIGSETJMP 1
+#define HAS_SYMBOLIC_LINKS 1
+#define HAS_SYMLINK 1
+#define HAS_READLINK 1
+#define HAS_FIFO_FILES 1
+#define HAS_SELECT 1
+#define HAS_POLL 1
+#define HAS_EPOLL 1
+#define HAS_UCONTEXT 1
+#define HAS_MMAP 1
+#define HAS_POSIX_MADVISE 1
+#define HAS_COPY_FILE_RANGE 1
+#define HAS_SENDFILE 1
+#define HAS_ACCEPT4 1
+#define HAS_FSTATAT 1
+#define HAS_FICLONE 1
+#define HAS_TERMIOS_H
+#define USE_TERMINFO
+#define USE_KBD_POLL
+#define FORWARD_TERM_CALLS 0
+#define X11_XRENDER_INCLUDE "X11/extensions/Xrender.h"
+#define XID_SIZE 64
+#define ATOM_SIZE 64
+#define HAS_XRENDER_EXTENSION
+#define VISUAL_DEPTH_OF_32_BITS_SUPPORTED 0
+#define FORWARD_X11_CALLS 0
+#define POINT_LIST_INT_SIZE 16
+#define POINT_LIST_ABSOLUTE 0
+#define MYSQL_INCLUDE "db_my.h"
+#define MYSQL_DLL "/root/repo/bin/libmariadb.so", "/root/repo/bin/libmariadb.so.3", "/root/repo/bin/libmysqlclient.so", "libmariadb.so", "libmariadb.so.3", "libmysqlclient.so",
+#define SQLITE_INCLUDE "sqlite3.h"
+#define POSTGRESQL_INCLUDE "db_post.h"
+#define ODBC_INCLUDE_WINDOWS_H 0
+#define ODBC_INCLUDE "db_odbc.h"
+#define ODBC_INCLUDE_SQLEXT_H 0
+#define ODBC_DLL "libodbc.so", "libodbc.so.2",
+#define ODBC_SIZEOF_SQLWCHAR 2
+#define OCI_INCLUDE "db_oci.h"
+#define OCI_DLL "libclntsh.so",
+#define FIRE_INCLUDE "db_fire.h"
+#define FIRE_DLL "/root/repo/bin/libfbclient.so", "/root/repo/bin/libfbclient.so.2", "libfbclient.so", "libfbclient.so.2",
+#define DB2_INCLUDE "db_odbc.h"
+#define DB2_INCLUDE_OPTION ""
+#define DB2_SIZEOF_SQLWCHAR 2
+#define DB2_DLL "libdb2.so",
+#define INFORMIX_INCLUDE_WINDOWS_H 0
+#define INFORMIX_INCLUDE "db_odbc.h"
+#define INFORMIX_INCLUDE_SQLEXT_H 0
+#define INFORMIX_INCLUDE_OPTION ""
+#define INFORMIX_DLL "iclit15a.so", "iclit09b.so", "/root/repo/bin/iclit15a.so", "/root/repo/bin/iclit09b.so",
+#define IFGLS_DLL "libifgls.so",
+#define INFORMIX_SIZEOF_SQLWCHAR 2
+#define SQL_SERVER_INCLUDE_WINDOWS_H 0
+#define SQL_SERVER_INCLUDE "db_odbc.h"
+#define SQL_SERVER_INCLUDE_SQLEXT_H 0
+#define SQL_SERVER_INCLUDE_OPTION ""
+#define FREETDS_SQL_SERVER_CONNECTION 1
+#define SPECIFY_SQL_SERVER_PORT_EXPLICIT 1
+#define SQL_SERVER_SIZEOF_SQLWCHAR 2
+#define SQL_SERVER_DLL "libtdsodbc.so", "libtdsodbc.so.0",
+#define TDS_INCLUDE "db_tds.h"
+#define TDS_INCLUDE_SYBFRONT_H 0
+#define TDS_DLL "libsybdb.so", "libsybdb.so.5",
+#define BIG_RTL_LIBRARY 1
+#define BIGINT_LIBRARY BIG_RTL_LIBRARY
+#define INCLUDE_OPTIONS ""
+#define SYSTEM_BIGINT_LIBS ""
+#define SYSTEM_CONSOLE_LIBS "-lncurses"
+#define SYSTEM_DATABASE_LIBS "-ldl\n-lsqlite3\n-lpq"
+#define SYSTEM_DRAW_LIBS "-lX11\n-lXrender"
+#define read_buffer_empty(fp) ((fp)->_IO_read_ptr >= (fp)->_IO_read_end)
+#define read_buffer_ptr(fp) ((const unsigned char *) (fp)->_IO_read_ptr)
+#define read_buffer_avail(fp) ((size_t) ((fp)->_IO_read_end - (fp)->_IO_read_ptr))
+#define read_buffer_skip(fp, n) ((fp)->_IO_read_ptr += (n))
+#define REMOVE_REATTEMPTS 0
+#define FILE_PRESENT_AFTER_DELAY 0
+#define NUMBER_OF_SUCCESSFUL_TESTS_AFTER_RESTART 0
+#define S7_LIB_DIR "/root/repo/bin"
+#define SEED7_LIBRARY "/root/repo/lib"
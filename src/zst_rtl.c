@@ -0,0 +1,1923 @@
+/********************************************************************/
+/*                                                                  */
+/*  zst_rtl.c     Zstandard decompression.                          */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This file is part of the Seed7 Runtime Library.                 */
+/*                                                                  */
+/*  The Seed7 Runtime Library is free software; you can             */
+/*  redistribute it and/or modify it under the terms of the GNU     */
+/*  Lesser General Public License as published by the Free Software */
+/*  Foundation; either version 2.1 of the License, or (at your      */
+/*  option) any later version.                                      */
+/*                                                                  */
+/*  The Seed7 Runtime Library is distributed in the hope that it    */
+/*  will be useful, but WITHOUT ANY WARRANTY; without even the      */
+/*  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR */
+/*  PURPOSE.  See the GNU Lesser General Public License for more    */
+/*  details.                                                        */
+/*                                                                  */
+/*  You should have received a copy of the GNU Lesser General       */
+/*  Public License along with this program; if not, write to the    */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Seed7 Runtime Library                                   */
+/*  File: seed7/src/zst_rtl.c                                       */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: Zstandard decompression (RFC 8878).                    */
+/*                                                                  */
+/*  The state of an incremental decompression is stored in a        */
+/*  bstring. It consists of a header, the entropy tables, which are */
+/*  used in place, and a history buffer. The history buffer holds   */
+/*  the window and room for further blocks. When it is full the     */
+/*  window is moved to its start. A step decodes whole blocks, so   */
+/*  a block must be completely available before it is decoded.      */
+/*                                                                  */
+/********************************************************************/
+
+#define LOG_FUNCTIONS 0
+#define VERBOSE_EXCEPTIONS 0
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+
+#include "common.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "striutl.h"
+#include "rtl_err.h"
+
+#undef EXTERN
+#define EXTERN
+#include "zst_rtl.h"
+
+
+#define ZSTD_MAGIC            0xfd2fb528
+#define SKIPPABLE_MAGIC       0x184d2a50
+#define SKIPPABLE_MASK        0xfffffff0
+#define MAX_BLOCK_SIZE         131072
+#define MIN_WINDOW_SIZE          1024
+#define MAX_WINDOW_LOG             31
+#define MIN_SLIDE_SIZE        1048576
+#define COPY_SLACK                 32
+#define INPUT_SLACK                32
+#define MIN_OUTPUT_CHUNK        65536
+#define BLOCK_HEADER_SIZE           3
+#define CHECKSUM_SIZE               4
+
+#define MAX_LL_CODE                35
+#define MAX_ML_CODE                52
+#define MAX_OF_CODE                31
+#define LL_MAX_LOG                  9
+#define ML_MAX_LOG                  9
+#define OF_MAX_LOG                  8
+#define HUF_MAX_LOG                11
+#define HUF_MAX_SYMBOL            255
+#define WEIGHT_MAX_LOG              6
+#define MAX_FSE_SYMBOLS            53
+
+#define LL_DEFAULT_LOG              6
+#define ML_DEFAULT_LOG              6
+#define OF_DEFAULT_LOG              5
+
+#define BLOCK_RAW                   0
+#define BLOCK_RLE                   1
+#define BLOCK_COMPRESSED            2
+
+#define LITERALS_RAW                0
+#define LITERALS_RLE                1
+#define LITERALS_COMPRESSED         2
+#define LITERALS_TREELESS           3
+
+#define SEQ_PREDEFINED              0
+#define SEQ_RLE                     1
+#define SEQ_FSE_COMPRESSED          2
+#define SEQ_REPEAT                  3
+
+#define MODE_FRAME_HEADER 0
+#define MODE_SKIP_FRAME   1
+#define MODE_BLOCK        2
+#define MODE_CHECKSUM     3
+#define MODE_FINISHED     4
+#define MODE_ERROR        5
+
+#define STATUS_RUNNING      0
+#define STATUS_OUTPUT_FULL  1
+#define STATUS_NEED_INPUT   2
+#define STATUS_FINISHED     3
+#define STATUS_DATA_ERROR   4
+#define STATUS_MEMORY_ERROR 5
+
+#define PRIME64_1 0x9e3779b185ebca87
+#define PRIME64_2 0xc2b2ae3d27d4eb4f
+#define PRIME64_3 0x165667b19e3779f9
+#define PRIME64_4 0x85ebca77c2b2ae63
+#define PRIME64_5 0x27d4eb2f165667c5
+
+static const uint32Type llBase[] = {
+        0,     1,     2,     3,     4,     5,     6,     7,     8,     9,
+       10,    11,    12,    13,    14,    15,    16,    18,    20,    22,
+       24,    28,    32,    40,    48,    64,   128,   256,   512,  1024,
+     2048,  4096,  8192, 16384, 32768, 65536
+  };
+
+static const ucharType llExtraBits[] = {
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     1,  1,  1,  1,  2,  2,  3,  3,  4,  6,  7,  8,  9, 10, 11, 12,
+    13, 14, 15, 16
+  };
+
+static const uint32Type mlBase[] = {
+        3,     4,     5,     6,     7,     8,     9,    10,    11,    12,
+       13,    14,    15,    16,    17,    18,    19,    20,    21,    22,
+       23,    24,    25,    26,    27,    28,    29,    30,    31,    32,
+       33,    34,    35,    37,    39,    41,    43,    47,    51,    59,
+       67,    83,    99,   131,   259,   515,  1027,  2051,  4099,  8195,
+    16387, 32771, 65539
+  };
+
+static const ucharType mlExtraBits[] = {
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     1,  1,  1,  1,  2,  2,  3,  3,  4,  4,  5,  7,  8,  9, 10, 11,
+    12, 13, 14, 15, 16
+  };
+
+static const short llDefaultNorm[] = {
+     4,  3,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  1,  1,  1,
+     2,  2,  2,  2,  2,  2,  2,  2,  2,  3,  2,  1,  1,  1,  1,  1,
+    -1, -1, -1, -1
+  };
+
+static const short mlDefaultNorm[] = {
+     1,  4,  3,  2,  2,  2,  2,  2,  2,  1,  1,  1,  1,  1,  1,  1,
+     1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,
+     1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1, -1, -1,
+    -1, -1, -1, -1, -1
+  };
+
+static const short ofDefaultNorm[] = {
+     1,  1,  1,  1,  1,  1,  2,  2,  2,  1,  1,  1,  1,  1,  1,  1,
+     1,  1,  1,  1,  1,  1,  1,  1, -1, -1, -1, -1, -1
+  };
+
+/* Entry of a decoding table for literal lengths, match lengths and */
+/* offsets. The value of a symbol is baseValue plus the next        */
+/* nbAdditionalBits bits of the bit stream.                         */
+typedef struct {
+    uint16Type nextStateBase;
+    ucharType nbAdditionalBits;
+    ucharType nbBits;
+    uint32Type baseValue;
+  } seqEntryType;
+
+/* Entry of the decoding table used for FSE compressed Huffman weights. */
+typedef struct {
+    uint16Type nextStateBase;
+    ucharType symbol;
+    ucharType nbBits;
+  } fseEntryType;
+
+/* The tables are used in place and contain only 16 and 32-bit values. */
+typedef struct {
+    seqEntryType llTable[1 << LL_MAX_LOG];
+    seqEntryType mlTable[1 << ML_MAX_LOG];
+    seqEntryType ofTable[1 << OF_MAX_LOG];
+    uint16Type hufTable[1 << HUF_MAX_LOG];
+  } zstdTablesRecord, *zstdTablesType;
+
+typedef struct {
+    uint64Type v[4];
+    uint64Type totalLength;
+    ucharType buffer[32];
+    uint32Type bufferSize;
+  } xxh64StateRecord;
+
+typedef struct {
+    uint32Type mode;
+    uint32Type lastBlock;
+    uint32Type hasChecksum;
+    uint32Type hasContentSize;
+    uint32Type llLog;
+    uint32Type mlLog;
+    uint32Type ofLog;
+    uint32Type hufLog;
+    uint32Type repOffset[3];
+    uint32Type skipRemaining;
+    uint32Type skippedFrame;
+    uint64Type contentSize;
+    uint64Type produced;
+    uint64Type windowSize;
+    uint64Type bufferSize;
+    uint64Type bufferPos;
+    xxh64StateRecord xxh64;
+  } zstdStateRecord;
+
+#define STATE_AREA_SIZE  ((sizeof(zstdStateRecord) + 7) & ~(memSizeType) 7)
+#define TABLES_AREA_SIZE ((sizeof(zstdTablesRecord) + 7) & ~(memSizeType) 7)
+#define BUFFER_OFFSET    (STATE_AREA_SIZE + TABLES_AREA_SIZE)
+
+typedef struct {
+    const ucharType *start;
+    const ucharType *ptr;
+    uint64Type container;
+    unsigned int bitsConsumed;
+  } backwardBitsRecord, *backwardBitsType;
+
+typedef struct {
+    zstdStateRecord state;
+    bstriType *stateBstri;
+    zstdTablesType tables;
+    ucharType *buffer;
+    const ucharType *in;
+    memSizeType inLength;
+    memSizeType inPos;
+    boolType inputEnd;
+    ucharType *out;
+    memSizeType outPos;
+    memSizeType outCapacity;
+    memSizeType outTarget;
+    const ucharType *literals;
+    memSizeType numLiterals;
+    ucharType literalBuffer[MAX_BLOCK_SIZE + COPY_SLACK];
+  } zstdWorkRecord, *zstdWorkType;
+
+#define ALLOC_ZSTD_WORK(var) (ALLOC_HEAP(var, zstdWorkType, sizeof(zstdWorkRecord))?CNT(CNT1_BYT(sizeof(zstdWorkRecord))) TRUE:FALSE)
+#define FREE_ZSTD_WORK(var)  (CNT(CNT2_BYT(sizeof(zstdWorkRecord))) FREE_HEAP(var, sizeof(zstdWorkRecord)))
+#define REALLOC_UBYTES(var,byt) REALLOC_HEAP(var, ucharType *, byt)
+#define COUNT3_UBYTES(byt1,byt2) CNT3(CNT2_BYT(byt1), CNT1_BYT(byt2))
+
+
+
+static inline uint32Type loadLittleEndian32 (const ucharType *bytes)
+
+  { /* loadLittleEndian32 */
+    return (uint32Type) bytes[0]       | (uint32Type) bytes[1] <<  8 |
+           (uint32Type) bytes[2] << 16 | (uint32Type) bytes[3] << 24;
+  } /* loadLittleEndian32 */
+
+
+
+static inline uint64Type loadLittleEndian64 (const ucharType *bytes)
+
+  {
+    uint64Type number;
+
+  /* loadLittleEndian64 */
+#if LITTLE_ENDIAN_INTTYPE
+    memcpy(&number, bytes, sizeof(uint64Type));
+#else
+    number = (uint64Type) bytes[0]       | (uint64Type) bytes[1] <<  8 |
+             (uint64Type) bytes[2] << 16 | (uint64Type) bytes[3] << 24 |
+             (uint64Type) bytes[4] << 32 | (uint64Type) bytes[5] << 40 |
+             (uint64Type) bytes[6] << 48 | (uint64Type) bytes[7] << 56;
+#endif
+    return number;
+  } /* loadLittleEndian64 */
+
+
+
+static inline unsigned int highestBit (uint32Type number)
+
+  {
+    unsigned int bit = 0;
+
+  /* highestBit */
+    while (number >>= 1) {
+      bit++;
+    } /* while */
+    return bit;
+  } /* highestBit */
+
+
+
+static striType bytesToStri (const ucharType *bytes, memSizeType length)
+
+  {
+    striType result;
+
+  /* bytesToStri */
+    if (unlikely(!ALLOC_STRI_CHECK_SIZE(result, length))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      result->size = length;
+      memcpy_to_strelem(result->mem, bytes, length);
+    } /* if */
+    return result;
+  } /* bytesToStri */
+
+
+
+static inline uint64Type rotateLeft64 (uint64Type number, unsigned int bits)
+
+  { /* rotateLeft64 */
+    return number << bits | number >> (64 - bits);
+  } /* rotateLeft64 */
+
+
+
+static inline uint64Type xxh64Round (uint64Type accumulator, uint64Type input)
+
+  { /* xxh64Round */
+    accumulator += input * PRIME64_2;
+    accumulator = rotateLeft64(accumulator, 31);
+    return accumulator * PRIME64_1;
+  } /* xxh64Round */
+
+
+
+static void xxh64Init (xxh64StateRecord *xxh64)
+
+  { /* xxh64Init */
+    memset(xxh64, 0, sizeof(xxh64StateRecord));
+    xxh64->v[0] = PRIME64_1 + PRIME64_2;
+    xxh64->v[1] = PRIME64_2;
+    xxh64->v[2] = 0;
+    xxh64->v[3] = 0 - PRIME64_1;
+  } /* xxh64Init */
+
+
+
+static void xxh64Update (xxh64StateRecord *xxh64, const ucharType *data,
+    memSizeType length)
+
+  {
+    memSizeType fill;
+
+  /* xxh64Update */
+    xxh64->totalLength += length;
+    if (xxh64->bufferSize + length < 32) {
+      memcpy(&xxh64->buffer[xxh64->bufferSize], data, length);
+      xxh64->bufferSize += (uint32Type) length;
+    } else {
+      if (xxh64->bufferSize != 0) {
+        fill = 32 - xxh64->bufferSize;
+        memcpy(&xxh64->buffer[xxh64->bufferSize], data, fill);
+        xxh64->v[0] = xxh64Round(xxh64->v[0], loadLittleEndian64(&xxh64->buffer[0]));
+        xxh64->v[1] = xxh64Round(xxh64->v[1], loadLittleEndian64(&xxh64->buffer[8]));
+        xxh64->v[2] = xxh64Round(xxh64->v[2], loadLittleEndian64(&xxh64->buffer[16]));
+        xxh64->v[3] = xxh64Round(xxh64->v[3], loadLittleEndian64(&xxh64->buffer[24]));
+        data += fill;
+        length -= fill;
+        xxh64->bufferSize = 0;
+      } /* if */
+      for (; length >= 32; length -= 32) {
+        xxh64->v[0] = xxh64Round(xxh64->v[0], loadLittleEndian64(&data[0]));
+        xxh64->v[1] = xxh64Round(xxh64->v[1], loadLittleEndian64(&data[8]));
+        xxh64->v[2] = xxh64Round(xxh64->v[2], loadLittleEndian64(&data[16]));
+        xxh64->v[3] = xxh64Round(xxh64->v[3], loadLittleEndian64(&data[24]));
+        data += 32;
+      } /* for */
+      memcpy(xxh64->buffer, data, length);
+      xxh64->bufferSize = (uint32Type) length;
+    } /* if */
+  } /* xxh64Update */
+
+
+
+static uint64Type xxh64Digest (const xxh64StateRecord *xxh64)
+
+  {
+    uint64Type hash;
+    unsigned int index;
+    const ucharType *data;
+    unsigned int length;
+
+  /* xxh64Digest */
+    if (xxh64->totalLength >= 32) {
+      hash = rotateLeft64(xxh64->v[0], 1) + rotateLeft64(xxh64->v[1], 7) +
+             rotateLeft64(xxh64->v[2], 12) + rotateLeft64(xxh64->v[3], 18);
+      for (index = 0; index < 4; index++) {
+        hash ^= xxh64Round(0, xxh64->v[index]);
+        hash = hash * PRIME64_1 + PRIME64_4;
+      } /* for */
+    } else {
+      hash = PRIME64_5;
+    } /* if */
+    hash += xxh64->totalLength;
+    data = xxh64->buffer;
+    length = xxh64->bufferSize;
+    for (; length >= 8; length -= 8) {
+      hash ^= xxh64Round(0, loadLittleEndian64(data));
+      hash = rotateLeft64(hash, 27) * PRIME64_1 + PRIME64_4;
+      data += 8;
+    } /* for */
+    if (length >= 4) {
+      hash ^= (uint64Type) loadLittleEndian32(data) * PRIME64_1;
+      hash = rotateLeft64(hash, 23) * PRIME64_2 + PRIME64_3;
+      data += 4;
+      length -= 4;
+    } /* if */
+    for (; length != 0; length--) {
+      hash ^= *data * PRIME64_5;
+      hash = rotateLeft64(hash, 11) * PRIME64_1;
+      data++;
+    } /* for */
+    hash ^= hash >> 33;
+    hash *= PRIME64_2;
+    hash ^= hash >> 29;
+    hash *= PRIME64_3;
+    hash ^= hash >> 32;
+    return hash;
+  } /* xxh64Digest */
+
+
+
+/**
+ *  Initialize a reader for a bit stream that is read backwards.
+ *  The last byte of the stream contains a 1 bit that marks the start.
+ *  @return TRUE if the stream is not empty and has a start marker,
+ *          FALSE otherwise.
+ */
+static boolType initBackwardBits (backwardBitsType bits,
+    const ucharType *start, memSizeType size)
+
+  {
+    unsigned int index;
+    boolType okay = TRUE;
+
+  /* initBackwardBits */
+    if (unlikely(size == 0 || start[size - 1] == 0)) {
+      okay = FALSE;
+    } else {
+      bits->start = start;
+      if (size >= 8) {
+        bits->ptr = &start[size - 8];
+        bits->container = loadLittleEndian64(bits->ptr);
+        bits->bitsConsumed = 0;
+      } else {
+        bits->ptr = start;
+        bits->container = 0;
+        for (index = 0; index < size; index++) {
+          bits->container |= (uint64Type) start[index] << (8 * index);
+        } /* for */
+        bits->bitsConsumed = (unsigned int) (8 - size) * 8;
+      } /* if */
+      bits->bitsConsumed += 8 - highestBit(start[size - 1]);
+    } /* if */
+    return okay;
+  } /* initBackwardBits */
+
+
+
+static inline uint32Type peekBits (const backwardBitsRecord *bits,
+    unsigned int numBits)
+
+  { /* peekBits */
+    return (uint32Type) (((bits->container << (bits->bitsConsumed & 63)) >> 1) >>
+                         ((63 - numBits) & 63));
+  } /* peekBits */
+
+
+
+static inline uint32Type readBits (backwardBitsType bits, unsigned int numBits)
+
+  {
+    uint32Type value;
+
+  /* readBits */
+    value = peekBits(bits, numBits);
+    bits->bitsConsumed += numBits;
+    return value;
+  } /* readBits */
+
+
+
+/**
+ *  Refill the container of 'bits'. Afterwards at least 57 bits can
+ *  be read, unless the start of the stream is reached.
+ */
+static inline void reloadBits (backwardBitsType bits)
+
+  {
+    memSizeType numBytes;
+
+  /* reloadBits */
+    if (bits->bitsConsumed <= 64) {
+      if (bits->ptr >= bits->start + 8) {
+        bits->ptr -= bits->bitsConsumed >> 3;
+        bits->bitsConsumed &= 7;
+        bits->container = loadLittleEndian64(bits->ptr);
+      } else if (bits->ptr != bits->start) {
+        numBytes = bits->bitsConsumed >> 3;
+        if (numBytes > (memSizeType) (bits->ptr - bits->start)) {
+          numBytes = (memSizeType) (bits->ptr - bits->start);
+        } /* if */
+        bits->ptr -= numBytes;
+        bits->bitsConsumed -= (unsigned int) numBytes * 8;
+        bits->container = loadLittleEndian64(bits->ptr);
+      } /* if */
+    } /* if */
+  } /* reloadBits */
+
+
+
+static inline boolType backwardBitsFinished (const backwardBitsRecord *bits)
+
+  { /* backwardBitsFinished */
+    return bits->ptr == bits->start && bits->bitsConsumed == 64;
+  } /* backwardBitsFinished */
+
+
+
+/**
+ *  Read the normalized probabilities of an FSE table description.
+ *  @param maxSymbol Number of the highest symbol that is allowed.
+ *  @return the number of bytes used by the description, or 0 if
+ *          the description is illegal.
+ */
+static memSizeType readFseDescription (const ucharType *data,
+    memSizeType size, short *norm, unsigned int maxSymbol,
+    unsigned int maxLog, unsigned int *tableLog, unsigned int *numSymbols)
+
+  {
+    uint64Type bitPos = 0;
+    uint64Type bitLimit;
+    int remaining;
+    unsigned int symbol = 0;
+    unsigned int numBits;
+    uint32Type value;
+    uint32Type lowerMask;
+    uint32Type threshold;
+    int probability;
+    unsigned int repeat;
+    unsigned int index;
+    boolType okay = TRUE;
+
+  /* readFseDescription */
+    bitLimit = (uint64Type) size * 8;
+#define GET_BITS(n) (value = 0, okay = okay && bitPos + (n) <= bitLimit, \
+    okay ? (value = (uint32Type) ((loadLittleEndian32(&data[bitPos >> 3]) >> \
+                                   (bitPos & 7)) & ((1U << (n)) - 1)), \
+            bitPos += (n), value) : 0)
+    /* The input has INPUT_SLACK bytes after its end, so 4 bytes can */
+    /* always be loaded. The bound check above prevents using them.  */
+    *tableLog = GET_BITS(4) + 5;
+    if (*tableLog > maxLog) {
+      okay = FALSE;
+    } /* if */
+    remaining = 1 << *tableLog;
+    while (okay && remaining > 0) {
+      if (symbol > maxSymbol) {
+        okay = FALSE;
+      } else {
+        numBits = highestBit((uint32Type) remaining + 1) + 1;
+        value = GET_BITS(numBits);
+        lowerMask = (1U << (numBits - 1)) - 1;
+        threshold = (1U << numBits) - 1 - ((uint32Type) remaining + 1);
+        if ((value & lowerMask) < threshold) {
+          bitPos--;
+          value &= lowerMask;
+        } else if (value > lowerMask) {
+          value -= threshold;
+        } /* if */
+        probability = (int) value - 1;
+        remaining -= probability < 0 ? -probability : probability;
+        norm[symbol] = (short) probability;
+        symbol++;
+        if (probability == 0) {
+          do {
+            repeat = GET_BITS(2);
+            for (index = 0; index < repeat && okay; index++) {
+              if (symbol > maxSymbol) {
+                okay = FALSE;
+              } else {
+                norm[symbol] = 0;
+                symbol++;
+              } /* if */
+            } /* for */
+          } while (repeat == 3 && okay);
+        } /* if */
+      } /* if */
+    } /* while */
+#undef GET_BITS
+    if (!okay || remaining != 0) {
+      return 0;
+    } else {
+      *numSymbols = symbol;
+      return (memSizeType) ((bitPos + 7) >> 3);
+    } /* if */
+  } /* readFseDescription */
+
+
+
+/**
+ *  Distribute the symbols of an FSE table over its states.
+ *  The symbols with a probability of less than one are put at
+ *  the end of the table. For every state the number of the
+ *  next occurrence of its symbol is stored in 'nextOccurrence'.
+ *  @return TRUE if the probabilities are consistent, FALSE otherwise.
+ */
+static boolType spreadSymbols (const short *norm, unsigned int numSymbols,
+    unsigned int tableLog, ucharType *symbols, uint16Type *nextOccurrence)
+
+  {
+    uint32Type tableSize;
+    uint32Type highThreshold;
+    uint32Type step;
+    uint32Type mask;
+    uint32Type position = 0;
+    uint16Type symbolNext[MAX_FSE_SYMBOLS > 256 ? MAX_FSE_SYMBOLS : 256];
+    unsigned int symbol;
+    int index;
+
+  /* spreadSymbols */
+    tableSize = (uint32Type) 1 << tableLog;
+    highThreshold = tableSize;
+    for (symbol = 0; symbol < numSymbols; symbol++) {
+      if (norm[symbol] == -1) {
+        highThreshold--;
+        symbols[highThreshold] = (ucharType) symbol;
+        symbolNext[symbol] = 1;
+      } else {
+        symbolNext[symbol] = (uint16Type) norm[symbol];
+      } /* if */
+    } /* for */
+    step = (tableSize >> 1) + (tableSize >> 3) + 3;
+    mask = tableSize - 1;
+    for (symbol = 0; symbol < numSymbols; symbol++) {
+      for (index = 0; index < norm[symbol]; index++) {
+        symbols[position] = (ucharType) symbol;
+        do {
+          position = (position + step) & mask;
+        } while (position >= highThreshold);
+      } /* for */
+    } /* for */
+    if (position == 0) {
+      for (position = 0; position < tableSize; position++) {
+        nextOccurrence[position] = symbolNext[symbols[position]]++;
+      } /* for */
+    } /* if */
+    return position == tableSize;
+  } /* spreadSymbols */
+
+
+
+static boolType buildSeqTable (seqEntryType *table, const short *norm,
+    unsigned int numSymbols, unsigned int tableLog,
+    const uint32Type *baseValues, const ucharType *extraBits)
+
+  {
+    ucharType symbols[1 << LL_MAX_LOG];
+    uint16Type nextOccurrence[1 << LL_MAX_LOG];
+    uint32Type tableSize;
+    uint32Type position;
+    unsigned int symbol;
+    unsigned int nbBits;
+    boolType okay;
+
+  /* buildSeqTable */
+    tableSize = (uint32Type) 1 << tableLog;
+    okay = spreadSymbols(norm, numSymbols, tableLog, symbols, nextOccurrence);
+    if (okay) {
+      for (position = 0; position < tableSize; position++) {
+        symbol = symbols[position];
+        nbBits = tableLog - highestBit(nextOccurrence[position]);
+        table[position].nbBits = (ucharType) nbBits;
+        table[position].nextStateBase =
+            (uint16Type) (((uint32Type) nextOccurrence[position] << nbBits) - tableSize);
+        if (baseValues == NULL) {
+          /* Offset codes: The value is 2 ** code plus code extra bits. */
+          table[position].nbAdditionalBits = (ucharType) symbol;
+          table[position].baseValue = (uint32Type) 1 << symbol;
+        } else {
+          table[position].nbAdditionalBits = extraBits[symbol];
+          table[position].baseValue = baseValues[symbol];
+        } /* if */
+      } /* for */
+    } /* if */
+    return okay;
+  } /* buildSeqTable */
+
+
+
+static void buildRleSeqTable (seqEntryType *table, unsigned int symbol,
+    const uint32Type *baseValues, const ucharType *extraBits)
+
+  { /* buildRleSeqTable */
+    table[0].nextStateBase = 0;
+    table[0].nbBits = 0;
+    if (baseValues == NULL) {
+      table[0].nbAdditionalBits = (ucharType) symbol;
+      table[0].baseValue = (uint32Type) 1 << symbol;
+    } else {
+      table[0].nbAdditionalBits = extraBits[symbol];
+      table[0].baseValue = baseValues[symbol];
+    } /* if */
+  } /* buildRleSeqTable */
+
+
+
+/**
+ *  Decode the FSE compressed Huffman weights at 'data'.
+ *  @return the number of weights, or 0 if the data is illegal.
+ */
+static unsigned int decodeFseWeights (const ucharType *data,
+    memSizeType size, ucharType *weights)
+
+  {
+    short norm[HUF_MAX_SYMBOL + 1];
+    ucharType symbols[1 << WEIGHT_MAX_LOG];
+    uint16Type nextOccurrence[1 << WEIGHT_MAX_LOG];
+    fseEntryType table[1 << WEIGHT_MAX_LOG];
+    unsigned int tableLog;
+    unsigned int numSymbols;
+    memSizeType headerSize;
+    uint32Type position;
+    uint32Type tableSize;
+    unsigned int nbBits;
+    backwardBitsRecord bits;
+    uint32Type state1;
+    uint32Type state2;
+    unsigned int numWeights = 0;
+    boolType done = FALSE;
+
+  /* decodeFseWeights */
+    headerSize = readFseDescription(data, size, norm, HUF_MAX_SYMBOL,
+                                    WEIGHT_MAX_LOG, &tableLog, &numSymbols);
+    if (headerSize != 0 && headerSize < size &&
+        spreadSymbols(norm, numSymbols, tableLog, symbols, nextOccurrence) &&
+        initBackwardBits(&bits, &data[headerSize], size - headerSize)) {
+      tableSize = (uint32Type) 1 << tableLog;
+      for (position = 0; position < tableSize; position++) {
+        nbBits = tableLog - highestBit(nextOccurrence[position]);
+        table[position].symbol = symbols[position];
+        table[position].nbBits = (ucharType) nbBits;
+        table[position].nextStateBase =
+            (uint16Type) (((uint32Type) nextOccurrence[position] << nbBits) - tableSize);
+      } /* for */
+      state1 = readBits(&bits, tableLog);
+      state2 = readBits(&bits, tableLog);
+      reloadBits(&bits);
+      /* The stream is finished when more bits than available are read. */
+      while (!done && numWeights < HUF_MAX_SYMBOL - 1) {
+        weights[numWeights++] = table[state1].symbol;
+        state1 = table[state1].nextStateBase +
+                 readBits(&bits, table[state1].nbBits);
+        reloadBits(&bits);
+        if (bits.bitsConsumed > 64) {
+          weights[numWeights++] = table[state2].symbol;
+          done = TRUE;
+        } else {
+          weights[numWeights++] = table[state2].symbol;
+          state2 = table[state2].nextStateBase +
+                   readBits(&bits, table[state2].nbBits);
+          reloadBits(&bits);
+          if (bits.bitsConsumed > 64) {
+            weights[numWeights++] = table[state1].symbol;
+            done = TRUE;
+          } /* if */
+        } /* if */
+      } /* while */
+      if (!done) {
+        numWeights = 0;
+      } /* if */
+    } /* if */
+    return numWeights;
+  } /* decodeFseWeights */
+
+
+
+/**
+ *  Read a Huffman tree description and build the decoding table.
+ *  @return the number of bytes used by the description, or 0 if
+ *          the description is illegal.
+ */
+static memSizeType readHuffmanTree (zstdWorkType work,
+    const ucharType *data, memSizeType size)
+
+  {
+    ucharType weights[HUF_MAX_SYMBOL + 1];
+    unsigned int numWeights;
+    unsigned int index;
+    memSizeType treeSize;
+    uint32Type weightSum = 0;
+    uint32Type leftOver;
+    unsigned int maxBits;
+    unsigned int lastWeight;
+    uint32Type rankStart[HUF_MAX_LOG + 2];
+    uint32Type rankCount[HUF_MAX_LOG + 2];
+    unsigned int nbBits;
+    uint32Type code;
+    uint32Type length;
+    uint32Type pos;
+    uint16Type *table;
+
+  /* readHuffmanTree */
+    if (size == 0) {
+      return 0;
+    } else if (data[0] < 128) {
+      treeSize = (memSizeType) data[0] + 1;
+      if (treeSize > size) {
+        return 0;
+      } /* if */
+      numWeights = decodeFseWeights(&data[1], treeSize - 1, weights);
+    } else {
+      numWeights = (unsigned int) data[0] - 127;
+      treeSize = (memSizeType) (numWeights + 1) / 2 + 1;
+      if (treeSize > size) {
+        return 0;
+      } /* if */
+      for (index = 0; index < numWeights; index++) {
+        weights[index] = (ucharType) ((index & 1) ? data[1 + index / 2] & 15 :
+                                                    data[1 + index / 2] >> 4);
+      } /* for */
+    } /* if */
+    if (numWeights == 0 || numWeights > HUF_MAX_SYMBOL) {
+      return 0;
+    } /* if */
+    for (index = 0; index < numWeights; index++) {
+      if (weights[index] > HUF_MAX_LOG) {
+        return 0;
+      } else if (weights[index] != 0) {
+        weightSum += (uint32Type) 1 << (weights[index] - 1);
+      } /* if */
+    } /* for */
+    if (weightSum == 0) {
+      return 0;
+    } /* if */
+    maxBits = highestBit(weightSum) + 1;
+    leftOver = ((uint32Type) 1 << maxBits) - weightSum;
+    if (maxBits > HUF_MAX_LOG || (leftOver & (leftOver - 1)) != 0) {
+      return 0;
+    } /* if */
+    lastWeight = highestBit(leftOver) + 1;
+    weights[numWeights] = (ucharType) lastWeight;
+    numWeights++;
+    memset(rankCount, 0, sizeof(rankCount));
+    for (index = 0; index < numWeights; index++) {
+      if (weights[index] != 0) {
+        rankCount[maxBits + 1 - weights[index]]++;
+      } /* if */
+    } /* for */
+    /* Codes are assigned from the longest to the shortest ones. */
+    rankStart[maxBits] = 0;
+    for (nbBits = maxBits; nbBits >= 1; nbBits--) {
+      rankStart[nbBits - 1] = rankStart[nbBits] +
+                              rankCount[nbBits] * ((uint32Type) 1 << (maxBits - nbBits));
+    } /* for */
+    if (rankStart[0] != (uint32Type) 1 << maxBits) {
+      return 0;
+    } /* if */
+    table = work->tables->hufTable;
+    for (index = 0; index < numWeights; index++) {
+      if (weights[index] != 0) {
+        nbBits = maxBits + 1 - weights[index];
+        code = rankStart[nbBits];
+        length = (uint32Type) 1 << (maxBits - nbBits);
+        for (pos = code; pos < code + length; pos++) {
+          table[pos] = (uint16Type) (index | nbBits << 8);
+        } /* for */
+        rankStart[nbBits] += length;
+      } /* if */
+    } /* for */
+    work->state.hufLog = maxBits;
+    return treeSize;
+  } /* readHuffmanTree */
+
+
+
+/**
+ *  Decode a Huffman coded stream of literals. Five symbols can be
+ *  decoded between two reloads, since a code has at most 11 bits.
+ *  @return TRUE if the stream has been decoded completely,
+ *          FALSE if it is illegal.
+ */
+static boolType decodeHuffmanStream (zstdWorkType work,
+    const ucharType *data, memSizeType size, ucharType *dest,
+    memSizeType length)
+
+  {
+    backwardBitsRecord bits;
+    const uint16Type *table;
+    unsigned int maxBits;
+    uint16Type entry;
+    ucharType *end;
+
+  /* decodeHuffmanStream */
+    if (!initBackwardBits(&bits, data, size)) {
+      return FALSE;
+    } else {
+      table = work->tables->hufTable;
+      maxBits = work->state.hufLog;
+      end = dest + length;
+      reloadBits(&bits);
+#define DECODE_SYMBOL entry = table[peekBits(&bits, maxBits)]; \
+                      bits.bitsConsumed += entry >> 8; \
+                      *dest++ = (ucharType) entry;
+      while (end - dest >= 5) {
+        DECODE_SYMBOL
+        DECODE_SYMBOL
+        DECODE_SYMBOL
+        DECODE_SYMBOL
+        DECODE_SYMBOL
+        reloadBits(&bits);
+      } /* while */
+      while (dest < end) {
+        DECODE_SYMBOL
+      } /* while */
+#undef DECODE_SYMBOL
+      reloadBits(&bits);
+      return backwardBitsFinished(&bits);
+    } /* if */
+  } /* decodeHuffmanStream */
+
+
+
+/**
+ *  Read the literals section of a compressed block.
+ *  @return the size of the literals section, or 0 if it is illegal.
+ */
+static memSizeType readLiteralsSection (zstdWorkType work,
+    const ucharType *data, memSizeType size)
+
+  {
+    unsigned int literalsType;
+    unsigned int sizeFormat;
+    memSizeType headerSize;
+    memSizeType regeneratedSize;
+    memSizeType compressedSize = 0;
+    boolType fourStreams = FALSE;
+    memSizeType treeSize = 0;
+    const ucharType *streams;
+    memSizeType streamsSize;
+    memSizeType segment;
+    memSizeType streamSize[4];
+    memSizeType streamPos;
+    unsigned int index;
+
+  /* readLiteralsSection */
+    literalsType = data[0] & 3;
+    sizeFormat = (data[0] >> 2) & 3;
+    if (literalsType == LITERALS_RAW || literalsType == LITERALS_RLE) {
+      switch (sizeFormat) {
+        case 0: case 2:
+          headerSize = 1;
+          regeneratedSize = data[0] >> 3;
+          break;
+        case 1:
+          headerSize = 2;
+          regeneratedSize = (data[0] >> 4) + ((memSizeType) data[1] << 4);
+          break;
+        default:
+          headerSize = 3;
+          regeneratedSize = (data[0] >> 4) + ((memSizeType) data[1] << 4) +
+                            ((memSizeType) data[2] << 12);
+          break;
+      } /* switch */
+      if (headerSize > size || regeneratedSize > MAX_BLOCK_SIZE) {
+        return 0;
+      } else if (literalsType == LITERALS_RAW) {
+        if (regeneratedSize > size - headerSize) {
+          return 0;
+        } /* if */
+        /* Raw literals are used directly from the input. */
+        work->literals = &data[headerSize];
+        work->numLiterals = regeneratedSize;
+        return headerSize + regeneratedSize;
+      } else {
+        if (headerSize + 1 > size) {
+          return 0;
+        } /* if */
+        memset(work->literalBuffer, data[headerSize], regeneratedSize);
+        work->literals = work->literalBuffer;
+        work->numLiterals = regeneratedSize;
+        return headerSize + 1;
+      } /* if */
+    } else {
+      switch (sizeFormat) {
+        case 0: case 1:
+          headerSize = 3;
+          fourStreams = sizeFormat == 1;
+          if (headerSize <= size) {
+            regeneratedSize = (loadLittleEndian32(data) >> 4) & 0x3ff;
+            compressedSize = (loadLittleEndian32(data) >> 14) & 0x3ff;
+          } /* if */
+          break;
+        case 2:
+          headerSize = 4;
+          fourStreams = TRUE;
+          if (headerSize <= size) {
+            regeneratedSize = (loadLittleEndian32(data) >> 4) & 0x3fff;
+            compressedSize = loadLittleEndian32(data) >> 18;
+          } /* if */
+          break;
+        default:
+          headerSize = 5;
+          fourStreams = TRUE;
+          if (headerSize <= size) {
+            regeneratedSize = (loadLittleEndian32(data) >> 4) & 0x3ffff;
+            compressedSize = (loadLittleEndian32(data) >> 22) +
+                             ((memSizeType) data[4] << 10);
+          } /* if */
+          break;
+      } /* switch */
+      if (headerSize > size || compressedSize > size - headerSize ||
+          regeneratedSize > MAX_BLOCK_SIZE || regeneratedSize == 0) {
+        return 0;
+      } /* if */
+      streams = &data[headerSize];
+      streamsSize = compressedSize;
+      if (literalsType == LITERALS_COMPRESSED) {
+        treeSize = readHuffmanTree(work, streams, streamsSize);
+        if (treeSize == 0) {
+          return 0;
+        } /* if */
+        streams += treeSize;
+        streamsSize -= treeSize;
+      } else if (work->state.hufLog == 0) {
+        /* Treeless literals need the Huffman tree of a previous block. */
+        return 0;
+      } /* if */
+      if (!fourStreams) {
+        if (!decodeHuffmanStream(work, streams, streamsSize,
+                                 work->literalBuffer, regeneratedSize)) {
+          return 0;
+        } /* if */
+      } else {
+        if (streamsSize < 10 || regeneratedSize < 4) {
+          return 0;
+        } /* if */
+        streamSize[0] = (memSizeType) streams[0] | (memSizeType) streams[1] << 8;
+        streamSize[1] = (memSizeType) streams[2] | (memSizeType) streams[3] << 8;
+        streamSize[2] = (memSizeType) streams[4] | (memSizeType) streams[5] << 8;
+        if (streamSize[0] + streamSize[1] + streamSize[2] > streamsSize - 6) {
+          return 0;
+        } /* if */
+        streamSize[3] = streamsSize - 6 - streamSize[0] - streamSize[1] - streamSize[2];
+        segment = (regeneratedSize + 3) / 4;
+        if (3 * segment > regeneratedSize) {
+          return 0;
+        } /* if */
+        streamPos = 6;
+        for (index = 0; index < 4; index++) {
+          if (!decodeHuffmanStream(work, &streams[streamPos], streamSize[index],
+                                   &work->literalBuffer[segment * index],
+                                   index == 3 ? regeneratedSize - 3 * segment : segment)) {
+            return 0;
+          } /* if */
+          streamPos += streamSize[index];
+        } /* for */
+      } /* if */
+      work->literals = work->literalBuffer;
+      work->numLiterals = regeneratedSize;
+      return headerSize + compressedSize;
+    } /* if */
+  } /* readLiteralsSection */
+
+
+
+/**
+ *  Set up the decoding table for literal lengths, offsets or match
+ *  lengths according to its compression mode.
+ *  @return the number of bytes used by the table description, or
+ *          -1 if the description is illegal.
+ */
+static long setupSeqTable (seqEntryType *table, uint32Type *tableLog,
+    unsigned int mode, const ucharType *data, memSizeType size,
+    unsigned int maxSymbol, unsigned int maxLog, const short *defaultNorm,
+    unsigned int defaultNumSymbols, unsigned int defaultLog,
+    const uint32Type *baseValues, const ucharType *extraBits)
+
+  {
+    short norm[MAX_FSE_SYMBOLS];
+    unsigned int numSymbols;
+    unsigned int log;
+    memSizeType used;
+    long result = -1;
+
+  /* setupSeqTable */
+    switch (mode) {
+      case SEQ_PREDEFINED:
+        if (buildSeqTable(table, defaultNorm, defaultNumSymbols, defaultLog,
+                          baseValues, extraBits)) {
+          *tableLog = defaultLog;
+          result = 0;
+        } /* if */
+        break;
+      case SEQ_RLE:
+        if (size >= 1 && data[0] <= maxSymbol) {
+          buildRleSeqTable(table, data[0], baseValues, extraBits);
+          *tableLog = 0;
+          result = 1;
+        } /* if */
+        break;
+      case SEQ_FSE_COMPRESSED:
+        used = readFseDescription(data, size, norm, maxSymbol, maxLog,
+                                  &log, &numSymbols);
+        if (used != 0 && used <= size &&
+            buildSeqTable(table, norm, numSymbols, log, baseValues, extraBits)) {
+          *tableLog = log;
+          result = (long) used;
+        } /* if */
+        break;
+      default:
+        /* Repeat mode: The table of the previous block is used. */
+        if (*tableLog != (uint32Type) -1) {
+          result = 0;
+        } /* if */
+        break;
+    } /* switch */
+    return result;
+  } /* setupSeqTable */
+
+
+
+static inline void copyBytes (ucharType *dest, const ucharType *source,
+    memSizeType length)
+
+  {
+    ucharType *end;
+
+  /* copyBytes */
+    end = dest + length;
+    do {
+      memcpy(dest, source, 16);
+      dest += 16;
+      source += 16;
+    } while (dest < end);
+  } /* copyBytes */
+
+
+
+/**
+ *  Copy a match with the distance 'offset' to 'dest'. Overlapping
+ *  matches with an offset below 8 are copied byte by byte.
+ *  Up to COPY_SLACK bytes after the match may be overwritten.
+ */
+static inline void copyMatch (ucharType *dest, memSizeType offset,
+    memSizeType length)
+
+  {
+    const ucharType *source;
+    ucharType *end;
+
+  /* copyMatch */
+    source = dest - offset;
+    end = dest + length;
+    if (offset >= 16) {
+      copyBytes(dest, source, length);
+    } else if (offset >= 8) {
+      do {
+        memcpy(dest, source, 8);
+        dest += 8;
+        source += 8;
+      } while (dest < end);
+    } else if (offset == 1) {
+      memset(dest, *source, length);
+    } else {
+      while (dest < end) {
+        *dest++ = *source++;
+      } /* while */
+    } /* if */
+  } /* copyMatch */
+
+
+
+/**
+ *  Decode and execute the sequences section of a compressed block.
+ *  The result is written to the history buffer at 'bufferPos'.
+ *  @return the number of bytes produced, or -1 if the data is illegal.
+ */
+static long executeSequences (zstdWorkType work, const ucharType *data,
+    memSizeType size)
+
+  {
+    memSizeType numSequences;
+    memSizeType headerSize;
+    unsigned int modes;
+    long used;
+    const ucharType *pos;
+    const ucharType *end;
+    backwardBitsRecord bits;
+    const seqEntryType *llTable;
+    const seqEntryType *mlTable;
+    const seqEntryType *ofTable;
+    uint32Type llState;
+    uint32Type mlState;
+    uint32Type ofState;
+    seqEntryType llEntry;
+    seqEntryType mlEntry;
+    seqEntryType ofEntry;
+    uint32Type literalLength;
+    uint32Type matchLength;
+    uint32Type offsetValue;
+    uint32Type offset;
+    uint32Type rep0;
+    uint32Type rep1;
+    uint32Type rep2;
+    unsigned int repIndex;
+    ucharType *bufferStart;
+    ucharType *dest;
+    ucharType *destLimit;
+    const ucharType *literals;
+    const ucharType *literalsEnd;
+    memSizeType count;
+
+  /* executeSequences */
+    if (size == 0) {
+      return -1;
+    } else if (data[0] < 128) {
+      numSequences = data[0];
+      headerSize = 1;
+    } else if (data[0] < 255) {
+      numSequences = (((memSizeType) data[0] - 128) << 8) + (memSizeType) data[1];
+      headerSize = 2;
+    } else {
+      numSequences = (memSizeType) data[1] + ((memSizeType) data[2] << 8) + 0x7f00;
+      headerSize = 3;
+    } /* if */
+    if (headerSize > size) {
+      return -1;
+    } /* if */
+    bufferStart = work->buffer;
+    dest = &bufferStart[work->state.bufferPos];
+    destLimit = dest + MAX_BLOCK_SIZE;
+    literals = work->literals;
+    literalsEnd = literals + work->numLiterals;
+    if (numSequences != 0) {
+      if (headerSize + 1 > size) {
+        return -1;
+      } /* if */
+      modes = data[headerSize];
+      if ((modes & 3) != 0) {
+        return -1;
+      } /* if */
+      pos = &data[headerSize + 1];
+      end = &data[size];
+      used = setupSeqTable(work->tables->llTable, &work->state.llLog,
+                           modes >> 6, pos, (memSizeType) (end - pos),
+                           MAX_LL_CODE, LL_MAX_LOG, llDefaultNorm,
+                           MAX_LL_CODE + 1, LL_DEFAULT_LOG, llBase, llExtraBits);
+      if (used < 0) {
+        return -1;
+      } /* if */
+      pos += used;
+      used = setupSeqTable(work->tables->ofTable, &work->state.ofLog,
+                           (modes >> 4) & 3, pos, (memSizeType) (end - pos),
+                           MAX_OF_CODE, OF_MAX_LOG, ofDefaultNorm,
+                           29, OF_DEFAULT_LOG, NULL, NULL);
+      if (used < 0) {
+        return -1;
+      } /* if */
+      pos += used;
+      used = setupSeqTable(work->tables->mlTable, &work->state.mlLog,
+                           (modes >> 2) & 3, pos, (memSizeType) (end - pos),
+                           MAX_ML_CODE, ML_MAX_LOG, mlDefaultNorm,
+                           MAX_ML_CODE + 1, ML_DEFAULT_LOG, mlBase, mlExtraBits);
+      if (used < 0) {
+        return -1;
+      } /* if */
+      pos += used;
+      if (!initBackwardBits(&bits, pos, (memSizeType) (end - pos))) {
+        return -1;
+      } /* if */
+      llTable = work->tables->llTable;
+      mlTable = work->tables->mlTable;
+      ofTable = work->tables->ofTable;
+      reloadBits(&bits);
+      llState = readBits(&bits, work->state.llLog);
+      ofState = readBits(&bits, work->state.ofLog);
+      mlState = readBits(&bits, work->state.mlLog);
+      rep0 = work->state.repOffset[0];
+      rep1 = work->state.repOffset[1];
+      rep2 = work->state.repOffset[2];
+      for (; numSequences != 0; numSequences--) {
+        reloadBits(&bits);
+        llEntry = llTable[llState];
+        mlEntry = mlTable[mlState];
+        ofEntry = ofTable[ofState];
+        offsetValue = ofEntry.baseValue + readBits(&bits, ofEntry.nbAdditionalBits);
+        reloadBits(&bits);
+        matchLength = mlEntry.baseValue + readBits(&bits, mlEntry.nbAdditionalBits);
+        literalLength = llEntry.baseValue + readBits(&bits, llEntry.nbAdditionalBits);
+        if (offsetValue > 3) {
+          offset = offsetValue - 3;
+          rep2 = rep1;
+          rep1 = rep0;
+          rep0 = offset;
+        } else {
+          repIndex = offsetValue - 1 + (literalLength == 0);
+          if (repIndex == 0) {
+            offset = rep0;
+          } else {
+            if (repIndex == 1) {
+              offset = rep1;
+            } else {
+              offset = repIndex == 2 ? rep2 : rep0 - 1;
+              rep2 = rep1;
+            } /* if */
+            rep1 = rep0;
+            rep0 = offset;
+          } /* if */
+        } /* if */
+        if (numSequences != 1) {
+          reloadBits(&bits);
+          llState = llEntry.nextStateBase + readBits(&bits, llEntry.nbBits);
+          mlState = mlEntry.nextStateBase + readBits(&bits, mlEntry.nbBits);
+          ofState = ofEntry.nextStateBase + readBits(&bits, ofEntry.nbBits);
+        } /* if */
+        if (unlikely(literalLength > (memSizeType) (literalsEnd - literals) ||
+                     literalLength + matchLength > (memSizeType) (destLimit - dest) ||
+                     offset == 0 ||
+                     offset > (memSizeType) (dest - bufferStart) + literalLength)) {
+          return -1;
+        } /* if */
+        if (literalLength != 0) {
+          copyBytes(dest, literals, literalLength);
+          dest += literalLength;
+          literals += literalLength;
+        } /* if */
+        copyMatch(dest, offset, matchLength);
+        dest += matchLength;
+      } /* for */
+      reloadBits(&bits);
+      if (!backwardBitsFinished(&bits)) {
+        return -1;
+      } /* if */
+      work->state.repOffset[0] = rep0;
+      work->state.repOffset[1] = rep1;
+      work->state.repOffset[2] = rep2;
+    } else if (headerSize != size) {
+      return -1;
+    } /* if */
+    count = (memSizeType) (literalsEnd - literals);
+    if (count > (memSizeType) (destLimit - dest)) {
+      return -1;
+    } /* if */
+    memcpy(dest, literals, count);
+    dest += count;
+    return (long) (dest - &bufferStart[work->state.bufferPos]);
+  } /* executeSequences */
+
+
+
+/**
+ *  Make sure that 'size' bytes can be stored in the state bstring.
+ *  The pointers of 'work' are updated afterwards.
+ *  @return TRUE if the state has the requested size, FALSE if there
+ *          is not enough memory.
+ */
+static boolType resizeState (zstdWorkType work, memSizeType size)
+
+  {
+    bstriType resized;
+    boolType okay = TRUE;
+
+  /* resizeState */
+    if ((*work->stateBstri)->size != size) {
+      REALLOC_BSTRI_SIZE_OK(resized, *work->stateBstri,
+                            (*work->stateBstri)->size, size);
+      if (unlikely(resized == NULL)) {
+        okay = FALSE;
+      } else {
+        COUNT3_BSTRI((*work->stateBstri)->size, size);
+        resized->size = size;
+        *work->stateBstri = resized;
+      } /* if */
+    } /* if */
+    work->tables = (zstdTablesType) &(*work->stateBstri)->mem[STATE_AREA_SIZE];
+    work->buffer = &(*work->stateBstri)->mem[BUFFER_OFFSET];
+    return okay;
+  } /* resizeState */
+
+
+
+static int readFrameHeader (zstdWorkType work)
+
+  {
+    const ucharType *data;
+    memSizeType available;
+    uint32Type magic;
+    unsigned int descriptor;
+    unsigned int fcsFieldSize;
+    boolType singleSegment;
+    unsigned int dictIdFieldSize;
+    memSizeType headerSize;
+    unsigned int windowDescriptor;
+    uint64Type windowBase;
+    uint64Type windowSize;
+    uint64Type contentSize = 0;
+    uint64Type slideSize;
+    uint64Type bufferSize;
+    memSizeType pos;
+    unsigned int index;
+    int status = STATUS_RUNNING;
+
+  /* readFrameHeader */
+    data = &work->in[work->inPos];
+    available = work->inLength - work->inPos;
+    if (available < 4) {
+      if (available == 0 && work->inputEnd && work->state.skippedFrame) {
+        /* The data ends with a skippable frame. */
+        work->state.mode = MODE_FINISHED;
+        return STATUS_RUNNING;
+      } else {
+        return work->inputEnd ? STATUS_DATA_ERROR : STATUS_NEED_INPUT;
+      } /* if */
+    } /* if */
+    magic = loadLittleEndian32(data);
+    if ((magic & SKIPPABLE_MASK) == SKIPPABLE_MAGIC) {
+      if (available < 8) {
+        return work->inputEnd ? STATUS_DATA_ERROR : STATUS_NEED_INPUT;
+      } /* if */
+      work->state.skipRemaining = loadLittleEndian32(&data[4]);
+      work->state.skippedFrame = 1;
+      work->state.mode = MODE_SKIP_FRAME;
+      work->inPos += 8;
+      return STATUS_RUNNING;
+    } else if (magic != ZSTD_MAGIC || available < 5) {
+      return magic != ZSTD_MAGIC || work->inputEnd ?
+          STATUS_DATA_ERROR : STATUS_NEED_INPUT;
+    } /* if */
+    descriptor = data[4];
+    fcsFieldSize = descriptor >> 6 == 0 ? (descriptor >> 5) & 1 :
+                                          1U << (descriptor >> 6);
+    singleSegment = (descriptor >> 5) & 1;
+    dictIdFieldSize = (descriptor & 3) == 3 ? 4U : descriptor & 3;
+    headerSize = 5U + (singleSegment ? 0U : 1U) + dictIdFieldSize + fcsFieldSize;
+    if ((descriptor & 0x08) != 0) {
+      /* The reserved bit must be zero. */
+      status = STATUS_DATA_ERROR;
+    } else if (available < headerSize) {
+      status = work->inputEnd ? STATUS_DATA_ERROR : STATUS_NEED_INPUT;
+    } else {
+      pos = 5;
+      windowSize = 0;
+      if (!singleSegment) {
+        windowDescriptor = data[pos];
+        pos++;
+        windowBase = (uint64Type) 1 << (10 + (windowDescriptor >> 3));
+        windowSize = windowBase + (windowBase >> 3) * (windowDescriptor & 7);
+        if ((windowDescriptor >> 3) + 10 > MAX_WINDOW_LOG) {
+          status = STATUS_MEMORY_ERROR;
+        } /* if */
+      } /* if */
+      for (index = 0; index < dictIdFieldSize; index++) {
+        if (data[pos + index] != 0) {
+          /* Frames that need a dictionary are not supported. */
+          status = STATUS_DATA_ERROR;
+        } /* if */
+      } /* for */
+      pos += dictIdFieldSize;
+      for (index = 0; index < fcsFieldSize; index++) {
+        contentSize |= (uint64Type) data[pos + index] << (8 * index);
+      } /* for */
+      if (fcsFieldSize == 2) {
+        contentSize += 256;
+      } /* if */
+      if (singleSegment) {
+        windowSize = contentSize;
+        if (windowSize > (uint64Type) 1 << MAX_WINDOW_LOG) {
+          status = STATUS_MEMORY_ERROR;
+        } /* if */
+      } /* if */
+      if (status == STATUS_RUNNING) {
+        if (windowSize < MIN_WINDOW_SIZE) {
+          windowSize = MIN_WINDOW_SIZE;
+        } /* if */
+        /* Moving the window once per window size keeps the */
+        /* copying effort to one byte per decoded byte.      */
+        slideSize = windowSize < MIN_SLIDE_SIZE ? MIN_SLIDE_SIZE : windowSize;
+        bufferSize = windowSize + slideSize + MAX_BLOCK_SIZE + COPY_SLACK;
+        if (bufferSize > MAX_BSTRI_LEN - BUFFER_OFFSET ||
+            !resizeState(work, (memSizeType) (BUFFER_OFFSET + bufferSize))) {
+          status = STATUS_MEMORY_ERROR;
+        } else {
+          work->state.hasContentSize = fcsFieldSize != 0 || singleSegment;
+          work->state.contentSize = contentSize;
+          work->state.hasChecksum = (descriptor >> 2) & 1;
+          work->state.windowSize = windowSize;
+          work->state.bufferSize = bufferSize;
+          work->state.bufferPos = 0;
+          work->state.produced = 0;
+          work->state.lastBlock = 0;
+          work->state.repOffset[0] = 1;
+          work->state.repOffset[1] = 4;
+          work->state.repOffset[2] = 8;
+          work->state.llLog = (uint32Type) -1;
+          work->state.mlLog = (uint32Type) -1;
+          work->state.ofLog = (uint32Type) -1;
+          work->state.hufLog = 0;
+          xxh64Init(&work->state.xxh64);
+          work->state.mode = MODE_BLOCK;
+          work->inPos += headerSize;
+        } /* if */
+      } /* if */
+    } /* if */
+    return status;
+  } /* readFrameHeader */
+
+
+
+static int skipFrame (zstdWorkType work)
+
+  {
+    memSizeType available;
+    int status = STATUS_RUNNING;
+
+  /* skipFrame */
+    available = work->inLength - work->inPos;
+    if (available >= work->state.skipRemaining) {
+      work->inPos += work->state.skipRemaining;
+      work->state.skipRemaining = 0;
+      work->state.mode = MODE_FRAME_HEADER;
+    } else {
+      work->inPos += available;
+      work->state.skipRemaining -= (uint32Type) available;
+      status = work->inputEnd ? STATUS_DATA_ERROR : STATUS_NEED_INPUT;
+    } /* if */
+    return status;
+  } /* skipFrame */
+
+
+
+/**
+ *  Append the bytes produced by a block to the output of the step.
+ *  @return TRUE if the output has been appended, FALSE if there
+ *          is not enough memory.
+ */
+static boolType emitBytes (zstdWorkType work, const ucharType *bytes,
+    memSizeType length)
+
+  {
+    memSizeType newCapacity;
+    ucharType *resized;
+    boolType okay = TRUE;
+
+  /* emitBytes */
+    if (length > work->outCapacity - work->outPos) {
+      newCapacity = work->outCapacity * 2;
+      if (newCapacity < work->outPos + length) {
+        newCapacity = work->outPos + length;
+      } /* if */
+      resized = REALLOC_UBYTES(work->out, newCapacity);
+      if (unlikely(resized == NULL)) {
+        okay = FALSE;
+      } else {
+        COUNT3_UBYTES(work->outCapacity, newCapacity);
+        work->out = resized;
+        work->outCapacity = newCapacity;
+      } /* if */
+    } /* if */
+    if (okay) {
+      memcpy(&work->out[work->outPos], bytes, length);
+      work->outPos += length;
+    } /* if */
+    return okay;
+  } /* emitBytes */
+
+
+
+static int decodeBlock (zstdWorkType work)
+
+  {
+    const ucharType *data;
+    memSizeType available;
+    uint32Type header;
+    unsigned int blockType;
+    memSizeType blockSize;
+    memSizeType inputSize;
+    memSizeType keep;
+    memSizeType literalsSize;
+    long produced = 0;
+    ucharType *dest;
+    int status = STATUS_RUNNING;
+
+  /* decodeBlock */
+    if (work->outPos >= work->outTarget) {
+      return STATUS_OUTPUT_FULL;
+    } /* if */
+    data = &work->in[work->inPos];
+    available = work->inLength - work->inPos;
+    if (available < BLOCK_HEADER_SIZE) {
+      return work->inputEnd ? STATUS_DATA_ERROR : STATUS_NEED_INPUT;
+    } /* if */
+    header = (uint32Type) data[0] | (uint32Type) data[1] << 8 |
+             (uint32Type) data[2] << 16;
+    blockType = (header >> 1) & 3;
+    blockSize = header >> 3;
+    inputSize = blockType == BLOCK_RLE ? 1 : blockSize;
+    if (blockType == 3 || blockSize > MAX_BLOCK_SIZE ||
+        blockSize > work->state.windowSize) {
+      return STATUS_DATA_ERROR;
+    } else if (available - BLOCK_HEADER_SIZE < inputSize) {
+      return work->inputEnd ? STATUS_DATA_ERROR : STATUS_NEED_INPUT;
+    } /* if */
+    if (work->state.bufferPos + MAX_BLOCK_SIZE + COPY_SLACK > work->state.bufferSize) {
+      keep = (memSizeType) work->state.windowSize;
+      memmove(work->buffer, &work->buffer[work->state.bufferPos - keep], keep);
+      work->state.bufferPos = keep;
+    } /* if */
+    dest = &work->buffer[work->state.bufferPos];
+    data += BLOCK_HEADER_SIZE;
+    switch (blockType) {
+      case BLOCK_RAW:
+        memcpy(dest, data, blockSize);
+        produced = (long) blockSize;
+        break;
+      case BLOCK_RLE:
+        memset(dest, data[0], blockSize);
+        produced = (long) blockSize;
+        break;
+      default:
+        if (blockSize == 0) {
+          produced = -1;
+        } else {
+          literalsSize = readLiteralsSection(work, data, blockSize);
+          if (literalsSize == 0) {
+            produced = -1;
+          } else {
+            produced = executeSequences(work, &data[literalsSize],
+                                        blockSize - literalsSize);
+          } /* if */
+        } /* if */
+        break;
+    } /* switch */
+    if (produced < 0) {
+      status = STATUS_DATA_ERROR;
+    } else if (!emitBytes(work, dest, (memSizeType) produced)) {
+      status = STATUS_MEMORY_ERROR;
+    } else {
+      if (work->state.hasChecksum) {
+        xxh64Update(&work->state.xxh64, dest, (memSizeType) produced);
+      } /* if */
+      work->state.bufferPos += (uint64Type) produced;
+      work->state.produced += (uint64Type) produced;
+      work->inPos += BLOCK_HEADER_SIZE + inputSize;
+      if (work->state.hasContentSize &&
+          work->state.produced > work->state.contentSize) {
+        status = STATUS_DATA_ERROR;
+      } else if (header & 1) {
+        if (work->state.hasContentSize &&
+            work->state.produced != work->state.contentSize) {
+          status = STATUS_DATA_ERROR;
+        } else {
+          work->state.mode = work->state.hasChecksum ? MODE_CHECKSUM :
+                                                       MODE_FINISHED;
+        } /* if */
+      } /* if */
+    } /* if */
+    return status;
+  } /* decodeBlock */
+
+
+
+static int checkChecksum (zstdWorkType work)
+
+  {
+    int status;
+
+  /* checkChecksum */
+    if (work->inLength - work->inPos < CHECKSUM_SIZE) {
+      status = work->inputEnd ? STATUS_DATA_ERROR : STATUS_NEED_INPUT;
+    } else if (loadLittleEndian32(&work->in[work->inPos]) !=
+               (uint32Type) xxh64Digest(&work->state.xxh64)) {
+      logError(printf("zstd: Content checksum does not match.\n"););
+      status = STATUS_DATA_ERROR;
+    } else {
+      work->inPos += CHECKSUM_SIZE;
+      work->state.mode = MODE_FINISHED;
+      status = STATUS_RUNNING;
+    } /* if */
+    return status;
+  } /* checkChecksum */
+
+
+
+static int runZstd (zstdWorkType work)
+
+  {
+    int status = STATUS_RUNNING;
+
+  /* runZstd */
+    while (status == STATUS_RUNNING) {
+      switch (work->state.mode) {
+        case MODE_FRAME_HEADER:
+          status = readFrameHeader(work);
+          break;
+        case MODE_SKIP_FRAME:
+          status = skipFrame(work);
+          break;
+        case MODE_BLOCK:
+          status = decodeBlock(work);
+          break;
+        case MODE_CHECKSUM:
+          status = checkChecksum(work);
+          break;
+        default:
+          status = STATUS_FINISHED;
+          break;
+      } /* switch */
+    } /* while */
+    return status;
+  } /* runZstd */
+
+
+
+/**
+ *  Copy the zstd state stored in the bstring 'stateBstri' to 'state'.
+ *  @return TRUE if 'stateBstri' contains a valid state, FALSE otherwise.
+ */
+static boolType getZstdState (const const_bstriType stateBstri,
+    zstdStateRecord *state)
+
+  {
+    boolType okay = FALSE;
+
+  /* getZstdState */
+    if (stateBstri->size >= BUFFER_OFFSET) {
+      memcpy(state, stateBstri->mem, sizeof(zstdStateRecord));
+      okay = state->mode <= MODE_ERROR &&
+             state->lastBlock <= 1 &&
+             state->hasChecksum <= 1 &&
+             state->hasContentSize <= 1 &&
+             state->skippedFrame <= 1 &&
+             (state->llLog <= LL_MAX_LOG || state->llLog == (uint32Type) -1) &&
+             (state->mlLog <= ML_MAX_LOG || state->mlLog == (uint32Type) -1) &&
+             (state->ofLog <= OF_MAX_LOG || state->ofLog == (uint32Type) -1) &&
+             state->hufLog <= HUF_MAX_LOG &&
+             state->xxh64.bufferSize < 32;
+      if (okay && (state->mode == MODE_BLOCK || state->mode == MODE_CHECKSUM)) {
+        okay = stateBstri->size - BUFFER_OFFSET == state->bufferSize &&
+               state->windowSize >= MIN_WINDOW_SIZE &&
+               state->bufferSize >= state->windowSize + MIN_SLIDE_SIZE +
+                                    MAX_BLOCK_SIZE + COPY_SLACK &&
+               state->bufferPos <= state->bufferSize - COPY_SLACK;
+      } /* if */
+    } /* if */
+    return okay;
+  } /* getZstdState */
+
+
+
+/**
+ *  Create a state for an incremental Zstandard decompression.
+ *  The history buffer is allocated when the frame header is read.
+ *  @return the zstd state, which is stored in a bstring.
+ *  @exception MEMORY_ERROR Not enough memory to represent the result.
+ */
+bstriType zstDecodeInit (void)
+
+  {
+    zstdStateRecord state;
+    bstriType result;
+
+  /* zstDecodeInit */
+    logFunction(printf("zstDecodeInit\n"););
+    memset(&state, 0, sizeof(zstdStateRecord));
+    state.mode = MODE_FRAME_HEADER;
+    if (unlikely(!ALLOC_BSTRI_SIZE_OK(result, BUFFER_OFFSET))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      result->size = BUFFER_OFFSET;
+      memset(result->mem, 0, BUFFER_OFFSET);
+      memcpy(result->mem, &state, sizeof(zstdStateRecord));
+    } /* if */
+    return result;
+  } /* zstDecodeInit */
+
+
+
+/**
+ *  Determine if the end of the Zstandard frame has been reached.
+ *  @param stateBstri Zstd state created with zstDecodeInit().
+ *  @return TRUE if the frame has been decompressed completely,
+ *          FALSE otherwise.
+ *  @exception RANGE_ERROR If 'stateBstri' is not a valid zstd state.
+ */
+boolType zstDecodeFinished (const const_bstriType stateBstri)
+
+  {
+    zstdStateRecord state;
+    boolType finished;
+
+  /* zstDecodeFinished */
+    if (unlikely(!getZstdState(stateBstri, &state))) {
+      logError(printf("zstDecodeFinished(*): Illegal zstd state.\n"););
+      raise_error(RANGE_ERROR);
+      finished = FALSE;
+    } else {
+      finished = state.mode == MODE_FINISHED;
+    } /* if */
+    return finished;
+  } /* zstDecodeFinished */
+
+
+
+/**
+ *  Decompress a Zstandard frame from 'compressed' starting at '*bytePos'.
+ *  Decompression continues until at least 'minLength' bytes have
+ *  been produced, the end of the frame is reached or more input is
+ *  needed. Blocks are only decoded when they are completely present
+ *  in 'compressed'. Afterwards '*bytePos' refers to the first byte
+ *  that has not been consumed. At the end of the frame it refers to
+ *  the first byte after the frame. Skippable frames in front of the
+ *  frame are skipped.
+ *  @param stateBstri Variable with a zstd state created with
+ *         zstDecodeInit(). The state grows, when the frame
+ *         header is read.
+ *  @param inputEnd TRUE if no data follows after 'compressed'.
+ *  @param minLength Minimum length of the result.
+ *  @return the decompressed bytes.
+ *  @exception RANGE_ERROR If the state is not valid, if 'compressed'
+ *             is not in Zstandard format or if it contains a character
+ *             beyond '\255;'. The state cannot be used afterwards.
+ *  @exception INDEX_ERROR If '*bytePos' is not in the range 1 to
+ *             length(compressed) + 1.
+ *  @exception MEMORY_ERROR Not enough memory for the window or
+ *             to represent the result.
+ */
+striType zstDecodeStep (bstriType *const stateBstri,
+    const const_striType compressed, intType *const bytePos,
+    boolType inputEnd, intType minLength)
+
+  {
+    zstdWorkType work;
+    ucharType *inBuffer = NULL;
+    memSizeType inLength;
+    int status;
+    striType result = NULL;
+
+  /* zstDecodeStep */
+    logFunction(printf("zstDecodeStep(*, \"%s\", " FMT_D ", %d, " FMT_D ")\n",
+                       striAsUnquotedCStri(compressed), *bytePos,
+                       inputEnd, minLength););
+    if (unlikely(*bytePos < 1 ||
+                 (uintType) *bytePos - 1 > compressed->size)) {
+      logError(printf("zstDecodeStep: Byte position " FMT_D
+                      " not in range 1 .. " FMT_U_MEM ".\n",
+                      *bytePos, compressed->size + 1););
+      raise_error(INDEX_ERROR);
+    } else if (unlikely(minLength < 0)) {
+      logError(printf("zstDecodeStep: Negative minimum length.\n"););
+      raise_error(RANGE_ERROR);
+    } else if (unlikely(!ALLOC_ZSTD_WORK(work))) {
+      raise_error(MEMORY_ERROR);
+    } else {
+      if (unlikely(!getZstdState(*stateBstri, &work->state) ||
+                   work->state.mode == MODE_ERROR)) {
+        logError(printf("zstDecodeStep: Illegal zstd state.\n"););
+        raise_error(RANGE_ERROR);
+      } else if (work->state.mode == MODE_FINISHED) {
+        result = bytesToStri(NULL, 0);
+      } else {
+        inLength = compressed->size - (memSizeType) (*bytePos - 1);
+        if (unlikely(inLength > MAX_MEMSIZETYPE - INPUT_SLACK ||
+                     !ALLOC_UBYTES(inBuffer, inLength + INPUT_SLACK))) {
+          raise_error(MEMORY_ERROR);
+        } else if (unlikely(memcpy_from_strelem(inBuffer,
+                                                &compressed->mem[*bytePos - 1],
+                                                inLength))) {
+          logError(printf("zstDecodeStep: "
+                          "Character beyond '\\255;' in data.\n"););
+          raise_error(RANGE_ERROR);
+        } else {
+          memset(&inBuffer[inLength], 0, INPUT_SLACK);
+          work->stateBstri = stateBstri;
+          work->tables = (zstdTablesType) &(*stateBstri)->mem[STATE_AREA_SIZE];
+          work->buffer = &(*stateBstri)->mem[BUFFER_OFFSET];
+          work->in = inBuffer;
+          work->inLength = inLength;
+          work->inPos = 0;
+          work->inputEnd = inputEnd;
+          work->outTarget = (memSizeType) minLength;
+          if (work->outTarget < MIN_OUTPUT_CHUNK) {
+            work->outTarget = MIN_OUTPUT_CHUNK;
+          } /* if */
+          work->outCapacity = MAX_BLOCK_SIZE;
+          work->outPos = 0;
+          if (unlikely(!ALLOC_UBYTES(work->out, work->outCapacity))) {
+            raise_error(MEMORY_ERROR);
+          } else {
+            status = runZstd(work);
+            if (status == STATUS_MEMORY_ERROR || status == STATUS_DATA_ERROR) {
+              /* The tables and the history may have been changed. */
+              work->state.mode = MODE_ERROR;
+              memcpy((*stateBstri)->mem, &work->state, sizeof(zstdStateRecord));
+              raise_error(status == STATUS_MEMORY_ERROR ? MEMORY_ERROR :
+                                                          RANGE_ERROR);
+            } else {
+              result = bytesToStri(work->out, work->outPos);
+              if (result != NULL) {
+                *bytePos += (intType) work->inPos;
+                memcpy((*stateBstri)->mem, &work->state, sizeof(zstdStateRecord));
+              } /* if */
+            } /* if */
+            FREE_BYTES(work->out, work->outCapacity);
+          } /* if */
+        } /* if */
+        if (inBuffer != NULL) {
+          FREE_BYTES(inBuffer, inLength + INPUT_SLACK);
+        } /* if */
+      } /* if */
+      FREE_ZSTD_WORK(work);
+    } /* if */
+    logFunction(printf("zstDecodeStep --> \"%s\" (bytePos=" FMT_D ")\n",
+                       striAsUnquotedCStri(result), *bytePos););
+    return result;
+  } /* zstDecodeStep */
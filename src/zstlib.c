@@ -0,0 +1,112 @@
+/********************************************************************/
+/*                                                                  */
+/*  s7   Seed7 interpreter                                          */
+/*  Copyright (C) 2026  Thomas Mertes                               */
+/*                                                                  */
+/*  This program is free software; you can redistribute it and/or   */
+/*  modify it under the terms of the GNU General Public License as  */
+/*  published by the Free Software Foundation; either version 2 of  */
+/*  the License, or (at your option) any later version.             */
+/*                                                                  */
+/*  This program is distributed in the hope that it will be useful, */
+/*  but WITHOUT ANY WARRANTY; without even the implied warranty of  */
+/*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the   */
+/*  GNU General Public License for more details.                    */
+/*                                                                  */
+/*  You should have received a copy of the GNU General Public       */
+/*  License along with this program; if not, write to the           */
+/*  Free Software Foundation, Inc., 51 Franklin Street,             */
+/*  Fifth Floor, Boston, MA  02110-1301, USA.                       */
+/*                                                                  */
+/*  Module: Library                                                 */
+/*  File: seed7/src/zstlib.c                                        */
+/*  Changes: 2026  Thomas Mertes                                    */
+/*  Content: All primitive actions for Zstandard decompression.     */
+/*                                                                  */
+/********************************************************************/
+
+#include "version.h"
+
+#include "stdlib.h"
+#include "stdio.h"
+
+#include "common.h"
+#include "data.h"
+#include "data_rtl.h"
+#include "heaputl.h"
+#include "syvarutl.h"
+#include "objutl.h"
+#include "runerr.h"
+#include "zst_rtl.h"
+
+#undef EXTERN
+#define EXTERN
+#include "zstlib.h"
+
+
+
+/**
+ *  Determine if the zstd state arg_1 reached the end of the frame.
+ *  @return TRUE if the frame has been decompressed completely,
+ *          FALSE otherwise.
+ *  @exception RANGE_ERROR If arg_1 is not a valid zstd state.
+ */
+objectType zst_decode_finished (listType arguments)
+
+  { /* zst_decode_finished */
+    isit_bstri(arg_1(arguments));
+    if (zstDecodeFinished(take_bstri(arg_1(arguments)))) {
+      return SYS_TRUE_OBJECT;
+    } else {
+      return SYS_FALSE_OBJECT;
+    } /* if */
+  } /* zst_decode_finished */
+
+
+
+/**
+ *  Create a state for the decompression of a Zstandard frame.
+ *  @return the new zstd state.
+ */
+objectType zst_decode_init (listType arguments)
+
+  { /* zst_decode_init */
+    return bld_bstri_temp(zstDecodeInit());
+  } /* zst_decode_init */
+
+
+
+/**
+ *  Decompress compressed/arg_2 starting at bytePos/arg_3 with the
+ *  zstd state arg_1. The variable bytePos/arg_3 is advanced behind
+ *  the consumed bytes. If inputEnd/arg_4 is TRUE no data follows
+ *  after arg_2. At least minLength/arg_5 bytes are produced, if the
+ *  data and the input allow it.
+ *  @return the decompressed bytes.
+ *  @exception RANGE_ERROR If arg_1 is not a valid zstd state or
+ *             if arg_2 is not in Zstandard format.
+ *  @exception INDEX_ERROR If bytePos/arg_3 is not in the range
+ *             1 to length(arg_2) + 1.
+ */
+objectType zst_decode_step (listType arguments)
+
+  {
+    objectType stateVar;
+    objectType bytePosVar;
+
+  /* zst_decode_step */
+    stateVar = arg_1(arguments);
+    isit_bstri(stateVar);
+    is_variable(stateVar);
+    isit_stri(arg_2(arguments));
+    bytePosVar = arg_3(arguments);
+    isit_int(bytePosVar);
+    is_variable(bytePosVar);
+    isit_bool(arg_4(arguments));
+    isit_int(arg_5(arguments));
+    return bld_stri_temp(
+        zstDecodeStep(&stateVar->value.bstriValue, take_stri(arg_2(arguments)),
+                      &bytePosVar->value.intValue,
+                      take_bool(arg_4(arguments)) == SYS_TRUE_OBJECT,
+                      take_int(arg_5(arguments))));
+  } /* zst_decode_step */